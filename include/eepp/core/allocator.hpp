@@ -3,6 +3,8 @@
 
 #include <eepp/core/memorymanager.hpp>
 #include <cstddef>
+#include <memory>
+#include <new>
 
 namespace EE {
 
@@ -41,7 +43,7 @@ class Allocator {
 
 		void destroy( T * ptr ) {
 			#ifdef EE_MEMORY_MANAGER
-			EE::MemoryManager::RemovePointer( ptr );
+			EE::MemoryManager::removePointer( ptr );
 			#endif
 
 			ptr->~T();
@@ -75,6 +77,85 @@ class Allocator {
 
 };
 
+/** @brief STL compatible allocator that allocates from an allocator instance ( PoolAllocator, ArenaAllocator or any class with
+**	allocate( size ) and deallocate( ptr, size ) ).
+**	The node based containers ( list, set, map ) allocate a node at a time, so they can use a pool with the node size as block size.
+**	@code
+	ArenaAllocator arena;
+	std::vector<int, AllocatorAdapter<int, ArenaAllocator> > vec( ( AllocatorAdapter<int, ArenaAllocator>( &arena ) ) );
+	@endcode */
+template<typename T, typename A>
+class AllocatorAdapter {
+	public:
+		typedef T				value_type;
+		typedef T *				pointer;
+		typedef const T *		const_pointer;
+		typedef T&				reference;
+		typedef const T&		const_reference;
+		typedef ptrdiff_t		difference_type;
+		typedef size_t			size_type;
+
+		AllocatorAdapter( A * allocator ) :
+			mAllocator( allocator )
+		{
+		}
+
+		template <class U>
+		AllocatorAdapter( const AllocatorAdapter<U, A>& other ) :
+			mAllocator( other.getAllocator() )
+		{
+		}
+
+		T * allocate( size_t cnt, const void * = 0 ) {
+			return ( T * ) mAllocator->allocate( cnt * sizeof( T ) );
+		}
+
+		void deallocate( T * ptr, size_type cnt ) {
+			mAllocator->deallocate( ptr, cnt * sizeof( T ) );
+		}
+
+		void construct( T * ptr, const T& e ) {
+			new ( (void*)ptr ) T( e );
+		}
+
+		void destroy( T * ptr ) {
+			ptr->~T();
+		}
+
+		size_t max_size() const {
+			return size_t( -1 ) / sizeof( T );
+		}
+
+		pointer address( reference x ) const {
+			return &x;
+		}
+
+		const_pointer address( const_reference x ) const {
+			return &x;
+		}
+
+		A * getAllocator() const {
+			return mAllocator;
+		}
+
+		template <class U>
+		struct rebind {
+			typedef AllocatorAdapter<U, A> other;
+		};
+	protected:
+		A * mAllocator;
+};
+
+template <typename T, typename U, typename A>
+bool operator==( const AllocatorAdapter<T, A>& a, const AllocatorAdapter<U, A>& b ) {
+	return a.getAllocator() == b.getAllocator();
+}
+
+template <typename T, typename U, typename A>
+bool operator!=( const AllocatorAdapter<T, A>& a, const AllocatorAdapter<U, A>& b ) {
+	return a.getAllocator() != b.getAllocator();
+}
+
 }
 
 #endif
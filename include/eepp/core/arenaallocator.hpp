@@ -0,0 +1,67 @@
+#ifndef EE_ARENAALLOCATOR_HPP
+#define EE_ARENAALLOCATOR_HPP
+
+#include <eepp/config.hpp>
+#include <eepp/core/noncopyable.hpp>
+#include <cstddef>
+#include <vector>
+#include <new>
+
+namespace EE {
+
+/** @brief A linear ( frame ) allocator.
+**	Allocating only moves a pointer forward inside the current block, and the memory is released all at once with reset(), so it's
+**	meant for short lived data: temporary buffers used while loading a resource or while processing a frame.
+**	The destructors of the objects created in the arena are never called, only use it for objects that don't need them.
+**	The arena is not thread-safe. */
+class EE_API ArenaAllocator : NonCopyable {
+	public:
+		/** @param blockSize The size of the blocks allocated from the heap. Allocations bigger than the block size get its own block. */
+		ArenaAllocator( const size_t& blockSize = 64 * 1024 );
+
+		~ArenaAllocator();
+
+		/** @return A pointer to size bytes of memory aligned to alignment ( must be a power of two ) */
+		void * allocate( const size_t& size, const size_t& alignment = 16 );
+
+		/** @brief Does nothing, the memory is released by reset() ( needed by AllocatorAdapter ). */
+		void deallocate( void * ptr, const size_t& size );
+
+		/** @brief Releases every allocation. The blocks are kept to be reused. */
+		void reset();
+
+		/** @brief Releases every allocation and frees the blocks. */
+		void release();
+
+		/** @return The memory allocated since the last reset */
+		const size_t& getUsedMemory() const;
+
+		/** @return The highest memory usage between resets */
+		const size_t& getPeakUsedMemory() const;
+
+		/** @return The memory reserved by the blocks */
+		size_t getReservedMemory() const;
+
+		/** @return The number of blocks */
+		size_t getBlockCount() const;
+	protected:
+		struct Block {
+			char *	Data;
+			size_t	Size;
+		};
+
+		size_t				mBlockSize;
+		std::vector<Block>	mBlocks;
+		size_t				mCurrentBlock;
+		size_t				mOffset;
+		size_t				mUsedMemory;
+		size_t				mPeakUsedMemory;
+};
+
+}
+
+/** @brief Creates an object in the arena */
+#define eeArenaNew( arena, classType, constructor ) \
+		new ( (arena).allocate( sizeof( classType ) ) ) classType constructor
+
+#endif
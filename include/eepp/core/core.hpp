@@ -5,5 +5,8 @@
 #include <eepp/core/utf.hpp>
 #include <eepp/core/debug.hpp>
 #include <eepp/core/memorymanager.hpp>
+#include <eepp/core/allocator.hpp>
+#include <eepp/core/poolallocator.hpp>
+#include <eepp/core/arenaallocator.hpp>
 
 #endif
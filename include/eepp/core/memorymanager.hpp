@@ -7,9 +7,11 @@
 #include <string>
 #include <cstring>
 #include <map>
+#include <vector>
 
 namespace EE {
 
+/** @brief The information of an allocation done with the memory manager. */
 class EE_API AllocatedPointer {
 	public:
 		AllocatedPointer( void * Data, const std::string& File, int Line, size_t Memory );
@@ -20,19 +22,44 @@ class EE_API AllocatedPointer {
 		void *			mData;
 };
 
-typedef std::map<void*, AllocatedPointer> 	AllocatedPointerMap;
-typedef AllocatedPointerMap::iterator 		AllocatedPointerMapIt;
+/** @brief The allocation statistics of a call site ( a line of code that allocates memory with the memory manager ). */
+class EE_API AllocationCallSite {
+	public:
+		const char *	File;
+		int				Line;
+		Int64			LiveMemory;		//! Memory currently allocated by the call site
+		Int64			PeakMemory;		//! Highest LiveMemory value
+		Int64			LiveCount;		//! Number of allocations not freed
+		Int64			TotalCount;		//! Number of allocations done
+};
 
+/** @brief Tracks the allocations done with eeNew, eeNewArray and eeMalloc when EE_MEMORY_MANAGER is defined.
+**	Every allocation macro interns its call site ( file and line ) once, and the allocations only store the call site id.
+**	The allocated pointers are kept in sharded hash tables, every shard guarded by its own spin lock, and the memory usage of every
+**	call site is counted with atomic counters, so tracking can be used in multi-threaded soak tests. */
 class EE_API MemoryManager {
 	public:
-		static void * addPointer( const AllocatedPointer& aAllocatedPointer );
+		/** @brief Interns a call site.
+		**	@return The call site id, the same file and line always return the same id. */
+		static Uint32 registerCallSite( const char * file, int line );
+
+		static void * addPointer( void * data, const Uint32& callSite, size_t memory );
 
-		static void * addPointerInPlace( void * Place, const AllocatedPointer& aAllocatedPointer );
+		static void * addPointerInPlace( void * place, void * data, const Uint32& callSite, size_t memory );
 
 		static bool removePointer( void * Data );
 
+		/** @brief Prints the final memory report: the memory leaks ( pointers not freed ) and the call sites report.
+		**	This destroys the Log instance, so it should be called when the application ends. */
 		static void showResults();
 
+		/** @brief Prints the call sites sorted by the memory that they currently keep allocated. It can be called at any time.
+		**	@param count Maximum number of call sites to print, 0 prints every call site that allocated memory. */
+		static void showCallSitesReport( const Uint32& count = 0 );
+
+		/** @return The statistics of every call site registered. */
+		static std::vector<AllocationCallSite> getCallSites();
+
 		template<class T>
 		static T* deletePtr( T * Data ) {
 			delete Data;
@@ -63,17 +90,21 @@ class EE_API MemoryManager {
 };
 
 #ifdef EE_MEMORY_MANAGER
+	/** The id of the call site, interned the first time the line is executed */
+	#define eeCallSite \
+			( []() -> EE::Uint32 { static const EE::Uint32 callSite = EE::MemoryManager::registerCallSite( __FILE__, __LINE__ ); return callSite; }() )
+
 	#define eeNew( classType, constructor ) \
-			( classType *)EE::MemoryManager::addPointer( EE::AllocatedPointer( new classType constructor ,__FILE__,__LINE__, sizeof(classType) ) )
+			( classType *)EE::MemoryManager::addPointer( new classType constructor, eeCallSite, sizeof(classType) )
 
 	#define eeNewInPlace( place, classType, constructor ) \
-			( classType *)EE::MemoryManager::addPointerInPlace( place, EE::AllocatedPointer( new place classType constructor ,__FILE__,__LINE__, sizeof(classType) ) )
+			( classType *)EE::MemoryManager::addPointerInPlace( place, new place classType constructor, eeCallSite, sizeof(classType) )
 
 	#define eeNewArray( classType, amount ) \
-			( classType *) EE::MemoryManager::addPointer( EE::AllocatedPointer( new classType [ amount ], __FILE__, __LINE__, amount * sizeof( classType ) ) )
+			( classType *) EE::MemoryManager::addPointer( new classType [ amount ], eeCallSite, ( amount ) * sizeof( classType ) )
 
 	#define eeMalloc(amount) \
-			EE::MemoryManager::addPointer( EE::AllocatedPointer( EE::MemoryManager::allocate( amount ), __FILE__, __LINE__, amount ) )
+			EE::MemoryManager::addPointer( EE::MemoryManager::allocate( amount ), eeCallSite, amount )
 
 	#define eeDelete( data ){ \
 			if( EE::MemoryManager::removePointer( EE::MemoryManager::deletePtr( data ) ) == false ) printf( "Deleting at '%s' %d\n", __FILE__, __LINE__ ); \
@@ -0,0 +1,107 @@
+#ifndef EE_POOLALLOCATOR_HPP
+#define EE_POOLALLOCATOR_HPP
+
+#include <eepp/config.hpp>
+#include <eepp/core/noncopyable.hpp>
+#include <cstddef>
+#include <vector>
+#include <atomic>
+
+namespace EE {
+
+/** @brief A fixed size block allocator.
+**	The blocks are carved from chunks allocated from the heap, and the freed blocks are kept in a free list to be reused, so
+**	allocating and freeing a block is constant time and the blocks of the same type stay close in memory.
+**	Allocations bigger than the block size ( or done while the pool is disabled ) are served by the heap, so a pool can be used by
+**	a whole class hierarchy. The chunks are only released when the pool is destroyed.
+**	The pool is thread-safe. */
+class EE_API PoolAllocator : NonCopyable {
+	public:
+		/** @param blockSize The size of every block ( rounded up to 16 bytes )
+		**	@param blocksPerChunk The number of blocks allocated at once when the pool runs out of free blocks */
+		PoolAllocator( const size_t& blockSize, const size_t& blocksPerChunk = 256 );
+
+		~PoolAllocator();
+
+		/** @return A block of memory of at least size bytes */
+		void * allocate( const size_t& size );
+
+		/** @brief Returns the memory to the pool ( or to the heap if it wasn't allocated from the pool ) */
+		void deallocate( void * ptr, const size_t& size );
+
+		/** @return True if the pointer belongs to a block of the pool */
+		bool owns( void * ptr );
+
+		/** @brief Enables or disables the pool. A disabled pool allocates from the heap. The blocks already allocated are still
+		**	returned to the pool when freed. */
+		void setEnabled( const bool& enabled );
+
+		/** @return If the pool is enabled */
+		bool isEnabled() const;
+
+		/** @return The size of a block */
+		const size_t& getBlockSize() const;
+
+		/** @return The number of blocks in use */
+		size_t getUsedBlocks() const;
+
+		/** @return The highest number of blocks in use at the same time */
+		size_t getPeakUsedBlocks() const;
+
+		/** @return The number of blocks allocated ( used and free ) */
+		size_t getCapacity() const;
+
+		/** @return The number of allocations served by the heap because they didn't fit in a block or the pool was disabled */
+		size_t getHeapAllocations() const;
+
+		/** @return The memory reserved by the pool chunks */
+		size_t getReservedMemory() const;
+	protected:
+		struct FreeBlock {
+			FreeBlock * Next;
+		};
+
+		size_t				mBlockSize;
+		size_t				mBlocksPerChunk;
+		FreeBlock *			mFreeList;
+		std::vector<char*>	mChunks;	//! Sorted by address
+		size_t				mUsedBlocks;
+		size_t				mPeakUsedBlocks;
+		size_t				mHeapAllocations;
+		bool				mEnabled;
+		std::atomic_flag	mLock;
+
+		void lock();
+
+		void unlock();
+
+		bool ownsUnlocked( void * ptr ) const;
+
+		void allocateChunk();
+};
+
+}
+
+/** @brief Makes every allocation of the class ( and its derived classes ) go through the pool returned by allocatorGetter.
+**	eeNew and eeDelete ( or new and delete ) use the pool transparently. The class must have a virtual destructor if derived
+**	objects are deleted through a base pointer.
+**	The pool must outlive every object allocated from it, so it shouldn't be a function-local static: an object released by
+**	another static destructor could return its block to a destroyed pool. Allocate the pool once and never destroy it.
+**	@code
+	class MyObject {
+		public:
+			EE_POOL_ALLOCATED( MyObject::getAllocator )
+
+			static PoolAllocator& getAllocator() {
+				static PoolAllocator * sAllocator = new PoolAllocator( sizeof(MyObject) );
+				return *sAllocator;
+			}
+	};
+	@endcode */
+#define EE_POOL_ALLOCATED( allocatorGetter ) \
+	static void * operator new( size_t size ) { return allocatorGetter().allocate( size ); } \
+	static void * operator new( size_t, void * place ) { return place; } \
+	static void operator delete( void * ptr, size_t size ) { allocatorGetter().deallocate( ptr, size ); } \
+	static void operator delete( void *, void * ) {}
+
+#endif
@@ -60,6 +60,9 @@ class EE_API String {
 	/** @return string hash */
 	static Uint32 hash( const char * str );
 
+	/** @return The hash of a buffer of data */
+	static Uint32 hash( const Uint8 * data, const Uint32& size );
+
 	/** @return string hash */
 	static Uint32 hash( const std::string& str );
 
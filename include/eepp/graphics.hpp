@@ -6,8 +6,11 @@
 #include <eepp/graphics/pixeldensity.hpp>
 #include <eepp/graphics/renderer/renderergl.hpp>
 #include <eepp/graphics/renderer/renderergl3.hpp>
+#include <eepp/graphics/renderer/renderernull.hpp>
+#include <eepp/graphics/renderer/vertexstreambuffer.hpp>
 #include <eepp/graphics/graphicshelper.hpp>
 #include <eepp/graphics/image.hpp>
+#include <eepp/graphics/imagekernels.hpp>
 #include <eepp/graphics/texture.hpp>
 #include <eepp/graphics/textureloader.hpp>
 #include <eepp/graphics/texturefactory.hpp>
@@ -26,6 +29,7 @@
 #include <eepp/graphics/fonttruetypeloader.hpp>
 #include <eepp/graphics/fontmanager.hpp>
 #include <eepp/graphics/text.hpp>
+#include <eepp/graphics/textlayout.hpp>
 #include <eepp/graphics/primitives.hpp>
 #include <eepp/graphics/scrollparallax.hpp>
 #include <eepp/graphics/console.hpp>
@@ -4,6 +4,7 @@
 #include <eepp/graphics/base.hpp>
 #include <eepp/math/polygon2.hpp>
 #include <eepp/math/originpoint.hpp>
+#include <vector>
 
 namespace EE { namespace Graphics {
 
@@ -21,9 +22,38 @@ struct eeVertex {
 class TextureFactory;
 class Texture;
 
-/** @brief A batch rendering class. */
+/** @brief A batch rendering class.
+**	By default the batch is drawn every time the texture, the blend mode or the draw mode changes. In the deferred mode the quads
+**	are recorded with their state instead, and when the batch is drawn they are stable sorted by ( layer, texture, blend mode )
+**	and the consecutive quads with the same state are drawn together ( as indexed triangles when the quads aren't supported ).
+**	The quads are only reordered inside a layer, so anything that must be drawn over something else with a different texture
+**	must use a higher layer. The other draw modes are never deferred, they draw the deferred quads first. */
 class EE_API BatchRenderer {
 	public:
+		/** The reasons to draw the batch */
+		enum FlushCause {
+			FlushTexture,		//! The texture changed
+			FlushBlendMode,		//! The blend mode changed
+			FlushDrawMode,		//! The draw mode changed
+			FlushBufferFull,	//! The vertex buffer is full
+			FlushDraw,			//! draw was called
+			FlushExternal,		//! Another batch renderer was drawn ( only for the global batch renderer )
+			FlushCauseCount
+		};
+
+		/** The rendering statistics of the batch renderer */
+		struct Stats {
+			Stats();
+
+			void reset();
+
+			Uint32	DrawCalls;
+			Uint32	Vertexs;
+			Uint32	Batches;		//! The runs of quads with the same state recorded in the deferred mode
+			Uint32	Flushes;
+			Uint32	FlushesByCause[ FlushCauseCount ];
+		};
+
 		BatchRenderer();
 
 		virtual ~BatchRenderer();
@@ -231,7 +261,42 @@ class EE_API BatchRenderer {
 
 		/** @return If the blending mode switch is forced */
 		const bool& getForceBlendModeChange() const;
+
+		/** @brief Enables or disables the deferred mode. The batch is drawn before changing the mode. */
+		void setDeferred( const bool& deferred );
+
+		/** @return If the quads are deferred and sorted */
+		const bool& isDeferred() const;
+
+		/** @brief Sets the layer of the next quads in the deferred mode. The layers are drawn in increasing order. */
+		void setLayer( const Int32& layer );
+
+		/** @return The current layer */
+		const Int32& getLayer() const;
+
+		/** @return The statistics accumulated since the last frame ended */
+		const Stats& getStats() const;
+
+		/** @return The statistics of the last frame */
+		const Stats& getFrameStats() const;
+
+		/** @brief Stores the current statistics as the frame statistics and resets them. Called by the window after drawing a frame. */
+		void endFrame();
 	protected:
+		struct DeferredBatch {
+			const Texture *	Tex;
+			EE_BLEND_MODE	Blend;
+			Int32			Layer;
+			Float			Rotation;
+			Vector2f		Scale;
+			Vector2f		Position;
+			Vector2f		Center;
+			Uint32			Start;
+			Uint32			Count;
+		};
+
+		class DeferredBatchLess;
+
 		eeVertex *			mVertex;
 		unsigned int				mVertexSize;
 		eeVertex *			mTVertex;
@@ -253,8 +318,29 @@ class EE_API BatchRenderer {
 
 		bool				mForceRendering;
 		bool				mForceBlendMode;
+		bool				mDeferred;
+		Int32				mLayer;
+
+		std::vector<DeferredBatch>	mBatches;
+		std::vector<Uint32>		mBatchesOrder;
+		std::vector<eeVertex>		mSortedVertex;
+		std::vector<Uint16>		mQuadIndexes;
+		Stats				mStats;
+		Stats				mFrameStats;
+
+		void flush( const FlushCause& cause );
+
+		bool isDeferring() const;
+
+		bool useQuadVertexs() const;
+
+		void addDeferredVertexs( const unsigned int& num );
+
+		void flushDeferred();
+
+		void drawDeferredBatch( const DeferredBatch& batch, eeVertex * vertex, const Uint32& count );
 
-		void flush();
+		void pushBatchMatrix( const Float& rotation, const Vector2f& scale, const Vector2f& position, const Vector2f& center );
 
 		void init();
 
@@ -6,6 +6,7 @@
 #include <eepp/graphics/primitives.hpp>
 #include <eepp/graphics/font.hpp>
 #include <eepp/graphics/text.hpp>
+#include <eepp/system/mutex.hpp>
 #include <deque>
 
 namespace EE { namespace Window { class Window; class InputTextBuffer; class InputEvent; } }
@@ -132,6 +133,8 @@ class EE_API Console : protected LogReaderInterface {
 		std::map < String, ConsoleCallback > mCallbacks;
 		std::deque < String > mCmdLog;
 		std::deque < String > mLastCommands;
+		std::deque < String > mLogPending;	//! Lines written to the log pending to be added to mCmdLog
+		Mutex mLogPendingMutex;
 
 		EE::Window::Window * mWindow;
 
@@ -252,6 +255,8 @@ class EE_API Console : protected LogReaderInterface {
 
 		void writeLog( const std::string& Text );
 
+		void pushPendingLog();
+
 		void getFilesFrom( std::string txt, const Uint32& curPos );
 
 		Int32 linesOnScreen();
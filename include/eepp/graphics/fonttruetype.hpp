@@ -4,6 +4,9 @@
 #include <eepp/graphics/base.hpp>
 #include <eepp/graphics/texture.hpp>
 #include <eepp/graphics/font.hpp>
+#include <eepp/system/hashindex.hpp>
+#include <map>
+#include <vector>
 
 namespace EE { namespace System {
 class Pack;
@@ -12,10 +15,16 @@ class IOStream;
 
 namespace EE { namespace Graphics {
 
+/** @brief A TrueType font rendered with FreeType.
+**	The glyphs are rasterized the first time they're requested and cached in a page ( a texture ) per character size. The Latin-1
+**	glyphs without outline are kept in a direct table of the page, the rest in a flat open-addressing table. */
 class EE_API FontTrueType : public Font {
 	public:
 		static FontTrueType * New( const std::string FontName ) ;
 
+		/** @brief Shares the FreeType face of the copied font. The glyph pages are not copied, the copy loads its own glyphs. */
+		FontTrueType( const FontTrueType& copy );
+
 		~FontTrueType();
 
 		bool loadFromFile(const std::string& filename);
@@ -28,8 +37,18 @@ class EE_API FontTrueType : public Font {
 
 		const Font::Info& getInfo() const;
 
+		/** @return The glyph of the code point, it's rasterized if it wasn't cached.
+		**	The reference is valid until the next glyph is loaded, copy the glyph if it must be kept. */
 		const Glyph& getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, Float outlineThickness = 0) const;
 
+		/** @brief Loads the glyphs of every character of the charset in every size, so the texts using them don't need to rasterize
+		**	glyphs while they're being drawn.
+		**	When the font was loaded from a file or from memory the glyphs are rasterized by the JobSystem workers ( a job per size,
+		**	every job opens its own face ), otherwise they're rasterized in the calling thread. The glyphs are uploaded to the page
+		**	textures in batches, with an update per texture row. Must be called from the thread that owns the GL context.
+		**	@return The number of glyphs loaded */
+		Uint32 prewarm( const String& charset, const std::vector<unsigned int>& sizes, bool bold = false, Float outlineThickness = 0 );
+
 		Float getKerning(Uint32 first, Uint32 second, unsigned int characterSize) const;
 
 		Float getLineSpacing(unsigned int characterSize) const;
@@ -55,7 +74,9 @@ class EE_API FontTrueType : public Font {
 			unsigned int height; ///< Height of the row
 		};
 
-		typedef std::map<Uint64, Glyph> GlyphTable; ///< Table mapping a codepoint to its glyph
+		static const Uint32 LATIN_GLYPHS = 256; ///< Number of code points stored in the direct table of the pages
+
+		typedef HashIndex<Glyph, Uint64> GlyphTable; ///< Table mapping a codepoint ( plus the bold flag and outline thickness ) to its glyph
 
 		struct Page
 		{
@@ -63,16 +84,45 @@ class EE_API FontTrueType : public Font {
 
 			~Page();
 
-			GlyphTable       glyphs;  ///< Table mapping code points to their corresponding glyph
+			GlyphTable       glyphs;                            ///< Table mapping the code points that aren't in the direct table to their glyph
+			Glyph            latinGlyphs[LATIN_GLYPHS * 2];     ///< The Latin-1 glyphs without outline, regular and bold
+			bool             latinLoaded[LATIN_GLYPHS * 2];     ///< If the glyph of the direct table was loaded
 			Texture *        texture; ///< Texture containing the pixels of the glyphs
 			unsigned int     nextRow; ///< Y position of the next new row in the texture
 			std::vector<Row> rows;    ///< List containing the position of all the existing rows
 		};
 
+		/** A rasterized glyph that wasn't written to the page texture yet */
+		struct GlyphBitmap
+		{
+			GlyphBitmap() : codePoint(0), width(0), height(0) {}
+
+			Uint32             codePoint;
+			Glyph              glyph;
+			unsigned int       width;   ///< Width of the bitmap, including the padding
+			unsigned int       height;  ///< Height of the bitmap, including the padding
+			std::vector<Uint8> pixels;  ///< RGBA pixels of the bitmap
+		};
+
+		class PrewarmJob;
+		friend class PrewarmJob;
+
 		void cleanup();
 
+		Page& getPage(unsigned int characterSize) const;
+
+		Glyph * findGlyph(Page& page, Uint32 codePoint, bool bold, Float outlineThickness) const;
+
+		const Glyph& storeGlyph(Page& page, Uint32 codePoint, bool bold, Float outlineThickness, const Glyph& glyph) const;
+
 		Glyph loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, Float outlineThickness) const;
 
+		void rasterizeGlyph(void* library, void* face, void* stroker, Uint32 codePoint, bool bold, Float outlineThickness, GlyphBitmap& bitmap) const;
+
+		Rect placeGlyph(Page& page, GlyphBitmap& bitmap) const;
+
+		void addGlyphBitmaps(Page& page, std::vector<GlyphBitmap>& bitmaps, bool bold, Float outlineThickness);
+
 		Rect findGlyphRect(Page& page, unsigned int width, unsigned int height) const;
 
 		bool setCurrentSize(unsigned int characterSize) const;
@@ -87,6 +137,10 @@ class EE_API FontTrueType : public Font {
 		SafeDataPointer            mMemCopy;
 		Font::Info                 mInfo;        ///< Information about the font
 		mutable PageTable          mPages;       ///< Table containing the glyphs pages by character size
+		mutable HashIndex<Page*>   mPageIndex;   ///< Flat index of mPages
+		std::string                mFilePath;    ///< The file the font was loaded from, used to open a face per prewarm job
+		const void*                mMemoryData;  ///< The memory the font was loaded from, used to open a face per prewarm job
+		std::size_t                mMemorySize;
 		mutable std::vector<Uint8> mPixelBuffer; ///< Pixel buffer holding a glyph's pixels before being written to the texture
 };
 
@@ -146,6 +146,9 @@ class EE_API Image {
 		/** Fill the image with a color */
 		virtual void fillWithColor( const Color& Color );
 
+		/** Multiplies the color of every pixel by its alpha ( only for RGBA images ) */
+		virtual void premultiplyAlpha();
+
 		/** Copy the image to this image data, starting from the position x,y */
 		virtual void copyImage( Graphics::Image * image, const Uint32& x = 0, const Uint32& y = 0 );
 
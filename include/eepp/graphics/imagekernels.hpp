@@ -0,0 +1,59 @@
+#ifndef EE_GRAPHICSIMAGEKERNELS_HPP
+#define EE_GRAPHICSIMAGEKERNELS_HPP
+
+#include <eepp/core.hpp>
+#include <eepp/system/color.hpp>
+using namespace EE::System;
+
+namespace EE { namespace Graphics {
+
+/** @brief The pixel processing kernels used by Image, Texture and SubTexture.
+**	Every kernel works over a contiguous run of pixels ( usually a row or the whole image ), so the callers only loop over the rows.
+**	The kernels are vectorized with SSE2 on x86 ( with the SSSE3 shuffles when the compiler targets it ) and NEON on ARM,
+**	and fall back to scalar code on the other targets.
+**	The results are the same with every instruction set. */
+class EE_API ImageKernels {
+	public:
+		/** @return The name of the instruction set used by the kernels: "SSSE3", "SSE2", "NEON" or "Scalar" */
+		static const char * getInstructionSet();
+
+		/** Fills the pixels with a color.
+		**	@param dst The first pixel to fill
+		**	@param count The number of pixels to fill
+		**	@param channels The number of channels of the pixels ( from 1 to 4 ), only the first channels components of the color are used */
+		static void fill( Uint8 * dst, const Uint32& count, const Uint32& channels, const Color& color );
+
+		/** Replaces the pixels equal to the color key with a new color ( color-key masking ).
+		**	Only the first channels components of the colors are compared and written. */
+		static void replaceColor( Uint8 * dst, const Uint32& count, const Uint32& channels, const Color& colorKey, const Color& newColor );
+
+		/** Blends RGBA source pixels over RGBA destination pixels, with the same result than Color::blend.
+		**	Transparent source pixels leave the destination untouched and opaque ones are copied. */
+		static void blend( Uint8 * dst, const Uint8 * src, const Uint32& count );
+
+		/** Multiplies the color components of RGBA pixels by its alpha ( rounded to the nearest value ). */
+		static void premultiply( Uint8 * dst, const Uint32& count );
+
+		/** Converts pixels between channel counts, keeping the first components of the source pixel.
+		**	The components that the source pixel doesn't have are set to 255, as Image::getPixel does.
+		**	RGB to RGBA and RGBA to RGB have fast paths. */
+		static void convert( Uint8 * dst, const Uint32& dstChannels, const Uint8 * src, const Uint32& srcChannels, const Uint32& count );
+
+		/** Copies the alpha channel of RGBA pixels to an A8 buffer. */
+		static void extractAlpha( Uint8 * dst, const Uint8 * src, const Uint32& count );
+
+		/** Creates RGBA pixels from an A8 buffer, using the RGB components of the color given. */
+		static void expandAlpha( Uint8 * dst, const Uint8 * src, const Uint32& count, const RGB& color = RGB( 255, 255, 255 ) );
+
+		/** Rotates an image 90º clockwise ( as Image::flip does ).
+		**	@param dst The destination buffer, with space for width * height pixels. The rotated image is height pixels wide and width pixels high.
+		**	@param src The source image pixels
+		**	@param width The source image width
+		**	@param height The source image height
+		**	@param channels The number of channels of the image */
+		static void rotate90( Uint8 * dst, const Uint8 * src, const Uint32& width, const Uint32& height, const Uint32& channels );
+};
+
+}}
+
+#endif
@@ -2,6 +2,7 @@
 #define EE_PACKER_HELPER
 
 #include <eepp/graphics/base.hpp>
+#include <cstddef>
 
 namespace EE { namespace Graphics { namespace Private {
 
@@ -22,10 +23,15 @@ typedef struct sSubTextureHdrSN {
 	Int32	DestHeight;
 	Uint32	Flags;
 	Uint32	PixelDensity;
+	Uint32	Hash;		///< Hash of the image file content, 0 if unknown ( images added from memory or atlases older than version 1001 )
+	Uint32	Reserved;
 } sSubTextureHdr;
 
 #define HDR_SUBTEXTURE_FLAG_FLIPED 					( 1 << 0 )
 
+/** The size of the sub texture header of the atlases older than version 1001, it ends before the Hash */
+#define HDR_SUBTEXTURE_SIZE_1000					( offsetof( sSubTextureHdr, Hash ) )
+
 typedef struct sTextureHdrS {
 	char	Name[ HDR_NAME_SIZE ];
 	Uint32	ResourceID;
@@ -52,6 +58,7 @@ typedef struct sTextureAtlasHdrSN {
 
 #define EE_TEXTURE_ATLAS_MAGIC		( ( 'E' << 0 ) | ( 'E' << 8 ) | ( 'T' << 16 ) | ( 'A' << 24 ) )
 #define EE_TEXTURE_ATLAS_EXTENSION ".eta"
+#define EE_TEXTURE_ATLAS_VERSION 1001
 
 }}}
 
@@ -6,7 +6,8 @@
 namespace EE { namespace Graphics {
 
 /** @brief A simple particle class used by the particle system.
-**	Probably not useful for the end user. */
+**	The particle system stores its particles as arrays of attributes, a Particle is only used to describe a particle when the
+**	effect ( or the reset callback ) creates it. */
 class EE_API Particle{
 	public:
 		Particle();
@@ -3,6 +3,8 @@
 
 #include <eepp/graphics/base.hpp>
 #include <eepp/graphics/particle.hpp>
+#include <eepp/graphics/batchrenderer.hpp>
+#include <vector>
 
 namespace EE { namespace Graphics {
 
@@ -30,7 +32,11 @@ enum EE_PARTICLE_EFFECT {
 	PSE_Callback //!< Callback defined effect. Set the callback before creating the effect.
 };
 
-/** @brief Basic but powerfull Particle System */
+/** @brief Basic but powerfull Particle System
+**	The particles are stored as a structure of arrays ( one array per attribute ), and the alive particles are kept packed at
+**	the start of the arrays, so the update is a straight loop over the arrays that the compiler can vectorize. The Particle
+**	class is only used to describe a particle when it's ( re )created by the effect or the reset callback.
+**	The geometry is written directly to a vertex buffer owned by the system and drawn with a single draw call. */
 class EE_API ParticleSystem {
 	public:
 		typedef cb::Callback2<void, Particle*, ParticleSystem*> ParticleCallback;
@@ -150,11 +156,50 @@ class EE_API ParticleSystem {
 
 		/** Set The Acceleration of the effect */
 		void setAcceleration( const Vector2f& acc );
+
+		/** @brief Enables splitting the update of the particles between the JobSystem workers.
+		**	Only the effects with more than PARALLEL_UPDATE_MIN_PARTICLES particles are split. Disabled by default. */
+		void setParallelUpdate( const bool& parallel );
+
+		/** @return If the update is split between the JobSystem workers */
+		const bool& isParallelUpdate() const;
+
+		/** @return The number of particles alive */
+		const Uint32& getAliveCount() const;
+
+		/** @return The number of particles of the effect */
+		const Uint32& getCount() const;
+
+		static const Uint32 PARALLEL_UPDATE_MIN_PARTICLES = 16384;
 	private:
-		Particle *			mParticle;
+		/** A range of particles updated by a JobSystem worker */
+		struct UpdateJob {
+			ParticleSystem *	System;
+			Uint32				Start;
+			Uint32				End;
+			Float				Time;
+			Uint32				Dead;
+
+			void run();
+		};
+
+		std::vector<Float>	mX;
+		std::vector<Float>	mY;
+		std::vector<Float>	mXSpeed;
+		std::vector<Float>	mYSpeed;
+		std::vector<Float>	mXAcc;
+		std::vector<Float>	mYAcc;
+		std::vector<Float>	mR;
+		std::vector<Float>	mG;
+		std::vector<Float>	mB;
+		std::vector<Float>	mA;
+		std::vector<Float>	mAlphaDecays;
+		std::vector<Uint32>	mIds;
+		std::vector<eeVertex>	mVertexs;
+		std::vector<UpdateJob>	mJobs;
 		Uint32				mPCount;
 		Uint32				mTexId;
-		Uint32				mPLeft;
+		Uint32				mPLeft;		//! The particles alive, stored in [0, mPLeft)
 		Uint32				mLoops;
 
 		EE_PARTICLE_EFFECT	mEffect;
@@ -177,11 +222,22 @@ class EE_API ParticleSystem {
 		bool				mLoop;
 		bool				mUsed;
 		bool				mPointsSup;
+		bool				mParallelUpdate;
 
 		void begin();
 
 		virtual void reset( Particle * P );
 
+		void resetParticle( const Uint32& index );
+
+		void removeParticle( const Uint32& index );
+
+		Uint32 integrate( const Uint32& start, const Uint32& end, const Float& time );
+
+		Uint32 integrateParallel( const Float& time );
+
+		void writeVertexs();
+
 		ParticleCallback mPC;
 };
 
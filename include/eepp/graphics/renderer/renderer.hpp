@@ -5,6 +5,7 @@
 #include <eepp/graphics/shaderprogram.hpp>
 #include <eepp/graphics/renderer/rendererhelper.hpp>
 #include <eepp/graphics/renderer/clippingmask.hpp>
+#include <eepp/graphics/renderer/vertexstreambuffer.hpp>
 
 namespace EE { namespace Graphics {
 
@@ -16,6 +17,7 @@ class RendererGL;
 class RendererGL3;
 class RendererGL3CP;
 class RendererGLES2;
+class RendererNull;
 
 /** @brief This class is an abstraction of some OpenGL functionality.
 *	eepp have 4 different rendering pipelines: OpenGL 2, OpenGL 3, OpenGL 3 Core Profile and OpenGL ES 2. This abstraction is to encapsulate this pipelines.
@@ -71,33 +73,38 @@ class EE_API Renderer {
 
 		Uint32 getTextureOpEnum( const EE_TEXTURE_OP& Type );
 
-		void clear ( unsigned int mask );
+		virtual void clear ( unsigned int mask );
 
-		void clearColor ( float red, float green, float blue, float alpha );
+		virtual void clearColor ( float red, float green, float blue, float alpha );
 
-		void scissor ( int x, int y, int width, int height );
+		virtual void scissor ( int x, int y, int width, int height );
 
-		void polygonMode( unsigned int face, unsigned int mode );
+		virtual void polygonMode( unsigned int face, unsigned int mode );
 
-		std::string getExtensions();
+		virtual std::string getExtensions();
 
-		const char * getString( unsigned int name );
+		virtual const char * getString( unsigned int name );
 
-		void drawArrays ( unsigned int mode, int first, int count );
+		virtual void drawArrays ( unsigned int mode, int first, int count );
 
-		void drawElements( unsigned int mode, int count, unsigned int type, const void *indices );
+		virtual void drawElements( unsigned int mode, int count, unsigned int type, const void *indices );
 
-		void bindTexture( unsigned int target, unsigned int texture );
+		virtual void bindTexture( unsigned int target, unsigned int texture );
 
-		void activeTexture( unsigned int texture );
+		virtual void activeTexture( unsigned int texture );
 
-		void blendFunc( unsigned int sfactor, unsigned int dfactor );
+		virtual void blendFunc( unsigned int sfactor, unsigned int dfactor );
 
-		void viewport( int x, int y, int width, int height );
+		virtual void blendFuncSeparate( unsigned int sfactorRGB, unsigned int dfactorRGB, unsigned int sfactorAlpha, unsigned int dfactorAlpha );
+
+		virtual void viewport( int x, int y, int width, int height );
 
 		void lineSmooth( const bool& enable );
 
-		void lineWidth( float width );
+		virtual void lineWidth( float width );
+
+		/** @return The last line width set */
+		const float& getLineWidth() const;
 
 		/** Reapply the line smooth state */
 		void lineSmooth();
@@ -110,7 +117,40 @@ class EE_API Renderer {
 		/** Reapply the polygon mode */
 		void polygonMode();
 
-		void pixelStorei (unsigned int pname, int param);
+		virtual void pixelStorei (unsigned int pname, int param);
+
+		virtual void getIntegerv( unsigned int pname, int * params );
+
+		/** @brief Creates a texture from the pixels ( or replaces the texture passed as reuseTextureId ).
+		**	@param flags The SOIL flags used to create the texture
+		**	@return The texture id, 0 if failed */
+		virtual unsigned int createTexture( const unsigned char * pixels, int * width, int * height, int channels, unsigned int reuseTextureId, unsigned int flags );
+
+		virtual void deleteTextures( int n, const unsigned int * textures );
+
+		virtual void texSubImage2D( unsigned int target, int level, int xoffset, int yoffset, int width, int height, unsigned int format, unsigned int type, const void * pixels );
+
+		virtual void texParameteri( unsigned int target, unsigned int pname, int param );
+
+		/** @brief Reserves size bytes in the vertex stream of the renderer to write the vertexs in place, without copying them from client memory.
+		**	@return The memory where the vertexs must be written, or NULL if the renderer doesn't stream the vertexs ( the vertex pointers must be set with client memory ).
+		**	The vertex pointers set with pointers to this memory after unmapVertexStream() ( and until releaseVertexStream() ) don't upload the vertexs again. */
+		void * mapVertexStream( unsigned int size );
+
+		/** @brief Ends the writing started with mapVertexStream() */
+		void unmapVertexStream();
+
+		/** @brief Forgets the memory mapped with mapVertexStream(), it must be called after the draws that use it. */
+		void releaseVertexStream();
+
+		/** @return The buffer used to stream the vertexs, NULL if the renderer uses client memory for the vertex pointers. */
+		VertexStreamBuffer * getVertexStream() const;
+
+		/** @return The statistics of the vertexs and indexes streamed in the last frame ended */
+		VertexStreamBuffer::Stats getVertexStreamStats() const;
+
+		/** @brief Ends the current frame ( called by Window::display() ). */
+		virtual void endFrame();
 
 		RendererGL * getRendererGL();
 
@@ -120,6 +160,8 @@ class EE_API Renderer {
 
 		RendererGLES2 * getRendererGLES2();
 
+		RendererNull * getRendererNull();
+
 		virtual void pointSize( float size ) = 0;
 
 		virtual float pointSize() = 0;
@@ -184,7 +226,7 @@ class EE_API Renderer {
 
 		virtual unsigned int getCurrentMatrixMode() = 0;
 
-		void getViewport( int * viewport );
+		virtual void getViewport( int * viewport );
 
 		virtual int project( float objx, float objy, float objz, const float modelMatrix[16], const float projMatrix[16], const int viewport[4], float *winx, float *winy, float *winz ) = 0;
 
@@ -194,19 +236,19 @@ class EE_API Renderer {
 
 		Vector3f unProjectCurrent( const Vector3f& point );
 
-		void stencilFunc( unsigned int func, int ref, unsigned int mask );
+		virtual void stencilFunc( unsigned int func, int ref, unsigned int mask );
 
-		void stencilOp( unsigned int fail, unsigned int zfail, unsigned int zpass );
+		virtual void stencilOp( unsigned int fail, unsigned int zfail, unsigned int zpass );
 
-		void stencilMask( unsigned int mask );
+		virtual void stencilMask( unsigned int mask );
 
-		void colorMask( Uint8 red, Uint8 green, Uint8 blue, Uint8 alpha );
+		virtual void colorMask( Uint8 red, Uint8 green, Uint8 blue, Uint8 alpha );
 
-		void bindVertexArray( unsigned int array );
+		virtual void bindVertexArray( unsigned int array );
 
-		void deleteVertexArrays( int n, const unsigned int *arrays );
+		virtual void deleteVertexArrays( int n, const unsigned int *arrays );
 
-		void genVertexArrays( int n, unsigned int *arrays );
+		virtual void genVertexArrays( int n, unsigned int *arrays );
 
 		const bool& quadsSupported() const;
 
@@ -214,25 +256,25 @@ class EE_API Renderer {
 
 		ClippingMask * getClippingMask() const;
 
-		void genFramebuffers( int n, unsigned int* framebuffers );
+		virtual void genFramebuffers( int n, unsigned int* framebuffers );
 
-		void deleteFramebuffers( int n, const unsigned int* framebuffers );
+		virtual void deleteFramebuffers( int n, const unsigned int* framebuffers );
 
-		void bindFramebuffer( unsigned int target, unsigned int framebuffer );
+		virtual void bindFramebuffer( unsigned int target, unsigned int framebuffer );
 
-		void framebufferTexture2D( unsigned int target, unsigned int attachment, unsigned int textarget, unsigned int texture, int level );
+		virtual void framebufferTexture2D( unsigned int target, unsigned int attachment, unsigned int textarget, unsigned int texture, int level );
 
-		void genRenderbuffers( int n, unsigned int * renderbuffers );
+		virtual void genRenderbuffers( int n, unsigned int * renderbuffers );
 
-		void deleteRenderbuffers( int n, const unsigned int* renderbuffers );
+		virtual void deleteRenderbuffers( int n, const unsigned int* renderbuffers );
 
-		void bindRenderbuffer( unsigned int target, unsigned int renderbuffer);
+		virtual void bindRenderbuffer( unsigned int target, unsigned int renderbuffer);
 
-		void renderbufferStorage( unsigned int target, unsigned int internalformat, int width, int height );
+		virtual void renderbufferStorage( unsigned int target, unsigned int internalformat, int width, int height );
 
-		void framebufferRenderbuffer( unsigned int target, unsigned int attachment, unsigned int renderbuffertarget, unsigned int renderbuffer );
+		virtual void framebufferRenderbuffer( unsigned int target, unsigned int attachment, unsigned int renderbuffertarget, unsigned int renderbuffer );
 
-		unsigned int checkFramebufferStatus( unsigned int target );
+		virtual unsigned int checkFramebufferStatus( unsigned int target );
 	protected:
 		static Renderer * sSingleton;
 
@@ -250,6 +292,15 @@ class EE_API Renderer {
 		unsigned int	mCurVAO;
 
 		ClippingMask * mClippingMask;
+		VertexStreamBuffer * mVertexStream;
+		VertexStreamBuffer * mIndexStream;
+
+		/** @brief Creates the buffers to stream the vertexs and the indexes passed in client memory */
+		void createVertexStreams();
+
+		/** @return The pointer to pass to the vertex attribute: the offset in the vertex stream where the client memory was uploaded.
+		**	An allocate of 0 means that the pointer is an offset in a buffer bound by the caller, and it's returned as is. */
+		const void * streamVertexPointer( const void * pointer, unsigned int allocate );
 	private:
 		void writeExtension( Uint8 Pos, Uint32 BitWrite );
 
@@ -111,7 +111,6 @@ class EE_API RendererGL3CP : public Renderer {
 		ShaderProgram *		mShaders[ EEGL3CP_SHADERS_COUNT ];
 		ShaderProgram *		mCurShader;
 		unsigned int					mVAO;
-		unsigned int					mVBO[ 8 ];
 		int					mAttribsLoc[ EEGL_ARRAY_STATES_COUNT ];
 		int					mAttribsLocStates[ EEGL_ARRAY_STATES_COUNT ];
 		int					mPlanes[ EE_MAX_PLANES ];
@@ -125,9 +124,6 @@ class EE_API RendererGL3CP : public Renderer {
 		int					mTextureUnits[ EE_MAX_TEXTURE_UNITS ];
 		int					mTextureUnitsStates[ EE_MAX_TEXTURE_UNITS ];
 		int					mCurActiveTex;
-		unsigned int					mCurTexCoordArray;
-		Uint32					mVBOSizeAlloc;
-		Uint32					mBiggestAlloc;
 		bool					mLoaded;
 		std::string				mBaseVertexShader;
 
@@ -136,8 +132,6 @@ class EE_API RendererGL3CP : public Renderer {
 		void planeStateCheck( bool tryEnable );
 
 		void reloadShader( ShaderProgram * Shader );
-
-		void allocateBuffers( const Uint32& size );
 };
 
 }}
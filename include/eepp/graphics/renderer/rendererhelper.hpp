@@ -26,7 +26,9 @@ enum EEGL_extensions  {
 	EEGL_ARB_vertex_array_object,
 	EEGL_EXT_blend_func_separate,
 	EEGL_IMG_texture_compression_pvrtc,
-	EEGL_OES_compressed_ETC1_RGB8_texture
+	EEGL_OES_compressed_ETC1_RGB8_texture,
+	EEGL_ARB_map_buffer_range,
+	EEGL_ARB_buffer_storage
 };
 
 enum EEGL_version {
@@ -35,6 +37,7 @@ enum EEGL_version {
 	GLv_3CP,
 	GLv_ES1,
 	GLv_ES2,
+	GLv_NULL,
 	GLv_default
 };
 
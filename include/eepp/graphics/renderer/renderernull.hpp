@@ -0,0 +1,310 @@
+#ifndef EE_GRAPHICS_CRENDERERNULL_HPP
+#define EE_GRAPHICS_CRENDERERNULL_HPP
+
+#include <eepp/graphics/renderer/renderer.hpp>
+
+namespace EE { namespace Graphics {
+
+namespace Private {
+class MatrixStack;
+}
+
+/** @brief A renderer that doesn't need a GPU nor an OpenGL context.
+**	Every command received is recorded in a command stream instead of being sent to OpenGL ( state changes, matrix operations,
+**	texture binds, draw calls, and the bytes uploaded by the vertex arrays and the textures ), and the commands are counted
+**	in the statistics of the frame. The matrices are kept in the CPU, so the projection functions work as with any other renderer.
+**	It's created with the GLv_NULL version, and it's the renderer used by the null window backend. The frame ends with
+**	Window::display(), or calling endFrame().
+**	@code
+	EE::Window::Window * win = Engine::instance()->createWindow( WindowSettings( 1024, 768, "", WindowStyle::Default, WindowBackend::Null ), ContextSettings( false, GLv_NULL ) );
+
+	drawScene();
+	win->display();
+
+	const RendererNull::FrameStats& stats = GLi->getRendererNull()->getFrameStats();
+	std::cout << stats.DrawCalls << " draw calls" << std::endl;
+	std::cout << GLi->getRendererNull()->dumpCommands();
+	@endcode */
+class EE_API RendererNull : public Renderer {
+	public:
+		enum CommandType {
+			CMD_CLEAR,
+			CMD_CLEAR_COLOR,
+			CMD_VIEWPORT,
+			CMD_SCISSOR,
+			CMD_ENABLE,
+			CMD_DISABLE,
+			CMD_BLEND_FUNC,
+			CMD_LINE_WIDTH,
+			CMD_POINT_SIZE,
+			CMD_POLYGON_MODE,
+			CMD_PIXEL_STORE,
+			CMD_STENCIL,
+			CMD_COLOR_MASK,
+			CMD_SET_SHADER,
+			CMD_TEX_ENV,
+			CMD_CLIP_PLANE,
+			CMD_CLIENT_STATE,
+			CMD_ACTIVE_TEXTURE,
+			CMD_BIND_TEXTURE,
+			CMD_BIND_VERTEX_ARRAY,
+			CMD_BIND_FRAMEBUFFER,
+			CMD_MATRIX_MODE,
+			CMD_PUSH_MATRIX,
+			CMD_POP_MATRIX,
+			CMD_LOAD_MATRIX,
+			CMD_MULT_MATRIX,
+			CMD_VERTEX_POINTER,
+			CMD_COLOR_POINTER,
+			CMD_TEXCOORD_POINTER,
+			CMD_DRAW_ARRAYS,
+			CMD_DRAW_ELEMENTS,
+			CMD_TEXTURE_CREATE,
+			CMD_TEXTURE_UPDATE,
+			CMD_TEXTURE_DELETE,
+			CMD_TEXTURE_PARAMETER,
+			CMD_COUNT
+		};
+
+		/** @brief A recorded command. The meaning of the parameters depends on the command type ( see dumpCommands() ). */
+		struct Command {
+			CommandType		Type;
+			Uint32			Param[4];	//! Enums, ids and integer arguments
+			Float			Value[4];	//! Float arguments
+			Uint32			Bytes;		//! The bytes uploaded by the command
+		};
+
+		struct FrameStats {
+			Uint32	Commands;
+			Uint32	DrawCalls;
+			Uint32	Vertexs;			//! Vertexs drawn with drawArrays and indexes drawn with drawElements
+			Uint32	TextureBinds;
+			Uint32	TextureChanges;		//! Binds that changed the texture bound
+			Uint32	StateChanges;		//! Enable, disable, blending, scissor, shader, stencil, viewport, framebuffer, etc
+			Uint32	MatrixOps;
+			Uint32	TextureUploads;		//! Textures created or updated
+			Uint64	VertexBytes;		//! The bytes of the vertex arrays passed to the pointer functions
+			Uint64	TextureBytes;		//! The bytes of the pixels uploaded to the textures
+			Uint32	CommandsByType[ CMD_COUNT ];
+
+			FrameStats();
+
+			void reset();
+
+			Uint64 getBytesUploaded() const;
+		};
+
+		/** @return The name of the command type */
+		static const char * getCommandName( const CommandType& type );
+
+		RendererNull();
+
+		~RendererNull();
+
+		EEGL_version version();
+
+		std::string versionStr();
+
+		void init();
+
+		/** @brief Keeps the commands received ( enabled by default ). If disabled only the statistics are updated. */
+		void setRecording( const bool& recording );
+
+		const bool& isRecording() const;
+
+		/** @brief Ends the current frame: the statistics and the commands of the frame become the frame stats and the frame commands. */
+		void endFrame();
+
+		/** @return The number of frames ended */
+		const Uint32& getFrameCount() const;
+
+		/** @return The statistics of the frame in progress */
+		const FrameStats& getStats() const;
+
+		/** @return The statistics of the last frame ended */
+		const FrameStats& getFrameStats() const;
+
+		/** @return The commands of the frame in progress */
+		const std::vector<Command>& getCommands() const;
+
+		/** @return The commands of the last frame ended */
+		const std::vector<Command>& getFrameCommands() const;
+
+		/** @brief Drops the commands and resets the statistics of the frame in progress */
+		void clearCommands();
+
+		/** @return The commands in a human readable format, one per line.
+		**	@param lastFrame If true dumps the commands of the last frame ended, otherwise the commands of the frame in progress. */
+		std::string dumpCommands( bool lastFrame = true ) const;
+
+		/** @return The texture bound in the active texture unit */
+		unsigned int getTextureBound() const;
+
+		void clear ( unsigned int mask );
+
+		void clearColor ( float red, float green, float blue, float alpha );
+
+		void scissor ( int x, int y, int width, int height );
+
+		void polygonMode( unsigned int face, unsigned int mode );
+
+		std::string getExtensions();
+
+		const char * getString( unsigned int name );
+
+		void drawArrays ( unsigned int mode, int first, int count );
+
+		void drawElements( unsigned int mode, int count, unsigned int type, const void *indices );
+
+		void bindTexture( unsigned int target, unsigned int texture );
+
+		void activeTexture( unsigned int texture );
+
+		void blendFunc( unsigned int sfactor, unsigned int dfactor );
+
+		void blendFuncSeparate( unsigned int sfactorRGB, unsigned int dfactorRGB, unsigned int sfactorAlpha, unsigned int dfactorAlpha );
+
+		void viewport( int x, int y, int width, int height );
+
+		void lineWidth( float width );
+
+		void pixelStorei( unsigned int pname, int param );
+
+		void getIntegerv( unsigned int pname, int * params );
+
+		unsigned int createTexture( const unsigned char * pixels, int * width, int * height, int channels, unsigned int reuseTextureId, unsigned int flags );
+
+		void deleteTextures( int n, const unsigned int * textures );
+
+		void texSubImage2D( unsigned int target, int level, int xoffset, int yoffset, int width, int height, unsigned int format, unsigned int type, const void * pixels );
+
+		void texParameteri( unsigned int target, unsigned int pname, int param );
+
+		void pointSize( float size );
+
+		float pointSize();
+
+		void clientActiveTexture( unsigned int texture );
+
+		void disable( unsigned int cap );
+
+		void enable( unsigned int cap );
+
+		void pushMatrix();
+
+		void popMatrix();
+
+		void loadIdentity();
+
+		void translatef( float x, float y, float z );
+
+		void rotatef( float angle, float x, float y, float z );
+
+		void scalef( float x, float y, float z );
+
+		void matrixMode ( unsigned int mode );
+
+		void ortho( float left, float right, float bottom, float top, float zNear, float zFar );
+
+		void lookAt( float eyeX, float eyeY, float eyeZ, float centerX, float centerY, float centerZ, float upX, float upY, float upZ );
+
+		void perspective( float fovy, float aspect, float zNear, float zFar );
+
+		void enableClientState( unsigned int array );
+
+		void disableClientState( unsigned int array );
+
+		void vertexPointer( int size, unsigned int type, int stride, const void *pointer, unsigned int allocate );
+
+		void colorPointer( int size, unsigned int type, int stride, const void *pointer, unsigned int allocate );
+
+		void texCoordPointer( int size, unsigned int type, int stride, const void *pointer, unsigned int allocate );
+
+		void setShader( ShaderProgram * Shader );
+
+		void clip2DPlaneEnable( const Int32& x, const Int32& y, const Int32& Width, const Int32& Height );
+
+		void clip2DPlaneDisable();
+
+		void multMatrixf( const float *m );
+
+		void clipPlane( unsigned int plane, const double *equation );
+
+		void texEnvi( unsigned int target, unsigned int pname, int param );
+
+		void loadMatrixf( const float *m );
+
+		void frustum( float left, float right, float bottom, float top, float near_val, float far_val );
+
+		void getCurrentMatrix( unsigned int mode, float * m );
+
+		unsigned int getCurrentMatrixMode();
+
+		int project( float objx, float objy, float objz, const float modelMatrix[16], const float projMatrix[16], const int viewport[4], float *winx, float *winy, float *winz );
+
+		int unProject( float winx, float winy, float winz, const float modelMatrix[16], const float projMatrix[16], const int viewport[4], float *objx, float *objy, float *objz );
+
+		void stencilFunc( unsigned int func, int ref, unsigned int mask );
+
+		void stencilOp( unsigned int fail, unsigned int zfail, unsigned int zpass );
+
+		void stencilMask( unsigned int mask );
+
+		void colorMask( Uint8 red, Uint8 green, Uint8 blue, Uint8 alpha );
+
+		void bindVertexArray( unsigned int array );
+
+		void deleteVertexArrays( int n, const unsigned int *arrays );
+
+		void genVertexArrays( int n, unsigned int *arrays );
+
+		void genFramebuffers( int n, unsigned int* framebuffers );
+
+		void deleteFramebuffers( int n, const unsigned int* framebuffers );
+
+		void bindFramebuffer( unsigned int target, unsigned int framebuffer );
+
+		void framebufferTexture2D( unsigned int target, unsigned int attachment, unsigned int textarget, unsigned int texture, int level );
+
+		void genRenderbuffers( int n, unsigned int * renderbuffers );
+
+		void deleteRenderbuffers( int n, const unsigned int* renderbuffers );
+
+		void bindRenderbuffer( unsigned int target, unsigned int renderbuffer );
+
+		void renderbufferStorage( unsigned int target, unsigned int internalformat, int width, int height );
+
+		void framebufferRenderbuffer( unsigned int target, unsigned int attachment, unsigned int renderbuffertarget, unsigned int renderbuffer );
+
+		unsigned int checkFramebufferStatus( unsigned int target );
+	protected:
+		Private::MatrixStack *	mStack;
+		unsigned int			mCurrentMode;
+		std::vector<Command>	mCommands;
+		std::vector<Command>	mFrameCommands;
+		FrameStats				mStats;
+		FrameStats				mFrameStats;
+		Uint32					mFrameCount;
+		bool					mRecording;
+		float					mPointSize;
+		int						mViewport[4];
+		unsigned int			mTextureBound[ EE_MAX_TEXTURE_UNITS ];
+		unsigned int			mActiveTexture;
+		unsigned int			mFramebuffer;
+		unsigned int			mRenderbuffer;
+		unsigned int			mLastId;		//! The last texture, framebuffer, renderbuffer or vertex array id created
+
+		Command					mDiscarded;	//! The command filled when the recording is disabled
+
+		Command& record( const CommandType& type, Uint32 p0 = 0, Uint32 p1 = 0, Uint32 p2 = 0, Uint32 p3 = 0 );
+
+		void recordValues( const CommandType& type, float v0, float v1 = 0, float v2 = 0, float v3 = 0 );
+
+		void recordPointer( const CommandType& cmd, int size, unsigned int type, int stride, unsigned int allocate );
+
+		void genIds( int n, unsigned int * ids );
+};
+
+}}
+
+#endif
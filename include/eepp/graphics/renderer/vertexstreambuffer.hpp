@@ -0,0 +1,131 @@
+#ifndef EE_GRAPHICS_CVERTEXSTREAMBUFFER_HPP
+#define EE_GRAPHICS_CVERTEXSTREAMBUFFER_HPP
+
+#include <eepp/graphics/renderer/base.hpp>
+
+namespace EE { namespace Graphics {
+
+/** @brief A buffer object used as a ring to stream the vertexs drawn every frame.
+**	The vertexs are written in place in the memory returned by map(), or copied from client memory with upload(). Every write
+**	goes to a region of the buffer not used by the previous ones, so the GPU never has to wait for the CPU to replace the data that
+**	it's still drawing. Depending on the extensions available the ring is:
+**	- Persistent: The buffer is mapped once ( ARB_buffer_storage ) and it's split in three segments, the segments are reused
+**	after a fence signals that the GPU finished drawing from them ( triple buffered ). When a region doesn't fit in a segment the
+**	ring grows into a new buffer, and the old one is kept until a fence signals that the GPU finished drawing from it.
+**	- Mapped: The regions are mapped unsynchronized ( ARB_map_buffer_range ), and the buffer is orphaned when the ring wraps.
+**	- SubData: The vertexs are written into a staging memory and copied with glBufferSubData, and the buffer is orphaned when the ring wraps.
+**	The renderers ( OpenGL 3, OpenGL 3 Core Profile and OpenGL ES 2 ) share this implementation to feed the vertex pointers. */
+class EE_API VertexStreamBuffer {
+	public:
+		enum StreamMode {
+			Persistent,
+			Mapped,
+			SubData
+		};
+
+		struct Stats {
+			Uint64	BytesUploaded;
+			Uint32	Uploads;		//! Regions mapped or client memory uploaded
+			Uint32	Orphans;		//! Times the buffer was orphaned or reallocated
+			Uint32	Waits;			//! Times the CPU waited for the GPU to release a segment
+
+			Stats();
+
+			void reset();
+		};
+
+		/** @param target The buffer target ( GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER )
+		**	@param size The size in bytes of the ring */
+		VertexStreamBuffer( unsigned int target, unsigned int size );
+
+		~VertexStreamBuffer();
+
+		const StreamMode& getMode() const;
+
+		const unsigned int& getHandle() const;
+
+		const unsigned int& getSize() const;
+
+		void bind();
+
+		/** @brief Reserves size bytes of the ring and binds the buffer.
+		**	The draws using the region must be issued before streaming more data, since the ring can reuse the memory of the regions already drawn.
+		**	@return The memory where the data must be written. It's valid until unmap() is called. */
+		void * map( unsigned int size );
+
+		/** @brief Ends the writing started with map().
+		**	@return The offset of the region in the buffer */
+		unsigned int unmap();
+
+		/** @brief Copies size bytes of client memory to the ring and binds the buffer.
+		**	@return The offset of the data in the buffer */
+		unsigned int upload( const void * data, unsigned int size );
+
+		/** @brief Finds the offset in the buffer of a pointer to the last region mapped or to the last client memory uploaded.
+		**	This allows to set the vertex pointers of interleaved vertexs uploading them once.
+		**	@return True if the pointer was found */
+		bool findOffset( const void * pointer, unsigned int& offset ) const;
+
+		/** @brief Forgets the last client memory uploaded, it must be called after drawing since the client memory can be modified. */
+		void invalidate();
+
+		/** @brief Forgets the last region mapped, it must be called after the draws that use it.
+		**	With glMapBufferRange the memory returned by map() isn't valid after unmap(), and the same address can be used later by
+		**	the driver or by the client memory. */
+		void releaseMapped();
+
+		/** @brief Ends the current frame: the statistics of the frame become the frame stats. */
+		void endFrame();
+
+		/** @return The statistics of the frame in progress */
+		const Stats& getStats() const;
+
+		/** @return The statistics of the last frame ended */
+		const Stats& getFrameStats() const;
+	protected:
+		enum { SEGMENTS = 3 };
+
+		unsigned int		mTarget;
+		unsigned int		mHandle;
+		unsigned int		mSize;
+		unsigned int		mHead;
+		StreamMode			mMode;
+		Uint8 *				mPersistentData;
+		void *				mFences[ SEGMENTS ];
+		unsigned int		mSegment;
+		std::vector<Uint8>	mStaging;
+		Uint8 *				mMapData;
+		unsigned int		mMapSize;
+		unsigned int		mMapOffset;
+		const Uint8 *		mMappedBase;		//! The last region mapped, in the memory returned by map()
+		unsigned int		mMappedSize;
+		unsigned int		mMappedOffset;
+		const Uint8 *		mClientBase;		//! The last client memory uploaded
+		unsigned int		mClientSize;
+		unsigned int		mClientOffset;
+		Stats				mStats;
+		Stats				mFrameStats;
+
+		struct RetiredBuffer {
+			unsigned int	Handle;
+			void *			Fence;
+		};
+
+		std::vector<RetiredBuffer>	mRetired;	//! The persistent buffers replaced by a bigger one, until the GPU finishes using them
+
+		void create( unsigned int size );
+
+		void destroy();
+
+		void grow( unsigned int size );
+
+		void releaseRetired( bool force );
+
+		unsigned int reserve( unsigned int size );
+
+		void waitSegment( unsigned int segment );
+};
+
+}}
+
+#endif
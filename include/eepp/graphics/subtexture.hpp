@@ -5,12 +5,18 @@
 #include <eepp/graphics/texture.hpp>
 #include <eepp/math/originpoint.hpp>
 #include <eepp/graphics/drawableresource.hpp>
+#include <eepp/core/poolallocator.hpp>
 
 namespace EE { namespace Graphics {
 
 /** @brief A SubTexture is a part of a texture that represent an sprite.*/
 class EE_API SubTexture : public DrawableResource {
 	public:
+		EE_POOL_ALLOCATED( SubTexture::getAllocator )
+
+		/** @return The pool used to allocate the sub textures. */
+		static PoolAllocator& getAllocator();
+
 		/** Creates an empty SubTexture */
 		SubTexture();
 
@@ -4,6 +4,7 @@
 #include <eepp/graphics/font.hpp>
 #include <eepp/graphics/fonthelper.hpp>
 #include <eepp/graphics/fontstyleconfig.hpp>
+#include <eepp/graphics/textlayout.hpp>
 
 namespace EE { namespace Graphics {
 
@@ -116,11 +117,11 @@ class EE_API Text {
 		* @param MaxWidth The Max Width posible
 		*/
 		void shrinkText( const Uint32& MaxWidth );
+
+		/** @return The cached layout of the text: lines, line widths and glyph positions */
+		const TextLayout& getLayout();
 	protected:
-		struct VertexCoords {
-			Vector2f texCoords;
-			Vector2f position;
-		};
+		typedef TextLayout::VertexCoords VertexCoords;
 
 		String				mString;			 ///< String to display
 		Font *				mFont;			   ///< FontTrueType used to display the string
@@ -130,39 +131,24 @@ class EE_API Text {
 		Color				mFillColor;		  ///< Text fill color
 		Color				mOutlineColor;	   ///< Text outline color
 		Float				mOutlineThickness;   ///< Thickness of the text's outline
-		Sizei				mTextureSize;
-
-		mutable Rectf   	mBounds;			 ///< Bounding rectangle of the text (in local coordinates)
-		mutable bool		mGeometryNeedUpdate; ///< Does the geometry need to be recomputed?
-		mutable bool		mCachedWidthNeedUpdate;
 		mutable bool		mColorsNeedUpdate;
-
-		Float				mCachedWidth;
-		int					mNumLines;
-		int					mLargestLineCharCount;
 		Color				mFontShadowColor;
 		Uint32				mAlign;
 		Uint32				mFontHeight;
 
-		std::vector<VertexCoords>	mVertices;
-		std::vector<Color> mColors;
+		mutable TextLayout	mLayout;			 ///< Lines, glyph positions and quads, updated incrementally when the string changes
 
-		std::vector<VertexCoords>	mOutlineVertices;
+		std::vector<Color> mColors;
 		std::vector<Color> mOutlineColors;
-		std::vector<Float> mLinesWidth;
-
-		void ensureGeometryUpdate();
+		std::vector<Color> mShadowColors;
 
-		void ensureColorUpdate();
+		void updateLayoutFont();
 
-		/** Force to cache the width of the current text */
-		void cacheWidth();
+		void ensureGeometryUpdate() const;
 
-		static void addLine(std::vector<VertexCoords>& vertice, Float lineLength, Float lineTop, Float offset, Float thickness, Float outlineThickness, Sizei textureSize, Int32 centerDiffX);
-
-		static void addGlyphQuad(std::vector<VertexCoords>& vertices, Vector2f position, const EE::Graphics::Glyph& glyph, Float italic, Float outlineThickness, Sizei textureSize, Int32 centerDiffX);
+		void ensureColorUpdate();
 
-		Uint32 getTotalVertices();
+		void drawVertices( const Float& X, const Float& Y, const Vector2f& Scale, const Float& Angle, const std::vector<Color>& colors );
 };
 
 }}
@@ -0,0 +1,123 @@
+#ifndef EE_GRAPHICS_TEXTLAYOUT_HPP
+#define EE_GRAPHICS_TEXTLAYOUT_HPP
+
+#include <eepp/graphics/font.hpp>
+#include <eepp/graphics/fonthelper.hpp>
+
+namespace EE { namespace Graphics {
+
+/** @brief The cached layout of a text: the line breaks, the width of every line, the pen position of every character and the glyph quads.
+**	The layout is kept line by line, so when a range of the string is replaced only the lines that contain the range are laid out again,
+**	and the lines below only move their character indexes. Appending a character to a long text costs the layout of its last line.
+**	The outline quads are generated with the fill quads, and every pass that draws the text ( the shadow too ) reuses them. */
+class EE_API TextLayout {
+	public:
+		struct VertexCoords {
+			Vector2f texCoords;
+			Vector2f position;
+		};
+
+		struct Line {
+			Uint32		start;		///< Index of the first character of the line
+			Uint32		length;		///< Number of characters of the line, without the new line
+			Float		width;
+			Float		minX;		///< Bounds of the line, relative to the line position
+			Float		minY;
+			Float		maxX;
+			Float		maxY;
+			std::vector<Float>			positions;			///< The pen position before every character, plus the end of the line
+			std::vector<VertexCoords>	vertices;			///< The quads of the line, relative to the line position
+			std::vector<VertexCoords>	outlineVertices;
+		};
+
+		TextLayout();
+
+		/** Sets the font and the style used to lay out the text, the layout is invalidated if any of them changed.
+		**	@param characterSize The character size in pixels
+		**	@param style The Text::Style flags */
+		void setFont( Font * font, unsigned int characterSize, Uint32 style, Float outlineThickness );
+
+		/** Sets the horizontal align of the lines ( TEXT_ALIGN_LEFT, TEXT_ALIGN_CENTER or TEXT_ALIGN_RIGHT ) */
+		void setAlign( const Uint32& align );
+
+		/** Forces the layout of the whole string in the next update */
+		void invalidate();
+
+		/** Updates the layout after the characters [from, from + removed) of the string laid out were replaced by the
+		**	characters [from, from + inserted) of the new string. Only the lines that contain the replaced characters are laid out again. */
+		void replace( const String& string, Uint32 from, Uint32 removed, Uint32 inserted );
+
+		/** Lays out the whole string if the layout was invalidated or the font texture changed */
+		void update( const String& string );
+
+		const std::vector<Line>& getLines() const;
+
+		/** @return The index of the line that contains the character */
+		Uint32 getLineFromCharacter( Uint32 index ) const;
+
+		const int& getNumLines() const;
+
+		/** @return The width of the largest line */
+		const Float& getWidth() const;
+
+		const std::vector<Float>& getLinesWidth() const;
+
+		const int& getLargestLineCharCount() const;
+
+		const Rectf& getBounds() const;
+
+		/** @return The pen position before the character, without the line align */
+		Vector2f findCharacterPos( std::size_t index ) const;
+
+		/** Finds the closest cursor position to the point position */
+		Int32 findCharacterFromPos( const Vector2i& pos ) const;
+
+		/** @return The fill quads of the text, with the lines positioned and aligned */
+		const std::vector<VertexCoords>& getVertices();
+
+		/** @return The outline quads of the text, with the lines positioned and aligned */
+		const std::vector<VertexCoords>& getOutlineVertices();
+	protected:
+		Font *				mFont;
+		unsigned int		mCharacterSize;
+		Uint32				mStyle;
+		Float				mOutlineThickness;
+		Uint32				mAlign;
+		Sizei				mTextureSize;
+		bool				mNeedUpdate;
+		bool				mGeometryNeedUpdate;
+		std::vector<Line>	mLines;
+		std::vector<Float>	mLinesWidth;
+		Float				mWidth;
+		int					mNumLines;
+		int					mLargestLineCharCount;
+		Rectf				mBounds;
+		std::vector<VertexCoords>	mVertices;
+		std::vector<VertexCoords>	mOutlineVertices;
+
+		/** Metrics shared by every line laid out */
+		Float				mHSpace;
+		Float				mVSpace;
+		Float				mItalic;
+		Float				mUnderlineOffset;
+		Float				mUnderlineThickness;
+		Float				mStrikeThroughOffset;
+
+		void prepareLayout();
+
+		/** Lays out the line that starts at the character index start.
+		**	@return True if the line ends with a new line */
+		bool layoutLine( const String& string, Uint32 start, Line& line );
+
+		void updateMetrics();
+
+		void updateGeometry();
+
+		void addLine( std::vector<VertexCoords>& vertices, Float lineLength, Float lineTop, Float offset, Float outlineThickness );
+
+		void addGlyphQuad( std::vector<VertexCoords>& vertices, Vector2f position, const Glyph& glyph, Float outlineThickness );
+};
+
+}}
+
+#endif
@@ -79,6 +79,9 @@ class EE_API Texture : public Image, public Drawable, private NonCopyable {
 		/** Fill a texture with a color */
 		void fillWithColor( const Color& Color );
 
+		/** Multiplies the color of every pixel of the texture by its alpha ( only for RGBA textures ) */
+		void premultiplyAlpha();
+
 		/** Resize the texture */
 		void resize( const Uint32& newWidth, const Uint32& newHeight, EE_RESAMPLER_FILTER filter = RESAMPLER_LANCZOS4 );
 
@@ -86,6 +86,12 @@ class EE_API TextureAtlas : public ResourceManager<SubTexture> {
 		std::vector<Texture*>	mTextures;
 
 		void setTextures( std::vector<Texture*> textures );
+
+		void onResourceAdd( SubTexture * subTexture );
+
+		void onResourceRemove( SubTexture * subTexture );
+
+		void onResourcesDestroy();
 };
 
 }}
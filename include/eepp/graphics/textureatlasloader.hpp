@@ -102,9 +102,13 @@ class EE_API TextureAtlasLoader {
 		const bool&				isLoading() const;
 
 		/** @brief The function will check if the texture atlas is updated.
-			Checks if all the images inside the images path are inside the texture atlas, and if they have the same date and size, otherwise it will recreate or update the texture atlas.
+			Checks if all the images inside the images path are inside the texture atlas, and if their content didn't change ( compared by a hash of the image file ), otherwise it will update the texture atlas.
+			The update is incremental: the unchanged sub textures keep their place, the modified images with the same size are copied over the old ones,
+			and the new or resized images are placed in the free space of the atlas textures. Only the atlas textures modified are saved again.
+			@param MaxFragmentation The texture atlas is packed again from scratch when an image doesn't fit in the free space, or when the area not used
+			inside the bounds of the sub textures divided by the area of the bounds is greater than this value.
 		*/
-		bool					updateTextureAtlas( std::string TextureAtlasPath, std::string ImagesPath );
+		bool					updateTextureAtlas( std::string TextureAtlasPath, std::string ImagesPath, const Float& MaxFragmentation = 0.25f );
 
 		/** Rewrites the texture atlas file. Usefull if the SubTextures where modified and need to be updated inside the texture atlas. */
 		bool					updateTextureAtlas();
@@ -8,7 +8,9 @@
 namespace EE { namespace Graphics {
 
 /** @brief The Texture Atlas Manager is a singleton class that manages all the instances of Texture Atlases instanciated.
-	Releases the Texture Atlases instances automatically. So the user doesn't need to release any Texture Atlas instance. */
+	Releases the Texture Atlases instances automatically. So the user doesn't need to release any Texture Atlas instance.
+	It keeps an index of the SubTextures of every atlas managed, so a SubTexture is found by id without searching every atlas.
+	When more than one atlas contains a SubTexture id, the first atlas added resolves it, as when the atlases were searched in order. */
 class EE_API TextureAtlasManager : public ResourceManager<TextureAtlas> {
 	SINGLETON_DECLARE_HEADERS(TextureAtlasManager)
 
@@ -28,11 +30,11 @@ class EE_API TextureAtlasManager : public ResourceManager<TextureAtlas> {
 		TextureAtlas * loadFromPack( Pack * Pack, const std::string& FilePackPath );
 
 		/** It will search for a SubTexture Name in the texture atlases loaded.
-		*	@return The first SubTexture found with the given name in any atlas. */
+		*	@return The SubTexture with the given name of the first atlas added that contains it ( TextureAtlas::getByName of that atlas ). */
 		SubTexture * getSubTextureByName( const std::string& Name );
 
 		/** It will search for a SubTexture Id in the texture atlases loaded.
-		*	@return The first SubTexture found with the given id in any atlas. */
+		*	@return The SubTexture with the given id of the first atlas added that contains it ( TextureAtlas::getById of that atlas ). */
 		SubTexture * getSubTextureById( const Uint32& Id );
 
 		/** Search for a pattern name
@@ -59,9 +61,29 @@ class EE_API TextureAtlasManager : public ResourceManager<TextureAtlas> {
 		/** @return If warnings are being printed. */
 		const bool& getPrintWarnings() const;
 	protected:
-		bool	mWarnings;
+		friend class TextureAtlas;
+
+		bool						mWarnings;
+		HashIndex<SubTexture*>		mSubTextureIndex;
+		bool						mSubTextureIndexDirty;
 
 		TextureAtlasManager();
+
+		bool isManaged( TextureAtlas * textureAtlas );
+
+		void rebuildSubTextureIndex();
+
+		void onResourceAdd( TextureAtlas * textureAtlas );
+
+		void onResourceRemove( TextureAtlas * textureAtlas );
+
+		void onResourcesDestroy();
+
+		void onSubTextureAdd( TextureAtlas * textureAtlas, SubTexture * subTexture );
+
+		void onSubTextureRemove( TextureAtlas * textureAtlas, SubTexture * subTexture );
+
+		void onSubTexturesDestroy( TextureAtlas * textureAtlas );
 };
 
 }}
@@ -37,15 +37,24 @@
 namespace EE { namespace Graphics {
 class Image;
 
-namespace Private { class TexturePackerNode; class TexturePackerTex; }
+namespace Private { class TexturePackerNode; class TexturePackerTex; class TexturePackerBin; }
 
 using namespace Private;
 
 /** @brief The Texture Packer class is used to create new Texture Atlases.
 *	Atlases can be created indicating the texture atlas size and adding textures to the atlases.
+*	The textures added from a directory are inspected in parallel, and the images are decoded and copied to the atlas in parallel when saving.
 */
 class EE_API TexturePacker {
 	public:
+		/** The algorithm used to place the textures inside the atlas */
+		enum PackingMethod {
+			FreeList,			///< The original free list algorithm. It restarts the packing every time the atlas must grow.
+			MaxRects,			///< MaxRects with best short side fit. The best occupancy, it's the default method.
+			SkylineBottomLeft,	///< Skyline placing every texture as low as possible. Faster than MaxRects.
+			SkylineMinWaste		///< Skyline placing every texture where it wastes the least area below it.
+		};
+
 		/** Creates a new texture packer ( you will need to call SetOptions before adding any texture or image ). */
 		TexturePacker();
 
@@ -104,6 +113,17 @@ class EE_API TexturePacker {
 
 		/** @return If the texture atlas has already been saved, returns the file path to the texture atlas. */
 		const std::string& getFilepath() const;
+
+		/** Sets the algorithm used to pack the textures. It must be set before packing the textures. */
+		void setPackingMethod( const PackingMethod& method );
+
+		const PackingMethod& getPackingMethod() const;
+
+		/** @return The number of atlases generated ( the atlas plus its children ). Valid after packing the textures. */
+		Int32 getAtlasCount();
+
+		/** @return The area of the textures placed divided by the area of the atlases, for this atlas and its children. Valid after packing the textures. */
+		Float getOccupancy();
 	protected:
 		enum PackStrategy {
 			PackBig,
@@ -131,6 +151,7 @@ class EE_API TexturePacker {
 		EE_PIXEL_DENSITY				mPixelDensity;
 		bool							mSaveExtensions;
 		EE_SAVE_TYPE					mFormat;
+		PackingMethod					mPackingMethod;
 
 		TexturePacker * 				getChild() const;
 
@@ -166,6 +187,14 @@ class EE_API TexturePacker {
 
 		void							addBorderToTextures( const Int32& BorderSize );
 
+		Int32							packTexturesFreeList();
+
+		Int32							packTexturesBin();
+
+		TexturePackerBin *				createBin();
+
+		bool							growSize( Int32& width, Int32& height );
+
 		void							createChild();
 
 		bool							addPackerTex( TexturePackerTex * TPack );
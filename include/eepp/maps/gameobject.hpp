@@ -6,12 +6,19 @@
 #include <eepp/maps/maplayer.hpp>
 
 #include <eepp/graphics/graphicshelper.hpp>
+#include <eepp/core/poolallocator.hpp>
 using namespace EE::Graphics;
 
 namespace EE { namespace Maps {
 
 class EE_API GameObject {
 	public:
+		EE_POOL_ALLOCATED( GameObject::getAllocator )
+
+		/** @return The pool used to allocate the game objects. Its block fits the tile layer objects ( sub textures, sprites and
+		**	virtual objects ), bigger objects are allocated from the heap. */
+		static PoolAllocator& getAllocator();
+
 		GameObject( const Uint32& Flags, MapLayer * Layer );
 
 		virtual ~GameObject();
@@ -73,6 +80,13 @@ class EE_API GameObject {
 
 		void assignTilePos();
 
+		/** @brief Marks the baked geometry of the tile of the object as outdated ( if the object belongs to a tile layer ), or
+		**	updates the object in the spatial index of its layer ( if the object belongs to an object layer ) */
+		void invalidateTile();
+
+		/** @brief Updates the object in the spatial index of its layer ( if the object belongs to an object layer ) */
+		void invalidateBounds();
+
 		Float getRotation();
 };
 
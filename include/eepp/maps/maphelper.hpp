@@ -77,6 +77,25 @@ typedef struct sMapObjObjHdrS {
 	Uint32	PropertyCount;
 } sMapObjObjHdr;
 
+#define MAP_CHUNK_FORMAT_VERSION	(1)
+
+/** The header of the chunk index of the chunked maps ( MAP_FORMAT_CHUNKED ).
+**	The chunks are square blocks of ChunkSize x ChunkSize tiles, stored in column-major order ( x * ChunksY + y ). */
+typedef struct sMapChunkIndexHdrS {
+	Uint32	Version;
+	Uint32	ChunkSize;
+	Uint32	ChunksX;
+	Uint32	ChunksY;
+} sMapChunkIndexHdr;
+
+/** An entry of the chunk index. The chunk data are the tile records of the chunk ( in the same encoding than the legacy
+**	format: the layer bit flags of every tile followed by a sMapTileGOHdr for every layer in the flags ), compressed with zlib. */
+typedef struct sMapChunkHdrS {
+	Uint64	Offset;			//! Offset of the compressed data from the start of the chunk data block
+	Uint32	CompressedSize;
+	Uint32	Size;			//! Size of the uncompressed tile records
+} sMapChunkHdr;
+
 class GObjFlags {
 	public:
 		enum EE_GAMEOBJECT_FLAGS {
@@ -119,9 +138,15 @@ enum EE_MAP_FLAGS {
 
 #define MAP_EDITOR_DEFAULT_FLAGS ( MAP_FLAG_LIGHTS_ENABLED | MAP_FLAG_LIGHTS_BYVERTEX | MAP_FLAG_CLAMP_BORDERS | MAP_FLAG_CLIP_AREA | MAP_FLAG_DRAW_GRID | MAP_FLAG_DRAW_BACKGROUND )
 
+enum EE_MAP_FORMAT {
+	MAP_FORMAT_LEGACY,		//! The tiles of every layer are stored tile by tile and loaded all at once
+	MAP_FORMAT_CHUNKED		//! The tiles are stored in compressed chunks, loaded on demand around the view while the map is used
+};
+
 enum EE_LAYER_FLAGS {
 	LAYER_FLAG_VISIBLE			= ( 1 << 0 ),
-	LAYER_FLAG_LIGHTS_ENABLED	= ( 1 << 1 )
+	LAYER_FLAG_LIGHTS_ENABLED	= ( 1 << 1 ),
+	LAYER_FLAG_DENSE			= ( 1 << 2 )	//! Tile layers: store the plain sub texture tiles as compact records
 };
 
 }}
@@ -56,13 +56,28 @@ class EE_API MapLight {
 		const Vector2f& getPosition() const;
 
 		void setPosition( const Vector2f& newPos );
+
+		/** @brief Marks the area lit by the light as outdated, so the light manager recomputes it.
+		**	It's called by every method that changes the light, a derived light that changes the way it lights must call it. */
+		void invalidate();
+
+		/** @return If the light changed since the last time the light manager updated it */
+		const bool& isDirty() const;
+
+		/** @return The area lit by the light before the changes */
+		const Rectf& getDirtyAABB() const;
+
+		/** @brief Called by the light manager once the light changes were applied */
+		void clearDirty();
 	protected:
 		Float		mRadius;
 		Vector2f	mPos;
 		RGB		mColor;
 		LIGHT_TYPE	mType;
 		Rectf		mAABB;
+		Rectf		mDirtyAABB;
 		bool		mActive;
+		bool		mDirty;
 
 		void updateAABB();
 };
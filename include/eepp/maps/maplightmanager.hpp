@@ -4,13 +4,20 @@
 #include <eepp/maps/base.hpp>
 #include <eepp/maps/maplight.hpp>
 #include <list>
+#include <vector>
 
 namespace EE { namespace Maps {
 
 class TileMap;
 
+/** @brief Computes the light map of a TileMap.
+**	The colors are stored in a flat buffer: one color per tile corner ( shared by the neighbour tiles ) when the lights are
+**	processed by vertex, or one color per tile. The buffer is split in blocks of LIGHT_BLOCK_SIZE x LIGHT_BLOCK_SIZE colors, and
+**	only the visible blocks touched by a light that changed ( moved, resized, recolored, added or removed ) are recomputed. */
 class EE_API MapLightManager {
 	public:
+		static const Int32 LIGHT_BLOCK_SIZE = 16;
+
 		typedef std::list<MapLight*> LightsList;
 
 		MapLightManager( TileMap * Map, bool ByVertex );
@@ -38,12 +45,26 @@ class EE_API MapLightManager {
 		LightsList& getLights();
 
 		MapLight * getLightOver( const Vector2f& OverPos, MapLight * LightCurrent = NULL );
+
+		/** @brief Marks the whole light map as outdated */
+		void invalidate();
+
+		/** @brief Marks the colors lit in the area ( in map coordinates ) as outdated */
+		void invalidate( const Rectf& area );
+
+		/** @return A counter incremented every time the colors change. Useful to know if the cached colors must be updated. */
+		const Uint32& getVersion() const;
 	protected:
-		TileMap *		mMap;
-		Int32			mNumVertex;
-		Color****		mTileColors;
-		LightsList		mLights;
-		bool			mIsByVertex;
+		TileMap *			mMap;
+		Int32				mNumVertex;
+		std::vector<Color>	mColors;		//! Row-major, ( width + 1 ) x ( height + 1 ) corners by vertex, width x height by tile
+		Sizei				mColorsSize;
+		std::vector<Uint8>	mDirtyBlocks;
+		Sizei				mBlocksSize;
+		Color				mBaseColor;
+		Uint32				mVersion;
+		LightsList			mLights;
+		bool				mIsByVertex;
 
 		void allocateColors();
 
@@ -51,9 +72,15 @@ class EE_API MapLightManager {
 
 		void destroyLights();
 
+		Vector2f getColorPos( const Int32& x, const Int32& y ) const;
+
+		void updateBlock( const Int32& bx, const Int32& by );
+
 		virtual void updateByVertex();
 
 		virtual void updateByTile();
+
+		void updateColors( const Vector2i& start, const Vector2i& end );
 };
 
 }}
@@ -3,14 +3,23 @@
 
 #include <eepp/maps/maplayer.hpp>
 #include <eepp/maps/gameobject.hpp>
+#include <eepp/system/hashindex.hpp>
 #include <list>
+#include <vector>
 
 namespace EE { namespace Maps {
 
 class TileMap;
 
+/** @brief A layer of free positioned objects.
+**	The objects are kept in a spatial index ( a uniform grid of CELL_SIZE x CELL_SIZE pixels over the map ), so the layer only
+**	draws the objects that intersect the view, and the picking only tests the objects near the point.
+**	The index is updated when the objects are added, removed or moved with setPosition, and after updating them. The objects
+**	changed in any other way must be updated with invalidateGameObject. */
 class EE_API MapObjectLayer : public MapLayer {
 	public:
+		static const Int32 CELL_SIZE = 256;
+
 		enum SEARCH_TYPE {
 			SEARCH_OBJECT = 1,
 			SEARCH_POLY,
@@ -31,13 +40,43 @@ class EE_API MapObjectLayer : public MapLayer {
 
 		virtual void removeGameObject( const Vector2i& pos );
 
+		/** @return The top most object under the position ( the last one drawn ). SEARCH_POLY only looks for the polygon objects,
+		**	SEARCH_OBJECT for the other objects and SEARCH_ALL for both. */
 		virtual GameObject * getObjectOver( const Vector2i& pos, SEARCH_TYPE type = SEARCH_ALL );
 
 		virtual Uint32 getObjectCount() const;
+
+		/** @brief Appends the objects whose bounds contain the position to the list, in drawing order. */
+		void getObjectsAt( const Vector2f& pos, std::vector<GameObject*>& objects );
+
+		/** @brief Appends the objects whose bounds intersect the rectangle to the list, in drawing order. */
+		void getObjectsInRect( const Rectf& rect, std::vector<GameObject*>& objects );
+
+		/** @brief Updates the object in the spatial index.
+		**	Must be called if the object changes its position or its size without calling setPosition. */
+		void invalidateGameObject( GameObject * obj );
 	protected:
 		friend class TileMap;
 
-		ObjList		mObjects;
+		struct ObjectEntry {
+			GameObject *		Obj;
+			ObjList::iterator	It;			//! The position of the object in mObjects
+			Uint32				Order;		//! The drawing order, the objects added later are drawn later
+			Rectf				Bounds;
+			Rect				Cells;		//! The cells covered, empty if the object is in mLargeObjects
+			Uint32				Query;		//! The last query that visited the object
+		};
+
+		ObjList						mObjects;
+		std::vector<ObjectEntry>	mEntries;
+		std::vector<Uint32>			mFreeEntries;
+		HashIndex<Uint32, Uint64>	mEntryIndex;	//! Object address -> index in mEntries
+		std::vector< std::vector<Uint32> >	mCells;	//! Column-major, the entries of the objects that overlap every cell
+		std::vector<Uint32>			mLargeObjects;	//! The objects out of the grid, or too big to add them to every cell
+		Sizei						mCellsSize;
+		Uint32						mLastOrder;
+		Uint32						mQuery;
+		std::vector<Uint64>			mResults;		//! The order of the entries found in the last query ( high bits ) and the entries
 
 		MapObjectLayer( TileMap * map, Uint32 flags, std::string name = "", Vector2f offset = Vector2f(0,0) );
 
@@ -45,7 +84,19 @@ class EE_API MapObjectLayer : public MapLayer {
 
 		void deallocateLayer();
 
-		ObjList& getObjectList();
+		/** The objects must be added and removed through addGameObject and removeGameObject, so the index stays in sync */
+		const ObjList& getObjectList() const;
+
+		Rectf getObjectBounds( GameObject * obj );
+
+		void indexEntry( const Uint32& entry );
+
+		void unindexEntry( const Uint32& entry );
+
+		void updateEntry( const Uint32& entry );
+
+		/** Fills mResults with the entries whose bounds intersect the rectangle, in drawing order */
+		void queryEntries( Rectf rect );
 };
 
 }}
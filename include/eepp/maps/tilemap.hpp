@@ -19,10 +19,11 @@ using namespace EE::Graphics;
 
 namespace EE { namespace Maps {
 
-namespace Private { class UIMapNew; }
+namespace Private { class UIMapNew; class TileMapStreamer; }
 
 #define EE_MAP_LAYER_UNKNOWN eeINDEX_NOT_FOUND
 #define EE_MAP_MAGIC ( ( 'E' << 0 ) | ( 'E' << 8 ) | ( 'M' << 16 ) | ( 'P' << 24 ) )
+#define EE_MAP_MAGIC_CHUNKED ( ( 'E' << 0 ) | ( 'E' << 8 ) | ( 'M' << 16 ) | ( 'C' << 24 ) )
 
 class EE_API TileMap {
 	public:
@@ -56,9 +57,10 @@ class EE_API TileMap {
 
 		virtual bool loadFromMemory( const char * Data, const Uint32& DataSize );
 
-		virtual void saveToFile( const std::string& path );
+		/** Saves the map. The chunked format is smaller and its tiles are loaded on demand, but older versions of the engine can't load it. */
+		virtual void saveToFile( const std::string& path, const EE_MAP_FORMAT& format = MAP_FORMAT_LEGACY );
 
-		virtual void saveToStream( IOStream& IOS );
+		virtual void saveToStream( IOStream& IOS, const EE_MAP_FORMAT& format = MAP_FORMAT_LEGACY );
 
 		virtual void draw();
 
@@ -222,8 +224,39 @@ class EE_API TileMap {
 		void setGridLinesColor( const Color& Col );
 
 		const Color& setGridLinesColor() const;
+
+		/** @return True if the map was loaded from a chunked map ( MAP_FORMAT_CHUNKED ), and its tiles are loaded on demand.
+		**	The chunks visible are loaded before drawing the map, and the chunks around them are loaded in background.
+		**	The tiles of the chunks not loaded are empty. */
+		bool isStreaming() const;
+
+		/** @brief Loads every chunk not loaded of a streamed map, and stops streaming it ( the chunks are not unloaded anymore ). */
+		void loadAllChunks();
+
+		/** @return The number of chunks of a streamed map */
+		Uint32 getChunkCount() const;
+
+		/** @return The number of chunks loaded of a streamed map */
+		Uint32 getLoadedChunkCount() const;
+
+		/** @brief Sets the memory that the tiles of a streamed map can use ( 0 for unlimited ).
+		**	When the tiles loaded exceed the budget, the chunks farthest from the view are unloaded. The tiles added, removed or moved
+		**	by the layers are kept: their chunks are compressed again when they are unloaded. */
+		void setStreamingMemoryBudget( const size_t& bytes );
+
+		const size_t& getStreamingMemoryBudget() const;
+
+		/** @return The memory used by the tiles loaded of a streamed map */
+		size_t getStreamingMemoryUsed() const;
+
+		/** @brief Sets the number of chunks around the view that are loaded in background and never unloaded. */
+		void setStreamingMargin( const Uint32& chunks );
+
+		const Uint32& getStreamingMargin() const;
 	protected:
 		friend class EE::Maps::Private::UIMapNew;
+		friend class EE::Maps::Private::TileMapStreamer;
+		friend class TileMapLayer;
 
 		class ForcedHeaders
 		{
@@ -281,6 +314,9 @@ class EE_API TileMap {
 		Uint32			mLastObjId;
 		PolyObjMap		mPolyObjs;
 		ForcedHeaders*	mForcedHeaders;
+		Private::TileMapStreamer *	mStreamer;
+		size_t			mStreamingBudget;
+		Uint32			mStreamingMargin;
 
 		virtual GameObject *	createGameObject( const Uint32& Type, const Uint32& Flags, MapLayer * Layer, const Uint32& DataId = 0 );
 
@@ -305,6 +341,19 @@ class EE_API TileMap {
 		void			createLightManager();
 
 		virtual void	onMapLoaded();
+
+		/** Adds a tile read from a map file to the layer */
+		void			addTile( const Uint32& layerIndex, const sMapTileGOHdr& hdr, const Vector2i& TilePos );
+
+		/** Called by the tiled layers before a tile is added, removed or moved */
+		void			onTileEdit( const Vector2i& TilePos );
+
+		/** Appends the records of the tiles between start and end ( exclusive ) in the map file encoding, row by row */
+		void			getTileRecords( const Vector2i& start, const Vector2i& end, std::vector<Uint8>& records );
+
+		bool			loadChunkIndex( IOStream& IOS, const sMapHdr& MapHdr );
+
+		void			saveChunks( IOStream& IOS );
 };
 
 }}
@@ -3,42 +3,230 @@
 
 #include <eepp/maps/maplayer.hpp>
 #include <eepp/maps/gameobject.hpp>
+#include <eepp/graphics/batchrenderer.hpp>
+#include <eepp/system/hashindex.hpp>
+#include <vector>
+
+namespace EE { namespace Graphics {
+class SubTexture;
+}}
 
 namespace EE { namespace Maps {
 
+/** @brief A layer of tiles.
+**	The tiles are stored in a row-major array. The geometry of the static tiles ( plain sub texture objects ) is baked in chunks of
+**	CHUNK_SIZE x CHUNK_SIZE tiles and submitted in one draw call per texture, and it's only rebuilt when a tile of the chunk is added,
+**	removed or moved. The animated and custom objects are drawn and updated one by one as before, between the baked quads, so the
+**	tiles of a chunk keep the drawing order of the tile array.
+**	The chunks are drawn one after another, so the baked path is only used while every visible tile fits in its cell. If a visible
+**	tile is larger than the tile size ( or is offset outside its cell ), the visible area is drawn tile by tile without baking.
+**	A dense layer ( LAYER_FLAG_DENSE ) doesn't keep a game object for the plain sub texture tiles, it only keeps a compact record of
+**	3 bytes per tile ( the sub texture and the object flags ). The full game objects are only kept for the tiles that need them. */
 class EE_API TileMapLayer : public MapLayer {
 	public:
+		static const Int32 CHUNK_SIZE = 32;
+
+		/** @brief Iterates the non-empty tiles of a rectangle of the layer, without creating the game objects of the compact tiles.
+		**	@code
+			for ( TileMapLayer::TileIterator it = layer->getVisibleTiles(); it.next(); ) {
+				if ( it.isBlocked() ) ...
+			}
+			@endcode */
+		class EE_API TileIterator {
+			public:
+				TileIterator( TileMapLayer * layer, const Vector2i& start, const Vector2i& end );
+
+				/** @brief Moves to the next non-empty tile.
+				**	@return False when there are no more tiles */
+				bool next();
+
+				/** @return The position of the current tile */
+				const Vector2i& getTilePos() const;
+
+				/** @return The game object of the current tile, NULL if it's a compact tile */
+				GameObject * getGameObject() const;
+
+				/** @return The sub texture of the current tile, if it's a compact tile or a sub texture object */
+				Graphics::SubTexture * getSubTexture() const;
+
+				/** @return The game object flags of the current tile */
+				Uint32 getFlags() const;
+
+				/** @return If the current tile is blocked */
+				bool isBlocked() const;
+			protected:
+				TileMapLayer *	mLayer;
+				Vector2i		mStart;
+				Vector2i		mEnd;
+				Vector2i		mPos;
+				Uint32			mIndex;
+		};
+
+		/** @brief The memory used by the layer */
+		struct MemoryReport {
+			size_t	TileStorage;	//! The tile array ( or the compact records and the object index )
+			size_t	Objects;		//! The memory used by the game objects
+			size_t	ObjectCount;
+			size_t	Chunks;			//! The baked geometry
+			size_t	Total;
+		};
+
 		virtual ~TileMapLayer();
 
 		virtual void draw( const Vector2f &Offset = Vector2f(0,0) );
 
 		virtual void update( const Time& dt );
 
+		/** @brief Adds the object to the tile, the layer takes the ownership of the object.
+		**	In a dense layer the plain sub texture objects are stored as a compact record and the object is deleted. */
 		virtual void addGameObject( GameObject * obj, const Vector2i& TilePos );
 
+		/** @brief Adds a plain sub texture tile. In a dense layer it doesn't create a game object. */
+		void addSubTextureTile( Graphics::SubTexture * subTexture, const Uint32& flags, const Vector2i& TilePos );
+
 		virtual void removeGameObject( const Vector2i& TilePos );
 
 		virtual void moveTileObject( const Vector2i& FromPos, const Vector2i& ToPos );
 
+		/** @return The game object of the tile. In a dense layer, the object of a compact tile is created and kept by the layer. */
 		virtual GameObject * getGameObject( const Vector2i& TilePos );
 
+		/** @return The game object of the tile, or NULL if the tile is empty or it's a compact tile */
+		GameObject * findGameObject( const Vector2i& TilePos );
+
+		/** @return True if the tile doesn't have a game object nor a compact record */
+		bool isTileEmpty( const Vector2i& TilePos );
+
+		/** @return True if the tile is stored as a compact record */
+		bool isTileCompact( const Vector2i& TilePos );
+
+		/** @return If the tile is blocked */
+		bool isTileBlocked( const Vector2i& TilePos );
+
+		/** @return The game object flags of the tile */
+		Uint32 getTileFlags( const Vector2i& TilePos );
+
+		/** @return The game object type of the tile, 0 if the tile is empty */
+		Uint32 getTileType( const Vector2i& TilePos );
+
+		/** @return The data id of the tile object, 0 if the tile is empty */
+		Uint32 getTileDataId( const Vector2i& TilePos );
+
+		/** @return An iterator of the tiles between start ( inclusive ) and end ( exclusive ) */
+		TileIterator getTiles( const Vector2i& start, const Vector2i& end );
+
+		/** @return An iterator of the tiles visible in the map */
+		TileIterator getVisibleTiles();
+
+		/** @return If the layer uses the compact tile storage */
+		bool isDense() const;
+
+		/** @brief Switches the layer to the compact tile storage ( or back ), converting the tiles. */
+		void setDense( const bool& dense );
+
+		/** @return The memory used by the layer */
+		MemoryReport getMemoryReport();
+
 		const Vector2i& getCurrentTile() const;
 
 		Vector2i getTilePosFromPos( const Vector2f& Pos );
 
 		Vector2f getPosFromTilePos( const Vector2i& TilePos );
+
+		/** @brief Marks the baked geometry of the chunk that contains the tile as outdated.
+		**	Must be called if the object of the tile changes its sub texture or its flags after being added to the layer. */
+		void invalidateTile( const Vector2i& TilePos );
+
+		/** @brief Marks the baked geometry of every chunk as outdated */
+		void invalidateChunks();
 	protected:
 		friend class TileMap;
-
-		GameObject***	mTiles;
-		Sizei			mSize;
-		Vector2i		mCurTile;
+		friend class TileIterator;
+
+		enum TileRecordFlags {
+			TILE_HAS_OBJECT = ( 1 << 7 )	//! The game object flags only use the lower 7 bits
+		};
+
+		/** The quads of a run of static tiles that share the texture, followed by the dynamic tiles drawn before the next run */
+		struct TileChunkBatch {
+			const Texture *			Tex;
+			std::vector<eeVertex>	Vertexs;
+			std::vector<Vector2i>	Tiles;			//! The tile of every quad, used to set the light colors
+			Uint32					DynamicStart;	//! The range of TileChunk::DynamicTiles drawn after the quads
+			Uint32					DynamicEnd;
+
+			TileChunkBatch() : Tex( NULL ), DynamicStart( 0 ), DynamicEnd( 0 ) {}
+		};
+
+		struct TileChunk {
+			std::vector<TileChunkBatch>	Batches;
+			std::vector<Vector2i>		DynamicTiles;	//! The tiles that can't be baked, in drawing order
+			Uint32						LastFrame;		//! The last frame the chunk was used
+			Uint32						LightVersion;	//! The version of the light map used to set the vertex colors
+			bool						Dirty;
+			bool						Cached;			//! If the chunk is in the list of built chunks
+			bool						Lit;			//! If the vertex colors were set by the light manager
+			bool						Oversized;		//! If a tile of the chunk doesn't fit in its cell, the chunk isn't baked
+		};
+
+		GameObject**						mTiles;				//! Row-major, only used by the sparse layers
+		std::vector<Uint16>					mTileSubTextures;	//! Dense layers: index in mPalette + 1, 0 if the tile has no compact record
+		std::vector<Uint8>					mTileFlags;			//! Dense layers: the object flags of the compact tiles, or TILE_HAS_OBJECT
+		std::vector<Graphics::SubTexture*>	mPalette;			//! Dense layers: the sub textures used by the layer
+		HashIndex<Uint16>					mPaletteIndex;		//! Sub texture id -> index in mPalette
+		HashIndex<GameObject*>				mObjects;			//! Dense layers: tile index -> game object
+		Sizei								mSize;
+		Vector2i							mCurTile;
+		Sizei								mChunksSize;
+		std::vector<TileChunk>				mChunks;
+		std::vector<Uint32>					mBuiltChunks;
+		Uint32								mFrame;
 
 		TileMapLayer( TileMap * map, Sizei size, Uint32 flags, std::string name = "", Vector2f offset = Vector2f(0,0) );
 
 		void allocateLayer();
 
 		void deallocateLayer();
+
+		Uint32 getTileIndex( const Vector2i& TilePos ) const;
+
+		GameObject * getObjectAt( const Uint32& index ) const;
+
+		void setObjectAt( const Uint32& index, GameObject * obj );
+
+		Graphics::SubTexture * getCompactSubTexture( const Uint32& index ) const;
+
+		bool setCompactTile( const Uint32& index, Graphics::SubTexture * subTexture, const Uint32& flags );
+
+		void clearTile( const Uint32& index );
+
+		GameObject * createTileObject( const Uint32& index, const Vector2i& TilePos );
+
+		TileChunk& getChunk( const Vector2i& TilePos );
+
+		bool canBakeSubTexture( Graphics::SubTexture * subTexture );
+
+		bool isStaticTile( GameObject * obj );
+
+		bool fitsTile( const Vector2f& min, const Vector2f& max, const Vector2i& TilePos );
+
+		void bakeTile( TileChunk& chunk, Graphics::SubTexture * subTexture, const Uint32& flags, const Vector2f& pos, const Vector2i& TilePos );
+
+		void addDynamicTile( TileChunk& chunk, GameObject * obj, const Vector2i& TilePos );
+
+		void buildChunk( TileChunk& chunk, const Vector2i& ChunkPos );
+
+		void releaseChunk( TileChunk& chunk );
+
+		void releaseUnusedChunks();
+
+		void updateChunkColors( TileChunk& chunk, const bool& lit );
+
+		void drawChunk( TileChunk& chunk, const Vector2i& start, const Vector2i& end );
+
+		void drawDynamicTiles( TileChunk& chunk, const Uint32& from, const Uint32& to, const Vector2i& start, const Vector2i& end );
+
+		void drawTiles( const Vector2i& start, const Vector2i& end );
 };
 
 }}
@@ -6,9 +6,11 @@
 #include <eepp/network/http.hpp>
 #include <eepp/network/ipaddress.hpp>
 #include <eepp/network/packet.hpp>
+#include <eepp/network/packetpool.hpp>
 #include <eepp/network/socket.hpp>
 #include <eepp/network/sockethandle.hpp>
 #include <eepp/network/socketselector.hpp>
+#include <eepp/network/socketpoller.hpp>
 #include <eepp/network/tcplistener.hpp>
 #include <eepp/network/tcpsocket.hpp>
 #include <eepp/network/udpsocket.hpp>
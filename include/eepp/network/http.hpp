@@ -6,14 +6,17 @@
 #include <eepp/network/tcpsocket.hpp>
 #include <eepp/core/noncopyable.hpp>
 #include <eepp/system/time.hpp>
-#include <eepp/system/threadlocalptr.hpp>
-#include <eepp/system/thread.hpp>
+#include <eepp/system/clock.hpp>
+#include <eepp/system/iostream.hpp>
+#include <eepp/system/condition.hpp>
 #include <eepp/system/mutex.hpp>
 #include <eepp/system/lock.hpp>
 #include <eepp/helper/PlusCallback/callback.hpp>
 #include <map>
 #include <string>
 #include <list>
+#include <deque>
+#include <vector>
 
 using namespace EE::System;
 
@@ -95,6 +98,17 @@ class EE_API Http : NonCopyable {
 
 			/** Enable/disable SSL hostname validation */
 			void setValidateHostname( bool enable );
+
+			/** @brief Set the stream where the body of the response is written
+			**  The body is written to the stream while it's received, instead
+			**  of being kept in the response, so big downloads never need to be
+			**  fully buffered in memory. The stream must be valid until the
+			**  response is received.
+			**  @param stream The stream to write the body, NULL to keep the body in the response */
+			void setResponseStream( IOStream * stream );
+
+			/** @return The stream where the body of the response is written ( NULL by default ) */
+			IOStream * getResponseStream() const;
 		private:
 			friend class Http;
 
@@ -122,6 +136,7 @@ class EE_API Http : NonCopyable {
 			std::string		mBody;					///< Body of the request
 			bool			mValidateCertificate;	///< Validates the SSL certificate in case of an HTTPS request
 			bool			mValidateHostname;		///< Validates the hostname in case of an HTTPS request
+			IOStream *		mResponseStream;		///< Stream to write the body of the response
 		};
 
 		/** @brief Define a HTTP response */
@@ -161,7 +176,8 @@ class EE_API Http : NonCopyable {
 
 				// 10xx: Custom codes
 				InvalidResponse		= 1000, ///< Response is not a valid HTTP one
-				ConnectionFailed	= 1001  ///< Connection with server failed
+				ConnectionFailed	= 1001, ///< Connection with server failed
+				TimedOut			= 1002  ///< The response wasn't received before the timeout
 			};
 
 			/** @brief Default constructor
@@ -205,11 +221,11 @@ class EE_API Http : NonCopyable {
 			private :
 			friend class Http;
 
-			/** @brief Construct the header from a response string
+			/** @brief Construct the header from a response header string
 			**  This function is used by Http to build the response
-			**  of a request.
-			**  @param data Content of the response to parse */
-			void parse(const std::string& data);
+			**  of a request, the body is read later from the connection.
+			**  @param data Status line and fields of the response to parse */
+			void parseHeader(const std::string& data);
 
 			/** @brief Read values passed in the answer header
 			**  This function is used by Http to extract values passed
@@ -262,11 +278,16 @@ class EE_API Http : NonCopyable {
 		**  You must have a valid host before sending a request (see SetHost).
 		**  Any missing mandatory header field in the request will be added
 		**  with an appropriate value.
+		**  The connections are kept alive unless the request or the server
+		**  asks to close them ( "Connection: close" ), and they are reused by the
+		**  next requests to the same host, including the async requests.
 		**  Warning: this function waits for the server's response and may
 		**  not return instantly; use a thread if you don't want to block your
 		**  application, or use a timeout to limit the time to wait. A value
 		**  of Time::Zero means that the client will use the system defaut timeout
-		**  (which is usually pretty long).
+		**  (which is usually pretty long). The timeout limits the whole request
+		**  ( connecting and receiving the response ) for HTTP, and only the
+		**  connection for HTTPS.
 		**  @param request Request to send
 		**  @param timeout Maximum time to wait
 		**  @return Server's response */
@@ -275,10 +296,44 @@ class EE_API Http : NonCopyable {
 		/** Definition of the async callback response */
 		typedef cb::Callback3<void, const Http&, Http::Request&, Http::Response&>		AsyncResponseCallback;
 
-		/** @brief Sends the request and creates a new thread, when got the response informs the result to the callback.
+		/** Identifies an async request, 0 is never a valid handle */
+		typedef Uint64 AsyncHandle;
+
+		/** @brief Sends the request from a thread of the Http instance, when got the response informs the result to the callback.
 		**	This function does not lock the caller thread.
-		**  @see SendRequest */
-		void sendAsyncRequest( AsyncResponseCallback cb, const Http::Request& request, Time timeout = Time::Zero );
+		**	The requests are queued and at most getMaxAsyncRequests of them are sent at the same time to the host, by that same
+		**	number of threads at most. The threads wait for the network, so they are not the JobSystem workers. The callback is
+		**	called from the thread, or queued until processAsyncResponses is called if setQueueAsyncResponses is enabled.
+		**  @see SendRequest
+		**  @return The handle of the request, to cancel it */
+		AsyncHandle sendAsyncRequest( AsyncResponseCallback cb, const Http::Request& request, Time timeout = Time::Zero );
+
+		/** @brief Cancels an async request, its callback won't be called
+		**	A request already being sent stops waiting for the response ( only for HTTP, an HTTPS request
+		**	finishes before being discarded ).
+		**	@return True if the request was pending, false if it already finished or its callback was already called */
+		bool cancelAsyncRequest( const AsyncHandle& handle );
+
+		/** @return The number of async requests queued, running or with their response queued */
+		Uint32 getPendingAsyncRequestCount();
+
+		/** @brief Set the maximum number of async requests sent at the same time to the host ( 4 by default )
+		**	It's also the maximum number of threads sending the async requests. */
+		void setMaxAsyncRequests( const Uint32& count );
+
+		/** @return The maximum number of async requests sent at the same time to the host */
+		const Uint32& getMaxAsyncRequests() const;
+
+		/** @brief Enables queueing the responses of the async requests instead of calling the callback from the worker
+		**	The queued responses are delivered by processAsyncResponses, so the callbacks can run in the main thread. */
+		void setQueueAsyncResponses( bool queue );
+
+		/** @return If the responses of the async requests are queued */
+		const bool& isQueueAsyncResponses() const;
+
+		/** @brief Calls the callbacks of the queued responses from the calling thread
+		**	@return The number of callbacks called */
+		Uint32 processAsyncResponses();
 
 		/** @return The host address */
 		const IpAddress& getHost() const;
@@ -288,30 +343,85 @@ class EE_API Http : NonCopyable {
 
 		/** @return The host port */
 		const unsigned short& getPort() const;
+
+		/** @brief Set the maximum number of idle connections kept alive to be reused ( 4 by default )
+		**  The connections in use are not limited, but the ones over the maximum
+		**  are closed when their request finishes. */
+		void setMaxConnections( const unsigned int& count );
+
+		/** @return The maximum number of idle connections kept alive */
+		const unsigned int& getMaxConnections() const;
+
+		/** @return The number of idle connections kept alive */
+		unsigned int getIdleConnectionCount();
+
+		/** @brief Closes the idle connections kept alive */
+		void closeConnections();
 	private:
-		class AsyncRequest : public Thread {
+		class AsyncRequest {
 			public:
-				AsyncRequest( Http * http, AsyncResponseCallback cb, Http::Request request, Time timeout );
-
-				void run();
+				AsyncRequest( AsyncHandle handle, AsyncResponseCallback cb, Http::Request request, Time timeout );
 			protected:
 				friend class Http;
-				Http *					mHttp;
+				AsyncHandle				mHandle;
 				AsyncResponseCallback	mCb;
 				Http::Request			mRequest;
+				Http::Response			mResponse;
 				Time					mTimeout;
-				bool					mRunning;
+				volatile bool			mCancelled;
 		};
 		friend class AsyncRequest;
-		ThreadLocalPtr<TcpSocket>		mConnection;	///< Connection to the host
+
+		class AsyncWorker;
+		friend class AsyncWorker;
+
+		/** @brief A connection to a host, kept alive while it's idle */
+		struct Connection {
+			TcpSocket *		Socket;
+			IpAddress		Host;
+			unsigned short	Port;
+			bool			SSL;
+			bool			ValidateCertificate;
+			bool			ValidateHostname;
+		};
+
 		IpAddress						mHost;			///< Web host address
 		std::string						mHostName;		///< Web host name
 		unsigned short					mPort;			///< Port used for connection with host
-		std::list<AsyncRequest*>		mThreads;
-		Mutex							mThreadsMutex;
+		std::map<AsyncHandle, AsyncRequest*>	mRequests;	///< Every async request not finished yet
+		std::deque<AsyncRequest*>		mQueuedRequests;	///< The async requests waiting to be sent
+		std::deque<AsyncRequest*>		mResponses;			///< The async requests waiting for processAsyncResponses
+		std::vector<AsyncWorker*>		mWorkers;			///< The threads sending the async requests, including the finished ones not deleted yet
+		Condition						mWorkersCond;		///< 1 when an idle thread must wake up
+		Mutex							mRequestsMutex;
+		AsyncHandle						mLastHandle;
+		Uint32							mMaxAsyncRequests;
+		Uint32							mWorkerCount;		///< The threads not finished
+		Uint32							mIdleWorkers;		///< The threads waiting for requests
+		bool							mRunning;
+		bool							mQueueResponses;
+		std::list<Connection>			mConnections;	///< Idle connections kept alive, the last used at the front
+		Mutex							mConnectionsMutex;
+		unsigned int					mMaxConnections;
 		bool							mIsSSL;
 
-		void removeOldThreads();
+		/** @brief Sends the queued async requests, waiting for more when there are none, until the Http instance is destroyed
+		**	or the threads exceed the maximum. Runs in the async threads. */
+		void processAsyncRequests( AsyncWorker * worker );
+
+		/** @brief Sends the request, stopping if the deadline passes or the request is cancelled */
+		Response sendRequest( const Request& request, Time timeout, const volatile bool * cancelled );
+
+		/** @brief Takes an idle connection to the current host compatible with the request, or opens a new connection to the host
+		**	@return False if it fails to connect */
+		bool getConnection( const Request& request, Time timeout, Connection& connection, bool& reused );
+
+		/** @brief Returns the connection to the idle connections if it can be kept alive, otherwise closes it */
+		void releaseConnection( Connection& connection, bool keepAlive );
+
+		/** @brief Reads the response of the request from the connection
+		**  @return False if the connection was closed before receiving anything */
+		bool receiveResponse( TcpSocket * connection, const Request& request, Response& response, bool& keepAlive, const Clock& clock, Time timeout, const volatile bool * cancelled );
 };
 
 }}
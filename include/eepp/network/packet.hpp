@@ -9,6 +9,7 @@ namespace EE { namespace Network {
 
 class TcpSocket;
 class UdpSocket;
+namespace SSL { class SSLSocket; }
 
 /** @brief Utility class to build blocks of data to transfer over the network */
 class EE_API Packet {
@@ -34,6 +35,14 @@ class EE_API Packet {
 	**  @see Append */
 	void clear();
 
+	/** @brief Allocate the memory for the data, so appending up to this size doesn't reallocate
+	**  @param sizeInBytes Number of bytes to allocate */
+	void reserve(std::size_t sizeInBytes);
+
+	/** @brief Get the memory allocated for the data, which clear keeps to reuse the packet
+	**  @return Capacity, in bytes */
+	std::size_t getCapacity() const;
+
 	/** @brief Get a pointer to the data contained in the packet
 	**  Warning: the returned pointer may become invalid after
 	**  you append data to the packet, therefore it should never
@@ -129,6 +138,7 @@ class EE_API Packet {
 protected:
 	friend class TcpSocket;
 	friend class UdpSocket;
+	friend class SSL::SSLSocket;
 
 	/** @brief Called before the packet is sent over the network
 	**  This function can be defined by derived classes to
@@ -150,7 +160,9 @@ protected:
 	**  The function receives a pointer to the received data,
 	**  and must fill the packet with the transformed bytes.
 	**  The default implementation fills the packet directly
-	**  without transforming the data.
+	**  without transforming the data. When the packet is received
+	**  by a TcpSocket, it takes the buffer of the socket instead
+	**  of copying it.
 	**  @param data Pointer to the received bytes
 	**  @param size Number of bytes
 	**  @see OnSend */
@@ -171,6 +183,7 @@ private:
 	std::size_t			mReadPos; ///< Current reading position in the packet
 	std::size_t			mSendPos; ///< Current send position in the packet (for handling partial sends)
 	bool				mIsValid; ///< Reading state of the packet
+	std::vector<char>*	mReceiveBuffer; ///< Buffer of the socket receiving the packet, that can be taken instead of copied
 };
 
 }}
@@ -0,0 +1,67 @@
+#ifndef EE_NETWORKCPACKETPOOL_HPP
+#define EE_NETWORKCPACKETPOOL_HPP
+
+#include <eepp/network/base.hpp>
+#include <eepp/core/noncopyable.hpp>
+#include <eepp/system/mutex.hpp>
+#include <vector>
+using namespace EE::System;
+
+namespace EE { namespace Network {
+
+class Packet;
+
+/** @brief Recycles packets with their buffers, so sending and receiving packets often doesn't allocate memory.
+**	The packets are acquired cleared and keep the memory of their data when released. Thread-safe. */
+class EE_API PacketPool : NonCopyable {
+	public:
+		/** @brief Creates the pool
+		**	@param maxPackets Maximum number of packets kept in the pool, the packets released when it's full are deleted
+		**	@param maxPacketCapacity Maximum memory of a packet kept in the pool, the bigger packets are deleted when released */
+		PacketPool( const Uint32& maxPackets = 64, const std::size_t& maxPacketCapacity = 1024 * 1024 );
+
+		/** @brief Deletes the packets in the pool. The packets acquired must be released or deleted before. */
+		~PacketPool();
+
+		/** @return An empty packet, from the pool if there's any. */
+		Packet * acquire();
+
+		/** @brief Returns a packet acquired to the pool, or deletes it if the pool is full or the packet uses too much memory */
+		void release( Packet * packet );
+
+		/** @brief Deletes the packets in the pool */
+		void clear();
+
+		/** @return The number of packets in the pool */
+		Uint32 getCount();
+	protected:
+		Mutex					mMutex;
+		std::vector<Packet*>	mPackets;
+		Uint32					mMaxPackets;
+		std::size_t				mMaxPacketCapacity;
+};
+
+}}
+
+#endif
+
+/**
+@class PacketPool
+@ingroup Network
+
+Usage example:
+@code
+PacketPool pool;
+
+Packet * packet = pool.acquire();
+
+if ( socket.receive( *packet ) == Socket::Done ) {
+	...
+}
+
+pool.release( packet );
+@endcode
+
+When a TcpSocket receives a packet, the packet takes the buffer of the socket and the socket keeps the previous buffer
+of the packet, so receiving with packets from a pool doesn't allocate memory once the buffers are big enough.
+*/
@@ -0,0 +1,159 @@
+#ifndef EE_NETWORKCSOCKETPOLLER_HPP
+#define EE_NETWORKCSOCKETPOLLER_HPP
+
+#include <eepp/network/base.hpp>
+#include <eepp/core/noncopyable.hpp>
+#include <eepp/system/time.hpp>
+#include <vector>
+using namespace EE::System;
+
+namespace EE { namespace Network {
+
+class Socket;
+
+/** @brief Readiness multiplexer that waits for events on any number of sockets
+**	Uses epoll on Linux, poll on the other POSIX platforms and select without the FD_SETSIZE limit on Windows. */
+class EE_API SocketPoller : NonCopyable {
+	public:
+		/** @brief The events that can be watched and reported */
+		enum Event {
+			Readable		= ( 1 << 0 ),	///< The socket has data to receive, a pending connection to accept or the peer closed the connection
+			Writable		= ( 1 << 1 ),	///< The socket can send without blocking, or a non-blocking connect finished
+			Error			= ( 1 << 2 ),	///< The socket failed or was hung up. Always reported, it doesn't need to be watched
+			EdgeTriggered	= ( 1 << 3 )	///< Report the events only when they change instead of while they last. Only supported by epoll, ignored by the other backends
+		};
+
+		/** @brief The system interfaces used to wait */
+		enum Backend {
+			Auto,	///< The best backend of the platform
+			Epoll,	///< Linux only
+			Poll,	///< POSIX only
+			Select	///< Windows only
+		};
+
+		/** @brief A socket reported by wait and the events that are ready */
+		struct ReadyEvent {
+			Socket *	Sock;
+			Uint32		Events;
+		};
+
+		/** @brief Creates the poller
+		**	@param backend The backend to use. If it isn't available in the platform the best one is used.
+		**	@param wakeUpEnabled If wakeUp can interrupt the waits. It costs a pipe ( a loopback socket on Windows ), created the first
+		**	time that the poller waits, so the pollers that never call wakeUp should disable it. */
+		SocketPoller( Backend backend = Auto, bool wakeUpEnabled = true );
+
+		~SocketPoller();
+
+		/** @brief Starts watching a socket
+		**	Keeps a weak reference to the socket, it must be removed before destroying it.
+		**	@param socket The socket to watch. It must be valid ( connected, listening or bound ).
+		**	@param events The events to watch, a combination of Readable, Writable and EdgeTriggered.
+		**	@return False if the socket is not valid, is already watched or the system refused it. */
+		bool add( Socket& socket, Uint32 events = Readable );
+
+		/** @brief Changes the events watched of a socket already added
+		**	@return False if the socket is not watched. */
+		bool modify( Socket& socket, Uint32 events );
+
+		/** @brief Stops watching a socket
+		**	Remove the sockets before closing them. A socket removed stays in the list of getReady until the next wait.
+		**	@return False if the socket was not watched. */
+		bool remove( Socket& socket );
+
+		/** @brief Stops watching every socket */
+		void clear();
+
+		/** @brief Waits until any socket is ready, the timeout expires or wakeUp is called.
+		**	The sockets ready are listed by getReady until the next wait.
+		**	@param timeout Maximum time to wait. Time::Zero waits forever, a negative time doesn't wait at all.
+		**	@return The number of sockets ready. */
+		Uint32 wait( Time timeout = Time::Zero );
+
+		/** @return The sockets ready in the last wait. */
+		const std::vector<ReadyEvent>& getReady() const;
+
+		/** @return The events ready of the socket in the last wait, or 0 if it wasn't ready. */
+		Uint32 isReady( Socket& socket ) const;
+
+		/** @return True if the last wait returned because wakeUp was called. */
+		bool wasWokenUp() const;
+
+		/** @brief Makes the current or the next wait return immediately. Can be called from any thread.
+		**	Does nothing if the wake up was disabled in the constructor. */
+		void wakeUp();
+
+		/** @return True if the socket is watched. */
+		bool contains( Socket& socket ) const;
+
+		/** @return The events watched of a socket, or 0 if it isn't watched. */
+		Uint32 getEvents( Socket& socket ) const;
+
+		/** @return The number of sockets watched. */
+		Uint32 getSocketCount() const;
+
+		/** @return The socket watched at the index, between 0 and getSocketCount. The order changes when a socket is removed. */
+		Socket * getSocket( const Uint32& index ) const;
+
+		/** @return The backend in use. */
+		Backend getBackend() const;
+	private:
+		struct SocketPollerImpl;
+
+		SocketPollerImpl * mImpl;
+};
+
+}}
+
+#endif
+
+/**
+@class SocketPoller
+@ingroup Network
+
+SocketPoller waits for events on a set of sockets like SocketSelector, but it scales to thousands of sockets:
+the cost of a wait depends on the sockets that are ready instead of the sockets watched ( with epoll ), it
+has no limit on the number of sockets or the value of their handles, and it returns the list of sockets
+ready instead of requiring a test per socket. It can also wait until a socket can send, and another thread
+can interrupt a wait with wakeUp.
+
+Usage example:
+@code
+TcpListener listener;
+listener.listen( 55001 );
+
+SocketPoller poller;
+poller.add( listener );
+
+while ( running ) {
+	poller.wait();
+
+	const std::vector<SocketPoller::ReadyEvent>& ready = poller.getReady();
+
+	for ( Uint32 i = 0; i < ready.size(); i++ ) {
+		if ( ready[i].Sock == &listener ) {
+			TcpSocket * client = eeNew( TcpSocket, () );
+
+			if ( listener.accept( *client ) == Socket::Done ) {
+				poller.add( *client );
+			} else {
+				eeDelete( client );
+			}
+		} else {
+			TcpSocket * client = static_cast<TcpSocket*>( ready[i].Sock );
+			Packet packet;
+
+			if ( client->receive( packet ) == Socket::Disconnected ) {
+				poller.remove( *client );
+				eeDelete( client );
+			}
+		}
+	}
+}
+@endcode
+
+With EdgeTriggered a socket is reported once each time new data arrives, so it must be read until the receive
+returns Socket::NotReady ( non-blocking sockets ) or it won't be reported again.
+
+@see SocketSelector
+*/
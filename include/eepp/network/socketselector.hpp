@@ -9,7 +9,8 @@ namespace EE { namespace Network {
 
 class Socket;
 
-/** @brief Multiplexer that allows to read from multiple sockets */
+/** @brief Multiplexer that allows to read from multiple sockets
+**	Compatibility layer over SocketPoller, which should be preferred in new code. */
 class EE_API SocketSelector
 {
 	public :
@@ -96,6 +97,12 @@ be ready first. In particular, it avoids to use a thread
 for each socket; with selectors, a single thread can handle
 all the sockets.
 
+The selector is implemented with a SocketPoller, so it has no limit on the
+number of sockets and waiting doesn't depend on the value of the handles.
+New code should use SocketPoller directly: it returns the list of sockets
+ready instead of testing each socket, can wait until a socket can send and
+can be woken up from another thread.
+
 All types of sockets can be used in a selector:
 @li TcpListener
 @li TcpSocket
@@ -175,5 +182,5 @@ while (running)
 }
 @endcode
 
-@see Socket
+@see Socket, SocketPoller
 */
@@ -121,7 +121,8 @@ class EE_API TcpSocket : public Socket {
 
 		Uint32			Size;		 ///< Data of packet size
 		std::size_t		SizeReceived; ///< Number of size bytes received so far
-		std::vector<char> Data;		 ///< Data of the packet
+		std::size_t		DataReceived; ///< Number of data bytes received so far
+		std::vector<char> Data;		 ///< Data of the packet, reused between packets
 	};
 
 	// Member data
@@ -19,6 +19,15 @@ class EE_API UdpSocket : public Socket {
 		MaxDatagramSize = 65507 ///< The maximum number of bytes that can be sent in a single UDP datagram
 	};
 
+	/** @brief A datagram of a batch send or receive, with a buffer owned by the caller */
+	struct Datagram {
+		void*			Data;		///< Data to send, or buffer to fill with the data received
+		std::size_t		Size;		///< Number of bytes to send, or size of the buffer to receive
+		std::size_t		Received;	///< Number of bytes received
+		IpAddress		Address;	///< Address of the destination, or of the sender when receiving
+		unsigned short	Port;		///< Port of the destination, or of the sender when receiving
+	};
+
 	/** @brief Default constructor */
 	UdpSocket();
 
@@ -96,6 +105,32 @@ class EE_API UdpSocket : public Socket {
 	**  @return Status code
 	**  @see Send */
 	Status receive(Packet& packet, IpAddress& remoteAddress, unsigned short& remotePort);
+
+	/** @brief Send several datagrams, each one to its own destination
+	**  Uses sendmmsg on Linux to send up to 64 datagrams per system call,
+	**  and a call per datagram on the other platforms.
+	**  @param datagrams Array of the datagrams to send
+	**  @param count	 Number of datagrams in the array
+	**  @param sent	  This variable is filled with the number of datagrams sent
+	**  @return Done if every datagram was sent. Partial if a non-blocking
+	**  socket could send only the first ones, otherwise the error of the
+	**  first datagram that couldn't be sent.
+	**  @see Receive */
+	Status send(const Datagram* datagrams, std::size_t count, std::size_t& sent);
+
+	/** @brief Receive several datagrams
+	**  In blocking mode, this function waits until one datagram is
+	**  received, and then takes the datagrams already queued, up to count,
+	**  without waiting. Uses recvmmsg on Linux to receive up to 64
+	**  datagrams per system call, and a call per datagram on the other
+	**  platforms. Each datagram is filled with the size received and the
+	**  address and port of its sender.
+	**  @param datagrams Array of the datagrams to fill, with their buffers set
+	**  @param count	 Number of datagrams in the array
+	**  @param received  This variable is filled with the number of datagrams received
+	**  @return Done if any datagram was received, otherwise the status of the first receive
+	**  @see Send */
+	Status receive(Datagram* datagrams, std::size_t count, std::size_t& received);
 private:
 	// Member data
 	std::vector<char> mBuffer; ///< Temporary buffer holding the received data in Receive(Packet)
@@ -18,6 +18,7 @@
 #include <eepp/system/pak.hpp>
 #include <eepp/system/zip.hpp>
 #include <eepp/system/rc4.hpp>
+#include <eepp/system/jobsystem.hpp>
 #include <eepp/system/objectloader.hpp>
 #include <eepp/system/resourceloader.hpp>
 #include <eepp/system/resourcemanager.hpp>
@@ -0,0 +1,265 @@
+#ifndef EE_SYSTEMTHASHINDEX_HPP
+#define EE_SYSTEMTHASHINDEX_HPP
+
+#include <eepp/system/base.hpp>
+
+namespace EE { namespace System {
+
+/** @return The slot of the key in a table of 2^( 32 - shift ) slots. Fibonacci hashing, the capacity is always a power of two. */
+inline Uint32 hashIndexSlot( const Uint32& key, const Uint32& shift ) {
+	return ( key * 2654435769U ) >> shift;
+}
+
+inline Uint32 hashIndexSlot( const Uint64& key, const Uint32& shift ) {
+	return (Uint32)( ( key * 11400714819323198485ULL ) >> ( shift + 32 ) );
+}
+
+/** @brief An open-addressing hash table ( linear probing ) that maps an id to a value.
+**	It's meant to index resources by their id ( the String::hash of the resource name ), so the key is already well distributed and it's used as is after a fibonacci mix.
+**	The key can be a Uint32 ( the default ) or a Uint64.
+**	Removed entries leave a tombstone that is cleaned when the table is rehashed. */
+template <typename V, typename K = Uint32>
+class HashIndex {
+	public:
+		HashIndex();
+
+		HashIndex( const HashIndex<V, K>& other );
+
+		~HashIndex();
+
+		HashIndex<V, K>& operator=( const HashIndex<V, K>& other );
+
+		/** @return A pointer to the value stored with the key, NULL if the key is not in the index. */
+		V * find( const K& key ) const;
+
+		/** @brief Inserts or replaces the value of the key.
+		**	@return A pointer to the stored value. The pointer is valid until the next insertion. */
+		V * insert( const K& key, const V& value );
+
+		/** @brief Removes the key from the index.
+		**	@return True if the key was found. */
+		bool erase( const K& key );
+
+		/** @brief Removes every entry. */
+		void clear();
+
+		/** @brief Allocates the space needed to store the number of entries without rehashing. */
+		void reserve( const Uint32& count );
+
+		/** @return The number of entries stored. */
+		Uint32 size() const;
+
+		/** @return True if the index is empty. */
+		bool empty() const;
+	protected:
+		enum SlotState {
+			SlotEmpty,
+			SlotUsed,
+			SlotRemoved
+		};
+
+		struct Slot {
+			K		Key;
+			Uint8	State;
+			V		Value;
+		};
+
+		Slot *	mSlots;
+		Uint32	mCapacity;
+		Uint32	mSize;
+		Uint32	mRemoved;
+		Uint32	mShift;
+
+		Uint32 slotIndex( const K& key ) const;
+
+		Uint32 findSlot( const K& key ) const;
+
+		void rehash( const Uint32& capacity );
+};
+
+template <typename V, typename K>
+HashIndex<V, K>::HashIndex() :
+	mSlots( NULL ),
+	mCapacity( 0 ),
+	mSize( 0 ),
+	mRemoved( 0 ),
+	mShift( 32 )
+{
+}
+
+template <typename V, typename K>
+HashIndex<V, K>::HashIndex( const HashIndex<V, K>& other ) :
+	mSlots( NULL ),
+	mCapacity( 0 ),
+	mSize( 0 ),
+	mRemoved( 0 ),
+	mShift( 32 )
+{
+	*this = other;
+}
+
+template <typename V, typename K>
+HashIndex<V, K>::~HashIndex() {
+	eeSAFE_DELETE_ARRAY( mSlots );
+}
+
+template <typename V, typename K>
+HashIndex<V, K>& HashIndex<V, K>::operator=( const HashIndex<V, K>& other ) {
+	if ( this != &other ) {
+		clear();
+
+		for ( Uint32 i = 0; i < other.mCapacity; i++ ) {
+			if ( SlotUsed == other.mSlots[i].State )
+				insert( other.mSlots[i].Key, other.mSlots[i].Value );
+		}
+	}
+
+	return *this;
+}
+
+template <typename V, typename K>
+Uint32 HashIndex<V, K>::slotIndex( const K& key ) const {
+	return hashIndexSlot( key, mShift );
+}
+
+template <typename V, typename K>
+Uint32 HashIndex<V, K>::findSlot( const K& key ) const {
+	if ( 0 == mSize )
+		return eeINDEX_NOT_FOUND;
+
+	Uint32 i = slotIndex( key );
+
+	while ( SlotEmpty != mSlots[i].State ) {
+		if ( SlotUsed == mSlots[i].State && key == mSlots[i].Key )
+			return i;
+
+		i = ( i + 1 ) & ( mCapacity - 1 );
+	}
+
+	return eeINDEX_NOT_FOUND;
+}
+
+template <typename V, typename K>
+V * HashIndex<V, K>::find( const K& key ) const {
+	Uint32 i = findSlot( key );
+
+	return eeINDEX_NOT_FOUND != i ? &mSlots[i].Value : NULL;
+}
+
+template <typename V, typename K>
+V * HashIndex<V, K>::insert( const K& key, const V& value ) {
+	V * found = find( key );
+
+	if ( NULL != found ) {
+		*found = value;
+		return found;
+	}
+
+	// Keep the load factor ( including tombstones ) under 0.75
+	if ( ( mSize + mRemoved + 1 ) * 4 > mCapacity * 3 ) {
+		Uint32 capacity = eemax( (Uint32)16, mCapacity );
+
+		while ( ( mSize + 1 ) * 2 > capacity )
+			capacity *= 2;
+
+		rehash( capacity );
+	}
+
+	Uint32 i = slotIndex( key );
+
+	while ( SlotUsed == mSlots[i].State )
+		i = ( i + 1 ) & ( mCapacity - 1 );
+
+	if ( SlotRemoved == mSlots[i].State )
+		mRemoved--;
+
+	mSlots[i].Key	= key;
+	mSlots[i].State	= SlotUsed;
+	mSlots[i].Value	= value;
+	mSize++;
+
+	return &mSlots[i].Value;
+}
+
+template <typename V, typename K>
+bool HashIndex<V, K>::erase( const K& key ) {
+	Uint32 i = findSlot( key );
+
+	if ( eeINDEX_NOT_FOUND == i )
+		return false;
+
+	mSlots[i].State = SlotRemoved;
+	mSlots[i].Value = V();
+	mSize--;
+	mRemoved++;
+
+	return true;
+}
+
+template <typename V, typename K>
+void HashIndex<V, K>::clear() {
+	eeSAFE_DELETE_ARRAY( mSlots );
+	mCapacity	= 0;
+	mSize		= 0;
+	mRemoved	= 0;
+	mShift		= 32;
+}
+
+template <typename V, typename K>
+void HashIndex<V, K>::reserve( const Uint32& count ) {
+	Uint32 capacity = 16;
+
+	while ( count * 2 > capacity )
+		capacity *= 2;
+
+	if ( capacity > mCapacity )
+		rehash( capacity );
+}
+
+template <typename V, typename K>
+void HashIndex<V, K>::rehash( const Uint32& capacity ) {
+	Slot * slots = mSlots;
+	Uint32 oldCapacity = mCapacity;
+
+	mSlots		= eeNewArray( Slot, capacity );
+	mCapacity	= capacity;
+	mSize		= 0;
+	mRemoved	= 0;
+	mShift		= 32;
+
+	for ( Uint32 c = capacity; c > 1; c >>= 1 )
+		mShift--;
+
+	for ( Uint32 i = 0; i < capacity; i++ )
+		mSlots[i].State = SlotEmpty;
+
+	for ( Uint32 i = 0; i < oldCapacity; i++ ) {
+		if ( SlotUsed == slots[i].State ) {
+			Uint32 n = slotIndex( slots[i].Key );
+
+			while ( SlotEmpty != mSlots[n].State )
+				n = ( n + 1 ) & ( mCapacity - 1 );
+
+			mSlots[n].Key	= slots[i].Key;
+			mSlots[n].State	= SlotUsed;
+			mSlots[n].Value	= slots[i].Value;
+			mSize++;
+		}
+	}
+
+	eeSAFE_DELETE_ARRAY( slots );
+}
+
+template <typename V, typename K>
+Uint32 HashIndex<V, K>::size() const {
+	return mSize;
+}
+
+template <typename V, typename K>
+bool HashIndex<V, K>::empty() const {
+	return 0 == mSize;
+}
+
+}}
+
+#endif
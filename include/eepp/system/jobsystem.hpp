@@ -0,0 +1,102 @@
+#ifndef EE_SYSTEMCJOBSYSTEM_HPP
+#define EE_SYSTEMCJOBSYSTEM_HPP
+
+#include <eepp/system/base.hpp>
+#include <eepp/system/singleton.hpp>
+#include <eepp/system/thread.hpp>
+#include <eepp/system/mutex.hpp>
+#include <eepp/system/condition.hpp>
+#include <eepp/system/threadlocalptr.hpp>
+#include <eepp/core/noncopyable.hpp>
+#include <vector>
+#include <deque>
+#include <map>
+
+namespace EE { namespace System {
+
+/** @brief A persistent pool of worker threads that executes jobs.
+**	Every worker owns a double-ended job queue. A worker takes the newest job from its own queue and, when it runs out of work,
+**	steals the oldest job from the queue of another worker. Jobs can depend on other jobs: a job is not queued until every job
+**	it depends on has finished.
+**	The engine loaders ( ObjectLoader, ResourceLoader, TextureAtlasLoader ) and Http::sendAsyncRequest submit their work here
+**	instead of creating a thread per request. */
+class EE_API JobSystem : NonCopyable {
+	SINGLETON_DECLARE_HEADERS(JobSystem)
+
+	public:
+		typedef cb::Callback0<void> JobCallback;
+
+		/** A job handle. Handles are unique during the lifetime of the job system. */
+		typedef Uint64 Handle;
+
+		/** The handle value that doesn't represent any job. Jobs depending on it don't wait for anything. */
+		static const Handle InvalidHandle;
+
+		~JobSystem();
+
+		/** @brief Queues a job to be executed by any worker.
+		**	@return The handle of the job */
+		Handle run( JobCallback job );
+
+		/** @brief Queues a job that will be executed after the dependency finished.
+		**	@return The handle of the job */
+		Handle run( JobCallback job, const Handle& dependency );
+
+		/** @brief Queues a job that will be executed after every dependency finished.
+		**	@return The handle of the job */
+		Handle run( JobCallback job, const std::vector<Handle>& dependencies );
+
+		/** @return True if the job finished ( or if the handle doesn't belong to any pending job ). */
+		bool isDone( const Handle& job );
+
+		/** @brief Blocks until the job finished.
+		**	When called from a worker the thread helps executing the queued jobs while waiting, so jobs can wait for other jobs.
+		**	Other threads never execute jobs, since loaders may need to bind a GL context to the thread running them. */
+		void wait( const Handle& job );
+
+		/** @brief Blocks until every queued job finished. @see wait
+		**	It can't be called from a job, since the job calling it is still pending. */
+		void waitAll();
+
+		/** @return The number of jobs queued or running. */
+		Uint32 getPendingCount();
+
+		/** @return The number of worker threads. */
+		Uint32 getWorkerCount() const;
+
+		/** @return True if the calling thread is one of the job system workers. */
+		bool isWorkerThread() const;
+	protected:
+		class Job;
+		class Worker;
+		friend class Worker;
+
+		Mutex					mJobsMutex;
+		std::map<Handle, Job*>	mJobs;
+		Handle					mLastHandle;
+		std::vector<Worker*>	mWorkers;
+		Uint32					mNextWorker;
+		Condition				mWorkCond;
+		Condition				mIdleCond;
+		Uint32					mQueued;
+		Uint32					mBlockedWorkers;
+		bool					mRunning;
+		ThreadLocalPtr<Worker>	mCurrentWorker;
+
+		/** Creates a job system with a worker per CPU core. */
+		JobSystem();
+
+		Handle addJob( JobCallback job, const Handle * dependencies, const Uint32& count );
+
+		void enqueue( Job * job );
+
+		Job * fetchJob( Worker * worker );
+
+		void execute( Job * job );
+
+		void workerLoop( Worker * worker );
+};
+
+}}
+
+#endif
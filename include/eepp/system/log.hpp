@@ -2,25 +2,43 @@
 #define EECLOG_H
 
 #include <list>
+#include <deque>
 #include <eepp/system/base.hpp>
 #include <eepp/system/singleton.hpp>
 #include <eepp/system/iostreamfile.hpp>
 #include <eepp/system/mutex.hpp>
+#include <eepp/system/condition.hpp>
 #include <eepp/system/sys.hpp>
+#include <atomic>
 
 namespace EE { namespace System {
 
-/** @brief The reader interface is useful if you want to keep track of what is write in the log, for example for a console. */
+class Thread;
+
+namespace Private { class LogRingBuffer; }
+
+/** @brief The reader interface is useful if you want to keep track of what is write in the log, for example for a console.
+**	In asynchronous mode the readers are called from the log thread. */
 class LogReaderInterface {
 	public:
 		virtual void writeLog( const std::string& Text ) = 0;
 };
 
-/** @brief Global log file. The engine will log everything in this file. */
+/** @brief Global log file. The engine will log everything in this file.
+**	By default every write is processed in the calling thread: the text is stored in the log history, sent to the readers, to the
+**	terminal and ( in live write mode ) to the log file, which is flushed on every write.
+**	In asynchronous mode the writes are pushed into a fixed size lock-free ring buffer and a background thread processes them in
+**	batches, flushing the log file once per batch. When the ring buffer is full the overflow policy decides if the writer waits
+**	for a free slot or the text is dropped. */
 class EE_API Log : protected Mutex {
 	SINGLETON_DECLARE_HEADERS(Log)
 
 	public:
+		enum OverflowPolicy {
+			OverflowBlock,	//! The writer waits until the log thread frees a slot in the ring buffer
+			OverflowDrop	//! The text is discarded and counted as dropped
+		};
+
 		/** @brief Indicates that the log must be writed to a file when the Log instance is closed.
 		**	@param filepath The path to the file to write the log.
 		*/
@@ -35,9 +53,38 @@ class EE_API Log : protected Mutex {
 		/** @brief Writes a formated string to the log */
 		void writef( const char* format, ... );
 
-		/** @returns A copy of the current writed log. */
+		/** @returns A copy of the log history. */
 		std::string getBuffer() const;
 
+		/** @brief Sets the maximum size in bytes of the log history kept in memory ( 0 means no limit ).
+		**	When the log must be saved on close, the oldest lines are written to the log file before being discarded from the history. */
+		void setHistorySize( const Uint32& size );
+
+		/** @returns The maximum size in bytes of the log history. */
+		const Uint32& getHistorySize() const;
+
+		/** @brief Enables or disables the asynchronous mode.
+		**	@param async True to process the writes in a background thread.
+		**	@param bufferSize The number of texts that the ring buffer can hold ( rounded up to a power of two ).
+		**	Disabling the asynchronous mode waits until every pending write is processed. Other threads can keep writing while the
+		**	mode changes, but setAsync itself must not be called from several threads at the same time. */
+		void setAsync( const bool& async, const Uint32& bufferSize = 4096 );
+
+		/** @returns If the log is in asynchronous mode. */
+		bool isAsync() const;
+
+		/** @brief Sets what happens when a text is written and the ring buffer is full. */
+		void setOverflowPolicy( const OverflowPolicy& policy );
+
+		/** @returns The overflow policy */
+		const OverflowPolicy& getOverflowPolicy() const;
+
+		/** @returns The number of texts dropped because the ring buffer was full. */
+		Uint64 getDroppedCount() const;
+
+		/** @brief Blocks until every pending write was processed, and flushes the log file. */
+		void flush();
+
 		/** @returns If the log Writes are outputed to the terminal. */
 		const bool& isConsoleOutput() const;
 
@@ -62,19 +109,46 @@ class EE_API Log : protected Mutex {
 	protected:
 		Log();
 
-		std::string mData;
+		std::deque<std::string> mHistory;
+		Uint32 mHistoryBytes;
+		Uint32 mHistorySize;
 		std::string mFilePath;
 		bool mSave;
 		bool mConsoleOutput;
 		bool mLiveWrite;
 		IOStreamFile * mFS;
 		std::list<LogReaderInterface*> mReaders;
+		Private::LogRingBuffer * mRing;
+		std::atomic<Private::LogRingBuffer*> mWriteRing;
+		std::atomic<Uint32> mRingUsers;
+		Condition mRingUsersCond;
+		Thread * mThread;
+		OverflowPolicy mOverflowPolicy;
+		std::atomic<Uint64> mDropped;
 
 		void openFS();
 
 		void closeFS();
 
 		void writeToReaders( std::string& text );
+
+		void writeToConsole( const std::string& text );
+
+		Private::LogRingBuffer * acquireRing();
+
+		void releaseRing();
+
+		void push( std::string& text );
+
+		void process( std::string& text );
+
+		void addToHistory( const std::string& text );
+
+		void trimHistory();
+
+		void logThread();
+
+		Uint32 processPending();
 };
 
 }}
@@ -0,0 +1,42 @@
+#ifndef EE_SYSTEMCMAPPEDFILE_HPP
+#define EE_SYSTEMCMAPPEDFILE_HPP
+
+#include <eepp/system/base.hpp>
+#include <eepp/core/noncopyable.hpp>
+
+namespace EE { namespace System {
+
+/** @brief Maps a file from the file system into memory.
+**	The file is mapped as a private copy-on-write mapping: the file contents are read on demand by the OS and any write to the
+**	mapped memory is never written back to the file. */
+class EE_API MappedFile : NonCopyable {
+	public:
+		MappedFile();
+
+		~MappedFile();
+
+		/** @brief Maps the file into memory.
+		**	@return True if the file was mapped. */
+		bool open( const std::string& path );
+
+		/** @brief Unmaps the file. Any pointer to the mapped memory becomes invalid. */
+		void close();
+
+		/** @return If the file is mapped */
+		bool isOpen() const;
+
+		/** @return A pointer to the mapped memory */
+		Uint8 * getData() const;
+
+		/** @return The size of the file mapped */
+		const Uint64& getSize() const;
+	protected:
+		Uint8 *		mData;
+		Uint64		mSize;
+		void *		mFileHandle;
+		void *		mMapHandle;
+};
+
+}}
+
+#endif
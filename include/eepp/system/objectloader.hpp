@@ -2,13 +2,14 @@
 #define EE_SYSTEMCOBJECTLOADER
 
 #include <eepp/system/base.hpp>
-#include <eepp/system/thread.hpp>
+#include <eepp/system/jobsystem.hpp>
 #include <list>
 
 namespace EE { namespace System {
 
-/** @brief Base class that defines resources to be loaded in synchronous or asynchronous mode. */
-class EE_API ObjectLoader : protected Thread {
+/** @brief Base class that defines resources to be loaded in synchronous or asynchronous mode.
+**	Asynchronous loaders are executed as jobs of the JobSystem. */
+class EE_API ObjectLoader : NonCopyable {
 	public:
 		typedef cb::Callback1<void, ObjectLoader *> ObjLoadCallback;
 
@@ -64,6 +65,7 @@ class EE_API ObjectLoader : protected Thread {
 		bool			mLoaded;
 		bool			mLoading;
 		bool			mThreaded;
+		JobSystem::Handle	mJob;
 
 		std::list<ObjLoadCallback>	mLoadCbs;
 
@@ -72,8 +74,11 @@ class EE_API ObjectLoader : protected Thread {
 		virtual void	setLoaded();
 
 		virtual void	reset();
+
+		/** @brief Blocks until the asynchronous load job finished. */
+		void			waitJob();
 	private:
-		virtual void 	run();
+		void 			run();
 };
 
 }}
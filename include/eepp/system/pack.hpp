@@ -20,6 +20,12 @@ class EE_API Pack : protected Mutex {
 		/** Open a pack file */
 		virtual bool open( const std::string& path ) = 0;
 
+		/** @brief Open a pack file in read-only mode.
+		**	The pack file is memory mapped and its directory is indexed when opened. The files can be read concurrently from any thread
+		**	without locking the pack, and the stored ( uncompressed ) files can be accessed with getFileView without copying them.
+		**	Packs that don't support the read-only mode open the file normally. */
+		virtual bool openReadOnly( const std::string& path );
+
 		/** Close the pack file */
 		virtual bool close() = 0;
 
@@ -54,6 +60,12 @@ class EE_API Pack : protected Mutex {
 		/** Extract a file to memory from the pack file */
 		virtual bool extractFileToMemory( const std::string& path, SafeDataPointer& data ) = 0;
 
+		/** @brief Gets the file data without copying it when possible.
+		**	If the pack was opened in read-only mode and the file is stored without compression the data points to the mapped pack file
+		**	( and it's not owned by the SafeDataPointer ), otherwise the file is extracted to memory.
+		**	The data is valid while the pack stays open. An empty file is always returned as a NULL Data with a DataSize of 0. */
+		virtual bool getFileView( const std::string& path, SafeDataPointer& data );
+
 		/** Check if a file exists in the pack file and return the number of the file, otherwise return -1. */
 		virtual Int32 exists( const std::string& path ) = 0;
 
@@ -66,10 +78,20 @@ class EE_API Pack : protected Mutex {
 		/** @return If the pack file is open */
 		virtual bool isOpen() const;
 
+		/** @return If the pack file was opened in read-only mode */
+		bool isReadOnly() const;
+
 		/** @return The file path of the opened package */
 		virtual std::string getPackPath() = 0;
 	protected:
 		bool mIsOpen;
+		bool mReadOnly;
+
+		/** @brief Must be called after the pack is opened or closed, to update the PackManager files index. */
+		void updateIndex();
+
+		/** @brief Must be called after a file is added to the open pack. */
+		void indexFile( const std::string& path );
 };
 
 }}
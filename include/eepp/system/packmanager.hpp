@@ -4,11 +4,14 @@
 #include <eepp/system/singleton.hpp>
 #include <eepp/system/container.hpp>
 #include <eepp/system/pack.hpp>
+#include <eepp/system/hashindex.hpp>
 
 namespace EE { namespace System {
 
 /** @brief The Pack Manager keep track of the instanciated Packs.
 	It's used to find files from any open pack.
+	The paths of the files of the open packs are indexed by hash, the index is rebuilt when a pack is opened or closed. If several
+	packs contain the same path the file is found in the first pack instanciated.
 */
 class EE_API PackManager : public Container<Pack> {
 	SINGLETON_DECLARE_HEADERS(PackManager)
@@ -36,9 +39,19 @@ class EE_API PackManager : public Container<Pack> {
 		*/
 		void setFallbackToPacks( const bool& fallback );
 	protected:
-		bool	mFallback;
+		friend class Pack;
+
+		bool				mFallback;
+		HashIndex<Pack*>	mFilesIndex;	//! File path hash to the pack that contains the file
+		std::string			mProcessPath;
 
 		PackManager();
+
+		/** @brief Indexes the files of every open pack. */
+		void rebuildIndex();
+
+		/** @brief Indexes a file added to an open pack. */
+		void indexFile( Pack * pack, const std::string& path );
 };
 
 }}
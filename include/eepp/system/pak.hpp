@@ -4,6 +4,8 @@
 #include <eepp/system/base.hpp>
 #include <eepp/system/pack.hpp>
 #include <eepp/system/iostreamfile.hpp>
+#include <eepp/system/mappedfile.hpp>
+#include <eepp/system/hashindex.hpp>
 
 namespace EE { namespace System {
 
@@ -19,6 +21,9 @@ class EE_API Pak : public Pack {
 		/** Open a pakFile */
 		bool open( const std::string& path );
 
+		/** Open a pakFile in read-only mode. @see Pack::openReadOnly */
+		bool openReadOnly( const std::string& path );
+
 		/** Close the pakFile */
 		bool close();
 
@@ -53,6 +58,9 @@ class EE_API Pak : public Pack {
 		/** Extract a file to memory from the pakFile */
 		bool extractFileToMemory( const std::string& path, SafeDataPointer& data );
 
+		/** Gets the file data. In read-only mode the data always points to the mapped pakFile. @see Pack::getFileView */
+		bool getFileView( const std::string& path, SafeDataPointer& data );
+
 		/** Check if a file exists in the pakFile and return the number of the file, otherwise return -1. */
 		Int32 exists( const std::string& path );
 
@@ -91,6 +99,14 @@ class EE_API Pak : public Pack {
 
 		pakFile					mPak;
 		std::vector<pakEntry>	mPakFiles;
+		HashIndex<Uint32>		mPakIndex;		//! File name hash to position in mPakFiles
+		MappedFile				mMappedFile;
+
+		std::string getEntryName( const Uint32& pos ) const;
+
+		void indexEntry( const Uint32& pos );
+
+		void buildIndex();
 };
 
 }}
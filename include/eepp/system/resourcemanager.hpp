@@ -2,12 +2,14 @@
 #define EE_SYSTEMTRESOURCEMANAGER_HPP
 
 #include <eepp/system/base.hpp>
+#include <eepp/system/hashindex.hpp>
 #include <list>
 
 namespace EE { namespace System {
 
 /** @brief A simple resource manager. It keeps a list of the resources, and free the instances of the resources when the manager is closed.
-**	Resources must have Id() and Name() properties. Id() is the string hash of Name(). */
+**	Resources must have Id() and Name() properties. Id() is the string hash of Name().
+**	The resources are indexed by id, so the lookups don't depend on the number of resources managed. */
 template <class T>
 class ResourceManager {
 	public:
@@ -66,10 +68,42 @@ class ResourceManager {
 
 		/** @brief Indicates if the resource manager is destroy the resources. */
 		const bool& isDestroying() const;
+
+		/** @brief Rebuilds the resources id index.
+		**	Must be called if the resources managed change their names ( and therefore their ids ). */
+		void reindex();
+
+		/** @brief Moves a resource managed to the index entry of its new id.
+		**	Must be called when a resource managed changes its name ( and therefore its id ).
+		**	@param Resource The resource renamed
+		**	@param OldId The id of the resource before being renamed */
+		void reindex( T * Resource, const Uint32& OldId );
 	protected:
+		/** The resource returned for an id ( the last one added with that id ) and the number of resources sharing the id */
+		struct IndexEntry {
+			T *		Resource;
+			Uint32	Count;
+
+			IndexEntry() : Resource( NULL ), Count( 0 ) {}
+		};
+
 		std::list<T*> mResources;
+		HashIndex<IndexEntry> mIndex;
 		bool mUniqueId;
 		bool mIsDestroying;
+
+		void indexAdd( T * Resource );
+
+		void indexRemove( T * Resource, const Uint32& Id );
+
+		/** @brief Called after a resource was added to the manager. */
+		virtual void onResourceAdd( T * Resource ) {}
+
+		/** @brief Called after a resource was removed from the manager ( before being deleted ). */
+		virtual void onResourceRemove( T * Resource ) {}
+
+		/** @brief Called after every resource was destroyed. */
+		virtual void onResourcesDestroy() {}
 };
 
 template <class T>
@@ -100,8 +134,11 @@ void ResourceManager<T>::destroy() {
 	}
 
 	mResources.clear();
+	mIndex.clear();
 
 	mIsDestroying = false;
+
+	onResourcesDestroy();
 }
 
 template <class T>
@@ -117,6 +154,8 @@ T * ResourceManager<T>::add( T * Resource ) {
 
 			if ( 0 == c ) {
 				mResources.push_back( Resource );
+				indexAdd( Resource );
+				onResourceAdd( Resource );
 
 				return Resource;
 			} else {
@@ -131,6 +170,8 @@ T * ResourceManager<T>::add( T * Resource ) {
 			}
 		} else {
 			mResources.push_back( Resource );
+			indexAdd( Resource );
+			onResourceAdd( Resource );
 
 			return Resource;
 		}
@@ -142,8 +183,15 @@ T * ResourceManager<T>::add( T * Resource ) {
 template <class T>
 bool ResourceManager<T>::remove( T * Resource, bool Delete ) {
 	if ( NULL != Resource ) {
+		size_t count = mResources.size();
+
 		mResources.remove( Resource );
 
+		if ( count != mResources.size() ) {
+			indexRemove( Resource, Resource->getId() );
+			onResourceRemove( Resource );
+		}
+
 		if ( Delete )
 			eeSAFE_DELETE( Resource );
 
@@ -170,13 +218,7 @@ bool ResourceManager<T>::exists( const std::string& Name ) {
 
 template <class T>
 bool ResourceManager<T>::existsId( const Uint32& Id ) {
-	typename std::list<T*>::iterator it;
-
-	for ( it = mResources.begin() ; it != mResources.end(); it++ )
-		if ( (*it)->getId() == Id )
-			return true;
-
-	return false;
+	return NULL != mIndex.find( Id );
 }
 
 template <class T>
@@ -186,18 +228,9 @@ T * ResourceManager<T>::getByName( const std::string& Name ) {
 
 template <class T>
 T * ResourceManager<T>::getById( const Uint32& id ) {
-	typename std::list<T*>::reverse_iterator it;
+	IndexEntry * entry = mIndex.find( id );
 
-	T * sp = NULL;
-
-	for ( it = mResources.rbegin(); it != mResources.rend(); it++ ) {
-		sp = (*it);
-
-		if ( id == sp->getId() )
-			return sp;
-	}
-
-	return NULL;
+	return NULL != entry ? entry->Resource : NULL;
 }
 
 template <class T>
@@ -220,14 +253,9 @@ Uint32 ResourceManager<T>::getCount() {
 
 template <class T>
 Uint32 ResourceManager<T>::setCount( const Uint32& Id ) {
-	typename std::list<T*>::iterator it;
-	Uint32 Count = 0;
-
-	for ( it = mResources.begin() ; it != mResources.end(); it++ )
-		if ( (*it)->getId() == Id )
-			Count++;
+	IndexEntry * entry = mIndex.find( Id );
 
-	return Count;
+	return NULL != entry ? entry->Count : 0;
 }
 
 template <class T>
@@ -235,6 +263,77 @@ Uint32 ResourceManager<T>::setCount( const std::string& Name ) {
 	return setCount( String::hash( Name ) );
 }
 
+template <class T>
+void ResourceManager<T>::indexAdd( T * Resource ) {
+	IndexEntry * entry = mIndex.find( Resource->getId() );
+
+	if ( NULL == entry )
+		entry = mIndex.insert( Resource->getId(), IndexEntry() );
+
+	// The last resource added with an id is the one returned by getById
+	entry->Resource = Resource;
+	entry->Count++;
+}
+
+template <class T>
+void ResourceManager<T>::indexRemove( T * Resource, const Uint32& id ) {
+	IndexEntry * entry = mIndex.find( id );
+
+	if ( NULL == entry )
+		return;
+
+	if ( 0 == --entry->Count ) {
+		mIndex.erase( id );
+	} else if ( entry->Resource == Resource ) {
+		// Only happens with non unique ids, find the previous resource added with the same id
+		typename std::list<T*>::reverse_iterator it;
+
+		for ( it = mResources.rbegin(); it != mResources.rend(); it++ ) {
+			if ( id == (*it)->getId() ) {
+				entry->Resource = (*it);
+				break;
+			}
+		}
+	}
+}
+
+template <class T>
+void ResourceManager<T>::reindex() {
+	typename std::list<T*>::iterator it;
+
+	mIndex.clear();
+	mIndex.reserve( mResources.size() );
+
+	for ( it = mResources.begin() ; it != mResources.end(); it++ )
+		indexAdd( (*it) );
+}
+
+template <class T>
+void ResourceManager<T>::reindex( T * Resource, const Uint32& OldId ) {
+	if ( NULL == Resource || OldId == Resource->getId() )
+		return;
+
+	indexRemove( Resource, OldId );
+
+	// The resource keeps its position in the list, if it isn't the last one added with the new id the last one still resolves it
+	IndexEntry * entry = mIndex.find( Resource->getId() );
+
+	if ( NULL == entry ) {
+		indexAdd( Resource );
+	} else {
+		typename std::list<T*>::reverse_iterator it;
+
+		entry->Count++;
+
+		for ( it = mResources.rbegin(); it != mResources.rend(); it++ ) {
+			if ( (*it)->getId() == Resource->getId() ) {
+				entry->Resource = (*it);
+				break;
+			}
+		}
+	}
+}
+
 }}
 
 #endif
@@ -5,16 +5,18 @@
 
 namespace EE { namespace System {
 
-/** @brief Keep a pointer and release it in the SafeDataPointer destructor */
+/** @brief Keep a pointer and release it in the SafeDataPointer destructor
+**	A SafeDataPointer can also be a view of memory owned by someone else ( for example a file inside a memory mapped Pack ), in that case the buffer is not released. */
 class EE_API SafeDataPointer {
 	public:
 		SafeDataPointer();
 
-		SafeDataPointer( Uint8 * data, Uint32 size );
+		SafeDataPointer( Uint8 * data, Uint32 size, bool owns = true );
 
-		/** @brief The destructor deletes the buffer */
+		/** @brief The destructor deletes the buffer if it owns it */
 		~SafeDataPointer();
 
+		/** @brief Releases the buffer if owned. After clearing the pointer owns the next buffer assigned. */
 		void clear();
 
 		/** Pointer to the buffer */
@@ -22,6 +24,9 @@ class EE_API SafeDataPointer {
 
 		/** Buffer size */
 		Uint32	DataSize;
+
+		/** Indicates if the buffer is released by the SafeDataPointer */
+		bool	Owns;
 };
 
 }}
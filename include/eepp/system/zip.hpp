@@ -3,6 +3,8 @@
 
 #include <eepp/system/base.hpp>
 #include <eepp/system/pack.hpp>
+#include <eepp/system/mappedfile.hpp>
+#include <eepp/system/hashindex.hpp>
 
 struct zip;
 
@@ -21,6 +23,11 @@ class EE_API Zip : public Pack {
 		/** Open a pack file */
 		bool open( const std::string& path );
 
+		/** Open a pack file in read-only mode. @see Pack::openReadOnly
+		**	Files stored without compression are accessed directly from the mapped file, deflated files are inflated without locking the pack.
+		**	Zip64 files are opened normally. */
+		bool openReadOnly( const std::string& path );
+
 		/** Close the pack file */
 		bool close();
 
@@ -52,6 +59,9 @@ class EE_API Zip : public Pack {
 		/** Extract a file to memory from the pakFile */
 		bool extractFileToMemory( const std::string& path, SafeDataPointer& data );
 
+		/** Gets the file data. @see Pack::getFileView */
+		bool getFileView( const std::string& path, SafeDataPointer& data );
+
 		/** Check if a file exists in the pack file and return the number of the file, otherwise return -1. */
 		Int32 exists( const std::string& path );
 
@@ -67,9 +77,25 @@ class EE_API Zip : public Pack {
 		/** @return The file path of the opened package */
 		std::string getPackPath();
 	protected:
+		struct ZipEntry {
+			std::string	Name;
+			Uint16		Method;
+			Uint32		CompressedSize;
+			Uint32		Size;
+			Uint32		DataOffset;
+		};
+
 		struct zip * mZip;
 
 		std::string mZipPath;
+
+		std::vector<ZipEntry>	mEntries;
+		HashIndex<Uint32>		mEntriesIndex;	//! File name hash to position in mEntries
+		MappedFile				mMappedFile;
+
+		bool readCentralDirectory();
+
+		bool inflateEntry( const ZipEntry& entry, Uint8 * dest );
 };
 
 }}
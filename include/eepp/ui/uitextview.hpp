@@ -76,6 +76,8 @@ class EE_API UITextView : public UIWidget {
 
 		UITooltipStyleConfig getFontStyleConfig() const;
 
+		Text * getTextCache();
+
 		const Rect& getPadding() const;
 
 		UITextView * setPadding(const Rect & padding);
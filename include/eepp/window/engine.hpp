@@ -49,7 +49,7 @@ class EE_API Engine {
 			BitColor		32,16,8
 			Windowed		bool
 			Resizeable		bool
-			Backend			SDL, SDL2 or SFML
+			Backend			SDL, SDL2, SFML or Null
 			WinIcon			The path to the window icon
 			WinCaption		The window default title
 
@@ -65,7 +65,7 @@ class EE_API Engine {
 			BitColor		32,16,8
 			Windowed		bool
 			Resizeable		bool
-			Backend			SDL, SDL2 or SFML
+			Backend			SDL, SDL2, SFML or Null
 			WinIcon			The path to the window icon
 			WinCaption		The window default title
 
@@ -137,6 +137,8 @@ class EE_API Engine {
 
 		EE::Window::Window * createSFMLWindow( const WindowSettings& Settings, const ContextSettings& Context );
 
+		EE::Window::Window * createNullWindow( const WindowSettings& Settings, const ContextSettings& Context );
+
 		EE::Window::Window * createDefaultWindow( const WindowSettings& Settings, const ContextSettings& Context );
 
 		Uint32 getDefaultBackend() const;
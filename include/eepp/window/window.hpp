@@ -36,6 +36,7 @@ namespace WindowBackend {
 	{
 		SDL2,
 		SFML,
+		Null,		//! A window without OpenGL context that renders with the null renderer ( see Graphics::RendererNull )
 		Default
 	};
 }
@@ -951,6 +951,102 @@ solution "eepp"
 		files { "src/examples/http_request/*.cpp" }
 		build_link_configuration( "eehttp-request", true )
 
+	project "eepp-job-system"
+		kind "ConsoleApp"
+		language "C++"
+		files { "src/examples/job_system/*.cpp" }
+		build_link_configuration( "eejob-system", true )
+
+	project "eepp-resource-lookup"
+		kind "ConsoleApp"
+		language "C++"
+		files { "src/examples/resource_lookup/*.cpp" }
+		build_link_configuration( "eeresource-lookup", true )
+
+	project "eepp-log-throughput"
+		kind "ConsoleApp"
+		language "C++"
+		files { "src/examples/log_throughput/*.cpp" }
+		build_link_configuration( "eelog-throughput", true )
+
+	project "eepp-allocator-pools"
+		kind "ConsoleApp"
+		language "C++"
+		files { "src/examples/allocator_pools/*.cpp" }
+		build_link_configuration( "eeallocator-pools", true )
+
+	project "eepp-map-lights"
+		kind "ConsoleApp"
+		language "C++"
+		files { "src/examples/map_lights/*.cpp" }
+		build_link_configuration( "eemap-lights", true )
+
+	project "eepp-particle-throughput"
+		kind "ConsoleApp"
+		language "C++"
+		files { "src/examples/particle_throughput/*.cpp" }
+		build_link_configuration( "eeparticle-throughput", true )
+
+	project "eepp-batch-sorting"
+		kind "ConsoleApp"
+		language "C++"
+		files { "src/examples/batch_sorting/*.cpp" }
+		build_link_configuration( "eebatch-sorting", true )
+
+	project "eepp-headless-render"
+		kind "ConsoleApp"
+		language "C++"
+		files { "src/examples/headless_render/*.cpp" }
+		build_link_configuration( "eeheadless-render", true )
+
+	project "eepp-texture-packer-bench"
+		kind "ConsoleApp"
+		language "C++"
+		files { "src/examples/texture_packer_bench/*.cpp" }
+		build_link_configuration( "eetexture-packer-bench", true )
+
+	project "eepp-image-kernels"
+		kind "ConsoleApp"
+		language "C++"
+		files { "src/examples/image_kernels/*.cpp" }
+		build_link_configuration( "eeimage-kernels", true )
+
+	project "eepp-map-streaming"
+		kind "ConsoleApp"
+		language "C++"
+		files { "src/examples/map_streaming/*.cpp" }
+		build_link_configuration( "eemap-streaming", true )
+
+	project "eepp-map-object-index"
+		kind "ConsoleApp"
+		language "C++"
+		files { "src/examples/map_object_index/*.cpp" }
+		build_link_configuration( "eemap-object-index", true )
+
+	project "eepp-http-loopback"
+		kind "ConsoleApp"
+		language "C++"
+		files { "src/examples/http_loopback/*.cpp" }
+		build_link_configuration( "eehttp-loopback", true )
+
+	project "eepp-socket-poller"
+		kind "ConsoleApp"
+		language "C++"
+		files { "src/examples/socket_poller/*.cpp" }
+		build_link_configuration( "eesocket-poller", true )
+
+	project "eepp-packet-throughput"
+		kind "ConsoleApp"
+		language "C++"
+		files { "src/examples/packet_throughput/*.cpp" }
+		build_link_configuration( "eepacket-throughput", true )
+
+	project "eepp-udp-batch"
+		kind "ConsoleApp"
+		language "C++"
+		files { "src/examples/udp_batch/*.cpp" }
+		build_link_configuration( "eeudp-batch", true )
+
 if os.isfile("external_projects.lua") then
 	dofile("external_projects.lua")
 end
@@ -0,0 +1,91 @@
+#include <eepp/core/arenaallocator.hpp>
+#include <cstdlib>
+
+namespace EE {
+
+ArenaAllocator::ArenaAllocator( const size_t& blockSize ) :
+	mBlockSize( blockSize > 0 ? blockSize : 1024 ),
+	mCurrentBlock( 0 ),
+	mOffset( 0 ),
+	mUsedMemory( 0 ),
+	mPeakUsedMemory( 0 )
+{
+}
+
+ArenaAllocator::~ArenaAllocator() {
+	release();
+}
+
+void * ArenaAllocator::allocate( const size_t& size, const size_t& alignment ) {
+	// malloc only guarantees the alignment of the fundamental types ( 8 bytes in most 32 bits platforms ), so the address is aligned
+	while ( mCurrentBlock < mBlocks.size() ) {
+		Block& block = mBlocks[ mCurrentBlock ];
+		size_t base = (size_t)block.Data;
+		size_t offset = ( ( base + mOffset + alignment - 1 ) & ~( alignment - 1 ) ) - base;
+
+		if ( offset + size <= block.Size ) {
+			mOffset = offset + size;
+			mUsedMemory += size;
+
+			if ( mUsedMemory > mPeakUsedMemory )
+				mPeakUsedMemory = mUsedMemory;
+
+			return block.Data + offset;
+		}
+
+		// Try the next block ( kept from before the last reset )
+		mCurrentBlock++;
+		mOffset = 0;
+	}
+
+	Block block;
+	block.Size = size + alignment > mBlockSize ? size + alignment : mBlockSize;
+	block.Data = (char*)malloc( block.Size );
+
+	mBlocks.push_back( block );
+	mCurrentBlock = mBlocks.size() - 1;
+	mOffset = 0;
+
+	return allocate( size, alignment );
+}
+
+void ArenaAllocator::deallocate( void *, const size_t& ) {
+}
+
+void ArenaAllocator::reset() {
+	mCurrentBlock	= 0;
+	mOffset			= 0;
+	mUsedMemory		= 0;
+}
+
+void ArenaAllocator::release() {
+	for ( size_t i = 0; i < mBlocks.size(); i++ )
+		free( mBlocks[i].Data );
+
+	mBlocks.clear();
+
+	reset();
+}
+
+const size_t& ArenaAllocator::getUsedMemory() const {
+	return mUsedMemory;
+}
+
+const size_t& ArenaAllocator::getPeakUsedMemory() const {
+	return mPeakUsedMemory;
+}
+
+size_t ArenaAllocator::getReservedMemory() const {
+	size_t size = 0;
+
+	for ( size_t i = 0; i < mBlocks.size(); i++ )
+		size += mBlocks[i].Size;
+
+	return size;
+}
+
+size_t ArenaAllocator::getBlockCount() const {
+	return mBlocks.size();
+}
+
+}
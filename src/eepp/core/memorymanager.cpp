@@ -1,21 +1,210 @@
 #include <iostream>
 #include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 #include <eepp/core/memorymanager.hpp>
 #include <eepp/core/debug.hpp>
 #include <eepp/system/log.hpp>
 #include <eepp/system/filesystem.hpp>
-#include <eepp/system/mutex.hpp>
-#include <eepp/system/lock.hpp>
 
 using namespace EE::System;
 
 namespace EE {
 
-static AllocatedPointerMap sMapPointers;
-static size_t sTotalMemoryUsage = 0;
-static size_t sPeakMemoryUsage = 0;
-static AllocatedPointer sBiggestAllocation = AllocatedPointer( NULL, "", 0, 0 );
-static Mutex sAlloMutex;
+// Every structure here lives in zero-initialized static storage and it's allocated with malloc, so the tracker works before the
+// static constructors run and it never tracks itself.
+
+#define EE_MM_MAX_CALL_SITES	16384
+#define EE_MM_SHARDS			64
+
+namespace {
+
+class SpinLock {
+	public:
+		SpinLock( std::atomic_flag& flag ) :
+			mFlag( flag )
+		{
+			// Yield after a few tries, the thread holding the lock may be waiting for a core
+			for ( int spins = 0; mFlag.test_and_set( std::memory_order_acquire ); spins++ ) {
+				if ( spins >= 64 )
+					std::this_thread::yield();
+			}
+		}
+
+		~SpinLock() {
+			mFlag.clear( std::memory_order_release );
+		}
+	protected:
+		std::atomic_flag& mFlag;
+};
+
+struct CallSite {
+	const char *		File;
+	int					Line;
+	std::atomic<Int64>	LiveMemory;
+	std::atomic<Int64>	PeakMemory;
+	std::atomic<Int64>	LiveCount;
+	std::atomic<Int64>	TotalCount;
+};
+
+struct PointerEntry {
+	void *	Data;
+	Uint32	CallSite;
+	size_t	Memory;
+};
+
+/** Open addressing hash table of the pointers ( linear probing, removals shift back the following entries ) */
+struct PointerShard {
+	std::atomic_flag	Lock;
+	PointerEntry *		Entries;
+	size_t				Capacity;
+	size_t				Size;
+};
+
+CallSite			sCallSites[ EE_MM_MAX_CALL_SITES ];
+std::atomic<Uint32>	sCallSitesCount;
+std::atomic_flag	sCallSitesLock = ATOMIC_FLAG_INIT;
+PointerShard		sShards[ EE_MM_SHARDS ];
+std::atomic<Int64>	sTotalMemoryUsage;
+std::atomic<Int64>	sPeakMemoryUsage;
+std::atomic<size_t>	sBiggestMemory;
+std::atomic<Uint32>	sBiggestCallSite;
+std::atomic<void*>	sBiggestData;
+std::atomic_flag	sBiggestLock = ATOMIC_FLAG_INIT;
+
+inline size_t hashPointer( void * data ) {
+	Uint64 key = (Uint64)(UintPtr)data;
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdULL;
+	key ^= key >> 33;
+	return (size_t)key;
+}
+
+inline PointerShard& getShard( const size_t& hash ) {
+	return sShards[ ( hash >> 24 ) % EE_MM_SHARDS ];
+}
+
+inline void updateMax( std::atomic<Int64>& max, const Int64& value ) {
+	Int64 cur = max.load( std::memory_order_relaxed );
+
+	while ( cur < value && !max.compare_exchange_weak( cur, value, std::memory_order_relaxed ) );
+}
+
+void shardGrow( PointerShard& shard ) {
+	PointerEntry * entries = shard.Entries;
+	size_t capacity = shard.Capacity;
+
+	shard.Capacity	= capacity ? capacity * 2 : 256;
+	shard.Entries	= (PointerEntry*)calloc( shard.Capacity, sizeof(PointerEntry) );
+
+	for ( size_t i = 0; i < capacity; i++ ) {
+		if ( NULL != entries[i].Data ) {
+			size_t n = hashPointer( entries[i].Data ) & ( shard.Capacity - 1 );
+
+			while ( NULL != shard.Entries[n].Data )
+				n = ( n + 1 ) & ( shard.Capacity - 1 );
+
+			shard.Entries[n] = entries[i];
+		}
+	}
+
+	::free( entries );
+}
+
+/** Inserts the pointer. @return False if the pointer is already in the shard. */
+bool shardInsert( PointerShard& shard, const size_t& hash, const PointerEntry& entry ) {
+	if ( ( shard.Size + 1 ) * 4 > shard.Capacity * 3 )
+		shardGrow( shard );
+
+	size_t mask = shard.Capacity - 1;
+	size_t i = hash & mask;
+
+	while ( NULL != shard.Entries[i].Data ) {
+		if ( entry.Data == shard.Entries[i].Data )
+			return false;
+
+		i = ( i + 1 ) & mask;
+	}
+
+	shard.Entries[i] = entry;
+	shard.Size++;
+
+	return true;
+}
+
+/** Removes the pointer. @return False if the pointer is not in the shard. */
+bool shardRemove( PointerShard& shard, const size_t& hash, void * data, PointerEntry& removed ) {
+	if ( 0 == shard.Size )
+		return false;
+
+	size_t mask = shard.Capacity - 1;
+	size_t i = hash & mask;
+
+	while ( data != shard.Entries[i].Data ) {
+		if ( NULL == shard.Entries[i].Data )
+			return false;
+
+		i = ( i + 1 ) & mask;
+	}
+
+	removed = shard.Entries[i];
+
+	// Shift back the entries of the cluster that can't be found anymore after the removal
+	size_t j = i;
+
+	while ( true ) {
+		j = ( j + 1 ) & mask;
+
+		if ( NULL == shard.Entries[j].Data )
+			break;
+
+		size_t k = hashPointer( shard.Entries[j].Data ) & mask;
+
+		if ( ( j > i && ( k <= i || k > j ) ) || ( j < i && ( k <= i && k > j ) ) ) {
+			shard.Entries[i] = shard.Entries[j];
+			i = j;
+		}
+	}
+
+	shard.Entries[i].Data = NULL;
+	shard.Size--;
+
+	return true;
+}
+
+void trackAllocation( const Uint32& callSite, const size_t& memory ) {
+	CallSite& site = sCallSites[ callSite ];
+
+	Int64 live = site.LiveMemory.fetch_add( memory, std::memory_order_relaxed ) + memory;
+
+	updateMax( site.PeakMemory, live );
+	site.LiveCount.fetch_add( 1, std::memory_order_relaxed );
+	site.TotalCount.fetch_add( 1, std::memory_order_relaxed );
+
+	Int64 total = sTotalMemoryUsage.fetch_add( memory, std::memory_order_relaxed ) + memory;
+
+	updateMax( sPeakMemoryUsage, total );
+}
+
+void untrackAllocation( const Uint32& callSite, const size_t& memory ) {
+	CallSite& site = sCallSites[ callSite ];
+
+	site.LiveMemory.fetch_sub( memory, std::memory_order_relaxed );
+	site.LiveCount.fetch_sub( 1, std::memory_order_relaxed );
+
+	sTotalMemoryUsage.fetch_sub( memory, std::memory_order_relaxed );
+}
+
+bool compareLiveMemory( const AllocationCallSite& a, const AllocationCallSite& b ) {
+	return a.LiveMemory > b.LiveMemory || ( a.LiveMemory == b.LiveMemory && a.PeakMemory > b.PeakMemory );
+}
+
+const char * callSiteFile( const Uint32& callSite ) {
+	return NULL != sCallSites[ callSite ].File ? sCallSites[ callSite ].File : "unknown";
+}
+
+}
 
 AllocatedPointer::AllocatedPointer( void * Data, const std::string& File, int Line, size_t Memory ) {
 	mData 		= Data;
@@ -24,64 +213,185 @@ AllocatedPointer::AllocatedPointer( void * Data, const std::string& File, int Li
 	mMemory 	= Memory;
 }
 
-void * MemoryManager::addPointerInPlace( void * Place, const AllocatedPointer& aAllocatedPointer ) {
-	AllocatedPointerMapIt it = sMapPointers.find( Place );
+Uint32 MemoryManager::registerCallSite( const char * file, int line ) {
+	SpinLock l( sCallSitesLock );
 
-	if ( it != sMapPointers.end() ) {
-		removePointer( Place );
+	Uint32 count = sCallSitesCount.load( std::memory_order_relaxed );
+
+	// The same line can be registered from different translation units ( allocations in headers )
+	for ( Uint32 i = 1; i < count; i++ ) {
+		if ( sCallSites[i].Line == line && 0 == strcmp( sCallSites[i].File, file ) )
+			return i;
 	}
 
-	return addPointer( aAllocatedPointer );
+	// The call site 0 collects the allocations of the call sites that don't fit in the table
+	if ( 0 == count )
+		count = 1;
+
+	if ( count >= EE_MM_MAX_CALL_SITES )
+		return 0;
+
+	sCallSites[ count ].File = file;
+	sCallSites[ count ].Line = line;
+
+	sCallSitesCount.store( count + 1, std::memory_order_release );
+
+	return count;
 }
 
-void * MemoryManager::addPointer( const AllocatedPointer& aAllocatedPointer ) {
-	Lock l( sAlloMutex );
+void * MemoryManager::addPointerInPlace( void * place, void * data, const Uint32& callSite, size_t memory ) {
+	size_t hash = hashPointer( place );
+	PointerShard& shard = getShard( hash );
+	PointerEntry removed;
+	bool found;
 
-	sMapPointers.insert( AllocatedPointerMap::value_type( aAllocatedPointer.mData, aAllocatedPointer ) );
+	{
+		SpinLock l( shard.Lock );
 
-	sTotalMemoryUsage += aAllocatedPointer.mMemory;
+		found = shardRemove( shard, hash, place, removed );
+	}
+
+	if ( found )
+		untrackAllocation( removed.CallSite, removed.Memory );
+
+	return addPointer( data, callSite, memory );
+}
 
-	if ( sPeakMemoryUsage < sTotalMemoryUsage ) {
-		sPeakMemoryUsage = sTotalMemoryUsage;
+void * MemoryManager::addPointer( void * data, const Uint32& callSite, size_t memory ) {
+	size_t hash = hashPointer( data );
+	PointerShard& shard = getShard( hash );
+	PointerEntry entry;
+
+	entry.Data		= data;
+	entry.CallSite	= callSite;
+	entry.Memory	= memory;
+
+	{
+		SpinLock l( shard.Lock );
+
+		if ( !shardInsert( shard, hash, entry ) )
+			return data;
 	}
 
-	if ( aAllocatedPointer.mMemory > sBiggestAllocation.mMemory ) {
-		sBiggestAllocation = aAllocatedPointer;
+	trackAllocation( callSite, memory );
+
+	if ( memory > sBiggestMemory.load( std::memory_order_relaxed ) ) {
+		SpinLock l( sBiggestLock );
+
+		if ( memory > sBiggestMemory.load( std::memory_order_relaxed ) ) {
+			sBiggestMemory.store( memory, std::memory_order_relaxed );
+			sBiggestCallSite.store( callSite, std::memory_order_relaxed );
+			sBiggestData.store( data, std::memory_order_relaxed );
+		}
 	}
 
-	return aAllocatedPointer.mData;
+	return data;
 }
 
 bool MemoryManager::removePointer( void * Data ) {
-	Lock l( sAlloMutex );
+	size_t hash = hashPointer( Data );
+	PointerShard& shard = getShard( hash );
+	PointerEntry removed;
+	bool found;
+
+	{
+		SpinLock l( shard.Lock );
 
-	AllocatedPointerMapIt it = sMapPointers.find( Data );
+		found = shardRemove( shard, hash, Data, removed );
+	}
 
-	if ( it == sMapPointers.end() ) {
+	if ( !found ) {
 		eePRINTL( "Trying to delete pointer %p created that does not exist!", Data );
 
 		return false;
 	}
 
-	sTotalMemoryUsage -= it->second.mMemory;
-
-	sMapPointers.erase( it );
+	untrackAllocation( removed.CallSite, removed.Memory );
 
 	return true;
 }
 
 size_t MemoryManager::getPeakMemoryUsage() {
-	return sPeakMemoryUsage;
+	return (size_t)sPeakMemoryUsage.load( std::memory_order_relaxed );
 }
 
 size_t MemoryManager::getTotalMemoryUsage() {
-	return sTotalMemoryUsage;
+	return (size_t)sTotalMemoryUsage.load( std::memory_order_relaxed );
 }
 
 const AllocatedPointer& MemoryManager::getBiggestAllocation() {
+	static AllocatedPointer sBiggestAllocation( NULL, "", 0, 0 );
+
+	SpinLock l( sBiggestLock );
+
+	Uint32 callSite = sBiggestCallSite.load( std::memory_order_relaxed );
+
+	sBiggestAllocation.mData	= sBiggestData.load( std::memory_order_relaxed );
+	sBiggestAllocation.mMemory	= sBiggestMemory.load( std::memory_order_relaxed );
+	sBiggestAllocation.mFile	= NULL != sBiggestAllocation.mData ? callSiteFile( callSite ) : "";
+	sBiggestAllocation.mLine	= NULL != sBiggestAllocation.mData ? sCallSites[ callSite ].Line : 0;
+
 	return sBiggestAllocation;
 }
 
+std::vector<AllocationCallSite> MemoryManager::getCallSites() {
+	std::vector<AllocationCallSite> sites;
+	Uint32 count = sCallSitesCount.load( std::memory_order_acquire );
+
+	for ( Uint32 i = 0; i < count; i++ ) {
+		CallSite& site = sCallSites[i];
+		AllocationCallSite info;
+
+		info.File		= callSiteFile( i );
+		info.Line		= site.Line;
+		info.LiveMemory	= site.LiveMemory.load( std::memory_order_relaxed );
+		info.PeakMemory	= site.PeakMemory.load( std::memory_order_relaxed );
+		info.LiveCount	= site.LiveCount.load( std::memory_order_relaxed );
+		info.TotalCount	= site.TotalCount.load( std::memory_order_relaxed );
+
+		if ( info.TotalCount > 0 )
+			sites.push_back( info );
+	}
+
+	return sites;
+}
+
+void MemoryManager::showCallSitesReport( const Uint32& count ) {
+	#ifdef EE_MEMORY_MANAGER
+
+	std::vector<AllocationCallSite> sites( getCallSites() );
+
+	std::sort( sites.begin(), sites.end(), compareLiveMemory );
+
+	if ( count > 0 && sites.size() > count )
+		sites.resize( count );
+
+	eePRINTL("\n|--Memory Manager Call Sites Report---------------------------|");
+	eePRINTL("|");
+	eePRINTL( "| live memory\t peak memory\t live allocs\t total allocs\t file:line" );
+	eePRINTL( "|------------------------------------------------------------|" );
+
+	for ( size_t i = 0; i < sites.size(); i++ ) {
+		AllocationCallSite& site = sites[i];
+
+		eePRINTL( "| %s\t %s\t %lld\t\t %lld\t\t %s:%d",
+			FileSystem::sizeToString( site.LiveMemory ).c_str(),
+			FileSystem::sizeToString( site.PeakMemory ).c_str(),
+			(long long)site.LiveCount,
+			(long long)site.TotalCount,
+			site.File,
+			site.Line
+		);
+	}
+
+	eePRINTL( "|" );
+	eePRINTL( "| Memory used: %s", FileSystem::sizeToString( static_cast<Int64>( getTotalMemoryUsage() ) ).c_str() );
+	eePRINTL( "| Peak Memory Usage: %s", FileSystem::sizeToString( getPeakMemoryUsage() ).c_str() );
+	eePRINTL( "|------------------------------------------------------------|\n" );
+
+	#endif
+}
+
 void MemoryManager::showResults() {
 	#ifdef EE_MEMORY_MANAGER
 
@@ -90,10 +400,22 @@ void MemoryManager::showResults() {
 		EE::PrintDebugInLog = false;
 	}
 
+	std::vector<PointerEntry> leaks;
+
+	for ( Uint32 s = 0; s < EE_MM_SHARDS; s++ ) {
+		PointerShard& shard = sShards[s];
+		SpinLock l( shard.Lock );
+
+		for ( size_t i = 0; i < shard.Capacity; i++ ) {
+			if ( NULL != shard.Entries[i].Data )
+				leaks.push_back( shard.Entries[i] );
+		}
+	}
+
 	eePRINTL("\n|--Memory Manager Report-------------------------------------|");
 	eePRINTL("|");
 
-	if( sMapPointers.empty() ) {
+	if( leaks.empty() ) {
 		eePRINTL( "| No memory leaks detected." );
 	} else {
 		eePRINTL( "| Memory leaks detected: " );
@@ -102,13 +424,12 @@ void MemoryManager::showResults() {
 
 		//Get max length of file name
 		int lMax =0;
-		AllocatedPointerMapIt it = sMapPointers.begin();
 
-		for( ; it != sMapPointers.end(); ++it ){
-			AllocatedPointer &ap = it->second;
+		for( size_t i = 0; i < leaks.size(); i++ ) {
+			int len = (int)strlen( callSiteFile( leaks[i].CallSite ) );
 
-			if( (int)ap.mFile.length() > lMax )
-				lMax = (int)ap.mFile.length();
+			if( len > lMax )
+				lMax = len;
 		}
 
 		lMax += 5;
@@ -120,27 +441,31 @@ void MemoryManager::showResults() {
 
 		eePRINTL( "|-----------------------------------------------------------|" );
 
-		it = sMapPointers.begin();
+		for( size_t i = 0; i < leaks.size(); i++ ) {
+			PointerEntry &ap = leaks[i];
+			const char * file = callSiteFile( ap.CallSite );
 
-		for( ; it != sMapPointers.end(); ++it ) {
-			AllocatedPointer &ap = it->second;
+			eePRINT( "| %p\t %s", ap.Data, file );
 
-			eePRINT( "| %p\t %s", ap.mData, ap.mFile.c_str() );
-
-			for ( int i=0; i < lMax - (int)ap.mFile.length(); ++i )
+			for ( int i=0; i < lMax - (int)strlen( file ); ++i )
 				eePRINT(" ");
 
-			eePRINTL( "%d\t\t %d\t", ap.mLine, ap.mMemory );
+			eePRINTL( "%d\t\t %d\t", sCallSites[ ap.CallSite ].Line, ap.Memory );
 		}
 	}
 
+	const AllocatedPointer& biggest = getBiggestAllocation();
+
 	eePRINTL( "|" );
-	eePRINTL( "| Memory left: %s", FileSystem::sizeToString( static_cast<Int64>( sTotalMemoryUsage ) ).c_str() );
+	eePRINTL( "| Memory left: %s", FileSystem::sizeToString( static_cast<Int64>( getTotalMemoryUsage() ) ).c_str() );
 	eePRINTL( "| Biggest allocation:" );
-	eePRINTL( "| %s in file: %s at line: %d", FileSystem::sizeToString( sBiggestAllocation.mMemory ).c_str(), sBiggestAllocation.mFile.c_str(), sBiggestAllocation.mLine );
-	eePRINTL( "| Peak Memory Usage: %s", FileSystem::sizeToString( sPeakMemoryUsage ).c_str() );
+	eePRINTL( "| %s in file: %s at line: %d", FileSystem::sizeToString( biggest.mMemory ).c_str(), biggest.mFile.c_str(), biggest.mLine );
+	eePRINTL( "| Peak Memory Usage: %s", FileSystem::sizeToString( getPeakMemoryUsage() ).c_str() );
 	eePRINTL( "|------------------------------------------------------------|\n" );
 
+	if ( !leaks.empty() )
+		showCallSitesReport();
+
 	#endif
 }
 
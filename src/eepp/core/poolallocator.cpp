@@ -0,0 +1,152 @@
+#include <eepp/core/poolallocator.hpp>
+#include <algorithm>
+#include <thread>
+#include <cstdlib>
+
+namespace EE {
+
+PoolAllocator::PoolAllocator( const size_t& blockSize, const size_t& blocksPerChunk ) :
+	mBlockSize( ( ( blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : blockSize ) + 15 ) & ~(size_t)15 ),
+	mBlocksPerChunk( blocksPerChunk > 0 ? blocksPerChunk : 1 ),
+	mFreeList( NULL ),
+	mUsedBlocks( 0 ),
+	mPeakUsedBlocks( 0 ),
+	mHeapAllocations( 0 ),
+	mEnabled( true )
+{
+	mLock.clear();
+}
+
+PoolAllocator::~PoolAllocator() {
+	for ( size_t i = 0; i < mChunks.size(); i++ )
+		free( mChunks[i] );
+}
+
+void PoolAllocator::lock() {
+	// Yield after a few tries, the thread holding the lock may be waiting for a core
+	for ( int spins = 0; mLock.test_and_set( std::memory_order_acquire ); spins++ ) {
+		if ( spins >= 64 )
+			std::this_thread::yield();
+	}
+}
+
+void PoolAllocator::unlock() {
+	mLock.clear( std::memory_order_release );
+}
+
+void PoolAllocator::allocateChunk() {
+	char * chunk = (char*)malloc( mBlockSize * mBlocksPerChunk );
+
+	// Link the blocks in address order
+	for ( size_t i = mBlocksPerChunk; i > 0; i-- ) {
+		FreeBlock * block = reinterpret_cast<FreeBlock*>( chunk + ( i - 1 ) * mBlockSize );
+		block->Next = mFreeList;
+		mFreeList = block;
+	}
+
+	mChunks.insert( std::upper_bound( mChunks.begin(), mChunks.end(), chunk ), chunk );
+}
+
+void * PoolAllocator::allocate( const size_t& size ) {
+	lock();
+
+	if ( size > mBlockSize || !mEnabled ) {
+		mHeapAllocations++;
+		unlock();
+		return malloc( size );
+	}
+
+	if ( NULL == mFreeList )
+		allocateChunk();
+
+	FreeBlock * block = mFreeList;
+	mFreeList = block->Next;
+
+	if ( ++mUsedBlocks > mPeakUsedBlocks )
+		mPeakUsedBlocks = mUsedBlocks;
+
+	unlock();
+
+	return block;
+}
+
+void PoolAllocator::deallocate( void * ptr, const size_t& size ) {
+	if ( NULL == ptr )
+		return;
+
+	if ( size > mBlockSize ) {
+		free( ptr );
+		return;
+	}
+
+	lock();
+
+	if ( ownsUnlocked( ptr ) ) {
+		FreeBlock * block = reinterpret_cast<FreeBlock*>( ptr );
+		block->Next = mFreeList;
+		mFreeList = block;
+		mUsedBlocks--;
+
+		unlock();
+	} else {
+		unlock();
+
+		free( ptr );
+	}
+}
+
+bool PoolAllocator::ownsUnlocked( void * ptr ) const {
+	char * p = reinterpret_cast<char*>( ptr );
+	std::vector<char*>::const_iterator it = std::upper_bound( mChunks.begin(), mChunks.end(), p );
+
+	if ( it == mChunks.begin() )
+		return false;
+
+	--it;
+
+	return p < *it + mBlockSize * mBlocksPerChunk;
+}
+
+bool PoolAllocator::owns( void * ptr ) {
+	lock();
+
+	bool res = ownsUnlocked( ptr );
+
+	unlock();
+
+	return res;
+}
+
+void PoolAllocator::setEnabled( const bool& enabled ) {
+	mEnabled = enabled;
+}
+
+bool PoolAllocator::isEnabled() const {
+	return mEnabled;
+}
+
+const size_t& PoolAllocator::getBlockSize() const {
+	return mBlockSize;
+}
+
+size_t PoolAllocator::getUsedBlocks() const {
+	return mUsedBlocks;
+}
+
+size_t PoolAllocator::getPeakUsedBlocks() const {
+	return mPeakUsedBlocks;
+}
+
+size_t PoolAllocator::getCapacity() const {
+	return mChunks.size() * mBlocksPerChunk;
+}
+
+size_t PoolAllocator::getHeapAllocations() const {
+	return mHeapAllocations;
+}
+
+size_t PoolAllocator::getReservedMemory() const {
+	return mChunks.size() * mBlocksPerChunk * mBlockSize;
+}
+
+}
@@ -28,6 +28,16 @@ Uint32 String::hash( const char * str ) {
 	return String::hash( reinterpret_cast<const Uint8*>( str ) );
 }
 
+Uint32 String::hash( const Uint8 * data, const Uint32& size ) {
+	//! djb2
+	Uint32 hash = 5381;
+
+	for ( Uint32 i = 0; i < size; i++ )
+		hash = ( ( hash << 5 ) + hash ) + data[i];
+
+	return hash;
+}
+
 Uint32 String::hash( const std::string& str ) {
 	return String::hash( reinterpret_cast<const Uint8*>( &str[0] ) );
 }
@@ -4,9 +4,44 @@
 #include <eepp/graphics/globalbatchrenderer.hpp>
 #include <eepp/graphics/renderer/openglext.hpp>
 #include <eepp/graphics/renderer/renderer.hpp>
+#include <algorithm>
 
 namespace EE { namespace Graphics {
 
+BatchRenderer::Stats::Stats() {
+	reset();
+}
+
+void BatchRenderer::Stats::reset() {
+	DrawCalls	= 0;
+	Vertexs		= 0;
+	Batches		= 0;
+	Flushes		= 0;
+
+	for ( int i = 0; i < FlushCauseCount; i++ )
+		FlushesByCause[i] = 0;
+}
+
+class BatchRenderer::DeferredBatchLess {
+	public:
+		DeferredBatchLess( const std::vector<DeferredBatch>& batches ) : mBatches( batches ) {}
+
+		bool operator()( const Uint32& left, const Uint32& right ) const {
+			const DeferredBatch& l = mBatches[ left ];
+			const DeferredBatch& r = mBatches[ right ];
+
+			if ( l.Layer != r.Layer )
+				return l.Layer < r.Layer;
+
+			if ( l.Tex != r.Tex )
+				return std::less<const Texture*>()( l.Tex, r.Tex );
+
+			return l.Blend < r.Blend;
+		}
+	protected:
+		const std::vector<DeferredBatch>& mBatches;
+};
+
 BatchRenderer::BatchRenderer() :
 	mVertex( NULL ),
 	mVertexSize( 0 ),
@@ -21,7 +56,9 @@ BatchRenderer::BatchRenderer() :
 	mPosition(0.0f, 0.0f),
 	mCenter(0.0f, 0.0f),
 	mForceRendering(false),
-	mForceBlendMode(true)
+	mForceBlendMode(true),
+	mDeferred(false),
+	mLayer(0)
 {
 	allocVertexs( 1024 );
 	init();
@@ -41,7 +78,9 @@ BatchRenderer::BatchRenderer( const unsigned int& Prealloc ) :
 	mPosition(0.0f, 0.0f),
 	mCenter(0.0f, 0.0f),
 	mForceRendering(false),
-	mForceBlendMode(true)
+	mForceBlendMode(true),
+	mDeferred(false),
+	mLayer(0)
 {
 	allocVertexs( Prealloc );
 	init();
@@ -64,47 +103,240 @@ void BatchRenderer::allocVertexs( const unsigned int& size ) {
 
 void BatchRenderer::drawOpt() {
 	if ( mForceRendering )
-		flush();
+		flush( FlushDraw );
 }
 
 void BatchRenderer::draw() {
-	flush();
+	flush( FlushDraw );
 }
 
 void BatchRenderer::setTexture( const Texture * Tex ) {
-	if ( mTexture != Tex )
-		flush();
+	if ( mTexture != Tex && !isDeferring() )
+		flush( FlushTexture );
 
 	mTexture = Tex;
 }
 
 void BatchRenderer::setBlendMode( const EE_BLEND_MODE& Blend ) {
-	if ( Blend != mBlend )
-		flush();
+	if ( Blend != mBlend && !isDeferring() )
+		flush( FlushBlendMode );
 
 	mBlend = Blend;
 }
 
 void BatchRenderer::addVertexs( const unsigned int& num ) {
+	if ( isDeferring() )
+		addDeferredVertexs( num );
+
 	mNumVertex += num;
 
 	if ( ( mNumVertex + num ) >= mVertexSize )
-		flush();
+		flush( FlushBufferFull );
 }
 
 void BatchRenderer::setDrawMode( const EE_DRAW_MODE& Mode, const bool& Force ) {
 	if ( Force && mCurrentMode != Mode ) {
-		flush();
+		flush( FlushDrawMode );
 		mCurrentMode = Mode;
 	}
 }
 
-void BatchRenderer::flush() {	
+bool BatchRenderer::isDeferring() const {
+	return mDeferred && DM_QUADS == mCurrentMode;
+}
+
+bool BatchRenderer::useQuadVertexs() const {
+	// The deferred quads are always stored with 4 vertexs, they're drawn as indexed triangles if the quads aren't supported
+	return isDeferring() || GLi->quadsSupported();
+}
+
+void BatchRenderer::pushBatchMatrix( const Float& rotation, const Vector2f& scale, const Vector2f& position, const Vector2f& center ) {
+	GLi->loadIdentity();
+	GLi->pushMatrix();
+
+	GLi->translatef( position.x + center.x, position.y + center.y, 0.0f);
+	GLi->rotatef( rotation, 0.0f, 0.0f, 1.0f );
+	GLi->scalef( scale.x, scale.y, 1.0f );
+	GLi->translatef( -center.x, -center.y, 0.0f);
+}
+
+void BatchRenderer::addDeferredVertexs( const unsigned int& num ) {
+	if ( !mBatches.empty() ) {
+		DeferredBatch& last = mBatches.back();
+
+		if ( last.Tex == mTexture && last.Blend == mBlend && last.Layer == mLayer && last.Rotation == mRotation &&
+			 last.Scale == mScale && last.Position == mPosition && last.Center == mCenter ) {
+			last.Count += num;
+			return;
+		}
+	}
+
+	DeferredBatch batch;
+	batch.Tex		= mTexture;
+	batch.Blend		= mBlend;
+	batch.Layer		= mLayer;
+	batch.Rotation	= mRotation;
+	batch.Scale		= mScale;
+	batch.Position	= mPosition;
+	batch.Center	= mCenter;
+	batch.Start		= mNumVertex;
+	batch.Count		= num;
+
+	mBatches.push_back( batch );
+	mStats.Batches++;
+}
+
+void BatchRenderer::flushDeferred() {
+	mNumVertex = 0;
+
+	if ( mBatches.empty() )
+		return;
+
+	// Stable sort the batches by layer, texture and blend mode
+	mBatchesOrder.resize( mBatches.size() );
+
+	for ( Uint32 i = 0; i < mBatchesOrder.size(); i++ )
+		mBatchesOrder[i] = i;
+
+	std::stable_sort( mBatchesOrder.begin(), mBatchesOrder.end(), DeferredBatchLess( mBatches ) );
+
+	Uint32 total = 0;
+
+	for ( Uint32 i = 0; i < mBatches.size(); i++ )
+		total += mBatches[i].Count;
+
+	// Copy the vertexs in the drawing order, in place in the vertex stream if the renderer streams the vertexs
+	eeVertex * sorted = reinterpret_cast<eeVertex*>( GLi->mapVertexStream( sizeof(eeVertex) * total ) );
+	bool mapped = NULL != sorted;
+
+	if ( !mapped ) {
+		if ( mSortedVertex.size() < total )
+			mSortedVertex.resize( total );
+
+		sorted = &mSortedVertex[0];
+	}
+
+	Uint32 pos = 0;
+
+	for ( Uint32 i = 0; i < mBatchesOrder.size(); i++ ) {
+		const DeferredBatch& batch = mBatches[ mBatchesOrder[i] ];
+
+		std::copy( mVertex + batch.Start, mVertex + batch.Start + batch.Count, sorted + pos );
+		pos += batch.Count;
+	}
+
+	if ( mapped )
+		GLi->unmapVertexStream();
+
+	// Draw the consecutive batches with the same state together
+	Uint32 runStart = 0;
+	const DeferredBatch * run = NULL;
+
+	pos = 0;
+
+	for ( Uint32 i = 0; i < mBatchesOrder.size(); i++ ) {
+		const DeferredBatch& batch = mBatches[ mBatchesOrder[i] ];
+
+		if ( NULL != run && ( run->Tex != batch.Tex || run->Blend != batch.Blend || run->Layer != batch.Layer || run->Rotation != batch.Rotation ||
+							  run->Scale != batch.Scale || run->Position != batch.Position || run->Center != batch.Center ) ) {
+			drawDeferredBatch( *run, sorted + runStart, pos - runStart );
+			run = NULL;
+		}
+
+		if ( NULL == run ) {
+			run = &batch;
+			runStart = pos;
+		}
+
+		pos += batch.Count;
+	}
+
+	if ( NULL != run )
+		drawDeferredBatch( *run, sorted + runStart, pos - runStart );
+
+	// The mapped memory isn't valid anymore, its address can't be taken as vertexs already streamed
+	if ( mapped )
+		GLi->releaseVertexStream();
+
+	mBatches.clear();
+}
+
+void BatchRenderer::drawDeferredBatch( const DeferredBatch& batch, eeVertex * vertex, const Uint32& count ) {
+	bool CreateMatrix = ( batch.Rotation || batch.Scale != 1.0f || batch.Position.x || batch.Position.y );
+	bool quads = GLi->quadsSupported();
+
+	BlendMode::setMode( batch.Blend );
+
+	if ( CreateMatrix )
+		pushBatchMatrix( batch.Rotation, batch.Scale, batch.Position, batch.Center );
+
+	if ( NULL != batch.Tex ) {
+		mTF->bind( batch.Tex );
+	} else {
+		GLi->disable( GL_TEXTURE_2D );
+		GLi->disableClientState( GL_TEXTURE_COORD_ARRAY );
+	}
+
+	// The 16 bits indexes can address 65536 vertexs, bigger batches are drawn in parts
+	const Uint32 maxVertexs = 65536;
+
+	if ( !quads && mQuadIndexes.empty() ) {
+		mQuadIndexes.resize( maxVertexs / 4 * 6 );
+
+		for ( Uint32 i = 0; i < maxVertexs / 4; i++ ) {
+			mQuadIndexes[ i * 6 ]		= i * 4;
+			mQuadIndexes[ i * 6 + 1 ]	= i * 4 + 1;
+			mQuadIndexes[ i * 6 + 2 ]	= i * 4 + 2;
+			mQuadIndexes[ i * 6 + 3 ]	= i * 4;
+			mQuadIndexes[ i * 6 + 4 ]	= i * 4 + 2;
+			mQuadIndexes[ i * 6 + 5 ]	= i * 4 + 3;
+		}
+	}
+
+	for ( Uint32 first = 0; first < count; first += maxVertexs ) {
+		Uint32 num = eemin( count - first, maxVertexs );
+		Uint32 alloc = sizeof(eeVertex) * num;
+		char * data = reinterpret_cast<char*> ( &vertex[ first ] );
+
+		GLi->vertexPointer	( 2, GL_FP			, sizeof(eeVertex), data											, alloc	);
+
+		if ( NULL != batch.Tex )
+			GLi->texCoordPointer( 2, GL_FP			, sizeof(eeVertex), data + sizeof(Vector2f)							, alloc	);
+
+		GLi->colorPointer	( 4, GL_UNSIGNED_BYTE	, sizeof(eeVertex), data + sizeof(Vector2f) + sizeof(eeTexCoord)	, alloc	);
+
+		if ( quads )
+			GLi->drawArrays( DM_QUADS, 0, num );
+		else
+			GLi->drawElements( DM_TRIANGLES, num / 4 * 6, GL_UNSIGNED_SHORT, &mQuadIndexes[0] );
+
+		mStats.DrawCalls++;
+		mStats.Vertexs += num;
+	}
+
+	if ( CreateMatrix )
+		GLi->popMatrix();
+
+	if ( NULL == batch.Tex ) {
+		GLi->enable( GL_TEXTURE_2D );
+		GLi->enableClientState( GL_TEXTURE_COORD_ARRAY );
+	}
+}
+
+void BatchRenderer::flush( const FlushCause& cause ) {
 	if ( mNumVertex == 0 )
 		return;
 
 	if ( GlobalBatchRenderer::instance() != this )
-		GlobalBatchRenderer::instance()->draw();
+		static_cast<BatchRenderer*>( GlobalBatchRenderer::instance() )->flush( FlushExternal );
+
+	mStats.Flushes++;
+	mStats.FlushesByCause[ cause ]++;
+
+	if ( isDeferring() ) {
+		flushDeferred();
+		return;
+	}
 
 	Uint32 NumVertex = mNumVertex;
 	mNumVertex = 0;
@@ -118,27 +350,24 @@ void BatchRenderer::flush() {
 		GLi->pointSize( (float)mTexture->getWidth() );
 	}
 
-	if ( CreateMatrix ) {
-		GLi->loadIdentity();
-		GLi->pushMatrix();
-
-		GLi->translatef( mPosition.x + mCenter.x, mPosition.y + mCenter.y, 0.0f);
-		GLi->rotatef( mRotation, 0.0f, 0.0f, 1.0f );
-		GLi->scalef( mScale.x, mScale.y, 1.0f );
-		GLi->translatef( -mCenter.x, -mCenter.y, 0.0f);
-	}
+	if ( CreateMatrix )
+		pushBatchMatrix( mRotation, mScale, mPosition, mCenter );
 
 	Uint32 alloc	= sizeof(eeVertex) * NumVertex;
 
 	if ( NULL != mTexture ) {
 		mTF->bind( mTexture );
-		GLi->texCoordPointer( 2, GL_FP			, sizeof(eeVertex), reinterpret_cast<char*> ( &mVertex[0] ) + sizeof(Vector2f)						, alloc		);
 	} else {
 		GLi->disable( GL_TEXTURE_2D );
 		GLi->disableClientState( GL_TEXTURE_COORD_ARRAY );
 	}
 
+	// The vertex pointer goes first, so the vertexs are uploaded once and the other pointers use the same upload
 	GLi->vertexPointer	( 2, GL_FP				, sizeof(eeVertex), reinterpret_cast<char*> ( &mVertex[0] )												, alloc		);
+
+	if ( NULL != mTexture )
+		GLi->texCoordPointer( 2, GL_FP			, sizeof(eeVertex), reinterpret_cast<char*> ( &mVertex[0] ) + sizeof(Vector2f)						, alloc		);
+
 	GLi->colorPointer	( 4, GL_UNSIGNED_BYTE	, sizeof(eeVertex), reinterpret_cast<char*> ( &mVertex[0] ) + sizeof(Vector2f) + sizeof(eeTexCoord)	, alloc		);
 
 	if ( !GLi->quadsSupported() ) {
@@ -153,6 +382,9 @@ void BatchRenderer::flush() {
 		GLi->drawArrays( mCurrentMode, 0, NumVertex );
 	}
 
+	mStats.DrawCalls++;
+	mStats.Vertexs += NumVertex;
+
 	if ( CreateMatrix ) {
 		GLi->popMatrix();
 	}
@@ -172,7 +404,7 @@ void BatchRenderer::batchQuad( const Float& x, const Float& y, const Float& widt
 }
 
 void BatchRenderer::batchQuadEx( Float x, Float y, Float width, Float height, Float angle, Vector2f scale, OriginPoint originPoint ) {
-	if ( mNumVertex + ( GLi->quadsSupported() ? 3 : 5 ) >= mVertexSize )
+	if ( mNumVertex + ( useQuadVertexs() ? 3 : 5 ) >= mVertexSize )
 		return;
 
 	if ( originPoint.OriginType == OriginPoint::OriginCenter ) {
@@ -193,7 +425,7 @@ void BatchRenderer::batchQuadEx( Float x, Float y, Float width, Float height, Fl
 
 	setDrawMode( DM_QUADS, mForceBlendMode );
 
-	if ( GLi->quadsSupported() ) {
+	if ( useQuadVertexs() ) {
 		mTVertex 		= &mVertex[ mNumVertex ];
 		mTVertex->pos.x = x;
 		mTVertex->pos.y = y;
@@ -267,12 +499,12 @@ void BatchRenderer::batchQuadEx( Float x, Float y, Float width, Float height, Fl
 }
 
 void BatchRenderer::batchQuadFree( const Float& x0, const Float& y0, const Float& x1, const Float& y1, const Float& x2, const Float& y2, const Float& x3, const Float& y3 ) {
-	if ( mNumVertex + ( GLi->quadsSupported() ? 3 : 5 ) >= mVertexSize )
+	if ( mNumVertex + ( useQuadVertexs() ? 3 : 5 ) >= mVertexSize )
 		return;
 
 	setDrawMode( DM_QUADS, mForceBlendMode );
 
-	if ( GLi->quadsSupported() ) {
+	if ( useQuadVertexs() ) {
 		mTVertex 		= &mVertex[ mNumVertex ];
 		mTVertex->pos.x = x0;
 		mTVertex->pos.y = y0;
@@ -340,7 +572,7 @@ void BatchRenderer::batchQuadFree( const Float& x0, const Float& y0, const Float
 }
 
 void BatchRenderer::batchQuadFreeEx( const Float& x0, const Float& y0, const Float& x1, const Float& y1, const Float& x2, const Float& y2, const Float& x3, const Float& y3, const Float& Angle, const Float& Scale ) {
-	if ( mNumVertex + ( GLi->quadsSupported() ? 3 : 5 ) >= mVertexSize )
+	if ( mNumVertex + ( useQuadVertexs() ? 3 : 5 ) >= mVertexSize )
 		return;
 
 	Quad2f mQ;
@@ -356,7 +588,7 @@ void BatchRenderer::batchQuadFreeEx( const Float& x0, const Float& y0, const Flo
 
 	setDrawMode( DM_QUADS, mForceBlendMode );
 
-	if ( GLi->quadsSupported() ) {
+	if ( useQuadVertexs() ) {
 		mTVertex 		= &mVertex[ mNumVertex ];
 		mTVertex->pos.x = mQ[0].x;
 		mTVertex->pos.y = mQ[0].y;
@@ -796,13 +1028,7 @@ void BatchRenderer::setLineWidth( const Float& lineWidth ) {
 }
 
 Float BatchRenderer::getLineWidth() {
-	float lw = 1;
-
-#if EE_PLATFORM != EE_PLATFORM_EMSCRIPTEN
-	glGetFloatv( GL_LINE_WIDTH, &lw );
-#endif
-
-	return lw;
+	return GLi->getLineWidth();
 }
 
 void BatchRenderer::setPointSize( const Float& pointSize ) {
@@ -821,4 +1047,37 @@ const bool& BatchRenderer::getForceBlendModeChange() const {
 	return mForceBlendMode;
 }
 
+void BatchRenderer::setDeferred( const bool& deferred ) {
+	if ( deferred != mDeferred ) {
+		flush( FlushDraw );
+
+		mDeferred = deferred;
+	}
+}
+
+const bool& BatchRenderer::isDeferred() const {
+	return mDeferred;
+}
+
+void BatchRenderer::setLayer( const Int32& layer ) {
+	mLayer = layer;
+}
+
+const Int32& BatchRenderer::getLayer() const {
+	return mLayer;
+}
+
+const BatchRenderer::Stats& BatchRenderer::getStats() const {
+	return mStats;
+}
+
+const BatchRenderer::Stats& BatchRenderer::getFrameStats() const {
+	return mFrameStats;
+}
+
+void BatchRenderer::endFrame() {
+	mFrameStats = mStats;
+	mStats.reset();
+}
+
 }}
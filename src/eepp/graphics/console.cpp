@@ -5,6 +5,7 @@
 #include <eepp/window/input.hpp>
 #include <eepp/window/cursormanager.hpp>
 #include <eepp/window/window.hpp>
+#include <eepp/system/lock.hpp>
 #include <algorithm>
 #include <cstdarg>
 
@@ -171,6 +172,8 @@ void Console::addCommand( const String& Command, ConsoleCallback CB ) {
 }
 
 void Console::draw() {
+	pushPendingLog();
+
 	if ( mEnabled && NULL != mFontStyleConfig.Font ) {
 		fade();
 
@@ -247,8 +250,8 @@ void Console::draw() {
 				text2.setString( "_" );
 				text2.draw( mFontSize + width, CurY );
 			} else {
-				text2.setString( "> " + mTBuf->getBuffer().substr( 0, mTBuf->getCursorPos() ) );
-				Uint32 width = mFontSize + text2.getTextWidth();
+				// The command line layout already has the position of the cursor character ( after the "> " prompt )
+				Uint32 width = mFontSize + text.findCharacterPos( 2 + mTBuf->getCursorPos() ).x;
 				text2.setString( "_" );
 				text2.draw( width, CurY );
 			}
@@ -952,10 +955,26 @@ void Console::setFontStyleConfig(const FontStyleConfig & fontStyleConfig)
 }
 
 void Console::writeLog( const std::string& Text ) {
+	// The log can be written from any thread ( and from the log thread in asynchronous mode ), so the lines are added to the console
+	// log when the console is drawn.
 	std::vector<String> Strings = String::split( String( Text ) );
 
+	Lock l( mLogPendingMutex );
+
 	for ( Uint32 i = 0; i < Strings.size(); i++ ) {
-		privPushText( Strings[i] );
+		mLogPending.push_back( Strings[i] );
+	}
+
+	while ( mLogPending.size() > mMaxLogLines )
+		mLogPending.pop_front();
+}
+
+void Console::pushPendingLog() {
+	Lock l( mLogPendingMutex );
+
+	while ( !mLogPending.empty() ) {
+		privPushText( mLogPending.front() );
+		mLogPending.pop_front();
 	}
 }
 
@@ -3,6 +3,8 @@
 #include <eepp/system/pack.hpp>
 #include <eepp/system/packmanager.hpp>
 #include <eepp/graphics/texturefactory.hpp>
+#include <eepp/system/jobsystem.hpp>
+#include <algorithm>
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -33,6 +35,94 @@ namespace {
 
 namespace EE { namespace Graphics {
 
+static bool setFaceSize(FT_Face face, unsigned int characterSize) {
+	// FT_Set_Pixel_Sizes is an expensive function, so we must call it
+	// only when necessary to avoid killing performances
+	FT_UShort currentSize = face->size->metrics.x_ppem;
+
+	if (currentSize != characterSize) {
+		FT_Error result = FT_Set_Pixel_Sizes(face, 0, characterSize);
+
+		if (result == FT_Err_Invalid_Pixel_Size)
+		{
+			// In the case of bitmap fonts, resizing can
+			// fail if the requested size is not available
+			if (!FT_IS_SCALABLE(face))
+			{
+				eePRINTL( "Failed to set bitmap font size to %d", characterSize );
+				eePRINTL( "Available sizes are: " );
+				for (int i = 0; i < face->num_fixed_sizes; ++i)
+					eePRINT( "%d ", face->available_sizes[i].height );
+				eePRINTL("");
+			}
+		}
+
+		return result == FT_Err_Ok;
+	} else {
+		return true;
+	}
+}
+
+// Leave a small padding around characters, so that filtering doesn't
+// pollute them with pixels from neighbors
+static const int GLYPH_PADDING = 1;
+
+class FontTrueType::PrewarmJob {
+	public:
+		PrewarmJob( FontTrueType * font, unsigned int characterSize, bool bold, Float outlineThickness ) :
+			Font( font ),
+			CharacterSize( characterSize ),
+			Bold( bold ),
+			OutlineThickness( outlineThickness )
+		{}
+
+		FontTrueType *				Font;
+		unsigned int				CharacterSize;
+		bool						Bold;
+		Float						OutlineThickness;
+		std::vector<Uint32>			CodePoints;
+		std::vector<GlyphBitmap>	Bitmaps;
+
+		void run() {
+			FT_Library library;
+			if (FT_Init_FreeType(&library) != 0)
+				return;
+
+			FT_Face face = NULL;
+			FT_Error err;
+
+			if (!Font->mFilePath.empty())
+				err = FT_New_Face(library, Font->mFilePath.c_str(), 0, &face);
+			else
+				err = FT_New_Memory_Face(library, reinterpret_cast<const FT_Byte*>(Font->mMemoryData), static_cast<FT_Long>(Font->mMemorySize), 0, &face);
+
+			if (err == 0) {
+				FT_Stroker stroker;
+
+				if (FT_Stroker_New(library, &stroker) == 0) {
+					if (FT_Select_Charmap(face, FT_ENCODING_UNICODE) == 0)
+						rasterize(library, face, stroker);
+
+					FT_Stroker_Done(stroker);
+				}
+
+				FT_Done_Face(face);
+			}
+
+			FT_Done_FreeType(library);
+		}
+
+		void rasterize(void* library, void* face, void* stroker) {
+			if (!setFaceSize(static_cast<FT_Face>(face), CharacterSize))
+				return;
+
+			Bitmaps.resize(CodePoints.size());
+
+			for (std::size_t i = 0; i < CodePoints.size(); ++i)
+				Font->rasterizeGlyph(library, face, stroker, CodePoints[i], Bold, OutlineThickness, Bitmaps[i]);
+		}
+};
+
 FontTrueType * FontTrueType::New( const std::string FontName ) {
 	return eeNew( FontTrueType, ( FontName ) );
 }
@@ -44,10 +134,30 @@ FontTrueType::FontTrueType( const std::string FontName ) :
 	mStreamRec(NULL),
 	mStroker  (NULL),
 	mRefCount (NULL),
-	mInfo     ()
+	mInfo     (),
+	mMemoryData(NULL),
+	mMemorySize(0)
 {
 }
 
+FontTrueType::FontTrueType( const FontTrueType& copy ) :
+	Font       (copy),
+	mLibrary   (copy.mLibrary),
+	mFace      (copy.mFace),
+	mStreamRec (copy.mStreamRec),
+	mStroker   (copy.mStroker),
+	mRefCount  (copy.mRefCount),
+	mInfo      (copy.mInfo),
+	mFilePath  (copy.mFilePath),
+	mMemoryData(copy.mMemoryData),
+	mMemorySize(copy.mMemorySize)
+{
+	// Note: as FreeType doesn't provide functions for copying/cloning,
+	// we must share all the FreeType pointers
+	if (mRefCount)
+		(*mRefCount)++;
+}
+
 FontTrueType::~FontTrueType() {
 	cleanup();
 }
@@ -107,6 +217,7 @@ bool FontTrueType::loadFromFile(const std::string& filename) {
 
 	// Store the font information
 	mInfo.family = face->family_name ? face->family_name : std::string();
+	mFilePath = filename;
 
 	return true;
 }
@@ -153,6 +264,8 @@ bool FontTrueType::loadFromMemory(const void* data, std::size_t sizeInBytes) {
 
 	// Store the font information
 	mInfo.family = face->family_name ? face->family_name : std::string();
+	mMemoryData = data;
+	mMemorySize = sizeInBytes;
 
 	return true;
 }
@@ -247,25 +360,75 @@ const FontTrueType::Info& FontTrueType::getInfo() const {
 
 const Glyph& FontTrueType::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, Float outlineThickness) const {
 	// Get the page corresponding to the character size
-	GlyphTable& glyphs = mPages[characterSize].glyphs;
-
-	// Build the key by combining the code point, bold flag, and outline thickness
-	Uint64 key = (static_cast<Uint64>(*reinterpret_cast<Uint32*>(&outlineThickness)) << 32)
-			   | (static_cast<Uint64>(bold ? 1 : 0) << 31)
-			   |  static_cast<Uint64>(codePoint);
+	Page& page = getPage(characterSize);
 
 	// Search the glyph into the cache
-	GlyphTable::const_iterator it = glyphs.find(key);
-	if (it != glyphs.end()) {
+	Glyph * glyph = findGlyph(page, codePoint, bold, outlineThickness);
+
+	if (NULL != glyph) {
 		// Found: just return it
-		return it->second;
+		return *glyph;
 	} else {
 		// Not found: we have to load it
-		Glyph glyph = loadGlyph(codePoint, characterSize, bold, outlineThickness);
-		return glyphs.insert(std::make_pair(key, glyph)).first->second;
+		return storeGlyph(page, codePoint, bold, outlineThickness, loadGlyph(codePoint, characterSize, bold, outlineThickness));
 	}
 }
 
+Uint32 FontTrueType::prewarm( const String& charset, const std::vector<unsigned int>& sizes, bool bold, Float outlineThickness ) {
+	if (!mFace)
+		return 0;
+
+	// A face can only be used by one thread, the jobs need a source to open their own face
+	bool parallel = !mFilePath.empty() || NULL != mMemoryData;
+	std::vector<PrewarmJob*> jobs;
+	std::vector<JobSystem::Handle> handles;
+	Uint32 count = 0;
+
+	for (std::size_t i = 0; i < sizes.size(); ++i) {
+		Page& page = getPage(sizes[i]);
+		HashIndex<bool> queued;
+		PrewarmJob * job = eeNew( PrewarmJob, ( this, sizes[i], bold, outlineThickness ) );
+
+		for (std::size_t c = 0; c < charset.size(); ++c) {
+			Uint32 codePoint = charset[c];
+
+			if (NULL == findGlyph(page, codePoint, bold, outlineThickness) && NULL == queued.find(codePoint)) {
+				queued.insert(codePoint, true);
+				job->CodePoints.push_back(codePoint);
+			}
+		}
+
+		if (job->CodePoints.empty()) {
+			eeDelete( job );
+			continue;
+		}
+
+		jobs.push_back(job);
+
+		if (parallel)
+			handles.push_back(JobSystem::instance()->run(cb::Make0(job, &PrewarmJob::run)));
+	}
+
+	for (std::size_t i = 0; i < jobs.size(); ++i) {
+		PrewarmJob * job = jobs[i];
+
+		if (parallel)
+			JobSystem::instance()->wait(handles[i]);
+
+		// The job couldn't open its own face ( or it didn't run ): rasterize the glyphs here
+		if (job->Bitmaps.size() != job->CodePoints.size())
+			job->rasterize(mLibrary, mFace, mStroker);
+
+		addGlyphBitmaps(getPage(job->CharacterSize), job->Bitmaps, bold, outlineThickness);
+
+		count += job->Bitmaps.size();
+
+		eeDelete( job );
+	}
+
+	return count;
+}
+
 Float FontTrueType::getKerning(Uint32 first, Uint32 second, unsigned int characterSize) const {
 	// Special case where first or second is 0 (null character)
 	if (first == 0 || second == 0)
@@ -356,7 +519,7 @@ Float FontTrueType::getUnderlineThickness(unsigned int characterSize) const {
 }
 
 Texture* FontTrueType::getTexture(unsigned int characterSize) const {
-	return mPages[characterSize].texture;
+	return getPage(characterSize).texture;
 }
 
 FontTrueType& FontTrueType::operator =(const FontTrueType& right) {
@@ -369,6 +532,10 @@ FontTrueType& FontTrueType::operator =(const FontTrueType& right) {
 	std::swap(mRefCount,    temp.mRefCount);
 	std::swap(mInfo,        temp.mInfo);
 	std::swap(mPages,       temp.mPages);
+	std::swap(mPageIndex,   temp.mPageIndex);
+	std::swap(mFilePath,    temp.mFilePath);
+	std::swap(mMemoryData,  temp.mMemoryData);
+	std::swap(mMemorySize,  temp.mMemorySize);
 	std::swap(mPixelBuffer, temp.mPixelBuffer);
 	return *this;
 }
@@ -409,43 +576,116 @@ void FontTrueType::cleanup() {
 	mStroker   = NULL;
 	mStreamRec = NULL;
 	mRefCount  = NULL;
+	mMemoryData = NULL;
+	mMemorySize = 0;
+	mFilePath.clear();
+	mPageIndex.clear();
 	mPages.clear();
 	std::vector<Uint8>().swap(mPixelBuffer);
 }
 
-Glyph FontTrueType::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, Float outlineThickness) const {
-	// The glyph to return
-	Glyph glyph;
+FontTrueType::Page& FontTrueType::getPage(unsigned int characterSize) const {
+	Page ** page = mPageIndex.find(characterSize);
+
+	if (NULL != page)
+		return **page;
+
+	// The pages are owned by the map, their addresses don't change
+	Page& newPage = mPages[characterSize];
+	mPageIndex.insert(characterSize, &newPage);
+	return newPage;
+}
+
+Glyph * FontTrueType::findGlyph(Page& page, Uint32 codePoint, bool bold, Float outlineThickness) const {
+	// Fast path for the Latin-1 glyphs without outline
+	if (codePoint < LATIN_GLYPHS && outlineThickness == 0) {
+		Uint32 index = codePoint + (bold ? LATIN_GLYPHS : 0);
+
+		return page.latinLoaded[index] ? &page.latinGlyphs[index] : NULL;
+	}
 
+	// Build the key by combining the code point, bold flag, and outline thickness
+	Uint64 key = (static_cast<Uint64>(*reinterpret_cast<Uint32*>(&outlineThickness)) << 32)
+			   | (static_cast<Uint64>(bold ? 1 : 0) << 31)
+			   |  static_cast<Uint64>(codePoint);
+
+	return page.glyphs.find(key);
+}
+
+const Glyph& FontTrueType::storeGlyph(Page& page, Uint32 codePoint, bool bold, Float outlineThickness, const Glyph& glyph) const {
+	if (codePoint < LATIN_GLYPHS && outlineThickness == 0) {
+		Uint32 index = codePoint + (bold ? LATIN_GLYPHS : 0);
+
+		page.latinGlyphs[index] = glyph;
+		page.latinLoaded[index] = true;
+		return page.latinGlyphs[index];
+	}
+
+	Uint64 key = (static_cast<Uint64>(*reinterpret_cast<Uint32*>(&outlineThickness)) << 32)
+			   | (static_cast<Uint64>(bold ? 1 : 0) << 31)
+			   |  static_cast<Uint64>(codePoint);
+
+	return *page.glyphs.insert(key, glyph);
+}
+
+Glyph FontTrueType::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, Float outlineThickness) const {
 	// First, transform our ugly void* to a FT_Face
 	FT_Face face = static_cast<FT_Face>(mFace);
 	if (!face) {
 		eePRINTL( "FT_Face failed for: codePoint %d characterSize: %d font %s", codePoint, characterSize, mFontName.c_str() );
-		return glyph;
+		return Glyph();
 	}
 
 	// Set the character size
 	if (!setCurrentSize(characterSize)) {
 		eePRINTL( "FontTrueType::setCurrentSize failed for: codePoint %d characterSize: %d font %s", codePoint, characterSize, mFontName.c_str() );
-		return glyph;
+		return Glyph();
+	}
+
+	// Reuse the pixel buffer
+	GlyphBitmap bitmap;
+	bitmap.pixels.swap(mPixelBuffer);
+
+	rasterizeGlyph(mLibrary, mFace, mStroker, codePoint, bold, outlineThickness, bitmap);
+
+	if (!bitmap.pixels.empty() && bitmap.width > 0 && bitmap.height > 0) {
+		// Get the glyphs page corresponding to the character size
+		Page& page = getPage(characterSize);
+
+		// Find a good position for the new glyph into the texture and write the pixels
+		Rect rect = placeGlyph(page, bitmap);
+		page.texture->update(&bitmap.pixels[0], rect.Right, rect.Bottom, rect.Left, rect.Top);
 	}
 
+	mPixelBuffer.swap(bitmap.pixels);
+
+	// Done :)
+	return bitmap.glyph;
+}
+
+void FontTrueType::rasterizeGlyph(void* library, void* ftFace, void* ftStroker, Uint32 codePoint, bool bold, Float outlineThickness, GlyphBitmap& result) const {
+	FT_Face face = static_cast<FT_Face>(ftFace);
 	FT_Error err = 0;
 
+	result.codePoint = codePoint;
+	result.glyph = Glyph();
+	result.width = 0;
+	result.height = 0;
+
 	// Load the glyph corresponding to the code point
 	FT_Int32 flags = FT_LOAD_TARGET_NORMAL; //  | FT_LOAD_FORCE_AUTOHINT
 	if (outlineThickness != 0)
 		flags |= FT_LOAD_NO_BITMAP;
 	if ( ( err = FT_Load_Char(face, codePoint, flags) ) != 0) {
-		eePRINTL( "FT_Load_Char failed for: codePoint %d characterSize: %d font: %s error: %d", codePoint, characterSize, mFontName.c_str(), err );
-		return glyph;
+		eePRINTL( "FT_Load_Char failed for: codePoint %d characterSize: %d font: %s error: %d", codePoint, face->size->metrics.x_ppem, mFontName.c_str(), err );
+		return;
 	}
 
 	// Retrieve the glyph
 	FT_Glyph glyphDesc;
 	if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0) {
-		eePRINTL( "FT_Get_Glyph failed for: codePoint %d characterSize: %d font: %s", codePoint, characterSize, mFontName.c_str() );
-		return glyph;
+		eePRINTL( "FT_Get_Glyph failed for: codePoint %d characterSize: %d font: %s", codePoint, face->size->metrics.x_ppem, mFontName.c_str() );
+		return;
 	}
 
 	// Apply bold and outline (there is no fallback for outline) if necessary -- first technique using outline (highest quality)
@@ -460,7 +700,7 @@ Glyph FontTrueType::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool
 
 		if (outlineThickness != 0)
 		{
-			FT_Stroker stroker = static_cast<FT_Stroker>(mStroker);
+			FT_Stroker stroker = static_cast<FT_Stroker>(ftStroker);
 
 			FT_Stroker_Set(stroker, static_cast<FT_Fixed>(outlineThickness * static_cast<Float>(1 << 6)), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
 			FT_Glyph_Stroke(&glyphDesc, stroker, false);
@@ -474,13 +714,14 @@ Glyph FontTrueType::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool
 	// Apply bold if necessary -- fallback technique using bitmap (lower quality)
 	if (!outline) {
 		if (bold)
-			FT_Bitmap_Embolden(static_cast<FT_Library>(mLibrary), &bitmap, weight, weight);
+			FT_Bitmap_Embolden(static_cast<FT_Library>(library), &bitmap, weight, weight);
 
 		if (outlineThickness != 0)
 			eePRINTL( "Failed to outline glyph (no fallback available)" );
 	}
 
 	// Compute the glyph's advance offset
+	Glyph& glyph = result.glyph;
 	glyph.advance = static_cast<Float>(face->glyph->metrics.horiAdvance) / static_cast<Float>(1 << 6);
 	if (bold)
 		glyph.advance += static_cast<Float>(weight) / static_cast<Float>(1 << 6);
@@ -489,25 +730,13 @@ Glyph FontTrueType::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool
 	int height = bitmap.rows;
 
 	if ((width > 0) && (height > 0)) {
-		// Leave a small padding around characters, so that filtering doesn't
-		// pollute them with pixels from neighbors
-		const int padding = 1;
+		const int padding = GLYPH_PADDING;
 
 		width += 2 * padding;
 		height += 2 * padding;
 
-		// Get the glyphs page corresponding to the character size
-		Page& page = mPages[characterSize];
-
-		// Find a good position for the new glyph into the texture
-		glyph.textureRect = findGlyphRect(page, width, height);
-
-		// Make sure the texture data is positioned in the center
-		// of the allocated texture rectangle
-		glyph.textureRect.Left += padding;
-		glyph.textureRect.Top += padding;
-		glyph.textureRect.Right -= 2 * padding;
-		glyph.textureRect.Bottom -= 2 * padding;
+		result.width = width;
+		result.height = height;
 
 		// Compute the glyph's bounding box
 		glyph.bounds.Left   =  static_cast<Float>(face->glyph->metrics.horiBearingX) / static_cast<Float>(1 << 6);
@@ -516,9 +745,10 @@ Glyph FontTrueType::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool
 		glyph.bounds.Bottom =  static_cast<Float>(face->glyph->metrics.height)       / static_cast<Float>(1 << 6) + outlineThickness * 2;
 
 		// Resize the pixel buffer to the new size and fill it with transparent white pixels
-		mPixelBuffer.resize(width * height * 4);
+		std::vector<Uint8>& pixelBuffer = result.pixels;
+		pixelBuffer.resize(width * height * 4);
 
-		Uint8* current = &mPixelBuffer[0];
+		Uint8* current = &pixelBuffer[0];
 		Uint8* end = current + width * height * 4;
 
 		while (current != end) {
@@ -539,7 +769,7 @@ Glyph FontTrueType::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool
 				{
 					// The color channels remain white, just fill the alpha channel
 					std::size_t index = x + y * width;
-					mPixelBuffer[index * 4 + 3] = ((pixels[(x - padding) / 8]) & (1 << (7 - ((x - padding) % 8)))) ? 255 : 0;
+					pixelBuffer[index * 4 + 3] = ((pixels[(x - padding) / 8]) & (1 << (7 - ((x - padding) % 8)))) ? 255 : 0;
 				}
 				pixels += bitmap.pitch;
 			}
@@ -553,25 +783,103 @@ Glyph FontTrueType::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool
 				{
 					// The color channels remain white, just fill the alpha channel
 					std::size_t index = x + y * width;
-					mPixelBuffer[index * 4 + 3] = pixels[x - padding];
+					pixelBuffer[index * 4 + 3] = pixels[x - padding];
 				}
 				pixels += bitmap.pitch;
 			}
 		}
-
-		// Write the pixels to the texture
-		unsigned int x = glyph.textureRect.Left - padding;
-		unsigned int y = glyph.textureRect.Top - padding;
-		unsigned int w = glyph.textureRect.Right + 2 * padding;
-		unsigned int h = glyph.textureRect.Bottom + 2 * padding;
-		page.texture->update(&mPixelBuffer[0], w, h, x, y);
 	}
 
 	// Delete the FT glyph
 	FT_Done_Glyph(glyphDesc);
+}
 
-	// Done :)
-	return glyph;
+Rect FontTrueType::placeGlyph(Page& page, GlyphBitmap& bitmap) const {
+	const int padding = GLYPH_PADDING;
+
+	// Find a good position for the new glyph into the texture
+	Rect rect = findGlyphRect(page, bitmap.width, bitmap.height);
+
+	// Make sure the texture data is positioned in the center
+	// of the allocated texture rectangle
+	bitmap.glyph.textureRect.Left   = rect.Left + padding;
+	bitmap.glyph.textureRect.Top    = rect.Top + padding;
+	bitmap.glyph.textureRect.Right  = rect.Right - 2 * padding;
+	bitmap.glyph.textureRect.Bottom = rect.Bottom - 2 * padding;
+
+	return rect;
+}
+
+namespace {
+	struct GlyphPlacement {
+		Rect			rect;
+		std::size_t		index;
+
+		bool operator <(const GlyphPlacement& other) const {
+			return rect.Top < other.rect.Top || (rect.Top == other.rect.Top && rect.Left < other.rect.Left);
+		}
+	};
+}
+
+void FontTrueType::addGlyphBitmaps(Page& page, std::vector<GlyphBitmap>& bitmaps, bool bold, Float outlineThickness) {
+	// Place every glyph first: the texture only grows while placing them, and the glyphs placed in the same row are contiguous
+	std::vector<GlyphPlacement> placements;
+
+	for (std::size_t i = 0; i < bitmaps.size(); ++i) {
+		GlyphBitmap& bitmap = bitmaps[i];
+
+		if (bitmap.width > 0 && bitmap.height > 0 && !bitmap.pixels.empty()) {
+			GlyphPlacement placement;
+			placement.rect = placeGlyph(page, bitmap);
+			placement.index = i;
+			placements.push_back(placement);
+		}
+
+		storeGlyph(page, bitmap.codePoint, bold, outlineThickness, bitmap.glyph);
+	}
+
+	std::sort(placements.begin(), placements.end());
+
+	// Write the pixels to the texture, a texture update per row
+	std::vector<Uint8> rowPixels;
+
+	for (std::size_t first = 0; first < placements.size(); ) {
+		std::size_t last = first;
+		int left = placements[first].rect.Left;
+		int right = left;
+		int height = 0;
+
+		while (last < placements.size() && placements[last].rect.Top == placements[first].rect.Top) {
+			right = eemax(right, placements[last].rect.Left + placements[last].rect.Right);
+			height = eemax(height, placements[last].rect.Bottom);
+			last++;
+		}
+
+		int width = right - left;
+		rowPixels.resize(width * height * 4);
+
+		Uint8* current = &rowPixels[0];
+		Uint8* end = current + width * height * 4;
+
+		while (current != end) {
+			(*current++) = 255;
+			(*current++) = 255;
+			(*current++) = 255;
+			(*current++) = 0;
+		}
+
+		for (std::size_t i = first; i < last; ++i) {
+			const Rect& rect = placements[i].rect;
+			const GlyphBitmap& bitmap = bitmaps[placements[i].index];
+
+			for (unsigned int y = 0; y < bitmap.height; ++y)
+				memcpy(&rowPixels[((rect.Left - left) + y * width) * 4], &bitmap.pixels[y * bitmap.width * 4], bitmap.width * 4);
+		}
+
+		page.texture->update(&rowPixels[0], width, height, left, placements[first].rect.Top);
+
+		first = last;
+	}
 }
 
 Rect FontTrueType::findGlyphRect(Page& page, unsigned int width, unsigned int height) const {
@@ -636,39 +944,15 @@ Rect FontTrueType::findGlyphRect(Page& page, unsigned int width, unsigned int he
 }
 
 bool FontTrueType::setCurrentSize(unsigned int characterSize) const {
-	// FT_Set_Pixel_Sizes is an expensive function, so we must call it
-	// only when necessary to avoid killing performances
-
-	FT_Face face = static_cast<FT_Face>(mFace);
-	FT_UShort currentSize = face->size->metrics.x_ppem;
-
-	if (currentSize != characterSize) {
-		FT_Error result = FT_Set_Pixel_Sizes(face, 0, characterSize);
-
-		if (result == FT_Err_Invalid_Pixel_Size)
-		{
-			// In the case of bitmap fonts, resizing can
-			// fail if the requested size is not available
-			if (!FT_IS_SCALABLE(face))
-			{
-				eePRINTL( "Failed to set bitmap font size to %d", characterSize );
-				eePRINTL( "Available sizes are: " );
-				for (int i = 0; i < face->num_fixed_sizes; ++i)
-					eePRINT( "%d ", face->available_sizes[i].height );
-				eePRINTL("");
-			}
-		}
-
-		return result == FT_Err_Ok;
-	} else {
-		return true;
-	}
+	return setFaceSize(static_cast<FT_Face>(mFace), characterSize);
 }
 
 FontTrueType::Page::Page() :
 	texture(NULL),
 	nextRow(3)
-{	
+{
+	memset(latinLoaded, 0, sizeof(latinLoaded));
+
 	// Make sure that the texture is initialized by default
 	Image image;
 	image.create(128, 128, 4);
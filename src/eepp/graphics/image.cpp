@@ -1,4 +1,5 @@
 #include <eepp/graphics/image.hpp>
+#include <eepp/graphics/imagekernels.hpp>
 #include <eepp/system/filesystem.hpp>
 #include <eepp/system/log.hpp>
 #include <eepp/system/pack.hpp>
@@ -211,7 +212,7 @@ bool Image::getInfo( const std::string& path, int * width, int * height, int * c
 		if ( NULL != tPack ) {
 			SafeDataPointer PData;
 
-			tPack->extractFileToMemory( npath, PData );
+			tPack->getFileView( npath, PData );
 
 			res = 0 != stbi_info_from_memory( PData.Data, PData.DataSize, width, height, channels );
 		}
@@ -366,7 +367,7 @@ void Image::loadFromPack( Pack * Pack, const std::string& FilePackPath ) {
 	if ( NULL != Pack && Pack->isOpen() && -1 != Pack->exists( FilePackPath ) ) {
 		SafeDataPointer PData;
 
-		Pack->extractFileToMemory( FilePackPath, PData );
+		Pack->getFileView( FilePackPath, PData );
 
 		int w, h, c;
 		Uint8 * data = stbi_load_from_memory( PData.Data, PData.DataSize, &w, &h, &c, mChannels );
@@ -500,40 +501,10 @@ bool Image::saveToFile( const std::string& filepath, const EE_SAVE_TYPE& Format
 }
 
 void Image::replaceColor( const Color& ColorKey, const Color& NewColor ) {
-	unsigned int Pos = 0;
-
 	if ( NULL == mPixels )
 		return;
 
-	unsigned int size = mWidth * mHeight;
-
-	for ( unsigned int i = 0; i < size; i++ ) {
-		Pos = i * mChannels;
-
-		if ( 4 == mChannels ) {
-			if ( mPixels[ Pos ] == ColorKey.r && mPixels[ Pos + 1 ] == ColorKey.g && mPixels[ Pos + 2 ] == ColorKey.b && mPixels[ Pos + 3 ] == ColorKey.a ) {
-				mPixels[ Pos ] 		= NewColor.r;
-				mPixels[ Pos + 1 ]	= NewColor.g;
-				mPixels[ Pos + 2 ]	= NewColor.b;
-				mPixels[ Pos + 3 ]	= NewColor.a;
-			}
-		} else if ( 3 == mChannels ) {
-			if ( mPixels[ Pos ] == ColorKey.r && mPixels[ Pos + 1 ] == ColorKey.g && mPixels[ Pos + 2 ] == ColorKey.b ) {
-				mPixels[ Pos ] 		= NewColor.r;
-				mPixels[ Pos + 1 ]	= NewColor.g;
-				mPixels[ Pos + 2 ]	= NewColor.b;
-			}
-		} else if ( 2 == mChannels ) {
-			if ( mPixels[ Pos ] == ColorKey.r && mPixels[ Pos + 1 ] == ColorKey.g ) {
-				mPixels[ Pos ] 		= NewColor.r;
-				mPixels[ Pos + 1 ]	= NewColor.g;
-			}
-		} else if ( 1 == mChannels ) {
-			if ( mPixels[ Pos ] == ColorKey.r ) {
-				mPixels[ Pos ] 		= NewColor.r;
-			}
-		}
-	}
+	ImageKernels::replaceColor( mPixels, mWidth * mHeight, mChannels, ColorKey, NewColor );
 }
 
 void Image::createMaskFromColor( const Color& ColorKey, Uint8 Alpha ) {
@@ -548,21 +519,14 @@ void Image::fillWithColor( const Color& Color ) {
 	if ( NULL == mPixels )
 		return;
 
-	unsigned int z;
-	unsigned int size = mWidth * mHeight;
-
-	for ( unsigned int i = 0; i < size; i += mChannels ) {
-		for ( z = 0; z < mChannels; z++ ) {
-			if ( 0 == z )
-				mPixels[ i + z ] = Color.r;
-			else if ( 1 == z )
-				mPixels[ i + z ] = Color.g;
-			else if ( 2 == z )
-				mPixels[ i + z ] = Color.b;
-			else if ( 3 == z )
-				mPixels[ i + z ] = Color.a;
-		}
-	}
+	ImageKernels::fill( mPixels, mWidth * mHeight, mChannels, Color );
+}
+
+void Image::premultiplyAlpha() {
+	if ( NULL == mPixels || 4 != mChannels )
+		return;
+
+	ImageKernels::premultiply( mPixels, mWidth * mHeight );
 }
 
 void Image::copyImage( Graphics::Image * image, const Uint32& x, const Uint32& y ) {
@@ -571,10 +535,14 @@ void Image::copyImage( Graphics::Image * image, const Uint32& x, const Uint32& y
 		unsigned int dHeight 	= image->getHeight();
 
 		if ( mChannels != image->getChannels() ) {
+			unsigned int sChannels = image->getChannels();
+
+			// Convert per row
 			for ( unsigned int ty = 0; ty < dHeight; ty++ ) {
-				for ( unsigned int tx = 0; tx < dWidth; tx++ ) {
-					setPixel( x + tx, y + ty, image->getPixel( tx, ty ) );
-				}
+				Uint8 *			pDst	= &mPixels[ ( x + ( ( ty + y ) * mWidth ) ) * mChannels ];
+				const Uint8 *	pSrc	= &( ( image->getPixelsPtr() )[ ( ty * dWidth ) * sChannels ] );
+
+				ImageKernels::convert( pDst, mChannels, pSrc, sChannels, dWidth );
 			}
 		} else {
 			// Copy per row
@@ -651,20 +619,17 @@ Graphics::Image * Image::crop( Rect rect ) {
 
 void Image::flip() {
 	if ( NULL != mPixels ) {
-		Image tImg( mHeight, mWidth, mChannels );
+		Uint8 * rotated = eeNewArray( Uint8, mWidth * mHeight * mChannels );
+		unsigned int width = mWidth;
 
-		for ( unsigned int y = 0; y < mHeight; y++ )
-			for ( unsigned int x = 0; x < mWidth; x++ )
-				tImg.setPixel( y, x, getPixel( x, mHeight - 1 - y ) );
+		ImageKernels::rotate90( rotated, mPixels, mWidth, mHeight, mChannels );
 
 		clearCache();
 
-		mPixels = tImg.getPixels();
-		mWidth 	= tImg.getWidth();
-		mHeight = tImg.getHeight();
+		mPixels = rotated;
+		mWidth 	= mHeight;
+		mHeight = width;
 		mLoadedFromStbi = false;
-
-		tImg.avoidFreeImage( true );
 	}
 }
 
@@ -677,6 +642,18 @@ void Image::blit( Graphics::Image * image, const Uint32& x, const Uint32& y ) {
 		unsigned int dh = eemin( mHeight	, y	+ image->getHeight() );
 		unsigned int dw = eemin( mWidth	, x	+ image->getWidth() );
 
+		if ( 4 == mChannels && 4 == image->getChannels() ) {
+			// Blend per row
+			for ( unsigned int ty = y; ty < dh; ty++ ) {
+				Uint8 *			pDst	= &mPixels[ ( x + ty * mWidth ) * 4 ];
+				const Uint8 *	pSrc	= &( ( image->getPixelsPtr() )[ ( ty - y ) * image->getWidth() * 4 ] );
+
+				ImageKernels::blend( pDst, pSrc, dw - x );
+			}
+
+			return;
+		}
+
 		for ( unsigned int ty = y; ty < dh; ty++ ) {
 			for ( unsigned int tx = x; tx < dw; tx++ ) {
 				Color ts( image->getPixel( tx - x, ty - y ) );
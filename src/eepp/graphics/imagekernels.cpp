@@ -0,0 +1,655 @@
+#include <eepp/graphics/imagekernels.hpp>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+	#define EE_IMAGE_KERNELS_SSE2
+	#include <emmintrin.h>
+
+	#if defined( __SSSE3__ )
+		#define EE_IMAGE_KERNELS_SSSE3
+		#include <tmmintrin.h>
+	#endif
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+	#define EE_IMAGE_KERNELS_NEON
+	#include <arm_neon.h>
+#endif
+
+namespace EE { namespace Graphics {
+
+namespace {
+
+/** Side of the square blocks of pixels rotated at once, so the source and destination rows of a block stay in the cache */
+static const Uint32 ROTATE_BLOCK_SIZE = 64;
+
+inline Uint8 blendComponentToU8( const Float& color ) {
+	// The same conversion used by Color::blend
+	return (Uint8)( color == 1.f ? 255 : ( color * 255.99f ) );
+}
+
+inline void blendPixel( Uint8 * dst, const Uint8 * src ) {
+	if ( 0 == src[3] )
+		return;
+
+	if ( 255 == src[3] ) {
+		dst[0] = src[0];
+		dst[1] = src[1];
+		dst[2] = src[2];
+		dst[3] = 255;
+		return;
+	}
+
+	Float sa	= (Float)src[3] / 255.f;
+	Float da	= (Float)dst[3] / 255.f;
+	Float isa	= 1.f - sa;
+	Float alpha	= sa + da * isa;
+
+	for ( Uint32 c = 0; c < 3; c++ )
+		dst[c] = blendComponentToU8( ( (Float)src[c] / 255.f * sa + (Float)dst[c] / 255.f * da * isa ) / alpha );
+
+	dst[3] = blendComponentToU8( alpha );
+}
+
+inline Uint8 premultiplyComponent( const Uint32& color, const Uint32& alpha ) {
+	// Exact rounding of color * alpha / 255
+	Uint32 t = color * alpha + 128;
+
+	return (Uint8)( ( t + ( t >> 8 ) ) >> 8 );
+}
+
+void convertGeneric( Uint8 * dst, const Uint32& dstChannels, const Uint8 * src, const Uint32& srcChannels, const Uint32& count ) {
+	for ( Uint32 i = 0; i < count; i++, dst += dstChannels, src += srcChannels ) {
+		for ( Uint32 c = 0; c < dstChannels; c++ )
+			dst[c] = c < srcChannels ? src[c] : 255;
+	}
+}
+
+void convertRGBToRGBA( Uint8 * dst, const Uint8 * src, Uint32 count ) {
+#if defined( EE_IMAGE_KERNELS_SSSE3 )
+	const __m128i mask	= _mm_setr_epi8( 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1 );
+	const __m128i alpha	= _mm_set1_epi32( (int)0xFF000000 );
+
+	for ( ; count >= 16; count -= 16, src += 48, dst += 64 ) {
+		__m128i a = _mm_loadu_si128( (const __m128i*)( src ) );
+		__m128i b = _mm_loadu_si128( (const __m128i*)( src + 16 ) );
+		__m128i c = _mm_loadu_si128( (const __m128i*)( src + 32 ) );
+
+		_mm_storeu_si128( (__m128i*)( dst )		, _mm_or_si128( _mm_shuffle_epi8( a, mask ), alpha ) );
+		_mm_storeu_si128( (__m128i*)( dst + 16 )	, _mm_or_si128( _mm_shuffle_epi8( _mm_alignr_epi8( b, a, 12 ), mask ), alpha ) );
+		_mm_storeu_si128( (__m128i*)( dst + 32 )	, _mm_or_si128( _mm_shuffle_epi8( _mm_alignr_epi8( c, b, 8 ), mask ), alpha ) );
+		_mm_storeu_si128( (__m128i*)( dst + 48 )	, _mm_or_si128( _mm_shuffle_epi8( _mm_srli_si128( c, 4 ), mask ), alpha ) );
+	}
+#elif defined( EE_IMAGE_KERNELS_NEON )
+	for ( ; count >= 16; count -= 16, src += 48, dst += 64 ) {
+		uint8x16x3_t rgb = vld3q_u8( src );
+		uint8x16x4_t rgba;
+
+		rgba.val[0] = rgb.val[0];
+		rgba.val[1] = rgb.val[1];
+		rgba.val[2] = rgb.val[2];
+		rgba.val[3] = vdupq_n_u8( 255 );
+
+		vst4q_u8( dst, rgba );
+	}
+#endif
+
+	for ( ; count > 0; count--, src += 3, dst += 4 ) {
+		dst[0] = src[0];
+		dst[1] = src[1];
+		dst[2] = src[2];
+		dst[3] = 255;
+	}
+}
+
+void convertRGBAToRGB( Uint8 * dst, const Uint8 * src, Uint32 count ) {
+#if defined( EE_IMAGE_KERNELS_SSSE3 )
+	const __m128i mask = _mm_setr_epi8( 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1 );
+
+	for ( ; count >= 16; count -= 16, src += 64, dst += 48 ) {
+		__m128i a = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i*)( src ) ), mask );
+		__m128i b = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i*)( src + 16 ) ), mask );
+		__m128i c = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i*)( src + 32 ) ), mask );
+		__m128i d = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i*)( src + 48 ) ), mask );
+
+		_mm_storeu_si128( (__m128i*)( dst )		, _mm_or_si128( a, _mm_slli_si128( b, 12 ) ) );
+		_mm_storeu_si128( (__m128i*)( dst + 16 )	, _mm_or_si128( _mm_srli_si128( b, 4 ), _mm_slli_si128( c, 8 ) ) );
+		_mm_storeu_si128( (__m128i*)( dst + 32 )	, _mm_or_si128( _mm_srli_si128( c, 8 ), _mm_slli_si128( d, 4 ) ) );
+	}
+#elif defined( EE_IMAGE_KERNELS_NEON )
+	for ( ; count >= 16; count -= 16, src += 64, dst += 48 ) {
+		uint8x16x4_t rgba = vld4q_u8( src );
+		uint8x16x3_t rgb;
+
+		rgb.val[0] = rgba.val[0];
+		rgb.val[1] = rgba.val[1];
+		rgb.val[2] = rgba.val[2];
+
+		vst3q_u8( dst, rgb );
+	}
+#endif
+
+	for ( ; count > 0; count--, src += 4, dst += 3 ) {
+		dst[0] = src[0];
+		dst[1] = src[1];
+		dst[2] = src[2];
+	}
+}
+
+template <Uint32 Channels>
+void rotateRegion( Uint8 * dst, const Uint8 * src, const Uint32& width, const Uint32& height, const Uint32& x0, const Uint32& x1, const Uint32& y0, const Uint32& y1 ) {
+	// The source pixel ( x, y ) goes to the destination pixel ( height - 1 - y, x ), in an image height pixels wide
+	for ( Uint32 by = y0; by < y1; by += ROTATE_BLOCK_SIZE ) {
+		Uint32 ey = eemin( by + ROTATE_BLOCK_SIZE, y1 );
+
+		for ( Uint32 bx = x0; bx < x1; bx += ROTATE_BLOCK_SIZE ) {
+			Uint32 ex = eemin( bx + ROTATE_BLOCK_SIZE, x1 );
+
+			for ( Uint32 y = by; y < ey; y++ ) {
+				const Uint8 *	s = src + ( y * width + bx ) * Channels;
+				Uint8 *			d = dst + ( bx * height + height - 1 - y ) * Channels;
+
+				for ( Uint32 x = bx; x < ex; x++, s += Channels, d += height * Channels ) {
+					for ( Uint32 c = 0; c < Channels; c++ )
+						d[c] = s[c];
+				}
+			}
+		}
+	}
+}
+
+void rotateRegion( Uint8 * dst, const Uint8 * src, const Uint32& width, const Uint32& height, const Uint32& channels, const Uint32& x0, const Uint32& x1, const Uint32& y0, const Uint32& y1 ) {
+	switch ( channels ) {
+		case 1: rotateRegion<1>( dst, src, width, height, x0, x1, y0, y1 ); break;
+		case 2: rotateRegion<2>( dst, src, width, height, x0, x1, y0, y1 ); break;
+		case 3: rotateRegion<3>( dst, src, width, height, x0, x1, y0, y1 ); break;
+		case 4: rotateRegion<4>( dst, src, width, height, x0, x1, y0, y1 ); break;
+	}
+}
+
+}
+
+const char * ImageKernels::getInstructionSet() {
+#if defined( EE_IMAGE_KERNELS_SSSE3 )
+	return "SSSE3";
+#elif defined( EE_IMAGE_KERNELS_SSE2 )
+	return "SSE2";
+#elif defined( EE_IMAGE_KERNELS_NEON )
+	return "NEON";
+#else
+	return "Scalar";
+#endif
+}
+
+void ImageKernels::fill( Uint8 * dst, const Uint32& count, const Uint32& channels, const Color& color ) {
+	if ( NULL == dst || 0 == channels || channels > 4 )
+		return;
+
+	if ( 1 == channels ) {
+		memset( dst, color.r, count );
+		return;
+	}
+
+	// 48 bytes contain a whole number of pixels of every channel count and a whole number of 16 bytes vectors
+	const Uint8 components[4] = { color.r, color.g, color.b, color.a };
+	Uint8 pattern[48];
+	Uint32 size = count * channels;
+
+	for ( Uint32 i = 0; i < 48; i++ )
+		pattern[i] = components[ i % channels ];
+
+#if defined( EE_IMAGE_KERNELS_SSE2 )
+	__m128i p0 = _mm_loadu_si128( (const __m128i*)( pattern ) );
+	__m128i p1 = _mm_loadu_si128( (const __m128i*)( pattern + 16 ) );
+	__m128i p2 = _mm_loadu_si128( (const __m128i*)( pattern + 32 ) );
+
+	for ( ; size >= 48; size -= 48, dst += 48 ) {
+		_mm_storeu_si128( (__m128i*)( dst )		, p0 );
+		_mm_storeu_si128( (__m128i*)( dst + 16 )	, p1 );
+		_mm_storeu_si128( (__m128i*)( dst + 32 )	, p2 );
+	}
+#elif defined( EE_IMAGE_KERNELS_NEON )
+	uint8x16x3_t p;
+
+	p.val[0] = vld1q_u8( pattern );
+	p.val[1] = vld1q_u8( pattern + 16 );
+	p.val[2] = vld1q_u8( pattern + 32 );
+
+	for ( ; size >= 48; size -= 48, dst += 48 ) {
+		vst1q_u8( dst, p.val[0] );
+		vst1q_u8( dst + 16, p.val[1] );
+		vst1q_u8( dst + 32, p.val[2] );
+	}
+#else
+	for ( ; size >= 48; size -= 48, dst += 48 )
+		memcpy( dst, pattern, 48 );
+#endif
+
+	// The remaining bytes always start at a pixel boundary, as the pattern does
+	memcpy( dst, pattern, size );
+}
+
+void ImageKernels::replaceColor( Uint8 * dst, const Uint32& count, const Uint32& channels, const Color& colorKey, const Color& newColor ) {
+	if ( NULL == dst || 0 == channels || channels > 4 )
+		return;
+
+	const Uint8 key[4]		= { colorKey.r, colorKey.g, colorKey.b, colorKey.a };
+	const Uint8 color[4]	= { newColor.r, newColor.g, newColor.b, newColor.a };
+	Uint32 i = 0;
+
+#if defined( EE_IMAGE_KERNELS_SSE2 )
+	if ( 3 != channels ) {
+		// Every lane of the vectors holds a whole pixel, so the compare is done over lanes of the pixel size
+		Uint32 pixelsPerVector = 16 / channels;
+		__m128i vkey, vcolor;
+
+		if ( 4 == channels ) {
+			Uint32 k, c;
+			memcpy( &k, key, 4 );
+			memcpy( &c, color, 4 );
+			vkey	= _mm_set1_epi32( (int)k );
+			vcolor	= _mm_set1_epi32( (int)c );
+		} else if ( 2 == channels ) {
+			Uint16 k, c;
+			memcpy( &k, key, 2 );
+			memcpy( &c, color, 2 );
+			vkey	= _mm_set1_epi16( (short)k );
+			vcolor	= _mm_set1_epi16( (short)c );
+		} else {
+			vkey	= _mm_set1_epi8( (char)key[0] );
+			vcolor	= _mm_set1_epi8( (char)color[0] );
+		}
+
+		for ( ; i + pixelsPerVector <= count; i += pixelsPerVector ) {
+			Uint8 * p = dst + i * channels;
+			__m128i pixels = _mm_loadu_si128( (const __m128i*)p );
+			__m128i match;
+
+			if ( 4 == channels )
+				match = _mm_cmpeq_epi32( pixels, vkey );
+			else if ( 2 == channels )
+				match = _mm_cmpeq_epi16( pixels, vkey );
+			else
+				match = _mm_cmpeq_epi8( pixels, vkey );
+
+			// Most of the vectors don't contain the key, and those are not written back
+			if ( 0 != _mm_movemask_epi8( match ) )
+				_mm_storeu_si128( (__m128i*)p, _mm_or_si128( _mm_and_si128( match, vcolor ), _mm_andnot_si128( match, pixels ) ) );
+		}
+	}
+#elif defined( EE_IMAGE_KERNELS_NEON )
+	if ( 4 == channels ) {
+		for ( ; i + 16 <= count; i += 16 ) {
+			Uint8 * p = dst + i * 4;
+			uint8x16x4_t pixels = vld4q_u8( p );
+			uint8x16_t match = vandq_u8( vandq_u8( vceqq_u8( pixels.val[0], vdupq_n_u8( key[0] ) ), vceqq_u8( pixels.val[1], vdupq_n_u8( key[1] ) ) ),
+										 vandq_u8( vceqq_u8( pixels.val[2], vdupq_n_u8( key[2] ) ), vceqq_u8( pixels.val[3], vdupq_n_u8( key[3] ) ) ) );
+
+			for ( Uint32 c = 0; c < 4; c++ )
+				pixels.val[c] = vbslq_u8( match, vdupq_n_u8( color[c] ), pixels.val[c] );
+
+			vst4q_u8( p, pixels );
+		}
+	} else if ( 3 == channels ) {
+		for ( ; i + 16 <= count; i += 16 ) {
+			Uint8 * p = dst + i * 3;
+			uint8x16x3_t pixels = vld3q_u8( p );
+			uint8x16_t match = vandq_u8( vandq_u8( vceqq_u8( pixels.val[0], vdupq_n_u8( key[0] ) ), vceqq_u8( pixels.val[1], vdupq_n_u8( key[1] ) ) ),
+										 vceqq_u8( pixels.val[2], vdupq_n_u8( key[2] ) ) );
+
+			for ( Uint32 c = 0; c < 3; c++ )
+				pixels.val[c] = vbslq_u8( match, vdupq_n_u8( color[c] ), pixels.val[c] );
+
+			vst3q_u8( p, pixels );
+		}
+	} else if ( 2 == channels ) {
+		for ( ; i + 16 <= count; i += 16 ) {
+			Uint8 * p = dst + i * 2;
+			uint8x16x2_t pixels = vld2q_u8( p );
+			uint8x16_t match = vandq_u8( vceqq_u8( pixels.val[0], vdupq_n_u8( key[0] ) ), vceqq_u8( pixels.val[1], vdupq_n_u8( key[1] ) ) );
+
+			for ( Uint32 c = 0; c < 2; c++ )
+				pixels.val[c] = vbslq_u8( match, vdupq_n_u8( color[c] ), pixels.val[c] );
+
+			vst2q_u8( p, pixels );
+		}
+	} else {
+		for ( ; i + 16 <= count; i += 16 ) {
+			Uint8 * p = dst + i;
+			uint8x16_t pixels = vld1q_u8( p );
+
+			vst1q_u8( p, vbslq_u8( vceqq_u8( pixels, vdupq_n_u8( key[0] ) ), vdupq_n_u8( color[0] ), pixels ) );
+		}
+	}
+#endif
+
+	Uint8 * p = dst + i * channels;
+
+	switch ( channels ) {
+		case 4:
+			for ( ; i < count; i++, p += 4 ) {
+				if ( p[0] == key[0] && p[1] == key[1] && p[2] == key[2] && p[3] == key[3] ) {
+					p[0] = color[0]; p[1] = color[1]; p[2] = color[2]; p[3] = color[3];
+				}
+			}
+			break;
+		case 3:
+			for ( ; i < count; i++, p += 3 ) {
+				if ( p[0] == key[0] && p[1] == key[1] && p[2] == key[2] ) {
+					p[0] = color[0]; p[1] = color[1]; p[2] = color[2];
+				}
+			}
+			break;
+		case 2:
+			for ( ; i < count; i++, p += 2 ) {
+				if ( p[0] == key[0] && p[1] == key[1] ) {
+					p[0] = color[0]; p[1] = color[1];
+				}
+			}
+			break;
+		case 1:
+			for ( ; i < count; i++, p++ ) {
+				if ( p[0] == key[0] )
+					p[0] = color[0];
+			}
+			break;
+	}
+}
+
+void ImageKernels::blend( Uint8 * dst, const Uint8 * src, const Uint32& count ) {
+	if ( NULL == dst || NULL == src )
+		return;
+
+	Uint32 i = 0;
+
+#if defined( EE_IMAGE_KERNELS_SSE2 )
+	const __m128i zero		= _mm_setzero_si128();
+	const __m128i alphaMask	= _mm_set1_epi32( (int)0xFF000000 );
+	const __m128i rgbMask	= _mm_setr_epi32( -1, -1, -1, 0 );
+	const __m128 one		= _mm_set1_ps( 1.f );
+	const __m128 toFloat	= _mm_set1_ps( 255.f );
+	const __m128 toU8		= _mm_set1_ps( 255.99f );
+
+	for ( ; i + 4 <= count; i += 4 ) {
+		__m128i s = _mm_loadu_si128( (const __m128i*)( src + i * 4 ) );
+		__m128i sAlpha = _mm_and_si128( s, alphaMask );
+
+		// Whole vectors of opaque or transparent pixels don't need any math
+		if ( 0xFFFF == _mm_movemask_epi8( _mm_cmpeq_epi32( sAlpha, alphaMask ) ) ) {
+			_mm_storeu_si128( (__m128i*)( dst + i * 4 ), s );
+			continue;
+		}
+
+		__m128i transparent = _mm_cmpeq_epi32( sAlpha, zero );
+
+		if ( 0xFFFF == _mm_movemask_epi8( transparent ) )
+			continue;
+
+		__m128i d = _mm_loadu_si128( (const __m128i*)( dst + i * 4 ) );
+		__m128i sLo = _mm_unpacklo_epi8( s, zero );
+		__m128i sHi = _mm_unpackhi_epi8( s, zero );
+		__m128i dLo = _mm_unpacklo_epi8( d, zero );
+		__m128i dHi = _mm_unpackhi_epi8( d, zero );
+		__m128i res[4];
+
+		// One pixel per vector ( r, g, b, a ), following the same operations than Color::blend
+		for ( Uint32 p = 0; p < 4; p++ ) {
+			__m128i s32 = p < 2 ? ( 0 == p ? _mm_unpacklo_epi16( sLo, zero ) : _mm_unpackhi_epi16( sLo, zero ) ) : ( 2 == p ? _mm_unpacklo_epi16( sHi, zero ) : _mm_unpackhi_epi16( sHi, zero ) );
+			__m128i d32 = p < 2 ? ( 0 == p ? _mm_unpacklo_epi16( dLo, zero ) : _mm_unpackhi_epi16( dLo, zero ) ) : ( 2 == p ? _mm_unpacklo_epi16( dHi, zero ) : _mm_unpackhi_epi16( dHi, zero ) );
+			__m128 sf = _mm_div_ps( _mm_cvtepi32_ps( s32 ), toFloat );
+			__m128 df = _mm_div_ps( _mm_cvtepi32_ps( d32 ), toFloat );
+			__m128 sa = _mm_shuffle_ps( sf, sf, _MM_SHUFFLE( 3, 3, 3, 3 ) );
+			__m128 da = _mm_shuffle_ps( df, df, _MM_SHUFFLE( 3, 3, 3, 3 ) );
+			__m128 isa = _mm_sub_ps( one, sa );
+			__m128 alpha = _mm_add_ps( sa, _mm_mul_ps( da, isa ) );
+			__m128 color = _mm_div_ps( _mm_add_ps( _mm_mul_ps( sf, sa ), _mm_mul_ps( _mm_mul_ps( df, da ), isa ) ), alpha );
+			__m128 rgba = _mm_or_ps( _mm_and_ps( _mm_castsi128_ps( rgbMask ), color ), _mm_andnot_ps( _mm_castsi128_ps( rgbMask ), alpha ) );
+
+			res[p] = _mm_cvttps_epi32( _mm_mul_ps( rgba, toU8 ) );
+		}
+
+		__m128i blended = _mm_packus_epi16( _mm_packs_epi32( res[0], res[1] ), _mm_packs_epi32( res[2], res[3] ) );
+
+		// The transparent source pixels keep the destination
+		_mm_storeu_si128( (__m128i*)( dst + i * 4 ), _mm_or_si128( _mm_and_si128( transparent, d ), _mm_andnot_si128( transparent, blended ) ) );
+	}
+#elif defined( EE_IMAGE_KERNELS_NEON ) && defined( __aarch64__ )
+	// The division is only available on AArch64
+	const float32x4_t one	= vdupq_n_f32( 1.f );
+	const float32x4_t toFloat	= vdupq_n_f32( 255.f );
+	const float32x4_t toU8	= vdupq_n_f32( 255.99f );
+
+	for ( ; i + 8 <= count; i += 8 ) {
+		uint8x8x4_t s = vld4_u8( src + i * 4 );
+
+		if ( 255 == vminv_u8( s.val[3] ) ) {
+			vst4_u8( dst + i * 4, s );
+			continue;
+		}
+
+		if ( 0 == vmaxv_u8( s.val[3] ) )
+			continue;
+
+		uint8x8x4_t d = vld4_u8( dst + i * 4 );
+		uint16x8_t s16[4], d16[4];
+		uint16x4_t out[2][4];
+
+		for ( Uint32 c = 0; c < 4; c++ ) {
+			s16[c] = vmovl_u8( s.val[c] );
+			d16[c] = vmovl_u8( d.val[c] );
+		}
+
+		for ( Uint32 h = 0; h < 2; h++ ) {
+			float32x4_t sf[4], df[4];
+
+			for ( Uint32 c = 0; c < 4; c++ ) {
+				sf[c] = vdivq_f32( vcvtq_f32_u32( vmovl_u16( h ? vget_high_u16( s16[c] ) : vget_low_u16( s16[c] ) ) ), toFloat );
+				df[c] = vdivq_f32( vcvtq_f32_u32( vmovl_u16( h ? vget_high_u16( d16[c] ) : vget_low_u16( d16[c] ) ) ), toFloat );
+			}
+
+			float32x4_t isa = vsubq_f32( one, sf[3] );
+			float32x4_t alpha = vaddq_f32( sf[3], vmulq_f32( df[3], isa ) );
+
+			for ( Uint32 c = 0; c < 3; c++ ) {
+				float32x4_t color = vdivq_f32( vaddq_f32( vmulq_f32( sf[c], sf[3] ), vmulq_f32( vmulq_f32( df[c], df[3] ), isa ) ), alpha );
+
+				out[h][c] = vmovn_u32( vcvtq_u32_f32( vmulq_f32( color, toU8 ) ) );
+			}
+
+			out[h][3] = vmovn_u32( vcvtq_u32_f32( vmulq_f32( alpha, toU8 ) ) );
+		}
+
+		uint8x8_t transparent = vceq_u8( s.val[3], vdup_n_u8( 0 ) );
+		uint8x8x4_t blended;
+
+		for ( Uint32 c = 0; c < 4; c++ )
+			blended.val[c] = vbsl_u8( transparent, d.val[c], vqmovn_u16( vcombine_u16( out[0][c], out[1][c] ) ) );
+
+		vst4_u8( dst + i * 4, blended );
+	}
+#endif
+
+	for ( ; i < count; i++ )
+		blendPixel( dst + i * 4, src + i * 4 );
+}
+
+void ImageKernels::premultiply( Uint8 * dst, const Uint32& count ) {
+	if ( NULL == dst )
+		return;
+
+	Uint32 i = 0;
+
+#if defined( EE_IMAGE_KERNELS_SSE2 )
+	const __m128i zero		= _mm_setzero_si128();
+	const __m128i alphaLane	= _mm_setr_epi16( 0, 0, 0, 255, 0, 0, 0, 255 );
+	const __m128i half		= _mm_set1_epi16( 128 );
+
+	for ( ; i + 4 <= count; i += 4 ) {
+		__m128i pixels = _mm_loadu_si128( (const __m128i*)( dst + i * 4 ) );
+		__m128i res[2];
+
+		for ( Uint32 h = 0; h < 2; h++ ) {
+			__m128i p = h ? _mm_unpackhi_epi8( pixels, zero ) : _mm_unpacklo_epi8( pixels, zero );
+
+			// Broadcast the alpha of each pixel, and multiply the alpha itself by 255 so it's kept
+			__m128i a = _mm_or_si128( _mm_shufflehi_epi16( _mm_shufflelo_epi16( p, _MM_SHUFFLE( 3, 3, 3, 3 ) ), _MM_SHUFFLE( 3, 3, 3, 3 ) ), alphaLane );
+			__m128i t = _mm_add_epi16( _mm_mullo_epi16( p, a ), half );
+
+			res[h] = _mm_srli_epi16( _mm_add_epi16( t, _mm_srli_epi16( t, 8 ) ), 8 );
+		}
+
+		_mm_storeu_si128( (__m128i*)( dst + i * 4 ), _mm_packus_epi16( res[0], res[1] ) );
+	}
+#elif defined( EE_IMAGE_KERNELS_NEON )
+	const uint16x8_t half = vdupq_n_u16( 128 );
+
+	for ( ; i + 8 <= count; i += 8 ) {
+		uint8x8x4_t pixels = vld4_u8( dst + i * 4 );
+
+		for ( Uint32 c = 0; c < 3; c++ ) {
+			uint16x8_t t = vaddq_u16( vmull_u8( pixels.val[c], pixels.val[3] ), half );
+
+			pixels.val[c] = vshrn_n_u16( vaddq_u16( t, vshrq_n_u16( t, 8 ) ), 8 );
+		}
+
+		vst4_u8( dst + i * 4, pixels );
+	}
+#endif
+
+	for ( Uint8 * p = dst + i * 4; i < count; i++, p += 4 ) {
+		p[0] = premultiplyComponent( p[0], p[3] );
+		p[1] = premultiplyComponent( p[1], p[3] );
+		p[2] = premultiplyComponent( p[2], p[3] );
+	}
+}
+
+void ImageKernels::convert( Uint8 * dst, const Uint32& dstChannels, const Uint8 * src, const Uint32& srcChannels, const Uint32& count ) {
+	if ( NULL == dst || NULL == src )
+		return;
+
+	if ( dstChannels == srcChannels ) {
+		memcpy( dst, src, count * dstChannels );
+	} else if ( 4 == dstChannels && 3 == srcChannels ) {
+		convertRGBToRGBA( dst, src, count );
+	} else if ( 3 == dstChannels && 4 == srcChannels ) {
+		convertRGBAToRGB( dst, src, count );
+	} else {
+		convertGeneric( dst, dstChannels, src, srcChannels, count );
+	}
+}
+
+void ImageKernels::extractAlpha( Uint8 * dst, const Uint8 * src, const Uint32& count ) {
+	if ( NULL == dst || NULL == src )
+		return;
+
+	Uint32 i = 0;
+
+#if defined( EE_IMAGE_KERNELS_SSE2 )
+	for ( ; i + 16 <= count; i += 16 ) {
+		const __m128i * s = (const __m128i*)( src + i * 4 );
+		__m128i a0 = _mm_srli_epi32( _mm_loadu_si128( s ), 24 );
+		__m128i a1 = _mm_srli_epi32( _mm_loadu_si128( s + 1 ), 24 );
+		__m128i a2 = _mm_srli_epi32( _mm_loadu_si128( s + 2 ), 24 );
+		__m128i a3 = _mm_srli_epi32( _mm_loadu_si128( s + 3 ), 24 );
+
+		_mm_storeu_si128( (__m128i*)( dst + i ), _mm_packus_epi16( _mm_packs_epi32( a0, a1 ), _mm_packs_epi32( a2, a3 ) ) );
+	}
+#elif defined( EE_IMAGE_KERNELS_NEON )
+	for ( ; i + 16 <= count; i += 16 )
+		vst1q_u8( dst + i, vld4q_u8( src + i * 4 ).val[3] );
+#endif
+
+	for ( ; i < count; i++ )
+		dst[i] = src[ i * 4 + 3 ];
+}
+
+void ImageKernels::expandAlpha( Uint8 * dst, const Uint8 * src, const Uint32& count, const RGB& color ) {
+	if ( NULL == dst || NULL == src )
+		return;
+
+	Uint32 i = 0;
+
+#if defined( EE_IMAGE_KERNELS_SSE2 )
+	const __m128i zero	= _mm_setzero_si128();
+	const __m128i rgb	= _mm_set1_epi32( (int)( (Uint32)color.r | ( (Uint32)color.g << 8 ) | ( (Uint32)color.b << 16 ) ) );
+
+	for ( ; i + 16 <= count; i += 16 ) {
+		__m128i a = _mm_loadu_si128( (const __m128i*)( src + i ) );
+		__m128i lo = _mm_unpacklo_epi8( a, zero );
+		__m128i hi = _mm_unpackhi_epi8( a, zero );
+		__m128i * d = (__m128i*)( dst + i * 4 );
+
+		_mm_storeu_si128( d		, _mm_or_si128( _mm_slli_epi32( _mm_unpacklo_epi16( lo, zero ), 24 ), rgb ) );
+		_mm_storeu_si128( d + 1	, _mm_or_si128( _mm_slli_epi32( _mm_unpackhi_epi16( lo, zero ), 24 ), rgb ) );
+		_mm_storeu_si128( d + 2	, _mm_or_si128( _mm_slli_epi32( _mm_unpacklo_epi16( hi, zero ), 24 ), rgb ) );
+		_mm_storeu_si128( d + 3	, _mm_or_si128( _mm_slli_epi32( _mm_unpackhi_epi16( hi, zero ), 24 ), rgb ) );
+	}
+#elif defined( EE_IMAGE_KERNELS_NEON )
+	uint8x16x4_t rgba;
+
+	rgba.val[0] = vdupq_n_u8( color.r );
+	rgba.val[1] = vdupq_n_u8( color.g );
+	rgba.val[2] = vdupq_n_u8( color.b );
+
+	for ( ; i + 16 <= count; i += 16 ) {
+		rgba.val[3] = vld1q_u8( src + i );
+
+		vst4q_u8( dst + i * 4, rgba );
+	}
+#endif
+
+	for ( Uint8 * p = dst + i * 4; i < count; i++, p += 4 ) {
+		p[0] = color.r;
+		p[1] = color.g;
+		p[2] = color.b;
+		p[3] = src[i];
+	}
+}
+
+void ImageKernels::rotate90( Uint8 * dst, const Uint8 * src, const Uint32& width, const Uint32& height, const Uint32& channels ) {
+	if ( NULL == dst || NULL == src || 0 == channels || channels > 4 )
+		return;
+
+	Uint32 x1 = 0;
+	Uint32 y1 = 0;
+
+#if defined( EE_IMAGE_KERNELS_SSE2 )
+	if ( 4 == channels ) {
+		// Blocks of 4x4 pixels are transposed in registers, the rows and columns left are rotated below
+		x1 = width & ~3u;
+		y1 = height & ~3u;
+
+		for ( Uint32 by = 0; by < y1; by += ROTATE_BLOCK_SIZE ) {
+			Uint32 ey = eemin( by + ROTATE_BLOCK_SIZE, y1 );
+
+			for ( Uint32 bx = 0; bx < x1; bx += ROTATE_BLOCK_SIZE ) {
+				Uint32 ex = eemin( bx + ROTATE_BLOCK_SIZE, x1 );
+
+				for ( Uint32 y = by; y < ey; y += 4 ) {
+					for ( Uint32 x = bx; x < ex; x += 4 ) {
+						const Uint8 * s = src + ( y * width + x ) * 4;
+						__m128i r0 = _mm_loadu_si128( (const __m128i*)( s ) );
+						__m128i r1 = _mm_loadu_si128( (const __m128i*)( s + width * 4 ) );
+						__m128i r2 = _mm_loadu_si128( (const __m128i*)( s + width * 8 ) );
+						__m128i r3 = _mm_loadu_si128( (const __m128i*)( s + width * 12 ) );
+						__m128i t0 = _mm_unpacklo_epi32( r0, r1 );
+						__m128i t1 = _mm_unpacklo_epi32( r2, r3 );
+						__m128i t2 = _mm_unpackhi_epi32( r0, r1 );
+						__m128i t3 = _mm_unpackhi_epi32( r2, r3 );
+
+						// Every source column becomes a destination row, with the source rows in reverse order
+						Uint8 * d = dst + ( x * height + height - 4 - y ) * 4;
+
+						_mm_storeu_si128( (__m128i*)( d )						, _mm_shuffle_epi32( _mm_unpacklo_epi64( t0, t1 ), _MM_SHUFFLE( 0, 1, 2, 3 ) ) );
+						_mm_storeu_si128( (__m128i*)( d + height * 4 )		, _mm_shuffle_epi32( _mm_unpackhi_epi64( t0, t1 ), _MM_SHUFFLE( 0, 1, 2, 3 ) ) );
+						_mm_storeu_si128( (__m128i*)( d + height * 8 )		, _mm_shuffle_epi32( _mm_unpacklo_epi64( t2, t3 ), _MM_SHUFFLE( 0, 1, 2, 3 ) ) );
+						_mm_storeu_si128( (__m128i*)( d + height * 12 )		, _mm_shuffle_epi32( _mm_unpackhi_epi64( t2, t3 ), _MM_SHUFFLE( 0, 1, 2, 3 ) ) );
+					}
+				}
+			}
+		}
+	}
+#endif
+
+	rotateRegion( dst, src, width, height, channels, x1, width, 0, height );
+	rotateRegion( dst, src, width, height, channels, 0, x1, y1, height );
+}
+
+}}
@@ -5,13 +5,17 @@
 #include <eepp/graphics/batchrenderer.hpp>
 #include <eepp/graphics/globalbatchrenderer.hpp>
 #include <eepp/window/engine.hpp>
+#include <eepp/system/jobsystem.hpp>
 
 using namespace EE::Window;
 
 namespace EE { namespace Graphics {
 
+void ParticleSystem::UpdateJob::run() {
+	Dead = System->integrate( Start, End, Time );
+}
+
 ParticleSystem::ParticleSystem() :
-	mParticle( NULL ),
 	mPCount( 0 ),
 	mTexId( 0 ),
 	mPLeft( 0 ),
@@ -31,12 +35,12 @@ ParticleSystem::ParticleSystem() :
 	mTime( 0.01f ),
 	mLoop( false ),
 	mUsed( false ),
-	mPointsSup( false )
+	mPointsSup( false ),
+	mParallelUpdate( false )
 {
 }
 
 ParticleSystem::~ParticleSystem() {
-	eeSAFE_DELETE_ARRAY( mParticle );
 }
 
 void ParticleSystem::create( const EE_PARTICLE_EFFECT& Effect, const Uint32& NumParticles, const Uint32& TexId, const Vector2f& Pos, const Float& PartSize, const bool& AnimLoop, const Uint32& NumLoops, const ColorAf& Color, const Vector2f& Pos2, const Float& AlphaDecay, const Vector2f& Speed, const Vector2f& Acc ) {
@@ -74,19 +78,69 @@ void ParticleSystem::create( const EE_PARTICLE_EFFECT& Effect, const Uint32& Num
 void ParticleSystem::begin() {
 	mPLeft = mPCount;
 
-	eeSAFE_DELETE_ARRAY( mParticle );
+	mX.resize( mPCount );
+	mY.resize( mPCount );
+	mXSpeed.resize( mPCount );
+	mYSpeed.resize( mPCount );
+	mXAcc.resize( mPCount );
+	mYAcc.resize( mPCount );
+	mR.resize( mPCount );
+	mG.resize( mPCount );
+	mB.resize( mPCount );
+	mA.resize( mPCount );
+	mAlphaDecays.resize( mPCount );
+	mIds.resize( mPCount );
+	mVertexs.clear();
 
-	mParticle = eeNewArray( Particle, mPCount );
-
-	Particle * P;
+	for ( Uint32 i = 0; i < mPCount; i++ ) {
+		mIds[i] = i + 1;
 
-	for ( Uint32 i=0; i < mPCount; i++ ) {
-		P = &mParticle[i];
-		P->setUsed(true);
-		P->setId(i+1);
+		resetParticle( i );
+	}
+}
 
-		reset( P );
+void ParticleSystem::resetParticle( const Uint32& index ) {
+	Particle P;
+	P.setUsed( true );
+	P.setId( mIds[ index ] );
+
+	reset( &P );
+
+	const ColorAf& color = P.getColor();
+
+	mX[ index ]				= P.getX();
+	mY[ index ]				= P.getY();
+	mXSpeed[ index ]		= P.getXSpeed();
+	mYSpeed[ index ]		= P.getYSpeed();
+	mXAcc[ index ]			= P.getXAcc();
+	mYAcc[ index ]			= P.getYAcc();
+	mR[ index ]				= color.r;
+	mG[ index ]				= color.g;
+	mB[ index ]				= color.b;
+	mA[ index ]				= color.a;
+	mAlphaDecays[ index ]	= P.getAlphaDecay();
+}
+
+void ParticleSystem::removeParticle( const Uint32& index ) {
+	// Swap the particle with the last one alive, the dead particle is kept after the alive ones so it can be reused
+	Uint32 last = mPLeft - 1;
+
+	if ( index != last ) {
+		std::swap( mX[ index ], mX[ last ] );
+		std::swap( mY[ index ], mY[ last ] );
+		std::swap( mXSpeed[ index ], mXSpeed[ last ] );
+		std::swap( mYSpeed[ index ], mYSpeed[ last ] );
+		std::swap( mXAcc[ index ], mXAcc[ last ] );
+		std::swap( mYAcc[ index ], mYAcc[ last ] );
+		std::swap( mR[ index ], mR[ last ] );
+		std::swap( mG[ index ], mG[ last ] );
+		std::swap( mB[ index ], mB[ last ] );
+		std::swap( mA[ index ], mA[ last ] );
+		std::swap( mAlphaDecays[ index ], mAlphaDecays[ last ] );
+		std::swap( mIds[ index ], mIds[ last ] );
 	}
+
+	mPLeft--;
 }
 
 void ParticleSystem::setCallbackReset( const ParticleCallback& pc ) {
@@ -316,49 +370,119 @@ void ParticleSystem::reset( Particle * P ) {
 }
 
 void ParticleSystem::draw() {
-	if ( !mUsed )
+	if ( !mUsed || 0 == mPLeft )
 		return;
 
 	TextureFactory * TF = TextureFactory::instance();
+	Texture * Tex = TF->getTexture( mTexId );
 
-	TF->bind( mTexId );
+	if ( NULL == Tex )
+		return;
+
+	writeVertexs();
+
+	// Anything batched must be drawn before the particles
+	GlobalBatchRenderer::instance()->draw();
+
+	TF->bind( Tex );
 	BlendMode::setMode( mBlend );
 
+	bool quads = GLi->quadsSupported();
+	Uint32 vertexsPerParticle = mPointsSup ? 1 : ( quads ? 4 : 6 );
+
+	// Only the vertexs of the live particles are uploaded, the array has room for every particle
+	Uint32 alloc = sizeof(eeVertex) * mPLeft * vertexsPerParticle;
+	char * data = reinterpret_cast<char*> ( &mVertexs[0] );
+
 	if ( mPointsSup ) {
 		GLi->enable( GL_POINT_SPRITE );
 		GLi->pointSize( mSize );
 
-		Uint32 alloc = mPCount * sizeof(Particle);
+		GLi->vertexPointer	( 2, GL_FP			, sizeof(eeVertex), data											, alloc	);
+		GLi->colorPointer	( 4, GL_UNSIGNED_BYTE	, sizeof(eeVertex), data + sizeof(Vector2f) + sizeof(eeTexCoord)	, alloc	);
 
-		GLi->colorPointer	( 4, GL_FP, sizeof(Particle), reinterpret_cast<char*>( &mParticle[0] ) + sizeof(Float) * 2	, alloc	);
-		GLi->vertexPointer	( 2, GL_FP, sizeof(Particle), reinterpret_cast<char*>( &mParticle[0] )							, alloc	);
-
-		GLi->drawArrays( GL_POINTS, 0, (int)mPCount );
+		GLi->drawArrays( GL_POINTS, 0, (int)mPLeft );
 
 		GLi->disable( GL_POINT_SPRITE );
 	} else {
-		Texture * Tex = TF->getTexture( mTexId );
+		GLi->vertexPointer	( 2, GL_FP			, sizeof(eeVertex), data											, alloc	);
+		GLi->texCoordPointer( 2, GL_FP			, sizeof(eeVertex), data + sizeof(Vector2f)							, alloc	);
+		GLi->colorPointer	( 4, GL_UNSIGNED_BYTE	, sizeof(eeVertex), data + sizeof(Vector2f) + sizeof(eeTexCoord)	, alloc	);
 
-		if ( NULL == Tex )
-			return;
+		GLi->drawArrays( quads ? DM_QUADS : DM_TRIANGLES, 0, (int)( mPLeft * vertexsPerParticle ) );
+	}
+}
+
+static inline Uint8 particleColorComponent( const Float& c ) {
+	// The float colors can go over 1, clamp them instead of wrapping around
+	return static_cast<Uint8>( eemin( c, 1.f ) * 255 );
+}
+
+void ParticleSystem::writeVertexs() {
+	Uint32 vertexsPerParticle = mPointsSup ? 1 : ( GLi->quadsSupported() ? 4 : 6 );
+	Uint32 count = mPLeft * vertexsPerParticle;
 
-		Particle* P;
+	if ( mVertexs.size() < count ) {
+		Uint32 first = mVertexs.size() / vertexsPerParticle;
 
-		BatchRenderer * BR = GlobalBatchRenderer::instance();
-		BR->setTexture( Tex );
-		BR->setBlendMode( mBlend );
-		BR->quadsBegin();
+		mVertexs.resize( mPCount * vertexsPerParticle );
 
-		for ( Uint32 i = 0; i < mPCount; i++ ) {
-			P = &mParticle[i];
+		// The texture coordinates never change, they are only set once
+		if ( 4 == vertexsPerParticle || 6 == vertexsPerParticle ) {
+			eeTexCoord quad[4];
+			quad[0].u = 0; quad[0].v = 0;
+			quad[1].u = 0; quad[1].v = 1;
+			quad[2].u = 1; quad[2].v = 1;
+			quad[3].u = 1; quad[3].v = 0;
 
-			if ( P->isUsed() ) {
-				BR->quadsSetColor( Color( static_cast<Uint8> ( P->r() * 255 ), static_cast<Uint8> ( P->g() * 255 ), static_cast<Uint8>( P->b() * 255 ), static_cast<Uint8>( P->a() * 255 ) ) );
-				BR->batchQuad( P->getX() - mHSize, P->getY() - mHSize, mSize, mSize );
+			// Same order than BatchRenderer::batchQuadEx when the quads are drawn as triangles
+			const int triangles[6] = { 1, 0, 3, 1, 2, 3 };
+
+			for ( Uint32 i = first; i < mPCount; i++ ) {
+				eeVertex * v = &mVertexs[ i * vertexsPerParticle ];
+
+				for ( Uint32 n = 0; n < vertexsPerParticle; n++ )
+					v[n].tex = quad[ 4 == vertexsPerParticle ? n : triangles[n] ];
 			}
 		}
+	}
+
+	eeVertex * v = &mVertexs[0];
 
-		BR->drawOpt();
+	if ( 1 == vertexsPerParticle ) {
+		for ( Uint32 i = 0; i < mPLeft; i++ ) {
+			v[i].pos.x = mX[i];
+			v[i].pos.y = mY[i];
+			v[i].color = Color( particleColorComponent( mR[i] ), particleColorComponent( mG[i] ), particleColorComponent( mB[i] ), particleColorComponent( mA[i] ) );
+		}
+	} else if ( 4 == vertexsPerParticle ) {
+		for ( Uint32 i = 0; i < mPLeft; i++, v += 4 ) {
+			Float x0 = mX[i] - mHSize;
+			Float y0 = mY[i] - mHSize;
+			Float x1 = x0 + mSize;
+			Float y1 = y0 + mSize;
+			Color color( particleColorComponent( mR[i] ), particleColorComponent( mG[i] ), particleColorComponent( mB[i] ), particleColorComponent( mA[i] ) );
+
+			v[0].pos.x = x0; v[0].pos.y = y0; v[0].color = color;
+			v[1].pos.x = x0; v[1].pos.y = y1; v[1].color = color;
+			v[2].pos.x = x1; v[2].pos.y = y1; v[2].color = color;
+			v[3].pos.x = x1; v[3].pos.y = y0; v[3].color = color;
+		}
+	} else {
+		for ( Uint32 i = 0; i < mPLeft; i++, v += 6 ) {
+			Float x0 = mX[i] - mHSize;
+			Float y0 = mY[i] - mHSize;
+			Float x1 = x0 + mSize;
+			Float y1 = y0 + mSize;
+			Color color( particleColorComponent( mR[i] ), particleColorComponent( mG[i] ), particleColorComponent( mB[i] ), particleColorComponent( mA[i] ) );
+
+			v[0].pos.x = x0; v[0].pos.y = y1; v[0].color = color;
+			v[1].pos.x = x0; v[1].pos.y = y0; v[1].color = color;
+			v[2].pos.x = x1; v[2].pos.y = y0; v[2].color = color;
+			v[3].pos.x = x0; v[3].pos.y = y1; v[3].color = color;
+			v[4].pos.x = x1; v[4].pos.y = y1; v[4].color = color;
+			v[5].pos.x = x1; v[5].pos.y = y0; v[5].color = color;
+		}
 	}
 }
 
@@ -366,37 +490,103 @@ void ParticleSystem::update() {
 	update( Engine::instance()->getCurrentWindow()->getElapsed() );
 }
 
+Uint32 ParticleSystem::integrate( const Uint32& start, const Uint32& end, const Float& time ) {
+	Float * x		= &mX[0];
+	Float * y		= &mY[0];
+	Float * xSpeed	= &mXSpeed[0];
+	Float * ySpeed	= &mYSpeed[0];
+	const Float * xAcc	= &mXAcc[0];
+	const Float * yAcc	= &mYAcc[0];
+	const Float * decay	= &mAlphaDecays[0];
+	Float * a		= &mA[0];
+	Uint32 dead		= 0;
+
+	for ( Uint32 i = start; i < end; i++ ) {
+		x[i]		+= xSpeed[i] * time;
+		y[i]		+= ySpeed[i] * time;
+		xSpeed[i]	+= xAcc[i] * time;
+		ySpeed[i]	+= yAcc[i] * time;
+
+		Float alpha = eemax( a[i] - decay[i] * time, 0.f );
+		a[i]		= alpha;
+		dead		+= alpha <= 0.f ? 1 : 0;
+	}
+
+	return dead;
+}
+
+Uint32 ParticleSystem::integrateParallel( const Float& time ) {
+	JobSystem * jobSystem = JobSystem::instance();
+	Uint32 count = eemin( jobSystem->getWorkerCount() + 1, mPLeft / PARALLEL_UPDATE_MIN_PARTICLES );
+
+	if ( count <= 1 )
+		return integrate( 0, mPLeft, time );
+
+	mJobs.resize( count );
+
+	Uint32 size = mPLeft / count;
+	std::vector<JobSystem::Handle> handles( count - 1 );
+
+	for ( Uint32 i = 0; i < count; i++ ) {
+		mJobs[i].System	= this;
+		mJobs[i].Start	= i * size;
+		mJobs[i].End	= ( i == count - 1 ) ? mPLeft : ( i + 1 ) * size;
+		mJobs[i].Time	= time;
+		mJobs[i].Dead	= 0;
+	}
+
+	for ( Uint32 i = 0; i < count - 1; i++ )
+		handles[i] = jobSystem->run( cb::Make0( &mJobs[i], &UpdateJob::run ) );
+
+	// The calling thread updates the last range
+	mJobs[ count - 1 ].run();
+
+	Uint32 dead = mJobs[ count - 1 ].Dead;
+
+	for ( Uint32 i = 0; i < count - 1; i++ ) {
+		jobSystem->wait( handles[i] );
+		dead += mJobs[i].Dead;
+	}
+
+	return dead;
+}
+
 void ParticleSystem::update( const System::Time& time ) {
 	if ( !mUsed )
 		return;
 
-	Particle * P;
+	Float t = time.asMilliseconds() * mTime;
+	Uint32 dead = mParallelUpdate ? integrateParallel( t ) : integrate( 0, mPLeft, t );
 
-	for ( Uint32 i = 0; i < mPCount; i++ ) {
-		P = &mParticle[i];
-
-		if ( P->isUsed() || P->a() > 0.f ) {
-			P->update( time.asMilliseconds() * mTime );
-
-			// If not alive
-			if ( P->a() <= 0.f ) {
-				if ( !mLoop ) { // If not loop
-					if ( mLoops == 1 ) { // If left only one loop
-						P->setUsed(false);
-						mPLeft--;
-					} else { // more than one
-						if ( i == 0 )
-							if ( mLoops > 0 ) mLoops--;
-
-						reset(P);
-					}
-
-					if ( mPLeft == 0 ) // Last mParticle?
-						mUsed = false;
-				} else {
-					reset( P );
-				}
+	if ( 0 == dead )
+		return;
+
+	// Reset or remove the particles that faded out
+	for ( Uint32 i = 0; i < mPLeft && dead > 0; ) {
+		if ( mA[i] > 0.f ) {
+			i++;
+			continue;
+		}
+
+		dead--;
+
+		if ( !mLoop ) { // If not loop
+			if ( mLoops == 1 ) { // If left only one loop
+				// The last particle alive is moved to this position, so it's checked in the next iteration
+				removeParticle( i );
+			} else { // more than one
+				if ( mIds[i] == 1 )
+					if ( mLoops > 0 ) mLoops--;
+
+				resetParticle( i );
+				i++;
 			}
+
+			if ( mPLeft == 0 ) // Last particle?
+				mUsed = false;
+		} else {
+			resetParticle( i );
+			i++;
 		}
 	}
 }
@@ -410,8 +600,8 @@ void ParticleSystem::reuse() {
 	mLoop	= true;
 	mLoops	= 0;
 
-	for ( Uint32 i = 0; i < mPCount; i++ )
-		mParticle[i].setUsed( true );
+	// The removed particles are faded out, they will be reset in the next update
+	mPLeft	= mPCount;
 }
 
 void ParticleSystem::kill() {
@@ -502,4 +692,20 @@ void ParticleSystem::setAcceleration( const Vector2f& acc ) {
 	mAcc = acc;
 }
 
+void ParticleSystem::setParallelUpdate( const bool& parallel ) {
+	mParallelUpdate = parallel;
+}
+
+const bool& ParticleSystem::isParallelUpdate() const {
+	return mParallelUpdate;
+}
+
+const Uint32& ParticleSystem::getAliveCount() const {
+	return mPLeft;
+}
+
+const Uint32& ParticleSystem::getCount() const {
+	return mPCount;
+}
+
 }}
@@ -4,6 +4,7 @@
 #include <eepp/graphics/renderer/renderergl3.hpp>
 #include <eepp/graphics/renderer/renderergl3cp.hpp>
 #include <eepp/graphics/renderer/renderergles2.hpp>
+#include <eepp/graphics/renderer/renderernull.hpp>
 #include <eepp/helper/SOIL2/src/SOIL2/SOIL2.h>
 
 namespace EE { namespace Graphics {
@@ -55,6 +56,11 @@ Renderer * Renderer::createSingleton( EEGL_version ver ) {
 	#endif
 
 	switch ( ver ) {
+		case GLv_NULL:
+		{
+			sSingleton = eeNew( RendererNull, () );
+			break;
+		}
 		case GLv_ES2:
 		{
 			#if defined( EE_GL3_ENABLED ) || defined( EE_GLES2 )
@@ -129,16 +135,88 @@ Renderer::Renderer() :
 	mQuadVertexs( 4 ),
 	mLineWidth( 1 ),
 	mCurVAO( 0 ),
-	mClippingMask( eeNew( ClippingMask , () ) )
+	mClippingMask( eeNew( ClippingMask , () ) ),
+	mVertexStream( NULL ),
+	mIndexStream( NULL )
 {
 	GLi = this;
 }
 
 Renderer::~Renderer() {
+	eeSAFE_DELETE( mVertexStream );
+	eeSAFE_DELETE( mIndexStream );
 	eeSAFE_DELETE( mClippingMask );
 	GLi = NULL;
 }
 
+void Renderer::createVertexStreams() {
+	eeSAFE_DELETE( mVertexStream );
+	eeSAFE_DELETE( mIndexStream );
+
+	mVertexStream	= eeNew( VertexStreamBuffer, ( GL_ARRAY_BUFFER, 4 * 1024 * 1024 ) );
+	mIndexStream	= eeNew( VertexStreamBuffer, ( GL_ELEMENT_ARRAY_BUFFER, 1024 * 1024 ) );
+}
+
+const void * Renderer::streamVertexPointer( const void * pointer, unsigned int allocate ) {
+	if ( NULL == mVertexStream || 0 == allocate )
+		return pointer;
+
+	unsigned int offset;
+
+	if ( mVertexStream->findOffset( pointer, offset ) ) {
+		mVertexStream->bind();
+	} else {
+		offset = mVertexStream->upload( pointer, allocate );
+	}
+
+	return reinterpret_cast<const void*>( (size_t)offset );
+}
+
+void * Renderer::mapVertexStream( unsigned int size ) {
+	return NULL != mVertexStream ? mVertexStream->map( size ) : NULL;
+}
+
+void Renderer::unmapVertexStream() {
+	if ( NULL != mVertexStream )
+		mVertexStream->unmap();
+}
+
+void Renderer::releaseVertexStream() {
+	if ( NULL != mVertexStream )
+		mVertexStream->releaseMapped();
+}
+
+VertexStreamBuffer * Renderer::getVertexStream() const {
+	return mVertexStream;
+}
+
+VertexStreamBuffer::Stats Renderer::getVertexStreamStats() const {
+	VertexStreamBuffer::Stats stats;
+
+	if ( NULL != mVertexStream ) {
+		stats = mVertexStream->getFrameStats();
+	}
+
+	if ( NULL != mIndexStream ) {
+		const VertexStreamBuffer::Stats& indexStats = mIndexStream->getFrameStats();
+
+		stats.BytesUploaded	+= indexStats.BytesUploaded;
+		stats.Uploads		+= indexStats.Uploads;
+		stats.Orphans		+= indexStats.Orphans;
+		stats.Waits			+= indexStats.Waits;
+	}
+
+	return stats;
+}
+
+void Renderer::endFrame() {
+	if ( NULL != mVertexStream )
+		mVertexStream->endFrame();
+
+	if ( NULL != mIndexStream )
+		mIndexStream->endFrame();
+}
+
 RendererGL * Renderer::getRendererGL() {
 	return reinterpret_cast<RendererGL*>( this );
 }
@@ -155,6 +233,10 @@ RendererGLES2 * Renderer::getRendererGLES2() {
 	return reinterpret_cast<RendererGLES2*>( this );
 }
 
+RendererNull * Renderer::getRendererNull() {
+	return reinterpret_cast<RendererNull*>( this );
+}
+
 void Renderer::writeExtension( Uint8 Pos, Uint32 BitWrite ) {
 	BitOp::writeBitKey( &mExtensions, Pos, BitWrite );
 }
@@ -180,6 +262,8 @@ void Renderer::init() {
 		writeExtension( EEGL_ARB_pixel_buffer_object		, GLEW_ARB_pixel_buffer_object						);
 		writeExtension( EEGL_ARB_vertex_array_object		, GLEW_ARB_vertex_array_object 						);
 		writeExtension( EEGL_EXT_blend_func_separate		, GLEW_EXT_blend_func_separate						);
+		writeExtension( EEGL_ARB_map_buffer_range			, GLEW_ARB_map_buffer_range							);
+		writeExtension( EEGL_ARB_buffer_storage				, GLEW_ARB_buffer_storage && GLEW_ARB_sync			);
 	}
 	else
 	#endif
@@ -198,6 +282,8 @@ void Renderer::init() {
 		writeExtension( EEGL_ARB_pixel_buffer_object		, isExtension( "GL_ARB_pixel_buffer_object" )		);
 		writeExtension( EEGL_ARB_vertex_array_object		, isExtension( "GL_ARB_vertex_array_object" )		);
 		writeExtension( EEGL_EXT_blend_func_separate		, isExtension( "GL_EXT_blend_func_separate" )		);
+		writeExtension( EEGL_ARB_map_buffer_range			, isExtension( "GL_ARB_map_buffer_range" )			);
+		writeExtension( EEGL_ARB_buffer_storage				, isExtension( "GL_ARB_buffer_storage" ) && isExtension( "GL_ARB_sync" )	);
 	}
 
 	// NVIDIA added support for GL_OES_compressed_ETC1_RGB8_texture in desktop GPUs
@@ -452,10 +538,29 @@ void Renderer::polygonMode( unsigned int face, unsigned int mode ) {
 
 void Renderer::drawArrays (unsigned int mode, int first, int count) {
 	glDrawArrays( mode, first, count );
+
+	if ( NULL != mVertexStream )
+		mVertexStream->invalidate();
 }
 
 void Renderer::drawElements( unsigned int mode, int count, unsigned int type, const void *indices ) {
-	glDrawElements( mode, count, type, indices );
+	GLint bound = 0;
+
+	// With an element buffer bound by the caller the indices are an offset in it, only the client memory indices are streamed
+	if ( NULL != mIndexStream && NULL != indices )
+		glGetIntegerv( GL_ELEMENT_ARRAY_BUFFER_BINDING, &bound );
+
+	if ( NULL != mIndexStream && NULL != indices && ( 0 == bound || (unsigned int)bound == mIndexStream->getHandle() ) ) {
+		unsigned int typeSize = GL_UNSIGNED_BYTE == type ? 1 : ( GL_UNSIGNED_SHORT == type ? 2 : 4 );
+		unsigned int offset = mIndexStream->upload( indices, count * typeSize );
+
+		glDrawElements( mode, count, type, reinterpret_cast<const void*>( (size_t)offset ) );
+	} else {
+		glDrawElements( mode, count, type, indices );
+	}
+
+	if ( NULL != mVertexStream )
+		mVertexStream->invalidate();
 }
 
 void Renderer::bindTexture ( unsigned int target, unsigned int texture ) {
@@ -471,6 +576,10 @@ void Renderer::blendFunc ( unsigned int sfactor, unsigned int dfactor ) {
 	glBlendFunc( sfactor, dfactor );
 }
 
+void Renderer::blendFuncSeparate( unsigned int sfactorRGB, unsigned int dfactorRGB, unsigned int sfactorAlpha, unsigned int dfactorAlpha ) {
+	glBlendFuncSeparateEXT( sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha );
+}
+
 void Renderer::setShader( ShaderProgram * Shader ) {
 	#ifdef EE_SHADERS_SUPPORTED
 	if ( NULL != Shader ) {
@@ -511,7 +620,10 @@ void Renderer::lineWidth(float width) {
 		}
 		mLineWidth = width;
 	}
+}
 
+const float& Renderer::getLineWidth() const {
+	return mLineWidth;
 }
 
 void Renderer::polygonMode() {
@@ -527,6 +639,26 @@ void Renderer::pixelStorei(unsigned int pname, int param) {
 	glPixelStorei( pname, param );
 }
 
+void Renderer::getIntegerv( unsigned int pname, int * params ) {
+	glGetIntegerv( pname, params );
+}
+
+unsigned int Renderer::createTexture( const unsigned char * pixels, int * width, int * height, int channels, unsigned int reuseTextureId, unsigned int flags ) {
+	return SOIL_create_OGL_texture( pixels, width, height, channels, reuseTextureId, flags );
+}
+
+void Renderer::deleteTextures( int n, const unsigned int * textures ) {
+	glDeleteTextures( n, textures );
+}
+
+void Renderer::texSubImage2D( unsigned int target, int level, int xoffset, int yoffset, int width, int height, unsigned int format, unsigned int type, const void * pixels ) {
+	glTexSubImage2D( target, level, xoffset, yoffset, width, height, format, type, pixels );
+}
+
+void Renderer::texParameteri( unsigned int target, unsigned int pname, int param ) {
+	glTexParameteri( target, pname, param );
+}
+
 void Renderer::polygonMode( const EE_FILL_MODE& Mode ) {
 	if ( Mode == DRAW_FILL )
 		polygonMode( GL_FRONT_AND_BACK, GL_FILL );
@@ -577,7 +709,7 @@ std::string Renderer::getShadingLanguageVersion() {
 }
 
 void Renderer::getViewport( int * viewport ) {
-	glGetIntegerv( GL_VIEWPORT, viewport );
+	getIntegerv( GL_VIEWPORT, viewport );
 }
 
 Vector3f Renderer::projectCurrent( const Vector3f& point ) {
@@ -126,6 +126,10 @@ void RendererGL3::init() {
 
 	clientActiveTexture( GL_TEXTURE0 );
 
+	// Stream the vertexs in a buffer object instead of letting the driver copy the client memory on every draw
+	if ( isExtension( EEGL_ARB_vertex_buffer_object ) )
+		createVertexStreams();
+
 	mLoaded = true;
 }
 
@@ -347,6 +351,8 @@ void RendererGL3::vertexPointer ( int size, unsigned int type, int stride, const
 	const int index = mAttribsLoc[ EEGL_VERTEX_ARRAY ];
 
 	if ( -1 != index ) {
+		pointer = streamVertexPointer( pointer, allocate );
+
 		if ( 0 == mAttribsLocStates[ EEGL_VERTEX_ARRAY ] ) {
 			mAttribsLocStates[ EEGL_VERTEX_ARRAY ] = 1;
 
@@ -361,6 +367,8 @@ void RendererGL3::colorPointer ( int size, unsigned int type, int stride, const
 	const int index = mAttribsLoc[ EEGL_COLOR_ARRAY ];
 
 	if ( -1 != index ) {
+		pointer = streamVertexPointer( pointer, allocate );
+
 		if ( 0 == mAttribsLocStates[ EEGL_COLOR_ARRAY ] ) {
 			mAttribsLocStates[ EEGL_COLOR_ARRAY ] = 1;
 
@@ -379,6 +387,8 @@ void RendererGL3::texCoordPointer ( int size, unsigned int type, int stride, con
 	const int index = mTextureUnits[ mCurActiveTex ];
 
 	if ( -1 != index ) {
+		pointer = streamVertexPointer( pointer, allocate );
+
 		if ( 0 == mTextureUnitsStates[ mCurActiveTex ] ) {
 			mTextureUnitsStates[ mCurActiveTex ] = 1;
 
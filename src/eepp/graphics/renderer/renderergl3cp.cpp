@@ -67,9 +67,6 @@ RendererGL3CP::RendererGL3CP() :
 	mPointSpriteLoc(-1),
 	mPointSize(1.f),
 	mCurActiveTex( 0 ),
-	mCurTexCoordArray( 0 ),
-	mVBOSizeAlloc( 1024 * 1024 ),
-	mBiggestAlloc( 0 ),
 	mLoaded( false )
 {
 	mQuadsSupported		= false;
@@ -81,19 +78,9 @@ RendererGL3CP::RendererGL3CP() :
 }
 
 RendererGL3CP::~RendererGL3CP() {
-	for ( Uint32 i = 0; i < eeARRAY_SIZE( mVBO ); i++ ) {
-		if ( 0 != mVBO[i] ) {
-			glDeleteBuffersARB( 1, &mVBO[i] );
-		}
-	}
-
 	deleteVertexArrays( 1, &mVAO );
 
 	eeSAFE_DELETE( mStack );
-
-	#ifdef EE_DEBUG
-	Log::instance()->write( "Biggest VBO allocation on GL3 Renderer: " + FileSystem::sizeToString( mBiggestAlloc ) );
-	#endif
 }
 
 EEGL_version RendererGL3CP::version() {
@@ -120,9 +107,6 @@ void RendererGL3CP::init() {
 			mAttribsLocStates[ i ]	= 0;
 		}
 
-		for ( i = 0; i < eeARRAY_SIZE(mVBO); i++ )
-			mVBO[i] = 0;
-
 		for ( i = 0; i < EE_MAX_PLANES; i++ ) {
 			mPlanes[i]			= -1;
 			mPlanesStates[i]	= 0;
@@ -148,9 +132,8 @@ void RendererGL3CP::init() {
 	genVertexArrays( 1, &mVAO );
 	bindVertexArray( mVAO );
 
-	glGenBuffersARB( EEGL_ARRAY_STATES_COUNT+5, &mVBO[0] );
-
-	allocateBuffers( mVBOSizeAlloc );
+	// The core profile doesn't allow client memory for the vertexs and the indexes, everything is streamed
+	createVertexStreams();
 
 	clientActiveTexture( GL_TEXTURE0 );
 
@@ -376,19 +359,10 @@ void RendererGL3CP::disableClientState( unsigned int array ) {
 void RendererGL3CP::vertexPointer ( int size, unsigned int type, int stride, const void * pointer, unsigned int allocate ) {
 	const int index = mAttribsLoc[ EEGL_VERTEX_ARRAY ];
 
-	#ifdef EE_DEBUG
-	mBiggestAlloc = eemax( mBiggestAlloc, allocate );
-	#endif
-
 	if ( -1 != index ) {
 		bindVertexArray( mVAO );
 
-		if ( allocate > mVBOSizeAlloc ) {
-			allocateBuffers( allocate );
-		}
-
-		glBindBufferARB( GL_ARRAY_BUFFER, mVBO[ EEGL_VERTEX_ARRAY ]			);
-		glBufferSubDataARB( GL_ARRAY_BUFFER, 0, allocate, pointer );
+		pointer = streamVertexPointer( pointer, allocate );
 
 		if ( 0 == mAttribsLocStates[ EEGL_VERTEX_ARRAY ] ) {
 			mAttribsLocStates[ EEGL_VERTEX_ARRAY ] = 1;
@@ -397,9 +371,9 @@ void RendererGL3CP::vertexPointer ( int size, unsigned int type, int stride, con
 		}
 
 		if ( type == GL_UNSIGNED_BYTE ) {
-			glVertexAttribPointerARB( index, size, type, GL_TRUE, stride, 0 );
+			glVertexAttribPointerARB( index, size, type, GL_TRUE, stride, pointer );
 		} else {
-			glVertexAttribPointerARB( index, size, type, GL_FALSE, stride, 0 );
+			glVertexAttribPointerARB( index, size, type, GL_FALSE, stride, pointer );
 		}
 	}
 }
@@ -407,19 +381,10 @@ void RendererGL3CP::vertexPointer ( int size, unsigned int type, int stride, con
 void RendererGL3CP::colorPointer ( int size, unsigned int type, int stride, const void *pointer, unsigned int allocate ) {
 	const int index = mAttribsLoc[ EEGL_COLOR_ARRAY ];
 
-	#ifdef EE_DEBUG
-	mBiggestAlloc = eemax( mBiggestAlloc, allocate );
-	#endif
-
 	if ( -1 != index ) {
 		bindVertexArray( mVAO );
 
-		if ( allocate > mVBOSizeAlloc ) {
-			allocateBuffers( allocate );
-		}
-
-		glBindBufferARB( GL_ARRAY_BUFFER, mVBO[ EEGL_COLOR_ARRAY ]				);
-		glBufferSubDataARB( GL_ARRAY_BUFFER, 0, allocate, pointer );
+		pointer = streamVertexPointer( pointer, allocate );
 
 		if ( 0 == mAttribsLocStates[ EEGL_COLOR_ARRAY ] ) {
 			mAttribsLocStates[ EEGL_COLOR_ARRAY ] = 1;
@@ -428,9 +393,9 @@ void RendererGL3CP::colorPointer ( int size, unsigned int type, int stride, cons
 		}
 
 		if ( type == GL_UNSIGNED_BYTE ) {
-			glVertexAttribPointerARB( index, size, type, GL_TRUE, stride, 0 );
+			glVertexAttribPointerARB( index, size, type, GL_TRUE, stride, pointer );
 		} else {
-			glVertexAttribPointerARB( index, size, type, GL_FALSE, stride, 0 );
+			glVertexAttribPointerARB( index, size, type, GL_FALSE, stride, pointer );
 		}
 	}
 }
@@ -438,19 +403,10 @@ void RendererGL3CP::colorPointer ( int size, unsigned int type, int stride, cons
 void RendererGL3CP::texCoordPointer ( int size, unsigned int type, int stride, const void *pointer, unsigned int allocate ) {
 	const int index = mTextureUnits[ mCurActiveTex ];
 
-	#ifdef EE_DEBUG
-	mBiggestAlloc = eemax( mBiggestAlloc, allocate );
-	#endif
-
 	if ( -1 != index ) {
 		bindVertexArray( mVAO );
 
-		if ( allocate > mVBOSizeAlloc ) {
-			allocateBuffers( allocate );
-		}
-
-		glBindBufferARB( GL_ARRAY_BUFFER, mCurTexCoordArray );
-		glBufferSubDataARB( GL_ARRAY_BUFFER, 0, allocate, pointer );
+		pointer = streamVertexPointer( pointer, allocate );
 
 		if ( 0 == mTextureUnitsStates[ mCurActiveTex ] ) {
 			mTextureUnitsStates[ mCurActiveTex ] = 1;
@@ -458,7 +414,7 @@ void RendererGL3CP::texCoordPointer ( int size, unsigned int type, int stride, c
 			glEnableVertexAttribArray( index );
 		}
 
-		glVertexAttribPointerARB( index, size, type, GL_FALSE, stride, 0 );
+		glVertexAttribPointerARB( index, size, type, GL_FALSE, stride, pointer );
 	}
 }
 
@@ -680,14 +636,6 @@ void RendererGL3CP::clientActiveTexture( unsigned int texture ) {
 
 	if ( mCurActiveTex >= EE_MAX_TEXTURE_UNITS )
 		mCurActiveTex = 0;
-
-	switch ( mCurActiveTex )
-	{
-		case 0: mCurTexCoordArray = mVBO[ EEGL_TEXTURE_COORD_ARRAY ]; break;
-		case 1: mCurTexCoordArray = mVBO[ EEGL_TEXTURE_COORD_ARRAY+1 ]; break;
-		case 2: mCurTexCoordArray = mVBO[ EEGL_TEXTURE_COORD_ARRAY+2 ]; break;
-		case 3: mCurTexCoordArray = mVBO[ EEGL_TEXTURE_COORD_ARRAY+3 ]; break;
-	}
 }
 
 void RendererGL3CP::texEnvi( unsigned int target, unsigned int pname, int param ) {
@@ -732,31 +680,6 @@ void RendererGL3CP::bindGlobalVAO() {
 	bindVertexArray( mVAO );
 }
 
-void RendererGL3CP::allocateBuffers( const Uint32& size ) {
-	if ( mVBOSizeAlloc != size )
-		Log::instance()->write( "Allocating new VBO buffers size: " + String::toStr( size ) );
-
-	mVBOSizeAlloc = size;
-
-	glBindBufferARB( GL_ARRAY_BUFFER, mVBO[ EEGL_VERTEX_ARRAY ] );
-	glBufferDataARB( GL_ARRAY_BUFFER, mVBOSizeAlloc, NULL, GL_STREAM_DRAW );
-
-	glBindBufferARB( GL_ARRAY_BUFFER, mVBO[ EEGL_COLOR_ARRAY ] );
-	glBufferDataARB( GL_ARRAY_BUFFER, mVBOSizeAlloc, NULL, GL_STREAM_DRAW );
-
-	glBindBufferARB( GL_ARRAY_BUFFER, mVBO[ EEGL_TEXTURE_COORD_ARRAY ] );
-	glBufferDataARB( GL_ARRAY_BUFFER, mVBOSizeAlloc, NULL, GL_STREAM_DRAW );
-
-	glBindBufferARB( GL_ARRAY_BUFFER, mVBO[ EEGL_TEXTURE_COORD_ARRAY+1 ] );
-	glBufferDataARB( GL_ARRAY_BUFFER, mVBOSizeAlloc, NULL, GL_STREAM_DRAW );
-
-	glBindBufferARB( GL_ARRAY_BUFFER, mVBO[ EEGL_TEXTURE_COORD_ARRAY+2 ] );
-	glBufferDataARB( GL_ARRAY_BUFFER, mVBOSizeAlloc, NULL, GL_STREAM_DRAW );
-
-	glBindBufferARB( GL_ARRAY_BUFFER, mVBO[ EEGL_TEXTURE_COORD_ARRAY+3 ] );
-	glBufferDataARB( GL_ARRAY_BUFFER, mVBOSizeAlloc, NULL, GL_STREAM_DRAW );
-}
-
 }}
 
 #endif
@@ -160,6 +160,9 @@ void RendererGLES2::init() {
 
 	clientActiveTexture( GL_TEXTURE0 );
 
+	// Stream the vertexs in a buffer object instead of letting the driver copy the client memory on every draw
+	createVertexStreams();
+
 	mLoaded = true;
 }
 
@@ -406,6 +409,8 @@ void RendererGLES2::vertexPointer( int size, unsigned int type, int stride, cons
 	const int index = mAttribsLoc[ EEGL_VERTEX_ARRAY ];
 
 	if ( -1 != index ) {
+		pointer = streamVertexPointer( pointer, allocate );
+
 		if ( 0 == mAttribsLocStates[ EEGL_VERTEX_ARRAY ] ) {
 			mAttribsLocStates[ EEGL_VERTEX_ARRAY ] = 1;
 
@@ -420,6 +425,8 @@ void RendererGLES2::colorPointer( int size, unsigned int type, int stride, const
 	const int index = mAttribsLoc[ EEGL_COLOR_ARRAY ];
 
 	if ( -1 != index ) {
+		pointer = streamVertexPointer( pointer, allocate );
+
 		if ( 0 == mAttribsLocStates[ EEGL_COLOR_ARRAY ] ) {
 			mAttribsLocStates[ EEGL_COLOR_ARRAY ] = 1;
 
@@ -452,6 +459,8 @@ void RendererGLES2::texCoordPointer ( int size, unsigned int type, int stride, c
 	const int index = mTextureUnits[ mCurActiveTex ];
 
 	if ( -1 != index ) {
+		pointer = streamVertexPointer( pointer, allocate );
+
 		if ( 0 == mTextureUnitsStates[ mCurActiveTex ] ) {
 			mTextureUnitsStates[ mCurActiveTex ] = 1;
 
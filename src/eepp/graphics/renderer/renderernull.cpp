@@ -0,0 +1,698 @@
+#include <eepp/graphics/renderer/openglext.hpp>
+#include <eepp/graphics/renderer/renderernull.hpp>
+#include <eepp/graphics/renderer/rendererstackhelper.hpp>
+
+// The framebuffer queries are not defined by the OpenGL ES 1 headers
+#ifndef GL_FRAMEBUFFER_BINDING
+#define GL_FRAMEBUFFER_BINDING 0x8CA6
+#endif
+
+#ifndef GL_RENDERBUFFER_BINDING
+#define GL_RENDERBUFFER_BINDING 0x8CA7
+#endif
+
+#ifndef GL_FRAMEBUFFER_COMPLETE
+#define GL_FRAMEBUFFER_COMPLETE 0x8CD5
+#endif
+
+namespace EE { namespace Graphics {
+
+static const char * EEGL_NULL_COMMAND_NAMES[] = {
+	"clear",
+	"clearColor",
+	"viewport",
+	"scissor",
+	"enable",
+	"disable",
+	"blendFunc",
+	"lineWidth",
+	"pointSize",
+	"polygonMode",
+	"pixelStore",
+	"stencil",
+	"colorMask",
+	"setShader",
+	"texEnv",
+	"clipPlane",
+	"clientState",
+	"activeTexture",
+	"bindTexture",
+	"bindVertexArray",
+	"bindFramebuffer",
+	"matrixMode",
+	"pushMatrix",
+	"popMatrix",
+	"loadMatrix",
+	"multMatrix",
+	"vertexPointer",
+	"colorPointer",
+	"texCoordPointer",
+	"drawArrays",
+	"drawElements",
+	"textureCreate",
+	"textureUpdate",
+	"textureDelete",
+	"textureParameter"
+};
+
+static Uint32 getPixelFormatSize( unsigned int format ) {
+	switch ( format ) {
+		case GL_ALPHA:
+		case GL_LUMINANCE:				return 1;
+		case GL_LUMINANCE_ALPHA:		return 2;
+		case GL_RGB:					return 3;
+		default:						return 4;
+	}
+}
+
+RendererNull::FrameStats::FrameStats() {
+	reset();
+}
+
+void RendererNull::FrameStats::reset() {
+	Commands = 0;
+	DrawCalls = 0;
+	Vertexs = 0;
+	TextureBinds = 0;
+	TextureChanges = 0;
+	StateChanges = 0;
+	MatrixOps = 0;
+	TextureUploads = 0;
+	VertexBytes = 0;
+	TextureBytes = 0;
+
+	for ( Uint32 i = 0; i < CMD_COUNT; i++ )
+		CommandsByType[i] = 0;
+}
+
+Uint64 RendererNull::FrameStats::getBytesUploaded() const {
+	return VertexBytes + TextureBytes;
+}
+
+const char * RendererNull::getCommandName( const CommandType& type ) {
+	return type < CMD_COUNT ? EEGL_NULL_COMMAND_NAMES[ type ] : "unknown";
+}
+
+RendererNull::RendererNull() :
+	mCurrentMode( 0 ),
+	mFrameCount( 0 ),
+	mRecording( true ),
+	mPointSize( 1.f ),
+	mActiveTexture( 0 ),
+	mFramebuffer( 0 ),
+	mRenderbuffer( 0 ),
+	mLastId( 0 )
+{
+	mStack = eeNew( MatrixStack, () );
+	mStack->mProjectionMatrix.push	( glm::mat4( 1.0f ) ); // identity matrix
+	mStack->mModelViewMatrix.push	( glm::mat4( 1.0f ) ); // identity matrix
+	mStack->mCurMatrix = &mStack->mModelViewMatrix;
+
+	mViewport[0] = mViewport[1] = mViewport[2] = mViewport[3] = 0;
+
+	for ( Uint32 i = 0; i < EE_MAX_TEXTURE_UNITS; i++ )
+		mTextureBound[i] = 0;
+}
+
+RendererNull::~RendererNull() {
+	eeSAFE_DELETE( mStack );
+}
+
+EEGL_version RendererNull::version() {
+	return GLv_NULL;
+}
+
+std::string RendererNull::versionStr() {
+	return "Null";
+}
+
+void RendererNull::init() {
+	// There's no extension to query, the textures can have any size and everything else uses the fallback paths
+	mExtensions = ( 1 << EEGL_ARB_texture_non_power_of_two );
+}
+
+void RendererNull::setRecording( const bool& recording ) {
+	mRecording = recording;
+}
+
+const bool& RendererNull::isRecording() const {
+	return mRecording;
+}
+
+void RendererNull::endFrame() {
+	Renderer::endFrame();
+
+	mFrameStats = mStats;
+	mStats.reset();
+
+	mFrameCommands.swap( mCommands );
+	mCommands.clear();
+
+	mFrameCount++;
+}
+
+const Uint32& RendererNull::getFrameCount() const {
+	return mFrameCount;
+}
+
+const RendererNull::FrameStats& RendererNull::getStats() const {
+	return mStats;
+}
+
+const RendererNull::FrameStats& RendererNull::getFrameStats() const {
+	return mFrameStats;
+}
+
+const std::vector<RendererNull::Command>& RendererNull::getCommands() const {
+	return mCommands;
+}
+
+const std::vector<RendererNull::Command>& RendererNull::getFrameCommands() const {
+	return mFrameCommands;
+}
+
+void RendererNull::clearCommands() {
+	mCommands.clear();
+	mStats.reset();
+}
+
+std::string RendererNull::dumpCommands( bool lastFrame ) const {
+	const std::vector<Command>& commands = lastFrame ? mFrameCommands : mCommands;
+	std::string dump;
+
+	for ( size_t i = 0; i < commands.size(); i++ ) {
+		const Command& cmd = commands[i];
+
+		dump += String::strFormated( "%u %s( %u, %u, %u, %u ) ( %.2f, %.2f, %.2f, %.2f )", (Uint32)i, getCommandName( cmd.Type ),
+									 cmd.Param[0], cmd.Param[1], cmd.Param[2], cmd.Param[3],
+									 cmd.Value[0], cmd.Value[1], cmd.Value[2], cmd.Value[3] );
+
+		if ( cmd.Bytes > 0 )
+			dump += String::strFormated( " %u bytes", cmd.Bytes );
+
+		dump += "\n";
+	}
+
+	return dump;
+}
+
+unsigned int RendererNull::getTextureBound() const {
+	return mTextureBound[ mActiveTexture ];
+}
+
+RendererNull::Command& RendererNull::record( const CommandType& type, Uint32 p0, Uint32 p1, Uint32 p2, Uint32 p3 ) {
+	mStats.Commands++;
+	mStats.CommandsByType[ type ]++;
+
+	if ( type >= CMD_MATRIX_MODE && type <= CMD_MULT_MATRIX ) {
+		mStats.MatrixOps++;
+	} else if ( ( type >= CMD_CLEAR_COLOR && type <= CMD_BIND_FRAMEBUFFER && type != CMD_BIND_TEXTURE ) || type == CMD_TEXTURE_PARAMETER ) {
+		mStats.StateChanges++;
+	}
+
+	Command * cmd = &mDiscarded;
+
+	if ( mRecording ) {
+		mCommands.push_back( Command() );
+		cmd = &mCommands.back();
+	}
+
+	cmd->Type = type;
+	cmd->Param[0] = p0;
+	cmd->Param[1] = p1;
+	cmd->Param[2] = p2;
+	cmd->Param[3] = p3;
+	cmd->Value[0] = cmd->Value[1] = cmd->Value[2] = cmd->Value[3] = 0;
+	cmd->Bytes = 0;
+
+	return *cmd;
+}
+
+void RendererNull::recordValues( const CommandType& type, float v0, float v1, float v2, float v3 ) {
+	Command& cmd = record( type, type >= CMD_MATRIX_MODE && type <= CMD_MULT_MATRIX ? mCurrentMode : 0 );
+	cmd.Value[0] = v0;
+	cmd.Value[1] = v1;
+	cmd.Value[2] = v2;
+	cmd.Value[3] = v3;
+}
+
+void RendererNull::recordPointer( const CommandType& cmd, int size, unsigned int type, int stride, unsigned int allocate ) {
+	record( cmd, size, type, stride ).Bytes = allocate;
+
+	mStats.VertexBytes += allocate;
+}
+
+void RendererNull::genIds( int n, unsigned int * ids ) {
+	for ( int i = 0; i < n; i++ )
+		ids[i] = ++mLastId;
+}
+
+void RendererNull::clear( unsigned int mask ) {
+	record( CMD_CLEAR, mask );
+}
+
+void RendererNull::clearColor( float red, float green, float blue, float alpha ) {
+	Command& cmd = record( CMD_CLEAR_COLOR );
+	cmd.Value[0] = red;
+	cmd.Value[1] = green;
+	cmd.Value[2] = blue;
+	cmd.Value[3] = alpha;
+}
+
+void RendererNull::scissor( int x, int y, int width, int height ) {
+	record( CMD_SCISSOR, x, y, width, height );
+}
+
+void RendererNull::polygonMode( unsigned int face, unsigned int mode ) {
+	record( CMD_POLYGON_MODE, face, mode );
+}
+
+std::string RendererNull::getExtensions() {
+	return std::string();
+}
+
+const char * RendererNull::getString( unsigned int name ) {
+	switch ( name ) {
+		case GL_VENDOR:		return "eepp";
+		case GL_RENDERER:	return "Null renderer";
+		case GL_VERSION:	return "Null";
+	}
+
+	return NULL;
+}
+
+void RendererNull::drawArrays( unsigned int mode, int first, int count ) {
+	record( CMD_DRAW_ARRAYS, mode, first, count );
+
+	mStats.DrawCalls++;
+	mStats.Vertexs += count;
+}
+
+void RendererNull::drawElements( unsigned int mode, int count, unsigned int type, const void * indices ) {
+	record( CMD_DRAW_ELEMENTS, mode, count, type );
+
+	mStats.DrawCalls++;
+	mStats.Vertexs += count;
+}
+
+void RendererNull::bindTexture( unsigned int target, unsigned int texture ) {
+	record( CMD_BIND_TEXTURE, target, texture, mActiveTexture );
+
+	mStats.TextureBinds++;
+
+	if ( mTextureBound[ mActiveTexture ] != texture ) {
+		mTextureBound[ mActiveTexture ] = texture;
+		mStats.TextureChanges++;
+	}
+}
+
+void RendererNull::activeTexture( unsigned int texture ) {
+	record( CMD_ACTIVE_TEXTURE, texture );
+
+	mActiveTexture = eemin<unsigned int>( texture - GL_TEXTURE0, EE_MAX_TEXTURE_UNITS - 1 );
+}
+
+void RendererNull::blendFunc( unsigned int sfactor, unsigned int dfactor ) {
+	record( CMD_BLEND_FUNC, sfactor, dfactor, sfactor, dfactor );
+}
+
+void RendererNull::blendFuncSeparate( unsigned int sfactorRGB, unsigned int dfactorRGB, unsigned int sfactorAlpha, unsigned int dfactorAlpha ) {
+	record( CMD_BLEND_FUNC, sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha );
+}
+
+void RendererNull::viewport( int x, int y, int width, int height ) {
+	record( CMD_VIEWPORT, x, y, width, height );
+
+	mViewport[0] = x;
+	mViewport[1] = y;
+	mViewport[2] = width;
+	mViewport[3] = height;
+}
+
+void RendererNull::lineWidth( float width ) {
+	if ( width != mLineWidth ) {
+		recordValues( CMD_LINE_WIDTH, width );
+
+		mLineWidth = width;
+	}
+}
+
+void RendererNull::pixelStorei( unsigned int pname, int param ) {
+	record( CMD_PIXEL_STORE, pname, param );
+}
+
+void RendererNull::getIntegerv( unsigned int pname, int * params ) {
+	switch ( pname ) {
+		case GL_VIEWPORT:
+		{
+			params[0] = mViewport[0];
+			params[1] = mViewport[1];
+			params[2] = mViewport[2];
+			params[3] = mViewport[3];
+			break;
+		}
+		case GL_MAX_TEXTURE_SIZE:			*params = 16384; break;
+		case GL_TEXTURE_BINDING_2D:			*params = mTextureBound[ mActiveTexture ]; break;
+		case GL_FRAMEBUFFER_BINDING:		*params = mFramebuffer; break;
+		case GL_RENDERBUFFER_BINDING:		*params = mRenderbuffer; break;
+		default:							*params = 0;
+	}
+}
+
+unsigned int RendererNull::createTexture( const unsigned char * pixels, int * width, int * height, int channels, unsigned int reuseTextureId, unsigned int flags ) {
+	if ( NULL == pixels || *width <= 0 || *height <= 0 )
+		return 0;
+
+	unsigned int texture = reuseTextureId;
+
+	if ( 0 == texture )
+		genIds( 1, &texture );
+
+	Uint32 bytes = *width * *height * channels;
+
+	record( CMD_TEXTURE_CREATE, texture, *width, *height, channels ).Bytes = bytes;
+
+	mStats.TextureUploads++;
+	mStats.TextureBytes += bytes;
+
+	return texture;
+}
+
+void RendererNull::deleteTextures( int n, const unsigned int * textures ) {
+	for ( int i = 0; i < n; i++ ) {
+		record( CMD_TEXTURE_DELETE, textures[i] );
+
+		for ( Uint32 u = 0; u < EE_MAX_TEXTURE_UNITS; u++ ) {
+			if ( mTextureBound[u] == textures[i] )
+				mTextureBound[u] = 0;
+		}
+	}
+}
+
+void RendererNull::texSubImage2D( unsigned int target, int level, int xoffset, int yoffset, int width, int height, unsigned int format, unsigned int type, const void * pixels ) {
+	Uint32 bytes = width * height * getPixelFormatSize( format );
+
+	record( CMD_TEXTURE_UPDATE, mTextureBound[ mActiveTexture ], width, height, format ).Bytes = bytes;
+
+	mStats.TextureUploads++;
+	mStats.TextureBytes += bytes;
+}
+
+void RendererNull::texParameteri( unsigned int target, unsigned int pname, int param ) {
+	record( CMD_TEXTURE_PARAMETER, mTextureBound[ mActiveTexture ], pname, param );
+}
+
+void RendererNull::pointSize( float size ) {
+	recordValues( CMD_POINT_SIZE, size );
+
+	mPointSize = size;
+}
+
+float RendererNull::pointSize() {
+	return mPointSize;
+}
+
+void RendererNull::clientActiveTexture( unsigned int texture ) {
+	record( CMD_ACTIVE_TEXTURE, texture, 1 );
+}
+
+void RendererNull::disable( unsigned int cap ) {
+	if ( GL_BLEND == cap ) {
+		if ( !mBlendEnabled )
+			return;
+
+		mBlendEnabled = false;
+	}
+
+	record( CMD_DISABLE, cap );
+}
+
+void RendererNull::enable( unsigned int cap ) {
+	if ( GL_BLEND == cap ) {
+		if ( mBlendEnabled )
+			return;
+
+		mBlendEnabled = true;
+	}
+
+	record( CMD_ENABLE, cap );
+}
+
+void RendererNull::pushMatrix() {
+	record( CMD_PUSH_MATRIX, mCurrentMode );
+
+	mStack->mCurMatrix->push( mStack->mCurMatrix->top() );
+}
+
+void RendererNull::popMatrix() {
+	record( CMD_POP_MATRIX, mCurrentMode );
+
+	if ( mStack->mCurMatrix->size() > 1 )
+		mStack->mCurMatrix->pop();
+}
+
+void RendererNull::loadIdentity() {
+	record( CMD_LOAD_MATRIX, mCurrentMode );
+
+	mStack->mCurMatrix->top() = glm::mat4(1.0);
+}
+
+void RendererNull::translatef( float x, float y, float z ) {
+	recordValues( CMD_MULT_MATRIX, x, y, z );
+
+	mStack->mCurMatrix->top() *= glm::translate( glm::vec3( x, y, z ) );
+}
+
+void RendererNull::rotatef( float angle, float x, float y, float z ) {
+	recordValues( CMD_MULT_MATRIX, angle, x, y, z );
+
+	mStack->mCurMatrix->top() *= glm::rotate( angle, glm::vec3( x, y, z ) );
+}
+
+void RendererNull::scalef( float x, float y, float z ) {
+	recordValues( CMD_MULT_MATRIX, x, y, z );
+
+	mStack->mCurMatrix->top() *= glm::scale( glm::vec3( x, y, z ) );
+}
+
+void RendererNull::matrixMode( unsigned int mode ) {
+	record( CMD_MATRIX_MODE, mode );
+
+	mCurrentMode = mode;
+
+	switch ( mCurrentMode ) {
+		case GL_PROJECTION:
+		case GL_PROJECTION_MATRIX:
+		{
+			mStack->mCurMatrix = &mStack->mProjectionMatrix;
+			break;
+		}
+		case GL_MODELVIEW:
+		case GL_MODELVIEW_MATRIX:
+		{
+			mStack->mCurMatrix = &mStack->mModelViewMatrix;
+			break;
+		}
+	}
+}
+
+void RendererNull::ortho( float left, float right, float bottom, float top, float zNear, float zFar ) {
+	recordValues( CMD_MULT_MATRIX, left, right, bottom, top );
+
+	mStack->mCurMatrix->top() *= glm::ortho( left, right, bottom, top , zNear, zFar );
+}
+
+void RendererNull::lookAt( float eyeX, float eyeY, float eyeZ, float centerX, float centerY, float centerZ, float upX, float upY, float upZ ) {
+	recordValues( CMD_MULT_MATRIX, eyeX, eyeY, eyeZ );
+
+	mStack->mCurMatrix->top() *= glm::lookAt( glm::vec3(eyeX, eyeY, eyeZ), glm::vec3(centerX, centerY, centerZ), glm::vec3(upX, upY, upZ) );
+}
+
+void RendererNull::perspective( float fovy, float aspect, float zNear, float zFar ) {
+	recordValues( CMD_MULT_MATRIX, fovy, aspect, zNear, zFar );
+
+	mStack->mCurMatrix->top() *= glm::perspective( fovy, aspect, zNear, zFar );
+}
+
+void RendererNull::enableClientState( unsigned int array ) {
+	record( CMD_CLIENT_STATE, array, 1 );
+}
+
+void RendererNull::disableClientState( unsigned int array ) {
+	record( CMD_CLIENT_STATE, array, 0 );
+}
+
+void RendererNull::vertexPointer( int size, unsigned int type, int stride, const void * pointer, unsigned int allocate ) {
+	recordPointer( CMD_VERTEX_POINTER, size, type, stride, allocate );
+}
+
+void RendererNull::colorPointer( int size, unsigned int type, int stride, const void * pointer, unsigned int allocate ) {
+	recordPointer( CMD_COLOR_POINTER, size, type, stride, allocate );
+}
+
+void RendererNull::texCoordPointer( int size, unsigned int type, int stride, const void * pointer, unsigned int allocate ) {
+	recordPointer( CMD_TEXCOORD_POINTER, size, type, stride, allocate );
+}
+
+void RendererNull::setShader( ShaderProgram * Shader ) {
+	record( CMD_SET_SHADER, NULL != Shader ? Shader->getHandler() : 0 );
+}
+
+void RendererNull::clip2DPlaneEnable( const Int32& x, const Int32& y, const Int32& Width, const Int32& Height ) {
+	record( CMD_CLIP_PLANE, x, y, Width, Height );
+}
+
+void RendererNull::clip2DPlaneDisable() {
+	record( CMD_CLIP_PLANE );
+}
+
+void RendererNull::multMatrixf( const float * m ) {
+	record( CMD_MULT_MATRIX, mCurrentMode ).Bytes = sizeof(float) * 16;
+
+	mStack->mCurMatrix->top() *= toGLMmat4( m );
+}
+
+void RendererNull::clipPlane( unsigned int plane, const double * equation ) {
+	Command& cmd = record( CMD_CLIP_PLANE, plane );
+	cmd.Value[0] = equation[0];
+	cmd.Value[1] = equation[1];
+	cmd.Value[2] = equation[2];
+	cmd.Value[3] = equation[3];
+}
+
+void RendererNull::texEnvi( unsigned int target, unsigned int pname, int param ) {
+	record( CMD_TEX_ENV, target, pname, param );
+}
+
+void RendererNull::loadMatrixf( const float * m ) {
+	record( CMD_LOAD_MATRIX, mCurrentMode ).Bytes = sizeof(float) * 16;
+
+	mStack->mCurMatrix->top() = toGLMmat4( m );
+}
+
+void RendererNull::frustum( float left, float right, float bottom, float top, float near_val, float far_val ) {
+	recordValues( CMD_MULT_MATRIX, left, right, bottom, top );
+
+	mStack->mCurMatrix->top() *= glm::frustum( left, right, bottom, top, near_val, far_val );
+}
+
+void RendererNull::getCurrentMatrix( unsigned int mode, float * m ) {
+	switch ( mode ) {
+		case GL_PROJECTION:
+		case GL_PROJECTION_MATRIX:
+		{
+			fromGLMmat4( mStack->mProjectionMatrix.top(), m );
+			break;
+		}
+		case GL_MODELVIEW:
+		case GL_MODELVIEW_MATRIX:
+		{
+			fromGLMmat4( mStack->mModelViewMatrix.top(), m );
+			break;
+		}
+	}
+}
+
+unsigned int RendererNull::getCurrentMatrixMode() {
+	return mCurrentMode;
+}
+
+int RendererNull::project( float objx, float objy, float objz, const float modelMatrix[16], const float projMatrix[16], const int viewport[4], float *winx, float *winy, float *winz ) {
+	glm::vec3 tv3( glm::project( glm::vec3( objx, objy, objz ), toGLMmat4( modelMatrix ), toGLMmat4( projMatrix ), glm::vec4( viewport[0], viewport[1], viewport[2], viewport[3] ) ) );
+
+	if ( NULL != winx )
+		*winx = tv3.x;
+
+	if ( NULL != winy )
+		*winy = tv3.y;
+
+	if ( NULL != winz )
+		*winz = tv3.z;
+
+	return GL_TRUE;
+}
+
+int RendererNull::unProject( float winx, float winy, float winz, const float modelMatrix[16], const float projMatrix[16], const int viewport[4], float *objx, float *objy, float *objz ) {
+	glm::vec3 tv3( glm::unProject( glm::vec3( winx, winy, winz ), toGLMmat4( modelMatrix ), toGLMmat4( projMatrix ), glm::vec4( viewport[0], viewport[1], viewport[2], viewport[3] ) ) );
+
+	if ( NULL != objx )
+		*objx = tv3.x;
+
+	if ( NULL != objy )
+		*objy = tv3.y;
+
+	if ( NULL != objz )
+		*objz = tv3.z;
+
+	return GL_TRUE;
+}
+
+void RendererNull::stencilFunc( unsigned int func, int ref, unsigned int mask ) {
+	record( CMD_STENCIL, func, ref, mask );
+}
+
+void RendererNull::stencilOp( unsigned int fail, unsigned int zfail, unsigned int zpass ) {
+	record( CMD_STENCIL, fail, zfail, zpass );
+}
+
+void RendererNull::stencilMask( unsigned int mask ) {
+	record( CMD_STENCIL, mask );
+}
+
+void RendererNull::colorMask( Uint8 red, Uint8 green, Uint8 blue, Uint8 alpha ) {
+	record( CMD_COLOR_MASK, red, green, blue, alpha );
+}
+
+void RendererNull::bindVertexArray( unsigned int array ) {
+	if ( mCurVAO != array ) {
+		record( CMD_BIND_VERTEX_ARRAY, array );
+
+		mCurVAO = array;
+	}
+}
+
+void RendererNull::deleteVertexArrays( int n, const unsigned int * arrays ) {
+}
+
+void RendererNull::genVertexArrays( int n, unsigned int * arrays ) {
+	genIds( n, arrays );
+}
+
+void RendererNull::genFramebuffers( int n, unsigned int * framebuffers ) {
+	genIds( n, framebuffers );
+}
+
+void RendererNull::deleteFramebuffers( int n, const unsigned int * framebuffers ) {
+}
+
+void RendererNull::bindFramebuffer( unsigned int target, unsigned int framebuffer ) {
+	record( CMD_BIND_FRAMEBUFFER, target, framebuffer );
+
+	mFramebuffer = framebuffer;
+}
+
+void RendererNull::framebufferTexture2D( unsigned int target, unsigned int attachment, unsigned int textarget, unsigned int texture, int level ) {
+}
+
+void RendererNull::genRenderbuffers( int n, unsigned int * renderbuffers ) {
+	genIds( n, renderbuffers );
+}
+
+void RendererNull::deleteRenderbuffers( int n, const unsigned int * renderbuffers ) {
+}
+
+void RendererNull::bindRenderbuffer( unsigned int target, unsigned int renderbuffer ) {
+	mRenderbuffer = renderbuffer;
+}
+
+void RendererNull::renderbufferStorage( unsigned int target, unsigned int internalformat, int width, int height ) {
+}
+
+void RendererNull::framebufferRenderbuffer( unsigned int target, unsigned int attachment, unsigned int renderbuffertarget, unsigned int renderbuffer ) {
+}
+
+unsigned int RendererNull::checkFramebufferStatus( unsigned int target ) {
+	return GL_FRAMEBUFFER_COMPLETE;
+}
+
+}}
@@ -3,8 +3,6 @@
 
 #include <eepp/graphics/renderer/base.hpp>
 
-#ifdef EE_GL3_ENABLED
-
 #include <stack>
 #include <eepp/helper/glm/gtx/transform.hpp>
 
@@ -33,5 +31,3 @@ class MatrixStack
 using namespace EE::Graphics::Private;
 
 #endif
-
-#endif
@@ -0,0 +1,370 @@
+#include <eepp/graphics/renderer/openglext.hpp>
+#include <eepp/graphics/renderer/vertexstreambuffer.hpp>
+#include <eepp/graphics/renderer/renderer.hpp>
+
+namespace EE { namespace Graphics {
+
+// The regions are aligned to keep the vertex attributes aligned
+static const unsigned int VERTEX_STREAM_ALIGNMENT = 16;
+
+static unsigned int alignSize( unsigned int size ) {
+	return ( size + VERTEX_STREAM_ALIGNMENT - 1 ) & ~( VERTEX_STREAM_ALIGNMENT - 1 );
+}
+
+VertexStreamBuffer::Stats::Stats() {
+	reset();
+}
+
+void VertexStreamBuffer::Stats::reset() {
+	BytesUploaded	= 0;
+	Uploads			= 0;
+	Orphans			= 0;
+	Waits			= 0;
+}
+
+VertexStreamBuffer::VertexStreamBuffer( unsigned int target, unsigned int size ) :
+	mTarget( target ),
+	mHandle( 0 ),
+	mSize( 0 ),
+	mHead( 0 ),
+	mMode( SubData ),
+	mPersistentData( NULL ),
+	mSegment( 0 ),
+	mMapData( NULL ),
+	mMapSize( 0 ),
+	mMapOffset( 0 ),
+	mMappedBase( NULL ),
+	mMappedSize( 0 ),
+	mMappedOffset( 0 ),
+	mClientBase( NULL ),
+	mClientSize( 0 ),
+	mClientOffset( 0 )
+{
+	for ( Uint32 i = 0; i < SEGMENTS; i++ )
+		mFences[i] = NULL;
+
+	#ifdef EE_GLEW_AVAILABLE
+	if ( GLi->isExtension( EEGL_ARB_buffer_storage ) ) {
+		mMode = Persistent;
+	} else if ( GLi->isExtension( EEGL_ARB_map_buffer_range ) ) {
+		mMode = Mapped;
+	}
+	#endif
+
+	create( size );
+}
+
+VertexStreamBuffer::~VertexStreamBuffer() {
+	destroy();
+	releaseRetired( true );
+}
+
+const VertexStreamBuffer::StreamMode& VertexStreamBuffer::getMode() const {
+	return mMode;
+}
+
+const unsigned int& VertexStreamBuffer::getHandle() const {
+	return mHandle;
+}
+
+const unsigned int& VertexStreamBuffer::getSize() const {
+	return mSize;
+}
+
+void VertexStreamBuffer::create( unsigned int size ) {
+	destroy();
+
+	// Every segment must have the same size
+	mSize		= alignSize( ( size + SEGMENTS - 1 ) / SEGMENTS ) * SEGMENTS;
+	mHead		= 0;
+	mSegment	= 0;
+
+	glGenBuffersARB( 1, &mHandle );
+	glBindBufferARB( mTarget, mHandle );
+
+	#ifdef EE_GLEW_AVAILABLE
+	if ( Persistent == mMode ) {
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+		glBufferStorage( mTarget, mSize, NULL, flags );
+
+		mPersistentData = reinterpret_cast<Uint8*>( glMapBufferRange( mTarget, 0, mSize, flags ) );
+
+		if ( NULL != mPersistentData )
+			return;
+
+		// The buffer storage is immutable, a new buffer is needed to stream it with the other modes
+		glDeleteBuffersARB( 1, &mHandle );
+		glGenBuffersARB( 1, &mHandle );
+		glBindBufferARB( mTarget, mHandle );
+
+		mMode = GLi->isExtension( EEGL_ARB_map_buffer_range ) ? Mapped : SubData;
+	}
+	#endif
+
+	glBufferDataARB( mTarget, mSize, NULL, GL_STREAM_DRAW );
+}
+
+void VertexStreamBuffer::destroy() {
+	#ifdef EE_GLEW_AVAILABLE
+	for ( Uint32 i = 0; i < SEGMENTS; i++ ) {
+		if ( NULL != mFences[i] ) {
+			glDeleteSync( reinterpret_cast<GLsync>( mFences[i] ) );
+			mFences[i] = NULL;
+		}
+	}
+
+	if ( NULL != mPersistentData ) {
+		glBindBufferARB( mTarget, mHandle );
+		glUnmapBuffer( mTarget );
+		mPersistentData = NULL;
+	}
+	#endif
+
+	if ( 0 != mHandle ) {
+		glDeleteBuffersARB( 1, &mHandle );
+		mHandle = 0;
+	}
+
+	releaseMapped();
+	invalidate();
+}
+
+void VertexStreamBuffer::grow( unsigned int size ) {
+	#ifdef EE_GLEW_AVAILABLE
+	if ( Persistent == mMode && 0 != mHandle ) {
+		// The regions handed out can still be pending, the buffer is deleted after the GPU finishes the commands issued until now
+		RetiredBuffer retired;
+		retired.Handle	= mHandle;
+		retired.Fence	= glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+
+		mRetired.push_back( retired );
+
+		// The segment fences are covered by the new one
+		for ( Uint32 i = 0; i < SEGMENTS; i++ ) {
+			if ( NULL != mFences[i] ) {
+				glDeleteSync( reinterpret_cast<GLsync>( mFences[i] ) );
+				mFences[i] = NULL;
+			}
+		}
+
+		glBindBufferARB( mTarget, mHandle );
+		glUnmapBuffer( mTarget );
+
+		mPersistentData	= NULL;
+		mHandle			= 0;
+	}
+	#endif
+
+	create( size );
+
+	mStats.Orphans++;
+}
+
+void VertexStreamBuffer::releaseRetired( bool force ) {
+	#ifdef EE_GLEW_AVAILABLE
+	for ( size_t i = 0; i < mRetired.size(); ) {
+		GLsync fence = reinterpret_cast<GLsync>( mRetired[i].Fence );
+
+		if ( force || NULL == fence || GL_TIMEOUT_EXPIRED != glClientWaitSync( fence, 0, 0 ) ) {
+			if ( NULL != fence )
+				glDeleteSync( fence );
+
+			glDeleteBuffersARB( 1, &mRetired[i].Handle );
+
+			mRetired[i] = mRetired.back();
+			mRetired.pop_back();
+		} else {
+			i++;
+		}
+	}
+	#endif
+}
+
+void VertexStreamBuffer::bind() {
+	glBindBufferARB( mTarget, mHandle );
+}
+
+void VertexStreamBuffer::waitSegment( unsigned int segment ) {
+	#ifdef EE_GLEW_AVAILABLE
+	if ( NULL != mFences[ segment ] ) {
+		GLsync fence = reinterpret_cast<GLsync>( mFences[ segment ] );
+
+		if ( GL_TIMEOUT_EXPIRED == glClientWaitSync( fence, 0, 0 ) ) {
+			mStats.Waits++;
+
+			while ( GL_TIMEOUT_EXPIRED == glClientWaitSync( fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000 ) );
+		}
+
+		glDeleteSync( fence );
+		mFences[ segment ] = NULL;
+	}
+	#endif
+}
+
+unsigned int VertexStreamBuffer::reserve( unsigned int size ) {
+	size = alignSize( size );
+
+	if ( Persistent == mMode ) {
+		unsigned int segmentSize = mSize / SEGMENTS;
+
+		if ( size > segmentSize ) {
+			grow( eemax( mSize * 2, size * SEGMENTS ) );
+
+			// The buffer could have been recreated with other mode
+			if ( Persistent != mMode )
+				return reserve( size );
+
+			segmentSize = mSize / SEGMENTS;
+		}
+
+		if ( mHead + size > ( mSegment + 1 ) * segmentSize ) {
+			#ifdef EE_GLEW_AVAILABLE
+			// The GPU will release the current segment when it finishes the commands issued until now
+			mFences[ mSegment ] = glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+			#endif
+
+			mSegment = ( mSegment + 1 ) % SEGMENTS;
+			mHead = mSegment * segmentSize;
+
+			waitSegment( mSegment );
+		}
+	} else {
+		if ( size > mSize ) {
+			create( eemax( mSize * 2, size ) );
+			mStats.Orphans++;
+		} else if ( mHead + size > mSize ) {
+			// Orphan the buffer: the driver keeps the old storage until the GPU finishes using it
+			bind();
+			glBufferDataARB( mTarget, mSize, NULL, GL_STREAM_DRAW );
+			mHead = 0;
+			mStats.Orphans++;
+		}
+	}
+
+	unsigned int offset = mHead;
+
+	mHead += size;
+
+	return offset;
+}
+
+void * VertexStreamBuffer::map( unsigned int size ) {
+	eeASSERT( NULL == mMapData );
+
+	releaseMapped();
+
+	mMapOffset	= reserve( size );
+	mMapSize	= size;
+
+	bind();
+
+	mStats.Uploads++;
+	mStats.BytesUploaded += size;
+
+	#ifdef EE_GLEW_AVAILABLE
+	if ( Persistent == mMode ) {
+		mMapData = mPersistentData + mMapOffset;
+
+		return mMapData;
+	} else if ( Mapped == mMode ) {
+		mMapData = reinterpret_cast<Uint8*>( glMapBufferRange( mTarget, mMapOffset, size, GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT ) );
+
+		if ( NULL != mMapData )
+			return mMapData;
+
+		mMode = SubData;
+	}
+	#endif
+
+	if ( mStaging.size() < size )
+		mStaging.resize( size );
+
+	mMapData = &mStaging[0];
+
+	return mMapData;
+}
+
+unsigned int VertexStreamBuffer::unmap() {
+	eeASSERT( NULL != mMapData );
+
+	bind();
+
+	if ( Mapped == mMode ) {
+		#ifdef EE_GLEW_AVAILABLE
+		glUnmapBuffer( mTarget );
+		#endif
+	} else if ( SubData == mMode ) {
+		glBufferSubDataARB( mTarget, mMapOffset, mMapSize, mMapData );
+	}
+
+	mMappedBase		= mMapData;
+	mMappedSize		= mMapSize;
+	mMappedOffset	= mMapOffset;
+	mMapData		= NULL;
+
+	return mMapOffset;
+}
+
+unsigned int VertexStreamBuffer::upload( const void * data, unsigned int size ) {
+	unsigned int offset = reserve( size );
+
+	bind();
+
+	if ( Persistent == mMode ) {
+		memcpy( mPersistentData + offset, data, size );
+	} else {
+		glBufferSubDataARB( mTarget, offset, size, data );
+	}
+
+	mClientBase		= reinterpret_cast<const Uint8*>( data );
+	mClientSize		= size;
+	mClientOffset	= offset;
+
+	mStats.Uploads++;
+	mStats.BytesUploaded += size;
+
+	return offset;
+}
+
+bool VertexStreamBuffer::findOffset( const void * pointer, unsigned int& offset ) const {
+	const Uint8 * ptr = reinterpret_cast<const Uint8*>( pointer );
+
+	if ( NULL != mMappedBase && ptr >= mMappedBase && ptr < mMappedBase + mMappedSize ) {
+		offset = mMappedOffset + (unsigned int)( ptr - mMappedBase );
+		return true;
+	}
+
+	if ( NULL != mClientBase && ptr >= mClientBase && ptr < mClientBase + mClientSize ) {
+		offset = mClientOffset + (unsigned int)( ptr - mClientBase );
+		return true;
+	}
+
+	return false;
+}
+
+void VertexStreamBuffer::invalidate() {
+	mClientBase = NULL;
+}
+
+void VertexStreamBuffer::releaseMapped() {
+	mMappedBase	= NULL;
+	mMappedSize	= 0;
+}
+
+void VertexStreamBuffer::endFrame() {
+	releaseRetired( false );
+
+	mFrameStats = mStats;
+	mStats.reset();
+}
+
+const VertexStreamBuffer::Stats& VertexStreamBuffer::getStats() const {
+	return mStats;
+}
+
+const VertexStreamBuffer::Stats& VertexStreamBuffer::getFrameStats() const {
+	return mFrameStats;
+}
+
+}}
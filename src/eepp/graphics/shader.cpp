@@ -39,7 +39,7 @@ Shader::Shader( const Uint32& Type, const std::string& Filename ) {
 		if ( PackManager::instance()->isFallbackToPacksActive() && NULL != ( tPack = PackManager::instance()->exists( tPath ) ) ) {
 			SafeDataPointer PData;
 
-			tPack->extractFileToMemory( tPath, PData );
+			tPack->getFileView( tPath, PData );
 
 			setSource( reinterpret_cast<char*> ( PData.Data ), PData.DataSize );
 		} else {
@@ -66,7 +66,7 @@ Shader::Shader( const Uint32& Type, Pack * Pack, const std::string& Filename ) {
 	mFilename = FileSystem::fileNameFromPath( Filename );
 
 	if ( NULL != Pack && Pack->isOpen() && -1 != Pack->exists( Filename ) ) {
-		Pack->extractFileToMemory( Filename, PData );
+		Pack->getFileView( Filename, PData );
 
 		setSource( reinterpret_cast<char*> ( PData.Data ), PData.DataSize );
 	}
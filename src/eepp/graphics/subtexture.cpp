@@ -1,5 +1,6 @@
 #include <eepp/graphics/subtexture.hpp>
 #include <eepp/graphics/texturefactory.hpp>
+#include <eepp/graphics/imagekernels.hpp>
 #include <eepp/graphics/renderer/renderer.hpp>
 #include <eepp/helper/SOIL2/src/SOIL2/SOIL2.h>
 #include <eepp/helper/jpeg-compressor/jpge.h>
@@ -9,6 +10,13 @@ using namespace EE::Graphics::Private;
 
 namespace EE { namespace Graphics {
 
+PoolAllocator& SubTexture::getAllocator() {
+	// Never destroyed, the sub textures can be released by static destructors running after the pool would be destroyed
+	static PoolAllocator * sAllocator = new PoolAllocator( sizeof(SubTexture), 256 );
+
+	return *sAllocator;
+}
+
 SubTexture::SubTexture() :
 	DrawableResource( DRAWABLE_SUBTEXTURE ),
 	mPixels(NULL),
@@ -161,13 +169,14 @@ Graphics::Texture * SubTexture::getTexture() {
 }
 
 void SubTexture::replaceColor( Color ColorKey, Color NewColor ) {
-	mTexture->lock();
+	Uint8 * pixels = mTexture->lock();
 
-	for ( int y = mSrcRect.Top; y < mSrcRect.Bottom; y++ ) {
-		for ( int x = mSrcRect.Left; x < mSrcRect.Right; x++ ) {
-			if ( mTexture->getPixel( x, y ) == ColorKey )
-				mTexture->setPixel( x, y, NewColor );
-		}
+	if ( NULL != pixels ) {
+		Uint32 channels = mTexture->getChannels();
+		Uint32 width = mTexture->getWidth();
+
+		for ( int y = mSrcRect.Top; y < mSrcRect.Bottom; y++ )
+			ImageKernels::replaceColor( &pixels[ ( mSrcRect.Left + y * width ) * channels ], mSrcRect.Right - mSrcRect.Left, channels, ColorKey, NewColor );
 	}
 
 	mTexture->unlock( false, true );
@@ -187,20 +196,16 @@ void SubTexture::cacheAlphaMask() {
 	eeSAFE_DELETE_ARRAY( mAlphaMask );
 	mAlphaMask = eeNewArray( Uint8, size );
 
-	mTexture->lock();
+	Uint8 * pixels = mTexture->lock();
 
-	int rY = 0;
-	int rX = 0;
 	int rW = mSrcRect.Right - mSrcRect.Left;
 
-	for ( int y = mSrcRect.Top; y < mSrcRect.Bottom; y++ ) {
-		rY = y - mSrcRect.Top;
-
-		for ( int x = mSrcRect.Left; x < mSrcRect.Right; x++ ) {
-			rX = x - mSrcRect.Left;
-
-			mAlphaMask[ rX + rY * rW ] = mTexture->getPixel( x, y ).a;
-		}
+	if ( NULL != pixels && 4 == mTexture->getChannels() ) {
+		for ( int y = mSrcRect.Top; y < mSrcRect.Bottom; y++ )
+			ImageKernels::extractAlpha( &mAlphaMask[ ( y - mSrcRect.Top ) * rW ], &pixels[ ( mSrcRect.Left + y * mTexture->getWidth() ) * 4 ], rW );
+	} else {
+		// The textures without alpha channel are opaque
+		memset( mAlphaMask, 255, size );
 	}
 
 	mTexture->unlock();
@@ -18,12 +18,7 @@ Text::Text() :
 	mFillColor(255, 255, 255, 255),
 	mOutlineColor(0, 0, 0, 255),
 	mOutlineThickness (0),
-	mGeometryNeedUpdate(false),
-	mCachedWidthNeedUpdate(false),
 	mColorsNeedUpdate(false),
-	mCachedWidth(0),
-	mNumLines(0),
-	mLargestLineCharCount(0),
 	mFontShadowColor( Color( 0, 0, 0, 255 ) ),
 	mAlign(0),
 	mFontHeight(0)
@@ -39,16 +34,12 @@ Text::Text(const String& string, Font * font, unsigned int characterSize) :
 	mFillColor(255, 255, 255, 255),
 	mOutlineColor(0, 0, 0, 255),
 	mOutlineThickness(0),
-	mGeometryNeedUpdate(true),
-	mCachedWidthNeedUpdate(true),
 	mColorsNeedUpdate(true),
-	mCachedWidth(0),
-	mNumLines(0),
-	mLargestLineCharCount(0),
 	mFontShadowColor( Color( 0, 0, 0, 255 ) ),
 	mAlign(0),
 	mFontHeight( mFont->getFontHeight( mRealCharacterSize ) )
 {
+	updateLayoutFont();
 }
 
 Text::Text(Font * font, unsigned int characterSize) :
@@ -59,16 +50,12 @@ Text::Text(Font * font, unsigned int characterSize) :
 	mFillColor(255, 255, 255, 255),
 	mOutlineColor(0, 0, 0, 255),
 	mOutlineThickness(0),
-	mGeometryNeedUpdate(true),
-	mCachedWidthNeedUpdate(true),
 	mColorsNeedUpdate(true),
-	mCachedWidth(0),
-	mNumLines(0),
-	mLargestLineCharCount(0),
 	mFontShadowColor( Color( 0, 0, 0, 255 ) ),
 	mAlign(0),
 	mFontHeight( mFont->getFontHeight( mRealCharacterSize ) )
 {
+	updateLayoutFont();
 }
 
 void Text::create(Font * font, const String & text, Color FontColor, Color FontShadowColor, Uint32 characterSize ) {
@@ -78,19 +65,29 @@ void Text::create(Font * font, const String & text, Color FontColor, Color FontS
 	mRealCharacterSize = PixelDensity::dpToPxI(mCharacterSize);
 	setFillColor( FontColor );
 	setShadowColor( FontShadowColor );
-	mGeometryNeedUpdate = true;
-	mCachedWidthNeedUpdate = true;
+	updateLayoutFont();
+	mLayout.invalidate();
 	mColorsNeedUpdate = true;
 	ensureColorUpdate();
-	ensureGeometryUpdate();
 }
 
 void Text::setString(const String& string) {
 	if (mString != string) {
+		// Find the range of characters that changed, so only the lines that contain it are laid out again
+		std::size_t oldSize = mString.size();
+		std::size_t newSize = string.size();
+		std::size_t prefix = 0;
+		std::size_t suffix = 0;
+
+		while ( prefix < oldSize && prefix < newSize && mString[prefix] == string[prefix] )
+			prefix++;
+
+		while ( suffix < oldSize - prefix && suffix < newSize - prefix && mString[oldSize - 1 - suffix] == string[newSize - 1 - suffix] )
+			suffix++;
+
 		mString = string;
+		mLayout.replace( mString, prefix, oldSize - prefix - suffix, newSize - prefix - suffix );
 		mColorsNeedUpdate = true;
-		mGeometryNeedUpdate = true;
-		mCachedWidthNeedUpdate = true;
 	}
 }
 
@@ -101,8 +98,7 @@ void Text::setFont(Font * font) {
 		mRealCharacterSize = PixelDensity::dpToPxI( mCharacterSize );
 		mFontHeight = mFont->getFontHeight( mRealCharacterSize );
 
-		mGeometryNeedUpdate = true;
-		mCachedWidthNeedUpdate = true;
+		updateLayoutFont();
 	}
 }
 
@@ -113,8 +109,7 @@ void Text::setCharacterSize(unsigned int size) {
 		mRealCharacterSize = PixelDensity::dpToPxI( mCharacterSize );
 		mFontHeight = mFont->getFontHeight( mRealCharacterSize );
 
-		mGeometryNeedUpdate = true;
-		mCachedWidthNeedUpdate = true;
+		updateLayoutFont();
 	}
 }
 
@@ -122,8 +117,7 @@ void Text::setStyle(Uint32 style) {
 	if (mStyle != style) {
 		mStyle = style;
 		mColorsNeedUpdate = true;
-		mGeometryNeedUpdate = true;
-		mCachedWidthNeedUpdate = true;
+		updateLayoutFont();
 	}
 }
 
@@ -149,8 +143,7 @@ void Text::setOutlineThickness(Float thickness) {
 	if (thickness != mOutlineThickness) {
 		mOutlineThickness = thickness;
 		mColorsNeedUpdate = true;
-		mGeometryNeedUpdate = true;
-		mCachedWidthNeedUpdate = true;
+		updateLayoutFont();
 	}
 }
 
@@ -207,101 +200,18 @@ Vector2f Text::findCharacterPos(std::size_t index) const {
 	if (!mFont)
 		return Vector2f();
 
-	// Adjust the index if it's out of range
-	if (index > mString.size())
-		index = mString.size();
-
-	// Precompute the variables needed by the algorithm
-	bool  bold   = (mStyle & Bold) != 0;
-	Float hspace = static_cast<Float>(mFont->getGlyph(L' ', mRealCharacterSize, bold).advance);
-	Float vspace = static_cast<Float>(mFont->getLineSpacing(mRealCharacterSize));
-
-	// Compute the position
-	Vector2f position;
-	Uint32 prevChar = 0;
-	for (std::size_t i = 0; i < index; ++i) {
-		Uint32 curChar = mString[i];
-
-		// Apply the kerning offset
-		position.x += static_cast<Float>(mFont->getKerning(prevChar, curChar, mRealCharacterSize));
-		prevChar = curChar;
-
-		// Handle special characters
-		switch (curChar)
-		{
-			case ' ':  position.x += hspace;				 continue;
-			case '\t': position.x += hspace * 4;			 continue;
-			case '\n': position.y += vspace; position.x = 0; continue;
-			case '\r': continue;
-		}
-
-		// For regular characters, add the advance offset of the glyph
-		position.x += static_cast<Float>(mFont->getGlyph(curChar, mRealCharacterSize, bold).advance);
-	}
+	ensureGeometryUpdate();
 
-	return position;
+	return mLayout.findCharacterPos( index );
 }
 
 Int32 Text::findCharacterFromPos( const Vector2i& pos ) {
 	if ( NULL == mFont )
 		return 0;
 
-	Float vspace = mFont->getLineSpacing(mRealCharacterSize);
-	Float Width = 0, lWidth = 0, Height = vspace, lHeight = 0;
-	Uint32 CharID;
-	Uint32 prevChar = 0;
-	std::size_t tSize = mString.size();
-	bool  bold = (mStyle & Bold) != 0;
-
-	for (std::size_t i = 0; i < tSize; ++i) {
-		CharID = mString[i];
-		Glyph glyph = mFont->getGlyph( CharID, mRealCharacterSize, bold, mOutlineThickness );
-
-		lWidth = Width;
-
-		if ( CharID != '\r' ) {
-			Width += mFont->getKerning(prevChar, CharID, mRealCharacterSize);
-			prevChar = CharID;
-			Width += glyph.advance;
-		}
-
-		if ( CharID == '\t' ) {
-			Width += glyph.advance * 3;
-		}
-
-		if ( CharID == '\n' ) {
-			lWidth = 0;
-			Width = 0;
-		}
-
-		if ( pos.x <= Width && pos.x >= lWidth && pos.y <= Height && pos.y >= lHeight ) {
-			if ( i + 1 < tSize ) {
-				Int32 curDist	= eeabs( pos.x - lWidth );
-				Int32 nextDist	= eeabs( pos.x - ( lWidth + glyph.advance ) );
-
-				if ( nextDist < curDist ) {
-					return  i + 1;
-				}
-			}
-
-			return i;
-		}
-
-		if ( CharID == '\n' ) {
-			lHeight = Height;
-			Height += vspace;
-
-			if ( pos.x > Width && pos.y <= lHeight ) {
-				return i;
-			}
-		}
-	}
-
-	if ( pos.x >= Width ) {
-		return tSize;
-	}
+	ensureGeometryUpdate();
 
-	return -1;
+	return mLayout.findCharacterFromPos( pos );
 }
 
 static bool isStopSelChar( Uint32 c ) {
@@ -347,56 +257,12 @@ void Text::getWidthInfo( std::vector<Float>& LinesWidth, Float& CachedWidth, int
 	if ( NULL == mFont )
 		return;
 
-	LinesWidth.clear();
-
-	Float Width = 0, MaxWidth = 0;
-	Uint32 CharID;
-	Int32 Lines = 1;
-	Int32 CharCount = 0;
-	Uint32 prevChar = 0;
-	LargestLineCharCount = 0;
-	bool bold = (mStyle & Bold) != 0;
-
-	for (std::size_t i = 0; i < mString.size(); ++i) {
-		CharID = static_cast<Int32>( mString.at(i) );
-		Glyph glyph = mFont->getGlyph( CharID, mRealCharacterSize, bold, mOutlineThickness );
-
-		if ( CharID != '\r' ) {
-			Width += mFont->getKerning(prevChar, CharID, mRealCharacterSize);
-			prevChar = CharID;
-			Width += glyph.advance;
-		}
-
-		CharCount++;
-
-		if ( CharID == '\t' )
-			Width += glyph.advance * 3;
-
-		if ( CharID == '\n' ) {
-			Lines++;
-
-			Float lWidth = ( CharID == '\t' ) ? glyph.advance * 4.f : glyph.advance;
-
-			LinesWidth.push_back( Width - lWidth );
-
-			Width = 0;
-
-			CharCount = 0;
-		} else {
-			if ( CharCount > LargestLineCharCount )
-				LargestLineCharCount = CharCount;
-		}
-
-		if ( Width > MaxWidth )
-			MaxWidth = Width;
-	}
-
-	if ( mString.size() && mString.at( mString.size() - 1 ) != '\n' ) {
-		LinesWidth.push_back( Width );
-	}
+	ensureGeometryUpdate();
 
-	CachedWidth = MaxWidth;
-	NumLines = Lines;
+	LinesWidth				= mLayout.getLinesWidth();
+	CachedWidth				= mLayout.getWidth();
+	NumLines				= mLayout.getNumLines();
+	LargestLineCharCount	= mLayout.getLargestLineCharCount();
 }
 
 void Text::shrinkText( const Uint32& MaxWidth ) {
@@ -469,35 +335,33 @@ void Text::shrinkText( const Uint32& MaxWidth ) {
 		}
 	}
 
-	mCachedWidthNeedUpdate = true;
-	mGeometryNeedUpdate = true;
+	mLayout.invalidate();
 	mColorsNeedUpdate = true;
 }
 
 Rectf Text::getLocalBounds() {
 	ensureGeometryUpdate();
 
-	return mBounds;
+	return mLayout.getBounds();
 }
 
 Float Text::getTextWidth() {
-	cacheWidth();
+	ensureGeometryUpdate();
 
-	return mCachedWidth;
+	return mLayout.getWidth();
 }
 
 Float Text::getTextHeight() {
-	cacheWidth();
+	ensureGeometryUpdate();
 
-	return mFont->getLineSpacing(mRealCharacterSize) * ( 0 == mNumLines ? 1 : mNumLines );
+	return mFont->getLineSpacing(mRealCharacterSize) * ( 0 == mLayout.getNumLines() ? 1 : mLayout.getNumLines() );
 }
 
 void Text::draw(const Float & X, const Float & Y, const Vector2f & Scale, const Float & Angle, EE_BLEND_MODE Effect) {
 	if ( NULL != mFont ) {
 		ensureColorUpdate();
-		ensureGeometryUpdate();
 
-		unsigned int numvert = mVertices.size();
+		unsigned int numvert = mLayout.getVertices().size();
 
 		if ( 0 == numvert )
 			return;
@@ -506,287 +370,97 @@ void Text::draw(const Float & X, const Float & Y, const Vector2f & Scale, const
 		TextureFactory::instance()->bind( mFont->getTexture(mRealCharacterSize) );
 		BlendMode::setMode( Effect );
 
+		// The shadow reuses the text quads, only the colors change
 		if ( mStyle & Shadow ) {
-			Uint32 f = mStyle;
-
-			mStyle &= ~Shadow;
-
-			Color Col = getFillColor();
-
-			if ( Col.a != 255 ) {
-				Color ShadowColor = getShadowColor();
-				ShadowColor.a = (Uint8)( (Float)ShadowColor.a * ( (Float)Col.a / (Float)255 ) );
+			Color ShadowColor = getShadowColor();
 
-				setFillColor( ShadowColor );
-			} else {
-				setFillColor( getShadowColor() );
-			}
+			if ( mFillColor.a != 255 )
+				ShadowColor.a = (Uint8)( (Float)ShadowColor.a * ( (Float)mFillColor.a / (Float)255 ) );
 
-			mColors.assign( mColors.size(), getFillColor() );
+			if ( mShadowColors.size() != numvert || mShadowColors[0] != ShadowColor )
+				mShadowColors.assign( numvert, ShadowColor );
 
 			Float pd = PixelDensity::dpToPx(1);
 
-			draw( X + pd, Y + pd, Scale, Angle, Effect );
-
-			mStyle = f;
-
-			setFillColor( Col );
-			mColors.assign( mColors.size(), getFillColor() );
+			drawVertices( X + pd, Y + pd, Scale, Angle, mShadowColors );
 		}
 
-		if ( Angle != 0.0f || Scale != 1.0f ) {
-			Float cX = (Float) ( (Int32)X );
-			Float cY = (Float) ( (Int32)Y );
+		drawVertices( X, Y, Scale, Angle, mColors );
+	}
+}
+
+void Text::drawVertices( const Float& X, const Float& Y, const Vector2f& Scale, const Float& Angle, const std::vector<Color>& colors ) {
+	const std::vector<VertexCoords>& vertices = mLayout.getVertices();
+	unsigned int numvert = vertices.size();
 
-			GLi->pushMatrix();
+	if ( Angle != 0.0f || Scale != 1.0f ) {
+		Float cX = (Float) ( (Int32)X );
+		Float cY = (Float) ( (Int32)Y );
 
-			Vector2f Center( cX + mCachedWidth * 0.5f, cY + getTextHeight() * 0.5f );
-			GLi->translatef( Center.x , Center.y, 0.f );
-			GLi->rotatef( Angle, 0.0f, 0.0f, 1.0f );
-			GLi->scalef( Scale.x, Scale.y, 1.0f );
-			GLi->translatef( -Center.x + X, -Center.y + Y, 0.f );
-		} else {
-			GLi->translatef( X, Y, 0 );
-		}
+		GLi->pushMatrix();
 
-		Uint32 alloc	= numvert * sizeof(VertexCoords);
-		Uint32 allocC	= numvert * GLi->quadVertexs();
+		Vector2f Center( cX + mLayout.getWidth() * 0.5f, cY + getTextHeight() * 0.5f );
+		GLi->translatef( Center.x , Center.y, 0.f );
+		GLi->rotatef( Angle, 0.0f, 0.0f, 1.0f );
+		GLi->scalef( Scale.x, Scale.y, 1.0f );
+		GLi->translatef( -Center.x + X, -Center.y + Y, 0.f );
+	} else {
+		GLi->translatef( X, Y, 0 );
+	}
 
-		if ( 0 != mOutlineThickness ) {
-			GLi->colorPointer	( 4, GL_UNSIGNED_BYTE	, 0						, reinterpret_cast<char*>( &mOutlineColors[0] )					, allocC	);
-			GLi->texCoordPointer( 2, GL_FP				, sizeof(VertexCoords), reinterpret_cast<char*>( &mOutlineVertices[0] )						, alloc		);
-			GLi->vertexPointer	( 2, GL_FP				, sizeof(VertexCoords), reinterpret_cast<char*>( &mOutlineVertices[0] ) + sizeof(Float) * 2	, alloc		);
+	Uint32 alloc	= numvert * sizeof(VertexCoords);
+	Uint32 allocC	= numvert * GLi->quadVertexs();
 
-			if ( GLi->quadsSupported() ) {
-				GLi->drawArrays( GL_QUADS, 0, numvert );
-			} else {
-				GLi->drawArrays( GL_TRIANGLES, 0, numvert );
-			}
-		}
+	if ( 0 != mOutlineThickness ) {
+		const std::vector<VertexCoords>& outlineVertices = mLayout.getOutlineVertices();
 
-		GLi->colorPointer	( 4, GL_UNSIGNED_BYTE	, 0						, reinterpret_cast<char*>( &mColors[0] )						, allocC	);
-		GLi->texCoordPointer( 2, GL_FP				, sizeof(VertexCoords), reinterpret_cast<char*>( &mVertices[0] )						, alloc		);
-		GLi->vertexPointer	( 2, GL_FP				, sizeof(VertexCoords), reinterpret_cast<char*>( &mVertices[0] ) + sizeof(Float) * 2	, alloc		);
+		GLi->colorPointer	( 4, GL_UNSIGNED_BYTE	, 0						, reinterpret_cast<const char*>( &mOutlineColors[0] )					, allocC	);
+		GLi->texCoordPointer( 2, GL_FP				, sizeof(VertexCoords), reinterpret_cast<const char*>( &outlineVertices[0] )						, alloc		);
+		GLi->vertexPointer	( 2, GL_FP				, sizeof(VertexCoords), reinterpret_cast<const char*>( &outlineVertices[0] ) + sizeof(Float) * 2	, alloc		);
 
 		if ( GLi->quadsSupported() ) {
 			GLi->drawArrays( GL_QUADS, 0, numvert );
 		} else {
 			GLi->drawArrays( GL_TRIANGLES, 0, numvert );
 		}
-
-		if ( Angle != 0.0f || Scale != 1.0f ) {
-			GLi->popMatrix();
-		} else {
-			GLi->translatef( -X, -Y, 0 );
-		}
 	}
-}
-
-void Text::ensureGeometryUpdate() {
-	cacheWidth();
-
-	Sizei textureSize = mFont->getTexture(mRealCharacterSize)->getPixelSize();
-
-	if ( textureSize != mTextureSize )
-		mGeometryNeedUpdate = true;
 
-	// Do nothing, if geometry has not changed
-	if (!mGeometryNeedUpdate)
-		return;
-
-	mTextureSize = textureSize;
-
-	// Mark geometry as updated
-	mGeometryNeedUpdate = false;
+	GLi->colorPointer	( 4, GL_UNSIGNED_BYTE	, 0						, reinterpret_cast<const char*>( &colors[0] )							, allocC	);
+	GLi->texCoordPointer( 2, GL_FP				, sizeof(VertexCoords), reinterpret_cast<const char*>( &vertices[0] )						, alloc		);
+	GLi->vertexPointer	( 2, GL_FP				, sizeof(VertexCoords), reinterpret_cast<const char*>( &vertices[0] ) + sizeof(Float) * 2	, alloc		);
 
-	// Clear the previous geometry
-	mVertices.clear();
-	mOutlineVertices.clear();
-	mBounds = Rectf();
-
-	// No font or text: nothing to draw
-	if (!mFont || mString.empty())
-		return;
-
-	// Compute values related to the text style
-	bool  bold			   = (mStyle & Bold) != 0;
-	bool  underlined		 = (mStyle & Underlined) != 0;
-	bool  strikeThrough	  = (mStyle & StrikeThrough) != 0;
-	Float italic			 = (mStyle & Italic) ? 0.208f : 0.f; // 12 degrees
-	Float underlineOffset	= mFont->getUnderlinePosition(mRealCharacterSize);
-	Float underlineThickness = mFont->getUnderlineThickness(mRealCharacterSize);
-
-	// Compute the location of the strike through dynamically
-	// We use the center point of the lowercase 'x' glyph as the reference
-	// We reuse the underline thickness as the thickness of the strike through as well
-	Rectf xBounds = mFont->getGlyph(L'x', mRealCharacterSize, bold).bounds;
-	Float strikeThroughOffset = xBounds.Top + xBounds.Bottom / 2.f;
-
-	// Precompute the variables needed by the algorithm
-	Float hspace = static_cast<Float>(mFont->getGlyph(L' ', mRealCharacterSize, bold).advance);
-	Float vspace = static_cast<Float>(mFont->getLineSpacing(mRealCharacterSize));
-	Float x	  = 0.f;
-	Float y	  = static_cast<Float>(mRealCharacterSize);
-
-	// Create one quad for each character
-	Float minX = static_cast<Float>(mRealCharacterSize);
-	Float minY = static_cast<Float>(mRealCharacterSize);
-	Float maxX = 0.f;
-	Float maxY = 0.f;
-	Uint32 prevChar = 0;
-
-	Float centerDiffX = 0;
-	unsigned int Line = 0;
-
-	switch ( fontHAlignGet( mAlign ) ) {
-		case TEXT_ALIGN_CENTER:
-			centerDiffX = (Float)( (Int32)( ( mCachedWidth - mLinesWidth[ Line ] ) * 0.5f ) );
-			Line++;
-			break;
-		case TEXT_ALIGN_RIGHT:
-			centerDiffX = mCachedWidth - mLinesWidth[ Line ];
-			Line++;
-			break;
-	}
-
-	for (std::size_t i = 0; i < mString.size(); ++i) {
-		Uint32 curChar = mString[i];
-
-		// Apply the kerning offset
-		x += mFont->getKerning(prevChar, curChar, mRealCharacterSize);
-		prevChar = curChar;
-
-		// If we're using the underlined style and there's a new line, draw a line
-		if (underlined && (curChar == L'\n')) {
-			addLine(mVertices, x, y, underlineOffset, underlineThickness, 0, textureSize, centerDiffX);
-
-			if (mOutlineThickness != 0)
-				addLine(mOutlineVertices, x, y, underlineOffset, underlineThickness, mOutlineThickness, textureSize, centerDiffX);
-		}
-
-		// If we're using the strike through style and there's a new line, draw a line across all characters
-		if (strikeThrough && (curChar == L'\n')) {
-			addLine(mVertices, x, y, strikeThroughOffset, underlineThickness, 0, textureSize, centerDiffX);
-
-			if (mOutlineThickness != 0)
-				addLine(mOutlineVertices, x, y, strikeThroughOffset, underlineThickness, mOutlineThickness, textureSize, centerDiffX);
-		}
-
-		if ( curChar == L'\n' ) {
-			switch ( fontHAlignGet( mAlign ) ) {
-				case TEXT_ALIGN_CENTER:
-					centerDiffX = (Float)( (Int32)( ( mCachedWidth - mLinesWidth[ Line ] ) * 0.5f ) );
-					break;
-				case TEXT_ALIGN_RIGHT:
-					centerDiffX = mCachedWidth - mLinesWidth[ Line ];
-					break;
-			}
-
-			Line++;
-		}
-
-		// Handle special characters
-		if ((curChar == ' ') || (curChar == '\t') || (curChar == '\n') || (curChar == '\r')) {
-			// Update the current bounds (min coordinates)
-			minX = std::min(minX, x);
-			minY = std::min(minY, y);
-
-			switch (curChar) {
-				case ' ':  x += hspace;		break;
-				case '\t': x += hspace * 4;	break;
-				case '\n': y += vspace; x = 0; break;
-				case '\r': break;
-			}
-
-			// Update the current bounds (max coordinates)
-			maxX = std::max(maxX, x);
-			maxY = std::max(maxY, y);
-
-			// Next glyph, no need to create a quad for whitespace
-			continue;
-		}
-
-		
-		// Apply the outline
-		if (mOutlineThickness != 0) {
-			const Glyph& glyph = mFont->getGlyph(curChar, mRealCharacterSize, bold, mOutlineThickness);
-
-			Float left   = glyph.bounds.Left;
-			Float top	= glyph.bounds.Top;
-			Float right  = glyph.bounds.Left + glyph.bounds.Right;
-			Float bottom = glyph.bounds.Top  + glyph.bounds.Bottom;
-
-			// Add the outline glyph to the vertices
-			addGlyphQuad(mOutlineVertices, Vector2f(x, y), glyph, italic, mOutlineThickness, textureSize, centerDiffX);
-
-			// Update the current bounds with the outlined glyph bounds
-			minX = std::min(minX, x + left   - italic * bottom - mOutlineThickness);
-			maxX = std::max(maxX, x + right  - italic * top	- mOutlineThickness);
-			minY = std::min(minY, y + top	- mOutlineThickness);
-			maxY = std::max(maxY, y + bottom - mOutlineThickness);
-		}
-
-		// Extract the current glyph's description
-		const Glyph& glyph = mFont->getGlyph(curChar, mRealCharacterSize, bold);
-
-		// Add the glyph to the vertices
-		addGlyphQuad(mVertices, Vector2f(x, y), glyph, italic, 0, textureSize, centerDiffX);
-
-		// Update the current bounds with the non outlined glyph bounds
-		if (mOutlineThickness == 0) {
-			Float left   = glyph.bounds.Left;
-			Float top	= glyph.bounds.Top;
-			Float right  = glyph.bounds.Left + glyph.bounds.Right;
-			Float bottom = glyph.bounds.Top  + glyph.bounds.Bottom;
-
-			minX = std::min(minX, x + left  - italic * bottom);
-			maxX = std::max(maxX, x + right - italic * top);
-			minY = std::min(minY, y + top);
-			maxY = std::max(maxY, y + bottom);
-		}
-
-		// Advance to the next character
-		x += glyph.advance;
+	if ( GLi->quadsSupported() ) {
+		GLi->drawArrays( GL_QUADS, 0, numvert );
+	} else {
+		GLi->drawArrays( GL_TRIANGLES, 0, numvert );
 	}
 
-	// If we're using the underlined style, add the last line
-	if (underlined && (x > 0)) {
-		addLine(mVertices, x, y, underlineOffset, underlineThickness, 0, textureSize, centerDiffX);
-
-		if (mOutlineThickness != 0)
-			addLine(mOutlineVertices, x, y, underlineOffset, underlineThickness, mOutlineThickness, textureSize, centerDiffX);
+	if ( Angle != 0.0f || Scale != 1.0f ) {
+		GLi->popMatrix();
+	} else {
+		GLi->translatef( -X, -Y, 0 );
 	}
+}
 
-	// If we're using the strike through style, add the last line across all characters
-	if (strikeThrough && (x > 0)) {
-		addLine(mVertices, x, y, strikeThroughOffset, underlineThickness, 0, textureSize, centerDiffX);
-
-		if (mOutlineThickness != 0)
-			addLine(mOutlineVertices, x, y, strikeThroughOffset, underlineThickness, mOutlineThickness, textureSize, centerDiffX);
-	}
+void Text::updateLayoutFont() {
+	mLayout.setFont( mFont, mRealCharacterSize, mStyle, mOutlineThickness );
+}
 
-	// Update the bounding rectangle
-	mBounds.Left = minX;
-	mBounds.Top = minY;
-	mBounds.Right = maxX - minX;
-	mBounds.Bottom = maxY - minY;
+void Text::ensureGeometryUpdate() const {
+	// Only lays out the lines that changed since the last update
+	mLayout.update( mString );
 }
 
 void Text::ensureColorUpdate() {
-	if ( mColorsNeedUpdate ) {
-		Uint32 tv = getTotalVertices();
+	ensureGeometryUpdate();
 
-		if ( mColors.size() < tv )
-			mColors.resize( tv, mFillColor );
+	Uint32 tv = mLayout.getVertices().size();
 
+	if ( mColorsNeedUpdate || mColors.size() != tv ) {
 		mColors.assign( tv, mFillColor );
 
-		if ( 0 != mOutlineThickness ) {
-			if ( mOutlineColors.size() < tv )
-				mOutlineColors.resize( tv, mOutlineColor );
-
+		if ( 0 != mOutlineThickness )
 			mOutlineColors.assign( tv, mOutlineColor );
-		}
 
 		mColorsNeedUpdate = false;
 	}
@@ -801,38 +475,30 @@ void Text::setShadowColor(const Color& color) {
 }
 
 const int& Text::getNumLines() {
-	cacheWidth();
+	ensureGeometryUpdate();
 
-	return mNumLines;
+	return mLayout.getNumLines();
 }
 
 const std::vector<Float>& Text::getLinesWidth() {
-	cacheWidth();
+	ensureGeometryUpdate();
 
-	return mLinesWidth;
+	return mLayout.getLinesWidth();
 }
 
 void Text::setAlign( const Uint32& align ) {
-	if ( mAlign != align ) {
-		mAlign = align;
-		mGeometryNeedUpdate = true;
-	}
+	mAlign = align;
+	mLayout.setAlign( align );
 }
 
 const Uint32& Text::getAlign() const {
 	return mAlign;
 }
 
-void Text::cacheWidth() {
-	if ( !mCachedWidthNeedUpdate )
-		return;
+const TextLayout& Text::getLayout() {
+	ensureGeometryUpdate();
 
-	if ( NULL != mFont && mString.size() ) {
-		getWidthInfo( mLinesWidth, mCachedWidth, mNumLines, mLargestLineCharCount );
-		mCachedWidthNeedUpdate = false;
-	} else {
-		mCachedWidth = 0;
-	}
+	return mLayout;
 }
 
 void Text::setStyleConfig( const FontStyleConfig& styleConfig ) {
@@ -935,195 +601,4 @@ void Text::setFillColor( const Color& color, Uint32 from, Uint32 to ) {
 	}
 }
 
-// Add an underline or strikethrough line to the vertex array
-void Text::addLine(std::vector<VertexCoords>& vertices, Float lineLength, Float lineTop, Float offset, Float thickness, Float outlineThickness, Sizei textureSize, Int32 centerDiffX) {
-	Float top = std::floor(lineTop + offset - (thickness / 2) + 0.5f);
-	Float bottom = top + std::floor(thickness + 0.5f);
-	Float u1 = 0;
-	Float v1 = 0;
-	Float u2 = 1 / (Float)textureSize.getWidth();
-	Float v2 = 1 / (Float)textureSize.getHeight();
-	VertexCoords vc;
-
-	if ( GLi->quadsSupported() ) {
-		vc.texCoords.x	= u1;
-		vc.texCoords.y	= v1;
-		vc.position.x	= centerDiffX + -outlineThickness;
-		vc.position.y	= top - outlineThickness;
-		vertices.push_back( vc );
-
-		vc.texCoords.x	= u1;
-		vc.texCoords.y	= v2;
-		vc.position.x	= centerDiffX + -outlineThickness;
-		vc.position.y	= bottom + outlineThickness;
-		vertices.push_back( vc );
-
-		vc.texCoords.x	= u2;
-		vc.texCoords.y	= v2;
-		vc.position.x	= centerDiffX + lineLength + outlineThickness;
-		vc.position.y	= bottom + outlineThickness;
-		vertices.push_back( vc );
-
-		vc.texCoords.x	= u2;
-		vc.texCoords.y	= v1;
-		vc.position.x	= centerDiffX + lineLength + outlineThickness;
-		vc.position.y	= top - outlineThickness;
-		vertices.push_back( vc );
-	} else {
-		vc.texCoords.x	= u1;
-		vc.texCoords.y	= v2;
-		vc.position.x	= centerDiffX + -outlineThickness;
-		vc.position.y	= bottom + outlineThickness;
-		vertices.push_back( vc );
-
-		vc.texCoords.x	= u1;
-		vc.texCoords.y	= v1;
-		vc.position.x	= centerDiffX + -outlineThickness;
-		vc.position.y	= top - outlineThickness;
-		vertices.push_back( vc );
-
-		vc.texCoords.x	= u2;
-		vc.texCoords.y	= v1;
-		vc.position.x	= centerDiffX + lineLength + outlineThickness;
-		vc.position.y	= top - outlineThickness;
-		vertices.push_back( vc );
-
-		vc.texCoords.x	= u1;
-		vc.texCoords.y	= v2;
-		vc.position.x	= centerDiffX + -outlineThickness;
-		vc.position.y	= bottom + outlineThickness;
-		vertices.push_back( vc );
-
-		vc.texCoords.x	= u2;
-		vc.texCoords.y	= v2;
-		vc.position.x	= centerDiffX + lineLength + outlineThickness;
-		vc.position.y	= bottom + outlineThickness;
-		vertices.push_back( vc );
-
-		vc.texCoords.x	= u2;
-		vc.texCoords.y	= v1;
-		vc.position.x	= centerDiffX + lineLength + outlineThickness;
-		vc.position.y	= top - outlineThickness;
-		vertices.push_back( vc );
-	}
-}
-
-// Add a glyph quad to the vertex array
-void Text::addGlyphQuad(std::vector<VertexCoords>& vertices, Vector2f position, const EE::Graphics::Glyph& glyph, Float italic, Float outlineThickness, Sizei textureSize, Int32 centerDiffX) {
-	Float left		= glyph.bounds.Left;
-	Float top		= glyph.bounds.Top;
-	Float right		= glyph.bounds.Left + glyph.bounds.Right;
-	Float bottom	= glyph.bounds.Top  + glyph.bounds.Bottom;
-
-	Float u1 = static_cast<Float>(glyph.textureRect.Left) / (Float)textureSize.getWidth();
-	Float v1 = static_cast<Float>(glyph.textureRect.Top) / (Float)textureSize.getHeight();
-	Float u2 = static_cast<Float>(glyph.textureRect.Left + glyph.textureRect.Right) / (Float)textureSize.getWidth();
-	Float v2 = static_cast<Float>(glyph.textureRect.Top  + glyph.textureRect.Bottom) / (Float)textureSize.getHeight();
-	VertexCoords vc;
-
-	if ( GLi->quadsSupported() ) {
-		vc.texCoords.x	= u1;
-		vc.texCoords.y	= v1;
-		vc.position.x	= centerDiffX + position.x + left  - italic * top	- outlineThickness;
-		vc.position.y	= position.y + top	- outlineThickness;
-		vertices.push_back( vc );
-
-		vc.texCoords.x	= u1;
-		vc.texCoords.y	= v2;
-		vc.position.x	= centerDiffX + position.x + left  - italic * bottom - outlineThickness;
-		vc.position.y	= position.y + bottom - outlineThickness;
-		vertices.push_back( vc );
-
-		vc.texCoords.x	= u2;
-		vc.texCoords.y	= v2;
-		vc.position.x	= centerDiffX + position.x + right - italic * bottom - outlineThickness;
-		vc.position.y	= position.y + bottom - outlineThickness;
-		vertices.push_back( vc );
-
-		vc.texCoords.x	= u2;
-		vc.texCoords.y	= v1;
-		vc.position.x	= centerDiffX + position.x + right - italic * top - outlineThickness;
-		vc.position.y	= position.y + top - outlineThickness;
-		vertices.push_back( vc );
-	} else {
-		vc.texCoords.x	= u1;
-		vc.texCoords.y	= v2;
-		vc.position.x	= centerDiffX + position.x + left  - italic * bottom - outlineThickness;
-		vc.position.y	= position.y + bottom - outlineThickness;
-		vertices.push_back( vc );
-
-		vc.texCoords.x	= u1;
-		vc.texCoords.y	= v1;
-		vc.position.x	= centerDiffX + position.x + left  - italic * top	- outlineThickness;
-		vc.position.y	= position.y + top	- outlineThickness;
-		vertices.push_back( vc );
-
-		vc.texCoords.x	= u2;
-		vc.texCoords.y	= v1;
-		vc.position.x	= centerDiffX + position.x + right - italic * top - outlineThickness;
-		vc.position.y	= position.y + top - outlineThickness;
-		vertices.push_back( vc );
-
-		vc.texCoords.x	= u1;
-		vc.texCoords.y	= v2;
-		vc.position.x	= centerDiffX + position.x + left  - italic * bottom - outlineThickness;
-		vc.position.y	= position.y + bottom - outlineThickness;
-		vertices.push_back( vc );
-
-		vc.texCoords.x	= u2;
-		vc.texCoords.y	= v2;
-		vc.position.x	= centerDiffX + position.x + right - italic * bottom - outlineThickness;
-		vc.position.y	= position.y + bottom - outlineThickness;
-		vertices.push_back( vc );
-
-		vc.texCoords.x	= u2;
-		vc.texCoords.y	= v1;
-		vc.position.x	= centerDiffX + position.x + right - italic * top - outlineThickness;
-		vc.position.y	= position.y + top - outlineThickness;
-		vertices.push_back( vc );
-	}
-}
-
-Uint32 Text::getTotalVertices() {
-	bool  underlined = (mStyle & Underlined) != 0;
-	bool  strikeThrough = (mStyle & StrikeThrough) != 0;
-	size_t sl = mString.size();
-	size_t sv = sl * GLi->quadVertexs();
-
-	Uint32 * c = &mString[0];
-	Uint32 skiped = 0;
-	bool lineHasChars = false;
-
-	while ( '\0' != *c ) {
-		lineHasChars = true;
-
-		if ( ' ' == *c || '\n' == *c || '\t' == *c || '\r' == *c ) {
-			lineHasChars = false;
-			skiped++;
-
-			if ( '\n' == *c ) {
-				if ( underlined )
-					skiped--;
-
-				if ( strikeThrough )
-					skiped--;
-			}
-		}
-
-		c++;
-	}
-
-	if ( lineHasChars ) {
-		if ( underlined )
-			skiped--;
-
-		if ( strikeThrough )
-			skiped--;
-	}
-
-	sv -= skiped * GLi->quadVertexs();
-
-	return sv;
-}
-
 }}
@@ -0,0 +1,529 @@
+#include <eepp/graphics/textlayout.hpp>
+#include <eepp/graphics/text.hpp>
+#include <eepp/graphics/texture.hpp>
+#include <eepp/graphics/renderer/renderer.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace EE { namespace Graphics {
+
+// The style flags that change the layout, the shadow doesn't
+static const Uint32 TEXT_LAYOUT_STYLE_MASK = Text::Bold | Text::Italic | Text::Underlined | Text::StrikeThrough;
+
+TextLayout::TextLayout() :
+	mFont( NULL ),
+	mCharacterSize( 0 ),
+	mStyle( 0 ),
+	mOutlineThickness( 0 ),
+	mAlign( 0 ),
+	mNeedUpdate( true ),
+	mGeometryNeedUpdate( true ),
+	mWidth( 0 ),
+	mNumLines( 0 ),
+	mLargestLineCharCount( 0 ),
+	mHSpace( 0 ),
+	mVSpace( 0 ),
+	mItalic( 0 ),
+	mUnderlineOffset( 0 ),
+	mUnderlineThickness( 0 ),
+	mStrikeThroughOffset( 0 )
+{
+}
+
+void TextLayout::setFont( Font * font, unsigned int characterSize, Uint32 style, Float outlineThickness ) {
+	style &= TEXT_LAYOUT_STYLE_MASK;
+
+	if ( mFont != font || mCharacterSize != characterSize || mStyle != style || mOutlineThickness != outlineThickness ) {
+		mFont				= font;
+		mCharacterSize		= characterSize;
+		mStyle				= style;
+		mOutlineThickness	= outlineThickness;
+
+		invalidate();
+	}
+}
+
+void TextLayout::setAlign( const Uint32& align ) {
+	if ( fontHAlignGet( mAlign ) != fontHAlignGet( align ) )
+		mGeometryNeedUpdate = true;
+
+	mAlign = align;
+}
+
+void TextLayout::invalidate() {
+	mNeedUpdate = true;
+	mGeometryNeedUpdate = true;
+}
+
+void TextLayout::prepareLayout() {
+	bool bold = ( mStyle & Text::Bold ) != 0;
+
+	mItalic				= ( mStyle & Text::Italic ) ? 0.208f : 0.f; // 12 degrees
+	mUnderlineOffset	= mFont->getUnderlinePosition( mCharacterSize );
+	mUnderlineThickness	= mFont->getUnderlineThickness( mCharacterSize );
+	mHSpace				= static_cast<Float>( mFont->getGlyph( L' ', mCharacterSize, bold ).advance );
+	mVSpace				= static_cast<Float>( mFont->getLineSpacing( mCharacterSize ) );
+
+	// Compute the location of the strike through dynamically
+	// We use the center point of the lowercase 'x' glyph as the reference
+	// We reuse the underline thickness as the thickness of the strike through as well
+	Rectf xBounds = mFont->getGlyph( L'x', mCharacterSize, bold ).bounds;
+	mStrikeThroughOffset = xBounds.Top + xBounds.Bottom / 2.f;
+}
+
+void TextLayout::update( const String& string ) {
+	if ( NULL == mFont ) {
+		if ( !mLines.empty() ) {
+			mLines.clear();
+			updateMetrics();
+		}
+
+		return;
+	}
+
+	Sizei textureSize = mFont->getTexture( mCharacterSize )->getPixelSize();
+
+	if ( textureSize != mTextureSize ) {
+		mTextureSize = textureSize;
+		invalidate();
+	}
+
+	if ( !mNeedUpdate )
+		return;
+
+	mNeedUpdate = false;
+
+	prepareLayout();
+
+	mLines.clear();
+
+	Uint32 start = 0;
+	bool newLine;
+
+	do {
+		mLines.push_back( Line() );
+
+		Line& line = mLines.back();
+
+		newLine = layoutLine( string, start, line );
+
+		start = line.start + line.length + 1;
+	} while ( newLine );
+
+	updateMetrics();
+}
+
+void TextLayout::replace( const String& string, Uint32 from, Uint32 removed, Uint32 inserted ) {
+	if ( mNeedUpdate || NULL == mFont || mLines.empty() ) {
+		invalidate();
+		return;
+	}
+
+	// The glyphs texture coordinates of the lines laid out would be mixed with the new ones
+	if ( mFont->getTexture( mCharacterSize )->getPixelSize() != mTextureSize ) {
+		invalidate();
+		return;
+	}
+
+	prepareLayout();
+
+	Uint32 first	= getLineFromCharacter( from );
+	Uint32 last		= getLineFromCharacter( from + removed );
+	Uint32 end		= from + inserted;
+	Uint32 start	= mLines[ first ].start;
+	std::vector<Line> lines;
+
+	// Lay out from the first line touched until the line that contains the end of the inserted characters
+	while ( true ) {
+		lines.push_back( Line() );
+
+		Line& line = lines.back();
+
+		bool newLine = layoutLine( string, start, line );
+
+		if ( !newLine || line.start + line.length >= end )
+			break;
+
+		start = line.start + line.length + 1;
+	}
+
+	Int32 delta = (Int32)inserted - (Int32)removed;
+
+	for ( Uint32 i = last + 1; i < mLines.size(); i++ )
+		mLines[i].start += delta;
+
+	mLines.erase( mLines.begin() + first, mLines.begin() + last + 1 );
+	mLines.insert( mLines.begin() + first, lines.size(), Line() );
+
+	for ( Uint32 i = 0; i < lines.size(); i++ )
+		std::swap( mLines[ first + i ], lines[i] );
+
+	updateMetrics();
+}
+
+bool TextLayout::layoutLine( const String& string, Uint32 start, Line& line ) {
+	bool bold			= ( mStyle & Text::Bold ) != 0;
+	bool underlined		= ( mStyle & Text::Underlined ) != 0;
+	bool strikeThrough	= ( mStyle & Text::StrikeThrough ) != 0;
+	std::size_t size	= string.size();
+	std::size_t i		= start;
+	bool newLine		= false;
+	Float x				= 0.f;
+	Float y				= static_cast<Float>( mCharacterSize );
+	Uint32 prevChar		= start > 0 ? string[ start - 1 ] : 0;
+
+	line.start	= start;
+	line.minX	= static_cast<Float>( mCharacterSize );
+	line.minY	= static_cast<Float>( mCharacterSize );
+	line.maxX	= 0.f;
+	line.maxY	= 0.f;
+	line.positions.clear();
+	line.vertices.clear();
+	line.outlineVertices.clear();
+
+	for ( ; i < size; ++i ) {
+		Uint32 curChar = string[i];
+
+		line.positions.push_back( x );
+
+		// Apply the kerning offset
+		x += mFont->getKerning( prevChar, curChar, mCharacterSize );
+		prevChar = curChar;
+
+		if ( curChar == L'\n' ) {
+			newLine = true;
+			break;
+		}
+
+		// Handle special characters
+		if ( ( curChar == ' ' ) || ( curChar == '\t' ) || ( curChar == '\r' ) ) {
+			// Update the current bounds (min coordinates)
+			line.minX = std::min( line.minX, x );
+			line.minY = std::min( line.minY, y );
+
+			switch ( curChar ) {
+				case ' ':  x += mHSpace;		break;
+				case '\t': x += mHSpace * 4;	break;
+				case '\r': break;
+			}
+
+			// Update the current bounds (max coordinates)
+			line.maxX = std::max( line.maxX, x );
+			line.maxY = std::max( line.maxY, y );
+
+			// Next glyph, no need to create a quad for whitespace
+			continue;
+		}
+
+		// Apply the outline
+		if ( mOutlineThickness != 0 ) {
+			const Glyph& glyph = mFont->getGlyph( curChar, mCharacterSize, bold, mOutlineThickness );
+
+			Float left		= glyph.bounds.Left;
+			Float top		= glyph.bounds.Top;
+			Float right		= glyph.bounds.Left + glyph.bounds.Right;
+			Float bottom	= glyph.bounds.Top  + glyph.bounds.Bottom;
+
+			// Add the outline glyph to the vertices
+			addGlyphQuad( line.outlineVertices, Vector2f( x, y ), glyph, mOutlineThickness );
+
+			// Update the current bounds with the outlined glyph bounds
+			line.minX = std::min( line.minX, x + left   - mItalic * bottom - mOutlineThickness );
+			line.maxX = std::max( line.maxX, x + right  - mItalic * top	- mOutlineThickness );
+			line.minY = std::min( line.minY, y + top	- mOutlineThickness );
+			line.maxY = std::max( line.maxY, y + bottom - mOutlineThickness );
+		}
+
+		// Extract the current glyph's description
+		const Glyph& glyph = mFont->getGlyph( curChar, mCharacterSize, bold );
+
+		// Add the glyph to the vertices
+		addGlyphQuad( line.vertices, Vector2f( x, y ), glyph, 0 );
+
+		// Update the current bounds with the non outlined glyph bounds
+		if ( mOutlineThickness == 0 ) {
+			Float left		= glyph.bounds.Left;
+			Float top		= glyph.bounds.Top;
+			Float right		= glyph.bounds.Left + glyph.bounds.Right;
+			Float bottom	= glyph.bounds.Top  + glyph.bounds.Bottom;
+
+			line.minX = std::min( line.minX, x + left  - mItalic * bottom );
+			line.maxX = std::max( line.maxX, x + right - mItalic * top );
+			line.minY = std::min( line.minY, y + top );
+			line.maxY = std::max( line.maxY, y + bottom );
+		}
+
+		// Advance to the next character
+		x += glyph.advance;
+	}
+
+	line.length	= i - start;
+	line.width	= x;
+
+	if ( newLine ) {
+		// The new line moves the pen to the start of the next line
+		line.minX = std::min( line.minX, x );
+		line.minY = std::min( line.minY, y );
+		line.maxX = std::max( line.maxX, 0.f );
+		line.maxY = std::max( line.maxY, y + mVSpace );
+	} else {
+		line.positions.push_back( x );
+	}
+
+	// The lines ended with a new line are always underlined, the last line only if it isn't empty
+	if ( newLine || x > 0 ) {
+		if ( underlined ) {
+			addLine( line.vertices, x, y, mUnderlineOffset, 0 );
+
+			if ( mOutlineThickness != 0 )
+				addLine( line.outlineVertices, x, y, mUnderlineOffset, mOutlineThickness );
+		}
+
+		if ( strikeThrough ) {
+			addLine( line.vertices, x, y, mStrikeThroughOffset, 0 );
+
+			if ( mOutlineThickness != 0 )
+				addLine( line.outlineVertices, x, y, mStrikeThroughOffset, mOutlineThickness );
+		}
+	}
+
+	return newLine;
+}
+
+void TextLayout::updateMetrics() {
+	mWidth					= 0;
+	mLargestLineCharCount	= 0;
+	mNumLines				= (int)mLines.size();
+	mLinesWidth.resize( mLines.size() );
+
+	Float minX = static_cast<Float>( mCharacterSize );
+	Float minY = static_cast<Float>( mCharacterSize );
+	Float maxX = 0.f;
+	Float maxY = 0.f;
+
+	for ( Uint32 i = 0; i < mLines.size(); i++ ) {
+		const Line& line = mLines[i];
+		Float lineY = mVSpace * i;
+
+		mLinesWidth[i] = line.width;
+		mWidth = eemax( mWidth, line.width );
+		mLargestLineCharCount = eemax( mLargestLineCharCount, (int)line.length );
+
+		minX = std::min( minX, line.minX );
+		minY = std::min( minY, lineY + line.minY );
+		maxX = std::max( maxX, line.maxX );
+		maxY = std::max( maxY, lineY + line.maxY );
+	}
+
+	// No text: nothing to bound
+	if ( mLines.empty() || ( 1 == mLines.size() && 0 == mLines[0].length ) ) {
+		mBounds = Rectf();
+	} else {
+		mBounds.Left	= minX;
+		mBounds.Top		= minY;
+		mBounds.Right	= maxX - minX;
+		mBounds.Bottom	= maxY - minY;
+	}
+
+	mGeometryNeedUpdate = true;
+}
+
+void TextLayout::updateGeometry() {
+	if ( !mGeometryNeedUpdate )
+		return;
+
+	mGeometryNeedUpdate = false;
+
+	std::size_t numVertices = 0;
+	std::size_t numOutlineVertices = 0;
+
+	for ( Uint32 i = 0; i < mLines.size(); i++ ) {
+		numVertices			+= mLines[i].vertices.size();
+		numOutlineVertices	+= mLines[i].outlineVertices.size();
+	}
+
+	mVertices.resize( numVertices );
+	mOutlineVertices.resize( numOutlineVertices );
+
+	VertexCoords * vertex = numVertices ? &mVertices[0] : NULL;
+	VertexCoords * outlineVertex = numOutlineVertices ? &mOutlineVertices[0] : NULL;
+
+	for ( Uint32 i = 0; i < mLines.size(); i++ ) {
+		const Line& line = mLines[i];
+		Vector2f offset( 0, mVSpace * i );
+
+		switch ( fontHAlignGet( mAlign ) ) {
+			case TEXT_ALIGN_CENTER:
+				offset.x = (Float)( (Int32)( ( mWidth - line.width ) * 0.5f ) );
+				break;
+			case TEXT_ALIGN_RIGHT:
+				offset.x = (Float)( (Int32)( mWidth - line.width ) );
+				break;
+		}
+
+		for ( std::size_t v = 0; v < line.vertices.size(); v++, vertex++ ) {
+			vertex->texCoords	= line.vertices[v].texCoords;
+			vertex->position	= line.vertices[v].position + offset;
+		}
+
+		for ( std::size_t v = 0; v < line.outlineVertices.size(); v++, outlineVertex++ ) {
+			outlineVertex->texCoords	= line.outlineVertices[v].texCoords;
+			outlineVertex->position		= line.outlineVertices[v].position + offset;
+		}
+	}
+}
+
+const std::vector<TextLayout::Line>& TextLayout::getLines() const {
+	return mLines;
+}
+
+Uint32 TextLayout::getLineFromCharacter( Uint32 index ) const {
+	// The last line that starts before or at the index
+	Uint32 lo = 0;
+	Uint32 hi = mLines.size();
+
+	while ( hi - lo > 1 ) {
+		Uint32 mid = ( lo + hi ) / 2;
+
+		if ( mLines[ mid ].start <= index ) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+const int& TextLayout::getNumLines() const {
+	return mNumLines;
+}
+
+const Float& TextLayout::getWidth() const {
+	return mWidth;
+}
+
+const std::vector<Float>& TextLayout::getLinesWidth() const {
+	return mLinesWidth;
+}
+
+const int& TextLayout::getLargestLineCharCount() const {
+	return mLargestLineCharCount;
+}
+
+const Rectf& TextLayout::getBounds() const {
+	return mBounds;
+}
+
+Vector2f TextLayout::findCharacterPos( std::size_t index ) const {
+	if ( mLines.empty() )
+		return Vector2f();
+
+	const Line& lastLine = mLines.back();
+
+	// Adjust the index if it's out of range
+	if ( index > lastLine.start + lastLine.length )
+		index = lastLine.start + lastLine.length;
+
+	Uint32 lineIndex = getLineFromCharacter( index );
+	const Line& line = mLines[ lineIndex ];
+
+	return Vector2f( line.positions[ index - line.start ], mVSpace * lineIndex );
+}
+
+Int32 TextLayout::findCharacterFromPos( const Vector2i& pos ) const {
+	if ( mLines.empty() || pos.x < 0 || pos.y < 0 || 0 == mVSpace )
+		return -1;
+
+	Uint32 lineIndex = eemin( (Uint32)( pos.y / mVSpace ), (Uint32)mLines.size() - 1 );
+	const Line& line = mLines[ lineIndex ];
+
+	for ( Uint32 i = 0; i < line.length; i++ ) {
+		Float left	= line.positions[i];
+		Float right	= line.positions[i + 1];
+
+		if ( pos.x >= left && pos.x <= right ) {
+			// Closest edge of the character
+			return line.start + i + ( pos.x - left > right - pos.x ? 1 : 0 );
+		}
+	}
+
+	return line.start + line.length;
+}
+
+const std::vector<TextLayout::VertexCoords>& TextLayout::getVertices() {
+	updateGeometry();
+
+	return mVertices;
+}
+
+const std::vector<TextLayout::VertexCoords>& TextLayout::getOutlineVertices() {
+	updateGeometry();
+
+	return mOutlineVertices;
+}
+
+// Add an underline or strikethrough line to the vertex array
+void TextLayout::addLine( std::vector<VertexCoords>& vertices, Float lineLength, Float lineTop, Float offset, Float outlineThickness ) {
+	Float top = std::floor( lineTop + offset - ( mUnderlineThickness / 2 ) + 0.5f );
+	Float bottom = top + std::floor( mUnderlineThickness + 0.5f );
+	Float u1 = 0;
+	Float v1 = 0;
+	Float u2 = 1 / (Float)mTextureSize.getWidth();
+	Float v2 = 1 / (Float)mTextureSize.getHeight();
+	Float left = -outlineThickness;
+	Float right = lineLength + outlineThickness;
+	VertexCoords vc;
+
+	top -= outlineThickness;
+	bottom += outlineThickness;
+
+	if ( GLi->quadsSupported() ) {
+		vc.texCoords = Vector2f( u1, v1 ); vc.position = Vector2f( left, top ); vertices.push_back( vc );
+		vc.texCoords = Vector2f( u1, v2 ); vc.position = Vector2f( left, bottom ); vertices.push_back( vc );
+		vc.texCoords = Vector2f( u2, v2 ); vc.position = Vector2f( right, bottom ); vertices.push_back( vc );
+		vc.texCoords = Vector2f( u2, v1 ); vc.position = Vector2f( right, top ); vertices.push_back( vc );
+	} else {
+		vc.texCoords = Vector2f( u1, v2 ); vc.position = Vector2f( left, bottom ); vertices.push_back( vc );
+		vc.texCoords = Vector2f( u1, v1 ); vc.position = Vector2f( left, top ); vertices.push_back( vc );
+		vc.texCoords = Vector2f( u2, v1 ); vc.position = Vector2f( right, top ); vertices.push_back( vc );
+		vc.texCoords = Vector2f( u1, v2 ); vc.position = Vector2f( left, bottom ); vertices.push_back( vc );
+		vc.texCoords = Vector2f( u2, v2 ); vc.position = Vector2f( right, bottom ); vertices.push_back( vc );
+		vc.texCoords = Vector2f( u2, v1 ); vc.position = Vector2f( right, top ); vertices.push_back( vc );
+	}
+}
+
+// Add a glyph quad to the vertex array
+void TextLayout::addGlyphQuad( std::vector<VertexCoords>& vertices, Vector2f position, const Glyph& glyph, Float outlineThickness ) {
+	Float left		= glyph.bounds.Left;
+	Float top		= glyph.bounds.Top;
+	Float right		= glyph.bounds.Left + glyph.bounds.Right;
+	Float bottom	= glyph.bounds.Top  + glyph.bounds.Bottom;
+
+	Float u1 = static_cast<Float>( glyph.textureRect.Left ) / (Float)mTextureSize.getWidth();
+	Float v1 = static_cast<Float>( glyph.textureRect.Top ) / (Float)mTextureSize.getHeight();
+	Float u2 = static_cast<Float>( glyph.textureRect.Left + glyph.textureRect.Right ) / (Float)mTextureSize.getWidth();
+	Float v2 = static_cast<Float>( glyph.textureRect.Top  + glyph.textureRect.Bottom ) / (Float)mTextureSize.getHeight();
+
+	Vector2f topLeft( position.x + left - mItalic * top - outlineThickness, position.y + top - outlineThickness );
+	Vector2f bottomLeft( position.x + left - mItalic * bottom - outlineThickness, position.y + bottom - outlineThickness );
+	Vector2f bottomRight( position.x + right - mItalic * bottom - outlineThickness, position.y + bottom - outlineThickness );
+	Vector2f topRight( position.x + right - mItalic * top - outlineThickness, position.y + top - outlineThickness );
+	VertexCoords vc;
+
+	if ( GLi->quadsSupported() ) {
+		vc.texCoords = Vector2f( u1, v1 ); vc.position = topLeft; vertices.push_back( vc );
+		vc.texCoords = Vector2f( u1, v2 ); vc.position = bottomLeft; vertices.push_back( vc );
+		vc.texCoords = Vector2f( u2, v2 ); vc.position = bottomRight; vertices.push_back( vc );
+		vc.texCoords = Vector2f( u2, v1 ); vc.position = topRight; vertices.push_back( vc );
+	} else {
+		vc.texCoords = Vector2f( u1, v2 ); vc.position = bottomLeft; vertices.push_back( vc );
+		vc.texCoords = Vector2f( u1, v1 ); vc.position = topLeft; vertices.push_back( vc );
+		vc.texCoords = Vector2f( u2, v1 ); vc.position = topRight; vertices.push_back( vc );
+		vc.texCoords = Vector2f( u1, v2 ); vc.position = bottomLeft; vertices.push_back( vc );
+		vc.texCoords = Vector2f( u2, v2 ); vc.position = bottomRight; vertices.push_back( vc );
+		vc.texCoords = Vector2f( u2, v1 ); vc.position = topRight; vertices.push_back( vc );
+	}
+}
+
+}}
@@ -18,7 +18,7 @@ Uint32 Texture::getMaximumSize() {
 
 	if (!checked) {
 		checked = true;
-		glGetIntegerv(GL_MAX_TEXTURE_SIZE, &size);
+		GLi->getIntegerv( GL_MAX_TEXTURE_SIZE, &size );
 	}
 
 	return static_cast<Uint32>(size);
@@ -80,7 +80,7 @@ Texture::~Texture() {
 void Texture::deleteTexture() {
 	if ( mTexture ) {
 		unsigned int Texture = static_cast<unsigned int>(mTexture);
-		glDeleteTextures(1, &Texture);
+		GLi->deleteTextures( 1, &Texture );
 
 		mTexture = 0;
 		mFlags = 0;
@@ -207,7 +207,7 @@ bool Texture::unlock( const bool& KeepData, const bool& Modified ) {
 			Uint32 flags = ( mFlags & TEX_FLAG_MIPMAP ) ? SOIL_FLAG_MIPMAPS : 0;
 			flags = (mClampMode == CLAMP_REPEAT) ? (flags | SOIL_FLAG_TEXTURE_REPEATS) : flags;
 
-			NTexId = SOIL_create_OGL_texture( reinterpret_cast<Uint8*>(&mPixels[0]), &width, &height, mChannels, mTexture, flags );
+			NTexId = GLi->createTexture( reinterpret_cast<Uint8*>(&mPixels[0]), &width, &height, mChannels, mTexture, flags );
 
 			iTextureFilter(mFilter);
 
@@ -277,12 +277,12 @@ void Texture::iTextureFilter( const EE_TEX_FILTER& filter ) {
 
 		TextureSaver saver( mTexture );
 
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (mFilter == TEX_FILTER_LINEAR) ? GL_LINEAR : GL_NEAREST);
+		GLi->texParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (mFilter == TEX_FILTER_LINEAR) ? GL_LINEAR : GL_NEAREST);
 
 		if ( mFlags & TEX_FLAG_MIPMAP )
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (mFilter == TEX_FILTER_LINEAR) ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST);
+			GLi->texParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (mFilter == TEX_FILTER_LINEAR) ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST);
 		else
-			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (mFilter == TEX_FILTER_LINEAR) ? GL_LINEAR : GL_NEAREST);
+			GLi->texParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (mFilter == TEX_FILTER_LINEAR) ? GL_LINEAR : GL_NEAREST);
 	}
 }
 
@@ -314,6 +314,14 @@ void Texture::fillWithColor( const Color& Color ) {
 	unlock( false, true );
 }
 
+void Texture::premultiplyAlpha() {
+	lock();
+
+	Image::premultiplyAlpha();
+
+	unlock( false, true );
+}
+
 void Texture::resize( const Uint32& newWidth, const Uint32& newHeight , EE_RESAMPLER_FILTER filter ) {
 	lock();
 
@@ -365,12 +373,12 @@ void Texture::applyClampMode() {
 		TextureSaver saver( mTexture );
 
 		if( mClampMode == CLAMP_REPEAT ) {
-			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
-			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
+			GLi->texParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
+			GLi->texParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
 		} else {
 			unsigned int clamp_mode = 0x812F; // GL_CLAMP_TO_EDGE
-			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, clamp_mode );
-			glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, clamp_mode );
+			GLi->texParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, clamp_mode );
+			GLi->texParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, clamp_mode );
 		}
 	}
 }
@@ -395,11 +403,11 @@ void Texture::reload()  {
 
 		if ( ( mFlags & TEX_FLAG_COMPRESSED ) ) {
 			if ( isGrabed() )
-				mTexture = SOIL_create_OGL_texture( reinterpret_cast<Uint8 *> ( &mPixels[0] ), &width, &height, mChannels, mTexture, flags | SOIL_FLAG_COMPRESS_TO_DXT );
+				mTexture = GLi->createTexture( reinterpret_cast<Uint8 *> ( &mPixels[0] ), &width, &height, mChannels, mTexture, flags | SOIL_FLAG_COMPRESS_TO_DXT );
 			else
 				glCompressedTexImage2D( mTexture, 0, mInternalFormat, width, height, 0, mSize, &mPixels[0] );
 		} else {
-			mTexture = SOIL_create_OGL_texture( reinterpret_cast<Uint8 *> ( &mPixels[0] ), &width, &height, mChannels, mTexture, flags );
+			mTexture = GLi->createTexture( reinterpret_cast<Uint8 *> ( &mPixels[0] ), &width, &height, mChannels, mTexture, flags );
 
 			TextureFactory::instance()->mMemSize -= mSize;
 
@@ -431,7 +439,7 @@ void Texture::update( const Uint8* pixels, Uint32 width, Uint32 height, Uint32 x
 	if ( NULL != pixels && mTexture && x + width <= mWidth && y + height <= mHeight ) {
 		TextureSaver saver( mTexture );
 
-		glTexSubImage2D( GL_TEXTURE_2D, 0, x, y, width, height, (unsigned int)pf, GL_UNSIGNED_BYTE, pixels );
+		GLi->texSubImage2D( GL_TEXTURE_2D, 0, x, y, width, height, (unsigned int)pf, GL_UNSIGNED_BYTE, pixels );
 
 		if ( hasLocalCopy() ) {
 			Image image( pixels, width, height, mChannels );
@@ -457,7 +465,7 @@ void Texture::replace( Image * image ) {
 
 	Int32 width = (Int32)image->getWidth();
 	Int32 height = (Int32)image->getHeight();
-	mTexture = SOIL_create_OGL_texture( image->getPixelsPtr(), &width, &height, image->getChannels(), mTexture, flags );
+	mTexture = GLi->createTexture( image->getPixelsPtr(), &width, &height, image->getChannels(), mTexture, flags );
 	mWidth = mImgWidth = width;
 	mHeight = mImgHeight = height;
 	mChannels = image->getChannels();
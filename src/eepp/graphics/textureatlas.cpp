@@ -1,14 +1,18 @@
 #include <eepp/graphics/textureatlas.hpp>
+#include <eepp/graphics/textureatlasmanager.hpp>
 
 namespace EE { namespace Graphics {
 
 TextureAtlas::TextureAtlas( const std::string& name ) :
-	ResourceManager<SubTexture> ( true )
+	ResourceManager<SubTexture> ( true ),
+	mId( 0 )
 {
 	setName( name );
 }
 
 TextureAtlas::~TextureAtlas() {
+	// The ResourceManager destructor can't call onResourcesDestroy of the atlas
+	destroy();
 }
 
 const std::string& TextureAtlas::getName() const {
@@ -16,8 +20,15 @@ const std::string& TextureAtlas::getName() const {
 }
 
 void TextureAtlas::setName( const std::string& name ) {
+	Uint32 oldId = mId;
+
 	mName = name;
 	mId = String::hash( mName );
+
+	TextureAtlasManager * manager = TextureAtlasManager::existsSingleton();
+
+	if ( NULL != manager && oldId != mId && manager->isManaged( this ) )
+		manager->reindex( this, oldId );
 }
 
 const std::string& TextureAtlas::getPath() const {
@@ -69,4 +80,25 @@ Uint32 TextureAtlas::getTexturesCount() {
 	return mTextures.size();
 }
 
+void TextureAtlas::onResourceAdd( SubTexture * subTexture ) {
+	TextureAtlasManager * manager = TextureAtlasManager::existsSingleton();
+
+	if ( NULL != manager && !manager->isDestroying() )
+		manager->onSubTextureAdd( this, subTexture );
+}
+
+void TextureAtlas::onResourceRemove( SubTexture * subTexture ) {
+	TextureAtlasManager * manager = TextureAtlasManager::existsSingleton();
+
+	if ( NULL != manager && !manager->isDestroying() )
+		manager->onSubTextureRemove( this, subTexture );
+}
+
+void TextureAtlas::onResourcesDestroy() {
+	TextureAtlasManager * manager = TextureAtlasManager::existsSingleton();
+
+	if ( NULL != manager && !manager->isDestroying() )
+		manager->onSubTexturesDestroy( this );
+}
+
 }}
@@ -6,12 +6,52 @@
 #include <eepp/system/iostreamfile.hpp>
 #include <eepp/system/iostreammemory.hpp>
 #include <eepp/graphics/packerhelper.hpp>
+#include <eepp/graphics/texturepackerbin.hpp>
 #include <eepp/helper/SOIL2/src/SOIL2/stb_image.h>
+#include <algorithm>
 
 namespace EE { namespace Graphics {
 
 using namespace Private;
 
+namespace {
+	/** What happens to a sub texture of the atlas when it's updated */
+	enum UpdateState {
+		UpdateRemove,	///< The image was removed, or it changed its size and it's placed again
+		UpdateKeep,		///< The image didn't change
+		UpdateRedraw	///< The image changed but it has the same size, it's copied over the old one
+	};
+
+	bool sortSubTextureHdrByArea( const sSubTextureHdr& a, const sSubTextureHdr& b ) {
+		return a.Width * a.Height > b.Width * b.Height;
+	}
+
+	/** Grows the smaller side of the atlas texture, as the texture packer does */
+	bool growPageSize( Int32& width, Int32& height, const Sizei& maxSize, bool forcePowOfTwo ) {
+		if ( width >= maxSize.x && height >= maxSize.y )
+			return false;
+
+		if ( ( width <= height && width < maxSize.x ) || height >= maxSize.y ) {
+			width = eemin( forcePowOfTwo ? (Int32)Math::nextPowOfTwo( width + 1 ) : width * 2, maxSize.x );
+		} else {
+			height = eemin( forcePowOfTwo ? (Int32)Math::nextPowOfTwo( height + 1 ) : height * 2, maxSize.y );
+		}
+
+		return true;
+	}
+
+	void clearImageRegion( Image& image, Int32 x, Int32 y, Int32 width, Int32 height ) {
+		Int32 right = eemin( x + width, (Int32)image.getWidth() );
+		Int32 bottom = eemin( y + height, (Int32)image.getHeight() );
+
+		if ( x < 0 || y < 0 || right <= x )
+			return;
+
+		for ( Int32 row = y; row < bottom; row++ )
+			memset( &image.getPixels()[ ( row * image.getWidth() + x ) * image.getChannels() ], 0, ( right - x ) * image.getChannels() );
+	}
+}
+
 TextureAtlasLoader::TextureAtlasLoader() :
 	mThreaded(false),
 	mLoaded(false),
@@ -118,7 +158,17 @@ void TextureAtlasLoader::loadFromStream( IOStream& IOS ) {
 					}
 				}
 
-				IOS.read( (char*)&tTexAtlas.SubTextures[0], sizeof(sSubTextureHdr) * tTextureHdr.SubTextureCount );
+				if ( mTexGrHdr.Version >= EE_TEXTURE_ATLAS_VERSION ) {
+					if ( tTextureHdr.SubTextureCount > 0 )
+						IOS.read( (char*)&tTexAtlas.SubTextures[0], sizeof(sSubTextureHdr) * tTextureHdr.SubTextureCount );
+				} else {
+					// The older sub texture headers don't have the hash
+					for ( Int32 i = 0; i < tTextureHdr.SubTextureCount; i++ ) {
+						memset( &tTexAtlas.SubTextures[i], 0, sizeof(sSubTextureHdr) );
+
+						IOS.read( (char*)&tTexAtlas.SubTextures[i], HDR_SUBTEXTURE_SIZE_1000 );
+					}
+				}
 
 				mTempAtlass.push_back( tTexAtlas );
 			}
@@ -159,7 +209,7 @@ void TextureAtlasLoader::loadFromPack( Pack * Pack, const std::string& FilePackP
 
 		SafeDataPointer PData;
 
-		Pack->extractFileToMemory( FilePackPath, PData );
+		Pack->getFileView( FilePackPath, PData );
 
 		loadFromMemory( reinterpret_cast<const Uint8*> ( PData.Data ), PData.DataSize, FilePackPath );
 	}
@@ -309,6 +359,9 @@ bool TextureAtlasLoader::updateTextureAtlas() {
 	IOStreamFile fs( mTextureAtlasPath, std::ios::out | std::ios::binary );
 
 	if ( fs.isOpen() ) {
+		// The sub texture headers were converted to the current version when loaded
+		mTexGrHdr.Version = EE_TEXTURE_ATLAS_VERSION;
+
 		fs.write( reinterpret_cast<char*> (&mTexGrHdr), sizeof(sTextureAtlasHdr) );
 
 		for ( Uint32 z = 0; z < mTempAtlass.size(); z++ ) {
@@ -326,7 +379,7 @@ bool TextureAtlasLoader::updateTextureAtlas() {
 	return false;
 }
 
-bool TextureAtlasLoader::updateTextureAtlas( std::string TextureAtlasPath, std::string ImagesPath ) {
+bool TextureAtlasLoader::updateTextureAtlas( std::string TextureAtlasPath, std::string ImagesPath, const Float& MaxFragmentation ) {
 	if ( !TextureAtlasPath.size() || !ImagesPath.size() || !FileSystem::fileExists( TextureAtlasPath ) || !FileSystem::isDirectory( ImagesPath ) )
 		return false;
 
@@ -338,149 +391,312 @@ bool TextureAtlasLoader::updateTextureAtlas( std::string TextureAtlasPath, std::
 		return false;
 
 	Int32 x, y, c;
-
-	Int32 NeedUpdate = 0;
+	Uint32 z;
+	Int32 i;
 	EE_PIXEL_DENSITY pixelDensity = PD_MDPI;
+	Int32 border = (Int32)mTexGrHdr.PixelBorder;
+	bool allowFlipping = 0 != ( mTexGrHdr.Flags & HDR_TEXTURE_ATLAS_ALLOW_FLIPPING );
+	bool forcePowOfTwo = 0 != ( mTexGrHdr.Flags & HDR_TEXTURE_ATLAS_POW_OF_TWO );
+	Uint32 pageCount = mTempAtlass.size();
 
 	FileSystem::dirPathAddSlashAtEnd( ImagesPath );
 
-	Uint32 z;
+	std::map<std::string, std::pair<Uint32, Int32> > subTexturesByName;
+	std::vector< std::vector<char> > state( pageCount );
 
-	Uint32 totalSubTextures = 0;
-	for ( z = 0; z < mTempAtlass.size(); z++ ) {
-		totalSubTextures += mTempAtlass[z].Texture.SubTextureCount;
+	for ( z = 0; z < pageCount; z++ ) {
+		sTempTexAtlas * tTexAtlas = &mTempAtlass[z];
 
-		if ( mTempAtlass[z].Texture.SubTextureCount > 0 ) {
-			pixelDensity = (EE_PIXEL_DENSITY)mTempAtlass[z].SubTextures[0].PixelDensity;
+		if ( tTexAtlas->Texture.SubTextureCount > 0 ) {
+			pixelDensity = (EE_PIXEL_DENSITY)tTexAtlas->SubTextures[0].PixelDensity;
 		}
+
+		state[z].resize( tTexAtlas->Texture.SubTextureCount, UpdateRemove );
+
+		for ( i = 0; i < tTexAtlas->Texture.SubTextureCount; i++ )
+			subTexturesByName[ std::string( tTexAtlas->SubTextures[i].Name ) ] = std::make_pair( z, i );
 	}
 
-	Uint32 totalImages = 0;
-	std::vector<std::string> PathFiles = FileSystem::filesGetInPath( ImagesPath );
+	std::vector<sSubTextureHdr> inserts;
+	std::vector<Uint8> data;
+	bool headersChanged = false;
+	bool layoutChanged = false;
 
-	for ( z = 0; z < PathFiles.size(); z++ ) {
-		std::string realpath( ImagesPath + PathFiles[z] );
+	std::vector<std::string> files = FileSystem::filesGetInPath( ImagesPath );
+	std::sort( files.begin(), files.end() );
+
+	for ( Uint32 f = 0; f < files.size(); f++ ) {
+		std::string path( ImagesPath + files[f] );
 
 		// Avoids reading file headers for known extensions
-		if ( Image::isImageExtension( realpath ) )
-			totalImages++;
-	}
+		if ( !Image::isImageExtension( path ) || FileSystem::isDirectory( path ) || !FileSystem::fileGet( path, data ) || data.empty() )
+			continue;
 
-	if ( totalSubTextures != totalImages ) {
-		NeedUpdate = 2;
-	} else {
-		for ( z = 0; z < mTempAtlass.size(); z++ ) {
-			sTempTexAtlas * tTexAtlas 	= &mTempAtlass[z];
-			sTextureHdr * tTexHdr 		= &tTexAtlas->Texture;
+		Uint32 hash = String::hash( &data[0], data.size() );
+		Uint64 date = FileSystem::fileGetModificationDate( path );
+		sSubTextureHdr * tSh = NULL;
+		std::map<std::string, std::pair<Uint32, Int32> >::iterator it = subTexturesByName.find( files[f] );
 
-			if ( 2 != NeedUpdate ) {
-				for ( Int32 i = 0; i < tTexHdr->SubTextureCount; i++ ) {
-					sSubTextureHdr * tSh = &tTexAtlas->SubTextures[i];
+		if ( it != subTexturesByName.end() ) {
+			tSh = &mTempAtlass[ it->second.first ].SubTextures[ it->second.second ];
 
-					std::string path( ImagesPath + tSh->Name );
-
-					if ( FileSystem::fileSize( path ) ) {
-						if ( tSh->Date != FileSystem::fileGetModificationDate( path ) ) {
-							if ( stbi_info( path.c_str(), &x, &y, &c ) ) {
-								if ( 	( !( tSh->Flags & HDR_SUBTEXTURE_FLAG_FLIPED ) && tSh->Width == x && tSh->Height == y ) || // If size or channels changed, the image need update
-										( ( tSh->Flags & HDR_SUBTEXTURE_FLAG_FLIPED ) && tSh->Width == y && tSh->Height == x ) ||
-										tSh->Channels != c
-								)
-								{
-									NeedUpdate = 1;	// Only update the image with the newest one
-								} else {
-									NeedUpdate = 2; // The image change it, recreate all
-									break;
-								}
-							} else {
-								NeedUpdate = 2; // Something is wrong on the image
-								break;
-							}
-						}
-					} else {
-						NeedUpdate = 2; // Need recreation of the whole texture atlas, some image where deleted.
-						break;
-					}
+			// The atlases older than version 1001 don't have the hash, so their images are compared by date
+			if ( ( 0 != tSh->Hash && tSh->Hash == hash ) || ( 0 == tSh->Hash && tSh->Date == date ) ) {
+				state[ it->second.first ][ it->second.second ] = UpdateKeep;
+
+				if ( tSh->Hash != hash || tSh->Date != date ) {
+					tSh->Hash		= hash;
+					tSh->Date		= date;
+					headersChanged	= true;
 				}
-			} else {
-				break;
+
+				continue;
 			}
 		}
+
+		// The images that can't be read are left out of the atlas, as the texture packer does
+		if ( !stbi_info_from_memory( &data[0], data.size(), &x, &y, &c ) )
+			continue;
+
+		if ( NULL != tSh && tSh->Width == x && tSh->Height == y ) {
+			// Same size, the new image is copied over the old one
+			state[ it->second.first ][ it->second.second ] = UpdateRedraw;
+
+			tSh->Hash		= hash;
+			tSh->Date		= date;
+			tSh->Channels	= c;
+			headersChanged	= true;
+
+			continue;
+		}
+
+		// A new image, or an image that changed its size and must be placed again
+		sSubTextureHdr tNewSh;
+		std::string name( files[f] );
+
+		memset( &tNewSh, 0, sizeof(sSubTextureHdr) );
+
+		String::strCopy( tNewSh.Name, name.c_str(), HDR_NAME_SIZE );
+
+		if ( mTexGrHdr.Flags & HDR_TEXTURE_ATLAS_REMOVE_EXTENSION )
+			name = FileSystem::fileRemoveExtension( name );
+
+		tNewSh.ResourceID	= String::hash( name );
+		tNewSh.Width		= x;
+		tNewSh.Height		= y;
+		tNewSh.Channels		= c;
+		tNewSh.DestWidth	= x;
+		tNewSh.DestHeight	= y;
+		tNewSh.Date			= date;
+		tNewSh.PixelDensity	= (Uint32)pixelDensity;
+		tNewSh.Hash			= hash;
+
+		inserts.push_back( tNewSh );
 	}
 
-	if ( NeedUpdate ) {
-		std::string tapath( FileSystem::fileRemoveExtension( TextureAtlasPath ) + "." + Image::saveTypeToExtension( mTexGrHdr.Format ) );
+	for ( z = 0; z < pageCount; z++ ) {
+		for ( i = 0; i < (Int32)state[z].size(); i++ ) {
+			if ( UpdateRemove == state[z][i] )
+				layoutChanged = true;
+		}
+	}
 
-		if ( 2 == NeedUpdate ) {
-			TexturePacker tp( mTexGrHdr.Width, mTexGrHdr.Height, pixelDensity, 0 != ( mTexGrHdr.Flags & HDR_TEXTURE_ATLAS_POW_OF_TWO ), mTexGrHdr.PixelBorder, mTexGrHdr.Flags & HDR_TEXTURE_ATLAS_ALLOW_FLIPPING );
+	layoutChanged = layoutChanged || !inserts.empty();
 
-			tp.addTexturesPath( ImagesPath );
+	if ( !headersChanged && !layoutChanged )
+		return true;
 
-			tp.packTextures();
+	std::string basePath( FileSystem::fileRemoveExtension( TextureAtlasPath ) );
+	std::string extension( "." + Image::saveTypeToExtension( mTexGrHdr.Format ) );
+	std::vector<std::string> pagePaths( pageCount );
+	std::vector<Sizei> pageSizes( pageCount );
+	bool repack = false;
 
-			tp.save( tapath, (EE_SAVE_TYPE)mTexGrHdr.Format );
-		} else if ( 1 == NeedUpdate ) {
-			std::string etapath = FileSystem::fileRemoveExtension( tapath ) + EE_TEXTURE_ATLAS_EXTENSION;
+	for ( z = 0; z < pageCount; z++ ) {
+		pagePaths[z] = 0 == z ? basePath + extension : basePath + "_ch" + String::toStr( z ) + extension;
 
-			IOStreamFile fs( etapath , std::ios::out | std::ios::binary );
+		if ( stbi_info( pagePaths[z].c_str(), &pageSizes[z].x, &pageSizes[z].y, &c ) == 0 )
+			repack = true;
+	}
 
-			if ( !fs.isOpen() )
-				return false;
+	std::vector< std::vector<sSubTextureHdr> > pageInserts( pageCount );
 
-			fs.write( reinterpret_cast<const char*> (&mTexGrHdr), sizeof(sTextureAtlasHdr) );
+	if ( !repack && layoutChanged ) {
+		// The new images are placed in the free space around the sub textures kept, the biggest first
+		std::vector<TexturePackerMaxRects*> bins( pageCount );
+		Sizei maxSize( mTexGrHdr.Width, mTexGrHdr.Height );
 
-			for ( Uint32 z = 0; z < mTempAtlass.size(); z++ ) {
-				if ( z != 0 ) {
-					tapath = FileSystem::fileRemoveExtension( TextureAtlasPath ) + "_ch" + String::toStr( z ) + "." + Image::saveTypeToExtension( mTexGrHdr.Format );
+		for ( z = 0; z < pageCount; z++ ) {
+			bins[z] = eeNew( TexturePackerMaxRects, ( pageSizes[z].x, pageSizes[z].y, allowFlipping ) );
+
+			for ( i = 0; i < (Int32)state[z].size(); i++ ) {
+				if ( UpdateRemove != state[z][i] ) {
+					sSubTextureHdr * tSh = &mTempAtlass[z].SubTextures[i];
+					bool flipped = 0 != ( tSh->Flags & HDR_SUBTEXTURE_FLAG_FLIPED );
+
+					bins[z]->reserve( tSh->X, tSh->Y, ( flipped ? tSh->Height : tSh->Width ) + border, ( flipped ? tSh->Width : tSh->Height ) + border );
 				}
+			}
+		}
 
-				unsigned char * imgPtr = stbi_load( tapath.c_str(), &x, &y, &c, 0 );
+		std::stable_sort( inserts.begin(), inserts.end(), sortSubTextureHdrByArea );
 
-				if ( NULL != imgPtr ) {
-					Image Img( imgPtr, x, y, c );
-					Img.avoidFreeImage( true );
+		for ( Uint32 n = 0; n < inserts.size() && !repack; n++ ) {
+			sSubTextureHdr& tSh = inserts[n];
+			bool flipped = false;
+			bool placed = false;
 
-					sTempTexAtlas * tTexAtlas 	= &mTempAtlass[z];
-					sTextureHdr * tTexHdr 		= &tTexAtlas->Texture;
+			for ( z = 0; z < pageCount && !placed; z++ ) {
+				Int32 width = bins[z]->getWidth();
+				Int32 height = bins[z]->getHeight();
 
-					fs.write( reinterpret_cast<const char*> (tTexHdr), sizeof(sTextureHdr) );
+				placed = bins[z]->insert( tSh.Width + border, tSh.Height + border, x, y, flipped );
 
-					for ( Int32 i = 0; i < tTexHdr->SubTextureCount; i++ ) {
-						sSubTextureHdr * tSh = &tTexAtlas->SubTextures[i];
+				// The atlas textures can grow up to the size of the first one
+				while ( !placed && growPageSize( width, height, maxSize, forcePowOfTwo ) ) {
+					bins[z]->grow( width, height );
 
-						std::string imgcopypath( ImagesPath + tSh->Name );
+					placed = bins[z]->insert( tSh.Width + border, tSh.Height + border, x, y, flipped );
+				}
 
-						Uint32 ModifDate = FileSystem::fileGetModificationDate( imgcopypath );
+				if ( placed ) {
+					tSh.X		= x;
+					tSh.Y		= y;
+					tSh.Flags	= flipped ? HDR_SUBTEXTURE_FLAG_FLIPED : 0;
 
-						if ( tSh->Date != ModifDate ) {
-							tSh->Date = ModifDate;	// Update the sub texture hdr
+					pageInserts[z].push_back( tSh );
+				}
+			}
 
-							unsigned char * imgCopyPtr = stbi_load( imgcopypath.c_str(), &x, &y, &c, 0 );
+			repack = !placed;
+		}
 
-							if ( NULL != imgCopyPtr ) {
-								Image ImgCopy( imgCopyPtr, x, y, c );
-								ImgCopy.avoidFreeImage( true );
+		// The holes left by the sub textures removed or moved waste space that only a full packing recovers
+		Int64 holesArea = 0;
+		Int64 boundsArea = 0;
 
-								Img.copyImage( &ImgCopy, tSh->X, tSh->Y );	// Update the image into the texture atlas
+		for ( z = 0; z < pageCount; z++ ) {
+			Sizei bounds( bins[z]->getUsedSize() );
 
-								if ( imgCopyPtr )
-									free( imgCopyPtr );
-							} else
-								break;
-						}
-					}
+			boundsArea	+= (Int64)bounds.x * (Int64)bounds.y;
+			holesArea	+= (Int64)bounds.x * (Int64)bounds.y - bins[z]->getUsedArea();
+
+			pageSizes[z].x = bins[z]->getWidth();
+			pageSizes[z].y = bins[z]->getHeight();
 
-					fs.write( reinterpret_cast<const char*> (&tTexAtlas->SubTextures[0]), sizeof(sSubTextureHdr) * tTexHdr->SubTextureCount );
+			eeSAFE_DELETE( bins[z] );
+		}
 
-					Img.saveToFile( tapath, (EE_SAVE_TYPE)mTexGrHdr.Format );
+		if ( !repack && boundsArea > 0 && (Float)( (double)holesArea / (double)boundsArea ) > MaxFragmentation ) {
+			eePRINTL( "TextureAtlasLoader::updateTextureAtlas: The texture atlas is too fragmented, packing it again." );
+			repack = true;
+		}
+	}
 
-					if ( imgPtr )
-						free( imgPtr );
-				}
-				else
-					return false; // fatal error
+	if ( repack ) {
+		TexturePacker tp( mTexGrHdr.Width, mTexGrHdr.Height, pixelDensity, forcePowOfTwo, mTexGrHdr.PixelBorder, allowFlipping );
+
+		tp.addTexturesPath( ImagesPath );
+
+		tp.packTextures();
+
+		tp.save( pagePaths[0], (EE_SAVE_TYPE)mTexGrHdr.Format );
+
+		return true;
+	}
+
+	// Only the atlas textures with sub textures removed, redrawn or inserted are saved again
+	for ( z = 0; z < pageCount; z++ ) {
+		sTempTexAtlas * tTexAtlas = &mTempAtlass[z];
+		std::vector<sSubTextureHdr> subTextures;
+		std::vector<sSubTextureHdr> draws;
+		std::vector<sSubTextureHdr> removed;
+
+		for ( i = 0; i < (Int32)state[z].size(); i++ ) {
+			if ( UpdateRemove == state[z][i] ) {
+				removed.push_back( tTexAtlas->SubTextures[i] );
+			} else {
+				subTextures.push_back( tTexAtlas->SubTextures[i] );
+
+				if ( UpdateRedraw == state[z][i] )
+					draws.push_back( tTexAtlas->SubTextures[i] );
 			}
 		}
+
+		subTextures.insert( subTextures.end(), pageInserts[z].begin(), pageInserts[z].end() );
+		draws.insert( draws.end(), pageInserts[z].begin(), pageInserts[z].end() );
+
+		tTexAtlas->SubTextures				= subTextures;
+		tTexAtlas->Texture.SubTextureCount	= (Int32)subTextures.size();
+
+		if ( draws.empty() && removed.empty() )
+			continue;
+
+		unsigned char * imgPtr = stbi_load( pagePaths[z].c_str(), &x, &y, &c, 0 );
+
+		if ( NULL == imgPtr )
+			return false;
+
+		Image Page( (Uint32)pageSizes[z].x, (Uint32)pageSizes[z].y, (Uint32)c );
+		Page.fillWithColor( Color(0,0,0,0) );
+
+		{
+			Image OldPage( imgPtr, x, y, c );
+			OldPage.avoidFreeImage( true );
+
+			Page.copyImage( &OldPage, 0, 0 );
+
+			free( imgPtr );
+		}
+
+		for ( Uint32 n = 0; n < removed.size(); n++ ) {
+			bool flipped = 0 != ( removed[n].Flags & HDR_SUBTEXTURE_FLAG_FLIPED );
+
+			clearImageRegion( Page, removed[n].X, removed[n].Y, flipped ? removed[n].Height : removed[n].Width, flipped ? removed[n].Width : removed[n].Height );
+		}
+
+		for ( Uint32 n = 0; n < draws.size(); n++ ) {
+			std::string imgcopypath( ImagesPath + draws[n].Name );
+			unsigned char * imgCopyPtr = stbi_load( imgcopypath.c_str(), &x, &y, &c, 0 );
+
+			if ( NULL == imgCopyPtr )
+				return false;
+
+			// The image owns a copy of the pixels, since flip() replaces them
+			Image ImgCopy( const_cast<const Uint8*>( imgCopyPtr ), x, y, c );
+
+			free( imgCopyPtr );
+
+			if ( draws[n].Flags & HDR_SUBTEXTURE_FLAG_FLIPED )
+				ImgCopy.flip();
+
+			Page.copyImage( &ImgCopy, draws[n].X, draws[n].Y );	// Update the image into the texture atlas
+		}
+
+		Page.saveToFile( pagePaths[z], (EE_SAVE_TYPE)mTexGrHdr.Format );
+
+		tTexAtlas->Texture.Size = FileSystem::fileSize( pagePaths[z] );
+	}
+
+	std::string etapath = basePath + EE_TEXTURE_ATLAS_EXTENSION;
+
+	IOStreamFile fs( etapath , std::ios::out | std::ios::binary );
+
+	if ( !fs.isOpen() )
+		return false;
+
+	mTexGrHdr.Version	= EE_TEXTURE_ATLAS_VERSION;
+	mTexGrHdr.Date		= static_cast<Uint64>( Sys::getSystemTime() );
+
+	fs.write( reinterpret_cast<const char*> (&mTexGrHdr), sizeof(sTextureAtlasHdr) );
+
+	for ( z = 0; z < pageCount; z++ ) {
+		sTempTexAtlas * tTexAtlas = &mTempAtlass[z];
+
+		fs.write( reinterpret_cast<const char*> (&tTexAtlas->Texture), sizeof(sTextureHdr) );
+
+		if ( tTexAtlas->SubTextures.size() )
+			fs.write( reinterpret_cast<const char*> (&tTexAtlas->SubTextures[0]), sizeof(sSubTextureHdr) * tTexAtlas->SubTextures.size() );
 	}
 
 	return true;
@@ -7,12 +7,15 @@ SINGLETON_DECLARE_IMPLEMENTATION(TextureAtlasManager)
 
 TextureAtlasManager::TextureAtlasManager() :
 	ResourceManager<TextureAtlas>( false ),
-	mWarnings( false )
+	mWarnings( false ),
+	mSubTextureIndexDirty( false )
 {
 	add( GlobalTextureAtlas::instance() );
 }
 
 TextureAtlasManager::~TextureAtlasManager() {
+	// The ResourceManager destructor can't call onResourcesDestroy of the manager
+	destroy();
 }
 
 TextureAtlas * TextureAtlasManager::loadFromFile( const std::string& TextureAtlasPath ) {
@@ -50,21 +53,96 @@ SubTexture * TextureAtlasManager::getSubTextureByName( const std::string& Name )
 }
 
 SubTexture * TextureAtlasManager::getSubTextureById( const Uint32& Id ) {
+	if ( mSubTextureIndexDirty )
+		rebuildSubTextureIndex();
+
+	SubTexture ** tSubTexture = mSubTextureIndex.find( Id );
+
+	return NULL != tSubTexture ? *tSubTexture : NULL;
+}
+
+bool TextureAtlasManager::isManaged( TextureAtlas * textureAtlas ) {
+	std::list<TextureAtlas*>::iterator it;
+
+	for ( it = mResources.begin(); it != mResources.end(); it++ )
+		if ( (*it) == textureAtlas )
+			return true;
+
+	return false;
+}
+
+void TextureAtlasManager::rebuildSubTextureIndex() {
 	std::list<TextureAtlas*>::iterator it;
+	Uint32 count = 0;
+
+	for ( it = mResources.begin(); it != mResources.end(); it++ )
+		count += (*it)->getCount();
 
-	TextureAtlas * tSG = NULL;
-	SubTexture * tSubTexture = NULL;
+	mSubTextureIndex.clear();
+	mSubTextureIndex.reserve( count );
 
+	// The first atlas containing an id is the one that resolves it, as TextureAtlas::getById it resolves it to the last SubTexture added
 	for ( it = mResources.begin(); it != mResources.end(); it++ ) {
-		tSG = (*it);
+		std::list<SubTexture*>& subTextures = (*it)->getResources();
+		std::list<SubTexture*>::reverse_iterator itSub;
 
-		tSubTexture = tSG->getById( Id );
+		for ( itSub = subTextures.rbegin(); itSub != subTextures.rend(); itSub++ ) {
+			if ( NULL == mSubTextureIndex.find( (*itSub)->getId() ) )
+				mSubTextureIndex.insert( (*itSub)->getId(), (*itSub) );
+		}
+	}
+
+	mSubTextureIndexDirty = false;
+}
 
-		if ( NULL != tSubTexture )
-			return tSubTexture;
+void TextureAtlasManager::onResourceAdd( TextureAtlas * textureAtlas ) {
+	if ( mSubTextureIndexDirty )
+		return;
+
+	// The atlas is the last one, it only resolves the ids that no other atlas contains
+	std::list<SubTexture*>& subTextures = textureAtlas->getResources();
+	std::list<SubTexture*>::reverse_iterator it;
+
+	for ( it = subTextures.rbegin(); it != subTextures.rend(); it++ ) {
+		if ( NULL == mSubTextureIndex.find( (*it)->getId() ) )
+			mSubTextureIndex.insert( (*it)->getId(), (*it) );
 	}
+}
+
+void TextureAtlasManager::onResourceRemove( TextureAtlas * textureAtlas ) {
+	mSubTextureIndexDirty = true;
+}
+
+void TextureAtlasManager::onResourcesDestroy() {
+	mSubTextureIndex.clear();
+	mSubTextureIndexDirty = false;
+}
+
+void TextureAtlasManager::onSubTextureAdd( TextureAtlas * textureAtlas, SubTexture * subTexture ) {
+	if ( mSubTextureIndexDirty || !isManaged( textureAtlas ) )
+		return;
+
+	if ( NULL == mSubTextureIndex.find( subTexture->getId() ) ) {
+		mSubTextureIndex.insert( subTexture->getId(), subTexture );
+	} else {
+		// Another atlas contains the same id, the atlases order decides which one resolves it
+		mSubTextureIndexDirty = true;
+	}
+}
+
+void TextureAtlasManager::onSubTextureRemove( TextureAtlas * textureAtlas, SubTexture * subTexture ) {
+	if ( mSubTextureIndexDirty )
+		return;
+
+	SubTexture ** indexed = mSubTextureIndex.find( subTexture->getId() );
+
+	if ( NULL != indexed && *indexed == subTexture )
+		mSubTextureIndexDirty = true;
+}
 
-	return NULL;
+void TextureAtlasManager::onSubTexturesDestroy( TextureAtlas * textureAtlas ) {
+	if ( !mSubTextureIndexDirty && isManaged( textureAtlas ) )
+		mSubTextureIndexDirty = true;
 }
 
 void TextureAtlasManager::printResources() {
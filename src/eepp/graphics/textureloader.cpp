@@ -308,7 +308,7 @@ void TextureLoader::loadFromFile() {
 void TextureLoader::loadFromPack() {
 	SafeDataPointer PData;
 
-	if ( NULL != mPack && mPack->isOpen() && mPack->extractFileToMemory( mFilepath, PData ) ) {
+	if ( NULL != mPack && mPack->isOpen() && mPack->getFileView( mFilepath, PData ) ) {
 		mImagePtr	= PData.Data;
 		mSize		= PData.DataSize;
 
@@ -434,7 +434,7 @@ void TextureLoader::loadFromPixels() {
 			}
 
 			int PreviousTexture;
-			glGetIntegerv(GL_TEXTURE_BINDING_2D, &PreviousTexture);
+			GLi->getIntegerv( GL_TEXTURE_BINDING_2D, &PreviousTexture );
 
 			if ( mDirectUpload ) {
 				if ( STBI_dds == mImgType ) {
@@ -457,7 +457,7 @@ void TextureLoader::loadFromPixels() {
 					eeSAFE_DELETE( tImg );
 				}
 
-				tTexId = SOIL_create_OGL_texture( mPixels, &width, &height, mChannels, SOIL_CREATE_NEW_ID, flags );
+				tTexId = GLi->createTexture( mPixels, &width, &height, mChannels, SOIL_CREATE_NEW_ID, flags );
 			}
 
 			GLi->bindTexture( GL_TEXTURE_2D, PreviousTexture );
@@ -3,11 +3,110 @@
 #include <eepp/system/iostreamfile.hpp>
 #include <eepp/graphics/texturepackernode.hpp>
 #include <eepp/graphics/texturepackertex.hpp>
+#include <eepp/graphics/texturepackerbin.hpp>
+#include <eepp/system/jobsystem.hpp>
 #include <eepp/helper/SOIL2/src/SOIL2/stb_image.h>
 #include <algorithm>
 
 namespace EE { namespace Graphics {
 
+namespace {
+	/** Reads the info of the textures First, First + Step, First + 2 * Step... */
+	struct LoadInfoJob {
+		std::vector<TexturePackerTex*> *	Textures;
+		Uint32								First;
+		Uint32								Step;
+
+		void run() {
+			for ( Uint32 i = First; i < Textures->size(); i += Step )
+				(*Textures)[i]->loadInfo();
+		}
+	};
+
+	/** Decodes the textures First, First + Step, First + 2 * Step... and copies them to the atlas.
+	**	The textures are sorted by area, so interleaving them balances the work between the jobs. */
+	struct CopyJob {
+		std::vector<TexturePackerTex*> *	Textures;
+		Uint32								First;
+		Uint32								Step;
+		Image *								Atlas;
+		Int32								Placed;
+
+		void run() {
+			std::vector<Uint8> file;
+			int w, h, c;
+
+			Placed = 0;
+
+			for ( Uint32 i = First; i < Textures->size(); i += Step ) {
+				TexturePackerTex * t = (*Textures)[i];
+
+				if ( NULL == t->getImage() ) {
+					// The file content is hashed, so the atlas updates can detect the images changed
+					if ( !FileSystem::fileGet( t->name(), file ) || file.empty() )
+						continue;
+
+					t->hash( String::hash( &file[0], file.size() ) );
+
+					Uint8 * data = stbi_load_from_memory( &file[0], file.size(), &w, &h, &c, 0 );
+
+					if ( NULL != data && t->width() == w && t->height() == h ) {
+						if ( t->flipped() ) {
+							// flip() replaces the pixels, so the image needs its own copy of them
+							Image ImgCopy( const_cast<const Uint8*>( data ), w, h, c );
+
+							ImgCopy.flip();
+
+							Atlas->copyImage( &ImgCopy, t->x(), t->y() );
+						} else {
+							Image ImgCopy( data, w, h, c );
+
+							Atlas->copyImage( &ImgCopy, t->x(), t->y() );
+
+							ImgCopy.avoidFreeImage( true );
+						}
+
+						Placed++;
+					}
+
+					if ( data )
+						free( data );
+				} else if ( NULL != t->getImage()->getPixels() ) {
+					if ( t->flipped() )
+						t->getImage()->flip();
+
+					Atlas->copyImage( t->getImage(), t->x(), t->y() );
+
+					Placed++;
+				}
+			}
+		}
+	};
+
+	Uint32 getJobCount( const Uint32& count ) {
+		return eemax( (Uint32)1, eemin( JobSystem::instance()->getWorkerCount() + 1, count ) );
+	}
+
+	/** Runs the jobs in the job system, the calling thread runs the last one */
+	template <typename T>
+	void runJobs( std::vector<T>& jobs ) {
+		JobSystem * jobSystem = JobSystem::instance();
+		std::vector<JobSystem::Handle> handles( jobs.size() - 1 );
+
+		for ( Uint32 i = 0; i < handles.size(); i++ )
+			handles[i] = jobSystem->run( cb::Make0( &jobs[i], &T::run ) );
+
+		jobs.back().run();
+
+		for ( Uint32 i = 0; i < handles.size(); i++ )
+			jobSystem->wait( handles[i] );
+	}
+
+	bool sortByArea( TexturePackerTex * a, TexturePackerTex * b ) {
+		return a->area() > b->area();
+	}
+}
+
 TexturePacker::TexturePacker( const Uint32& MaxWidth, const Uint32& MaxHeight, const EE_PIXEL_DENSITY& PixelDensity, const bool& ForcePowOfTwo, const Uint32& PixelBorder, const bool& AllowFlipping ) :
 	mTotalArea(0),
 	mFreeList(NULL),
@@ -21,7 +120,8 @@ TexturePacker::TexturePacker( const Uint32& MaxWidth, const Uint32& MaxHeight, c
 	mParent(NULL),
 	mPlacedCount(0),
 	mForcePowOfTwo(true),
-	mPixelBorder(0)
+	mPixelBorder(0),
+	mPackingMethod(MaxRects)
 {
 	setOptions( MaxWidth, MaxHeight, PixelDensity, ForcePowOfTwo, PixelBorder, AllowFlipping );
 }
@@ -40,7 +140,8 @@ TexturePacker::TexturePacker() :
 	mParent(NULL),
 	mPlacedCount(0),
 	mForcePowOfTwo(true),
-	mPixelBorder(0)
+	mPixelBorder(0),
+	mPackingMethod(MaxRects)
 {
 }
 
@@ -353,35 +454,32 @@ void TexturePacker::insertTexture( TexturePackerTex * t, TexturePackerNode * bes
 }
 
 void TexturePacker::createChild() {
-	mChild = eeNew( TexturePacker, ( mWidth, mHeight, mPixelDensity, mForcePowOfTwo, mPixelBorder, mAllowFlipping ) );
+	mChild = eeNew( TexturePacker, ( mMaxSize.getWidth(), mMaxSize.getHeight(), mPixelDensity, mForcePowOfTwo, mPixelBorder, mAllowFlipping ) );
+	mChild->mParent = this;
+	mChild->mPackingMethod = mPackingMethod;
 
-	std::list<TexturePackerTex*>::iterator it;
-	std::list< std::list<TexturePackerTex*>::iterator > remove;
+	// Moves the non-placed textures to the child, without the border added while packing
+	std::list<TexturePackerTex*>::iterator it = mTextures.begin();
 
-	TexturePackerTex * t = NULL;
-
-	for ( it = mTextures.begin(); it != mTextures.end(); it++ ) {
-		t = (*it);
+	while ( it != mTextures.end() ) {
+		TexturePackerTex * t = (*it);
 
 		if ( !t->placed() ) {
-			mChild->addTexture( t->name() );
-			mChild->mParent = this;
+			t->width	( t->width() 	- mPixelBorder );
+			t->height	( t->height() 	- mPixelBorder );
 
-			t->disabled( true );
+			mTotalArea -= t->area();
+			mChild->mTotalArea += t->area();
+			mChild->mTextures.push_back( t );
 
-			remove.push_back( it );
+			it = mTextures.erase( it );
 
 			mCount--;
+		} else {
+			it++;
 		}
 	}
 
-	// Removes the non-placed textures from the pack
-	std::list< std::list<TexturePackerTex*>::iterator >::iterator itit;
-
-	for ( itit = remove.begin(); itit != remove.end(); itit++ ) {
-		mTextures.erase( *itit );
-	}
-
 	mChild->packTextures();
 }
 
@@ -392,10 +490,28 @@ bool TexturePacker::addTexturesPath( std::string TexturesPath ) {
 		std::vector<std::string> files = FileSystem::filesGetInPath( TexturesPath );
 		std::sort( files.begin(), files.end() );
 
+		std::vector<TexturePackerTex*> textures;
+
 		for ( Uint32 i = 0; i < files.size(); i++ ) {
 			std::string path( TexturesPath + files[i] );
 			if ( !FileSystem::isDirectory( path ) )
-				addTexture( path );
+				textures.push_back( eeNew( TexturePackerTex, ( path, false ) ) );
+		}
+
+		if ( textures.size() ) {
+			// Reading the image headers dominates with a lot of small images, so it's done in parallel
+			std::vector<LoadInfoJob> jobs( getJobCount( textures.size() ) );
+
+			for ( Uint32 i = 0; i < jobs.size(); i++ ) {
+				jobs[i].Textures	= &textures;
+				jobs[i].First		= i;
+				jobs[i].Step		= jobs.size();
+			}
+
+			runJobs( jobs );
+
+			for ( Uint32 i = 0; i < textures.size(); i++ )
+				addPackerTex( textures[i] );
 		}
 
 		return true;
@@ -413,27 +529,15 @@ bool TexturePacker::addPackerTex( TexturePackerTex * TPack ) {
 		{
 			mTotalArea += TPack->area();
 
-			// Insert ordered
-			std::list<TexturePackerTex*>::iterator it;
-
-			bool Added = false;
-
-			for ( it = mTextures.begin(); it != mTextures.end(); it++ ) {
-				if ( (*it)->area() < TPack->area() ) {
-					mTextures.insert( it, TPack );
-					Added = true;
-					break;
-				}
-			}
-
-			if ( !Added ) {
-				mTextures.push_back( TPack );
+			// The textures are sorted by area when packing
+			mTextures.push_back( TPack );
 
-				return true;
-			}
+			return true;
 		}
 	}
 
+	eeSAFE_DELETE( TPack );
+
 	return false;
 }
 
@@ -452,6 +556,114 @@ bool TexturePacker::addTexture( const std::string& TexturePath ) {
 }
 
 Int32 TexturePacker::packTextures() { // pack the textures, the return code is the amount of wasted/unused area.
+	// The biggest textures are placed first, the sort is stable so the textures with the same area keep the order they were added
+	mTextures.sort( sortByArea );
+
+	if ( FreeList == mPackingMethod )
+		return packTexturesFreeList();
+
+	return packTexturesBin();
+}
+
+TexturePackerBin * TexturePacker::createBin() {
+	switch ( mPackingMethod ) {
+		case SkylineBottomLeft:
+			return eeNew( TexturePackerSkyline, ( mWidth, mHeight, mAllowFlipping, TexturePackerSkyline::BottomLeft ) );
+		case SkylineMinWaste:
+			return eeNew( TexturePackerSkyline, ( mWidth, mHeight, mAllowFlipping, TexturePackerSkyline::MinWaste ) );
+		case MaxRects:
+		default:
+			return eeNew( TexturePackerMaxRects, ( mWidth, mHeight, mAllowFlipping ) );
+	}
+}
+
+bool TexturePacker::growSize( Int32& width, Int32& height ) {
+	if ( width >= mMaxSize.getWidth() && height >= mMaxSize.getHeight() )
+		return false;
+
+	// Grows the smaller side, as the free list packer does
+	if ( ( width <= height && width < mMaxSize.getWidth() ) || height >= mMaxSize.getHeight() ) {
+		width = eemin( width * 2, mMaxSize.getWidth() );
+	} else {
+		height = eemin( height * 2, mMaxSize.getHeight() );
+	}
+
+	return true;
+}
+
+Int32 TexturePacker::packTexturesBin() {
+	addBorderToTextures( (Int32)mPixelBorder );
+
+	// Starts with the smallest size that can hold the area of every texture, so the bin rarely needs to grow
+	Int64 area = 0;
+	Int32 maxWidth = 0;
+	Int32 maxHeight = 0;
+	std::list<TexturePackerTex*>::iterator it;
+
+	for ( it = mTextures.begin(); it != mTextures.end(); it++ ) {
+		area		+= (Int64)(*it)->width() * (Int64)(*it)->height();
+		maxWidth	= eemax( maxWidth, (*it)->width() );
+		maxHeight	= eemax( maxHeight, (*it)->height() );
+	}
+
+	mWidth	= eemin( mWidth, mMaxSize.getWidth() );
+	mHeight	= eemin( mHeight, mMaxSize.getHeight() );
+
+	while ( ( (Int64)mWidth * (Int64)mHeight < area || mWidth < maxWidth || mHeight < maxHeight ) && growSize( mWidth, mHeight ) );
+
+	TexturePackerBin * bin = createBin();
+
+	mCount = (Int32)mTextures.size();
+
+	for ( it = mTextures.begin(); it != mTextures.end(); it++ ) {
+		TexturePackerTex * t = (*it);
+		Int32 x = 0, y = 0;
+		bool flipped = false;
+		bool placed = bin->insert( t->width(), t->height(), x, y, flipped );
+
+		// The bin grows keeping the textures already placed, until the texture fits or the bin reaches the max size
+		while ( !placed && growSize( mWidth, mHeight ) ) {
+			bin->grow( mWidth, mHeight );
+
+			placed = bin->insert( t->width(), t->height(), x, y, flipped );
+		}
+
+		if ( placed ) {
+			t->place( x, y, flipped );
+			mCount--;
+		}
+	}
+
+	// The last growth can leave space unused
+	if ( bin->getUsedArea() > 0 ) {
+		Sizei used( bin->getUsedSize() );
+
+		if ( mForcePowOfTwo ) {
+			used.x = Math::nextPowOfTwo( used.x );
+			used.y = Math::nextPowOfTwo( used.y );
+		}
+
+		mWidth	= eemin( mWidth, used.x );
+		mHeight	= eemin( mHeight, used.y );
+	}
+
+	eeSAFE_DELETE( bin );
+
+	if ( mCount > 0 ) {
+		eePRINTL( "Creating a new image as a child. Some textures couldn't get it: %d", mCount );
+		createChild();
+	}
+
+	addBorderToTextures( -( (Int32)mPixelBorder ) );
+
+	mPacked = true;
+
+	eePRINTL( "Total Area Used: %d. This represents the %4.3f percent", mTotalArea, ( (double)mTotalArea / (double)( mWidth * mHeight ) ) * 100.0 );
+
+	return ( mWidth * mHeight ) - mTotalArea;
+}
+
+Int32 TexturePacker::packTexturesFreeList() {
 	TexturePackerTex * t 	= NULL;
 
 	addBorderToTextures( (Int32)mPixelBorder );
@@ -507,7 +719,7 @@ Int32 TexturePacker::packTextures() { // pack the textures, the return code is t
 						mHeight = mMaxSize.getHeight();
 				}
 
-				return packTextures();
+				return packTexturesFreeList();
 			} else {
 				eePRINTL( "Creating a new image as a child." );
 				createChild();
@@ -517,6 +729,15 @@ Int32 TexturePacker::packTextures() { // pack the textures, the return code is t
 		}
 	}
 
+	// The strategies can run out without failing when the last textures don't fit, the atlas must grow before creating a child
+	if ( mCount > 0 && ( mWidth < mMaxSize.getWidth() || mHeight < mMaxSize.getHeight() ) ) {
+		reset();
+		addBorderToTextures( -( (Int32)mPixelBorder ) );
+		growSize( mWidth, mHeight );
+
+		return packTexturesFreeList();
+	}
+
 	if ( mCount > 0 ) {
 		eePRINTL( "Creating a new image as a child. Some textures couldn't get it: %d", mCount );
 		createChild();
@@ -550,49 +771,30 @@ void TexturePacker::save( const std::string& Filepath, const EE_SAVE_TYPE& Forma
 
 	Img.fillWithColor( Color(0,0,0,0) );
 
-	TexturePackerTex * t = NULL;
-	int w, h, c;
+	std::vector<TexturePackerTex*> placed;
 	std::list<TexturePackerTex*>::iterator it;
 
 	for ( it = mTextures.begin(); it != mTextures.end(); it++ ) {
-		t = (*it);
-
-		if ( t->placed() ) {
-			Uint8 * data;
-
-			if ( NULL == t->getImage() ) {
-				data = stbi_load( t->name().c_str(), &w, &h, &c, 0 );
-
-				if ( NULL != data && t->width() == w && t->height() == h ) {
-					Image * ImgCopy = eeNew( Image, ( data, w, h, c ) );
-
-					if ( t->flipped() )
-						ImgCopy->flip();
-
-					Img.copyImage( ImgCopy, t->x(), t->y() );
-
-					ImgCopy->avoidFreeImage( true );
+		if ( (*it)->placed() )
+			placed.push_back( *it );
+	}
 
-					eeSAFE_DELETE( ImgCopy );
+	if ( placed.size() ) {
+		// The textures occupy disjoint regions of the atlas, so they are decoded and copied in parallel
+		std::vector<CopyJob> jobs( getJobCount( placed.size() ) );
 
-					if ( data )
-						free( data );
-
-					mPlacedCount++;
-				}
-			} else {
-				data = t->getImage()->getPixels();
-
-				if ( NULL != data ) {
-					if ( t->flipped() )
-						t->getImage()->flip();
+		for ( Uint32 i = 0; i < jobs.size(); i++ ) {
+			jobs[i].Textures	= &placed;
+			jobs[i].First		= i;
+			jobs[i].Step		= jobs.size();
+			jobs[i].Atlas		= &Img;
+			jobs[i].Placed		= 0;
+		}
 
-					Img.copyImage( t->getImage(), t->x(), t->y() );
+		runJobs( jobs );
 
-					mPlacedCount++;
-				}
-			}
-		}
+		for ( Uint32 i = 0; i < jobs.size(); i++ )
+			mPlacedCount += jobs[i].Placed;
 	}
 
 	mFormat = Format;
@@ -623,7 +825,7 @@ void TexturePacker::saveSubTextures() {
 	sTextureAtlasHdr TexGrHdr;
 
 	TexGrHdr.Magic 			= EE_TEXTURE_ATLAS_MAGIC;
-	TexGrHdr.Version		= 1000;
+	TexGrHdr.Version		= EE_TEXTURE_ATLAS_VERSION;
 	TexGrHdr.Date			= static_cast<Uint64>( Sys::getSystemTime() );
 	TexGrHdr.TextureCount 	= 1 + getChildCount();
 	TexGrHdr.Format			= mFormat;
@@ -727,6 +929,8 @@ void TexturePacker::createSubTexturesHdr( TexturePacker * Packer, std::vector<sS
 			tSubTextureHdr.Date			= FileSystem::fileGetModificationDate( tTex->name() );
 			tSubTextureHdr.Flags		= 0;
 			tSubTextureHdr.PixelDensity	= (Uint32)mPixelDensity;
+			tSubTextureHdr.Hash			= tTex->hash();
+			tSubTextureHdr.Reserved		= 0;
 
 			if ( tTex->flipped() )
 				tSubTextureHdr.Flags |= HDR_SUBTEXTURE_FLAG_FLIPED;
@@ -805,4 +1009,36 @@ const Int32& TexturePacker::getPlacedCount() const {
 	return mPlacedCount;
 }
 
+void TexturePacker::setPackingMethod( const PackingMethod& method ) {
+	mPackingMethod = method;
+}
+
+const TexturePacker::PackingMethod& TexturePacker::getPackingMethod() const {
+	return mPackingMethod;
+}
+
+Int32 TexturePacker::getAtlasCount() {
+	return 1 + getChildCount();
+}
+
+Float TexturePacker::getOccupancy() {
+	Int64 usedArea = 0;
+	Int64 totalArea = 0;
+	TexturePacker * Packer = this;
+
+	while ( NULL != Packer ) {
+		std::list<TexturePackerTex*>::iterator it;
+
+		for ( it = Packer->mTextures.begin(); it != Packer->mTextures.end(); it++ ) {
+			if ( (*it)->placed() )
+				usedArea += (*it)->area();
+		}
+
+		totalArea	+= (Int64)Packer->getWidth() * (Int64)Packer->getHeight();
+		Packer		= Packer->getChild();
+	}
+
+	return totalArea > 0 ? (Float)( (double)usedArea / (double)totalArea ) : 0.f;
+}
+
 }}
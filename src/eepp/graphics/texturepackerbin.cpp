@@ -0,0 +1,359 @@
+#include <eepp/graphics/texturepackerbin.hpp>
+#include <climits>
+
+namespace EE { namespace Graphics { namespace Private {
+
+static bool isContainedIn( const TexturePackerBin::Box& a, const TexturePackerBin::Box& b ) {
+	return a.x >= b.x && a.y >= b.y && a.x + a.width <= b.x + b.width && a.y + a.height <= b.y + b.height;
+}
+
+TexturePackerBin::TexturePackerBin( Int32 width, Int32 height, bool allowFlipping ) :
+	mWidth( width ),
+	mHeight( height ),
+	mAllowFlipping( allowFlipping ),
+	mUsedArea( 0 )
+{
+}
+
+TexturePackerBin::~TexturePackerBin() {
+}
+
+const Int32& TexturePackerBin::getWidth() const {
+	return mWidth;
+}
+
+const Int32& TexturePackerBin::getHeight() const {
+	return mHeight;
+}
+
+const Int64& TexturePackerBin::getUsedArea() const {
+	return mUsedArea;
+}
+
+Sizei TexturePackerBin::getUsedSize() const {
+	return mUsedSize;
+}
+
+void TexturePackerBin::addUsed( const Box& box ) {
+	mUsedArea	+= (Int64)box.width * (Int64)box.height;
+	mUsedSize.x	= eemax( mUsedSize.x, box.x + box.width );
+	mUsedSize.y	= eemax( mUsedSize.y, box.y + box.height );
+}
+
+/** MaxRects */
+
+TexturePackerMaxRects::TexturePackerMaxRects( Int32 width, Int32 height, bool allowFlipping ) :
+	TexturePackerBin( width, height, allowFlipping )
+{
+	mFree.push_back( Box( 0, 0, width, height ) );
+}
+
+bool TexturePackerMaxRects::insert( Int32 width, Int32 height, Int32& x, Int32& y, bool& flipped ) {
+	Int32 bestShortSide = INT_MAX;
+	Int32 bestLongSide = INT_MAX;
+	Box best;
+
+	for ( Uint32 i = 0; i < mFree.size(); i++ ) {
+		const Box& f = mFree[i];
+
+		if ( f.width >= width && f.height >= height ) {
+			Int32 leftoverH	= f.width - width;
+			Int32 leftoverV	= f.height - height;
+			Int32 shortSide	= eemin( leftoverH, leftoverV );
+			Int32 longSide	= eemax( leftoverH, leftoverV );
+
+			if ( shortSide < bestShortSide || ( shortSide == bestShortSide && longSide < bestLongSide ) ) {
+				best			= Box( f.x, f.y, width, height );
+				bestShortSide	= shortSide;
+				bestLongSide	= longSide;
+				flipped			= false;
+			}
+		}
+
+		if ( mAllowFlipping && f.width >= height && f.height >= width ) {
+			Int32 leftoverH	= f.width - height;
+			Int32 leftoverV	= f.height - width;
+			Int32 shortSide	= eemin( leftoverH, leftoverV );
+			Int32 longSide	= eemax( leftoverH, leftoverV );
+
+			if ( shortSide < bestShortSide || ( shortSide == bestShortSide && longSide < bestLongSide ) ) {
+				best			= Box( f.x, f.y, height, width );
+				bestShortSide	= shortSide;
+				bestLongSide	= longSide;
+				flipped			= true;
+			}
+		}
+	}
+
+	if ( INT_MAX == bestShortSide )
+		return false;
+
+	placeBox( best );
+
+	x = best.x;
+	y = best.y;
+
+	return true;
+}
+
+void TexturePackerMaxRects::reserve( Int32 x, Int32 y, Int32 width, Int32 height ) {
+	placeBox( Box( x, y, width, height ) );
+}
+
+void TexturePackerMaxRects::placeBox( const Box& box ) {
+	// Split every free rectangle that intersects the new one
+	for ( Uint32 i = 0; i < mFree.size(); ) {
+		if ( splitFreeBox( mFree[i], box ) ) {
+			mFree[i] = mFree.back();
+			mFree.pop_back();
+		} else {
+			i++;
+		}
+	}
+
+	pruneFreeList();
+
+	addUsed( box );
+}
+
+bool TexturePackerMaxRects::splitFreeBox( const Box& freeBox, const Box& used ) {
+	if ( used.x >= freeBox.x + freeBox.width || used.x + used.width <= freeBox.x ||
+		 used.y >= freeBox.y + freeBox.height || used.y + used.height <= freeBox.y )
+		return false;
+
+	if ( used.x < freeBox.x + freeBox.width && used.x + used.width > freeBox.x ) {
+		// Free space above the used rectangle
+		if ( used.y > freeBox.y && used.y < freeBox.y + freeBox.height )
+			insertNewFreeBox( Box( freeBox.x, freeBox.y, freeBox.width, used.y - freeBox.y ) );
+
+		// Free space below the used rectangle
+		if ( used.y + used.height < freeBox.y + freeBox.height )
+			insertNewFreeBox( Box( freeBox.x, used.y + used.height, freeBox.width, freeBox.y + freeBox.height - ( used.y + used.height ) ) );
+	}
+
+	if ( used.y < freeBox.y + freeBox.height && used.y + used.height > freeBox.y ) {
+		// Free space at the left of the used rectangle
+		if ( used.x > freeBox.x && used.x < freeBox.x + freeBox.width )
+			insertNewFreeBox( Box( freeBox.x, freeBox.y, used.x - freeBox.x, freeBox.height ) );
+
+		// Free space at the right of the used rectangle
+		if ( used.x + used.width < freeBox.x + freeBox.width )
+			insertNewFreeBox( Box( used.x + used.width, freeBox.y, freeBox.x + freeBox.width - ( used.x + used.width ), freeBox.height ) );
+	}
+
+	return true;
+}
+
+void TexturePackerMaxRects::insertNewFreeBox( const Box& box ) {
+	// The new free rectangles only need to be compared with the other new ones here, and with the old ones when pruning
+	for ( Uint32 i = 0; i < mNewFree.size(); ) {
+		if ( isContainedIn( box, mNewFree[i] ) )
+			return;
+
+		if ( isContainedIn( mNewFree[i], box ) ) {
+			mNewFree[i] = mNewFree.back();
+			mNewFree.pop_back();
+		} else {
+			i++;
+		}
+	}
+
+	mNewFree.push_back( box );
+}
+
+void TexturePackerMaxRects::pruneFreeList() {
+	// The new free rectangles are pieces of the old ones that were split, so an old free rectangle can't be contained in a new one
+	for ( Uint32 i = 0; i < mFree.size(); i++ ) {
+		for ( Uint32 j = 0; j < mNewFree.size(); ) {
+			if ( isContainedIn( mNewFree[j], mFree[i] ) ) {
+				mNewFree[j] = mNewFree.back();
+				mNewFree.pop_back();
+			} else {
+				j++;
+			}
+		}
+	}
+
+	mFree.insert( mFree.end(), mNewFree.begin(), mNewFree.end() );
+	mNewFree.clear();
+}
+
+void TexturePackerMaxRects::grow( Int32 width, Int32 height ) {
+	// The free rectangles that touch the right or bottom edge extend over the new space, and they are still maximal
+	for ( Uint32 i = 0; i < mFree.size(); i++ ) {
+		Box& f = mFree[i];
+
+		if ( f.x + f.width == mWidth )
+			f.width += width - mWidth;
+
+		if ( f.y + f.height == mHeight )
+			f.height += height - mHeight;
+	}
+
+	if ( width > mWidth )
+		mFree.push_back( Box( mWidth, 0, width - mWidth, height ) );
+
+	if ( height > mHeight )
+		mFree.push_back( Box( 0, mHeight, width, height - mHeight ) );
+
+	// The extended rectangles can contain other ones, so the whole list is pruned
+	for ( Uint32 i = 0; i < mFree.size(); i++ ) {
+		for ( Uint32 j = i + 1; j < mFree.size(); ) {
+			if ( isContainedIn( mFree[j], mFree[i] ) ) {
+				mFree.erase( mFree.begin() + j );
+			} else if ( isContainedIn( mFree[i], mFree[j] ) ) {
+				mFree.erase( mFree.begin() + i );
+				j = i + 1;
+			} else {
+				j++;
+			}
+		}
+	}
+
+	mWidth	= width;
+	mHeight	= height;
+}
+
+/** Skyline */
+
+TexturePackerSkyline::TexturePackerSkyline( Int32 width, Int32 height, bool allowFlipping, Heuristic heuristic ) :
+	TexturePackerBin( width, height, allowFlipping ),
+	mHeuristic( heuristic )
+{
+	mSkyline.push_back( Node( 0, 0, width ) );
+}
+
+bool TexturePackerSkyline::fits( Uint32 index, Int32 width, Int32 height, Int32& y ) const {
+	if ( mSkyline[ index ].x + width > mWidth )
+		return false;
+
+	Int32 widthLeft = width;
+
+	y = mSkyline[ index ].y;
+
+	while ( widthLeft > 0 && index < mSkyline.size() ) {
+		y = eemax( y, mSkyline[ index ].y );
+
+		if ( y + height > mHeight )
+			return false;
+
+		widthLeft -= mSkyline[ index ].width;
+		index++;
+	}
+
+	return widthLeft <= 0;
+}
+
+Int64 TexturePackerSkyline::wastedArea( Uint32 index, Int32 width, Int32 y ) const {
+	Int64 wasted = 0;
+	Int32 left = mSkyline[ index ].x;
+	Int32 right = left + width;
+
+	for ( ; index < mSkyline.size() && mSkyline[ index ].x < right; index++ ) {
+		Int32 segmentRight = eemin( right, mSkyline[ index ].x + mSkyline[ index ].width );
+
+		wasted += (Int64)( segmentRight - mSkyline[ index ].x ) * (Int64)( y - mSkyline[ index ].y );
+	}
+
+	return wasted;
+}
+
+bool TexturePackerSkyline::insert( Int32 width, Int32 height, Int32& x, Int32& y, bool& flipped ) {
+	Int64 bestScore = LLONG_MAX;
+	Int32 bestSecondary = INT_MAX;
+	Uint32 bestIndex = 0;
+	Box best;
+
+	for ( Uint32 i = 0; i < mSkyline.size(); i++ ) {
+		for ( Uint32 rotation = 0; rotation < ( mAllowFlipping ? 2u : 1u ); rotation++ ) {
+			Int32 w = rotation ? height : width;
+			Int32 h = rotation ? width : height;
+			Int32 top;
+
+			if ( !fits( i, w, h, top ) )
+				continue;
+
+			Int64 score;
+			Int32 secondary;
+
+			if ( BottomLeft == mHeuristic ) {
+				// Lowest top edge, then the narrowest segment
+				score		= top + h;
+				secondary	= mSkyline[i].width;
+			} else {
+				// Least area wasted below, then the lowest
+				score		= wastedArea( i, w, top );
+				secondary	= top + h;
+			}
+
+			if ( score < bestScore || ( score == bestScore && secondary < bestSecondary ) ) {
+				bestScore		= score;
+				bestSecondary	= secondary;
+				bestIndex		= i;
+				best			= Box( mSkyline[i].x, top, w, h );
+				flipped			= rotation != 0;
+			}
+		}
+	}
+
+	if ( LLONG_MAX == bestScore )
+		return false;
+
+	addLevel( bestIndex, best );
+
+	addUsed( best );
+
+	x = best.x;
+	y = best.y;
+
+	return true;
+}
+
+void TexturePackerSkyline::addLevel( Uint32 index, const Box& box ) {
+	mSkyline.insert( mSkyline.begin() + index, Node( box.x, box.y + box.height, box.width ) );
+
+	// Shrink or remove the segments covered by the new one
+	for ( Uint32 i = index + 1; i < mSkyline.size(); ) {
+		Int32 previousRight = mSkyline[ i - 1 ].x + mSkyline[ i - 1 ].width;
+
+		if ( mSkyline[i].x >= previousRight )
+			break;
+
+		Int32 shrink = previousRight - mSkyline[i].x;
+
+		mSkyline[i].x += shrink;
+		mSkyline[i].width -= shrink;
+
+		if ( mSkyline[i].width > 0 )
+			break;
+
+		mSkyline.erase( mSkyline.begin() + i );
+	}
+
+	// Merge the segments at the same height
+	for ( Uint32 i = 0; i + 1 < mSkyline.size(); ) {
+		if ( mSkyline[i].y == mSkyline[ i + 1 ].y ) {
+			mSkyline[i].width += mSkyline[ i + 1 ].width;
+			mSkyline.erase( mSkyline.begin() + i + 1 );
+		} else {
+			i++;
+		}
+	}
+}
+
+void TexturePackerSkyline::grow( Int32 width, Int32 height ) {
+	if ( width > mWidth ) {
+		Node& last = mSkyline.back();
+
+		if ( 0 == last.y ) {
+			last.width += width - mWidth;
+		} else {
+			mSkyline.push_back( Node( mWidth, 0, width - mWidth ) );
+		}
+	}
+
+	mWidth	= width;
+	mHeight	= height;
+}
+
+}}}
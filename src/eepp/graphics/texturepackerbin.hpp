@@ -0,0 +1,114 @@
+#ifndef EE_GRAPHICSPRIVATECTEXTUREPACKERBIN
+#define EE_GRAPHICSPRIVATECTEXTUREPACKERBIN
+
+#include <eepp/graphics/base.hpp>
+
+namespace EE { namespace Graphics { namespace Private {
+
+/** @brief A bin where the texture packer places the rectangles of the textures.
+**	The bin can grow keeping the rectangles already placed, so the packer never restarts the packing when the atlas must be bigger. */
+class TexturePackerBin {
+	public:
+		struct Box {
+			Box() : x(0), y(0), width(0), height(0) {}
+
+			Box( Int32 x, Int32 y, Int32 width, Int32 height ) : x(x), y(y), width(width), height(height) {}
+
+			Int32 x;
+			Int32 y;
+			Int32 width;
+			Int32 height;
+		};
+
+		TexturePackerBin( Int32 width, Int32 height, bool allowFlipping );
+
+		virtual ~TexturePackerBin();
+
+		/** Finds a place for the rectangle and reserves it.
+		**	@param flipped Returns true if the rectangle was placed rotated ( width and height swapped )
+		**	@return False if the rectangle doesn't fit in the bin */
+		virtual bool insert( Int32 width, Int32 height, Int32& x, Int32& y, bool& flipped ) = 0;
+
+		/** Grows the bin to the new size, keeping the rectangles already placed. */
+		virtual void grow( Int32 width, Int32 height ) = 0;
+
+		const Int32& getWidth() const;
+
+		const Int32& getHeight() const;
+
+		/** @return The area of the rectangles placed */
+		const Int64& getUsedArea() const;
+
+		/** @return The size of the smallest rectangle that contains every rectangle placed */
+		Sizei getUsedSize() const;
+	protected:
+		Int32	mWidth;
+		Int32	mHeight;
+		bool	mAllowFlipping;
+		Int64	mUsedArea;
+		Sizei	mUsedSize;
+
+		void addUsed( const Box& box );
+};
+
+/** @brief MaxRects bin: keeps the list of the maximal free rectangles and places every rectangle in the free rectangle
+**	that leaves the shortest leftover side ( best short side fit ). */
+class TexturePackerMaxRects : public TexturePackerBin {
+	public:
+		TexturePackerMaxRects( Int32 width, Int32 height, bool allowFlipping );
+
+		bool insert( Int32 width, Int32 height, Int32& x, Int32& y, bool& flipped );
+
+		void grow( Int32 width, Int32 height );
+
+		/** Marks a rectangle as used, for the rectangles placed before creating the bin ( when updating an existing atlas ). */
+		void reserve( Int32 x, Int32 y, Int32 width, Int32 height );
+	protected:
+		std::vector<Box>	mFree;
+		std::vector<Box>	mNewFree;
+
+		void placeBox( const Box& box );
+
+		bool splitFreeBox( const Box& freeBox, const Box& used );
+
+		void insertNewFreeBox( const Box& box );
+
+		void pruneFreeList();
+};
+
+/** @brief Skyline bin: keeps the top edge of the rectangles placed as a list of horizontal segments.
+**	It's faster than MaxRects and uses less memory, but it wastes the space below the skyline. */
+class TexturePackerSkyline : public TexturePackerBin {
+	public:
+		enum Heuristic {
+			BottomLeft,		///< Places the rectangles as low as possible
+			MinWaste		///< Places the rectangles where they leave the least area wasted below them
+		};
+
+		TexturePackerSkyline( Int32 width, Int32 height, bool allowFlipping, Heuristic heuristic );
+
+		bool insert( Int32 width, Int32 height, Int32& x, Int32& y, bool& flipped );
+
+		void grow( Int32 width, Int32 height );
+	protected:
+		struct Node {
+			Node( Int32 x, Int32 y, Int32 width ) : x(x), y(y), width(width) {}
+
+			Int32 x;
+			Int32 y;
+			Int32 width;
+		};
+
+		std::vector<Node>	mSkyline;
+		Heuristic			mHeuristic;
+
+		bool fits( Uint32 index, Int32 width, Int32 height, Int32& y ) const;
+
+		Int64 wastedArea( Uint32 index, Int32 width, Int32 y ) const;
+
+		void addLevel( Uint32 index, const Box& box );
+};
+
+}}}
+
+#endif
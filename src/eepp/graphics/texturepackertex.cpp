@@ -4,7 +4,7 @@
 
 namespace EE { namespace Graphics { namespace Private {
 
-TexturePackerTex::TexturePackerTex( const std::string& Name ) :
+TexturePackerTex::TexturePackerTex( const std::string& Name, const bool& LoadInfo ) :
 	mName(Name),
 	mWidth(0),
 	mHeight(0),
@@ -13,17 +13,15 @@ TexturePackerTex::TexturePackerTex( const std::string& Name ) :
 	mY(0),
 	mLongestEdge(0),
 	mArea(0),
+	mHash(0),
 	mFlipped(false),
 	mPlaced(false),
 	mLoadedInfo(false),
 	mDisabled(false),
 	mImg( NULL )
 {
-	if ( stbi_info( Name.c_str(), &mWidth, &mHeight, &mChannels ) ) {
-		mArea 			= mWidth * mHeight;
-		mLongestEdge 	= ( mWidth >= mHeight ) ? mWidth : mHeight;
-		mLoadedInfo 	= true;
-	}
+	if ( LoadInfo )
+		loadInfo();
 }
 
 TexturePackerTex::TexturePackerTex( EE::Graphics::Image * Img , const std::string& Name ) :
@@ -35,6 +33,7 @@ TexturePackerTex::TexturePackerTex( EE::Graphics::Image * Img , const std::strin
 	mY(0),
 	mLongestEdge(0),
 	mArea(0),
+	mHash(0),
 	mFlipped(false),
 	mPlaced(false),
 	mLoadedInfo(false),
@@ -46,6 +45,16 @@ TexturePackerTex::TexturePackerTex( EE::Graphics::Image * Img , const std::strin
 	mLoadedInfo 	= true;
 }
 
+bool TexturePackerTex::loadInfo() {
+	if ( NULL == mImg && stbi_info( mName.c_str(), &mWidth, &mHeight, &mChannels ) ) {
+		mArea 			= mWidth * mHeight;
+		mLongestEdge 	= ( mWidth >= mHeight ) ? mWidth : mHeight;
+		mLoadedInfo 	= true;
+	}
+
+	return mLoadedInfo;
+}
+
 void TexturePackerTex::place( Int32 x, Int32 y, bool flipped ) {
 	if ( !mPlaced ) {
 		mX 			= x;
@@ -11,10 +11,14 @@ namespace Private {
 
 class TexturePackerTex {
 	public:
-		TexturePackerTex( const std::string& name );
+		/** @param loadInfo If false the image info is not read until loadInfo() is called, so it can be read from another thread */
+		TexturePackerTex( const std::string& name, const bool& loadInfo = true );
 
 		TexturePackerTex( EE::Graphics::Image * Img, const std::string& name );
 
+		/** Reads the image size and channels from the image file */
+		bool					loadInfo();
+
 		void 					place( Int32 x, Int32 y, bool flipped );
 
 		inline const std::string& name() const				{ return mName; }
@@ -69,6 +73,11 @@ class TexturePackerTex {
 
 		inline void 			offsetY( const Int32& offy ){ mDestHeight = offy; }
 
+		/** @return The hash of the image file content, 0 until the texture atlas is saved */
+		inline const Uint32&	hash() const				{ return mHash; }
+
+		inline void				hash( const Uint32& hash )	{ mHash = hash; }
+
 		EE::Graphics::Image *	getImage() const;
 	protected:
 		std::string mName;
@@ -83,6 +92,7 @@ class TexturePackerTex {
 		Int32		mDestHeight;
 		Int32		mOffsetX;
 		Int32		mOffsetY;
+		Uint32		mHash;
 		bool  		mFlipped;
 		bool  		mPlaced;
 		bool		mLoadedInfo;
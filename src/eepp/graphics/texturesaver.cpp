@@ -8,7 +8,7 @@ TextureSaver::TextureSaver( int textureBind ) :
 	mTextureBinded( 0 ),
 	mTextureToBind( textureBind )
 {
-	glGetIntegerv( GL_TEXTURE_BINDING_2D, &mTextureBinded );
+	GLi->getIntegerv( GL_TEXTURE_BINDING_2D, &mTextureBinded );
 
 	if ( mTextureToBind > 0 && mTextureBinded != mTextureToBind )
 		GLi->bindTexture( GL_TEXTURE_2D, mTextureToBind );
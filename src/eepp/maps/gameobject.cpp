@@ -1,8 +1,22 @@
 #include <eepp/maps/gameobject.hpp>
 #include <eepp/maps/tilemaplayer.hpp>
+#include <eepp/maps/mapobjectlayer.hpp>
+#include <eepp/maps/gameobjectsubtextureex.hpp>
+#include <eepp/maps/gameobjectsprite.hpp>
+#include <eepp/maps/gameobjectvirtual.hpp>
 
 namespace EE { namespace Maps {
 
+PoolAllocator& GameObject::getAllocator() {
+	// Never destroyed, the game objects can be released by static destructors running after the pool would be destroyed
+	static PoolAllocator * sAllocator = new PoolAllocator(
+		eemax( eemax( sizeof(GameObjectSubTexture), sizeof(GameObjectSubTextureEx) ), eemax( sizeof(GameObjectSprite), sizeof(GameObjectVirtual) ) ),
+		1024
+	);
+
+	return *sAllocator;
+}
+
 GameObject::GameObject(  const Uint32& Flags, MapLayer * Layer ) :
 	mFlags( Flags ),
 	mLayer( Layer )
@@ -32,12 +46,16 @@ Uint32 GameObject::getFlag( const Uint32& Flag ) {
 void GameObject::setFlag( const Uint32& Flag ) {
 	if ( !( mFlags & Flag ) ) {
 		mFlags |= Flag;
+
+		invalidateTile();
 	}
 }
 
 void GameObject::clearFlag( const Uint32& Flag ) {
 	if ( mFlags & Flag ) {
 		mFlags &= ~Flag;
+
+		invalidateTile();
 	}
 }
 
@@ -85,6 +103,8 @@ Vector2f GameObject::getPosition() const {
 
 void GameObject::setPosition( Vector2f pos ) {
 	autoFixTilePos();
+
+	invalidateBounds();
 }
 
 Vector2i GameObject::getTilePosition() const {
@@ -134,13 +154,27 @@ void GameObject::autoFixTilePos() {
 		if ( CurPos != NewPos ) {
 			TileMapLayer * TLayer = static_cast<TileMapLayer *> ( mLayer );
 
-			if ( TLayer->getGameObject( CurPos ) == this ) {
+			if ( TLayer->findGameObject( CurPos ) == this ) {
 				TLayer->moveTileObject( CurPos, NewPos );
 			}
 		}
 	}
 }
 
+void GameObject::invalidateTile() {
+	if ( NULL != mLayer && mLayer->getType() == MAP_LAYER_TILED ) {
+		static_cast<TileMapLayer *> ( mLayer )->invalidateTile( getTilePosition() );
+	} else {
+		invalidateBounds();
+	}
+}
+
+void GameObject::invalidateBounds() {
+	if ( NULL != mLayer && mLayer->getType() == MAP_LAYER_OBJECT ) {
+		static_cast<MapObjectLayer *> ( mLayer )->invalidateGameObject( this );
+	}
+}
+
 void GameObject::assignTilePos() {
 	TileMapLayer * TLayer = static_cast<TileMapLayer *> ( mLayer );
 
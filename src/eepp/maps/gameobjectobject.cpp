@@ -56,6 +56,8 @@ void GameObjectObject::setPosition( Vector2f pos ) {
 	mPoly.move( pos - mPos );
 	mPos	= pos;
 	mRect	= Rectf( pos, Sizef( getSize().x, getSize().y ) );
+
+	invalidateBounds();
 }
 
 void GameObjectObject::setPolygonPoint( Uint32 index, Vector2f p ) {
@@ -91,6 +93,8 @@ void GameObjectObject::setPolygonPoint( Uint32 index, Vector2f p ) {
 	mRect	= mPoly.getBounds();
 	mPos	= Vector2f( mRect.Left, mRect.Top );
 	mPoly	= mRect;
+
+	invalidateBounds();
 }
 
 Uint32 GameObjectObject::getDataId() {
@@ -45,6 +45,8 @@ void GameObjectPolygon::setPolygonPoint( Uint32 index, Vector2f p ) {
 	mPoly.setAt( index, p );
 	mRect	= mPoly.getBounds();
 	mPos	= Vector2f( mRect.Left, mRect.Top );
+
+	invalidateBounds();
 }
 
 bool GameObjectPolygon::pointInside( const Vector2f& p ) {
@@ -109,6 +109,8 @@ Graphics::SubTexture * GameObjectSubTexture::getSubTexture() const {
 
 void GameObjectSubTexture::setSubTexture( Graphics::SubTexture * subTexture ) {
 	mSubTexture = subTexture;
+
+	invalidateTile();
 }
 
 Uint32 GameObjectSubTexture::getDataId() {
@@ -123,6 +123,8 @@ Vector2f GameObjectVirtual::getPosition() const {
 
 void GameObjectVirtual::setPosition( Vector2f pos ) {
 	mPos = pos;
+
+	invalidateBounds();
 }
 
 Uint32 GameObjectVirtual::getDataId() {
@@ -887,6 +887,9 @@ void MapEditor::mapOpen( const UIEvent * Event ) {
 void MapEditor::onMapLoad() {
 	mCurLayer = NULL;
 
+	//! The chunks of a streamed map can be unloaded, losing the edits
+	mUIMap->Map()->loadAllChunks();
+
 	mUIMap->Map()->setViewSize( mUIMap->getRealSize() );
 
 	mapCreated();
@@ -6,7 +6,8 @@ MapLight::MapLight() :
 	mRadius( 0 ),
 	mColor( 255, 255, 255 ),
 	mType( LIGHT_NORMAL ),
-	mActive( true )
+	mActive( true ),
+	mDirty( false )
 {
 }
 
@@ -14,12 +15,16 @@ MapLight::~MapLight() {
 }
 
 MapLight::MapLight( const Float& Radius, const Float& x, const Float& y, const RGB& Color, LIGHT_TYPE Type ) :
-	mActive( true )
+	mRadius( 0 ),
+	mActive( true ),
+	mDirty( false )
 {
 	create( Radius, x, y, Color, Type );
 }
 
 void MapLight::create( const Float& Radius, const Float& x, const Float& y, const RGB& Color, LIGHT_TYPE Type ) {
+	invalidate();
+
 	mRadius	= Radius;
 	mColor	= Color;
 	mType	= Type;
@@ -116,6 +121,8 @@ Color MapLight::processVertex( const Vector2f& Pos, const Color& VertexColor, co
 }
 
 void MapLight::updatePos( const Float& x, const Float& y ) {
+	invalidate();
+
 	mPos.x = x;
 	mPos.y = y;
 	updateAABB();
@@ -150,6 +157,8 @@ const Float& MapLight::getRadius() const {
 
 void MapLight::setRadius( const Float& radius ) {
 	if ( radius > 0 ) {
+		invalidate();
+
 		mRadius = radius;
 		updateAABB();
 	}
@@ -160,10 +169,14 @@ const bool& MapLight::isActive() const {
 }
 
 void MapLight::setActive( const bool& active ) {
+	invalidate();
+
 	mActive = active;
 }
 
 void MapLight::setColor( const RGB& color ) {
+	invalidate();
+
 	mColor = color;
 }
 
@@ -172,6 +185,8 @@ const RGB& MapLight::getColor() const {
 }
 
 void MapLight::setType( const LIGHT_TYPE& type ) {
+	invalidate();
+
 	mType = type;
 	updateAABB();
 }
@@ -184,4 +199,26 @@ const Vector2f& MapLight::getPosition() const {
 	return mPos;
 }
 
+void MapLight::invalidate() {
+	// Accumulates the areas lit since the last update, the light can change many times between updates
+	if ( mDirty ) {
+		mDirtyAABB.expand( mAABB );
+	} else {
+		mDirtyAABB	= mAABB;
+		mDirty		= true;
+	}
+}
+
+const bool& MapLight::isDirty() const {
+	return mDirty;
+}
+
+const Rectf& MapLight::getDirtyAABB() const {
+	return mDirtyAABB;
+}
+
+void MapLight::clearDirty() {
+	mDirty = false;
+}
+
 }}
@@ -3,9 +3,44 @@
 
 namespace EE { namespace Maps {
 
+//! Lights a row of colors. It gives the same result than MapLight::processVertex, but it's written without branches so the
+//! compiler can vectorize the loops.
+static void lightRow( Color * colors, Float * weights, const Int32& count, const Float& x, const Float& stepX, const Float& dy, MapLight * light ) {
+	const Vector2f& pos	= light->getPosition();
+	const RGB& color	= light->getColor();
+	Float invRadius		= (Float)1 / light->getRadius();
+	Float xScale		= LIGHT_ISOMETRIC == light->getType() ? (Float)0.5 : (Float)1;
+	Float distScale		= LIGHT_ISOMETRIC == light->getType() ? (Float)2 : (Float)1;
+	Float dy2			= dy * dy;
+	Float lr			= color.r;
+	Float lg			= color.g;
+	Float lb			= color.b;
+
+	// The weight of the light is 1 at the center and 0 at the radius ( and beyond )
+	for ( Int32 i = 0; i < count; i++ ) {
+		Float dx	= ( x + i * stepX - pos.x ) * xScale;
+		Float w		= (Float)1 - eesqrt( dx * dx + dy2 ) * distScale * invRadius;
+		weights[i]	= w > 0 ? w : 0;
+	}
+
+	// The light only brightens the color: color + ( light color - color ) * weight
+	for ( Int32 i = 0; i < count; i++ ) {
+		Float r		= colors[i].r;
+		Float g		= colors[i].g;
+		Float b		= colors[i].b;
+		Float dr	= lr - r;
+		Float dg	= lg - g;
+		Float db	= lb - b;
+
+		colors[i].r	= (Uint8)( r + ( dr > 0 ? dr : 0 ) * weights[i] );
+		colors[i].g	= (Uint8)( g + ( dg > 0 ? dg : 0 ) * weights[i] );
+		colors[i].b	= (Uint8)( b + ( db > 0 ? db : 0 ) * weights[i] );
+	}
+}
+
 MapLightManager::MapLightManager( TileMap * Map, bool ByVertex ) :
 	mMap( Map ),
-	mTileColors( NULL )
+	mVersion( 0 )
 {
 	mIsByVertex = ByVertex;
 
@@ -23,6 +58,26 @@ MapLightManager::~MapLightManager() {
 }
 
 void MapLightManager::update() {
+	if ( !mLights.size() )
+		return;
+
+	if ( mBaseColor != mMap->getBaseColor() ) {
+		mBaseColor = mMap->getBaseColor();
+
+		invalidate();
+	}
+
+	for ( LightsList::iterator it = mLights.begin(); it != mLights.end(); it++ ) {
+		MapLight * Light = (*it);
+
+		if ( Light->isDirty() ) {
+			invalidate( Light->getDirtyAABB() );
+			invalidate( Light->getAABB() );
+
+			Light->clearDirty();
+		}
+	}
+
 	if ( mIsByVertex ) {
 		updateByVertex();
 	} else {
@@ -35,98 +90,123 @@ const bool& MapLightManager::isByVertex() const {
 }
 
 void MapLightManager::updateByVertex() {
-	Vector2i start	= mMap->getStartTile();
-	Vector2i end		= mMap->getEndTile();
-	Rectf VisibleArea	= mMap->getViewAreaAABB();
-	Sizei TileSize		= mMap->getTileSize();
-	Color BaseColor	= mMap->getBaseColor();
-	bool firstLight		= true;
-	Vector2i Pos;
+	// The corners of the visible tiles
+	updateColors( mMap->getStartTile(), mMap->getEndTile() + Vector2i( 1, 1 ) );
+}
 
-	if ( !mLights.size() )
+void MapLightManager::updateByTile() {
+	updateColors( mMap->getStartTile(), mMap->getEndTile() );
+}
+
+void MapLightManager::updateColors( const Vector2i& start, const Vector2i& end ) {
+	if ( start.x >= end.x || start.y >= end.y )
 		return;
 
-	for ( LightsList::iterator it = mLights.begin(); it != mLights.end(); it++ ) {
-		MapLight * Light = (*it);
+	Int32 bxStart	= eemax( start.x, 0 ) / LIGHT_BLOCK_SIZE;
+	Int32 byStart	= eemax( start.y, 0 ) / LIGHT_BLOCK_SIZE;
+	Int32 bxEnd		= eemin( ( eemin( end.x, mColorsSize.x ) - 1 ) / LIGHT_BLOCK_SIZE, mBlocksSize.x - 1 );
+	Int32 byEnd		= eemin( ( eemin( end.y, mColorsSize.y ) - 1 ) / LIGHT_BLOCK_SIZE, mBlocksSize.y - 1 );
+	bool changed	= false;
 
-		if ( firstLight || VisibleArea.intersect( Light->getAABB() ) ) {
-			for ( Int32 x = start.x; x < end.x; x++ ) {
-				for ( Int32 y = start.y; y < end.y; y++ ) {
-					if ( firstLight ) {
-						mTileColors[x][y][0]->r = mTileColors[x][y][1]->r = mTileColors[x][y][2]->r = mTileColors[x][y][3]->r = BaseColor.r;
-						mTileColors[x][y][0]->g = mTileColors[x][y][1]->g = mTileColors[x][y][2]->g = mTileColors[x][y][3]->g = BaseColor.g;
-						mTileColors[x][y][0]->b = mTileColors[x][y][1]->b = mTileColors[x][y][2]->b = mTileColors[x][y][3]->b = BaseColor.b;
-					}
+	for ( Int32 by = byStart; by <= byEnd; by++ ) {
+		for ( Int32 bx = bxStart; bx <= bxEnd; bx++ ) {
+			Uint8& dirty = mDirtyBlocks[ by * mBlocksSize.x + bx ];
 
-					Pos.x = x * TileSize.x;
-					Pos.y = y * TileSize.y;
+			if ( dirty ) {
+				updateBlock( bx, by );
 
-					Rectf TileAABB( Pos.x, Pos.y, Pos.x + TileSize.x, Pos.y + TileSize.y );
+				dirty	= 0;
+				changed	= true;
+			}
+		}
+	}
 
-					if ( TileAABB.intersect( Light->getAABB() ) ) {
-						if ( y > 0 )
-							mTileColors[x][y][0]->assign( *mTileColors[x][y - 1][1] );
-						else
-							mTileColors[x][y][0]->assign( Light->processVertex( Pos.x, Pos.y, *(mTileColors[x][y][0]), *(mTileColors[x][y][0]) ) );
+	if ( changed )
+		mVersion++;
+}
 
-						mTileColors[x][y][1]->assign( Light->processVertex( Pos.x, Pos.y + TileSize.getHeight(), *(mTileColors[x][y][1]), *(mTileColors[x][y][1]) ) );
+Vector2f MapLightManager::getColorPos( const Int32& x, const Int32& y ) const {
+	Sizei TileSize = mMap->getTileSize();
 
-						mTileColors[x][y][2]->assign( Light->processVertex( Pos.x + TileSize.getWidth(), Pos.y + TileSize.getHeight(), *(mTileColors[x][y][2]), *(mTileColors[x][y][2]) ) );
+	if ( mIsByVertex )
+		return Vector2f( x * TileSize.x, y * TileSize.y );
 
-						if ( y > 0 )
-							mTileColors[x][y][3]->assign( *mTileColors[x][y - 1][2] );
-						else
-							mTileColors[x][y][3]->assign( Light->processVertex( Pos.x + TileSize.getWidth(), Pos.y, *(mTileColors[x][y][3]), *(mTileColors[x][y][3]) ) );
-					}
-				}
-			}
+	// The center of the tile
+	Sizei HalfTileSize = TileSize / 2;
 
-			firstLight = false;
-		}
-	}
+	return Vector2f( x * TileSize.x + HalfTileSize.x, y * TileSize.y + HalfTileSize.y );
 }
 
-void MapLightManager::updateByTile() {
-	Vector2i start	= mMap->getStartTile();
-	Vector2i end		= mMap->getEndTile();
-	Rectf VisibleArea	= mMap->getViewAreaAABB();
-	Sizei TileSize		= mMap->getTileSize();
-	Sizei HalfTileSize = mMap->getTileSize() / 2;
-	Color BaseColor	= mMap->getBaseColor();
-	bool firstLight		= true;
-	Vector2i Pos;
-
-	if ( !mLights.size() )
-		return;
+void MapLightManager::updateBlock( const Int32& bx, const Int32& by ) {
+	Int32 x0		= bx * LIGHT_BLOCK_SIZE;
+	Int32 y0		= by * LIGHT_BLOCK_SIZE;
+	Int32 x1		= eemin( x0 + LIGHT_BLOCK_SIZE, mColorsSize.x );
+	Int32 y1		= eemin( y0 + LIGHT_BLOCK_SIZE, mColorsSize.y );
+	Float stepX		= (Float)mMap->getTileSize().x;
+	Float stepY		= (Float)mMap->getTileSize().y;
+	Vector2f origin	= getColorPos( 0, 0 );
+	Vector2f pos0	= getColorPos( x0, y0 );
+	Vector2f pos1	= getColorPos( x1 - 1, y1 - 1 );
+	Color base( mBaseColor.r, mBaseColor.g, mBaseColor.b, 255 );
+	Float weights[ LIGHT_BLOCK_SIZE ];
+
+	for ( Int32 y = y0; y < y1; y++ ) {
+		Color * row = &mColors[ y * mColorsSize.x ];
+
+		for ( Int32 x = x0; x < x1; x++ )
+			row[x] = base;
+	}
 
 	for ( LightsList::iterator it = mLights.begin(); it != mLights.end(); it++ ) {
 		MapLight * Light = (*it);
+		Rectf AABB = Light->getAABB();
 
-		if (  firstLight || VisibleArea.intersect( Light->getAABB() ) ) {
-			for ( Int32 x = start.x; x < end.x; x++ ) {
-				for ( Int32 y = start.y; y < end.y; y++ ) {
-					if ( firstLight ) {
-						mTileColors[x][y][0]->r = BaseColor.r;
-						mTileColors[x][y][0]->g = BaseColor.g;
-						mTileColors[x][y][0]->b = BaseColor.b;
-					}
+		if ( !Light->isActive() || AABB.Right < pos0.x || AABB.Left > pos1.x || AABB.Bottom < pos0.y || AABB.Top > pos1.y )
+			continue;
 
-					Pos.x = x * TileSize.x;
-					Pos.y = y * TileSize.y;
+		// Only the colors inside the light box
+		Int32 lx0 = eemax( x0, (Int32)eefloor( ( AABB.Left - origin.x ) / stepX ) );
+		Int32 lx1 = eemin( x1, (Int32)eefloor( ( AABB.Right - origin.x ) / stepX ) + 1 );
+		Int32 ly0 = eemax( y0, (Int32)eefloor( ( AABB.Top - origin.y ) / stepY ) );
+		Int32 ly1 = eemin( y1, (Int32)eefloor( ( AABB.Bottom - origin.y ) / stepY ) + 1 );
 
-					Rectf TileAABB( Pos.x, Pos.y, Pos.x + TileSize.x, Pos.y + TileSize.y );
+		if ( lx0 >= lx1 )
+			continue;
 
-					if ( TileAABB.intersect( Light->getAABB() ) ) {
-						mTileColors[x][y][0]->assign( Light->processVertex( Pos.x + HalfTileSize.getWidth(), Pos.y + HalfTileSize.getHeight(), *(mTileColors[x][y][0]), *(mTileColors[x][y][0]) ) );
-					}
-				}
-			}
+		for ( Int32 y = ly0; y < ly1; y++ ) {
+			lightRow( &mColors[ y * mColorsSize.x + lx0 ], weights, lx1 - lx0, origin.x + lx0 * stepX, stepX, origin.y + y * stepY - Light->getPosition().y, Light );
+		}
+	}
+}
 
-			firstLight = false;
+void MapLightManager::invalidate() {
+	for ( size_t i = 0; i < mDirtyBlocks.size(); i++ )
+		mDirtyBlocks[i] = 1;
+}
+
+void MapLightManager::invalidate( const Rectf& area ) {
+	Vector2f origin	= getColorPos( 0, 0 );
+	Float stepX		= (Float)mMap->getTileSize().x;
+	Float stepY		= (Float)mMap->getTileSize().y;
+	Int32 x0		= eemax( (Int32)eefloor( ( area.Left - origin.x ) / stepX ), 0 );
+	Int32 y0		= eemax( (Int32)eefloor( ( area.Top - origin.y ) / stepY ), 0 );
+	Int32 x1		= eemin( (Int32)eefloor( ( area.Right - origin.x ) / stepX ) + 1, mColorsSize.x - 1 );
+	Int32 y1		= eemin( (Int32)eefloor( ( area.Bottom - origin.y ) / stepY ) + 1, mColorsSize.y - 1 );
+
+	if ( x0 > x1 || y0 > y1 )
+		return;
+
+	for ( Int32 by = y0 / LIGHT_BLOCK_SIZE; by <= y1 / LIGHT_BLOCK_SIZE; by++ ) {
+		for ( Int32 bx = x0 / LIGHT_BLOCK_SIZE; bx <= x1 / LIGHT_BLOCK_SIZE; bx++ ) {
+			mDirtyBlocks[ by * mBlocksSize.x + bx ] = 1;
 		}
 	}
 }
 
+const Uint32& MapLightManager::getVersion() const {
+	return mVersion;
+}
+
 Color MapLightManager::getColorFromPos( const Vector2f& Pos ) {
 	Color Col( mMap->getBaseColor() );
 
@@ -147,12 +227,29 @@ Color MapLightManager::getColorFromPos( const Vector2f& Pos ) {
 void MapLightManager::addLight( MapLight * Light ) {
 	mLights.push_back( Light );
 
+	invalidate( Light->getAABB() );
+
+	Light->clearDirty();
+
 	if ( mLights.size() == 1 )
 		update();
 }
 
 void MapLightManager::removeLight( MapLight * Light ) {
+	// The light could have moved since the last update, the area lit by its old position must be updated too
+	if ( Light->isDirty() ) {
+		invalidate( Light->getDirtyAABB() );
+
+		Light->clearDirty();
+	}
+
+	invalidate( Light->getAABB() );
+
 	mLights.remove( Light );
+
+	// Without lights the base color is used
+	if ( mLights.empty() )
+		mVersion++;
 }
 
 void MapLightManager::removeLight( const Vector2f& OverPos ) {
@@ -160,8 +257,10 @@ void MapLightManager::removeLight( const Vector2f& OverPos ) {
 		MapLight * Light = (*it);
 
 		if ( Light->getAABB().contains( OverPos ) ) {
-			mLights.remove( Light );
+			removeLight( Light );
+
 			eeSAFE_DELETE( Light );
+
 			break;
 		}
 	}
@@ -173,7 +272,7 @@ const Color * MapLightManager::getTileColor( const Vector2i& TilePos ) {
 	if ( !mLights.size() )
 		return &mMap->getBaseColor();
 
-	return mTileColors[ TilePos.x ][ TilePos.y ][0];
+	return &mColors[ TilePos.y * mColorsSize.x + TilePos.x ];
 }
 
 const Color * MapLightManager::getTileColor( const Vector2i& TilePos, const Uint32& Vertex ) {
@@ -182,42 +281,27 @@ const Color * MapLightManager::getTileColor( const Vector2i& TilePos, const Uint
 	if ( !mLights.size() )
 		return &mMap->getBaseColor();
 
-	return mTileColors[ TilePos.x ][ TilePos.y ][Vertex];
+	// The vertexs are ordered: top-left, bottom-left, bottom-right, top-right
+	Int32 x = TilePos.x + ( Vertex >= 2 ? 1 : 0 );
+	Int32 y = TilePos.y + ( Vertex == 1 || Vertex == 2 ? 1 : 0 );
+
+	return &mColors[ y * mColorsSize.x + x ];
 }
 
 void MapLightManager::allocateColors() {
 	Sizei Size		= mMap->getSize();
-	mTileColors		= eeNewArray( Color***, Size.getWidth() );
-
-	for ( Int32 x = 0; x < Size.x; x++ ) {
-		mTileColors[x] = eeNewArray( Color**, Size.getHeight() );
 
-		for ( Int32 y = 0; y < Size.y; y++ ) {
-			mTileColors[x][y] = eeNewArray( Color*, mNumVertex );
+	mColorsSize		= mIsByVertex ? Sizei( Size.x + 1, Size.y + 1 ) : Size;
+	mBlocksSize		= Sizei( ( mColorsSize.x + LIGHT_BLOCK_SIZE - 1 ) / LIGHT_BLOCK_SIZE, ( mColorsSize.y + LIGHT_BLOCK_SIZE - 1 ) / LIGHT_BLOCK_SIZE );
+	mBaseColor		= mMap->getBaseColor();
 
-			for ( Int32 v = 0; v < mNumVertex; v++ ) {
-				mTileColors[x][y][v] = eeNew( Color, (255,255,255,255) );
-			}
-		}
-	}
+	mColors.assign( mColorsSize.x * mColorsSize.y, Color( 255, 255, 255, 255 ) );
+	mDirtyBlocks.assign( mBlocksSize.x * mBlocksSize.y, 1 );
 }
 
 void MapLightManager::deallocateColors() {
-	Sizei Size		= mMap->getSize();
-
-	for ( Int32 x = 0; x < Size.x; x++ ) {
-		for ( Int32 y = 0; y < Size.y; y++ ) {
-			for ( Int32 v = 0; v < mNumVertex; v++ ) {
-				eeSAFE_DELETE( mTileColors[x][y][v] );
-			}
-
-			eeSAFE_DELETE_ARRAY( mTileColors[x][y] );
-		}
-
-		eeSAFE_DELETE_ARRAY( mTileColors[x] );
-	}
-
-	eeSAFE_DELETE_ARRAY( mTileColors );
+	std::vector<Color>().swap( mColors );
+	std::vector<Uint8>().swap( mDirtyBlocks );
 }
 
 void MapLightManager::destroyLights() {
@@ -8,11 +8,29 @@
 #include <eepp/graphics/renderer/renderer.hpp>
 using namespace EE::Graphics;
 
+#include <algorithm>
+
 namespace EE { namespace Maps {
 
+namespace {
+	//! The objects that cover more cells are kept out of the grid
+	static const Int32 MAX_OBJECT_CELLS = 64;
+
+	inline Uint64 entryKey( GameObject * obj ) {
+		return (Uint64)(size_t)obj;
+	}
+
+	inline Int32 cellFromPos( const Float& pos ) {
+		return (Int32)floor( pos / (Float)MapObjectLayer::CELL_SIZE );
+	}
+}
+
 MapObjectLayer::MapObjectLayer( TileMap * map, Uint32 flags, std::string name, Vector2f offset ) :
-	MapLayer( map, MAP_LAYER_OBJECT, flags, name, offset )
+	MapLayer( map, MAP_LAYER_OBJECT, flags, name, offset ),
+	mLastOrder( 0 ),
+	mQuery( 0 )
 {
+	allocateLayer();
 }
 
 MapObjectLayer::~MapObjectLayer() {
@@ -20,25 +38,41 @@ MapObjectLayer::~MapObjectLayer() {
 }
 
 void MapObjectLayer::allocateLayer() {
+	Sizei size( mMap->getTotalSize() );
+
+	mCellsSize.x = eemax( 0, ( size.x + CELL_SIZE - 1 ) / CELL_SIZE );
+	mCellsSize.y = eemax( 0, ( size.y + CELL_SIZE - 1 ) / CELL_SIZE );
 
+	mCells.resize( mCellsSize.x * mCellsSize.y );
 }
 
 void MapObjectLayer::deallocateLayer() {
 	for ( ObjList::iterator it = mObjects.begin(); it != mObjects.end(); it++ ) {
 		eeSAFE_DELETE( *it );
 	}
+
+	mObjects.clear();
+	mEntries.clear();
+	mFreeEntries.clear();
+	mEntryIndex.clear();
+	mCells.clear();
+	mLargeObjects.clear();
 }
 
 void MapObjectLayer::draw( const Vector2f &Offset ) {
 	GlobalBatchRenderer::instance()->draw();
 
-	ObjList::iterator it;
-
 	GLi->pushMatrix();
 	GLi->translatef( mOffset.x, mOffset.y, 0.0f );
 
-	for ( it = mObjects.begin(); it != mObjects.end(); it++ ) {
-		(*it)->draw();
+	//! Only the objects that intersect the view area ( in layer coordinates ) are drawn
+	Rectf view( mMap->getViewAreaAABB() );
+	Float scale = mMap->getScale();
+
+	queryEntries( Rectf( view.Left / scale - mOffset.x, view.Top / scale - mOffset.y, view.Right / scale - mOffset.x, view.Bottom / scale - mOffset.y ) );
+
+	for ( size_t i = 0; i < mResults.size(); i++ ) {
+		mEntries[ (Uint32)mResults[i] ].Obj->draw();
 	}
 
 	Texture * Tex = mMap->getBlankTileTexture();
@@ -46,8 +80,8 @@ void MapObjectLayer::draw( const Vector2f &Offset ) {
 	if ( mMap->getShowBlocked() && NULL != Tex ) {
 		Color Col( 255, 0, 0, 200 );
 
-		for ( it = mObjects.begin(); it != mObjects.end(); it++ ) {
-			GameObject * Obj = (*it);
+		for ( size_t i = 0; i < mResults.size(); i++ ) {
+			GameObject * Obj = mEntries[ (Uint32)mResults[i] ].Obj;
 
 			if ( Obj->isBlocked() ) {
 				Tex->drawEx( Obj->getPosition().x, Obj->getPosition().y, Obj->getSize().getWidth(), Obj->getSize().getHeight(), 0, Vector2f::One, Col, Col, Col, Col );
@@ -62,7 +96,17 @@ void MapObjectLayer::draw( const Vector2f &Offset ) {
 
 void MapObjectLayer::update( const Time& dt ) {
 	for ( ObjList::iterator it = mObjects.begin(); it != mObjects.end(); it++ ) {
-		(*it)->update( dt );
+		GameObject * obj = (*it);
+
+		obj->update( dt );
+
+		//! The dynamic objects can move or change its size while updating
+		if ( !( obj->getFlags() & GObjFlags::GAMEOBJECT_STATIC ) ) {
+			Uint32 * entry = mEntryIndex.find( entryKey( obj ) );
+
+			if ( NULL != entry )
+				updateEntry( *entry );
+		}
 	}
 }
 
@@ -71,11 +115,42 @@ Uint32 MapObjectLayer::getObjectCount() const {
 }
 
 void MapObjectLayer::addGameObject( GameObject * obj ) {
-	mObjects.push_back( obj );
+	Uint32 entry;
+
+	if ( !mFreeEntries.empty() ) {
+		entry = mFreeEntries.back();
+		mFreeEntries.pop_back();
+	} else {
+		entry = mEntries.size();
+		mEntries.push_back( ObjectEntry() );
+	}
+
+	ObjectEntry& e	= mEntries[ entry ];
+	e.Obj			= obj;
+	e.It			= mObjects.insert( mObjects.end(), obj );
+	e.Order			= mLastOrder++;
+	e.Bounds		= getObjectBounds( obj );
+	e.Query			= 0;
+
+	mEntryIndex.insert( entryKey( obj ), entry );
+
+	indexEntry( entry );
 }
 
 void MapObjectLayer::removeGameObject( GameObject * obj ) {
-	mObjects.remove( obj );
+	Uint32 * entryPtr = mEntryIndex.find( entryKey( obj ) );
+
+	if ( NULL != entryPtr ) {
+		Uint32 entry = *entryPtr;
+
+		unindexEntry( entry );
+
+		mObjects.erase( mEntries[ entry ].It );
+		mEntryIndex.erase( entryKey( obj ) );
+
+		mEntries[ entry ].Obj = NULL;
+		mFreeEntries.push_back( entry );
+	}
 
 	eeSAFE_DELETE( obj );
 }
@@ -88,53 +163,196 @@ void MapObjectLayer::removeGameObject( const Vector2i& pos ) {
 	}
 }
 
+void MapObjectLayer::invalidateGameObject( GameObject * obj ) {
+	Uint32 * entry = mEntryIndex.find( entryKey( obj ) );
+
+	if ( NULL != entry )
+		updateEntry( *entry );
+}
+
 GameObject * MapObjectLayer::getObjectOver( const Vector2i& pos, SEARCH_TYPE type ) {
 	GameObject * tObj;
 	Vector2f tPos;
 	Sizei tSize;
 
-	for ( ObjList::reverse_iterator it = mObjects.rbegin(); it != mObjects.rend(); it++ ) {
-		tObj = (*it);
+	queryEntries( Rectf( pos.x, pos.y, pos.x, pos.y ) );
+
+	//! The top most object is the last one drawn
+	for ( Int32 i = (Int32)mResults.size() - 1; i >= 0; i-- ) {
+		tObj = mEntries[ (Uint32)mResults[i] ].Obj;
 
-		if ( type & SEARCH_POLY ) {
-			if ( tObj->isType( GAMEOBJECT_TYPE_OBJECT ) ) {
+		if ( tObj->isType( GAMEOBJECT_TYPE_OBJECT ) ) {
+			if ( type & SEARCH_POLY ) {
 				GameObjectObject * tObjObj = reinterpret_cast<GameObjectObject*> ( tObj );
 
 				if ( tObjObj->pointInside( Vector2f( pos.x, pos.y ) ) )
 					return tObj;
 			}
 		} else if ( type & SEARCH_OBJECT ) {
-			if ( !tObj->isType( GAMEOBJECT_TYPE_OBJECT ) ) {
-				tPos = tObj->getPosition();
-				tSize = tObj->getSize();
+			tPos = tObj->getPosition();
+			tSize = tObj->getSize();
 
-				Rect objR( tPos.x, tPos.y, tPos.x + tSize.x, tPos.y + tSize.y );
+			Rect objR( tPos.x, tPos.y, tPos.x + tSize.x, tPos.y + tSize.y );
 
-				if ( objR.contains( pos ) )
-					return tObj;
+			if ( objR.contains( pos ) )
+				return tObj;
+		}
+	}
+
+	return NULL;
+}
+
+void MapObjectLayer::getObjectsAt( const Vector2f& pos, std::vector<GameObject*>& objects ) {
+	getObjectsInRect( Rectf( pos.x, pos.y, pos.x, pos.y ), objects );
+}
+
+void MapObjectLayer::getObjectsInRect( const Rectf& rect, std::vector<GameObject*>& objects ) {
+	queryEntries( rect );
+
+	for ( size_t i = 0; i < mResults.size(); i++ ) {
+		objects.push_back( mEntries[ (Uint32)mResults[i] ].Obj );
+	}
+}
+
+Rectf MapObjectLayer::getObjectBounds( GameObject * obj ) {
+	Vector2f pos( obj->getPosition() );
+	Sizei size( obj->getSize() );
+	Rectf bounds( pos.x, pos.y, pos.x + size.x, pos.y + size.y );
+
+	if ( obj->isType( GAMEOBJECT_TYPE_OBJECT ) ) {
+		bounds.expand( reinterpret_cast<GameObjectObject*> ( obj )->getPolygon().getBounds() );
+	} else if ( obj->isRotated() && size.x != size.y ) {
+		//! The rotated objects are drawn rotated around their center
+		Float half = eemax( size.x, size.y ) * 0.5f;
+		Vector2f center( pos.x + size.x * 0.5f, pos.y + size.y * 0.5f );
+
+		bounds = Rectf( center.x - half, center.y - half, center.x + half, center.y + half );
+	}
+
+	//! Aligned to pixels, so the bounds also contain the integer rectangles used by getObjectOver
+	return Rectf( floor( bounds.Left ), floor( bounds.Top ), ceil( bounds.Right ), ceil( bounds.Bottom ) );
+}
+
+void MapObjectLayer::indexEntry( const Uint32& entry ) {
+	ObjectEntry& e = mEntries[ entry ];
+	Rect cells( cellFromPos( e.Bounds.Left ), cellFromPos( e.Bounds.Top ), cellFromPos( e.Bounds.Right ), cellFromPos( e.Bounds.Bottom ) );
+
+	if ( cells.Left < 0 || cells.Top < 0 || cells.Right >= mCellsSize.x || cells.Bottom >= mCellsSize.y ||
+		 ( cells.Right - cells.Left + 1 ) * ( cells.Bottom - cells.Top + 1 ) > MAX_OBJECT_CELLS )
+	{
+		e.Cells = Rect( 0, 0, -1, -1 );
+
+		mLargeObjects.push_back( entry );
+
+		return;
+	}
+
+	e.Cells = cells;
+
+	for ( Int32 cx = cells.Left; cx <= cells.Right; cx++ ) {
+		for ( Int32 cy = cells.Top; cy <= cells.Bottom; cy++ ) {
+			mCells[ cx * mCellsSize.y + cy ].push_back( entry );
+		}
+	}
+}
+
+void MapObjectLayer::unindexEntry( const Uint32& entry ) {
+	ObjectEntry& e = mEntries[ entry ];
+
+	if ( e.Cells.Right < e.Cells.Left ) {
+		std::vector<Uint32>::iterator it = std::find( mLargeObjects.begin(), mLargeObjects.end(), entry );
+
+		if ( it != mLargeObjects.end() ) {
+			*it = mLargeObjects.back();
+			mLargeObjects.pop_back();
+		}
+
+		return;
+	}
+
+	for ( Int32 cx = e.Cells.Left; cx <= e.Cells.Right; cx++ ) {
+		for ( Int32 cy = e.Cells.Top; cy <= e.Cells.Bottom; cy++ ) {
+			std::vector<Uint32>& cell = mCells[ cx * mCellsSize.y + cy ];
+			std::vector<Uint32>::iterator it = std::find( cell.begin(), cell.end(), entry );
+
+			if ( it != cell.end() ) {
+				*it = cell.back();
+				cell.pop_back();
 			}
-		} else {
-			if ( tObj->isType( GAMEOBJECT_TYPE_OBJECT ) ) {
-				GameObjectObject * tObjObj = reinterpret_cast<GameObjectObject*> ( tObj );
+		}
+	}
+}
 
-				if ( tObjObj->pointInside( Vector2f( pos.x, pos.y ) ) )
-					return tObj;
-			} else {
-				tPos = tObj->getPosition();
-				tSize = tObj->getSize();
+void MapObjectLayer::updateEntry( const Uint32& entry ) {
+	ObjectEntry& e = mEntries[ entry ];
+	Rectf bounds( getObjectBounds( e.Obj ) );
 
-				Rect objR( tPos.x, tPos.y, tPos.x + tSize.x, tPos.y + tSize.y );
+	if ( bounds.Left == e.Bounds.Left && bounds.Top == e.Bounds.Top && bounds.Right == e.Bounds.Right && bounds.Bottom == e.Bounds.Bottom )
+		return;
 
-				if ( objR.contains( pos ) )
-					return tObj;
+	//! The object only needs to be moved between cells if it covers other cells now
+	bool sameCells = e.Cells.Right >= e.Cells.Left &&
+					 cellFromPos( bounds.Left ) == e.Cells.Left && cellFromPos( bounds.Top ) == e.Cells.Top &&
+					 cellFromPos( bounds.Right ) == e.Cells.Right && cellFromPos( bounds.Bottom ) == e.Cells.Bottom;
+
+	if ( sameCells ) {
+		e.Bounds = bounds;
+	} else {
+		unindexEntry( entry );
+
+		e.Bounds = bounds;
+
+		indexEntry( entry );
+	}
+}
+
+void MapObjectLayer::queryEntries( Rectf rect ) {
+	mResults.clear();
+
+	//! Every entry is visited once per query, even if it covers many cells
+	if ( 0 == ++mQuery ) {
+		for ( size_t i = 0; i < mEntries.size(); i++ )
+			mEntries[i].Query = 0;
+
+		mQuery = 1;
+	}
+
+	for ( size_t i = 0; i < mLargeObjects.size(); i++ ) {
+		ObjectEntry& e = mEntries[ mLargeObjects[i] ];
+
+		if ( e.Bounds.intersect( rect ) )
+			mResults.push_back( ( (Uint64)e.Order << 32 ) | mLargeObjects[i] );
+	}
+
+	if ( mCellsSize.x > 0 && mCellsSize.y > 0 ) {
+		Int32 cxStart	= eemax( 0, cellFromPos( rect.Left ) );
+		Int32 cyStart	= eemax( 0, cellFromPos( rect.Top ) );
+		Int32 cxEnd		= eemin( mCellsSize.x - 1, cellFromPos( rect.Right ) );
+		Int32 cyEnd		= eemin( mCellsSize.y - 1, cellFromPos( rect.Bottom ) );
+
+		for ( Int32 cx = cxStart; cx <= cxEnd; cx++ ) {
+			for ( Int32 cy = cyStart; cy <= cyEnd; cy++ ) {
+				std::vector<Uint32>& cell = mCells[ cx * mCellsSize.y + cy ];
+
+				for ( size_t i = 0; i < cell.size(); i++ ) {
+					ObjectEntry& e = mEntries[ cell[i] ];
+
+					if ( e.Query != mQuery ) {
+						e.Query = mQuery;
+
+						if ( e.Bounds.intersect( rect ) )
+							mResults.push_back( ( (Uint64)e.Order << 32 ) | cell[i] );
+					}
+				}
 			}
 		}
 	}
 
-	return NULL;
+	//! Sorting by the order sorts the objects in drawing order
+	std::sort( mResults.begin(), mResults.end() );
 }
 
-MapObjectLayer::ObjList& MapObjectLayer::getObjectList() {
+const MapObjectLayer::ObjList& MapObjectLayer::getObjectList() const {
 	return mObjects;
 }
 
@@ -8,6 +8,7 @@
 #include <eepp/maps/gameobjectpolyline.hpp>
 #include <eepp/maps/tilemaplayer.hpp>
 #include <eepp/maps/mapobjectlayer.hpp>
+#include <eepp/maps/tilemapstreamer.hpp>
 
 #include <eepp/system/packmanager.hpp>
 #include <eepp/graphics/renderer/opengl.hpp>
@@ -20,6 +21,8 @@ using namespace EE::Graphics;
 
 #include <eepp/ui/uithememanager.hpp>
 
+#include <zlib.h>
+
 namespace EE { namespace Maps {
 
 TileMap::TileMap() :
@@ -41,7 +44,10 @@ TileMap::TileMap() :
 	mScale( 1 ),
 	mOffscale( 1, 1 ),
 	mLastObjId( 0 ),
-	mForcedHeaders( NULL )
+	mForcedHeaders( NULL ),
+	mStreamer( NULL ),
+	mStreamingBudget( 64 * 1024 * 1024 ),
+	mStreamingMargin( 1 )
 {
 	setViewSize( mViewSize );
 }
@@ -74,6 +80,12 @@ void TileMap::disableForcedHeaders() {
 }
 
 void TileMap::deleteLayers() {
+	if ( NULL != mStreamer ) {
+		eeSAFE_DELETE( mStreamer );
+
+		mPolyObjs.clear();
+	}
+
 	eeSAFE_DELETE( mLightManager );
 
 	for ( Uint32 i = 0; i < mLayerCount; i++ )
@@ -236,6 +248,10 @@ void TileMap::draw() {
 
 	gridDraw();
 
+	//! The visible chunks that weren't loaded in background are loaded now, so the tiles never pop in
+	if ( NULL != mStreamer )
+		mStreamer->load( mStartTile, mEndTile );
+
 	for ( Uint32 i = 0; i < mLayerCount; i++ ) {
 		if ( mLayers[i]->isVisible() )
 			mLayers[i]->draw();
@@ -340,6 +356,8 @@ void TileMap::getMouseOverTile() {
 }
 
 void TileMap::calcTilesClip() {
+	updateScreenAABB();
+
 	if ( mTileSize.x > 0 && mTileSize.y > 0 ) {
 		Vector2f ffoff( mOffset );
 		Vector2i foff( (Int32)ffoff.x, (Int32)ffoff.y );
@@ -361,6 +379,9 @@ void TileMap::calcTilesClip() {
 
 		if ( mEndTile.y > mSize.y )
 			mEndTile.y = mSize.y;
+
+		if ( NULL != mStreamer )
+			mStreamer->request( mStartTile, mEndTile );
 	}
 }
 
@@ -445,6 +466,9 @@ void TileMap::update() {
 
 	updateScreenAABB();
 
+	if ( NULL != mStreamer )
+		mStreamer->update( mStartTile, mEndTile );
+
 	if ( NULL != mLightManager )
 		mLightManager->update();
 
@@ -799,7 +823,7 @@ bool TileMap::loadFromStream( IOStream& IOS ) {
 	if ( IOS.isOpen() ) {
 		IOS.read( (char*)&MapHdr, sizeof(sMapHdr) );
 
-		if ( MapHdr.Magic == EE_MAP_MAGIC ) {
+		if ( MapHdr.Magic == EE_MAP_MAGIC || MapHdr.Magic == EE_MAP_MAGIC_CHUNKED ) {
 			if ( NULL == mForcedHeaders ) {
 				create( Sizei( MapHdr.SizeX, MapHdr.SizeY ), MapHdr.MaxLayers, Sizei( MapHdr.TileSizeX, MapHdr.TileSizeY ), MapHdr.Flags );
 			} else {
@@ -899,14 +923,14 @@ bool TileMap::loadFromStream( IOStream& IOS ) {
 
 				Int32 x, y;
 				Uint32 tReadFlag = 0;
-				TileMapLayer * tTLayer;
 				GameObject * tGO;
 
 				if ( NULL != mForcedHeaders ) {
 					mSize = Sizei( MapHdr.SizeX, MapHdr.SizeY );
 				}
 
-				if ( ThereIsTiled ) {
+				//! The chunked maps store the tiles at the end of the file
+				if ( ThereIsTiled && EE_MAP_MAGIC == MapHdr.Magic ) {
 					//! First we read the tiled layers.
 					for ( y = 0; y < mSize.y; y++ ) {
 						for ( x = 0; x < mSize.x; x++ ) {
@@ -917,15 +941,11 @@ bool TileMap::loadFromStream( IOStream& IOS ) {
 							//! Read every game object header corresponding to this tile
 							for ( i = 0; i < mLayerCount; i++ ) {
 								if ( tReadFlag & ( 1 << i ) ) {
-									tTLayer = reinterpret_cast<TileMapLayer*> ( mLayers[i] );
-
 									sMapTileGOHdr tTGOHdr;
 
 									IOS.read( (char*)&tTGOHdr, sizeof(sMapTileGOHdr) );
 
-									tGO = createGameObject( tTGOHdr.Type, tTGOHdr.Flags, mLayers[i], tTGOHdr.Id );
-
-									tTLayer->addGameObject( tGO, Vector2i( x, y ) );
+									addTile( i, tTGOHdr, Vector2i( x, y ) );
 								}
 							}
 						}
@@ -1021,11 +1041,23 @@ bool TileMap::loadFromStream( IOStream& IOS ) {
 				}
 
 				eeSAFE_DELETE_ARRAY( tLayersHdr );
+
+				if ( ThereIsTiled && EE_MAP_MAGIC_CHUNKED == MapHdr.Magic ) {
+					if ( !loadChunkIndex( IOS, MapHdr ) )
+						return false;
+
+					//! Loads the chunks of the initial view, and queues the chunks around them
+					calcTilesClip();
+
+					mStreamer->load( mStartTile, mEndTile );
+				}
 			}
 
 			onMapLoaded();
 
-			mPolyObjs.clear();
+			//! The chunks loaded later can have polygon objects
+			if ( NULL == mStreamer )
+				mPolyObjs.clear();
 
 			return true;
 		}
@@ -1062,7 +1094,7 @@ bool TileMap::loadFromPack( Pack * Pack, const std::string& FilePackPath ) {
 	if ( NULL != Pack && Pack->isOpen() && -1 != Pack->exists( FilePackPath ) ) {
 		SafeDataPointer PData;
 
-		Pack->extractFileToMemory( FilePackPath, PData );
+		Pack->getFileView( FilePackPath, PData );
 
 		return loadFromMemory( reinterpret_cast<const char*> ( PData.Data ), PData.DataSize );
 	}
@@ -1076,14 +1108,17 @@ bool TileMap::loadFromMemory( const char * Data, const Uint32& DataSize ) {
 	return loadFromStream( IOS );
 }
 
-void TileMap::saveToStream( IOStream& IOS ) {
+void TileMap::saveToStream( IOStream& IOS, const EE_MAP_FORMAT& format ) {
 	Uint32 i;
 	sMapHdr MapHdr;
 	MapLayer * tLayer;
 
+	//! The tiles of the chunks not loaded would be lost
+	loadAllChunks();
+
 	std::vector<std::string> TextureAtlases = getTextureAtlases();
 
-	MapHdr.Magic					= EE_MAP_MAGIC;
+	MapHdr.Magic					= MAP_FORMAT_CHUNKED == format ? EE_MAP_MAGIC_CHUNKED : EE_MAP_MAGIC;
 	MapHdr.Flags					= mFlags;
 	MapHdr.MaxLayers				= mMaxLayers;
 	MapHdr.SizeX					= mSize.getWidth();
@@ -1188,71 +1223,19 @@ void TileMap::saveToStream( IOStream& IOS ) {
 			}
 		}
 
-		//! This method is slow, but allows to save big maps with little space needed, i'll add an alternative save method ( just plain layer -> tile object saving )
-		Int32 x, y;
-		Uint32 tReadFlag = 0, z;
-		TileMapLayer * tTLayer;
 		GameObject * tObj;
 
-		std::vector<GameObject*> tObjects( mLayerCount );
-
-		if ( ThereIsTiled ) {
-			//! First we save the tiled layers.
-			for ( y = 0; y < mSize.y; y++ ) {
-				for ( x = 0; x < mSize.x; x++ ) {
-					//! Reset Layer Read Flags and temporal objects
-					tReadFlag		= 0;
+		//! The legacy format stores the tiles after the layer headers, row by row
+		if ( ThereIsTiled && MAP_FORMAT_LEGACY == format ) {
+			std::vector<Uint8> tRecords;
 
-					for ( z = 0; z < mLayerCount; z++ )
-						tObjects[z] = NULL;
+			for ( Int32 y = 0; y < mSize.y; y++ ) {
+				tRecords.clear();
 
-					//! Look at every layer if it's some data on the current tile, in that case it will write a bit flag to
-					//! inform that it's an object on the current tile layer, and it will store a temporal reference to the
-					//! object to write layer the object header information
-					for ( i = 0; i < mLayerCount; i++ ) {
-						tLayer = mLayers[i];
+				getTileRecords( Vector2i( 0, y ), Vector2i( mSize.x, y + 1 ), tRecords );
 
-						if ( NULL != tLayer && tLayer->getType() == MAP_LAYER_TILED ) {
-							tTLayer = reinterpret_cast<TileMapLayer*> ( tLayer );
-
-							tObj = tTLayer->getGameObject( Vector2i( x, y ) );
-
-							if ( NULL != tObj ) {
-								tReadFlag |= 1 << i;
-
-								tObjects[i] = tObj;
-							}
-						}
-					}
-
-					//! Writes the current tile flags
-					IOS.write( (const char*)&tReadFlag, sizeof(Uint32) );
-
-					//! Writes every game object header corresponding to this tile
-					for ( i = 0; i < mLayerCount; i++ ) {
-						if ( tReadFlag & ( 1 << i ) ) {
-							tObj = tObjects[i];
-
-							sMapTileGOHdr tTGOHdr;
-
-							//! The DataId should be the SubTexture hash name ( at least in the cases of type SubTexture, SubTextureEx and Sprite.
-							tTGOHdr.Id		= tObj->getDataId();
-
-							//! If the object type is virtual, means that the real type is stored elsewhere.
-							if ( tObj->getType() != GAMEOBJECT_TYPE_VIRTUAL ) {
-								tTGOHdr.Type	= tObj->getType();
-							} else {
-								GameObjectVirtual * tObjV = reinterpret_cast<GameObjectVirtual*> ( tObj );
-
-								tTGOHdr.Type	= tObjV->getRealType();
-							}
-
-							tTGOHdr.Flags	= tObj->getFlags();
-
-							IOS.write( (const char*)&tTGOHdr, sizeof(sMapTileGOHdr) );
-						}
-					}
-				}
+				if ( !tRecords.empty() )
+					IOS.write( (const char*)&tRecords[0], tRecords.size() );
 			}
 		}
 
@@ -1265,9 +1248,9 @@ void TileMap::saveToStream( IOStream& IOS ) {
 			if ( NULL != tLayer && tLayer->getType() == MAP_LAYER_OBJECT ) {
 				tOLayer = reinterpret_cast<MapObjectLayer*> ( tLayer );
 
-				MapObjectLayer::ObjList ObjList = tOLayer->getObjectList();
+				const MapObjectLayer::ObjList& ObjList = tOLayer->getObjectList();
 
-				for ( MapObjectLayer::ObjList::iterator MapObjIt = ObjList.begin(); MapObjIt != ObjList.end(); MapObjIt++ ) {
+				for ( MapObjectLayer::ObjList::const_iterator MapObjIt = ObjList.begin(); MapObjIt != ObjList.end(); MapObjIt++ ) {
 					tObj = (*MapObjIt);
 
 					sMapObjGOHdr tOGOHdr;
@@ -1358,19 +1341,258 @@ void TileMap::saveToStream( IOStream& IOS ) {
 				IOS.write( (const char*)&tLightHdr, sizeof(sMapLightHdr) );
 			}
 		}
+
+		//! The chunked format stores the tiles at the end, after the chunk index
+		if ( ThereIsTiled && MAP_FORMAT_CHUNKED == format ) {
+			saveChunks( IOS );
+		}
 	}
 }
 
-void TileMap::saveToFile( const std::string& path ) {
+void TileMap::saveToFile( const std::string& path, const EE_MAP_FORMAT& format ) {
 	if ( !FileSystem::isDirectory( path ) ) {
 		IOStreamFile IOS( path, std::ios::out | std::ios::binary );
 
-		saveToStream( IOS );
+		saveToStream( IOS, format );
 
 		mPath = path;
 	}
 }
 
+void TileMap::addTile( const Uint32& layerIndex, const sMapTileGOHdr& hdr, const Vector2i& TilePos ) {
+	TileMapLayer * tTLayer = reinterpret_cast<TileMapLayer*> ( mLayers[ layerIndex ] );
+
+	//! The layer doesn't take the object of a tile out of its bounds ( the forced headers can make the map smaller )
+	if ( TilePos.x >= tTLayer->mSize.x || TilePos.y >= tTLayer->mSize.y )
+		return;
+
+	if ( GAMEOBJECT_TYPE_SUBTEXTURE == hdr.Type && tTLayer->isDense() ) {
+		//! The dense layers don't need a game object for the plain sub textures
+		tTLayer->addSubTextureTile( TextureAtlasManager::instance()->getSubTextureById( hdr.Id ), hdr.Flags, TilePos );
+	} else {
+		tTLayer->addGameObject( createGameObject( hdr.Type, hdr.Flags, mLayers[ layerIndex ], hdr.Id ), TilePos );
+	}
+}
+
+void TileMap::onTileEdit( const Vector2i& TilePos ) {
+	//! The chunk of the tile must be loaded before the edit and kept when it's unloaded
+	if ( NULL != mStreamer )
+		mStreamer->editTile( TilePos );
+}
+
+void TileMap::getTileRecords( const Vector2i& start, const Vector2i& end, std::vector<Uint8>& records ) {
+	Uint32 i, tReadFlag;
+	MapLayer * tLayer;
+	TileMapLayer * tTLayer;
+	GameObject * tObj;
+	std::vector<GameObject*> tObjects( mLayerCount );
+
+	for ( Int32 y = start.y; y < end.y; y++ ) {
+		for ( Int32 x = start.x; x < end.x; x++ ) {
+			//! Reset Layer Read Flags and temporal objects
+			tReadFlag		= 0;
+
+			for ( i = 0; i < mLayerCount; i++ )
+				tObjects[i] = NULL;
+
+			//! Look at every layer if it's some data on the current tile, in that case it will write a bit flag to
+			//! inform that it's an object on the current tile layer, and it will store a temporal reference to the
+			//! object to write layer the object header information
+			for ( i = 0; i < mLayerCount; i++ ) {
+				tLayer = mLayers[i];
+
+				if ( NULL != tLayer && tLayer->getType() == MAP_LAYER_TILED ) {
+					tTLayer = reinterpret_cast<TileMapLayer*> ( tLayer );
+
+					//! The compact tiles of the dense layers don't have a game object ( tObjects[i] stays NULL )
+					if ( !tTLayer->isTileEmpty( Vector2i( x, y ) ) ) {
+						tReadFlag |= 1 << i;
+
+						tObjects[i] = tTLayer->findGameObject( Vector2i( x, y ) );
+					}
+				}
+			}
+
+			//! Writes the current tile flags
+			size_t pos = records.size();
+
+			records.resize( pos + sizeof(Uint32) );
+
+			memcpy( &records[ pos ], &tReadFlag, sizeof(Uint32) );
+
+			//! Writes every game object header corresponding to this tile
+			for ( i = 0; i < mLayerCount; i++ ) {
+				if ( tReadFlag & ( 1 << i ) ) {
+					tObj = tObjects[i];
+
+					sMapTileGOHdr tTGOHdr;
+
+					if ( NULL == tObj ) {
+						tTLayer			= reinterpret_cast<TileMapLayer*> ( mLayers[i] );
+						tTGOHdr.Id		= tTLayer->getTileDataId( Vector2i( x, y ) );
+						tTGOHdr.Type	= GAMEOBJECT_TYPE_SUBTEXTURE;
+						tTGOHdr.Flags	= tTLayer->getTileFlags( Vector2i( x, y ) );
+					} else {
+						//! The DataId should be the SubTexture hash name ( at least in the cases of type SubTexture, SubTextureEx and Sprite.
+						tTGOHdr.Id		= tObj->getDataId();
+
+						//! If the object type is virtual, means that the real type is stored elsewhere.
+						if ( tObj->getType() != GAMEOBJECT_TYPE_VIRTUAL ) {
+							tTGOHdr.Type	= tObj->getType();
+						} else {
+							GameObjectVirtual * tObjV = reinterpret_cast<GameObjectVirtual*> ( tObj );
+
+							tTGOHdr.Type	= tObjV->getRealType();
+						}
+
+						tTGOHdr.Flags	= tObj->getFlags();
+					}
+
+					pos = records.size();
+
+					records.resize( pos + sizeof(sMapTileGOHdr) );
+
+					memcpy( &records[ pos ], &tTGOHdr, sizeof(sMapTileGOHdr) );
+				}
+			}
+		}
+	}
+}
+
+bool TileMap::loadChunkIndex( IOStream& IOS, const sMapHdr& MapHdr ) {
+	sMapChunkIndexHdr tIndexHdr;
+
+	IOS.read( (char*)&tIndexHdr, sizeof(sMapChunkIndexHdr) );
+
+	if ( MAP_CHUNK_FORMAT_VERSION != tIndexHdr.Version || 0 == tIndexHdr.ChunkSize ||
+		 tIndexHdr.ChunksX != ( MapHdr.SizeX + tIndexHdr.ChunkSize - 1 ) / tIndexHdr.ChunkSize ||
+		 tIndexHdr.ChunksY != ( MapHdr.SizeY + tIndexHdr.ChunkSize - 1 ) / tIndexHdr.ChunkSize )
+	{
+		eePRINTL( "TileMap::loadChunkIndex: Unsupported chunk index in map %s.", mPath.c_str() );
+		return false;
+	}
+
+	std::vector<sMapChunkHdr> tChunksHdr( tIndexHdr.ChunksX * tIndexHdr.ChunksY );
+	Uint64 tDataSize = 0;
+
+	if ( !tChunksHdr.empty() )
+		IOS.read( (char*)&tChunksHdr[0], sizeof(sMapChunkHdr) * tChunksHdr.size() );
+
+	for ( Uint32 i = 0; i < tChunksHdr.size(); i++ )
+		tDataSize = eemax( tDataSize, tChunksHdr[i].Offset + tChunksHdr[i].CompressedSize );
+
+	//! Only the compressed chunks are kept in memory, they are decompressed when they are loaded
+	std::vector<Uint8> tData( tDataSize );
+
+	if ( tDataSize > 0 && IOS.read( (char*)&tData[0], tDataSize ) != (ios_size)tDataSize ) {
+		eePRINTL( "TileMap::loadChunkIndex: The map %s is truncated.", mPath.c_str() );
+		return false;
+	}
+
+	mStreamer = eeNew( Private::TileMapStreamer, ( this, tIndexHdr, Sizei( MapHdr.SizeX, MapHdr.SizeY ), tChunksHdr, tData ) );
+	mStreamer->setMemoryBudget( mStreamingBudget );
+	mStreamer->setMargin( mStreamingMargin );
+
+	return true;
+}
+
+void TileMap::saveChunks( IOStream& IOS ) {
+	sMapChunkIndexHdr tIndexHdr;
+
+	tIndexHdr.Version	= MAP_CHUNK_FORMAT_VERSION;
+	tIndexHdr.ChunkSize	= TileMapLayer::CHUNK_SIZE;
+	tIndexHdr.ChunksX	= ( mSize.x + TileMapLayer::CHUNK_SIZE - 1 ) / TileMapLayer::CHUNK_SIZE;
+	tIndexHdr.ChunksY	= ( mSize.y + TileMapLayer::CHUNK_SIZE - 1 ) / TileMapLayer::CHUNK_SIZE;
+
+	std::vector<sMapChunkHdr> tChunksHdr( tIndexHdr.ChunksX * tIndexHdr.ChunksY );
+	std::vector<Uint8> tData;
+	std::vector<Uint8> tRecords;
+
+	for ( Uint32 cx = 0; cx < tIndexHdr.ChunksX; cx++ ) {
+		for ( Uint32 cy = 0; cy < tIndexHdr.ChunksY; cy++ ) {
+			sMapChunkHdr& tChunkHdr = tChunksHdr[ cx * tIndexHdr.ChunksY + cy ];
+			Vector2i start( cx * TileMapLayer::CHUNK_SIZE, cy * TileMapLayer::CHUNK_SIZE );
+			Vector2i end( eemin( start.x + TileMapLayer::CHUNK_SIZE, mSize.x ), eemin( start.y + TileMapLayer::CHUNK_SIZE, mSize.y ) );
+
+			tRecords.clear();
+
+			getTileRecords( start, end, tRecords );
+
+			tChunkHdr.Offset			= tData.size();
+			tChunkHdr.Size				= tRecords.size();
+			tChunkHdr.CompressedSize	= 0;
+
+			if ( !tRecords.empty() ) {
+				uLongf size = compressBound( tRecords.size() );
+
+				tData.resize( tChunkHdr.Offset + size );
+
+				compress2( &tData[ tChunkHdr.Offset ], &size, &tRecords[0], tRecords.size(), Z_DEFAULT_COMPRESSION );
+
+				tData.resize( tChunkHdr.Offset + size );
+
+				tChunkHdr.CompressedSize	= size;
+			}
+		}
+	}
+
+	IOS.write( (const char*)&tIndexHdr, sizeof(sMapChunkIndexHdr) );
+
+	if ( !tChunksHdr.empty() )
+		IOS.write( (const char*)&tChunksHdr[0], sizeof(sMapChunkHdr) * tChunksHdr.size() );
+
+	if ( !tData.empty() )
+		IOS.write( (const char*)&tData[0], tData.size() );
+}
+
+bool TileMap::isStreaming() const {
+	return NULL != mStreamer;
+}
+
+void TileMap::loadAllChunks() {
+	if ( NULL != mStreamer ) {
+		mStreamer->loadAll();
+
+		eeSAFE_DELETE( mStreamer );
+
+		mPolyObjs.clear();
+	}
+}
+
+Uint32 TileMap::getChunkCount() const {
+	return NULL != mStreamer ? mStreamer->getChunkCount() : 0;
+}
+
+Uint32 TileMap::getLoadedChunkCount() const {
+	return NULL != mStreamer ? mStreamer->getLoadedChunkCount() : 0;
+}
+
+void TileMap::setStreamingMemoryBudget( const size_t& bytes ) {
+	mStreamingBudget = bytes;
+
+	if ( NULL != mStreamer )
+		mStreamer->setMemoryBudget( bytes );
+}
+
+const size_t& TileMap::getStreamingMemoryBudget() const {
+	return mStreamingBudget;
+}
+
+size_t TileMap::getStreamingMemoryUsed() const {
+	return NULL != mStreamer ? mStreamer->getMemoryUsed() : 0;
+}
+
+void TileMap::setStreamingMargin( const Uint32& chunks ) {
+	mStreamingMargin = chunks;
+
+	if ( NULL != mStreamer )
+		mStreamer->setMargin( chunks );
+}
+
+const Uint32& TileMap::getStreamingMargin() const {
+	return mStreamingMargin;
+}
+
 std::vector<std::string> TileMap::getTextureAtlases() {
 	TextureAtlasManager * SGM = TextureAtlasManager::instance();
 	std::list<TextureAtlas*>& Res = SGM->getResources();
@@ -1379,7 +1601,8 @@ std::vector<std::string> TileMap::getTextureAtlases() {
 
 	//! Ugly ugly ugly, but i don't see another way
 	Uint32 Restricted1 = String::hash( std::string( "global" ) );
-	Uint32 Restricted2 = String::hash( UI::UIThemeManager::instance()->getDefaultTheme()->getTextureAtlas()->getName() );
+	UI::UITheme * Theme = UI::UIThemeManager::instance()->getDefaultTheme();
+	Uint32 Restricted2 = NULL != Theme && NULL != Theme->getTextureAtlas() ? String::hash( Theme->getTextureAtlas()->getName() ) : 0;
 
 	for ( std::list<TextureAtlas*>::iterator it = Res.begin(); it != Res.end(); it++ ) {
 		if ( (*it)->getId() != Restricted1 && (*it)->getId() != Restricted2 )
@@ -1403,14 +1626,12 @@ Texture * TileMap::getBlankTileTexture() {
 
 bool TileMap::isTileBlocked( const Vector2i& TilePos ) {
 	TileMapLayer * TLayer;
-	GameObject * TObj;
 
 	for ( Uint32 i = 0; i < mLayerCount; i++ ) {
 		if ( mLayers[i]->getType() == MAP_LAYER_TILED ) {
 			TLayer	= static_cast<TileMapLayer*>( mLayers[i] );
-			TObj	= TLayer->getGameObject( TilePos );
 
-			if ( NULL != TObj && TObj->isBlocked() ) {
+			if ( TLayer->isTileBlocked( TilePos ) ) {
 				return true;
 			}
 		}
@@ -1436,7 +1657,12 @@ GameObject * TileMap::IsTypeInTilePos( const Uint32& Type, const Vector2i& TileP
 			TileMapLayer * tLayer = reinterpret_cast<TileMapLayer*> ( mLayers[i] );
 			GameObject * tObj = NULL;
 
-			if ( ( tObj = tLayer->getGameObject( TilePos ) ) ) {
+			if ( tLayer->isTileCompact( TilePos ) ) {
+				//! The compact tiles are plain sub textures, the object is only created if it's requested
+				if ( GAMEOBJECT_TYPE_SUBTEXTURE == Type || GAMEOBJECT_TYPE_BASE == Type ) {
+					return tLayer->getGameObject( TilePos );
+				}
+			} else if ( ( tObj = tLayer->findGameObject( TilePos ) ) ) {
 				if ( tObj->isType( Type ) ) {
 					return tObj;
 				}
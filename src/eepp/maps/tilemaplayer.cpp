@@ -1,16 +1,88 @@
 #include <eepp/maps/tilemaplayer.hpp>
 #include <eepp/maps/tilemap.hpp>
+#include <eepp/maps/gameobjectsubtexture.hpp>
+#include <eepp/maps/maplightmanager.hpp>
 
 #include <eepp/graphics/texture.hpp>
+#include <eepp/graphics/subtexture.hpp>
+#include <eepp/graphics/texturefactory.hpp>
 #include <eepp/graphics/globalbatchrenderer.hpp>
+#include <eepp/graphics/blendmode.hpp>
+#include <eepp/graphics/renderer/openglext.hpp>
 #include <eepp/graphics/renderer/renderer.hpp>
 using namespace EE::Graphics;
 
+//! The chunks not used in this number of frames release their baked geometry
+#define TILE_CHUNK_MAX_UNUSED_FRAMES	( 120 )
+
 namespace EE { namespace Maps {
 
+TileMapLayer::TileIterator::TileIterator( TileMapLayer * layer, const Vector2i& start, const Vector2i& end ) :
+	mLayer( layer ),
+	mStart( start ),
+	mEnd( end ),
+	mPos( start.x - 1, start.y ),
+	mIndex( 0 )
+{
+}
+
+bool TileMapLayer::TileIterator::next() {
+	if ( mStart.x >= mEnd.x )
+		return false;
+
+	while ( true ) {
+		mPos.x++;
+
+		if ( mPos.x >= mEnd.x ) {
+			mPos.x = mStart.x;
+			mPos.y++;
+		}
+
+		if ( mPos.y >= mEnd.y )
+			return false;
+
+		mIndex = mLayer->getTileIndex( mPos );
+
+		if ( NULL != mLayer->getObjectAt( mIndex ) || NULL != mLayer->getCompactSubTexture( mIndex ) )
+			return true;
+	}
+}
+
+const Vector2i& TileMapLayer::TileIterator::getTilePos() const {
+	return mPos;
+}
+
+GameObject * TileMapLayer::TileIterator::getGameObject() const {
+	return mLayer->getObjectAt( mIndex );
+}
+
+Graphics::SubTexture * TileMapLayer::TileIterator::getSubTexture() const {
+	GameObject * obj = mLayer->getObjectAt( mIndex );
+
+	if ( NULL == obj )
+		return mLayer->getCompactSubTexture( mIndex );
+
+	if ( obj->isType( GAMEOBJECT_TYPE_SUBTEXTURE ) )
+		return static_cast<GameObjectSubTexture*>( obj )->getSubTexture();
+
+	return NULL;
+}
+
+Uint32 TileMapLayer::TileIterator::getFlags() const {
+	GameObject * obj = mLayer->getObjectAt( mIndex );
+
+	return NULL != obj ? obj->getFlags() : mLayer->mTileFlags[ mIndex ];
+}
+
+bool TileMapLayer::TileIterator::isBlocked() const {
+	return 0 != ( getFlags() & GObjFlags::GAMEOBJECT_BLOCKED );
+}
+
 TileMapLayer::TileMapLayer( TileMap * map, Sizei size, Uint32 flags, std::string name, Vector2f offset ) :
 	MapLayer( map, MAP_LAYER_TILED, flags, name, offset ),
-	mSize( size )
+	mTiles( NULL ),
+	mSize( size ),
+	mFrame( 0 )
 {
 	allocateLayer();
 }
@@ -28,13 +100,34 @@ void TileMapLayer::draw( const Vector2f& Offset ) {
 	Vector2i start = mMap->getStartTile();
 	Vector2i end = mMap->getEndTile();
 
-	for ( Int32 x = start.x; x < end.x; x++ ) {
-		for ( Int32 y = start.y; y < end.y; y++ ) {
-			mCurTile.x = x;
-			mCurTile.y = y;
+	mFrame++;
+
+	if ( start.x < end.x && start.y < end.y ) {
+		Int32 cxEnd = ( end.x - 1 ) / CHUNK_SIZE;
+		Int32 cyEnd = ( end.y - 1 ) / CHUNK_SIZE;
+		bool oversized = false;
+
+		for ( Int32 cx = start.x / CHUNK_SIZE; cx <= cxEnd; cx++ ) {
+			for ( Int32 cy = start.y / CHUNK_SIZE; cy <= cyEnd; cy++ ) {
+				TileChunk& chunk = mChunks[ cx * mChunksSize.y + cy ];
+
+				if ( chunk.Dirty )
+					buildChunk( chunk, Vector2i( cx, cy ) );
+
+				chunk.LastFrame = mFrame;
 
-			if ( NULL != mTiles[x][y] ) {
-				mTiles[x][y]->draw();
+				oversized |= chunk.Oversized;
+			}
+		}
+
+		if ( oversized ) {
+			// A tile overlaps the tiles of other chunks, drawing chunk by chunk would change the drawing order
+			drawTiles( start, end );
+		} else {
+			for ( Int32 cx = start.x / CHUNK_SIZE; cx <= cxEnd; cx++ ) {
+				for ( Int32 cy = start.y / CHUNK_SIZE; cy <= cyEnd; cy++ ) {
+					drawChunk( mChunks[ cx * mChunksSize.y + cy ], start, end );
+				}
 			}
 		}
 	}
@@ -42,13 +135,9 @@ void TileMapLayer::draw( const Vector2f& Offset ) {
 	Texture * Tex = mMap->getBlankTileTexture();
 
 	if ( mMap->getShowBlocked() && NULL != Tex ) {
-		for ( Int32 x = start.x; x < end.x; x++ ) {
-			for ( Int32 y = start.y; y < end.y; y++ ) {
-				if ( NULL != mTiles[x][y] ) {
-					if ( mTiles[x][y]->isBlocked() ) {
-						Tex->draw( x * mMap->getTileSize().x, y * mMap->getTileSize().y, 0 , Vector2f::One, Color( 255, 0, 0, 200 ) );
-					}
-				}
+		for ( TileIterator it = getTiles( start, end ); it.next(); ) {
+			if ( it.isBlocked() ) {
+				Tex->draw( it.getTilePos().x * mMap->getTileSize().x, it.getTilePos().y * mMap->getTileSize().y, 0 , Vector2f::One, Color( 255, 0, 0, 200 ) );
 			}
 		}
 	}
@@ -56,57 +145,602 @@ void TileMapLayer::draw( const Vector2f& Offset ) {
 	GlobalBatchRenderer::instance()->draw();
 
 	GLi->popMatrix();
+
+	releaseUnusedChunks();
 }
 
 void TileMapLayer::update( const Time& dt ) {
 	Vector2i start = mMap->getStartTile();
 	Vector2i end = mMap->getEndTile();
 
+	if ( start.x >= end.x || start.y >= end.y )
+		return;
+
+	Int32 cxEnd = ( end.x - 1 ) / CHUNK_SIZE;
+	Int32 cyEnd = ( end.y - 1 ) / CHUNK_SIZE;
+
+	// The static tiles don't need to be updated
+	for ( Int32 cx = start.x / CHUNK_SIZE; cx <= cxEnd; cx++ ) {
+		for ( Int32 cy = start.y / CHUNK_SIZE; cy <= cyEnd; cy++ ) {
+			TileChunk& chunk = mChunks[ cx * mChunksSize.y + cy ];
+
+			if ( chunk.Dirty )
+				buildChunk( chunk, Vector2i( cx, cy ) );
+
+			chunk.LastFrame = mFrame;
+
+			for ( size_t i = 0; i < chunk.DynamicTiles.size(); i++ ) {
+				const Vector2i& tile = chunk.DynamicTiles[i];
+
+				if ( tile.x >= start.x && tile.x < end.x && tile.y >= start.y && tile.y < end.y ) {
+					GameObject * obj = getObjectAt( getTileIndex( tile ) );
+
+					if ( NULL != obj ) {
+						mCurTile = tile;
+
+						obj->update( dt );
+					}
+				}
+			}
+		}
+	}
+}
+
+Uint32 TileMapLayer::getTileIndex( const Vector2i& TilePos ) const {
+	return TilePos.y * mSize.x + TilePos.x;
+}
+
+GameObject * TileMapLayer::getObjectAt( const Uint32& index ) const {
+	if ( NULL != mTiles )
+		return mTiles[ index ];
+
+	if ( mTileFlags[ index ] & TILE_HAS_OBJECT )
+		return *mObjects.find( index );
+
+	return NULL;
+}
+
+void TileMapLayer::setObjectAt( const Uint32& index, GameObject * obj ) {
+	if ( NULL != mTiles ) {
+		mTiles[ index ] = obj;
+	} else if ( NULL != obj ) {
+		mObjects.insert( index, obj );
+		mTileSubTextures[ index ] = 0;
+		mTileFlags[ index ] = TILE_HAS_OBJECT;
+	} else {
+		if ( mTileFlags[ index ] & TILE_HAS_OBJECT )
+			mObjects.erase( index );
+
+		mTileFlags[ index ] = 0;
+	}
+}
+
+Graphics::SubTexture * TileMapLayer::getCompactSubTexture( const Uint32& index ) const {
+	if ( NULL == mTiles && 0 != mTileSubTextures[ index ] )
+		return mPalette[ mTileSubTextures[ index ] - 1 ];
+
+	return NULL;
+}
+
+bool TileMapLayer::setCompactTile( const Uint32& index, Graphics::SubTexture * subTexture, const Uint32& flags ) {
+	if ( NULL != mTiles || NULL == subTexture || flags >= TILE_HAS_OBJECT )
+		return false;
+
+	Uint16 * paletteId = mPaletteIndex.find( subTexture->getId() );
+
+	if ( NULL == paletteId ) {
+		// The palette index is stored in 16 bits, the tiles of any other sub texture keep its object
+		if ( mPalette.size() >= 0xFFFF )
+			return false;
+
+		mPalette.push_back( subTexture );
+
+		paletteId = mPaletteIndex.insert( subTexture->getId(), (Uint16)mPalette.size() );
+	} else if ( mPalette[ *paletteId - 1 ] != subTexture ) {
+		// Two sub textures with the same id
+		return false;
+	}
+
+	mTileSubTextures[ index ] = *paletteId;
+	mTileFlags[ index ] = (Uint8)flags;
+
+	return true;
+}
+
+void TileMapLayer::clearTile( const Uint32& index ) {
+	GameObject * obj = getObjectAt( index );
+
+	if ( NULL != obj ) {
+		eeDelete( obj );
+
+		setObjectAt( index, NULL );
+	}
+
+	if ( NULL == mTiles ) {
+		mTileSubTextures[ index ] = 0;
+		mTileFlags[ index ] = 0;
+	}
+}
+
+GameObject * TileMapLayer::createTileObject( const Uint32& index, const Vector2i& TilePos ) {
+	GameObject * obj = eeNew( GameObjectSubTexture, ( mTileFlags[ index ], this, getCompactSubTexture( index ), Vector2f( TilePos.x * mMap->getTileSize().x, TilePos.y * mMap->getTileSize().y ) ) );
+
+	setObjectAt( index, obj );
+
+	return obj;
+}
+
+TileMapLayer::TileChunk& TileMapLayer::getChunk( const Vector2i& TilePos ) {
+	return mChunks[ ( TilePos.x / CHUNK_SIZE ) * mChunksSize.y + TilePos.y / CHUNK_SIZE ];
+}
+
+void TileMapLayer::invalidateTile( const Vector2i& TilePos ) {
+	if ( TilePos.x >= 0 && TilePos.y >= 0 && TilePos.x < mSize.x && TilePos.y < mSize.y )
+		getChunk( TilePos ).Dirty = true;
+}
+
+void TileMapLayer::invalidateChunks() {
+	for ( size_t i = 0; i < mChunks.size(); i++ )
+		mChunks[i].Dirty = true;
+}
+
+bool TileMapLayer::canBakeSubTexture( Graphics::SubTexture * subTexture ) {
+	return NULL != subTexture && NULL != subTexture->getTexture() && subTexture->getTexture()->getClampMode() != CLAMP_REPEAT;
+}
+
+bool TileMapLayer::isStaticTile( GameObject * obj ) {
+	// Only the plain sub texture objects are baked, the derived objects can draw anything
+	return obj->getType() == GAMEOBJECT_TYPE_SUBTEXTURE && canBakeSubTexture( static_cast<GameObjectSubTexture*>( obj )->getSubTexture() );
+}
+
+bool TileMapLayer::fitsTile( const Vector2f& min, const Vector2f& max, const Vector2i& TilePos ) {
+	const Sizei& tileSize = mMap->getTileSize();
+	Float x = (Float)( TilePos.x * tileSize.x );
+	Float y = (Float)( TilePos.y * tileSize.y );
+
+	return min.x >= x && min.y >= y && max.x <= x + tileSize.x && max.y <= y + tileSize.y;
+}
+
+void TileMapLayer::bakeTile( TileChunk& chunk, Graphics::SubTexture * subTexture, const Uint32& flags, const Vector2f& pos, const Vector2i& TilePos ) {
+	Texture * tex = subTexture->getTexture();
+
+	// Same geometry than GameObjectSubTexture::draw
+	Float w = (Float)tex->getImageWidth();
+	Float h = (Float)tex->getImageHeight();
+	Rectf sector( 0, 0, w, h );
+	const Rect& srcRect = subTexture->getSrcRect();
+
+	if ( srcRect.Right != 0 || srcRect.Bottom != 0 )
+		sector = Rectf( srcRect.Left, srcRect.Top, srcRect.Right, srcRect.Bottom );
+
+	Float l = sector.Left / w;
+	Float t = sector.Top / h;
+	Float r = sector.Right / w;
+	Float b = sector.Bottom / h;
+
+	if ( flags & GObjFlags::GAMEOBJECT_MIRRORED ) {
+		Float tmp = l; l = r; r = tmp;
+	}
+
+	if ( flags & GObjFlags::GAMEOBJECT_FLIPED ) {
+		Float tmp = t; t = b; b = tmp;
+	}
+
+	Sizei size( subTexture->getRealSize() );
+	Float x = pos.x + subTexture->getOffset().x;
+	Float y = pos.y + subTexture->getOffset().y;
+
+	eeVertex quad[4];
+	quad[0].pos = Vector2f( x, y );							quad[0].tex.u = l; quad[0].tex.v = t;
+	quad[1].pos = Vector2f( x, y + size.y );				quad[1].tex.u = l; quad[1].tex.v = b;
+	quad[2].pos = Vector2f( x + size.x, y + size.y );		quad[2].tex.u = r; quad[2].tex.v = b;
+	quad[3].pos = Vector2f( x + size.x, y );				quad[3].tex.u = r; quad[3].tex.v = t;
+
+	if ( flags & GObjFlags::GAMEOBJECT_ROTATE_90DEG ) {
+		Vector2f center( x + size.x * 0.5f, y + size.y * 0.5f );
+		Float cosA = Math::cosAng( 90 );
+		Float sinA = Math::sinAng( 90 );
+
+		for ( int i = 0; i < 4; i++ ) {
+			Float px = quad[i].pos.x - center.x;
+			Float py = quad[i].pos.y - center.y;
+			quad[i].pos.x = px * cosA - py * sinA + center.x;
+			quad[i].pos.y = px * sinA + py * cosA + center.y;
+		}
+	}
+
+	Vector2f min( quad[0].pos );
+	Vector2f max( quad[0].pos );
+
+	for ( int i = 0; i < 4; i++ ) {
+		quad[i].color = Color::White;
+
+		min.x = eemin( min.x, quad[i].pos.x );
+		min.y = eemin( min.y, quad[i].pos.y );
+		max.x = eemax( max.x, quad[i].pos.x );
+		max.y = eemax( max.y, quad[i].pos.y );
+	}
+
+	// The oversized chunks aren't baked, buildChunk only keeps looking for the dynamic tiles
+	if ( chunk.Oversized || !fitsTile( min, max, TilePos ) ) {
+		chunk.Oversized = true;
+		return;
+	}
+
+	// Merge with the last batch if it uses the same texture and no dynamic tile is drawn after it, so the drawing order is kept
+	if ( chunk.Batches.empty() || chunk.Batches.back().Tex != tex || chunk.Batches.back().DynamicEnd != chunk.Batches.back().DynamicStart ) {
+		chunk.Batches.push_back( TileChunkBatch() );
+		chunk.Batches.back().Tex = tex;
+		chunk.Batches.back().DynamicStart = chunk.Batches.back().DynamicEnd = chunk.DynamicTiles.size();
+	}
+
+	TileChunkBatch& batch = chunk.Batches.back();
+
+	if ( GLi->quadsSupported() ) {
+		batch.Vertexs.insert( batch.Vertexs.end(), quad, quad + 4 );
+	} else {
+		// Same order than BatchRenderer::batchQuadEx
+		batch.Vertexs.push_back( quad[1] );
+		batch.Vertexs.push_back( quad[0] );
+		batch.Vertexs.push_back( quad[3] );
+		batch.Vertexs.push_back( quad[1] );
+		batch.Vertexs.push_back( quad[2] );
+		batch.Vertexs.push_back( quad[3] );
+	}
+
+	batch.Tiles.push_back( TilePos );
+}
+
+void TileMapLayer::addDynamicTile( TileChunk& chunk, GameObject * obj, const Vector2i& TilePos ) {
+	Vector2f pos( obj->getPosition() );
+	Sizei size( obj->getSize() );
+
+	if ( !fitsTile( pos, Vector2f( pos.x + size.x, pos.y + size.y ), TilePos ) )
+		chunk.Oversized = true;
+
+	// A chunk starting with a dynamic tile starts with an empty batch
+	if ( chunk.Batches.empty() )
+		chunk.Batches.push_back( TileChunkBatch() );
+
+	chunk.DynamicTiles.push_back( TilePos );
+	chunk.Batches.back().DynamicEnd = chunk.DynamicTiles.size();
+}
+
+void TileMapLayer::buildChunk( TileChunk& chunk, const Vector2i& ChunkPos ) {
+	chunk.Batches.clear();
+	chunk.DynamicTiles.clear();
+	chunk.Lit = false;
+	chunk.Oversized = false;
+
+	Int32 xEnd = eemin( ( ChunkPos.x + 1 ) * CHUNK_SIZE, mSize.x );
+	Int32 yEnd = eemin( ( ChunkPos.y + 1 ) * CHUNK_SIZE, mSize.y );
+
+	for ( Int32 x = ChunkPos.x * CHUNK_SIZE; x < xEnd; x++ ) {
+		for ( Int32 y = ChunkPos.y * CHUNK_SIZE; y < yEnd; y++ ) {
+			Uint32 index = getTileIndex( Vector2i( x, y ) );
+			GameObject * obj = getObjectAt( index );
+
+			if ( NULL != obj ) {
+				if ( isStaticTile( obj ) ) {
+					bakeTile( chunk, static_cast<GameObjectSubTexture*>( obj )->getSubTexture(), obj->getFlags(), obj->getPosition(), Vector2i( x, y ) );
+				} else {
+					addDynamicTile( chunk, obj, Vector2i( x, y ) );
+				}
+			} else {
+				Graphics::SubTexture * subTexture = getCompactSubTexture( index );
+
+				if ( NULL != subTexture ) {
+					if ( canBakeSubTexture( subTexture ) ) {
+						bakeTile( chunk, subTexture, mTileFlags[ index ], Vector2f( x * mMap->getTileSize().x, y * mMap->getTileSize().y ), Vector2i( x, y ) );
+					} else {
+						// The repeated textures are drawn by the object
+						addDynamicTile( chunk, createTileObject( index, Vector2i( x, y ) ), Vector2i( x, y ) );
+					}
+				}
+			}
+		}
+	}
+
+	if ( chunk.Oversized )
+		std::vector<TileChunkBatch>().swap( chunk.Batches );
+
+	chunk.Dirty = false;
+
+	if ( !chunk.Cached ) {
+		chunk.Cached = true;
+
+		mBuiltChunks.push_back( &chunk - &mChunks[0] );
+	}
+}
+
+void TileMapLayer::releaseChunk( TileChunk& chunk ) {
+	std::vector<TileChunkBatch>().swap( chunk.Batches );
+	std::vector<Vector2i>().swap( chunk.DynamicTiles );
+	chunk.Dirty = true;
+	chunk.Cached = false;
+	chunk.Lit = false;
+	chunk.Oversized = false;
+}
+
+void TileMapLayer::releaseUnusedChunks() {
+	// The baked geometry takes more memory than the tiles, so only the chunks around the visible area are kept
+	if ( 0 != ( mFrame % 60 ) )
+		return;
+
+	for ( size_t i = 0; i < mBuiltChunks.size(); ) {
+		TileChunk& chunk = mChunks[ mBuiltChunks[i] ];
+
+		if ( mFrame - chunk.LastFrame > TILE_CHUNK_MAX_UNUSED_FRAMES ) {
+			releaseChunk( chunk );
+
+			mBuiltChunks[i] = mBuiltChunks.back();
+			mBuiltChunks.pop_back();
+		} else {
+			i++;
+		}
+	}
+}
+
+void TileMapLayer::updateChunkColors( TileChunk& chunk, const bool& lit ) {
+	MapLightManager * LM = mMap->getLightManager();
+	bool byVertex = lit && LM->isByVertex();
+	bool triangles = !GLi->quadsSupported();
+	Color colors[4];
+
+	for ( size_t i = 0; i < chunk.Batches.size(); i++ ) {
+		TileChunkBatch& batch = chunk.Batches[i];
+		eeVertex * vertex = batch.Vertexs.empty() ? NULL : &batch.Vertexs[0];
+
+		for ( size_t q = 0; q < batch.Tiles.size(); q++ ) {
+			if ( byVertex ) {
+				for ( Uint32 v = 0; v < 4; v++ )
+					colors[v] = *LM->getTileColor( batch.Tiles[q], v );
+			} else {
+				colors[0] = colors[1] = colors[2] = colors[3] = lit ? *LM->getTileColor( batch.Tiles[q] ) : Color::White;
+			}
+
+			if ( triangles ) {
+				vertex[0].color = colors[1];
+				vertex[1].color = colors[0];
+				vertex[2].color = colors[3];
+				vertex[3].color = colors[1];
+				vertex[4].color = colors[2];
+				vertex[5].color = colors[3];
+				vertex += 6;
+			} else {
+				vertex[0].color = colors[0];
+				vertex[1].color = colors[1];
+				vertex[2].color = colors[2];
+				vertex[3].color = colors[3];
+				vertex += 4;
+			}
+		}
+	}
+
+	chunk.Lit = lit;
+	chunk.LightVersion = lit ? LM->getVersion() : 0;
+}
+
+void TileMapLayer::drawChunk( TileChunk& chunk, const Vector2i& start, const Vector2i& end ) {
+	if ( chunk.Batches.empty() )
+		return;
+
+	MapLightManager * LM = mMap->getLightManager();
+	bool lit = mMap->getLightsEnabled() && getLightsEnabled() && NULL != LM;
+
+	// The colors are only updated when the light map changes
+	if ( lit ? ( !chunk.Lit || chunk.LightVersion != LM->getVersion() ) : chunk.Lit )
+		updateChunkColors( chunk, lit );
+
+	TextureFactory * TF = TextureFactory::instance();
+	EE_DRAW_MODE mode = GLi->quadsSupported() ? DM_QUADS : DM_TRIANGLES;
+
+	for ( size_t i = 0; i < chunk.Batches.size(); i++ ) {
+		TileChunkBatch& batch = chunk.Batches[i];
+
+		if ( !batch.Vertexs.empty() ) {
+			Uint32 alloc = sizeof(eeVertex) * batch.Vertexs.size();
+			char * data = reinterpret_cast<char*> ( &batch.Vertexs[0] );
+
+			// Anything batched ( the previous dynamic tiles ) must be drawn before the quads
+			GlobalBatchRenderer::instance()->draw();
+
+			BlendMode::setMode( ALPHA_NORMAL );
+
+			TF->bind( batch.Tex );
+
+			GLi->vertexPointer	( 2, GL_FP			, sizeof(eeVertex), data											, alloc	);
+			GLi->texCoordPointer( 2, GL_FP			, sizeof(eeVertex), data + sizeof(Vector2f)							, alloc	);
+			GLi->colorPointer	( 4, GL_UNSIGNED_BYTE	, sizeof(eeVertex), data + sizeof(Vector2f) + sizeof(eeTexCoord)	, alloc	);
+
+			GLi->drawArrays( mode, 0, (int)batch.Vertexs.size() );
+		}
+
+		drawDynamicTiles( chunk, batch.DynamicStart, batch.DynamicEnd, start, end );
+	}
+}
+
+void TileMapLayer::drawDynamicTiles( TileChunk& chunk, const Uint32& from, const Uint32& to, const Vector2i& start, const Vector2i& end ) {
+	for ( Uint32 i = from; i < to; i++ ) {
+		const Vector2i& tile = chunk.DynamicTiles[i];
+
+		if ( tile.x >= start.x && tile.x < end.x && tile.y >= start.y && tile.y < end.y ) {
+			GameObject * obj = getObjectAt( getTileIndex( tile ) );
+
+			if ( NULL != obj ) {
+				mCurTile = tile;
+
+				obj->draw();
+			}
+		}
+	}
+}
+
+void TileMapLayer::drawTiles( const Vector2i& start, const Vector2i& end ) {
 	for ( Int32 x = start.x; x < end.x; x++ ) {
 		for ( Int32 y = start.y; y < end.y; y++ ) {
+			Uint32 index = getTileIndex( Vector2i( x, y ) );
+			GameObject * obj = getObjectAt( index );
+
 			mCurTile.x = x;
 			mCurTile.y = y;
 
-			if ( NULL != mTiles[x][y] ) {
-				mTiles[x][y]->update( dt );
+			if ( NULL != obj ) {
+				obj->draw();
+			} else {
+				Graphics::SubTexture * subTexture = getCompactSubTexture( index );
+
+				if ( NULL != subTexture ) {
+					// Drawn as the object the compact record replaces, without keeping it
+					GameObjectSubTexture tile( mTileFlags[ index ], this, subTexture, Vector2f( x * mMap->getTileSize().x, y * mMap->getTileSize().y ) );
+
+					tile.draw();
+				}
 			}
 		}
 	}
 }
 
 void TileMapLayer::allocateLayer() {
-	mTiles		= eeNewArray( GameObject**, mSize.getWidth() );
+	Uint32 count = mSize.getWidth() * mSize.getHeight();
 
-	for ( Int32 x = 0; x < mSize.x; x++ ) {
-		mTiles[x] = eeNewArray( GameObject*, mSize.getHeight() );
+	if ( isDense() ) {
+		mTileSubTextures.assign( count, 0 );
+		mTileFlags.assign( count, 0 );
+	} else {
+		mTiles = eeNewArray( GameObject*, count );
 
-		for ( Int32 y = 0; y < mSize.y; y++ ) {
-			mTiles[x][y] = NULL;
-		}
+		memset( mTiles, 0, sizeof(GameObject*) * count );
+	}
+
+	mChunksSize = Sizei( ( mSize.x + CHUNK_SIZE - 1 ) / CHUNK_SIZE, ( mSize.y + CHUNK_SIZE - 1 ) / CHUNK_SIZE );
+
+	mChunks.resize( mChunksSize.x * mChunksSize.y );
+
+	for ( size_t i = 0; i < mChunks.size(); i++ ) {
+		mChunks[i].LastFrame = 0;
+		mChunks[i].LightVersion = 0;
+		mChunks[i].Dirty = true;
+		mChunks[i].Cached = false;
+		mChunks[i].Lit = false;
+		mChunks[i].Oversized = false;
 	}
 }
 
 void TileMapLayer::deallocateLayer() {
-	for ( Int32 x = 0; x < mSize.x; x++ ) {
-		for ( Int32 y = 0; y < mSize.y; y++ ) {
-			eeSAFE_DELETE( mTiles[x][y] );
-		}
+	Uint32 count = mSize.getWidth() * mSize.getHeight();
 
-		eeSAFE_DELETE_ARRAY( mTiles[x] );
+	for ( Uint32 i = 0; i < count; i++ ) {
+		GameObject * obj = getObjectAt( i );
+
+		eeSAFE_DELETE( obj );
 	}
 
 	eeSAFE_DELETE_ARRAY( mTiles );
+
+	std::vector<Uint16>().swap( mTileSubTextures );
+	std::vector<Uint8>().swap( mTileFlags );
+	mPalette.clear();
+	mPaletteIndex.clear();
+	mObjects.clear();
+	mChunks.clear();
+	mBuiltChunks.clear();
+}
+
+bool TileMapLayer::isDense() const {
+	return 0 != ( mFlags & LAYER_FLAG_DENSE );
+}
+
+void TileMapLayer::setDense( const bool& dense ) {
+	if ( dense == isDense() )
+		return;
+
+	Uint32 count = mSize.getWidth() * mSize.getHeight();
+
+	if ( dense ) {
+		GameObject ** tiles = mTiles;
+
+		mTiles = NULL;
+		mTileSubTextures.assign( count, 0 );
+		mTileFlags.assign( count, 0 );
+		setFlag( LAYER_FLAG_DENSE );
+
+		for ( Uint32 i = 0; i < count; i++ ) {
+			GameObject * obj = tiles[i];
+
+			if ( NULL != obj ) {
+				if ( obj->getType() == GAMEOBJECT_TYPE_SUBTEXTURE && setCompactTile( i, static_cast<GameObjectSubTexture*>( obj )->getSubTexture(), obj->getFlags() ) ) {
+					eeDelete( obj );
+				} else {
+					setObjectAt( i, obj );
+				}
+			}
+		}
+
+		eeSAFE_DELETE_ARRAY( tiles );
+	} else {
+		GameObject ** tiles = eeNewArray( GameObject*, count );
+
+		for ( Uint32 i = 0; i < count; i++ ) {
+			tiles[i] = getObjectAt( i );
+
+			if ( NULL == tiles[i] && NULL != getCompactSubTexture( i ) ) {
+				Vector2i pos( i % mSize.x, i / mSize.x );
+
+				tiles[i] = eeNew( GameObjectSubTexture, ( mTileFlags[i], this, getCompactSubTexture( i ), Vector2f( pos.x * mMap->getTileSize().x, pos.y * mMap->getTileSize().y ) ) );
+			}
+		}
+
+		std::vector<Uint16>().swap( mTileSubTextures );
+		std::vector<Uint8>().swap( mTileFlags );
+		mPalette.clear();
+		mPaletteIndex.clear();
+		mObjects.clear();
+		clearFlag( LAYER_FLAG_DENSE );
+
+		mTiles = tiles;
+	}
+
+	invalidateChunks();
 }
 
 void TileMapLayer::addGameObject( GameObject * obj, const Vector2i& TilePos ) {
 	eeASSERT( TilePos.x >= 0 && TilePos.y >= 0 );
 
 	if ( TilePos.x < mSize.x && TilePos.y < mSize.y ) {
-		removeGameObject( TilePos );
+		Uint32 index = getTileIndex( TilePos );
+
+		mMap->onTileEdit( TilePos );
+
+		clearTile( index );
 
-		mTiles[ TilePos.x ][ TilePos.y ] = obj;
+		if ( isDense() && obj->getType() == GAMEOBJECT_TYPE_SUBTEXTURE && setCompactTile( index, static_cast<GameObjectSubTexture*>( obj )->getSubTexture(), obj->getFlags() ) ) {
+			eeDelete( obj );
+		} else {
+			setObjectAt( index, obj );
 
-		obj->setPosition( Vector2f( TilePos.x * mMap->getTileSize().x, TilePos.y * mMap->getTileSize().y ) );
+			obj->setPosition( Vector2f( TilePos.x * mMap->getTileSize().x, TilePos.y * mMap->getTileSize().y ) );
+		}
+
+		invalidateTile( TilePos );
+	}
+}
+
+void TileMapLayer::addSubTextureTile( Graphics::SubTexture * subTexture, const Uint32& flags, const Vector2i& TilePos ) {
+	eeASSERT( TilePos.x >= 0 && TilePos.y >= 0 );
+
+	if ( TilePos.x < mSize.x && TilePos.y < mSize.y ) {
+		Uint32 index = getTileIndex( TilePos );
+
+		mMap->onTileEdit( TilePos );
+
+		clearTile( index );
+
+		if ( setCompactTile( index, subTexture, flags ) ) {
+			invalidateTile( TilePos );
+		} else {
+			addGameObject( eeNew( GameObjectSubTexture, ( flags, this, subTexture ) ), TilePos );
+		}
 	}
 }
 
@@ -114,24 +748,153 @@ void TileMapLayer::removeGameObject( const Vector2i& TilePos ) {
 	eeASSERT( TilePos.x >= 0 && TilePos.y >= 0 );
 
 	if ( TilePos.x < mSize.x && TilePos.y < mSize.y ) {
-		if ( NULL != mTiles[ TilePos.x ][ TilePos.y ] ) {
-			eeSAFE_DELETE( mTiles[ TilePos.x ][ TilePos.y ] );
+		Uint32 index = getTileIndex( TilePos );
+
+		mMap->onTileEdit( TilePos );
+
+		if ( NULL != getObjectAt( index ) || NULL != getCompactSubTexture( index ) ) {
+			clearTile( index );
+
+			invalidateTile( TilePos );
 		}
 	}
 }
 
 void TileMapLayer::moveTileObject( const Vector2i& FromPos, const Vector2i& ToPos ) {
+	mMap->onTileEdit( FromPos );
+
 	removeGameObject( ToPos );
 
-	GameObject * tObj = mTiles[ FromPos.x ][ FromPos.y ];
+	Uint32 from = getTileIndex( FromPos );
+	Uint32 to = getTileIndex( ToPos );
+	GameObject * tObj = getObjectAt( from );
 
-	mTiles[ FromPos.x ][ FromPos.y ] = NULL;
+	if ( NULL != tObj ) {
+		setObjectAt( from, NULL );
+
+		setObjectAt( to, tObj );
+	} else if ( NULL != getCompactSubTexture( from ) ) {
+		mTileSubTextures[ to ] = mTileSubTextures[ from ];
+		mTileFlags[ to ] = mTileFlags[ from ];
+		mTileSubTextures[ from ] = 0;
+		mTileFlags[ from ] = 0;
+	}
 
-	mTiles[ ToPos.x ][ ToPos.y ] = tObj;
+	invalidateTile( FromPos );
+	invalidateTile( ToPos );
 }
 
 GameObject * TileMapLayer::getGameObject( const Vector2i& TilePos ) {
-	return mTiles[ TilePos.x ][ TilePos.y ];
+	Uint32 index = getTileIndex( TilePos );
+	GameObject * obj = getObjectAt( index );
+
+	if ( NULL == obj && NULL != getCompactSubTexture( index ) ) {
+		obj = createTileObject( index, TilePos );
+
+		invalidateTile( TilePos );
+	}
+
+	return obj;
+}
+
+GameObject * TileMapLayer::findGameObject( const Vector2i& TilePos ) {
+	return getObjectAt( getTileIndex( TilePos ) );
+}
+
+bool TileMapLayer::isTileEmpty( const Vector2i& TilePos ) {
+	Uint32 index = getTileIndex( TilePos );
+
+	return NULL == getObjectAt( index ) && NULL == getCompactSubTexture( index );
+}
+
+bool TileMapLayer::isTileCompact( const Vector2i& TilePos ) {
+	return NULL != getCompactSubTexture( getTileIndex( TilePos ) );
+}
+
+bool TileMapLayer::isTileBlocked( const Vector2i& TilePos ) {
+	return 0 != ( getTileFlags( TilePos ) & GObjFlags::GAMEOBJECT_BLOCKED );
+}
+
+Uint32 TileMapLayer::getTileFlags( const Vector2i& TilePos ) {
+	Uint32 index = getTileIndex( TilePos );
+	GameObject * obj = getObjectAt( index );
+
+	if ( NULL != obj )
+		return obj->getFlags();
+
+	return NULL != getCompactSubTexture( index ) ? mTileFlags[ index ] : 0;
+}
+
+Uint32 TileMapLayer::getTileType( const Vector2i& TilePos ) {
+	Uint32 index = getTileIndex( TilePos );
+	GameObject * obj = getObjectAt( index );
+
+	if ( NULL != obj )
+		return obj->getType();
+
+	return NULL != getCompactSubTexture( index ) ? (Uint32)GAMEOBJECT_TYPE_SUBTEXTURE : 0;
+}
+
+Uint32 TileMapLayer::getTileDataId( const Vector2i& TilePos ) {
+	Uint32 index = getTileIndex( TilePos );
+	GameObject * obj = getObjectAt( index );
+
+	if ( NULL != obj )
+		return obj->getDataId();
+
+	Graphics::SubTexture * subTexture = getCompactSubTexture( index );
+
+	return NULL != subTexture ? subTexture->getId() : 0;
+}
+
+TileMapLayer::TileIterator TileMapLayer::getTiles( const Vector2i& start, const Vector2i& end ) {
+	return TileIterator( this,
+						 Vector2i( eemax( start.x, 0 ), eemax( start.y, 0 ) ),
+						 Vector2i( eemin( end.x, mSize.x ), eemin( end.y, mSize.y ) ) );
+}
+
+TileMapLayer::TileIterator TileMapLayer::getVisibleTiles() {
+	return getTiles( mMap->getStartTile(), mMap->getEndTile() );
+}
+
+TileMapLayer::MemoryReport TileMapLayer::getMemoryReport() {
+	MemoryReport report;
+	Uint32 count = mSize.getWidth() * mSize.getHeight();
+
+	if ( isDense() ) {
+		report.ObjectCount	= mObjects.size();
+		report.TileStorage	= mTileSubTextures.capacity() * sizeof(Uint16) + mTileFlags.capacity() * sizeof(Uint8) +
+							  mPalette.capacity() * sizeof(Graphics::SubTexture*) +
+							  // The indexes keep the load factor between 0.25 and 0.75
+							  ( mPaletteIndex.size() * 2 ) * ( sizeof(Uint32) * 2 + sizeof(Uint16) ) +
+							  ( mObjects.size() * 2 ) * ( sizeof(Uint32) * 2 + sizeof(GameObject*) );
+	} else {
+		report.ObjectCount	= 0;
+		report.TileStorage	= count * sizeof(GameObject*);
+
+		for ( Uint32 i = 0; i < count; i++ ) {
+			if ( NULL != mTiles[i] )
+				report.ObjectCount++;
+		}
+	}
+
+	// Most of the tile objects fit in a block of the game objects pool
+	report.Objects	= report.ObjectCount * GameObject::getAllocator().getBlockSize();
+	report.Chunks	= mChunks.capacity() * sizeof(TileChunk) + mBuiltChunks.capacity() * sizeof(Uint32);
+
+	for ( size_t i = 0; i < mBuiltChunks.size(); i++ ) {
+		TileChunk& chunk = mChunks[ mBuiltChunks[i] ];
+
+		report.Chunks += chunk.DynamicTiles.capacity() * sizeof(Vector2i) + chunk.Batches.capacity() * sizeof(TileChunkBatch);
+
+		for ( size_t b = 0; b < chunk.Batches.size(); b++ ) {
+			report.Chunks += chunk.Batches[b].Vertexs.capacity() * sizeof(eeVertex) + chunk.Batches[b].Tiles.capacity() * sizeof(Vector2i);
+		}
+	}
+
+	report.Total = report.TileStorage + report.Objects + report.Chunks;
+
+	return report;
 }
 
 const Vector2i& TileMapLayer::getCurrentTile() const {
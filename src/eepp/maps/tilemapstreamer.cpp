@@ -0,0 +1,378 @@
+#include <eepp/maps/tilemapstreamer.hpp>
+#include <eepp/maps/tilemap.hpp>
+#include <eepp/maps/tilemaplayer.hpp>
+#include <eepp/system/lock.hpp>
+#include <algorithm>
+#include <zlib.h>
+
+namespace EE { namespace Maps { namespace Private {
+
+namespace {
+	struct EvictCandidate {
+		Uint32	Index;
+		Int64	Distance;
+
+		bool operator<( const EvictCandidate& other ) const {
+			return Distance > other.Distance;
+		}
+	};
+}
+
+void TileMapStreamer::DecodeJob::run() {
+	Streamer->decode( Streamer->mChunks[ Index ] );
+
+	Lock l( Streamer->mDecodedMutex );
+
+	Streamer->mDecoded.push_back( Index );
+}
+
+TileMapStreamer::TileMapStreamer( TileMap * map, const sMapChunkIndexHdr& indexHdr, const Sizei& tilesSize, const std::vector<sMapChunkHdr>& chunks, std::vector<Uint8>& data ) :
+	mMap( map ),
+	mChunkSize( indexHdr.ChunkSize ),
+	mChunksSize( indexHdr.ChunksX, indexHdr.ChunksY ),
+	mTilesSize( tilesSize ),
+	mMargin( 1 ),
+	mMemoryBudget( 0 ),
+	mMemoryUsed( 0 ),
+	mLoadedCount( 0 ),
+	mUpdatingTiles( false )
+{
+	mData.swap( data );
+	mChunks.resize( chunks.size() );
+
+	for ( Uint32 i = 0; i < mChunks.size(); i++ ) {
+		Chunk& chunk		= mChunks[i];
+		chunk.Hdr			= chunks[i];
+		chunk.State			= CHUNK_UNLOADED;
+		chunk.Job			= JobSystem::InvalidHandle;
+		chunk.Decode.Streamer	= this;
+		chunk.Decode.Index		= i;
+		chunk.Memory		= 0;
+		chunk.Dirty			= false;
+	}
+}
+
+TileMapStreamer::~TileMapStreamer() {
+	//! The jobs read the compressed data and write the chunk records, so they must finish before releasing them
+	for ( Uint32 i = 0; i < mChunks.size(); i++ ) {
+		if ( CHUNK_LOADING == mChunks[i].State ) {
+			JobSystem::instance()->wait( mChunks[i].Job );
+		}
+	}
+}
+
+void TileMapStreamer::getChunkRange( const Vector2i& start, const Vector2i& end, const Int32& margin, Vector2i& chunkStart, Vector2i& chunkEnd ) const {
+	if ( end.x <= start.x || end.y <= start.y ) {
+		chunkStart = chunkEnd = Vector2i( 0, 0 );
+		return;
+	}
+
+	chunkStart.x	= eemax( 0, start.x / mChunkSize - margin );
+	chunkStart.y	= eemax( 0, start.y / mChunkSize - margin );
+	chunkEnd.x		= eemin( mChunksSize.x, ( end.x - 1 ) / mChunkSize + 1 + margin );
+	chunkEnd.y		= eemin( mChunksSize.y, ( end.y - 1 ) / mChunkSize + 1 + margin );
+}
+
+void TileMapStreamer::getChunkTiles( const Uint32& index, Vector2i& start, Vector2i& end ) const {
+	start.x		= ( index / mChunksSize.y ) * mChunkSize;
+	start.y		= ( index % mChunksSize.y ) * mChunkSize;
+	end.x		= eemin( start.x + mChunkSize, mTilesSize.x );
+	end.y		= eemin( start.y + mChunkSize, mTilesSize.y );
+}
+
+void TileMapStreamer::decode( Chunk& chunk ) {
+	chunk.Records.clear();
+
+	//! The chunks edited and unloaded have their own compressed records
+	const std::vector<Uint8>& data = chunk.Edited.empty() ? mData : chunk.Edited;
+
+	if ( 0 == chunk.Hdr.Size || chunk.Hdr.Offset + chunk.Hdr.CompressedSize > data.size() )
+		return;
+
+	uLongf size = chunk.Hdr.Size;
+
+	chunk.Records.resize( chunk.Hdr.Size );
+
+	if ( Z_OK != uncompress( &chunk.Records[0], &size, &data[ chunk.Hdr.Offset ], chunk.Hdr.CompressedSize ) || size != chunk.Hdr.Size ) {
+		eePRINTL( "TileMapStreamer::decode: Failed to decompress a chunk of the map %s.", mMap->getPath().c_str() );
+
+		chunk.Records.clear();
+	}
+}
+
+void TileMapStreamer::encode( const Uint32& index ) {
+	Chunk& chunk = mChunks[ index ];
+	Vector2i start, end;
+	std::vector<Uint8> records;
+
+	getChunkTiles( index, start, end );
+
+	mMap->getTileRecords( start, end, records );
+
+	chunk.Edited.clear();
+	chunk.Hdr.Offset			= 0;
+	chunk.Hdr.Size				= records.size();
+	chunk.Hdr.CompressedSize	= 0;
+
+	if ( !records.empty() ) {
+		uLongf size = compressBound( records.size() );
+
+		chunk.Edited.resize( size );
+
+		compress2( &chunk.Edited[0], &size, &records[0], records.size(), Z_DEFAULT_COMPRESSION );
+
+		chunk.Edited.resize( size );
+
+		chunk.Hdr.CompressedSize	= size;
+	}
+
+	chunk.Dirty = false;
+}
+
+void TileMapStreamer::request( const Vector2i& start, const Vector2i& end ) {
+	Vector2i cs, ce;
+
+	getChunkRange( start, end, mMargin, cs, ce );
+
+	for ( Int32 cx = cs.x; cx < ce.x; cx++ ) {
+		for ( Int32 cy = cs.y; cy < ce.y; cy++ ) {
+			Chunk& chunk = mChunks[ cx * mChunksSize.y + cy ];
+
+			if ( CHUNK_UNLOADED == chunk.State ) {
+				chunk.State	= CHUNK_LOADING;
+				chunk.Job	= JobSystem::instance()->run( cb::Make0( &chunk.Decode, &DecodeJob::run ) );
+			}
+		}
+	}
+}
+
+void TileMapStreamer::load( const Vector2i& start, const Vector2i& end ) {
+	Vector2i cs, ce;
+	bool waited = false;
+
+	getChunkRange( start, end, 0, cs, ce );
+
+	for ( Int32 cx = cs.x; cx < ce.x; cx++ ) {
+		for ( Int32 cy = cs.y; cy < ce.y; cy++ ) {
+			Uint32 index = cx * mChunksSize.y + cy;
+			Chunk& chunk = mChunks[ index ];
+
+			if ( CHUNK_UNLOADED == chunk.State ) {
+				decode( chunk );
+
+				addTiles( index );
+			} else if ( CHUNK_LOADING == chunk.State ) {
+				JobSystem::instance()->wait( chunk.Job );
+
+				waited = true;
+			}
+		}
+	}
+
+	if ( waited )
+		processDecoded();
+}
+
+void TileMapStreamer::loadAll() {
+	processDecoded();
+
+	load( Vector2i( 0, 0 ), Vector2i( mTilesSize.x, mTilesSize.y ) );
+}
+
+void TileMapStreamer::editTile( const Vector2i& tilePos ) {
+	if ( mUpdatingTiles || tilePos.x < 0 || tilePos.y < 0 || tilePos.x >= mTilesSize.x || tilePos.y >= mTilesSize.y )
+		return;
+
+	Chunk& chunk = mChunks[ ( tilePos.x / mChunkSize ) * mChunksSize.y + tilePos.y / mChunkSize ];
+
+	if ( CHUNK_LOADED != chunk.State )
+		load( tilePos, Vector2i( tilePos.x + 1, tilePos.y + 1 ) );
+
+	chunk.Dirty = true;
+}
+
+void TileMapStreamer::update( const Vector2i& start, const Vector2i& end ) {
+	processDecoded();
+
+	if ( mMemoryBudget > 0 && mMemoryUsed > mMemoryBudget )
+		evict( start, end );
+}
+
+void TileMapStreamer::processDecoded() {
+	std::vector<Uint32> decoded;
+
+	{
+		Lock l( mDecodedMutex );
+
+		decoded.swap( mDecoded );
+	}
+
+	for ( Uint32 i = 0; i < decoded.size(); i++ ) {
+		if ( CHUNK_LOADING == mChunks[ decoded[i] ].State ) {
+			addTiles( decoded[i] );
+		}
+	}
+}
+
+void TileMapStreamer::addTiles( const Uint32& index ) {
+	Chunk& chunk = mChunks[ index ];
+	Vector2i start, end;
+	size_t pos = 0;
+	size_t size = chunk.Records.size();
+	bool corrupted = false;
+
+	getChunkTiles( index, start, end );
+
+	mUpdatingTiles = true;
+
+	for ( Int32 y = start.y; y < end.y && pos < size && !corrupted; y++ ) {
+		for ( Int32 x = start.x; x < end.x && !corrupted; x++ ) {
+			Uint32 tReadFlag;
+
+			if ( pos + sizeof(Uint32) > size ) {
+				corrupted = true;
+				break;
+			}
+
+			memcpy( &tReadFlag, &chunk.Records[ pos ], sizeof(Uint32) );
+			pos += sizeof(Uint32);
+
+			for ( Uint32 i = 0; i < mMap->mLayerCount; i++ ) {
+				if ( tReadFlag & ( 1 << i ) ) {
+					sMapTileGOHdr tTGOHdr;
+
+					if ( pos + sizeof(sMapTileGOHdr) > size ) {
+						corrupted = true;
+						break;
+					}
+
+					memcpy( &tTGOHdr, &chunk.Records[ pos ], sizeof(sMapTileGOHdr) );
+					pos += sizeof(sMapTileGOHdr);
+
+					mMap->addTile( i, tTGOHdr, Vector2i( x, y ) );
+				}
+			}
+		}
+	}
+
+	mUpdatingTiles = false;
+
+	if ( corrupted ) {
+		eePRINTL( "TileMapStreamer::addTiles: A chunk of the map %s is corrupted.", mMap->getPath().c_str() );
+	}
+
+	std::vector<Uint8>().swap( chunk.Records );
+
+	chunk.State		= CHUNK_LOADED;
+	chunk.Memory	= getTilesMemory( start, end );
+	mMemoryUsed		+= chunk.Memory;
+	mLoadedCount++;
+}
+
+void TileMapStreamer::removeTiles( const Uint32& index ) {
+	Chunk& chunk = mChunks[ index ];
+	Vector2i start, end;
+
+	getChunkTiles( index, start, end );
+
+	//! The edited tiles would be lost, so they replace the records of the map file
+	if ( chunk.Dirty )
+		encode( index );
+
+	mUpdatingTiles = true;
+
+	for ( Uint32 i = 0; i < mMap->mLayerCount; i++ ) {
+		if ( NULL != mMap->mLayers[i] && mMap->mLayers[i]->getType() == MAP_LAYER_TILED ) {
+			TileMapLayer * tTLayer = reinterpret_cast<TileMapLayer*> ( mMap->mLayers[i] );
+
+			for ( Int32 y = start.y; y < end.y; y++ ) {
+				for ( Int32 x = start.x; x < end.x; x++ ) {
+					tTLayer->removeGameObject( Vector2i( x, y ) );
+				}
+			}
+		}
+	}
+
+	mUpdatingTiles = false;
+
+	chunk.State		= CHUNK_UNLOADED;
+	mMemoryUsed		-= chunk.Memory;
+	chunk.Memory	= 0;
+	mLoadedCount--;
+}
+
+size_t TileMapStreamer::getTilesMemory( const Vector2i& start, const Vector2i& end ) {
+	size_t objects = 0;
+	size_t compact = 0;
+
+	for ( Uint32 i = 0; i < mMap->mLayerCount; i++ ) {
+		if ( NULL != mMap->mLayers[i] && mMap->mLayers[i]->getType() == MAP_LAYER_TILED ) {
+			TileMapLayer * tTLayer = reinterpret_cast<TileMapLayer*> ( mMap->mLayers[i] );
+
+			for ( TileMapLayer::TileIterator it = tTLayer->getTiles( start, end ); it.next(); ) {
+				if ( NULL != it.getGameObject() ) {
+					objects++;
+				} else {
+					compact++;
+				}
+			}
+		}
+	}
+
+	// Most of the tile objects fit in a block of the game objects pool, the compact tiles use 3 bytes
+	return objects * GameObject::getAllocator().getBlockSize() + compact * ( sizeof(Uint16) + sizeof(Uint8) );
+}
+
+void TileMapStreamer::evict( const Vector2i& start, const Vector2i& end ) {
+	Vector2i cs, ce;
+	std::vector<EvictCandidate> candidates;
+
+	getChunkRange( start, end, mMargin, cs, ce );
+
+	//! Twice the center of the area kept, in chunks
+	Vector2i center( cs.x + ce.x, cs.y + ce.y );
+
+	for ( Uint32 i = 0; i < mChunks.size(); i++ ) {
+		Int32 cx = i / mChunksSize.y;
+		Int32 cy = i % mChunksSize.y;
+
+		if ( CHUNK_LOADED == mChunks[i].State && ( cx < cs.x || cx >= ce.x || cy < cs.y || cy >= ce.y ) ) {
+			EvictCandidate candidate;
+			Int64 dx = cx * 2 + 1 - center.x;
+			Int64 dy = cy * 2 + 1 - center.y;
+
+			candidate.Index		= i;
+			candidate.Distance	= dx * dx + dy * dy;
+
+			candidates.push_back( candidate );
+		}
+	}
+
+	std::sort( candidates.begin(), candidates.end() );
+
+	for ( Uint32 i = 0; i < candidates.size() && mMemoryUsed > mMemoryBudget; i++ ) {
+		removeTiles( candidates[i].Index );
+	}
+}
+
+Uint32 TileMapStreamer::getChunkCount() const {
+	return mChunks.size();
+}
+
+const Uint32& TileMapStreamer::getLoadedChunkCount() const {
+	return mLoadedCount;
+}
+
+const size_t& TileMapStreamer::getMemoryUsed() const {
+	return mMemoryUsed;
+}
+
+void TileMapStreamer::setMemoryBudget( const size_t& budget ) {
+	mMemoryBudget = budget;
+}
+
+void TileMapStreamer::setMargin( const Uint32& chunks ) {
+	mMargin = chunks;
+}
+
+}}}
@@ -0,0 +1,112 @@
+#ifndef EE_MAPSPRIVATECTILEMAPSTREAMER
+#define EE_MAPSPRIVATECTILEMAPSTREAMER
+
+#include <eepp/maps/base.hpp>
+#include <eepp/maps/maphelper.hpp>
+#include <eepp/system/jobsystem.hpp>
+#include <eepp/system/mutex.hpp>
+#include <vector>
+
+namespace EE { namespace Maps {
+
+class TileMap;
+
+namespace Private {
+
+/** @brief Loads the tiles of a chunked map ( MAP_FORMAT_CHUNKED ) on demand.
+**	The compressed chunks are kept in memory. The chunks around the view are decompressed by the job system and their tiles
+**	are added to the layers in the main thread. When the tiles loaded use more memory than the budget, the chunks farthest
+**	from the view are unloaded. The chunks with tiles edited after they were loaded are compressed again before unloading
+**	them, so the edits are kept. */
+class TileMapStreamer {
+	public:
+		TileMapStreamer( TileMap * map, const sMapChunkIndexHdr& indexHdr, const Sizei& tilesSize, const std::vector<sMapChunkHdr>& chunks, std::vector<Uint8>& data );
+
+		~TileMapStreamer();
+
+		/** Queues the chunks of the tiles between start and end ( exclusive ), plus the margin, to be loaded in background. */
+		void request( const Vector2i& start, const Vector2i& end );
+
+		/** Loads now the chunks of the tiles between start and end ( exclusive ) that aren't loaded yet. */
+		void load( const Vector2i& start, const Vector2i& end );
+
+		void loadAll();
+
+		/** Called before a tile is added, removed or moved by the layers. Loads the chunk of the tile if it isn't loaded yet, so the
+		**	edit isn't replaced later by the tiles of the map file, and marks it as edited. */
+		void editTile( const Vector2i& tilePos );
+
+		/** Adds the tiles of the chunks decoded in background to the layers, and unloads the far chunks if the memory budget is exceeded.
+		**	The chunks of the tiles between start and end, plus the margin, are never unloaded. */
+		void update( const Vector2i& start, const Vector2i& end );
+
+		Uint32 getChunkCount() const;
+
+		const Uint32& getLoadedChunkCount() const;
+
+		const size_t& getMemoryUsed() const;
+
+		void setMemoryBudget( const size_t& budget );
+
+		void setMargin( const Uint32& chunks );
+	protected:
+		enum ChunkState {
+			CHUNK_UNLOADED,
+			CHUNK_LOADING,
+			CHUNK_LOADED
+		};
+
+		struct DecodeJob {
+			TileMapStreamer *	Streamer;
+			Uint32				Index;
+
+			void run();
+		};
+
+		struct Chunk {
+			sMapChunkHdr		Hdr;
+			Uint32				State;
+			JobSystem::Handle	Job;
+			DecodeJob			Decode;
+			std::vector<Uint8>	Records;	//! The decompressed tile records, until they are added to the layers
+			std::vector<Uint8>	Edited;		//! The compressed tile records of a chunk edited and unloaded, they replace the ones in the map data
+			size_t				Memory;		//! The memory used by the tiles of the chunk
+			bool				Dirty;		//! The tiles were edited after the chunk was loaded
+		};
+
+		TileMap *			mMap;
+		Int32				mChunkSize;
+		Sizei				mChunksSize;
+		Sizei				mTilesSize;
+		Int32				mMargin;
+		size_t				mMemoryBudget;
+		size_t				mMemoryUsed;
+		Uint32				mLoadedCount;
+		bool				mUpdatingTiles;	//! The streamer is adding or removing tiles, they aren't edits
+		std::vector<Uint8>	mData;
+		std::vector<Chunk>	mChunks;
+		Mutex				mDecodedMutex;
+		std::vector<Uint32>	mDecoded;		//! The chunks decoded in background, waiting to be added to the layers
+
+		void getChunkRange( const Vector2i& start, const Vector2i& end, const Int32& margin, Vector2i& chunkStart, Vector2i& chunkEnd ) const;
+
+		void getChunkTiles( const Uint32& index, Vector2i& start, Vector2i& end ) const;
+
+		void decode( Chunk& chunk );
+
+		void encode( const Uint32& index );
+
+		void processDecoded();
+
+		void addTiles( const Uint32& index );
+
+		void removeTiles( const Uint32& index );
+
+		size_t getTilesMemory( const Vector2i& start, const Vector2i& end );
+
+		void evict( const Vector2i& start, const Vector2i& end );
+};
+
+}}}
+
+#endif
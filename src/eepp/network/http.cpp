@@ -1,5 +1,7 @@
 #include <eepp/network/http.hpp>
 #include <eepp/network/ssl/sslsocket.hpp>
+#include <eepp/network/socketselector.hpp>
+#include <eepp/system/thread.hpp>
 #include <cctype>
 #include <algorithm>
 #include <iterator>
@@ -10,9 +12,124 @@ using namespace EE::Network::SSL;
 
 namespace EE { namespace Network {
 
+namespace {
+	/** Reads the response from the connection, keeping the data received but not consumed yet */
+	class ResponseReader {
+		public:
+			/** @param selectable If the connection can be waited with a selector ( the SSL connections can have data buffered
+			**	that the selector doesn't see ), needed to stop waiting after the timeout or if the request is cancelled */
+			ResponseReader( TcpSocket * connection, bool selectable, const Clock& clock, Time timeout, const volatile bool * cancelled ) :
+				mConnection( connection ),
+				mClock( clock ),
+				mTimeout( timeout ),
+				mCancelled( cancelled ),
+				mPos( 0 ),
+				mReceived( 0 ),
+				mTimedOut( false ),
+				mSelectable( selectable && ( Time::Zero != timeout || NULL != cancelled ) )
+			{
+				if ( mSelectable )
+					mSelector.add( *mConnection );
+			}
+
+			/** Receives more data, @return False if the connection was closed, the timeout passed or the request was cancelled */
+			bool fill() {
+				std::size_t size = 0;
+
+				// Drop the consumed data before appending more
+				if ( mPos > 0 ) {
+					mBuffer.erase( 0, mPos );
+					mPos = 0;
+				}
+
+				// Waits in short slices to notice the cancellation
+				while ( mSelectable && !mSelector.wait( Milliseconds( 50 ) ) ) {
+					if ( ( NULL != mCancelled && *mCancelled ) || ( Time::Zero != mTimeout && mClock.getElapsedTime() >= mTimeout ) ) {
+						mTimedOut = true;
+						return false;
+					}
+				}
+
+				if ( mConnection->receive( mData, sizeof(mData), size ) != Socket::Done || 0 == size )
+					return false;
+
+				mBuffer.append( mData, size );
+				mReceived += size;
+
+				return true;
+			}
+
+			/** Finds the delimiter in the pending data, receiving more if needed.
+			**	@param found The position of the delimiter in the buffer */
+			bool find( const std::string& delimiter, std::size_t& found ) {
+				std::size_t searched = 0;
+
+				while ( ( found = mBuffer.find( delimiter, mPos + searched ) ) == std::string::npos ) {
+					// The delimiter can start in the last bytes already searched
+					if ( available() >= delimiter.size() )
+						searched = available() - delimiter.size() + 1;
+
+					if ( !fill() )
+						return false;
+				}
+
+				return true;
+			}
+
+			std::size_t available() const {
+				return mBuffer.size() - mPos;
+			}
+
+			const char * data() const {
+				return mBuffer.c_str() + mPos;
+			}
+
+			void consume( std::size_t size ) {
+				mPos += size;
+			}
+
+			/** @return The pending data until the position in the buffer, consuming it */
+			std::string extract( std::size_t end ) {
+				std::string str( mBuffer, mPos, end - mPos );
+				mPos = end;
+				return str;
+			}
+
+			const std::size_t& received() const {
+				return mReceived;
+			}
+
+			/** @return If the reader stopped because of the timeout or the cancellation */
+			const bool& timedOut() const {
+				return mTimedOut;
+			}
+		protected:
+			TcpSocket *				mConnection;
+			SocketSelector			mSelector;
+			const Clock&			mClock;
+			Time					mTimeout;
+			const volatile bool *	mCancelled;
+			std::string				mBuffer;
+			std::size_t				mPos;
+			std::size_t				mReceived;
+			bool					mTimedOut;
+			bool					mSelectable;
+			char					mData[16384];
+	};
+
+	void writeBody( std::string& body, IOStream * stream, const char * data, std::size_t size ) {
+		if ( NULL != stream ) {
+			stream->write( data, size );
+		} else {
+			body.append( data, size );
+		}
+	}
+}
+
 Http::Request::Request(const std::string& uri, Method method, const std::string& body, bool validateCertificate, bool validateHostname ) :
 	mValidateCertificate( validateCertificate ),
-	mValidateHostname( validateHostname )
+	mValidateHostname( validateHostname ),
+	mResponseStream( NULL )
 {
 	setMethod(method);
 	setUri(uri);
@@ -65,6 +182,14 @@ void Http::Request::setValidateHostname(bool enable) {
 	mValidateHostname = enable;
 }
 
+void Http::Request::setResponseStream( IOStream * stream ) {
+	mResponseStream = stream;
+}
+
+IOStream * Http::Request::getResponseStream() const {
+	return mResponseStream;
+}
+
 std::string Http::Request::prepare() const {
 	std::ostringstream out;
 
@@ -134,7 +259,7 @@ const std::string& Http::Response::getBody() const {
 	return mBody;
 }
 
-void Http::Response::parse(const std::string& data) {
+void Http::Response::parseHeader(const std::string& data) {
 	std::istringstream in(data);
 
 	// Extract the HTTP version from the first line
@@ -170,35 +295,6 @@ void Http::Response::parse(const std::string& data) {
 
 	// Parse the other lines, which contain fields, one by one
 	parseFields(in);
-
-	// Finally extract the body
-	mBody.clear();
-
-	// Determine whether the transfer is chunked
-	if (String::toLower(getField("transfer-encoding")) != "chunked") {
-		// Not chunked - everything at once
-		std::copy(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>(), std::back_inserter(mBody));
-	} else {
-		// Chunked - have to read chunk by chunk
-		std::size_t length;
-
-		// Read all chunks, identified by a chunk-size not being 0
-		while (in >> std::hex >> length) {
-			// Drop the rest of the line (chunk-extension)
-			in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-
-			// Copy the actual content data
-			std::istreambuf_iterator<char> it(in);
-			for (std::size_t i = 0; i < length; i++)
-				mBody.push_back(*it++);
-		}
-
-		// Drop the rest of the line (chunk-extension)
-		in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-
-		// Read all trailers (if present)
-		parseFields(in);
-	}
 }
 
 void Http::Response::parseFields(std::istream &in) {
@@ -221,43 +317,81 @@ void Http::Response::parseFields(std::istream &in) {
 	}
 }
 
+class Http::AsyncWorker : public Thread {
+	public:
+		AsyncWorker( Http * http ) :
+			mHttp( http ),
+			mFinished( false )
+		{}
+	protected:
+		friend class Http;
+		Http *	mHttp;
+		bool	mFinished;	///< Set by the thread when it leaves, guarded by the requests mutex
+
+		void run() {
+			mHttp->processAsyncRequests( this );
+		}
+};
+
 Http::Http() :
-	mConnection( NULL ),
 	mHost(),
 	mPort(0),
+	mWorkersCond( 0 ),
+	mLastHandle( 0 ),
+	mMaxAsyncRequests( 4 ),
+	mWorkerCount( 0 ),
+	mIdleWorkers( 0 ),
+	mRunning( true ),
+	mQueueResponses( false ),
+	mMaxConnections( 4 ),
 	mIsSSL( false )
 {
 }
 
 Http::Http(const std::string& host, unsigned short port, bool useSSL) :
-	mConnection( NULL ),
+	mWorkersCond( 0 ),
+	mLastHandle( 0 ),
+	mMaxAsyncRequests( 4 ),
+	mWorkerCount( 0 ),
+	mIdleWorkers( 0 ),
+	mRunning( true ),
+	mQueueResponses( false ),
+	mMaxConnections( 4 ),
 	mIsSSL( false )
 {
 	setHost(host, port, useSSL);
 }
 
 Http::~Http() {
-	std::list<AsyncRequest*>::iterator itt;
+	// First we wait to finish any request pending, the threads send every queued request before finishing
+	{
+		Lock l( mRequestsMutex );
 
-	// First we wait to finish any request pending
-	for ( itt = mThreads.begin(); itt != mThreads.end(); itt++ ) {
-		(*itt)->wait();
+		mRunning = false;
 	}
 
-	for ( itt = mThreads.begin(); itt != mThreads.end(); itt++ ) {
-		eeDelete( *itt );
+	mWorkersCond = 1;
+
+	for ( std::size_t i = 0; i < mWorkers.size(); i++ ) {
+		mWorkers[i]->wait();
+
+		eeDelete( mWorkers[i] );
 	}
 
-	// Then we destroy the last open connection
-	TcpSocket * tcp = mConnection;
+	// The responses not processed are discarded
+	for ( std::map<AsyncHandle, AsyncRequest*>::iterator it = mRequests.begin(); it != mRequests.end(); it++ ) {
+		eeDelete( it->second );
+	}
 
-	eeSAFE_DELETE( tcp );
+	// Then we destroy the connections kept alive
+	closeConnections();
 }
 
 void Http::setHost(const std::string& host, unsigned short port, bool useSSL) {
 	// Check the protocol
 	if (String::toLower(host.substr(0, 7)) == "http://") {
 		// HTTP protocol
+		mIsSSL		= false;
 		mHostName = host.substr(7);
 		mPort	 = (port != 0 ? port : 80);
 	} else if (String::toLower(host.substr(0, 8)) == "https://") {
@@ -286,18 +420,20 @@ void Http::setHost(const std::string& host, unsigned short port, bool useSSL) {
 		mHostName.erase(mHostName.size() - 1);
 
 	mHost = IpAddress(mHostName);
+
+	// The idle connections are connected to the previous host
+	closeConnections();
 }
 
 Http::Response Http::sendRequest(const Http::Request& request, Time timeout) {
+	return sendRequest( request, timeout, NULL );
+}
+
+Http::Response Http::sendRequest(const Http::Request& request, Time timeout, const volatile bool * cancelled) {
 	if ( 0 == mHost.toInteger() ) {
 		return Response();
 	}
 
-	if ( NULL == mConnection ) {
-		TcpSocket * Conn	= mIsSSL ? eeNew( SSLSocket, ( mHostName, request.getValidateCertificate(), request.getValidateHostname() ) ) : eeNew( TcpSocket, () );
-		mConnection			= Conn;
-	}
-
 	// First make sure that the request is valid -- add missing mandatory fields
 	Request toSend(request);
 
@@ -323,98 +459,472 @@ Http::Response Http::sendRequest(const Http::Request& request, Time timeout) {
 		toSend.setField("Content-Type", "application/x-www-form-urlencoded");
 	}
 
-	if ((toSend.mMajorVersion * 10 + toSend.mMinorVersion >= 11) && !toSend.hasField("Connection")) {
-		toSend.setField("Connection", "close");
+	if (!toSend.hasField("Connection")) {
+		toSend.setField("Connection", "keep-alive");
 	}
 
-	// Prepare the response
-	Response received;
+	// Convert the request to string
+	std::string requestStr = toSend.prepare();
+
+	Clock clock;
+
+	// A connection kept alive could have been closed by the server, in that case the request is sent again through a new connection
+	for ( int attempt = 0; attempt < 2; attempt++ ) {
+		bool reused = false;
+		Time remaining = timeout - clock.getElapsedTime();
+
+		if ( Time::Zero != timeout && remaining <= Time::Zero ) {
+			Response timedOut;
+			timedOut.mStatus = Response::TimedOut;
+			return timedOut;
+		}
+
+		Connection connection;
+
+		if ( !getConnection( toSend, Time::Zero != timeout ? remaining : Time::Zero, connection, reused ) ) {
+			break;
+		}
+
+		// Prepare the response
+		Response received;
+		bool keepAlive = false;
+		bool answered = false;
+
+		// Send it through the socket and wait for the server's response
+		if ( connection.Socket->send( requestStr.c_str(), requestStr.size() ) == Socket::Done ) {
+			answered = receiveResponse( connection.Socket, toSend, received, keepAlive, clock, timeout, cancelled );
+		}
+
+		releaseConnection( connection, keepAlive );
+
+		// Only the idempotent requests are sent again, the server could have processed the request before closing the connection
+		if ( answered || !reused || Request::Post == toSend.mMethod ) {
+			return received;
+		}
+	}
+
+	return Response();
+}
+
+bool Http::getConnection( const Request& request, Time timeout, Connection& connection, bool& reused ) {
+	connection.Host					= mHost;
+	connection.Port					= mPort;
+	connection.SSL					= mIsSSL;
+	connection.ValidateCertificate	= request.getValidateCertificate();
+	connection.ValidateHostname		= request.getValidateHostname();
+
+	{
+		Lock l( mConnectionsMutex );
+
+		// A request sent while the host was changed can return a connection to the previous host
+		for ( std::list<Connection>::iterator it = mConnections.begin(); it != mConnections.end(); it++ ) {
+			if ( it->Host == connection.Host && it->Port == connection.Port && it->SSL == connection.SSL &&
+				 ( !connection.SSL || ( it->ValidateCertificate == connection.ValidateCertificate && it->ValidateHostname == connection.ValidateHostname ) ) ) {
+				connection.Socket = it->Socket;
+
+				mConnections.erase( it );
+
+				reused = true;
+
+				return true;
+			}
+		}
+	}
+
+	reused = false;
+
+	connection.Socket = connection.SSL ? eeNew( SSLSocket, ( mHostName, connection.ValidateCertificate, connection.ValidateHostname ) ) : eeNew( TcpSocket, () );
 
 	// Connect the socket to the host
-	if (mConnection->connect(mHost, mPort, timeout) == Socket::Done) {
-		// Convert the request to string and send it through the connected socket
-		std::string requestStr = toSend.prepare();
-
-		if (!requestStr.empty()) {
-			// Send it through the socket
-			if (mConnection->send(requestStr.c_str(), requestStr.size()) == Socket::Done) {
-				// Wait for the server's response
-				std::string receivedStr;
-				std::size_t size = 0;
-				char buffer[1024];
+	if ( connection.Socket->connect( connection.Host, connection.Port, timeout ) != Socket::Done ) {
+		eeSAFE_DELETE( connection.Socket );
+
+		return false;
+	}
+
+	return true;
+}
+
+void Http::releaseConnection( Connection& connection, bool keepAlive ) {
+	if ( keepAlive ) {
+		Lock l( mConnectionsMutex );
+
+		if ( mConnections.size() < mMaxConnections ) {
+			mConnections.push_front( connection );
+
+			return;
+		}
+	}
+
+	// Close the connection
+	connection.Socket->disconnect();
+
+	eeSAFE_DELETE( connection.Socket );
+}
+
+bool Http::receiveResponse( TcpSocket * connection, const Request& request, Response& response, bool& keepAlive, const Clock& clock, Time timeout, const volatile bool * cancelled ) {
+	ResponseReader reader( connection, !mIsSSL, clock, timeout, cancelled );
+	IOStream * stream = request.getResponseStream();
+	std::size_t pos;
+
+	keepAlive = false;
+
+	// Read the status line and the fields. The interim responses ( 1xx ) are followed by the final response to the request, except
+	// 101 ( Switching Protocols ), after which the connection doesn't speak HTTP anymore.
+	while ( true ) {
+		if ( !reader.find( "\r\n\r\n", pos ) ) {
+			if ( reader.timedOut() ) {
+				response.mStatus = Response::TimedOut;
+				return true;
+			}
+
+			if ( 0 == reader.received() ) {
+				return false;
+			}
+
+			// The server closed the connection in the middle of the header
+			response.parseHeader( reader.extract( reader.available() ) );
+
+			return true;
+		}
+
+		response.parseHeader( reader.extract( pos + 4 ) );
+
+		if ( Response::InvalidResponse == response.mStatus ) {
+			return true;
+		}
+
+		if ( 1 != response.mStatus / 100 ) {
+			break;
+		}
+
+		if ( 101 == response.mStatus ) {
+			return true;
+		}
+
+		response = Response();
+	}
+
+	std::string connectionField = String::toLower( response.getField( "connection" ) );
 
-				while (mConnection->receive(buffer, sizeof(buffer), size) == Socket::Done) {
-					receivedStr.append(buffer, buffer + size);
+	if ( response.mMajorVersion * 10 + response.mMinorVersion >= 11 ) {
+		keepAlive = connectionField != "close";
+	} else {
+		keepAlive = connectionField == "keep-alive";
+	}
+
+	Request::FieldTable::const_iterator field = request.mFields.find( "connection" );
+
+	if ( field != request.mFields.end() && String::toLower( field->second ) == "close" ) {
+		keepAlive = false;
+	}
+
+	// The responses to HEAD requests, 204 and 304 don't have a body
+	if ( Request::Head == request.mMethod || Response::NoContent == response.mStatus || Response::NotModified == response.mStatus ) {
+		return true;
+	}
+
+	// Determine whether the transfer is chunked
+	if ( String::toLower( response.getField( "transfer-encoding" ) ) == "chunked" ) {
+		bool failed = false;
+
+		// Read all chunks, identified by a chunk-size not being 0
+		while ( !failed ) {
+			if ( !reader.find( "\r\n", pos ) ) {
+				failed = true;
+				break;
+			}
+
+			// Drop the chunk-extension
+			std::string sizeLine = reader.extract( pos + 2 );
+			std::size_t length = strtoul( sizeLine.c_str(), NULL, 16 );
+
+			if ( 0 == length ) {
+				break;
+			}
+
+			// Copy the actual content data, as it arrives
+			while ( length > 0 ) {
+				if ( 0 == reader.available() && !reader.fill() ) {
+					failed = true;
+					break;
 				}
 
-				// Build the Response object from the received data
-				received.parse(receivedStr);
+				std::size_t size = eemin( length, reader.available() );
+
+				writeBody( response.mBody, stream, reader.data(), size );
+
+				reader.consume( size );
+				length -= size;
+			}
+
+			// Drop the end of the chunk
+			if ( failed || !reader.find( "\r\n", pos ) ) {
+				failed = true;
+				break;
 			}
+
+			reader.extract( pos + 2 );
 		}
 
-		// Close the connection
-		mConnection->disconnect();
+		if ( failed ) {
+			keepAlive = false;
+		} else {
+			// Read all trailers (if present), until the empty line
+			std::string trailers;
+
+			while ( reader.find( "\r\n", pos ) ) {
+				std::string line = reader.extract( pos + 2 );
+
+				if ( line.size() <= 2 ) {
+					break;
+				}
+
+				trailers += line;
+			}
+
+			std::istringstream in( trailers );
+
+			response.parseFields( in );
+		}
+	} else if ( !response.getField( "content-length" ).empty() ) {
+		// Read the exact length of the body
+		std::size_t length = strtoul( response.getField( "content-length" ).c_str(), NULL, 10 );
+
+		while ( length > 0 ) {
+			if ( 0 == reader.available() && !reader.fill() ) {
+				keepAlive = false;
+				break;
+			}
+
+			std::size_t size = eemin( length, reader.available() );
+
+			writeBody( response.mBody, stream, reader.data(), size );
+
+			reader.consume( size );
+			length -= size;
+		}
+	} else {
+		// Without length, everything until the server closes the connection
+		keepAlive = false;
+
+		do {
+			writeBody( response.mBody, stream, reader.data(), reader.available() );
+
+			reader.consume( reader.available() );
+		} while ( reader.fill() );
 	}
 
-	return received;
+	// The body is incomplete
+	if ( reader.timedOut() ) {
+		response.mStatus = Response::TimedOut;
+		keepAlive = false;
+	}
+
+	return true;
 }
 
-Http::AsyncRequest::AsyncRequest(Http *http, AsyncResponseCallback cb, Http::Request request, Time timeout) :
-	mHttp( http ),
+Http::AsyncRequest::AsyncRequest(AsyncHandle handle, AsyncResponseCallback cb, Http::Request request, Time timeout) :
+	mHandle( handle ),
 	mCb( cb ),
 	mRequest( request ),
 	mTimeout( timeout ),
-	mRunning( true )
+	mCancelled( false )
 {
 }
 
-void Http::AsyncRequest::run() {
-	Http::Response response = mHttp->sendRequest( mRequest, mTimeout );
+void Http::processAsyncRequests( AsyncWorker * worker ) {
+	while ( true ) {
+		AsyncRequest * ar = NULL;
+
+		{
+			Lock l( mRequestsMutex );
+
+			// The cancelled requests are discarded without sending them
+			while ( !mQueuedRequests.empty() && mQueuedRequests.front()->mCancelled ) {
+				mRequests.erase( mQueuedRequests.front()->mHandle );
+				eeDelete( mQueuedRequests.front() );
+				mQueuedRequests.pop_front();
+			}
+
+			if ( mQueuedRequests.empty() ) {
+				// The thread finishes when the Http instance is destroyed or the maximum was reduced
+				if ( !mRunning || mWorkerCount > mMaxAsyncRequests ) {
+					mWorkerCount--;
+					worker->mFinished = true;
+					return;
+				}
+
+				mIdleWorkers++;
+			} else {
+				ar = mQueuedRequests.front();
+				mQueuedRequests.pop_front();
+			}
+		}
+
+		if ( NULL == ar ) {
+			mWorkersCond.waitAndLock( 1, Condition::ManualUnlock );
+
+			bool wakeUpNext;
+
+			{
+				Lock l( mRequestsMutex );
+
+				mIdleWorkers--;
+
+				// Another idle thread is needed if there are more requests than this one, or to finish
+				wakeUpNext = mQueuedRequests.size() > 1 || !mRunning || mWorkerCount > mMaxAsyncRequests;
+			}
+
+			mWorkersCond.unlock( wakeUpNext ? 1 : 0 );
+
+			continue;
+		}
+
+		ar->mResponse = sendRequest( ar->mRequest, ar->mTimeout, &ar->mCancelled );
+
+		bool deliver = false;
 
-	mCb( *mHttp, mRequest, response );
+		{
+			Lock l( mRequestsMutex );
 
-	// The Async Request destroys the socket used to create the request
-	TcpSocket * tcp = mHttp->mConnection;
-	eeSAFE_DELETE( tcp );
-	mHttp->mConnection = NULL;
+			if ( ar->mCancelled ) {
+				mRequests.erase( ar->mHandle );
+			} else if ( mQueueResponses ) {
+				mResponses.push_back( ar );
+				ar = NULL;
+			} else {
+				// Once removed the request can't be cancelled
+				mRequests.erase( ar->mHandle );
+				deliver = true;
+			}
+		}
+
+		if ( deliver ) {
+			ar->mCb( *this, ar->mRequest, ar->mResponse );
+		}
 
-	mRunning = false;
+		eeSAFE_DELETE( ar );
+	}
 }
 
-void Http::removeOldThreads() {
-	std::list<AsyncRequest*> remove;
+Http::AsyncHandle Http::sendAsyncRequest( AsyncResponseCallback cb, const Http::Request& request, Time timeout ) {
+	AsyncHandle handle;
+
+	{
+		Lock l( mRequestsMutex );
+
+		AsyncRequest * asyncRequest = eeNew( AsyncRequest, ( ++mLastHandle, cb, request, timeout ) );
+
+		handle = asyncRequest->mHandle;
 
-	std::list<AsyncRequest*>::iterator it = mThreads.begin();
+		mRequests[ handle ] = asyncRequest;
+		mQueuedRequests.push_back( asyncRequest );
 
-	for ( ; it != mThreads.end(); it++ ) {
-		AsyncRequest * ar = (*it);
+		// A new thread is only started if the idle threads can't take the requests queued
+		if ( mIdleWorkers < mQueuedRequests.size() && mWorkerCount < mMaxAsyncRequests ) {
+			std::size_t i = 0;
 
-		if ( !ar->mRunning ) {
-			// We need to be sure, since the state is set in the thread, this will not block the thread anyway
-			ar->wait();
+			// Delete the threads already finished
+			while ( i < mWorkers.size() ) {
+				if ( mWorkers[i]->mFinished ) {
+					mWorkers[i]->wait();
 
-			eeDelete( ar );
+					eeDelete( mWorkers[i] );
 
-			remove.push_back( ar );
+					mWorkers[i] = mWorkers.back();
+					mWorkers.pop_back();
+				} else {
+					i++;
+				}
+			}
+
+			AsyncWorker * worker = eeNew( AsyncWorker, ( this ) );
+
+			mWorkers.push_back( worker );
+			mWorkerCount++;
+
+			worker->launch();
 		}
 	}
 
-	for ( it = remove.begin(); it != remove.end(); it++ ) {
-		mThreads.remove( (*it) );
+	// Wakes up an idle thread, the condition can't be signaled while holding the requests mutex
+	mWorkersCond = 1;
+
+	return handle;
+}
+
+bool Http::cancelAsyncRequest( const AsyncHandle& handle ) {
+	Lock l( mRequestsMutex );
+
+	std::map<AsyncHandle, AsyncRequest*>::iterator it = mRequests.find( handle );
+
+	if ( it == mRequests.end() || it->second->mCancelled ) {
+		return false;
 	}
+
+	it->second->mCancelled = true;
+
+	return true;
 }
 
-void Http::sendAsyncRequest( AsyncResponseCallback cb, const Http::Request& request, Time timeout ) {
-	AsyncRequest * thread = eeNew( AsyncRequest, ( this, cb, request, timeout ) );
+Uint32 Http::getPendingAsyncRequestCount() {
+	Lock l( mRequestsMutex );
 
-	thread->launch();
+	return mRequests.size();
+}
 
-	// Clean old threads
-	Lock l( mThreadsMutex );
+void Http::setMaxAsyncRequests( const Uint32& count ) {
+	{
+		Lock l( mRequestsMutex );
 
-	removeOldThreads();
+		mMaxAsyncRequests = eemax( (Uint32)1, count );
+	}
 
-	mThreads.push_back( thread );
+	// The idle threads over the maximum finish
+	mWorkersCond = 1;
+}
+
+const Uint32& Http::getMaxAsyncRequests() const {
+	return mMaxAsyncRequests;
+}
+
+void Http::setQueueAsyncResponses( bool queue ) {
+	Lock l( mRequestsMutex );
+
+	mQueueResponses = queue;
+}
+
+const bool& Http::isQueueAsyncResponses() const {
+	return mQueueResponses;
+}
+
+Uint32 Http::processAsyncResponses() {
+	std::deque<AsyncRequest*> responses;
+	Uint32 count = 0;
+
+	{
+		Lock l( mRequestsMutex );
+
+		responses.swap( mResponses );
+
+		for ( std::size_t i = 0; i < responses.size(); i++ ) {
+			mRequests.erase( responses[i]->mHandle );
+		}
+	}
+
+	for ( std::size_t i = 0; i < responses.size(); i++ ) {
+		AsyncRequest * ar = responses[i];
+
+		if ( !ar->mCancelled ) {
+			ar->mCb( *this, ar->mRequest, ar->mResponse );
+			count++;
+		}
+
+		eeDelete( ar );
+	}
+
+	return count;
 }
 
 const IpAddress &Http::getHost() const {
@@ -429,4 +939,38 @@ const unsigned short& Http::getPort() const {
 	return mPort;
 }
 
+void Http::setMaxConnections( const unsigned int& count ) {
+	mMaxConnections = count;
+
+	Lock l( mConnectionsMutex );
+
+	while ( mConnections.size() > mMaxConnections ) {
+		TcpSocket * connection = mConnections.back().Socket;
+
+		mConnections.pop_back();
+
+		eeSAFE_DELETE( connection );
+	}
+}
+
+const unsigned int& Http::getMaxConnections() const {
+	return mMaxConnections;
+}
+
+unsigned int Http::getIdleConnectionCount() {
+	Lock l( mConnectionsMutex );
+
+	return mConnections.size();
+}
+
+void Http::closeConnections() {
+	Lock l( mConnectionsMutex );
+
+	for ( std::list<Connection>::iterator it = mConnections.begin(); it != mConnections.end(); it++ ) {
+		eeSAFE_DELETE( it->Socket );
+	}
+
+	mConnections.clear();
+}
+
 }}
@@ -11,7 +11,8 @@ namespace EE { namespace Network {
 Packet::Packet() :
 	mReadPos(0),
 	mSendPos(0),
-	mIsValid(true)
+	mIsValid(true),
+	mReceiveBuffer(NULL)
 {
 }
 
@@ -33,6 +34,14 @@ void Packet::clear() {
 	mIsValid = true;
 }
 
+void Packet::reserve(std::size_t sizeInBytes) {
+	mData.reserve(sizeInBytes);
+}
+
+std::size_t Packet::getCapacity() const {
+	return mData.capacity();
+}
+
 const void* Packet::getData() const {
 	return !mData.empty() ? &mData[0] : NULL;
 }
@@ -347,7 +356,13 @@ const void* Packet::onSend(std::size_t& size) {
 }
 
 void Packet::onReceive(const void* data, std::size_t size) {
-	append(data, size);
+	// If the data is the buffer of the socket, swap the buffers instead of copying it.
+	// The socket keeps the previous buffer of the packet to receive the next one.
+	if (NULL != mReceiveBuffer && mData.empty() && size == mReceiveBuffer->size() && data == &(*mReceiveBuffer)[0]) {
+		mData.swap(*mReceiveBuffer);
+	} else {
+		append(data, size);
+	}
 }
 
 }}
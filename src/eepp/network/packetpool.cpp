@@ -0,0 +1,66 @@
+#include <eepp/network/packetpool.hpp>
+#include <eepp/network/packet.hpp>
+#include <eepp/system/lock.hpp>
+
+namespace EE { namespace Network {
+
+PacketPool::PacketPool( const Uint32& maxPackets, const std::size_t& maxPacketCapacity ) :
+	mMaxPackets( maxPackets ),
+	mMaxPacketCapacity( maxPacketCapacity )
+{
+}
+
+PacketPool::~PacketPool() {
+	clear();
+}
+
+Packet * PacketPool::acquire() {
+	{
+		Lock l( mMutex );
+
+		if ( !mPackets.empty() ) {
+			Packet * packet = mPackets.back();
+
+			mPackets.pop_back();
+
+			return packet;
+		}
+	}
+
+	return eeNew( Packet, () );
+}
+
+void PacketPool::release( Packet * packet ) {
+	if ( NULL == packet )
+		return;
+
+	packet->clear();
+
+	if ( packet->getCapacity() <= mMaxPacketCapacity ) {
+		Lock l( mMutex );
+
+		if ( mPackets.size() < mMaxPackets ) {
+			mPackets.push_back( packet );
+			return;
+		}
+	}
+
+	eeDelete( packet );
+}
+
+void PacketPool::clear() {
+	Lock l( mMutex );
+
+	for ( Uint32 i = 0; i < mPackets.size(); i++ )
+		eeDelete( mPackets[i] );
+
+	mPackets.clear();
+}
+
+Uint32 PacketPool::getCount() {
+	Lock l( mMutex );
+
+	return mPackets.size();
+}
+
+}}
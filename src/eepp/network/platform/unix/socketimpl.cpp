@@ -5,6 +5,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <cstring>
+#include <sys/uio.h>
 
 namespace EE { namespace Network { namespace Private {
 
@@ -38,6 +39,26 @@ void SocketImpl::setBlocking(SocketHandle sock, bool block) {
 		fcntl(sock, F_SETFL, status | O_NONBLOCK);
 }
 
+int SocketImpl::send(SocketHandle sock, const IoBuffer* buffers, Uint32 count, int flags) {
+	iovec iov[MaxIoBuffers];
+	msghdr message;
+
+	if (count > MaxIoBuffers)
+		count = MaxIoBuffers;
+
+	for (Uint32 i = 0; i < count; i++) {
+		iov[i].iov_base	= const_cast<void*>(buffers[i].Data);
+		iov[i].iov_len	= buffers[i].Size;
+	}
+
+	// sendmsg is writev with send flags, so it can avoid SIGPIPE too
+	std::memset(&message, 0, sizeof(message));
+	message.msg_iov		= iov;
+	message.msg_iovlen	= count;
+
+	return static_cast<int>(sendmsg(sock, &message, flags));
+}
+
 Socket::Status SocketImpl::getErrorStatus() {
 	// The followings are sometimes equal to EWOULDBLOCK,
 	// so we have to make a special case for them in order
@@ -28,6 +28,24 @@ void SocketImpl::setBlocking(SocketHandle sock, bool block) {
 	ioctlsocket(sock, FIONBIO, &blocking);
 }
 
+int SocketImpl::send(SocketHandle sock, const IoBuffer* buffers, Uint32 count, int flags) {
+	WSABUF wsaBuffers[MaxIoBuffers];
+	DWORD sent = 0;
+
+	if (count > MaxIoBuffers)
+		count = MaxIoBuffers;
+
+	for (Uint32 i = 0; i < count; i++) {
+		wsaBuffers[i].buf = static_cast<char*>(const_cast<void*>(buffers[i].Data));
+		wsaBuffers[i].len = static_cast<ULONG>(buffers[i].Size);
+	}
+
+	if (WSASend(sock, wsaBuffers, count, &sent, flags, NULL, NULL) == SOCKET_ERROR)
+		return -1;
+
+	return static_cast<int>(sent);
+}
+
 Socket::Status SocketImpl::getErrorStatus() {
 	switch (WSAGetLastError()) {
 		case WSAEWOULDBLOCK:	return Socket::NotReady;
@@ -25,6 +25,15 @@ class SocketImpl {
 		// Types
 		typedef socklen_t AddrLength;
 
+		/** @brief A buffer of a scatter/gather operation */
+		struct IoBuffer {
+			const void*	Data;
+			std::size_t	Size;
+		};
+
+		/** @brief Maximum number of buffers sent in a single call */
+		static const Uint32 MaxIoBuffers = 16;
+
 		/** @brief  Create an internal sockaddr_in address
 		**  @param address Target address
 		**  @param port	Target port
@@ -44,6 +53,15 @@ class SocketImpl {
 		**  @param block New blocking state of the socket */
 		static void setBlocking(SocketHandle sock, bool block);
 
+		/** @brief  Send several buffers with a single call (gather write)
+		**  The buffers after MaxIoBuffers are not sent, as if the send was partial.
+		**  @param sock	Handle of the socket
+		**  @param buffers Buffers to send, in order
+		**  @param count   Number of buffers
+		**  @param flags   Flags of the send
+		**  @return Number of bytes sent, or -1 on error */
+		static int send(SocketHandle sock, const IoBuffer* buffers, Uint32 count, int flags);
+
 		/** Get the last socket error status
 		**  @return Status corresponding to the last socket error */
 		static Socket::Status getErrorStatus();
@@ -0,0 +1,637 @@
+#include <eepp/network/socketpoller.hpp>
+#include <eepp/network/socket.hpp>
+#include <eepp/network/platform/platformimpl.hpp>
+#include <eepp/system/hashindex.hpp>
+#include <eepp/system/mutex.hpp>
+#include <eepp/system/lock.hpp>
+
+#if EE_PLATFORM == EE_PLATFORM_LINUX
+	#include <sys/epoll.h>
+	#define EE_SOCKETPOLLER_EPOLL
+#endif
+
+#if defined( EE_PLATFORM_POSIX )
+	#include <poll.h>
+	#include <fcntl.h>
+	#include <errno.h>
+	#include <unistd.h>
+#endif
+
+namespace EE { namespace Network {
+
+namespace {
+	struct Entry {
+		Socket *		Sock;
+		SocketHandle	Handle;		//! The handle when the socket was added, to unregister it even if the socket was closed
+		Uint32			Events;
+		Uint32			ReadyEvents;
+		Uint32			ReadyPos;	//! The position in the ready list
+		Uint64			ReadyWait;	//! The wait in which the socket was ready
+	};
+
+	Uint64 socketKey( Socket * socket ) {
+		return (Uint64)reinterpret_cast<size_t>( socket );
+	}
+
+	int timeoutToMilliseconds( const Time& timeout ) {
+		if ( timeout == Time::Zero )
+			return -1;
+
+		if ( timeout < Time::Zero )
+			return 0;
+
+		// Rounds up, so a wait of less than a millisecond doesn't become a busy loop
+		return (int)eemin( ( timeout.asMicroseconds() + 999 ) / 1000, (Int64)0x7FFFFFFF );
+	}
+
+#if EE_PLATFORM == EE_PLATFORM_WIN
+	//! Windows fd_set is a count followed by an array of handles, so it can be allocated with any size
+	fd_set * resetSet( std::vector<SOCKET>& set, const size_t& capacity ) {
+		set.resize( capacity + 1 );
+
+		fd_set * fds = reinterpret_cast<fd_set*>( &set[0] );
+		fds->fd_count = 0;
+
+		return fds;
+	}
+
+	void addToSet( fd_set * fds, const SOCKET& handle ) {
+		fds->fd_array[ fds->fd_count++ ] = handle;
+	}
+#endif
+}
+
+struct SocketPoller::SocketPollerImpl {
+	Backend						Type;
+	std::vector<Entry>			Entries;
+	HashIndex<Uint32, Uint64>	Indexes;			//! Socket address to position in Entries
+	std::vector<ReadyEvent>		Ready;
+	Uint64						WaitCount;
+	bool						WokenUp;
+	Mutex						WakeUpMutex;
+	bool						WakeUpEnabled;
+	bool						WakeUpCreated;		//! Guarded by WakeUpMutex, the channel can be created by wakeUp from another thread
+	bool						WakeUpRegistered;	//! Only accessed by the thread that waits
+#if defined( EE_SOCKETPOLLER_EPOLL )
+	int							EpollFd;
+	std::vector<epoll_event>	EpollEvents;
+#endif
+#if defined( EE_PLATFORM_POSIX )
+	int							WakeUpPipe[2];
+	std::vector<pollfd>			PollFds;			//! The wake up pipe followed by the entries
+#else
+	SocketHandle				WakeUpSocket;		//! A loopback UDP socket that sends datagrams to itself
+	sockaddr_in					WakeUpAddress;
+	HashIndex<Uint32, Uint64>	HandleIndexes;		//! Socket handle to position in Entries
+	std::vector<SOCKET>			ReadSet;
+	std::vector<SOCKET>			WriteSet;
+	std::vector<SOCKET>			ErrorSet;
+#endif
+
+	SocketPollerImpl( Backend backend, bool wakeUpEnabled ) :
+		Type( Auto ),
+		WaitCount( 0 ),
+		WokenUp( false ),
+		WakeUpEnabled( wakeUpEnabled ),
+		WakeUpCreated( false ),
+		WakeUpRegistered( false )
+	{
+#if defined( EE_SOCKETPOLLER_EPOLL )
+		EpollFd = -1;
+
+		if ( Poll != backend ) {
+			EpollFd = epoll_create1( EPOLL_CLOEXEC );
+
+			if ( -1 == EpollFd )
+				eePRINTL( "SocketPoller: epoll_create1 failed, using poll instead." );
+		}
+
+		Type = -1 != EpollFd ? Epoll : Poll;
+#elif defined( EE_PLATFORM_POSIX )
+		Type = Poll;
+#else
+		Type = Select;
+#endif
+
+#if defined( EE_PLATFORM_POSIX )
+		WakeUpPipe[0] = WakeUpPipe[1] = -1;
+
+		// poll ignores the negative handles, so the slot is unused until the pipe exists
+		pollfd wakeUp;
+		wakeUp.fd		= -1;
+		wakeUp.events	= POLLIN;
+		wakeUp.revents	= 0;
+		PollFds.push_back( wakeUp );
+#else
+		WakeUpSocket = Private::SocketImpl::invalidSocket();
+#endif
+	}
+
+	~SocketPollerImpl() {
+#if defined( EE_SOCKETPOLLER_EPOLL )
+		if ( -1 != EpollFd )
+			::close( EpollFd );
+#endif
+#if defined( EE_PLATFORM_POSIX )
+		if ( WakeUpCreated ) {
+			::close( WakeUpPipe[0] );
+			::close( WakeUpPipe[1] );
+		}
+#else
+		if ( WakeUpCreated )
+			Private::SocketImpl::close( WakeUpSocket );
+#endif
+	}
+
+	//! Must be called with WakeUpMutex locked
+	void createWakeUp() {
+		if ( WakeUpCreated )
+			return;
+
+#if defined( EE_PLATFORM_POSIX )
+		if ( -1 == pipe( WakeUpPipe ) ) {
+			eePRINTL( "SocketPoller: failed to create the wake up pipe." );
+			return;
+		}
+
+		for ( Uint32 i = 0; i < 2; i++ ) {
+			fcntl( WakeUpPipe[i], F_SETFL, fcntl( WakeUpPipe[i], F_GETFL ) | O_NONBLOCK );
+			fcntl( WakeUpPipe[i], F_SETFD, FD_CLOEXEC );
+		}
+#else
+		WakeUpSocket = socket( AF_INET, SOCK_DGRAM, 0 );
+
+		if ( Private::SocketImpl::invalidSocket() == WakeUpSocket ) {
+			eePRINTL( "SocketPoller: failed to create the wake up socket." );
+			return;
+		}
+
+		sockaddr_in address = Private::SocketImpl::createAddress( INADDR_LOOPBACK, 0 );
+		Private::SocketImpl::AddrLength size = sizeof(WakeUpAddress);
+
+		if ( bind( WakeUpSocket, reinterpret_cast<sockaddr*>( &address ), sizeof(address) ) == -1 ||
+			 getsockname( WakeUpSocket, reinterpret_cast<sockaddr*>( &WakeUpAddress ), &size ) == -1 )
+		{
+			eePRINTL( "SocketPoller: failed to bind the wake up socket." );
+			Private::SocketImpl::close( WakeUpSocket );
+			WakeUpSocket = Private::SocketImpl::invalidSocket();
+			return;
+		}
+
+		Private::SocketImpl::setBlocking( WakeUpSocket, false );
+#endif
+
+		WakeUpCreated = true;
+	}
+
+	//! Adds the wake up channel to the set waited, the first time that it waits
+	void registerWakeUp() {
+		if ( WakeUpRegistered || !WakeUpEnabled )
+			return;
+
+		{
+			Lock l( WakeUpMutex );
+
+			createWakeUp();
+
+			if ( !WakeUpCreated )
+				return;
+		}
+
+#if defined( EE_SOCKETPOLLER_EPOLL )
+		if ( Epoll == Type ) {
+			epoll_event ev;
+			ev.events	= EPOLLIN;
+			ev.data.ptr	= NULL;
+
+			epoll_ctl( EpollFd, EPOLL_CTL_ADD, WakeUpPipe[0], &ev );
+		}
+#endif
+#if defined( EE_PLATFORM_POSIX )
+		PollFds[0].fd = WakeUpPipe[0];
+#endif
+
+		WakeUpRegistered = true;
+	}
+
+	void drainWakeUp() {
+		char buffer[64];
+
+#if defined( EE_PLATFORM_POSIX )
+		while ( read( WakeUpPipe[0], buffer, sizeof(buffer) ) > 0 ) {}
+#else
+		while ( recv( WakeUpSocket, buffer, sizeof(buffer), 0 ) > 0 ) {}
+#endif
+
+		WokenUp = true;
+	}
+
+	void markReady( const Uint32& index, const Uint32& events ) {
+		Entry& entry = Entries[ index ];
+
+		// The sockets closed or failed are also readable, so the next receive reports the error
+		Uint32 ready = events & ( entry.Events | Error );
+
+		if ( ( ready & Error ) && ( entry.Events & Readable ) )
+			ready |= Readable;
+
+		if ( 0 == ready )
+			return;
+
+		if ( entry.ReadyWait == WaitCount ) {
+			entry.ReadyEvents |= ready;
+			Ready[ entry.ReadyPos ].Events |= ready;
+		} else {
+			ReadyEvent ev;
+			ev.Sock		= entry.Sock;
+			ev.Events	= ready;
+
+			entry.ReadyWait		= WaitCount;
+			entry.ReadyEvents	= ready;
+			entry.ReadyPos		= Ready.size();
+
+			Ready.push_back( ev );
+		}
+	}
+
+#if defined( EE_SOCKETPOLLER_EPOLL )
+	static Uint32 toEpollEvents( const Uint32& events ) {
+		Uint32 ev = 0;
+
+		if ( events & Readable )		ev |= EPOLLIN;
+		if ( events & Writable )		ev |= EPOLLOUT;
+		if ( events & EdgeTriggered )	ev |= EPOLLET;
+
+		return ev;
+	}
+
+	static Uint32 fromEpollEvents( const Uint32& ev ) {
+		Uint32 events = 0;
+
+		if ( ev & ( EPOLLIN | EPOLLPRI ) )	events |= Readable;
+		if ( ev & EPOLLOUT )				events |= Writable;
+		if ( ev & ( EPOLLERR | EPOLLHUP ) )	events |= Error;
+
+		return events;
+	}
+
+	void waitEpoll( const int& timeout ) {
+		size_t maxEvents = eemin( Entries.size() + 1, (size_t)1024 );
+
+		if ( EpollEvents.size() < maxEvents )
+			EpollEvents.resize( maxEvents );
+
+		int count = epoll_wait( EpollFd, &EpollEvents[0], (int)maxEvents, timeout );
+
+		for ( int i = 0; i < count; i++ ) {
+			epoll_event& ev = EpollEvents[i];
+
+			if ( NULL == ev.data.ptr ) {
+				drainWakeUp();
+			} else {
+				Uint32 * index = Indexes.find( socketKey( reinterpret_cast<Socket*>( ev.data.ptr ) ) );
+
+				if ( NULL != index )
+					markReady( *index, fromEpollEvents( ev.events ) );
+			}
+		}
+	}
+#endif
+
+#if defined( EE_PLATFORM_POSIX )
+	static short toPollEvents( const Uint32& events ) {
+		short ev = 0;
+
+		if ( events & Readable )	ev |= POLLIN;
+		if ( events & Writable )	ev |= POLLOUT;
+
+		return ev;
+	}
+
+	static Uint32 fromPollEvents( const short& ev ) {
+		Uint32 events = 0;
+
+		if ( ev & ( POLLIN | POLLPRI ) )				events |= Readable;
+		if ( ev & POLLOUT )								events |= Writable;
+		if ( ev & ( POLLERR | POLLHUP | POLLNVAL ) )	events |= Error;
+
+		return events;
+	}
+
+	void waitPoll( const int& timeout ) {
+		int count = poll( &PollFds[0], PollFds.size(), timeout );
+
+		if ( count <= 0 )
+			return;
+
+		if ( 0 != PollFds[0].revents ) {
+			drainWakeUp();
+			count--;
+		}
+
+		for ( size_t i = 1; i < PollFds.size() && count > 0; i++ ) {
+			if ( 0 != PollFds[i].revents ) {
+				markReady( i - 1, fromPollEvents( PollFds[i].revents ) );
+				count--;
+			}
+		}
+	}
+#else
+	void waitSelect( const Time& timeout ) {
+		size_t capacity = Entries.size() + 1;
+		fd_set * readSet = resetSet( ReadSet, capacity );
+		fd_set * writeSet = resetSet( WriteSet, capacity );
+		fd_set * errorSet = resetSet( ErrorSet, capacity );
+
+		if ( WakeUpRegistered )
+			addToSet( readSet, WakeUpSocket );
+
+		for ( size_t i = 0; i < Entries.size(); i++ ) {
+			if ( Entries[i].Events & Readable )
+				addToSet( readSet, Entries[i].Handle );
+
+			if ( Entries[i].Events & Writable )
+				addToSet( writeSet, Entries[i].Handle );
+
+			addToSet( errorSet, Entries[i].Handle );
+		}
+
+		// select fails immediately when every set is empty
+		if ( 0 == readSet->fd_count && 0 == errorSet->fd_count )
+			return;
+
+		timeval time;
+		Int64 microseconds = eemax( timeout.asMicroseconds(), (Int64)0 );
+		time.tv_sec		= static_cast<long>( microseconds / 1000000 );
+		time.tv_usec	= static_cast<long>( microseconds % 1000000 );
+
+		if ( select( 0, readSet, writeSet, errorSet, timeout != Time::Zero ? &time : NULL ) <= 0 )
+			return;
+
+		// select leaves in each set only the handles ready
+		fd_set * sets[3] = { readSet, writeSet, errorSet };
+		Uint32 events[3] = { Readable, Writable, Error };
+
+		for ( Uint32 s = 0; s < 3; s++ ) {
+			for ( u_int i = 0; i < sets[s]->fd_count; i++ ) {
+				SOCKET handle = sets[s]->fd_array[i];
+
+				if ( WakeUpRegistered && handle == WakeUpSocket ) {
+					drainWakeUp();
+				} else {
+					Uint32 * index = HandleIndexes.find( (Uint64)handle );
+
+					if ( NULL != index )
+						markReady( *index, events[s] );
+				}
+			}
+		}
+	}
+#endif
+
+	void wakeUp() {
+		if ( !WakeUpEnabled )
+			return;
+
+		Lock l( WakeUpMutex );
+
+		createWakeUp();
+
+		if ( !WakeUpCreated )
+			return;
+
+		// If the pipe or the socket buffer is full there is already a wake up pending
+#if defined( EE_PLATFORM_POSIX )
+		char c = 1;
+
+		if ( -1 == write( WakeUpPipe[1], &c, 1 ) ) {}
+#else
+		sendto( WakeUpSocket, "w", 1, 0, reinterpret_cast<sockaddr*>( &WakeUpAddress ), sizeof(WakeUpAddress) );
+#endif
+	}
+};
+
+SocketPoller::SocketPoller( Backend backend, bool wakeUpEnabled ) :
+	mImpl( eeNew( SocketPollerImpl, ( backend, wakeUpEnabled ) ) )
+{
+}
+
+SocketPoller::~SocketPoller() {
+	eeSAFE_DELETE( mImpl );
+}
+
+bool SocketPoller::add( Socket& socket, Uint32 events ) {
+	SocketHandle handle = socket.getHandle();
+
+	if ( handle == Private::SocketImpl::invalidSocket() || NULL != mImpl->Indexes.find( socketKey( &socket ) ) )
+		return false;
+
+	Uint32 index = mImpl->Entries.size();
+
+#if defined( EE_SOCKETPOLLER_EPOLL )
+	if ( Epoll == mImpl->Type ) {
+		epoll_event ev;
+		ev.events	= SocketPollerImpl::toEpollEvents( events );
+		ev.data.ptr	= &socket;
+
+		if ( -1 == epoll_ctl( mImpl->EpollFd, EPOLL_CTL_ADD, handle, &ev ) ) {
+			eePRINTL( "SocketPoller::add: epoll_ctl failed with error %d", errno );
+			return false;
+		}
+	}
+#endif
+
+#if defined( EE_PLATFORM_POSIX )
+	pollfd pfd;
+	pfd.fd		= handle;
+	pfd.events	= SocketPollerImpl::toPollEvents( events );
+	pfd.revents	= 0;
+
+	mImpl->PollFds.push_back( pfd );
+#else
+	mImpl->HandleIndexes.insert( (Uint64)handle, index );
+#endif
+
+	Entry entry;
+	entry.Sock			= &socket;
+	entry.Handle		= handle;
+	entry.Events		= events;
+	entry.ReadyEvents	= 0;
+	entry.ReadyPos		= 0;
+	entry.ReadyWait		= 0;
+
+	mImpl->Entries.push_back( entry );
+	mImpl->Indexes.insert( socketKey( &socket ), index );
+
+	return true;
+}
+
+bool SocketPoller::modify( Socket& socket, Uint32 events ) {
+	Uint32 * found = mImpl->Indexes.find( socketKey( &socket ) );
+
+	if ( NULL == found )
+		return false;
+
+	Entry& entry = mImpl->Entries[ *found ];
+
+#if defined( EE_SOCKETPOLLER_EPOLL )
+	if ( Epoll == mImpl->Type ) {
+		epoll_event ev;
+		ev.events	= SocketPollerImpl::toEpollEvents( events );
+		ev.data.ptr	= &socket;
+
+		if ( -1 == epoll_ctl( mImpl->EpollFd, EPOLL_CTL_MOD, entry.Handle, &ev ) )
+			return false;
+	}
+#endif
+
+#if defined( EE_PLATFORM_POSIX )
+	mImpl->PollFds[ *found + 1 ].events = SocketPollerImpl::toPollEvents( events );
+#endif
+
+	entry.Events = events;
+
+	return true;
+}
+
+bool SocketPoller::remove( Socket& socket ) {
+	Uint32 * found = mImpl->Indexes.find( socketKey( &socket ) );
+
+	if ( NULL == found )
+		return false;
+
+	Uint32 index = *found;
+	Uint32 last = mImpl->Entries.size() - 1;
+	Entry& entry = mImpl->Entries[ index ];
+
+#if defined( EE_SOCKETPOLLER_EPOLL )
+	if ( Epoll == mImpl->Type ) {
+		// Fails if the socket was already closed, which also removes it from the epoll set
+		epoll_event ev;
+		epoll_ctl( mImpl->EpollFd, EPOLL_CTL_DEL, entry.Handle, &ev );
+	}
+#endif
+
+#if EE_PLATFORM == EE_PLATFORM_WIN
+	mImpl->HandleIndexes.erase( (Uint64)entry.Handle );
+#endif
+
+	mImpl->Indexes.erase( socketKey( &socket ) );
+
+	// Moves the last entry to the hole, so the entries stay contiguous
+	if ( index != last ) {
+		mImpl->Entries[ index ] = mImpl->Entries[ last ];
+		mImpl->Indexes.insert( socketKey( mImpl->Entries[ index ].Sock ), index );
+
+#if defined( EE_PLATFORM_POSIX )
+		mImpl->PollFds[ index + 1 ] = mImpl->PollFds[ last + 1 ];
+#else
+		mImpl->HandleIndexes.insert( (Uint64)mImpl->Entries[ index ].Handle, index );
+#endif
+	}
+
+	mImpl->Entries.pop_back();
+
+#if defined( EE_PLATFORM_POSIX )
+	mImpl->PollFds.pop_back();
+#endif
+
+	return true;
+}
+
+void SocketPoller::clear() {
+#if defined( EE_SOCKETPOLLER_EPOLL )
+	if ( Epoll == mImpl->Type ) {
+		epoll_event ev;
+
+		for ( size_t i = 0; i < mImpl->Entries.size(); i++ )
+			epoll_ctl( mImpl->EpollFd, EPOLL_CTL_DEL, mImpl->Entries[i].Handle, &ev );
+	}
+#endif
+
+#if defined( EE_PLATFORM_POSIX )
+	mImpl->PollFds.resize( 1 );
+#else
+	mImpl->HandleIndexes.clear();
+#endif
+
+	mImpl->Entries.clear();
+	mImpl->Indexes.clear();
+	mImpl->Ready.clear();
+}
+
+Uint32 SocketPoller::wait( Time timeout ) {
+	mImpl->Ready.clear();
+	mImpl->WokenUp = false;
+	mImpl->WaitCount++;
+
+	mImpl->registerWakeUp();
+
+	switch ( mImpl->Type ) {
+#if defined( EE_SOCKETPOLLER_EPOLL )
+		case Epoll:
+			mImpl->waitEpoll( timeoutToMilliseconds( timeout ) );
+			break;
+#endif
+#if defined( EE_PLATFORM_POSIX )
+		case Poll:
+			mImpl->waitPoll( timeoutToMilliseconds( timeout ) );
+			break;
+#else
+		case Select:
+			mImpl->waitSelect( timeout );
+			break;
+#endif
+		default:
+			break;
+	}
+
+	return mImpl->Ready.size();
+}
+
+const std::vector<SocketPoller::ReadyEvent>& SocketPoller::getReady() const {
+	return mImpl->Ready;
+}
+
+Uint32 SocketPoller::isReady( Socket& socket ) const {
+	Uint32 * found = mImpl->Indexes.find( socketKey( &socket ) );
+
+	if ( NULL == found )
+		return 0;
+
+	const Entry& entry = mImpl->Entries[ *found ];
+
+	return entry.ReadyWait == mImpl->WaitCount ? entry.ReadyEvents : 0;
+}
+
+bool SocketPoller::wasWokenUp() const {
+	return mImpl->WokenUp;
+}
+
+void SocketPoller::wakeUp() {
+	mImpl->wakeUp();
+}
+
+bool SocketPoller::contains( Socket& socket ) const {
+	return NULL != mImpl->Indexes.find( socketKey( &socket ) );
+}
+
+Uint32 SocketPoller::getEvents( Socket& socket ) const {
+	Uint32 * found = mImpl->Indexes.find( socketKey( &socket ) );
+
+	return NULL != found ? mImpl->Entries[ *found ].Events : 0;
+}
+
+Uint32 SocketPoller::getSocketCount() const {
+	return mImpl->Entries.size();
+}
+
+Socket * SocketPoller::getSocket( const Uint32& index ) const {
+	return index < mImpl->Entries.size() ? mImpl->Entries[ index ].Sock : NULL;
+}
+
+SocketPoller::Backend SocketPoller::getBackend() const {
+	return mImpl->Type;
+}
+
+}}
@@ -1,5 +1,7 @@
 #include <eepp/network/ssl/sslsocket.hpp>
 #include <eepp/network/ssl/sslsocketimpl.hpp>
+#include <eepp/network/packet.hpp>
+#include <eepp/network/platform/platformimpl.hpp>
 #include <eepp/system/filesystem.hpp>
 #include <eepp/system/mutex.hpp>
 #include <eepp/system/lock.hpp>
@@ -10,6 +12,9 @@
 
 using namespace EE::System;
 
+//! The packets up to this size ( counting the size prefix ) are copied to the stack and sent with a single write
+#define SSL_PACKET_BLOCK_SIZE	( 1024 )
+
 namespace EE { namespace Network { namespace SSL {
 
 static bool ssl_initialized = false;
@@ -128,7 +133,55 @@ Socket::Status SSLSocket::receive(void* data, std::size_t size, std::size_t& rec
 }
 
 Socket::Status SSLSocket::send(Packet& packet) {
-	return TcpSocket::send( packet );
+	// The gather write of TcpSocket would skip the encryption, so the size and the data are written through the SSL implementation
+	std::size_t size = 0;
+	const void * data = packet.onSend( size );
+	Uint32 packetSize = htonl( static_cast<Uint32>( size ) );
+	std::size_t total = sizeof(packetSize) + size;
+	std::size_t sent = packet.mSendPos;
+	Status status;
+
+	if ( 0 == sent && total <= SSL_PACKET_BLOCK_SIZE ) {
+		// The small packets are encrypted in a single record
+		char block[ SSL_PACKET_BLOCK_SIZE ];
+
+		memcpy( block, &packetSize, sizeof(packetSize) );
+
+		if ( size > 0 )
+			memcpy( block + sizeof(packetSize), data, size );
+
+		status = send( block, total );
+	} else {
+		status = Done;
+
+		// Resume from the last partial send
+		if ( sent < sizeof(packetSize) ) {
+			status = send( reinterpret_cast<const char*>( &packetSize ) + sent, sizeof(packetSize) - sent );
+
+			if ( Done == status )
+				sent = sizeof(packetSize);
+		}
+
+		if ( Done == status && sent < total ) {
+			status = send( static_cast<const char*>( data ) + sent - sizeof(packetSize), total - sent );
+
+			if ( Done == status )
+				sent = total;
+		}
+	}
+
+	if ( Done == status ) {
+		packet.mSendPos = 0;
+		return Done;
+	}
+
+	// In the case of a partial send, record the location to resume from
+	if ( ( NotReady == status ) && ( sent > packet.mSendPos ) ) {
+		packet.mSendPos = sent;
+		return Partial;
+	}
+
+	return status;
 }
 
 Socket::Status SSLSocket::receive(Packet& packet) {
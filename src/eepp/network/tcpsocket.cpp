@@ -222,10 +222,9 @@ Socket::Status TcpSocket::send(Packet& packet) {
 	// This means that we have to send the packet size first, so that the
 	// receiver knows the actual end of the packet in the data stream.
 
-	// We allocate an extra memory block so that the size can be sent
-	// together with the data in a single call. This may seem inefficient,
-	// but it is actually required to avoid partial send, which could cause
-	// data corruption on the receiving end.
+	// The size and the data are sent together with a single gather write,
+	// so there's no need to copy them into a single block to avoid partial
+	// sends, which could cause data corruption on the receiving end.
 
 	// Get the data to send from the packet
 	std::size_t size = 0;
@@ -233,27 +232,49 @@ Socket::Status TcpSocket::send(Packet& packet) {
 
 	// First convert the packet size to network byte order
 	Uint32 packetSize = htonl(static_cast<Uint32>(size));
- 
-	// Allocate memory for the data block to send
-	std::vector<char> blockToSend(sizeof(packetSize) + size);
- 
-	// Copy the packet size and data into the block to send
-	std::memcpy(&blockToSend[0], &packetSize, sizeof(packetSize));
-	if (size > 0)
-		std::memcpy(&blockToSend[0] + sizeof(packetSize), data, size);
-
-	// Send the data block
-	std::size_t sent;
-	Status status = send(&blockToSend[0] + packet.mSendPos, blockToSend.size() - packet.mSendPos, sent );
+	std::size_t total = sizeof(packetSize) + size;
+	std::size_t sent = packet.mSendPos;
+
+	// Loop until every byte has been sent, resuming from the last partial send
+	while (sent < total) {
+		Private::SocketImpl::IoBuffer buffers[2];
+		Uint32 count = 0;
+
+		if (sent < sizeof(packetSize)) {
+			buffers[count].Data = reinterpret_cast<const char*>(&packetSize) + sent;
+			buffers[count].Size = sizeof(packetSize) - sent;
+			count++;
+		}
+
+		if (size > 0) {
+			std::size_t offset = sent > sizeof(packetSize) ? sent - sizeof(packetSize) : 0;
+
+			buffers[count].Data = static_cast<const char*>(data) + offset;
+			buffers[count].Size = size - offset;
+			count++;
+		}
+
+		int result = Private::SocketImpl::send(getHandle(), buffers, count, flags);
+
+		// Check for errors
+		if (result < 0) {
+			Status status = Private::SocketImpl::getErrorStatus();
+
+			// In the case of a partial send, record the location to resume from
+			if ((status == NotReady) && (sent > packet.mSendPos)) {
+				packet.mSendPos = sent;
+				return Partial;
+			}
+
+			return status;
+		}
 
-	// In the case of a partial send, record the location to resume from
-	if (status == Partial) {
-		packet.mSendPos += sent;
-	} else if (status == Done) {
-		packet.mSendPos = 0;
+		sent += result;
 	}
 
-	return status;
+	packet.mSendPos = 0;
+
+	return Done;
 }
 
 Socket::Status TcpSocket::receive(Packet& packet) {
@@ -261,50 +282,51 @@ Socket::Status TcpSocket::receive(Packet& packet) {
 	packet.clear();
 
 	// We start by getting the size of the incoming packet
-	Uint32 packetSize = 0;
 	std::size_t received = 0;
-	if (mPendingPacket.SizeReceived < sizeof(mPendingPacket.Size)) {
-		// Loop until we've received the entire size of the packet
-		// (even a 4 byte variable may be received in more than one call)
-		while (mPendingPacket.SizeReceived < sizeof(mPendingPacket.Size)) {
-			char* data = reinterpret_cast<char*>(&mPendingPacket.Size) + mPendingPacket.SizeReceived;
-			Status status = receive(data, sizeof(mPendingPacket.Size) - mPendingPacket.SizeReceived, received);
-			mPendingPacket.SizeReceived += received;
-
-			if (status != Done)
-				return status;
-		}
 
-		// The packet size has been fully received
-		packetSize = ntohl(mPendingPacket.Size);
-	} else {
-		// The packet size has already been received in a previous call
-		packetSize = ntohl(mPendingPacket.Size);
+	// Loop until we've received the entire size of the packet
+	// (even a 4 byte variable may be received in more than one call)
+	while (mPendingPacket.SizeReceived < sizeof(mPendingPacket.Size)) {
+		char* data = reinterpret_cast<char*>(&mPendingPacket.Size) + mPendingPacket.SizeReceived;
+		Status status = receive(data, sizeof(mPendingPacket.Size) - mPendingPacket.SizeReceived, received);
+		mPendingPacket.SizeReceived += received;
+
+		if (status != Done)
+			return status;
 	}
 
-	// Loop until we receive all the packet data
-	char buffer[1024];
-	while (mPendingPacket.Data.size() < packetSize) {
-		// Receive a chunk of data
-		std::size_t sizeToGet = eemin(static_cast<std::size_t>(packetSize - mPendingPacket.Data.size()), sizeof(buffer));
-		Status status = receive(buffer, sizeToGet, received);
+	std::size_t packetSize = ntohl(mPendingPacket.Size);
+
+	// Loop until we receive all the packet data, directly into the buffer
+	while (mPendingPacket.DataReceived < packetSize) {
+		// The buffer is reused between packets. It grows with the data received,
+		// so a wrong size in the header doesn't allocate all the memory at once.
+		std::size_t bufferSize = eemin(packetSize, eemax(mPendingPacket.DataReceived * 2, static_cast<std::size_t>(65536)));
+
+		if (mPendingPacket.Data.size() < bufferSize)
+			mPendingPacket.Data.resize(bufferSize);
+
+		Status status = receive(&mPendingPacket.Data[0] + mPendingPacket.DataReceived, bufferSize - mPendingPacket.DataReceived, received);
 		if (status != Done)
 			return status;
 
-		// Append it into the packet
-		if (received > 0) {
-			mPendingPacket.Data.resize(mPendingPacket.Data.size() + received);
-			char* begin = &mPendingPacket.Data[0] + mPendingPacket.Data.size() - received;
-			std::memcpy(begin, buffer, received);
-		}
+		mPendingPacket.DataReceived += received;
 	}
 
-	// We have received all the packet data: we can copy it to the user packet
-	if (!mPendingPacket.Data.empty())
-		packet.onReceive(&mPendingPacket.Data[0], mPendingPacket.Data.size());
+	// We have received all the packet data: the user packet takes the buffer,
+	// unless it transforms the data in onReceive
+	if (packetSize > 0) {
+		mPendingPacket.Data.resize(packetSize);
 
-	// Clear the pending packet data
-	mPendingPacket = PendingPacket();
+		packet.mReceiveBuffer = &mPendingPacket.Data;
+		packet.onReceive(&mPendingPacket.Data[0], packetSize);
+		packet.mReceiveBuffer = NULL;
+	}
+
+	// Clear the pending packet data, keeping the buffer
+	mPendingPacket.Size			= 0;
+	mPendingPacket.SizeReceived	= 0;
+	mPendingPacket.DataReceived	= 0;
 
 	return Done;
 }
@@ -312,6 +334,7 @@ Socket::Status TcpSocket::receive(Packet& packet) {
 TcpSocket::PendingPacket::PendingPacket() :
 	Size		(0),
 	SizeReceived(0),
+	DataReceived(0),
 	Data		()
 {
 }
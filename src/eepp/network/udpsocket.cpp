@@ -3,6 +3,18 @@
 #include <eepp/network/packet.hpp>
 #include <eepp/network/platform/platformimpl.hpp>
 #include <algorithm>
+#include <cstring>
+
+#if defined( EE_PLATFORM_POSIX )
+#include <sys/ioctl.h>
+#include <errno.h>
+#endif
+
+namespace
+{
+	// Number of datagrams sent or received per system call by the batch functions
+	const std::size_t BatchSize = 64;
+}
 
 namespace EE { namespace Network {
 
@@ -136,5 +148,139 @@ Socket::Status UdpSocket::receive(Packet& packet, IpAddress& remoteAddress, unsi
 	return status;
 }
 
+Socket::Status UdpSocket::send(const Datagram* datagrams, std::size_t count, std::size_t& sent) {
+	// First clear the variables to fill
+	sent = 0;
+
+	// Create the internal socket if it doesn't exist
+	create();
+
+#if EE_PLATFORM == EE_PLATFORM_LINUX
+	while (sent < count) {
+		mmsghdr messages[BatchSize];
+		iovec buffers[BatchSize];
+		sockaddr_in addresses[BatchSize];
+		std::size_t batch = 0;
+
+		// Build the messages until the batch is full or a datagram is too big, which is reported by send
+		for (; batch < BatchSize && sent + batch < count && datagrams[sent + batch].Size <= MaxDatagramSize; batch++) {
+			const Datagram& datagram = datagrams[sent + batch];
+
+			addresses[batch]	= Private::SocketImpl::createAddress(datagram.Address.toInteger(), datagram.Port);
+			buffers[batch].iov_base	= datagram.Data;
+			buffers[batch].iov_len	= datagram.Size;
+
+			std::memset(&messages[batch], 0, sizeof(mmsghdr));
+			messages[batch].msg_hdr.msg_name	= &addresses[batch];
+			messages[batch].msg_hdr.msg_namelen	= sizeof(sockaddr_in);
+			messages[batch].msg_hdr.msg_iov		= &buffers[batch];
+			messages[batch].msg_hdr.msg_iovlen	= 1;
+		}
+
+		if (0 == batch)
+			break;
+
+		int result = sendmmsg(getHandle(), messages, batch, 0);
+
+		if (result < 0) {
+			// Kernels older than 3.0 don't have sendmmsg, send them one by one
+			if (errno == ENOSYS)
+				break;
+
+			Status status = Private::SocketImpl::getErrorStatus();
+
+			return (status == NotReady) && sent ? Partial : status;
+		}
+
+		sent += result;
+	}
+#endif
+
+	for (; sent < count; sent++) {
+		const Datagram& datagram = datagrams[sent];
+		Status status = send(datagram.Data, datagram.Size, datagram.Address, datagram.Port);
+
+		if (status != Done)
+			return (status == NotReady) && sent ? Partial : status;
+	}
+
+	return Done;
+}
+
+Socket::Status UdpSocket::receive(Datagram* datagrams, std::size_t count, std::size_t& received) {
+	// First clear the variables to fill
+	received = 0;
+
+#if EE_PLATFORM == EE_PLATFORM_LINUX
+	while (received < count) {
+		mmsghdr messages[BatchSize];
+		iovec buffers[BatchSize];
+		sockaddr_in addresses[BatchSize];
+		std::size_t batch = eemin(BatchSize, count - received);
+
+		for (std::size_t i = 0; i < batch; i++) {
+			Datagram& datagram = datagrams[received + i];
+
+			buffers[i].iov_base	= datagram.Data;
+			buffers[i].iov_len	= datagram.Size;
+
+			std::memset(&messages[i], 0, sizeof(mmsghdr));
+			messages[i].msg_hdr.msg_name	= &addresses[i];
+			messages[i].msg_hdr.msg_namelen	= sizeof(sockaddr_in);
+			messages[i].msg_hdr.msg_iov		= &buffers[i];
+			messages[i].msg_hdr.msg_iovlen	= 1;
+		}
+
+		// Only the first call waits, and only for the first datagram
+		int result = recvmmsg(getHandle(), messages, batch, received ? MSG_DONTWAIT : MSG_WAITFORONE, NULL);
+
+		if (result < 0) {
+			// Kernels older than 2.6.33 don't have recvmmsg, receive them one by one
+			if (errno == ENOSYS)
+				break;
+
+			return received ? Done : Private::SocketImpl::getErrorStatus();
+		}
+
+		// Fill the sender informations
+		for (int i = 0; i < result; i++) {
+			Datagram& datagram = datagrams[received + i];
+
+			datagram.Received	= messages[i].msg_len;
+			datagram.Address	= IpAddress(ntohl(addresses[i].sin_addr.s_addr));
+			datagram.Port		= ntohs(addresses[i].sin_port);
+		}
+
+		received += result;
+
+		if (static_cast<std::size_t>(result) < batch)
+			return Done;
+	}
+#endif
+
+	for (; received < count; received++) {
+		// After the first datagram, receive only the datagrams already queued
+		if (received) {
+#if EE_PLATFORM == EE_PLATFORM_WIN
+			u_long queued = 0;
+			ioctlsocket(getHandle(), FIONREAD, &queued);
+#else
+			int queued = 0;
+			ioctl(getHandle(), FIONREAD, &queued);
+#endif
+
+			if (0 == queued)
+				break;
+		}
+
+		Datagram& datagram = datagrams[received];
+		Status status = receive(datagram.Data, datagram.Size, datagram.Received, datagram.Address, datagram.Port);
+
+		if (status != Done)
+			return received ? Done : status;
+	}
+
+	return Done;
+}
 
 }}
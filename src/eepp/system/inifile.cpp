@@ -48,7 +48,7 @@ bool IniFile::loadFromPack( Pack * Pack, std::string iniPackPath ) {
 	if ( NULL != Pack && Pack->isOpen() && Pack->exists( iniPackPath ) ) {
 		SafeDataPointer PData;
 
-		Pack->extractFileToMemory( iniPackPath, PData );
+		Pack->getFileView( iniPackPath, PData );
 
 		return loadFromMemory( PData.Data, PData.DataSize );
 	}
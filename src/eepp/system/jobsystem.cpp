@@ -0,0 +1,347 @@
+#include <eepp/system/jobsystem.hpp>
+#include <eepp/system/lock.hpp>
+#include <eepp/system/sys.hpp>
+
+namespace EE { namespace System {
+
+SINGLETON_DECLARE_IMPLEMENTATION(JobSystem)
+
+const JobSystem::Handle JobSystem::InvalidHandle = 0;
+
+class JobSystem::Job {
+	public:
+		Job( const Handle& handle, JobCallback callback ) :
+			Id( handle ),
+			Callback( callback ),
+			PendingDependencies( 0 ),
+			Done( 0 ),
+			Waiters( 0 )
+		{}
+
+		Handle				Id;
+		JobCallback			Callback;
+		Uint32				PendingDependencies;
+		std::vector<Job*>	Dependents;
+		Condition			Done;		//! Set to 1 when the job finished
+		Uint32				Waiters;	//! The threads blocked in Done, the last one deletes the job
+};
+
+class JobSystem::Worker : public Thread {
+	public:
+		Worker( JobSystem * jobSystem ) :
+			mJobSystem( jobSystem )
+		{}
+
+		/** Pops the newest job of the worker queue */
+		Job * pop() {
+			Lock l( mMutex );
+
+			if ( mQueue.empty() )
+				return NULL;
+
+			Job * job = mQueue.back();
+			mQueue.pop_back();
+			return job;
+		}
+
+		/** Takes the oldest job of the worker queue */
+		Job * steal() {
+			Lock l( mMutex );
+
+			if ( mQueue.empty() )
+				return NULL;
+
+			Job * job = mQueue.front();
+			mQueue.pop_front();
+			return job;
+		}
+
+		void push( Job * job ) {
+			Lock l( mMutex );
+			mQueue.push_back( job );
+		}
+	protected:
+		JobSystem *			mJobSystem;
+		Mutex				mMutex;
+		std::deque<Job*>	mQueue;
+
+		void run() {
+			mJobSystem->workerLoop( this );
+		}
+};
+
+JobSystem::JobSystem() :
+	mLastHandle( InvalidHandle ),
+	mNextWorker( 0 ),
+	mWorkCond( 0 ),
+	mIdleCond( 1 ),
+	mQueued( 0 ),
+	mBlockedWorkers( 0 ),
+	mRunning( true ),
+	mCurrentWorker( NULL )
+{
+	int count = Sys::getCPUCount();
+
+	if ( count < 1 )
+		count = 1;
+
+	for ( int i = 0; i < count; i++ ) {
+		mWorkers.push_back( eeNew( Worker, ( this ) ) );
+	}
+
+	for ( size_t i = 0; i < mWorkers.size(); i++ ) {
+		mWorkers[i]->launch();
+	}
+}
+
+JobSystem::~JobSystem() {
+	waitAll();
+
+	mRunning = false;
+
+	// Wakes up the workers, every worker leaving the loop will wake up the next one
+	mWorkCond = 1;
+
+	for ( size_t i = 0; i < mWorkers.size(); i++ ) {
+		mWorkers[i]->wait();
+		eeDelete( mWorkers[i] );
+	}
+
+	mWorkers.clear();
+}
+
+JobSystem::Handle JobSystem::run( JobCallback job ) {
+	return addJob( job, NULL, 0 );
+}
+
+JobSystem::Handle JobSystem::run( JobCallback job, const Handle& dependency ) {
+	return addJob( job, &dependency, 1 );
+}
+
+JobSystem::Handle JobSystem::run( JobCallback job, const std::vector<Handle>& dependencies ) {
+	return addJob( job, dependencies.empty() ? NULL : &dependencies[0], dependencies.size() );
+}
+
+JobSystem::Handle JobSystem::addJob( JobCallback callback, const Handle * dependencies, const Uint32& count ) {
+	Job * job;
+
+	{
+		Lock l( mJobsMutex );
+
+		job = eeNew( Job, ( ++mLastHandle, callback ) );
+
+		for ( Uint32 i = 0; i < count; i++ ) {
+			std::map<Handle, Job*>::iterator it = mJobs.find( dependencies[i] );
+
+			if ( it != mJobs.end() ) {
+				it->second->Dependents.push_back( job );
+				job->PendingDependencies++;
+			}
+		}
+
+		if ( mJobs.empty() )
+			mIdleCond = 0;
+
+		mJobs[ job->Id ] = job;
+
+		if ( job->PendingDependencies > 0 )
+			return job->Id;
+	}
+
+	Handle handle = job->Id;
+
+	enqueue( job );
+
+	return handle;
+}
+
+void JobSystem::enqueue( Job * job ) {
+	Worker * worker = mCurrentWorker;
+
+	if ( NULL == worker ) {
+		Lock l( mJobsMutex );
+
+		worker = mWorkers[ mNextWorker ];
+
+		mNextWorker = ( mNextWorker + 1 ) % mWorkers.size();
+	}
+
+	// Counted before the job is visible to the other workers, a worker could steal it and discount it first
+	mWorkCond.lock();
+	mQueued++;
+	worker->push( job );
+	mWorkCond.unlock( 1 );
+}
+
+JobSystem::Job * JobSystem::fetchJob( Worker * worker ) {
+	Job * job = NULL;
+
+	if ( NULL != worker )
+		job = worker->pop();
+
+	if ( NULL == job ) {
+		size_t count = mWorkers.size();
+		size_t start = Sys::getTicks() % count;
+
+		for ( size_t i = 0; i < count && NULL == job; i++ ) {
+			Worker * victim = mWorkers[ ( start + i ) % count ];
+
+			if ( victim != worker )
+				job = victim->steal();
+		}
+	}
+
+	if ( NULL != job ) {
+		mWorkCond.lock();
+		mQueued--;
+		mWorkCond.unlock( mQueued > 0 ? 1 : 0 );
+	}
+
+	return job;
+}
+
+void JobSystem::execute( Job * job ) {
+	job->Callback();
+
+	std::vector<Job*> ready;
+	bool waited;
+
+	{
+		Lock l( mJobsMutex );
+
+		mJobs.erase( job->Id );
+
+		for ( size_t i = 0; i < job->Dependents.size(); i++ ) {
+			Job * dependent = job->Dependents[i];
+
+			if ( 0 == --dependent->PendingDependencies )
+				ready.push_back( dependent );
+		}
+
+		// Signaled under the lock, the waiters can't delete the job until the lock is released
+		waited = job->Waiters > 0;
+
+		if ( waited )
+			job->Done = 1;
+
+		if ( mJobs.empty() )
+			mIdleCond = 1;
+	}
+
+	if ( !waited )
+		eeDelete( job );
+
+	for ( size_t i = 0; i < ready.size(); i++ )
+		enqueue( ready[i] );
+}
+
+void JobSystem::workerLoop( Worker * worker ) {
+	mCurrentWorker = worker;
+
+	while ( true ) {
+		Job * job = fetchJob( worker );
+
+		if ( NULL != job ) {
+			execute( job );
+			continue;
+		}
+
+		mWorkCond.waitAndLock( 1, Condition::ManualUnlock );
+
+		bool running = mRunning;
+
+		mWorkCond.unlock( ( mQueued > 0 || !running ) ? 1 : 0 );
+
+		if ( !running && 0 == mQueued )
+			break;
+	}
+
+	mCurrentWorker = NULL;
+}
+
+bool JobSystem::isDone( const Handle& job ) {
+	Lock l( mJobsMutex );
+
+	return mJobs.find( job ) == mJobs.end();
+}
+
+void JobSystem::wait( const Handle& handle ) {
+	Worker * worker = mCurrentWorker;
+
+	while ( true ) {
+		if ( NULL != worker ) {
+			Job * job = fetchJob( worker );
+
+			if ( NULL != job ) {
+				execute( job );
+				continue;
+			}
+		}
+
+		Job * job = NULL;
+
+		{
+			Lock l( mJobsMutex );
+
+			std::map<Handle, Job*>::iterator it = mJobs.find( handle );
+
+			if ( it == mJobs.end() )
+				return;
+
+			// A worker only blocks while another one can run the jobs queued from now on
+			if ( NULL == worker || mBlockedWorkers + 1 < mWorkers.size() ) {
+				job = it->second;
+				job->Waiters++;
+
+				if ( NULL != worker )
+					mBlockedWorkers++;
+			}
+		}
+
+		if ( NULL == job ) {
+			// Every other worker is blocked waiting for a job, so the job can only finish after running the jobs queued next
+			mWorkCond.waitAndLock( 1, Condition::AutoUnlock );
+			continue;
+		}
+
+		job->Done.waitAndLock( 1, Condition::AutoUnlock );
+
+		bool last;
+
+		{
+			Lock l( mJobsMutex );
+
+			if ( NULL != worker )
+				mBlockedWorkers--;
+
+			last = 0 == --job->Waiters;
+		}
+
+		if ( last )
+			eeDelete( job );
+
+		return;
+	}
+}
+
+void JobSystem::waitAll() {
+	eeASSERT( !isWorkerThread() );
+
+	mIdleCond.waitAndLock( 1, Condition::AutoUnlock );
+}
+
+Uint32 JobSystem::getPendingCount() {
+	Lock l( mJobsMutex );
+
+	return mJobs.size();
+}
+
+Uint32 JobSystem::getWorkerCount() const {
+	return mWorkers.size();
+}
+
+bool JobSystem::isWorkerThread() const {
+	return NULL != (Worker*)mCurrentWorker;
+}
+
+}}
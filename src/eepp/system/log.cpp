@@ -1,5 +1,9 @@
 #include <eepp/system/log.hpp>
+#include <eepp/system/thread.hpp>
+#include <eepp/system/condition.hpp>
+#include <eepp/system/lock.hpp>
 #include <cstdarg>
+#include <atomic>
 
 #if EE_PLATFORM == EE_PLATFORM_ANDROID
 	#include <android/log.h>
@@ -17,13 +21,245 @@
 
 namespace EE { namespace System {
 
+namespace Private {
+
+/** @brief Bounded multiple producers single consumer queue of texts.
+**	Every cell has a sequence number that tells if the cell is free to be written by the producer that claimed the position
+**	( sequence == position ) or if it's ready to be read by the consumer ( sequence == position + 1 ). Producers claim the positions
+**	with a compare and swap, so writing never takes a lock. The consumer only sleeps when the queue is empty, and the producers only
+**	signal it when it's sleeping. The producers waiting for a free cell or for a flush sleep on conditions that the consumer signals
+**	after processing a batch. */
+class LogRingBuffer {
+	public:
+		LogRingBuffer( const Uint32& size ) :
+			mCells( NULL ),
+			mMask( 0 ),
+			mWakeCond( 0 ),
+			mSpaceCond( 0 ),
+			mFlushCond( 0 ),
+			ConsumerThreadId( 0 ),
+			mEnqueuePos( 0 ),
+			mDequeuePos( 0 ),
+			mBlockedWriters( 0 ),
+			mSleeping( false ),
+			mRunning( true ),
+			mFlushRequested( false )
+		{
+			size_t capacity = 2;
+
+			while ( capacity < size )
+				capacity *= 2;
+
+			mCells	= eeNewArray( Cell, capacity );
+			mMask	= capacity - 1;
+
+			for ( size_t i = 0; i < capacity; i++ )
+				mCells[i].Sequence.store( i, std::memory_order_relaxed );
+		}
+
+		~LogRingBuffer() {
+			eeSAFE_DELETE_ARRAY( mCells );
+		}
+
+		/** Moves the text into the queue. @return False if the queue is full ( and the text is untouched ) */
+		bool push( std::string& text ) {
+			size_t pos = mEnqueuePos.load( std::memory_order_relaxed );
+			Cell * cell;
+
+			while ( true ) {
+				cell = &mCells[ pos & mMask ];
+
+				size_t seq = cell->Sequence.load( std::memory_order_acquire );
+				intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+				if ( 0 == diff ) {
+					if ( mEnqueuePos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+						break;
+				} else if ( diff < 0 ) {
+					return false;
+				} else {
+					pos = mEnqueuePos.load( std::memory_order_relaxed );
+				}
+			}
+
+			cell->Text.swap( text );
+			cell->Sequence.store( pos + 1 );
+
+			return true;
+		}
+
+		/** Moves the text into the queue, waiting until the consumer frees a cell while the queue is full.
+		**	@return False if the consumer stopped before the text could be pushed ( and the text is untouched ) */
+		bool pushWait( std::string& text ) {
+			bool pushed = false;
+
+			mBlockedWriters.fetch_add( 1 );
+
+			while ( true ) {
+				// The push is retried under the condition lock, so the consumer can't free the cells and signal between a failed push
+				// and the wait. A failed push means that the queue is full, so the consumer will signal again after its next batch.
+				mSpaceCond.lock();
+
+				if ( !mRunning.load() ) {
+					mSpaceCond.unlock();
+					break;
+				}
+
+				if ( push( text ) ) {
+					mSpaceCond.unlock();
+					pushed = true;
+					break;
+				}
+
+				mSpaceCond.unlock( 0 );
+
+				wake();
+
+				mSpaceCond.waitAndLock( 1, Condition::AutoUnlock );
+			}
+
+			mBlockedWriters.fetch_sub( 1 );
+
+			return pushed;
+		}
+
+		/** Moves the oldest text of the queue to text. Only the consumer can call it. @return False if the queue is empty */
+		bool pop( std::string& text ) {
+			Cell * cell = &mCells[ mDequeuePos & mMask ];
+
+			if ( cell->Sequence.load() != mDequeuePos + 1 )
+				return false;
+
+			text.swap( cell->Text );
+			cell->Text.clear();
+			cell->Sequence.store( mDequeuePos + mMask + 1, std::memory_order_release );
+			mDequeuePos++;
+
+			return true;
+		}
+
+		bool empty() const {
+			return mCells[ mDequeuePos & mMask ].Sequence.load() != mDequeuePos + 1;
+		}
+
+		/** Called by the consumer after processing a batch of texts: wakes up the writers waiting for a free cell. */
+		void signalSpace() {
+			if ( mBlockedWriters.load() > 0 )
+				mSpaceCond = 1;
+		}
+
+		/** Called by the consumer when it found the queue empty: wakes up the writers waiting for a flush. */
+		void signalFlushed() {
+			if ( !mFlushRequested.load() )
+				return;
+
+			// Checked under the lock, a text pushed before a new flush request must be processed before signaling it
+			mFlushCond.lock();
+
+			if ( empty() ) {
+				mFlushRequested.store( false );
+				mFlushCond.unlock( 1 );
+			} else {
+				mFlushCond.unlock();
+			}
+		}
+
+		/** Blocks the calling producer until the consumer processed every text in the queue. */
+		void flush() {
+			mFlushCond.lock();
+
+			if ( !mRunning.load() ) {
+				mFlushCond.unlock();
+				return;
+			}
+
+			mFlushRequested.store( true );
+			mFlushCond.unlock( 0 );
+
+			wake();
+
+			mFlushCond.waitAndLock( 1, Condition::AutoUnlock );
+		}
+
+		/** Blocks the consumer until a producer wakes it up. */
+		void sleep() {
+			mWakeCond = 0;
+			mSleeping.store( true );
+
+			// A text pushed or a flush requested before the flag was set wouldn't wake the consumer
+			if ( !empty() || !mRunning.load() || mFlushRequested.load() ) {
+				mSleeping.store( false );
+				return;
+			}
+
+			mWakeCond.waitAndLock( 1, Condition::AutoUnlock );
+		}
+
+		void wake() {
+			if ( mSleeping.exchange( false ) )
+				mWakeCond = 1;
+		}
+
+		/** Stops the consumer, and releases the producers waiting for a free cell. */
+		void stop() {
+			mSpaceCond.lock();
+			mRunning.store( false );
+			mSpaceCond.unlock( 1 );
+
+			mSleeping.store( false );
+			mWakeCond = 1;
+		}
+
+		/** Called by the consumer when it processed the last texts after being stopped: releases the producers waiting for a flush. */
+		void finish() {
+			mFlushCond.lock();
+			mFlushRequested.store( false );
+			mFlushCond.unlock( 1 );
+		}
+
+		bool isRunning() const {
+			return mRunning.load();
+		}
+	protected:
+		struct Cell {
+			std::atomic<size_t>	Sequence;
+			std::string			Text;
+		};
+
+		Cell *					mCells;
+		size_t					mMask;
+		Condition				mWakeCond;
+		Condition				mSpaceCond;
+		Condition				mFlushCond;
+	public:
+		std::atomic<Uint32>		ConsumerThreadId;
+	protected:
+		std::atomic<size_t>		mEnqueuePos;
+		size_t					mDequeuePos;
+		std::atomic<Uint32>		mBlockedWriters;
+		std::atomic<bool>		mSleeping;
+		std::atomic<bool>		mRunning;
+		std::atomic<bool>		mFlushRequested;
+};
+
+}
+
 SINGLETON_DECLARE_IMPLEMENTATION(Log)
 
 Log::Log() :
+	mHistoryBytes( 0 ),
+	mHistorySize( 4 * 1024 * 1024 ),
 	mSave( false ),
 	mConsoleOutput( false ),
 	mLiveWrite( false ),
-	mFS( NULL )
+	mFS( NULL ),
+	mRing( NULL ),
+	mWriteRing( NULL ),
+	mRingUsers( 0 ),
+	mRingUsersCond( 0 ),
+	mThread( NULL ),
+	mOverflowPolicy( OverflowBlock ),
+	mDropped( 0 )
 {
 	write("...::: Entropia Engine++ Loaded :::...");
 	write( "Loaded on " + Sys::getDateTimeStr() + "\n" );
@@ -33,10 +269,13 @@ Log::~Log() {
 	write( "\nUnloaded on " + Sys::getDateTimeStr() );
 	write( "...::: Entropia Engine++ Unloaded :::...\n" );
 
+	setAsync( false );
+
 	if ( mSave && !mLiveWrite ) {
 		openFS();
 
-		mFS->write( mData.c_str(), mData.size() );
+		for ( std::deque<std::string>::iterator it = mHistory.begin(); it != mHistory.end(); it++ )
+			mFS->write( it->c_str(), it->size() );
 	}
 
 	closeFS();
@@ -57,27 +296,152 @@ void Log::write( std::string Text, const bool& newLine ) {
 		Text += '\n';
 	}
 
-	mData += Text;
+	push( Text );
+}
+
+Private::LogRingBuffer * Log::acquireRing() {
+	if ( NULL == mWriteRing.load() )
+		return NULL;
+
+	// Counted before loading the ring again, so setAsync can't delete a ring that is still in use
+	mRingUsers.fetch_add( 1 );
+
+	Private::LogRingBuffer * ring = mWriteRing.load();
 
-	writeToReaders( Text );
+	if ( NULL == ring )
+		releaseRing();
+
+	return ring;
+}
+
+void Log::releaseRing() {
+	if ( 1 == mRingUsers.fetch_sub( 1 ) && NULL == mWriteRing.load() )
+		mRingUsersCond = 1;
+}
+
+void Log::push( std::string& text ) {
+	Private::LogRingBuffer * ring = acquireRing();
+
+	if ( NULL == ring ) {
+		process( text );
+		return;
+	}
+
+	// The readers may write to the log from the log thread, waiting for a free slot there would never end
+	if ( Thread::getCurrentThreadId() == ring->ConsumerThreadId ) {
+		process( text );
+	} else if ( ring->push( text ) ) {
+		ring->wake();
+	} else if ( OverflowDrop == mOverflowPolicy ) {
+		mDropped.fetch_add( 1, std::memory_order_relaxed );
+	} else if ( ring->pushWait( text ) ) {
+		ring->wake();
+	} else {
+		// The log thread stopped while waiting
+		process( text );
+	}
+
+	releaseRing();
+}
+
+void Log::process( std::string& text ) {
+	Lock l( *this );
+
+	addToHistory( text );
+
+	writeToReaders( text );
 
 	if ( mConsoleOutput ) {
-	#if EE_PLATFORM == EE_PLATFORM_ANDROID
-		__android_log_print( ANDROID_LOG_INFO, "eepp", "%s", Text.c_str() );
-	#elif defined( EE_COMPILER_MSVC )
-		OutputDebugString( Text.c_str() );
-	#else
-		std::cout << Text;
-	#endif
+		writeToConsole( text );
 	}
-	
+
 	if ( mLiveWrite ) {
 		openFS();
 
-		mFS->write( Text.c_str(), Text.size() );
+		mFS->write( text.c_str(), text.size() );
 
+		// The log thread flushes once per batch
+		if ( NULL == mWriteRing.load() ) {
+			mFS->flush();
+		}
+	}
+}
+
+void Log::writeToConsole( const std::string& text ) {
+#if EE_PLATFORM == EE_PLATFORM_ANDROID
+	__android_log_print( ANDROID_LOG_INFO, "eepp", "%s", text.c_str() );
+#elif defined( EE_COMPILER_MSVC )
+	OutputDebugString( text.c_str() );
+#else
+	std::cout << text;
+#endif
+}
+
+void Log::addToHistory( const std::string& text ) {
+	mHistory.push_back( text );
+	mHistoryBytes += text.size();
+
+	trimHistory();
+}
+
+void Log::trimHistory() {
+	if ( 0 == mHistorySize ) {
+		return;
+	}
+
+	while ( mHistoryBytes > mHistorySize && mHistory.size() > 1 ) {
+		std::string& front = mHistory.front();
+
+		// Keep the discarded lines in the log file when it will be saved
+		if ( mSave && !mLiveWrite ) {
+			openFS();
+
+			mFS->write( front.c_str(), front.size() );
+		}
+
+		mHistoryBytes -= front.size();
+		mHistory.pop_front();
+	}
+}
+
+Uint32 Log::processPending() {
+	Lock l( *this );
+
+	Uint32 count = 0;
+	std::string text;
+
+	while ( mRing->pop( text ) ) {
+		process( text );
+		count++;
+	}
+
+	if ( count > 0 && mLiveWrite && NULL != mFS ) {
 		mFS->flush();
 	}
+
+	return count;
+}
+
+void Log::logThread() {
+	mRing->ConsumerThreadId = Thread::getCurrentThreadId();
+
+	while ( true ) {
+		if ( processPending() > 0 ) {
+			mRing->signalSpace();
+			continue;
+		}
+
+		mRing->signalFlushed();
+
+		if ( !mRing->isRunning() )
+			break;
+
+		mRing->sleep();
+	}
+
+	processPending();
+
+	mRing->finish();
 }
 
 void Log::openFS() {
@@ -115,27 +479,7 @@ void Log::writef( const char* format, ... ) {
 			tstr.resize( n );
 			tstr += '\n';
 
-			mData += tstr;
-
-			writeToReaders( tstr );
-
-			if ( mConsoleOutput ) {
-			#if EE_PLATFORM == EE_PLATFORM_ANDROID
-				__android_log_print( ANDROID_LOG_INFO, "eepp", "%s", tstr.c_str() );
-			#elif defined( EE_COMPILER_MSVC )
-				OutputDebugString( tstr.c_str() );
-			#else
-				std::cout << tstr;
-			#endif
-			}
-
-			if ( mLiveWrite ) {
-				openFS();
-
-				mFS->write( tstr.c_str(), tstr.size() );
-
-				mFS->flush();
-			}
+			push( tstr );
 
 			va_end( args );
 
@@ -152,7 +496,96 @@ void Log::writef( const char* format, ... ) {
 }
 
 std::string Log::getBuffer() const {
-	return mData;
+	Lock l( const_cast<Log&>( *this ) );
+
+	std::string buffer;
+
+	buffer.reserve( mHistoryBytes );
+
+	for ( std::deque<std::string>::const_iterator it = mHistory.begin(); it != mHistory.end(); it++ )
+		buffer += *it;
+
+	return buffer;
+}
+
+void Log::setHistorySize( const Uint32& size ) {
+	Lock l( *this );
+
+	mHistorySize = size;
+
+	trimHistory();
+}
+
+const Uint32& Log::getHistorySize() const {
+	return mHistorySize;
+}
+
+void Log::setAsync( const bool& async, const Uint32& bufferSize ) {
+	if ( async == isAsync() )
+		return;
+
+	if ( async ) {
+		mRing	= eeNew( Private::LogRingBuffer, ( bufferSize ) );
+		mThread	= eeNew( Thread, ( &Log::logThread, this ) );
+		mThread->launch();
+
+		mWriteRing.store( mRing );
+	} else {
+		// The new writes are processed in the calling thread, and the writes that already took the ring finish before stopping the
+		// log thread ( the ones waiting for a free slot are released when the log thread processes the next batch )
+		mRingUsersCond = 0;
+		mWriteRing.store( NULL );
+
+		if ( mRingUsers.load() > 0 )
+			mRingUsersCond.waitAndLock( 1, Condition::AutoUnlock );
+
+		mRing->stop();
+		mThread->wait();
+
+		eeSAFE_DELETE( mThread );
+		eeSAFE_DELETE( mRing );
+
+		Lock l( *this );
+
+		if ( NULL != mFS ) {
+			mFS->flush();
+		}
+	}
+}
+
+bool Log::isAsync() const {
+	return NULL != mWriteRing.load();
+}
+
+void Log::setOverflowPolicy( const OverflowPolicy& policy ) {
+	mOverflowPolicy = policy;
+}
+
+const Log::OverflowPolicy& Log::getOverflowPolicy() const {
+	return mOverflowPolicy;
+}
+
+Uint64 Log::getDroppedCount() const {
+	return mDropped.load( std::memory_order_relaxed );
+}
+
+void Log::flush() {
+	Private::LogRingBuffer * ring = acquireRing();
+
+	if ( NULL != ring ) {
+		// A reader flushing from the log thread would wait for itself
+		if ( Thread::getCurrentThreadId() != ring->ConsumerThreadId )
+			ring->flush();
+
+		releaseRing();
+	}
+
+	// The log thread holds the lock while it processes a batch
+	Lock l( *this );
+
+	if ( NULL != mFS ) {
+		mFS->flush();
+	}
 }
 
 const bool& Log::isConsoleOutput() const {
@@ -160,16 +593,16 @@ const bool& Log::isConsoleOutput() const {
 }
 
 void Log::setConsoleOutput( const bool& output ) {
+	Lock l( *this );
+
 	bool OldOutput = mConsoleOutput;
 
 	mConsoleOutput = output;
 
 	if ( !OldOutput && output ) {
-		std::string data( mData );
-		mData = "";
-		write( data, false );
+		for ( std::deque<std::string>::iterator it = mHistory.begin(); it != mHistory.end(); it++ )
+			writeToConsole( *it );
 	}
-
 }
 
 const bool& Log::isLiveWrite() const {
@@ -181,10 +614,14 @@ void Log::setLiveWrite( const bool& lw ) {
 }
 
 void Log::addLogReader( LogReaderInterface * reader ) {
+	Lock l( *this );
+
 	mReaders.push_back( reader );
 }
 
 void Log::removeLogReader( LogReaderInterface * reader ) {
+	Lock l( *this );
+
 	mReaders.remove( reader );
 }
 
@@ -0,0 +1,127 @@
+#include <eepp/system/mappedfile.hpp>
+
+#if EE_PLATFORM == EE_PLATFORM_WIN
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#elif defined( EE_PLATFORM_POSIX )
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace EE { namespace System {
+
+MappedFile::MappedFile() :
+	mData( NULL ),
+	mSize( 0 ),
+	mFileHandle( NULL ),
+	mMapHandle( NULL )
+{
+}
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+bool MappedFile::open( const std::string& path ) {
+	close();
+
+#if EE_PLATFORM == EE_PLATFORM_WIN
+	HANDLE file = CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+
+	if ( INVALID_HANDLE_VALUE == file )
+		return false;
+
+	LARGE_INTEGER size;
+
+	if ( !GetFileSizeEx( file, &size ) || 0 == size.QuadPart ) {
+		CloseHandle( file );
+		return false;
+	}
+
+	HANDLE map = CreateFileMappingA( file, NULL, PAGE_WRITECOPY, 0, 0, NULL );
+
+	if ( NULL == map ) {
+		CloseHandle( file );
+		return false;
+	}
+
+	void * data = MapViewOfFile( map, FILE_MAP_COPY, 0, 0, 0 );
+
+	if ( NULL == data ) {
+		CloseHandle( map );
+		CloseHandle( file );
+		return false;
+	}
+
+	mFileHandle	= file;
+	mMapHandle	= map;
+	mData		= reinterpret_cast<Uint8*>( data );
+	mSize		= (Uint64)size.QuadPart;
+
+	return true;
+#elif defined( EE_PLATFORM_POSIX )
+	int fd = ::open( path.c_str(), O_RDONLY );
+
+	if ( -1 == fd )
+		return false;
+
+	struct stat st;
+
+	if ( 0 != fstat( fd, &st ) || 0 == st.st_size ) {
+		::close( fd );
+		return false;
+	}
+
+	void * data = mmap( NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+
+	// The mapping keeps its own reference to the file
+	::close( fd );
+
+	if ( MAP_FAILED == data )
+		return false;
+
+	mData	= reinterpret_cast<Uint8*>( data );
+	mSize	= (Uint64)st.st_size;
+
+	return true;
+#else
+	#warning MappedFile not implemented in this platform.
+	return false;
+#endif
+}
+
+void MappedFile::close() {
+	if ( NULL == mData )
+		return;
+
+#if EE_PLATFORM == EE_PLATFORM_WIN
+	UnmapViewOfFile( mData );
+	CloseHandle( (HANDLE)mMapHandle );
+	CloseHandle( (HANDLE)mFileHandle );
+#elif defined( EE_PLATFORM_POSIX )
+	munmap( mData, mSize );
+#endif
+
+	mData		= NULL;
+	mSize		= 0;
+	mFileHandle	= NULL;
+	mMapHandle	= NULL;
+}
+
+bool MappedFile::isOpen() const {
+	return NULL != mData;
+}
+
+Uint8 * MappedFile::getData() const {
+	return mData;
+}
+
+const Uint64& MappedFile::getSize() const {
+	return mSize;
+}
+
+}}
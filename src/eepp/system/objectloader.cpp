@@ -6,12 +6,14 @@ ObjectLoader::ObjectLoader( Uint32 ObjType ):
 	mObjType(ObjType),
 	mLoaded(false),
 	mLoading(false),
-	mThreaded(false)
+	mThreaded(false),
+	mJob(JobSystem::InvalidHandle)
 {
 }
 
 ObjectLoader::~ObjectLoader()
 {
+	waitJob();
 }
 
 void ObjectLoader::load() {
@@ -32,7 +34,12 @@ void ObjectLoader::load( ObjLoadCallback Cb ) {
 
 void ObjectLoader::launch() {
 	if ( mThreaded ) {
-		Thread::launch();
+		waitJob();
+
+		//! The loader is loading since it's queued, so the resource loader counts it and doesn't launch it again
+		mLoading = true;
+
+		mJob = JobSystem::instance()->run( cb::Make0( this, &ObjectLoader::run ) );
 	 } else {
 		run();
 	}
@@ -62,6 +69,14 @@ void ObjectLoader::setThreaded( const bool& threaded ) {
 	mThreaded = threaded;
 }
 
+void ObjectLoader::waitJob() {
+	if ( JobSystem::InvalidHandle != mJob ) {
+		JobSystem::instance()->wait( mJob );
+
+		mJob = JobSystem::InvalidHandle;
+	}
+}
+
 void ObjectLoader::run() {
 	start();
 }
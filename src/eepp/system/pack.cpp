@@ -5,17 +5,44 @@ namespace EE { namespace System {
 
 Pack::Pack() :
 	Mutex(),
-	mIsOpen(false)
+	mIsOpen(false),
+	mReadOnly(false)
 {
 	PackManager::instance()->add( this );
 }
 
 Pack::~Pack() {
 	PackManager::instance()->remove( this );
+
+	// The pack wasn't closed, its files are still indexed
+	if ( mIsOpen )
+		PackManager::instance()->rebuildIndex();
 }
 
 bool Pack::isOpen() const {
 	return mIsOpen;
 }
 
+bool Pack::isReadOnly() const {
+	return mReadOnly;
+}
+
+bool Pack::openReadOnly( const std::string& path ) {
+	return open( path );
+}
+
+void Pack::updateIndex() {
+	PackManager::instance()->rebuildIndex();
+}
+
+void Pack::indexFile( const std::string& path ) {
+	PackManager::instance()->indexFile( this, path );
+}
+
+bool Pack::getFileView( const std::string& path, SafeDataPointer& data ) {
+	data.clear();
+
+	return extractFileToMemory( path, data );
+}
+
 }}
@@ -1,13 +1,14 @@
 #include <eepp/system/packmanager.hpp>
-#include <eepp/system/filesystem.hpp>
 #include <eepp/system/log.hpp>
+#include <eepp/system/sys.hpp>
 
 namespace EE { namespace System {
 
 SINGLETON_DECLARE_IMPLEMENTATION(PackManager)
 
 PackManager::PackManager() :
-	mFallback( true )
+	mFallback( true ),
+	mProcessPath( Sys::getProcessPath() )
 {
 }
 
@@ -15,25 +16,59 @@ PackManager::~PackManager() {
 }
 
 Pack * PackManager::exists( std::string& path ) {
-	std::string tpath( path );
+	// The process path is skipped to hash the path, and it's only removed from the path when the file is found
+	size_t start = 0;
 
-	FileSystem::filePathRemoveProcessPath( tpath );
+	if ( mProcessPath.size() < path.size() && 0 == path.compare( 0, mProcessPath.size(), mProcessPath ) )
+		start = mProcessPath.size();
 
+	Pack ** pack = mFilesIndex.find( String::hash( path.c_str() + start ) );
+
+	if ( NULL == pack )
+		return NULL;
+
+	if ( 0 != start )
+		path.erase( 0, start );
+
+	if ( -1 != (*pack)->exists( path ) )
+		return *pack;
+
+	// Two paths share the hash, fallback to search in every pack
 	std::list<Pack*>::iterator it;
 
 	for ( it = mResources.begin(); it != mResources.end(); it++ ) {
-		if ( -1 != (*it)->exists( tpath ) ) {
-			if ( path.size() != tpath.size() ) {
-				path = tpath;
-			}
-
+		if ( (*it)->isOpen() && -1 != (*it)->exists( path ) )
 			return (*it);
-		}
 	}
 
+	if ( 0 != start )
+		path.insert( 0, mProcessPath );
+
 	return NULL;
 }
 
+void PackManager::rebuildIndex() {
+	mFilesIndex.clear();
+
+	std::list<Pack*>::iterator it;
+
+	for ( it = mResources.begin(); it != mResources.end(); it++ ) {
+		if ( (*it)->isOpen() ) {
+			std::vector<std::string> files = (*it)->getFileList();
+
+			for ( size_t i = 0; i < files.size(); i++ )
+				indexFile( (*it), files[i] );
+		}
+	}
+}
+
+void PackManager::indexFile( Pack * pack, const std::string& path ) {
+	Uint32 hash = String::hash( path );
+
+	if ( NULL == mFilesIndex.find( hash ) )
+		mFilesIndex.insert( hash, pack );
+}
+
 Pack * PackManager::getPackByPath( std::string path ) {
 	std::list<Pack*>::iterator it;
 
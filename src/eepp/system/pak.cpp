@@ -67,22 +67,100 @@ bool Pak::open( const std::string& path ) {
 				mPakFiles.push_back( Entry );
 			}
 
+			buildIndex();
+
 			mIsOpen = true;
 
+			updateIndex();
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool Pak::openReadOnly( const std::string& path ) {
+	close();
+
+	if ( !mMappedFile.open( path ) )
+		return false;
+
+	const Uint8 * data = mMappedFile.getData();
+	Uint64 size = mMappedFile.getSize();
+
+	if ( size >= sizeof(pakHeader) ) {
+		memcpy( &mPak.header, data, sizeof(pakHeader) );
+
+		if ( mPak.header.head[0] == 'P' && mPak.header.head[1] == 'A' && mPak.header.head[2] == 'C' && mPak.header.head[3] == 'K' &&
+			 mPak.header.dir_offset >= sizeof(mPak.header.head) + 1 && (Uint64)mPak.header.dir_offset + mPak.header.dir_length <= size )
+		{
+			mPak.pakPath		= path;
+			mPak.pakFilesNum	= mPak.header.dir_length / sizeof(pakEntry);
+
+			mPakFiles.resize( mPak.pakFilesNum );
+
+			if ( mPak.pakFilesNum )
+				memcpy( &mPakFiles[0], data + mPak.header.dir_offset, mPak.pakFilesNum * sizeof(pakEntry) );
+
+			// Discard the entries pointing outside the file
+			for ( Uint32 i = 0; i < mPakFiles.size(); i++ ) {
+				if ( (Uint64)mPakFiles[i].file_position + mPakFiles[i].file_length > size ) {
+					mPakFiles[i].filename[0] = '\0';
+					mPakFiles[i].file_length = 0;
+				}
+			}
+
+			buildIndex();
+
+			mReadOnly	= true;
+			mIsOpen		= true;
+
+			updateIndex();
+
 			return true;
 		}
 	}
 
+	mMappedFile.close();
+
 	return false;
 }
 
+std::string Pak::getEntryName( const Uint32& pos ) const {
+	// The file name isn't null terminated when it uses the 56 characters
+	return std::string( mPakFiles[pos].filename, strnlen( mPakFiles[pos].filename, sizeof(mPakFiles[pos].filename) ) );
+}
+
+void Pak::indexEntry( const Uint32& pos ) {
+	Uint32 hash = String::hash( getEntryName( pos ) );
+
+	// In case of duplicated names the first entry wins, as the linear search did
+	if ( NULL == mPakIndex.find( hash ) )
+		mPakIndex.insert( hash, pos );
+}
+
+void Pak::buildIndex() {
+	mPakIndex.clear();
+	mPakIndex.reserve( mPakFiles.size() );
+
+	for ( Uint32 i = 0; i < mPakFiles.size(); i++ )
+		indexEntry( i );
+}
+
 bool Pak::close() {
 	if ( mIsOpen ) {
 		eeSAFE_DELETE( mPak.fs );
 
+		mMappedFile.close();
+
 		mPakFiles.clear();
+		mPakIndex.clear();
 
 		mIsOpen = false;
+		mReadOnly = false;
+
+		updateIndex();
 
 		return true;
 	}
@@ -104,8 +182,17 @@ Int8 Pak::checkPack() {
 
 Int32 Pak::exists( const std::string& path ) {
 	if ( isOpen() ) {
+		Uint32 * pos = mPakIndex.find( String::hash( path ) );
+
+		if ( NULL == pos )
+			return -1;
+
+		if ( strncmp( path.c_str(), mPakFiles[ *pos ].filename, sizeof(mPakFiles[ *pos ].filename) ) == 0 )
+			return *pos;
+
+		// Two names share the hash, fallback to the linear search
 		for ( Uint32 i = 0; i < mPakFiles.size(); i++ )
-			if ( strcmp( path.c_str(), mPakFiles[i].filename ) == 0 )
+			if ( strncmp( path.c_str(), mPakFiles[i].filename, sizeof(mPakFiles[i].filename) ) == 0 )
 				return i;
 	}
 
@@ -113,7 +200,7 @@ Int32 Pak::exists( const std::string& path ) {
 }
 
 bool Pak::extractFile( const std::string& path , const std::string& dest ) {
-	if ( NULL == mPak.fs || !mPak.fs->isOpen() ) {
+	if ( !mReadOnly && ( NULL == mPak.fs || !mPak.fs->isOpen() ) ) {
 		return false;
 	}
 
@@ -139,6 +226,19 @@ bool Pak::extractFile( const std::string& path , const std::string& dest ) {
 }
 
 bool Pak::extractFileToMemory( const std::string& path, std::vector<Uint8>& data ) {
+	if ( mReadOnly ) {
+		Int32 Pos = exists( path );
+
+		if ( Pos == -1 )
+			return false;
+
+		const Uint8 * fileData = mMappedFile.getData() + mPakFiles[Pos].file_position;
+
+		data.assign( fileData, fileData + mPakFiles[Pos].file_length );
+
+		return true;
+	}
+
 	if ( NULL == mPak.fs || !mPak.fs->isOpen() ) {
 		return false;
 	}
@@ -153,8 +253,10 @@ bool Pak::extractFileToMemory( const std::string& path, std::vector<Uint8>& data
 		data.clear();
 		data.resize( mPakFiles[Pos].file_length );
 
-		mPak.fs->seek( mPakFiles[Pos].file_position );
-		mPak.fs->read( reinterpret_cast<char*> (&data[0]), mPakFiles[Pos].file_length );
+		if ( !data.empty() ) {
+			mPak.fs->seek( mPakFiles[Pos].file_position );
+			mPak.fs->read( reinterpret_cast<char*> (&data[0]), mPakFiles[Pos].file_length );
+		}
 
 		Ret = true;
 	}
@@ -165,6 +267,24 @@ bool Pak::extractFileToMemory( const std::string& path, std::vector<Uint8>& data
 }
 
 bool Pak::extractFileToMemory( const std::string& path, SafeDataPointer& data ) {
+	if ( mReadOnly ) {
+		Int32 Pos = exists( path );
+
+		if ( Pos == -1 )
+			return false;
+
+		data.clear();
+		data.DataSize	= mPakFiles[Pos].file_length;
+
+		if ( data.DataSize ) {
+			data.Data = eeNewArray( Uint8, ( data.DataSize ) );
+
+			memcpy( data.Data, mMappedFile.getData() + mPakFiles[Pos].file_position, data.DataSize );
+		}
+
+		return true;
+	}
+
 	if ( NULL == mPak.fs || !mPak.fs->isOpen() ) {
 		return false;
 	}
@@ -176,11 +296,15 @@ bool Pak::extractFileToMemory( const std::string& path, SafeDataPointer& data )
 	Int32 Pos = exists( path );
 
 	if ( Pos != -1 ) {
+		data.clear();
 		data.DataSize	= mPakFiles[Pos].file_length;
-		data.Data		= eeNewArray( Uint8, ( data.DataSize ) );
 
-		mPak.fs->seek( mPakFiles[Pos].file_position );
-		mPak.fs->read( reinterpret_cast<char*> ( data.Data ), mPakFiles[Pos].file_length );
+		if ( data.DataSize ) {
+			data.Data = eeNewArray( Uint8, ( data.DataSize ) );
+
+			mPak.fs->seek( mPakFiles[Pos].file_position );
+			mPak.fs->read( reinterpret_cast<char*> ( data.Data ), mPakFiles[Pos].file_length );
+		}
 
 		Ret = true;
 	}
@@ -190,8 +314,28 @@ bool Pak::extractFileToMemory( const std::string& path, SafeDataPointer& data )
 	return Ret;
 }
 
+bool Pak::getFileView( const std::string& path, SafeDataPointer& data ) {
+	if ( !mReadOnly )
+		return Pack::getFileView( path, data );
+
+	Int32 Pos = exists( path );
+
+	if ( Pos == -1 )
+		return false;
+
+	data.clear();
+	data.DataSize = mPakFiles[Pos].file_length;
+
+	if ( data.DataSize ) {
+		data.Data = mMappedFile.getData() + mPakFiles[Pos].file_position;
+		data.Owns = false;
+	}
+
+	return true;
+}
+
 bool Pak::addFile( const Uint8 * data, const Uint32& dataSize, const std::string& inpack ) {
-	if ( dataSize < 1 )
+	if ( dataSize < 1 || mReadOnly )
 		return false;
 
 	Uint32 fsize = dataSize;
@@ -216,6 +360,8 @@ bool Pak::addFile( const Uint8 * data, const Uint32& dataSize, const std::string
 			mPak.fs->write( reinterpret_cast<const char*> (&newFile), sizeof( pakEntry ) );
 
 			mPakFiles.push_back( newFile );
+			indexEntry( mPakFiles.size() - 1 );
+			indexFile( getEntryName( mPakFiles.size() - 1 ) );
 
 			return true;
 		} else {
@@ -251,6 +397,8 @@ bool Pak::addFile( const Uint8 * data, const Uint32& dataSize, const std::string
 			mPak.fs->write( reinterpret_cast<const char*>(&pakE[0]), (std::streamsize)( sizeof(pakEntry) * pakE.size() ) );
 
 			mPakFiles.push_back( pakE[ mPak.pakFilesNum ] );
+			indexEntry( mPakFiles.size() - 1 );
+			indexFile( getEntryName( mPakFiles.size() - 1 ) );
 			mPak.pakFilesNum += 1;
 
 			pakE.clear();
@@ -299,6 +447,9 @@ bool Pak::eraseFiles( const std::vector<std::string>& paths ) {
 	std::vector<pakEntry> uEntry;
 	bool Remove;
 
+	if ( mReadOnly )
+		return false;
+
 	for ( i = 0; i < paths.size(); i++ ) {
 		Ex = exists( paths[i] );
 		if ( Ex  == -1 )
@@ -361,7 +512,7 @@ std::vector<std::string> Pak::getFileList() {
 	tmpv.resize( mPakFiles.size() );
 
 	for ( Uint32 i = 0; i < mPakFiles.size(); i++ )
-		tmpv[i] = std::string ( mPakFiles[i].filename );
+		tmpv[i] = getEntryName( i );
 
 	return tmpv;
 }
@@ -18,6 +18,7 @@ ResourceLoader::~ResourceLoader() {
 
 void ResourceLoader::setThreads() {
 	if ( THREADS_AUTO == mThreads ) {
+		// The job system creates one worker per core
 		mThreads = Sys::getCPUCount();
 
 		if ( 1 == mThreads ) {
@@ -85,12 +86,11 @@ void ResourceLoader::load() {
 	bool AllLoaded = true;
 
 	ObjectLoader * Obj = NULL;
-	std::list<ObjectLoader *>::iterator it;
-	std::list<ObjectLoader *> ObjsErase;
+	std::list<ObjectLoader *>::iterator it = mObjs.begin();
 
 	Uint32 count = 0;
 
-	for ( it = mObjs.begin(); it != mObjs.end(); it++ ) {
+	while ( it != mObjs.end() ) {
 		Obj = (*it);
 
 		if ( NULL != Obj ) {
@@ -109,22 +109,25 @@ void ResourceLoader::load() {
 
 				if ( !Obj->isLoaded() ) {
 					AllLoaded = false;
+					it++;
 				} else {
-					ObjsErase.push_back( Obj );
+					mObjsLoaded.push_back( Obj );
+					it = mObjs.erase( it );
 				}
 
+				//! The loaders left are started in the next update
 				if ( mThreaded && mThreads == count ) {
-					AllLoaded = false;
+					if ( it != mObjs.end() )
+						AllLoaded = false;
+
 					break;
 				}
+
+				continue;
 			}
 		}
-	}
 
-	for ( it = ObjsErase.begin(); it != ObjsErase.end(); it++ ) {
-		Obj = (*it);
-		mObjs.remove( Obj );
-		mObjsLoaded.push_back( Obj );
+		it++;
 	}
 
 	if ( AllLoaded ) {
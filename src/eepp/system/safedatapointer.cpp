@@ -6,13 +6,15 @@ namespace EE { namespace System {
 
 SafeDataPointer::SafeDataPointer() :
 	Data( NULL ),
-	DataSize( 0 )
+	DataSize( 0 ),
+	Owns( true )
 {
 }
 
-SafeDataPointer::SafeDataPointer( Uint8 *data, Uint32 size ) :
+SafeDataPointer::SafeDataPointer( Uint8 *data, Uint32 size, bool owns ) :
 	Data( data ),
-	DataSize( size )
+	DataSize( size ),
+	Owns( owns )
 {
 }
 
@@ -21,7 +23,12 @@ SafeDataPointer::~SafeDataPointer() {
 }
 
 void SafeDataPointer::clear() {
-	eeSAFE_DELETE_ARRAY( Data );
+	if ( Owns ) {
+		eeSAFE_DELETE_ARRAY( Data );
+	} else {
+		Data = NULL;
+		Owns = true;
+	}
 }
 
 }}
@@ -132,7 +132,7 @@ void Translator::loadFromStream( IOStream& stream, std::string lang ) {
 void Translator::loadFromPack( Pack * pack, const std::string& FilePackPath, std::string lang ) {
 	SafeDataPointer PData;
 
-	if ( pack->isOpen() && pack->extractFileToMemory( FilePackPath, PData ) ) {
+	if ( pack->isOpen() && pack->getFileView( FilePackPath, PData ) ) {
 		lang = lang.size() == 2 ? lang : FileSystem::fileRemoveExtension( FileSystem::fileNameFromPath( FilePackPath ) );
 
 		loadFromMemory( PData.Data, PData.DataSize, lang );
@@ -2,6 +2,7 @@
 #include <eepp/helper/libzip/zip.h>
 #include <eepp/helper/libzip/zipint.h>
 #include <eepp/system/filesystem.hpp>
+#include <zlib.h>
 
 namespace EE { namespace System {
 
@@ -24,6 +25,8 @@ bool Zip::create( const std::string& path ) {
 
 			mIsOpen = true;
 
+			updateIndex();
+
 			return true;
 		}
 	} else {
@@ -43,6 +46,8 @@ bool Zip::open( const std::string& path ) {
 
 			mIsOpen = true;
 
+			updateIndex();
+
 			return true;
 		}
 	} else {
@@ -52,16 +57,152 @@ bool Zip::open( const std::string& path ) {
 	return false;
 }
 
+bool Zip::openReadOnly( const std::string& path ) {
+	if ( !FileSystem::fileExists( path ) || !open( path ) )
+		return false;
+
+	if ( mMappedFile.open( path ) ) {
+		if ( readCentralDirectory() ) {
+			mReadOnly = true;
+		} else {
+			mEntries.clear();
+			mEntriesIndex.clear();
+			mMappedFile.close();
+		}
+	}
+
+	return true;
+}
+
+static Uint16 zipReadUint16( const Uint8 * p ) {
+	return (Uint16)( p[0] | ( p[1] << 8 ) );
+}
+
+static Uint32 zipReadUint32( const Uint8 * p ) {
+	return (Uint32)p[0] | ( (Uint32)p[1] << 8 ) | ( (Uint32)p[2] << 16 ) | ( (Uint32)p[3] << 24 );
+}
+
+bool Zip::readCentralDirectory() {
+	const Uint8 * data = mMappedFile.getData();
+	Uint64 size = mMappedFile.getSize();
+
+	if ( size < 22 )
+		return false;
+
+	// Find the end of central directory record, it's followed by a comment of up to 64 KiB
+	Int64 eocd = -1;
+	Int64 minPos = size > 22 + 0xFFFF ? size - 22 - 0xFFFF : 0;
+
+	for ( Int64 i = size - 22; i >= minPos; i-- ) {
+		if ( zipReadUint32( data + i ) == 0x06054b50 ) {
+			eocd = i;
+			break;
+		}
+	}
+
+	if ( -1 == eocd )
+		return false;
+
+	Uint16 count		= zipReadUint16( data + eocd + 10 );
+	Uint32 cdirSize		= zipReadUint32( data + eocd + 12 );
+	Uint32 cdirOffset	= zipReadUint32( data + eocd + 16 );
+
+	// Zip64 files are left to libzip
+	if ( 0xFFFF == count || 0xFFFFFFFF == cdirOffset || 0xFFFFFFFF == cdirSize || (Uint64)cdirOffset + cdirSize > size )
+		return false;
+
+	mEntries.resize( count );
+	mEntriesIndex.reserve( count );
+
+	Uint64 pos = cdirOffset;
+
+	for ( Uint32 i = 0; i < count; i++ ) {
+		if ( pos + 46 > size || zipReadUint32( data + pos ) != 0x02014b50 )
+			return false;
+
+		const Uint8 * header = data + pos;
+		Uint16 nameLen		= zipReadUint16( header + 28 );
+		Uint16 extraLen		= zipReadUint16( header + 30 );
+		Uint16 commentLen	= zipReadUint16( header + 32 );
+		Uint32 localOffset	= zipReadUint32( header + 42 );
+
+		if ( pos + 46 + nameLen > size || (Uint64)localOffset + 30 > size || zipReadUint32( data + localOffset ) != 0x04034b50 )
+			return false;
+
+		ZipEntry& entry		= mEntries[i];
+		entry.Name			= std::string( (const char*)header + 46, nameLen );
+		entry.Method		= zipReadUint16( header + 10 );
+		entry.CompressedSize= zipReadUint32( header + 20 );
+		entry.Size			= zipReadUint32( header + 24 );
+
+		// The local header extra field can differ from the central directory one
+		const Uint8 * local	= data + localOffset;
+		Uint64 dataOffset	= (Uint64)localOffset + 30 + zipReadUint16( local + 26 ) + zipReadUint16( local + 28 );
+
+		if ( 0xFFFFFFFF == entry.CompressedSize || 0xFFFFFFFF == entry.Size || dataOffset + entry.CompressedSize > size )
+			return false;
+
+		entry.DataOffset	= (Uint32)dataOffset;
+
+		Uint32 hash = String::hash( entry.Name );
+
+		if ( NULL == mEntriesIndex.find( hash ) )
+			mEntriesIndex.insert( hash, i );
+
+		pos += 46 + nameLen + extraLen + commentLen;
+	}
+
+	return true;
+}
+
+bool Zip::inflateEntry( const ZipEntry& entry, Uint8 * dest ) {
+	const Uint8 * src = mMappedFile.getData() + entry.DataOffset;
+
+	if ( 0 == entry.Method ) {
+		if ( entry.Size != entry.CompressedSize )
+			return false;
+
+		memcpy( dest, src, entry.Size );
+
+		return true;
+	}
+
+	z_stream stream;
+	memset( &stream, 0, sizeof(z_stream) );
+
+	// Raw deflate stream, without the zlib header
+	if ( Z_OK != inflateInit2( &stream, -MAX_WBITS ) )
+		return false;
+
+	stream.next_in		= (Bytef*)src;
+	stream.avail_in		= entry.CompressedSize;
+	stream.next_out		= (Bytef*)dest;
+	stream.avail_out	= entry.Size;
+
+	int res = inflate( &stream, Z_FINISH );
+
+	inflateEnd( &stream );
+
+	return Z_STREAM_END == res && stream.total_out == entry.Size;
+}
+
 bool Zip::close() {
 	if ( 0 == checkPack() ) {
 		zip_close( mZip );
 
+		mMappedFile.close();
+		mEntries.clear();
+		mEntriesIndex.clear();
+
 		mIsOpen = false;
+		mReadOnly = false;
 
 		mZipPath = "";
 
 		mZip = NULL;
 
+		updateIndex();
+
 		return true;
 	}
 
@@ -77,7 +218,7 @@ bool Zip::addFile( const std::string& path, const std::string& inpack ) {
 }
 
 bool Zip::addFile( const Uint8 * data, const Uint32& dataSize, const std::string& inpack ) {
-	if ( 0 == checkPack() ) {
+	if ( 0 == checkPack() && !mReadOnly ) {
 		struct zip_source * zs = zip_source_buffer( mZip, (const void*)data, dataSize, 0 );
 
 		if ( NULL != zs ) {
@@ -118,6 +259,9 @@ bool Zip::eraseFiles( const std::vector<std::string>& paths ) {
 	Int32 Ex;
 	Uint32 i = 0;
 
+	if ( mReadOnly )
+		return false;
+
 	for ( i = 0; i < paths.size(); i++ ) {
 		Ex = exists( paths[i] );
 
@@ -150,6 +294,21 @@ bool Zip::extractFile( const std::string& path , const std::string& dest ) {
 }
 
 bool Zip::extractFileToMemory( const std::string& path, std::vector<Uint8>& data ) {
+	if ( mReadOnly ) {
+		Int32 Pos = exists( path );
+
+		if ( -1 == Pos )
+			return false;
+
+		const ZipEntry& entry = mEntries[ Pos ];
+
+		if ( 0 == entry.Method || Z_DEFLATED == entry.Method ) {
+			data.resize( entry.Size );
+
+			return 0 == entry.Size || inflateEntry( entry, &data[0] );
+		}
+	}
+
 	lock();
 
 	bool Ret = false;
@@ -162,7 +321,9 @@ bool Zip::extractFileToMemory( const std::string& path, std::vector<Uint8>& data
 		struct zip_stat zs;
 		int err = zip_stat( mZip, path.c_str(), 0, &zs );
 
-		if ( !err ) {
+		if ( !err && 0 == zs.size ) {
+			Ret = true;
+		} else if ( !err ) {
 			struct zip_file * zf = zip_fopen_index( mZip, zs.index, 0 );
 
 			if ( NULL != zf ) {
@@ -184,6 +345,33 @@ bool Zip::extractFileToMemory( const std::string& path, std::vector<Uint8>& data
 }
 
 bool Zip::extractFileToMemory( const std::string& path, SafeDataPointer& data ) {
+	if ( mReadOnly ) {
+		Int32 Pos = exists( path );
+
+		if ( -1 == Pos )
+			return false;
+
+		const ZipEntry& entry = mEntries[ Pos ];
+
+		if ( 0 == entry.Method || Z_DEFLATED == entry.Method ) {
+			data.clear();
+			data.DataSize = entry.Size;
+
+			if ( 0 == data.DataSize )
+				return true;
+
+			data.Data = eeNewArray( Uint8, ( data.DataSize ) );
+
+			if ( inflateEntry( entry, data.Data ) )
+				return true;
+
+			data.clear();
+			data.DataSize = 0;
+
+			return false;
+		}
+	}
+
 	lock();
 
 	bool Ret = false;
@@ -195,7 +383,12 @@ bool Zip::extractFileToMemory( const std::string& path, SafeDataPointer& data )
 		struct zip_stat zs;
 		int err = zip_stat( mZip, path.c_str(), 0, &zs );
 
-		if ( !err ) {
+		data.clear();
+		data.DataSize = 0;
+
+		if ( !err && 0 == zs.size ) {
+			Ret = true;
+		} else if ( !err ) {
 			struct zip_file * zf = zip_fopen_index( mZip, zs.index, 0 );
 
 			if ( NULL != zf ) {
@@ -217,7 +410,53 @@ bool Zip::extractFileToMemory( const std::string& path, SafeDataPointer& data )
 	return Ret;
 }
 
+bool Zip::getFileView( const std::string& path, SafeDataPointer& data ) {
+	if ( mReadOnly ) {
+		Int32 Pos = exists( path );
+
+		if ( -1 == Pos )
+			return false;
+
+		const ZipEntry& entry = mEntries[ Pos ];
+
+		if ( 0 == entry.Size ) {
+			data.clear();
+			data.DataSize = 0;
+
+			return true;
+		}
+
+		if ( 0 == entry.Method && entry.Size == entry.CompressedSize ) {
+			data.clear();
+			data.Data		= mMappedFile.getData() + entry.DataOffset;
+			data.DataSize	= entry.Size;
+			data.Owns		= false;
+
+			return true;
+		}
+	}
+
+	return Pack::getFileView( path, data );
+}
+
 Int32 Zip::exists( const std::string& path ) {
+	if ( mReadOnly ) {
+		Uint32 * pos = mEntriesIndex.find( String::hash( path ) );
+
+		if ( NULL == pos )
+			return -1;
+
+		if ( mEntries[ *pos ].Name == path )
+			return *pos;
+
+		// Two names share the hash, fallback to the linear search
+		for ( Uint32 i = 0; i < mEntries.size(); i++ )
+			if ( mEntries[i].Name == path )
+				return i;
+
+		return -1;
+	}
+
 	if ( isOpen() )
 		return zip_name_locate( mZip, path.c_str(), 0 );
 
@@ -628,7 +628,7 @@ UIWidget * UIManager::loadLayoutFromStream( IOStream& stream, UIControl * parent
 UIWidget * UIManager::loadLayoutFromPack( Pack * pack, const std::string& FilePackPath, UIControl * parent ) {
 	SafeDataPointer PData;
 
-	if ( pack->isOpen() && pack->extractFileToMemory( FilePackPath, PData ) ) {
+	if ( pack->isOpen() && pack->getFileView( FilePackPath, PData ) ) {
 		return loadLayoutFromMemory( PData.Data, PData.DataSize, parent );
 	}
 
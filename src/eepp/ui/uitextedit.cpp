@@ -346,17 +346,12 @@ void UITextEdit::fixScrollToCursor() {
 		Uint32 NLPos	= 0;
 		Uint32 LineNum = mTextInput->getInputTextBuffer()->getCurPosLinePos( NLPos );
 
-		Text textCache( mTextInput->getFont(), mTextInput->getFontStyleConfig().CharacterSize );
-		textCache.setString(
-			mTextInput->getInputTextBuffer()->getBuffer().substr(
-				NLPos, mTextInput->getInputTextBuffer()->getCursorPos() - NLPos
-			)
-		);
+		Text * textCache = mTextInput->getTextCache();
 
 		mSkipValueChange = true;
 
-		Float tW	= textCache.getTextWidth();
-		Float tH	= (Float)(LineNum + 1) * (Float)textCache.getFont()->getLineSpacing( textCache.getCharacterSizePx() );
+		Float tW	= textCache->findCharacterPos( mTextInput->getInputTextBuffer()->getCursorPos() ).x;
+		Float tH	= (Float)(LineNum + 1) * (Float)textCache->getFont()->getLineSpacing( textCache->getCharacterSizePx() );
 
 		if ( tW > Width ) {
 			mTextInput->setPixelsPosition( mContainerPadding.Left + Width - tW, mTextInput->getRealPosition().y );
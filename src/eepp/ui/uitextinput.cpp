@@ -161,11 +161,8 @@ void UITextInput::alignFix() {
 		Uint32 NLPos	= 0;
 		Uint32 LineNum	= mTextBuffer.getCurPosLinePos( NLPos );
 
-		Text textCache( mTextCache->getFont(), mTextCache->getCharacterSize() );
-
-		textCache.setString( mTextBuffer.getBuffer().substr( NLPos, mTextBuffer.getCursorPos() - NLPos ) );
-
-		Float tW	= textCache.getTextWidth();
+		// The text layout already knows the pen position of every character
+		Float tW	= mTextCache->findCharacterPos( mTextBuffer.getCursorPos() ).x;
 		Float tX	= mRealAlignOffset.x + tW;
 
 		mCurPos.x	= tW;
@@ -147,6 +147,10 @@ UITextView * UITextView::setFontStyle(const Uint32 & fontStyle) {
 	return this;
 }
 
+Text * UITextView::getTextCache() {
+	return mTextCache;
+}
+
 const String& UITextView::getText() {
 	if ( mFlags & UI_WORD_WRAP )
 		return mString;
@@ -278,7 +278,7 @@ bool WindowSDL::create( WindowSettings Settings, ContextSettings Context ) {
 
 	eePRINTL( "Opening application APK in: %s", apkPath.c_str() );
 
-	if ( mZip->open( apkPath ) )
+	if ( mZip->openReadOnly( apkPath ) )
 		eePRINTL( "APK opened succesfully!" );
 	else
 		eePRINTL( "Failed to open APK!" );
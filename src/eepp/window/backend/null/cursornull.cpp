@@ -7,7 +7,7 @@ CursorNull::CursorNull( Texture * tex, const Vector2i& hotspot, const std::strin
 {
 }
 
-CursorNull::CursorNull( getImage * img, const Vector2i& hotspot, const std::string& name, EE::Window::Window * window ) :
+CursorNull::CursorNull( Graphics::Image * img, const Vector2i& hotspot, const std::string& name, EE::Window::Window * window ) :
 	Cursor( img, hotspot, name, window )
 {
 }
@@ -13,7 +13,7 @@ class CursorNull : public Cursor {
 
 		CursorNull( Texture * tex, const Vector2i& hotspot, const std::string& getName, EE::Window::Window * window );
 
-		CursorNull( getImage * img, const Vector2i& hotspot, const std::string& getName, EE::Window::Window * window );
+		CursorNull( Graphics::Image * img, const Vector2i& hotspot, const std::string& getName, EE::Window::Window * window );
 
 		CursorNull( const std::string& path, const Vector2i& hotspot, const std::string& getName, EE::Window::Window * window );
 
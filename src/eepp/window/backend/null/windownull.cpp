@@ -2,6 +2,7 @@
 #include <eepp/window/backend/null/clipboardnull.hpp>
 #include <eepp/window/backend/null/inputnull.hpp>
 #include <eepp/window/backend/null/cursormanagernull.hpp>
+#include <eepp/graphics/renderer/renderernull.hpp>
 
 namespace EE { namespace Window { namespace Backend { namespace Null {
 
@@ -15,7 +16,32 @@ WindowNull::~WindowNull() {
 }
 
 bool WindowNull::create( WindowSettings Settings, ContextSettings Context ) {
-	return false;
+	/// There's no OpenGL context, everything is rendered by the null renderer
+	mWindow.ContextConfig.Version	= GLv_NULL;
+	mWindow.WindowSize				= Sizei( mWindow.WindowConfig.Width, mWindow.WindowConfig.Height );
+	mWindow.DesktopResolution		= mWindow.WindowSize;
+
+	if ( NULL == Renderer::existsSingleton() ) {
+		Renderer::createSingleton( mWindow.ContextConfig.Version );
+		Renderer::instance()->init();
+	}
+
+	if ( GLv_NULL != GLi->version() ) {
+		eePRINTL( "WindowNull: the renderer already created is not the null renderer" );
+		return false;
+	}
+
+	createPlatform();
+
+	createView();
+
+	setup2D();
+
+	mWindow.Created = true;
+
+	logSuccessfulInit( "Null" );
+
+	return true;
 }
 
 void WindowNull::toggleFullscreen() {
@@ -63,6 +89,18 @@ Vector2i WindowNull::getPosition() {
 }
 
 void WindowNull::setSize( Uint32 Width, Uint32 Height, bool Windowed ) {
+	if ( !mWindow.Created || !Width || !Height )
+		return;
+
+	mWindow.WindowConfig.Width	= Width;
+	mWindow.WindowConfig.Height	= Height;
+	mWindow.WindowSize			= Sizei( Width, Height );
+
+	mDefaultView.setView( 0, 0, Width, Height );
+
+	setup2D();
+
+	sendVideoResizeCb();
 }
 
 void WindowNull::swapBuffers() {
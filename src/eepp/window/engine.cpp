@@ -1,5 +1,6 @@
 #include <eepp/window/engine.hpp>
 #include <eepp/system/packmanager.hpp>
+#include <eepp/system/jobsystem.hpp>
 #include <eepp/system/inifile.hpp>
 #include <eepp/graphics/texturefactory.hpp>
 #include <eepp/graphics/fontmanager.hpp>
@@ -16,6 +17,7 @@
 #include <eepp/window/backend.hpp>
 #include <eepp/window/backend/SDL2/backendsdl2.hpp>
 #include <eepp/window/backend/SFML/backendsfml.hpp>
+#include <eepp/window/backend/null/windownull.hpp>
 #include <eepp/graphics/renderer/renderer.hpp>
 
 #define BACKEND_SDL2		1
@@ -45,6 +47,8 @@ Engine::Engine() :
 }
 
 Engine::~Engine() {
+	JobSystem::destroySingleton();
+
 	Physics::PhysicsManager::destroySingleton();
 
 	GlobalBatchRenderer::destroySingleton();
@@ -131,11 +135,17 @@ EE::Window::Window * Engine::createSFMLWindow( const WindowSettings& Settings, c
 #endif
 }
 
+EE::Window::Window * Engine::createNullWindow( const WindowSettings& Settings, const ContextSettings& Context ) {
+	return eeNew( Backend::Null::WindowNull, ( Settings, Context ) );
+}
+
 EE::Window::Window * Engine::createDefaultWindow( const WindowSettings& Settings, const ContextSettings& Context ) {
 #if DEFAULT_BACKEND == BACKEND_SDL2
 	return createSDL2Window( Settings, Context );
 #elif DEFAULT_BACKEND == BACKEND_SFML
 	return createSFMLWindow( Settings, Context );
+#else
+	return createNullWindow( Settings, Context );
 #endif
 }
 
@@ -151,6 +161,7 @@ EE::Window::Window * Engine::createWindow( WindowSettings Settings, ContextSetti
 	switch ( Settings.Backend ) {
 		case WindowBackend::SDL2:		window = createSDL2Window( Settings, Context );		break;
 		case WindowBackend::SFML:		window = createSFMLWindow( Settings, Context );		break;
+		case WindowBackend::Null:		window = createNullWindow( Settings, Context );		break;
 		case WindowBackend::Default:
 		default:						window = createDefaultWindow( Settings, Context );	break;
 	}
@@ -218,6 +229,8 @@ Uint32 Engine::getDefaultBackend() const {
 	return WindowBackend::SDL2;
 #elif DEFAULT_BACKEND == BACKEND_SFML
 	return WindowBackend::SFML;
+#else
+	return WindowBackend::Null;
 #endif
 }
 
@@ -242,6 +255,7 @@ WindowSettings Engine::createWindowSettings( IniFile * ini, std::string iniKeyNa
 
 	if ( "sdl2" == Backend )		WinBackend	= WindowBackend::SDL2;
 	else if ( "sfml" == Backend )	WinBackend	= WindowBackend::SFML;
+	else if ( "null" == Backend )	WinBackend	= WindowBackend::Null;
 
 	Uint32 Style = WindowStyle::Titlebar;
 
@@ -290,6 +304,7 @@ ContextSettings Engine::createContextSettings( IniFile * ini, std::string iniKey
 	else if (	"opengl es 1" == GLVersion || "gles1" == GLVersion || "gl es 1" == GLVersion || "opengl es1" == GLVersion ||
 				"opengles1" == GLVersion || "es1" == GLVersion || "gles 1" == GLVersion )														GLVer = GLv_ES1;
 	else if (	"2" == GLVersion || "opengl 2" == GLVersion || "gl2" == GLVersion || "gl 2" == GLVersion )										GLVer = GLv_2;
+	else if (	"null" == GLVersion )																											GLVer = GLv_NULL;
 	else																																		GLVer = GLv_default;
 
 	bool doubleBuffering 		= ini->getValueB( iniKeyName, "DoubleBuffering", true );
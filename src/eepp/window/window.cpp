@@ -308,12 +308,15 @@ void Window::clear() {
 
 void Window::display( bool clear ) {
 	GlobalBatchRenderer::instance()->draw();
+	GlobalBatchRenderer::instance()->endFrame();
 
 	if ( mCurrentView->needUpdate() )
 		setView( *mCurrentView );
 
 	swapBuffers();
 
+	GLi->endFrame();
+
 	#if EE_PLATFORM != EE_PLATFORM_EMSCRIPTEN
 	if ( clear )
 		this->clear();
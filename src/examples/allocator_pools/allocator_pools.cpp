@@ -0,0 +1,138 @@
+#include <eepp/ee.hpp>
+#include <eepp/maps.hpp>
+#include <eepp/maps/gameobjectvirtual.hpp>
+using namespace EE::Maps;
+
+// Benchmark of the allocations of the short lived engine objects with and without their pools:
+// loading a tile map ( a game object per tile ), creating and destroying the sub textures of a texture atlas, and building
+// temporary per frame containers in an arena instead of the heap.
+
+static void createMap( const std::string& path, const Sizei& size ) {
+	TileMap map;
+
+	map.create( size, 2, Sizei( 32, 32 ) );
+
+	for ( Uint32 l = 0; l < 2; l++ ) {
+		TileMapLayer * layer = reinterpret_cast<TileMapLayer*>( map.addLayer( MAP_LAYER_TILED, 0, "layer" + String::toStr( l ) ) );
+
+		for ( Int32 y = 0; y < size.getHeight(); y++ ) {
+			for ( Int32 x = 0; x < size.getWidth(); x++ ) {
+				layer->addGameObject( eeNew( GameObjectVirtual, ( x * y, layer, GObjFlags::GAMEOBJECT_STATIC, 1000 + l ) ), Vector2i( x, y ) );
+			}
+		}
+	}
+
+	map.saveToFile( path );
+}
+
+static Time benchmarkMapLoad( const std::string& path, Uint32 loads ) {
+	Clock clock;
+
+	for ( Uint32 i = 0; i < loads; i++ ) {
+		TileMap map;
+		map.loadFromFile( path );
+	}
+
+	return clock.getElapsedTime();
+}
+
+static Time benchmarkSubTextures( Uint32 count, Uint32 rounds ) {
+	Clock clock;
+
+	for ( Uint32 r = 0; r < rounds; r++ ) {
+		TextureAtlas atlas( "allocator_pools" );
+
+		for ( Uint32 i = 0; i < count; i++ ) {
+			atlas.add( 0, Rect( 0, 0, 16, 16 ), String::toStr( i ) );
+		}
+	}
+
+	return clock.getElapsedTime();
+}
+
+typedef AllocatorAdapter<Vector2f, ArenaAllocator> ArenaVector2fAllocator;
+
+static Time benchmarkFrameContainers( Uint32 frames, Uint32 containers, bool useArena ) {
+	ArenaAllocator arena;
+	Clock clock;
+	Float sum = 0;
+
+	for ( Uint32 f = 0; f < frames; f++ ) {
+		for ( Uint32 c = 0; c < containers; c++ ) {
+			if ( useArena ) {
+				std::vector<Vector2f, ArenaVector2fAllocator> points( ( ArenaVector2fAllocator( &arena ) ) );
+
+				for ( Uint32 i = 0; i < 32; i++ )
+					points.push_back( Vector2f( i, c ) );
+
+				sum += points.back().x;
+			} else {
+				std::vector<Vector2f> points;
+
+				for ( Uint32 i = 0; i < 32; i++ )
+					points.push_back( Vector2f( i, c ) );
+
+				sum += points.back().x;
+			}
+		}
+
+		arena.reset();
+	}
+
+	if ( useArena )
+		std::cout << "Frame arena peak usage: " << FileSystem::sizeToString( arena.getPeakUsedMemory() ) << " in " << arena.getBlockCount() << " blocks" << std::endl;
+
+	return sum > 0 ? clock.getElapsedTime() : Time::Zero;
+}
+
+static void printPoolStats( const std::string& name, PoolAllocator& pool ) {
+	std::cout << name << " pool: block size " << pool.getBlockSize() << " bytes, peak " << pool.getPeakUsedBlocks() << " blocks used of "
+			  << pool.getCapacity() << " ( " << FileSystem::sizeToString( pool.getReservedMemory() ) << " reserved ), "
+			  << pool.getHeapAllocations() << " allocations served by the heap" << std::endl;
+}
+
+static void printResult( const std::string& name, const Time& withPool, const Time& withoutPool ) {
+	std::cout << name << ": " << withoutPool.asMilliseconds() << " ms without pool, " << withPool.asMilliseconds() << " ms with pool" << std::endl;
+}
+
+EE_MAIN_FUNC int main (int argc, char * argv []) {
+	EE::Window::Window * win = Engine::instance()->createWindow( WindowSettings( 320, 240, "eepp - Allocator Pools" ), ContextSettings( false ) );
+
+	if ( win->isOpen() ) {
+		Int32 mapSize = argc > 1 ? atoi( argv[1] ) : 256;
+		Uint32 rounds = argc > 2 ? atoi( argv[2] ) : 10;
+		std::string path( Sys::getTempPath() + "eepp_allocator_pools.eem" );
+
+		createMap( path, Sizei( mapSize, mapSize ) );
+
+		GameObject::getAllocator().setEnabled( false );
+		Time mapHeap = benchmarkMapLoad( path, rounds );
+		GameObject::getAllocator().setEnabled( true );
+		Time mapPool = benchmarkMapLoad( path, rounds );
+
+		printResult( "TileMap load", mapPool, mapHeap );
+
+		SubTexture::getAllocator().setEnabled( false );
+		Time subHeap = benchmarkSubTextures( 50000, rounds );
+		SubTexture::getAllocator().setEnabled( true );
+		Time subPool = benchmarkSubTextures( 50000, rounds );
+
+		printResult( "SubTexture creation", subPool, subHeap );
+
+		Time frameHeap = benchmarkFrameContainers( 1000, 500, false );
+		Time frameArena = benchmarkFrameContainers( 1000, 500, true );
+
+		std::cout << "Frame containers: " << frameHeap.asMilliseconds() << " ms with the heap, " << frameArena.asMilliseconds() << " ms with the frame arena" << std::endl;
+
+		printPoolStats( "GameObject", GameObject::getAllocator() );
+		printPoolStats( "SubTexture", SubTexture::getAllocator() );
+
+		FileSystem::fileRemove( path );
+	}
+
+	Engine::destroySingleton();
+
+	MemoryManager::showResults();
+
+	return EXIT_SUCCESS;
+}
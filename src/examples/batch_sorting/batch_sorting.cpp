@@ -0,0 +1,71 @@
+#include <eepp/ee.hpp>
+
+// Compares the draw calls of the global batch renderer drawing sprites of interleaved textures ( like the skins, texts and
+// sprites of an UI from different atlases ) with the default batching and with the deferred sort and merge batching.
+
+static Texture * createTexture( const Color& color ) {
+	Image image( 32, 32, 4, color );
+
+	return TextureFactory::instance()->getTexture( TextureFactory::instance()->loadFromPixels( image.getPixelsPtr(), image.getWidth(), image.getHeight(), image.getChannels() ) );
+}
+
+static void drawFrame( EE::Window::Window * win, std::vector<Texture*>& textures, Uint32 sprites, bool deferred ) {
+	BatchRenderer * BR = GlobalBatchRenderer::instance();
+	BR->setDeferred( deferred );
+
+	for ( Uint32 i = 0; i < sprites; i++ ) {
+		// The background skins go in the first layer, the sprites over them in the second one
+		BR->setLayer( i % 4 == 0 ? 0 : 1 );
+
+		textures[ i % textures.size() ]->draw( ( i * 7 ) % win->getWidth(), ( i * 13 ) % win->getHeight() );
+	}
+
+	win->display();
+}
+
+static void printStats( const std::string& name, const BatchRenderer::Stats& stats ) {
+	std::cout << name << ": " << stats.DrawCalls << " draw calls, " << stats.Vertexs << " vertexs, " << stats.Flushes << " flushes ( "
+			  << stats.FlushesByCause[ BatchRenderer::FlushTexture ] << " texture, "
+			  << stats.FlushesByCause[ BatchRenderer::FlushBlendMode ] << " blend mode, "
+			  << stats.FlushesByCause[ BatchRenderer::FlushDrawMode ] << " draw mode, "
+			  << stats.FlushesByCause[ BatchRenderer::FlushBufferFull ] << " buffer full, "
+			  << stats.FlushesByCause[ BatchRenderer::FlushDraw ] << " draw, "
+			  << stats.FlushesByCause[ BatchRenderer::FlushExternal ] << " external )" << std::endl;
+}
+
+EE_MAIN_FUNC int main (int argc, char * argv []) {
+	EE::Window::Window * win = Engine::instance()->createWindow( WindowSettings( 640, 480, "eepp - Batch Sorting" ), ContextSettings( false ) );
+
+	if ( win->isOpen() ) {
+		Uint32 sprites = argc > 1 ? atoi( argv[1] ) : 2000;
+		Uint32 frames = argc > 2 ? atoi( argv[2] ) : 100;
+		std::vector<Texture*> textures;
+
+		textures.push_back( createTexture( Color::Red ) );
+		textures.push_back( createTexture( Color::Green ) );
+		textures.push_back( createTexture( Color::Blue ) );
+
+		for ( int mode = 0; mode < 2; mode++ ) {
+			bool deferred = 1 == mode;
+			Clock clock;
+
+			for ( Uint32 f = 0; f < frames; f++ )
+				drawFrame( win, textures, sprites, deferred );
+
+			std::cout << ( deferred ? "Deferred" : "Default" ) << ": " << clock.getElapsedTime().asMilliseconds() / frames << " ms per frame" << std::endl;
+
+			printStats( deferred ? "Deferred" : "Default", GlobalBatchRenderer::instance()->getFrameStats() );
+
+			VertexStreamBuffer::Stats streamStats = GLi->getVertexStreamStats();
+
+			std::cout << "Vertex stream: " << streamStats.BytesUploaded << " bytes uploaded in " << streamStats.Uploads << " uploads, "
+					  << streamStats.Orphans << " orphans, " << streamStats.Waits << " waits" << std::endl;
+		}
+	}
+
+	Engine::destroySingleton();
+
+	MemoryManager::showResults();
+
+	return EXIT_SUCCESS;
+}
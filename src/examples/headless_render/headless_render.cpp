@@ -0,0 +1,95 @@
+#include <eepp/ee.hpp>
+
+// Renders some frames with the null window backend, without a GPU nor an OpenGL context, and prints the statistics of the
+// commands recorded by the null renderer: draw calls, vertexs, texture binds, state changes and bytes uploaded.
+// Usage: eepp-headless-render [sprites] [frames] [font path] [--dump]
+
+static Texture * createTexture( const Color& color ) {
+	Image image( 32, 32, 4, color );
+
+	return TextureFactory::instance()->getTexture( TextureFactory::instance()->loadFromPixels( image.getPixelsPtr(), image.getWidth(), image.getHeight(), image.getChannels() ) );
+}
+
+static void printStats( const std::string& name, const RendererNull::FrameStats& stats ) {
+	std::cout << name << ": " << stats.DrawCalls << " draw calls, " << stats.Vertexs << " vertexs, "
+			  << stats.TextureBinds << " texture binds ( " << stats.TextureChanges << " changes ), "
+			  << stats.StateChanges << " state changes, " << stats.MatrixOps << " matrix ops, "
+			  << stats.getBytesUploaded() << " bytes uploaded ( " << stats.TextureBytes << " to textures )" << std::endl;
+}
+
+EE_MAIN_FUNC int main (int argc, char * argv []) {
+	EE::Window::Window * win = Engine::instance()->createWindow( WindowSettings( 1024, 768, "eepp - Headless Render", WindowStyle::Default, WindowBackend::Null ), ContextSettings( false, GLv_NULL ) );
+
+	if ( win->isOpen() && GLv_NULL == GLi->version() ) {
+		RendererNull * renderer = GLi->getRendererNull();
+		std::vector<std::string> args;
+		bool dump = false;
+
+		// --dump can be anywhere, the other arguments are positional
+		for ( int i = 1; i < argc; i++ ) {
+			if ( std::string( "--dump" ) == argv[i] ) {
+				dump = true;
+			} else {
+				args.push_back( argv[i] );
+			}
+		}
+
+		Uint32 sprites = args.size() > 0 ? atoi( args[0].c_str() ) : 2000;
+		Uint32 frames = args.size() > 1 ? atoi( args[1].c_str() ) : 100;
+		std::vector<Texture*> textures;
+		Primitives p;
+		Text text;
+
+		textures.push_back( createTexture( Color::Red ) );
+		textures.push_back( createTexture( Color::Green ) );
+		textures.push_back( createTexture( Color::Blue ) );
+
+		if ( args.size() > 2 && FileSystem::fileExists( args[2] ) ) {
+			FontTrueType * font = FontTrueType::New( "font" );
+			font->loadFromFile( args[2] );
+
+			text.setFont( font );
+			text.setCharacterSize( 16 );
+			text.setString( "Lorem ipsum dolor sit amet, consectetur adipisicing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua." );
+		}
+
+		// The first frame includes the texture uploads and the window setup
+		win->display();
+
+		printStats( "Setup", renderer->getFrameStats() );
+
+		Clock clock;
+
+		for ( Uint32 f = 0; f < frames; f++ ) {
+			for ( Uint32 i = 0; i < sprites; i++ ) {
+				textures[ i % textures.size() ]->draw( ( i * 7 + f ) % win->getWidth(), ( i * 13 ) % win->getHeight() );
+			}
+
+			p.setColor( Color( 255, 255, 255, 100 ) );
+
+			for ( Uint32 i = 0; i < 32; i++ ) {
+				p.drawRectangle( Rectf( Vector2f( i * 32, 0 ), Sizef( 30, 30 ) ) );
+			}
+
+			if ( NULL != text.getFont() ) {
+				text.draw( 16, 16 );
+			}
+
+			win->display();
+		}
+
+		std::cout << "CPU time: " << clock.getElapsedTime().asMilliseconds() / ( frames > 0 ? frames : 1 ) << " ms per frame" << std::endl;
+
+		printStats( "Frame", renderer->getFrameStats() );
+
+		if ( dump ) {
+			std::cout << renderer->dumpCommands();
+		}
+	}
+
+	Engine::destroySingleton();
+
+	MemoryManager::showResults();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,420 @@
+#include <eepp/ee.hpp>
+#include <eepp/network/socketselector.hpp>
+#include <eepp/network/tcplistener.hpp>
+
+#if defined( EE_PLATFORM_POSIX )
+#include <sys/resource.h>
+#endif
+
+// Benchmark of the Http client against a local HTTP server: compares the requests per second closing the connection
+// after every request ( as Http did before the connection pool ) against the connections kept alive, with Content-Length
+// and chunked responses, and the memory used to download a big file keeping the body in the response or writing it to
+// a stream while it is received. The async requests share the same connections. The stress test queues a lot of async
+// requests at once, cancelling some of them, with the callbacks called from the main thread, and checks the connections
+// opened at the same time, the timeouts and the cancellation of a request waiting for the response.
+// Usage: eepp-http-loopback [requests] [download size in MB] [port]
+
+namespace {
+
+// A minimal HTTP/1.1 server: answers GET requests to /small ( 1 KB body ), /chunked ( 1 KB body in chunks of 100 bytes )
+// and /big ( the download size ), and never answers /never. Keeps the connections alive unless the client asks to close them.
+class LoopbackServer {
+	public:
+		LoopbackServer( unsigned short port, std::size_t bigSize ) :
+			mThread( &LoopbackServer::run, this ),
+			mPort( port ),
+			mBigSize( bigSize ),
+			mRunning( false ),
+			mAccepted( 0 ),
+			mOpen( 0 ),
+			mMaxOpen( 0 )
+		{
+			for ( std::size_t i = 0; i < 1024; i++ )
+				mSmallBody += (char)( 'a' + i % 26 );
+		}
+
+		~LoopbackServer() {
+			stop();
+		}
+
+		bool start() {
+			if ( mListener.listen( mPort ) != Socket::Done )
+				return false;
+
+			mRunning = true;
+			mThread.launch();
+
+			return true;
+		}
+
+		void stop() {
+			if ( mRunning ) {
+				mRunning = false;
+				mThread.wait();
+				mListener.close();
+			}
+		}
+
+		Uint32 getAcceptedConnections() const {
+			return mAccepted;
+		}
+
+		/** @return The maximum number of connections open at the same time since the last reset */
+		Uint32 getMaxOpenConnections() const {
+			return mMaxOpen;
+		}
+
+		void resetMaxOpenConnections() {
+			mMaxOpen = mOpen;
+		}
+
+		const std::string& getSmallBody() const {
+			return mSmallBody;
+		}
+	protected:
+		struct Client {
+			TcpSocket *	Socket;
+			std::string	Buffer;
+		};
+
+		Thread				mThread;
+		TcpListener			mListener;
+		unsigned short		mPort;
+		std::size_t			mBigSize;
+		volatile bool		mRunning;
+		volatile Uint32		mAccepted;
+		volatile Uint32		mOpen;
+		volatile Uint32		mMaxOpen;
+		std::string			mSmallBody;
+
+		void run() {
+			SocketSelector selector;
+			std::list<Client> clients;
+
+			selector.add( mListener );
+
+			while ( mRunning ) {
+				if ( !selector.wait( Milliseconds( 50 ) ) )
+					continue;
+
+				if ( selector.isReady( mListener ) ) {
+					Client client;
+					client.Socket = eeNew( TcpSocket, () );
+
+					if ( mListener.accept( *client.Socket ) == Socket::Done ) {
+						selector.add( *client.Socket );
+						clients.push_back( client );
+						mAccepted++;
+						mOpen = clients.size();
+						mMaxOpen = eemax( mMaxOpen, mOpen );
+					} else {
+						eeDelete( client.Socket );
+					}
+				}
+
+				std::list<Client>::iterator it = clients.begin();
+
+				while ( it != clients.end() ) {
+					if ( selector.isReady( *it->Socket ) && !serve( *it ) ) {
+						selector.remove( *it->Socket );
+						eeDelete( it->Socket );
+						it = clients.erase( it );
+						mOpen = clients.size();
+					} else {
+						it++;
+					}
+				}
+			}
+
+			for ( std::list<Client>::iterator it = clients.begin(); it != clients.end(); it++ )
+				eeDelete( it->Socket );
+		}
+
+		// Answers the complete requests received, @return False if the connection must be closed
+		bool serve( Client& client ) {
+			char data[4096];
+			std::size_t received;
+
+			if ( client.Socket->receive( data, sizeof(data), received ) != Socket::Done )
+				return false;
+
+			client.Buffer.append( data, received );
+
+			std::size_t end;
+
+			while ( ( end = client.Buffer.find( "\r\n\r\n" ) ) != std::string::npos ) {
+				std::string request( client.Buffer.substr( 0, end ) );
+				bool close = String::toLower( request ).find( "connection: close" ) != std::string::npos;
+				std::string uri( request.substr( 4, request.find( ' ', 4 ) - 4 ) );
+
+				client.Buffer.erase( 0, end + 4 );
+
+				if ( !respond( *client.Socket, uri, close ) || close )
+					return false;
+			}
+
+			return true;
+		}
+
+		bool respond( TcpSocket& socket, const std::string& uri, bool close ) {
+			std::ostringstream header;
+
+			if ( "/never" == uri )
+				return true;
+
+			header << "HTTP/1.1 200 OK\r\n" << ( close ? "Connection: close\r\n" : "" );
+
+			if ( "/chunked" == uri ) {
+				std::ostringstream body;
+
+				for ( std::size_t i = 0; i < mSmallBody.size(); i += 100 ) {
+					std::size_t size = eemin( (std::size_t)100, mSmallBody.size() - i );
+					body << std::hex << size << "\r\n" << mSmallBody.substr( i, size ) << "\r\n";
+				}
+
+				body << "0\r\n\r\n";
+
+				header << "Transfer-Encoding: chunked\r\n\r\n" << body.str();
+
+				return socket.send( header.str().c_str(), header.str().size() ) == Socket::Done;
+			} else if ( "/big" == uri ) {
+				header << "Content-Length: " << mBigSize << "\r\n\r\n";
+
+				if ( socket.send( header.str().c_str(), header.str().size() ) != Socket::Done )
+					return false;
+
+				std::string block( 65536, 'x' );
+
+				for ( std::size_t sent = 0; sent < mBigSize; sent += block.size() ) {
+					if ( socket.send( block.c_str(), eemin( block.size(), mBigSize - sent ) ) != Socket::Done )
+						return false;
+				}
+
+				return true;
+			}
+
+			header << "Content-Length: " << mSmallBody.size() << "\r\n\r\n" << mSmallBody;
+
+			return socket.send( header.str().c_str(), header.str().size() ) == Socket::Done;
+		}
+};
+
+// Counts the body received instead of storing it
+class CountingStream : public IOStream {
+	public:
+		CountingStream() : mSize( 0 ) {}
+
+		ios_size read( char * data, ios_size size ) { return 0; }
+
+		ios_size write( const char * data, ios_size size ) { mSize += size; return size; }
+
+		ios_size seek( ios_size position ) { return mSize; }
+
+		ios_size tell() { return mSize; }
+
+		ios_size getSize() { return mSize; }
+
+		bool isOpen() { return true; }
+	protected:
+		ios_size mSize;
+};
+
+Mutex asyncMutex;
+Uint32 asyncDone = 0;
+Uint32 asyncFailed = 0;
+
+void onAsyncResponse( const Http&, Http::Request&, Http::Response& response ) {
+	Lock l( asyncMutex );
+
+	asyncDone++;
+
+	if ( response.getStatus() != Http::Response::Ok || response.getBody().size() != 1024 )
+		asyncFailed++;
+}
+
+void onStressResponse( const Http&, Http::Request&, Http::Response& response ) {
+	// Called from the main thread by processAsyncResponses
+	asyncDone++;
+
+	if ( response.getStatus() != Http::Response::Ok || response.getBody().size() != 1024 )
+		asyncFailed++;
+}
+
+Http::Response::Status neverStatus = Http::Response::Ok;
+
+void onNeverResponse( const Http&, Http::Request&, Http::Response& response ) {
+	neverStatus = response.getStatus();
+}
+
+void stressTest( LoopbackServer& server, unsigned short port, Uint32 requests ) {
+	Http http( "localhost", port );
+	std::vector<Http::AsyncHandle> handles;
+	Uint32 cancelled = 0;
+	Clock clock;
+
+	http.setMaxAsyncRequests( 8 );
+	http.setMaxConnections( 8 );
+	http.setQueueAsyncResponses( true );
+
+	asyncDone = asyncFailed = 0;
+	server.resetMaxOpenConnections();
+
+	for ( Uint32 i = 0; i < requests; i++ )
+		handles.push_back( http.sendAsyncRequest( cb::Make3( onStressResponse ), Http::Request( "/small" ) ) );
+
+	// Cancels one of every ten requests, some of them could be already sent
+	for ( Uint32 i = 0; i < requests; i += 10 ) {
+		if ( http.cancelAsyncRequest( handles[i] ) )
+			cancelled++;
+	}
+
+	// The main loop pumps the responses
+	while ( http.getPendingAsyncRequestCount() > 0 ) {
+		http.processAsyncResponses();
+
+		Sys::sleep( Milliseconds( 1 ) );
+	}
+
+	std::cout << "Stress: " << requests << " async requests in " << clock.getElapsedTime().asMilliseconds() << " ms, " << asyncDone
+			  << " responses, " << cancelled << " cancelled, " << asyncFailed << " failed, " << server.getMaxOpenConnections()
+			  << " connections open at most" << std::endl;
+
+	// A request without response must stop after the timeout
+	clock.restart();
+
+	http.setQueueAsyncResponses( false );
+	http.sendAsyncRequest( cb::Make3( onNeverResponse ), Http::Request( "/never" ), Milliseconds( 200 ) );
+
+	while ( http.getPendingAsyncRequestCount() > 0 )
+		Sys::sleep( Milliseconds( 1 ) );
+
+	std::cout << "Timeout of 200 ms: " << ( Http::Response::TimedOut == neverStatus ? "timed out" : "didn't time out" ) << " after "
+			  << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+
+	// A request waiting for the response must stop when cancelled
+	Http::AsyncHandle handle = http.sendAsyncRequest( cb::Make3( onNeverResponse ), Http::Request( "/never" ) );
+
+	Sys::sleep( Milliseconds( 100 ) );
+
+	clock.restart();
+
+	bool wasPending = http.cancelAsyncRequest( handle );
+
+	while ( http.getPendingAsyncRequestCount() > 0 )
+		Sys::sleep( Milliseconds( 1 ) );
+
+	std::cout << "Cancel while waiting for the response: " << ( wasPending ? "cancelled" : "not pending" ) << ", stopped after "
+			  << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+}
+
+// The peak resident memory of the process, in KB
+long peakMemory() {
+#if defined( EE_PLATFORM_POSIX )
+	struct rusage usage;
+
+	getrusage( RUSAGE_SELF, &usage );
+
+	return usage.ru_maxrss;
+#else
+	return 0;
+#endif
+}
+
+void benchmarkRequests( Http& http, LoopbackServer& server, const std::string& name, const std::string& uri, bool keepAlive, Uint32 requests ) {
+	Http::Request request( uri );
+	Uint32 accepted = server.getAcceptedConnections();
+	Uint32 failed = 0;
+	Clock clock;
+
+	if ( !keepAlive )
+		request.setField( "Connection", "close" );
+
+	for ( Uint32 i = 0; i < requests; i++ ) {
+		Http::Response response = http.sendRequest( request );
+
+		if ( response.getStatus() != Http::Response::Ok || response.getBody() != server.getSmallBody() )
+			failed++;
+	}
+
+	Time time = clock.getElapsedTime();
+
+	std::cout << name << ": " << (Uint32)( requests / time.asSeconds() ) << " requests/s, " << server.getAcceptedConnections() - accepted
+			  << " connections" << ( failed ? ", " + String::toStr( failed ) + " failed" : "" ) << std::endl;
+}
+
+}
+
+EE_MAIN_FUNC int main (int argc, char * argv []) {
+	{
+		Uint32 requests = argc > 1 ? atoi( argv[1] ) : 2000;
+		std::size_t bigSize = ( argc > 2 ? atoi( argv[2] ) : 64 ) * 1024 * 1024;
+		unsigned short port = argc > 3 ? atoi( argv[3] ) : 55080;
+		LoopbackServer server( port, bigSize );
+
+		if ( !server.start() ) {
+			std::cout << "Couldn't listen on port " << port << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		Http http( "localhost", port );
+
+		benchmarkRequests( http, server, "Content-Length, closing the connections", "/small", false, requests );
+		benchmarkRequests( http, server, "Content-Length, keep-alive", "/small", true, requests );
+		benchmarkRequests( http, server, "Chunked, closing the connections", "/chunked", false, requests );
+		benchmarkRequests( http, server, "Chunked, keep-alive", "/chunked", true, requests );
+
+		// Async requests, sharing the connections kept alive
+		Uint32 accepted = server.getAcceptedConnections();
+		Clock clock;
+
+		for ( Uint32 i = 0; i < requests; i++ )
+			http.sendAsyncRequest( cb::Make3( onAsyncResponse ), Http::Request( "/small" ) );
+
+		while ( true ) {
+			{
+				Lock l( asyncMutex );
+
+				if ( asyncDone == requests )
+					break;
+			}
+
+			Sys::sleep( Milliseconds( 1 ) );
+		}
+
+		std::cout << "Async, keep-alive: " << (Uint32)( requests / clock.getElapsedTime().asSeconds() ) << " requests/s, "
+				  << server.getAcceptedConnections() - accepted << " connections" << ( asyncFailed ? ", " + String::toStr( asyncFailed ) + " failed" : "" ) << std::endl;
+
+		// The peak memory only grows, so the streamed download goes first
+		Http::Request request( "/big" );
+		CountingStream stream;
+		long memory = peakMemory();
+
+		clock.restart();
+
+		request.setResponseStream( &stream );
+
+		Http::Response streamed = http.sendRequest( request );
+
+		std::cout << "Download streamed: " << FileSystem::sizeToString( stream.getSize() ) << " in " << clock.getElapsedTime().asMilliseconds()
+				  << " ms, peak memory +" << FileSystem::sizeToString( ( peakMemory() - memory ) * 1024 ) << std::endl;
+
+		request.setResponseStream( NULL );
+		memory = peakMemory();
+		clock.restart();
+
+		Http::Response buffered = http.sendRequest( request );
+
+		std::cout << "Download buffered: " << FileSystem::sizeToString( buffered.getBody().size() ) << " in " << clock.getElapsedTime().asMilliseconds()
+				  << " ms, peak memory +" << FileSystem::sizeToString( ( peakMemory() - memory ) * 1024 ) << std::endl;
+
+		http.closeConnections();
+
+		stressTest( server, port, requests );
+
+		server.stop();
+	}
+
+	MemoryManager::showResults();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,308 @@
+#include <eepp/ee.hpp>
+
+// Runs every ImageKernels kernel over the same image and compares the time and the result against the per pixel
+// code that Image used before the kernels ( getPixel / setPixel and Color::blend ).
+// Usage: eepp-image-kernels [image size] [iterations]
+
+namespace {
+
+void oldReplaceColor( Image& img, const Color& ColorKey, const Color& NewColor ) {
+	Uint8 * pixels = img.getPixels();
+	Uint32 channels = img.getChannels();
+	Uint32 size = img.getWidth() * img.getHeight();
+
+	for ( Uint32 i = 0; i < size; i++ ) {
+		Uint32 Pos = i * channels;
+
+		if ( 4 == channels ) {
+			if ( pixels[ Pos ] == ColorKey.r && pixels[ Pos + 1 ] == ColorKey.g && pixels[ Pos + 2 ] == ColorKey.b && pixels[ Pos + 3 ] == ColorKey.a ) {
+				pixels[ Pos ]		= NewColor.r;
+				pixels[ Pos + 1 ]	= NewColor.g;
+				pixels[ Pos + 2 ]	= NewColor.b;
+				pixels[ Pos + 3 ]	= NewColor.a;
+			}
+		} else if ( 3 == channels ) {
+			if ( pixels[ Pos ] == ColorKey.r && pixels[ Pos + 1 ] == ColorKey.g && pixels[ Pos + 2 ] == ColorKey.b ) {
+				pixels[ Pos ]		= NewColor.r;
+				pixels[ Pos + 1 ]	= NewColor.g;
+				pixels[ Pos + 2 ]	= NewColor.b;
+			}
+		}
+	}
+}
+
+void oldFill( Image& img, const Color& color ) {
+	// The per channel loop of the old Image::fillWithColor, over the whole image
+	Uint8 * pixels = img.getPixels();
+	Uint32 channels = img.getChannels();
+	Uint32 size = img.getWidth() * img.getHeight() * channels;
+
+	for ( Uint32 i = 0; i < size; i += channels ) {
+		for ( Uint32 z = 0; z < channels; z++ ) {
+			if ( 0 == z )
+				pixels[ i + z ] = color.r;
+			else if ( 1 == z )
+				pixels[ i + z ] = color.g;
+			else if ( 2 == z )
+				pixels[ i + z ] = color.b;
+			else if ( 3 == z )
+				pixels[ i + z ] = color.a;
+		}
+	}
+}
+
+void oldBlit( Image& dst, Image& src ) {
+	for ( Uint32 y = 0; y < src.getHeight(); y++ )
+		for ( Uint32 x = 0; x < src.getWidth(); x++ )
+			dst.setPixel( x, y, Color::blend( src.getPixel( x, y ), dst.getPixel( x, y ) ) );
+}
+
+void oldFlip( Image& dst, Image& src ) {
+	for ( Uint32 y = 0; y < src.getWidth(); y++ )
+		for ( Uint32 x = 0; x < src.getHeight(); x++ )
+			dst.setPixel( x, y, src.getPixel( y, src.getHeight() - 1 - x ) );
+}
+
+void oldConvert( Image& dst, Image& src ) {
+	for ( Uint32 y = 0; y < src.getHeight(); y++ )
+		for ( Uint32 x = 0; x < src.getWidth(); x++ )
+			dst.setPixel( x, y, src.getPixel( x, y ) );
+}
+
+void oldExtractAlpha( Uint8 * dst, Image& src ) {
+	for ( Uint32 y = 0; y < src.getHeight(); y++ )
+		for ( Uint32 x = 0; x < src.getWidth(); x++ )
+			dst[ x + y * src.getWidth() ] = src.getPixel( x, y ).a;
+}
+
+void oldExpandAlpha( Image& dst, const Uint8 * src ) {
+	for ( Uint32 y = 0; y < dst.getHeight(); y++ )
+		for ( Uint32 x = 0; x < dst.getWidth(); x++ )
+			dst.setPixel( x, y, Color( 255, 255, 255, src[ x + y * dst.getWidth() ] ) );
+}
+
+void oldPremultiply( Image& img ) {
+	for ( Uint32 y = 0; y < img.getHeight(); y++ ) {
+		for ( Uint32 x = 0; x < img.getWidth(); x++ ) {
+			Color c( img.getPixel( x, y ) );
+
+			img.setPixel( x, y, Color( ( c.r * c.a + 127 ) / 255, ( c.g * c.a + 127 ) / 255, ( c.b * c.a + 127 ) / 255, c.a ) );
+		}
+	}
+}
+
+void randomize( Image& img ) {
+	Uint8 * pixels = img.getPixels();
+
+	for ( Uint32 i = 0; i < img.getMemSize(); i++ )
+		pixels[i] = (Uint8)Math::randi( 0, 255 );
+
+	// Sprites have a lot of fully transparent and fully opaque pixels
+	if ( 4 == img.getChannels() ) {
+		for ( Uint32 i = 3; i < img.getMemSize(); i += 4 ) {
+			Uint32 r = Math::randi( 0, 3 );
+
+			if ( r < 2 )
+				pixels[i] = 0 == r ? 0 : 255;
+		}
+	}
+}
+
+void printResult( const std::string& name, const Time& oldTime, const Time& newTime, const bool& match ) {
+	std::cout << name << ": " << oldTime.asMicroseconds() / 1000.0 << " ms -> " << newTime.asMicroseconds() / 1000.0 << " ms ( x"
+			  << ( newTime.asMicroseconds() > 0 ? (double)oldTime.asMicroseconds() / (double)newTime.asMicroseconds() : 0.0 ) << " )"
+			  << ( match ? "" : " results differ" ) << std::endl;
+}
+
+bool equals( Image& a, Image& b ) {
+	return a.getMemSize() == b.getMemSize() && 0 == memcmp( a.getPixels(), b.getPixels(), a.getMemSize() );
+}
+
+}
+
+EE_MAIN_FUNC int main (int argc, char * argv []) {
+	{
+		Uint32 size = argc > 1 ? atoi( argv[1] ) : 1024;
+		Uint32 iterations = argc > 2 ? atoi( argv[2] ) : 10;
+		Uint32 count = size * size;
+		Clock clock;
+		Time oldTime, newTime;
+
+		Math::setRandomSeed( 1 );
+
+		std::cout << "Image kernels using " << ImageKernels::getInstructionSet() << ", " << size << "x" << size << " pixels, " << iterations << " iterations" << std::endl;
+
+		Image rgba( size, size, 4 ), rgb( size, size, 3 ), src( size, size, 4 );
+		Image oldImg( size, size, 4 ), newImg( size, size, 4 );
+		Image oldRgb( size, size, 3 ), newRgb( size, size, 3 );
+		std::vector<Uint8> oldAlpha( count ), newAlpha( count );
+
+		randomize( rgba );
+		randomize( rgb );
+		randomize( src );
+
+		// Alpha blend over an opaque canvas ( blending two transparent pixels gives an undefined color with Color::blend )
+		Image canvas( size, size, 4 );
+		canvas.copyImage( &rgb );
+		oldTime = newTime = Time::Zero;
+
+		for ( Uint32 i = 0; i < iterations; i++ ) {
+			oldImg = canvas;
+			clock.restart();
+			oldBlit( oldImg, src );
+			oldTime += clock.getElapsed();
+
+			newImg = canvas;
+			clock.restart();
+			newImg.blit( &src );
+			newTime += clock.getElapsed();
+		}
+
+		printResult( "blend", oldTime, newTime, equals( oldImg, newImg ) );
+
+		// Color-key masking
+		Color key( rgba.getPixel( 0, 0 ) );
+		oldTime = newTime = Time::Zero;
+
+		for ( Uint32 i = 0; i < iterations; i++ ) {
+			oldImg = rgba;
+			clock.restart();
+			oldReplaceColor( oldImg, key, Color::Transparent );
+			oldTime += clock.getElapsed();
+
+			newImg = rgba;
+			clock.restart();
+			newImg.replaceColor( key, Color::Transparent );
+			newTime += clock.getElapsed();
+		}
+
+		printResult( "replaceColor RGBA", oldTime, newTime, equals( oldImg, newImg ) );
+
+		key = rgb.getPixel( 0, 0 );
+		oldTime = newTime = Time::Zero;
+
+		for ( Uint32 i = 0; i < iterations; i++ ) {
+			oldRgb = rgb;
+			clock.restart();
+			oldReplaceColor( oldRgb, key, Color::Black );
+			oldTime += clock.getElapsed();
+
+			newRgb = rgb;
+			clock.restart();
+			newRgb.replaceColor( key, Color::Black );
+			newTime += clock.getElapsed();
+		}
+
+		printResult( "replaceColor RGB", oldTime, newTime, equals( oldRgb, newRgb ) );
+
+		// Fill
+		oldTime = newTime = Time::Zero;
+
+		for ( Uint32 i = 0; i < iterations; i++ ) {
+			clock.restart();
+			oldFill( oldRgb, Color( 10, 20, 30, 40 ) );
+			oldTime += clock.getElapsed();
+
+			clock.restart();
+			newRgb.fillWithColor( Color( 10, 20, 30, 40 ) );
+			newTime += clock.getElapsed();
+		}
+
+		printResult( "fill RGB", oldTime, newTime, equals( oldRgb, newRgb ) );
+
+		// 90º rotation
+		Image rotated( size, size, 4 );
+		oldTime = newTime = Time::Zero;
+
+		for ( Uint32 i = 0; i < iterations; i++ ) {
+			clock.restart();
+			oldFlip( rotated, rgba );
+			oldTime += clock.getElapsed();
+
+			newImg = rgba;
+			clock.restart();
+			newImg.flip();
+			newTime += clock.getElapsed();
+		}
+
+		printResult( "flip", oldTime, newTime, equals( rotated, newImg ) );
+
+		// Channel conversion
+		oldTime = newTime = Time::Zero;
+
+		for ( Uint32 i = 0; i < iterations; i++ ) {
+			clock.restart();
+			oldConvert( oldImg, rgb );
+			oldTime += clock.getElapsed();
+
+			clock.restart();
+			newImg.copyImage( &rgb );
+			newTime += clock.getElapsed();
+		}
+
+		printResult( "convert RGB to RGBA", oldTime, newTime, equals( oldImg, newImg ) );
+
+		oldTime = newTime = Time::Zero;
+
+		for ( Uint32 i = 0; i < iterations; i++ ) {
+			clock.restart();
+			oldConvert( oldRgb, rgba );
+			oldTime += clock.getElapsed();
+
+			clock.restart();
+			newRgb.copyImage( &rgba );
+			newTime += clock.getElapsed();
+		}
+
+		printResult( "convert RGBA to RGB", oldTime, newTime, equals( oldRgb, newRgb ) );
+
+		oldTime = newTime = Time::Zero;
+
+		for ( Uint32 i = 0; i < iterations; i++ ) {
+			clock.restart();
+			oldExtractAlpha( &oldAlpha[0], rgba );
+			oldTime += clock.getElapsed();
+
+			clock.restart();
+			ImageKernels::extractAlpha( &newAlpha[0], rgba.getPixels(), count );
+			newTime += clock.getElapsed();
+		}
+
+		printResult( "convert RGBA to A8", oldTime, newTime, oldAlpha == newAlpha );
+
+		oldTime = newTime = Time::Zero;
+
+		for ( Uint32 i = 0; i < iterations; i++ ) {
+			clock.restart();
+			oldExpandAlpha( oldImg, &oldAlpha[0] );
+			oldTime += clock.getElapsed();
+
+			clock.restart();
+			ImageKernels::expandAlpha( newImg.getPixels(), &newAlpha[0], count );
+			newTime += clock.getElapsed();
+		}
+
+		printResult( "convert A8 to RGBA", oldTime, newTime, equals( oldImg, newImg ) );
+
+		// Premultiplication
+		oldTime = newTime = Time::Zero;
+
+		for ( Uint32 i = 0; i < iterations; i++ ) {
+			oldImg = rgba;
+			clock.restart();
+			oldPremultiply( oldImg );
+			oldTime += clock.getElapsed();
+
+			newImg = rgba;
+			clock.restart();
+			newImg.premultiplyAlpha();
+			newTime += clock.getElapsed();
+		}
+
+		printResult( "premultiply", oldTime, newTime, equals( oldImg, newImg ) );
+	}
+
+	MemoryManager::showResults();
+
+	return EXIT_SUCCESS;
+}
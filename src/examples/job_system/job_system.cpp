@@ -0,0 +1,113 @@
+#include <eepp/ee.hpp>
+
+// Benchmark that decodes N small PNG images with a thread per image ( the way the ObjectLoaders worked before the JobSystem ) and with the JobSystem.
+
+struct ImageDecode {
+	std::string		Path;
+	Image *			Img;
+	bool			Done;
+
+	ImageDecode() : Img( NULL ), Done( false ) {}
+
+	void decode() {
+		Img = eeNew( Image, ( Path ) );
+		Done = true;
+	}
+
+	void reset() {
+		eeSAFE_DELETE( Img );
+		Done = false;
+	}
+};
+
+static void decodeImage( ImageDecode * decode ) {
+	decode->decode();
+}
+
+static Time benchmarkThreadPerImage( std::vector<ImageDecode>& images ) {
+	Clock clock;
+	Uint32 maxThreads = Sys::getCPUCount();
+	std::list< std::pair<Thread*, ImageDecode*> > running;
+	size_t next = 0;
+
+	// Same policy that ResourceLoader used: launch a thread per resource, up to one per core, and poll for the finished ones
+	while ( next < images.size() || !running.empty() ) {
+		while ( next < images.size() && running.size() < maxThreads ) {
+			Thread * thread = eeNew( Thread, ( &decodeImage, &images[ next ] ) );
+			thread->launch();
+			running.push_back( std::make_pair( thread, &images[ next ] ) );
+			next++;
+		}
+
+		std::list< std::pair<Thread*, ImageDecode*> >::iterator it = running.begin();
+
+		while ( it != running.end() ) {
+			if ( it->second->Done ) {
+				it->first->wait();
+				eeDelete( it->first );
+				it = running.erase( it );
+			} else {
+				it++;
+			}
+		}
+	}
+
+	return clock.getElapsedTime();
+}
+
+static Time benchmarkJobSystem( std::vector<ImageDecode>& images ) {
+	Clock clock;
+	JobSystem * jobSystem = JobSystem::instance();
+
+	for ( size_t i = 0; i < images.size(); i++ ) {
+		jobSystem->run( cb::Make0( &images[i], &ImageDecode::decode ) );
+	}
+
+	jobSystem->waitAll();
+
+	return clock.getElapsedTime();
+}
+
+EE_MAIN_FUNC int main (int argc, char * argv []) {
+	{
+		Uint32 count = argc > 1 ? atoi( argv[1] ) : 2000;
+		std::string path( Sys::getTempPath() + "eepp_job_system_bench/" );
+
+		FileSystem::makeDir( path );
+
+		std::vector<ImageDecode> images( count );
+
+		for ( Uint32 i = 0; i < count; i++ ) {
+			Image img( 32, 32, 4, Color( i % 255, ( i * 3 ) % 255, ( i * 7 ) % 255, 255 ) );
+
+			images[i].Path = path + String::toStr( i ) + ".png";
+
+			img.saveToFile( images[i].Path, SAVE_TYPE_PNG );
+		}
+
+		// Creates the workers before measuring
+		JobSystem::instance();
+
+		Time threads = benchmarkThreadPerImage( images );
+
+		for ( Uint32 i = 0; i < count; i++ )
+			images[i].reset();
+
+		Time jobs = benchmarkJobSystem( images );
+
+		for ( Uint32 i = 0; i < count; i++ ) {
+			images[i].reset();
+			FileSystem::fileRemove( images[i].Path );
+		}
+
+		std::cout << "Decoded " << count << " PNG images" << std::endl;
+		std::cout << "Thread per image: " << threads.asMilliseconds() << " ms" << std::endl;
+		std::cout << "JobSystem (" << JobSystem::instance()->getWorkerCount() << " workers): " << jobs.asMilliseconds() << " ms" << std::endl;
+
+		JobSystem::destroySingleton();
+	}
+
+	MemoryManager::showResults();
+
+	return EXIT_SUCCESS;
+}
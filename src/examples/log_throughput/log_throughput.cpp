@@ -0,0 +1,91 @@
+#include <eepp/ee.hpp>
+
+// Benchmark that writes to the log from several producer threads in synchronous mode and in asynchronous mode
+// ( with both overflow policies ). The log is written live to a file in the temporary directory.
+
+struct Producer {
+	Uint32	Id;
+	Uint32	Lines;
+
+	void run() {
+		Log * log = Log::instance();
+
+		for ( Uint32 i = 0; i < Lines; i++ ) {
+			log->writef( "Producer %u writing line %u of %u with some payload to format: %f", Id, i, Lines, i * 0.5f );
+		}
+	}
+};
+
+static Time benchmark( Uint32 producers, Uint32 lines ) {
+	std::vector<Producer> prods( producers );
+	std::vector<Thread*> threads;
+	Clock clock;
+
+	for ( Uint32 i = 0; i < producers; i++ ) {
+		prods[i].Id		= i;
+		prods[i].Lines	= lines;
+
+		threads.push_back( eeNew( Thread, ( &Producer::run, &prods[i] ) ) );
+		threads.back()->launch();
+	}
+
+	for ( Uint32 i = 0; i < producers; i++ ) {
+		threads[i]->wait();
+		eeDelete( threads[i] );
+	}
+
+	Log::instance()->flush();
+
+	return clock.getElapsedTime();
+}
+
+static void printResult( const std::string& name, Uint32 producers, Uint32 lines, Time time, Uint64 dropped ) {
+	Uint64 total = (Uint64)producers * lines;
+
+	std::cout << name << ": " << producers << " producers, " << total << " lines in " << time.asMilliseconds() << " ms ( "
+			  << (Uint64)( total / eemax( time.asSeconds(), 0.000001 ) ) << " lines/s, " << dropped << " dropped )" << std::endl;
+}
+
+EE_MAIN_FUNC int main (int argc, char * argv []) {
+	{
+		Uint32 lines = argc > 1 ? atoi( argv[1] ) : 100000;
+		Uint32 maxProducers = argc > 2 ? atoi( argv[2] ) : eemax( 1, Sys::getCPUCount() );
+		std::string path( Sys::getTempPath() + "eepp_log_bench/" );
+
+		FileSystem::makeDir( path );
+
+		Log * log = Log::instance();
+		log->save( path );
+		log->setLiveWrite( true );
+		log->setHistorySize( 1024 * 1024 );
+
+		for ( Uint32 producers = 1; producers <= maxProducers; producers *= 2 ) {
+			printResult( "Synchronous", producers, lines, benchmark( producers, lines ), 0 );
+
+			Uint64 dropped = log->getDroppedCount();
+
+			log->setAsync( true );
+			log->setOverflowPolicy( Log::OverflowBlock );
+			printResult( "Asynchronous ( block )", producers, lines, benchmark( producers, lines ), log->getDroppedCount() - dropped );
+			log->setAsync( false );
+
+			dropped = log->getDroppedCount();
+
+			log->setAsync( true );
+			log->setOverflowPolicy( Log::OverflowDrop );
+			Time time = benchmark( producers, lines );
+			log->setAsync( false );
+			printResult( "Asynchronous ( drop )", producers, lines, time, log->getDroppedCount() - dropped );
+		}
+
+		Log::destroySingleton();
+
+		FileSystem::fileRemove( path + "log.log" );
+	}
+
+	Engine::destroySingleton();
+
+	MemoryManager::showResults();
+
+	return EXIT_SUCCESS;
+}
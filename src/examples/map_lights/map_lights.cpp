@@ -0,0 +1,67 @@
+#include <eepp/ee.hpp>
+#include <eepp/maps.hpp>
+using namespace EE::Maps;
+
+// Benchmark of the light map of a TileMap: 200 lights over a visible area of 256x256 tiles.
+// Measures the first full computation, the frames without changes, and the frames where some or all of the lights move.
+
+static Time benchmarkFrames( MapLightManager * lightManager, std::vector<MapLight*>& lights, Uint32 frames, Uint32 moving ) {
+	Clock clock;
+
+	for ( Uint32 f = 0; f < frames; f++ ) {
+		for ( Uint32 i = 0; i < moving && i < lights.size(); i++ ) {
+			lights[i]->move( ( f & 1 ) ? -8 : 8, ( f & 2 ) ? -4 : 4 );
+		}
+
+		lightManager->update();
+	}
+
+	return clock.getElapsedTime();
+}
+
+static void printResult( const std::string& name, const Time& time, Uint32 frames ) {
+	std::cout << name << ": " << time.asMilliseconds() / (double)frames << " ms per frame" << std::endl;
+}
+
+EE_MAIN_FUNC int main (int argc, char * argv []) {
+	EE::Window::Window * win = Engine::instance()->createWindow( WindowSettings( 320, 240, "eepp - Map Lights" ), ContextSettings( false ) );
+
+	if ( win->isOpen() ) {
+		Int32 mapSize = argc > 1 ? atoi( argv[1] ) : 256;
+		Uint32 lightCount = argc > 2 ? atoi( argv[2] ) : 200;
+		Uint32 frames = argc > 3 ? atoi( argv[3] ) : 100;
+		Sizei tileSize( 32, 32 );
+
+		TileMap map;
+		map.create( Sizei( mapSize, mapSize ), 1, tileSize, MAP_FLAG_LIGHTS_ENABLED | MAP_FLAG_LIGHTS_BYVERTEX, Sizei( mapSize, mapSize ) * tileSize );
+		map.setBaseColor( Color( 40, 40, 40, 255 ) );
+
+		MapLightManager * lightManager = map.getLightManager();
+		std::vector<MapLight*> lights;
+		Float pixelSize = mapSize * tileSize.getWidth();
+
+		for ( Uint32 i = 0; i < lightCount; i++ ) {
+			MapLight * light = eeNew( MapLight, ( Math::randf( 64, 384 ), Math::randf( 0, pixelSize ), Math::randf( 0, pixelSize ),
+												  RGB( Math::randi( 64, 255 ), Math::randi( 64, 255 ), Math::randi( 64, 255 ) ) ) );
+			lightManager->addLight( light );
+			lights.push_back( light );
+		}
+
+		Clock clock;
+		lightManager->invalidate();
+		lightManager->update();
+		printResult( "Full light map", clock.getElapsedTime(), 1 );
+
+		printResult( "No changes", benchmarkFrames( lightManager, lights, frames, 0 ), frames );
+		printResult( "10 lights moving", benchmarkFrames( lightManager, lights, frames, 10 ), frames );
+		printResult( "All the lights moving", benchmarkFrames( lightManager, lights, frames, lightCount ), frames );
+
+		std::cout << "Light map version: " << lightManager->getVersion() << std::endl;
+	}
+
+	Engine::destroySingleton();
+
+	MemoryManager::showResults();
+
+	return EXIT_SUCCESS;
+}
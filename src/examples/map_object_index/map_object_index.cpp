@@ -0,0 +1,202 @@
+#include <eepp/ee.hpp>
+#include <eepp/maps.hpp>
+#include <eepp/maps/gameobjectvirtual.hpp>
+#include <eepp/maps/gameobjectpolygon.hpp>
+using namespace EE::Maps;
+
+// Benchmark of the spatial index of MapObjectLayer: fills an object layer with polygons and virtual objects, and compares
+// drawing every object against drawing only the objects in the view, and picking the objects with a linear scan of the
+// objects ( as MapObjectLayer did before the index ) against MapObjectLayer::getObjectOver, checking that both pick the same objects.
+// Usage: eepp-map-object-index [objects] [frames] [picks]
+
+namespace {
+
+// The objects in drawing order
+std::vector<GameObject*> objects;
+
+GameObject * linearObjectOver( const Vector2i& pos ) {
+	for ( Int32 i = (Int32)objects.size() - 1; i >= 0; i-- ) {
+		GameObject * tObj = objects[i];
+
+		if ( tObj->isType( GAMEOBJECT_TYPE_OBJECT ) ) {
+			if ( reinterpret_cast<GameObjectObject*> ( tObj )->pointInside( Vector2f( pos.x, pos.y ) ) )
+				return tObj;
+		} else {
+			Vector2f tPos = tObj->getPosition();
+			Sizei tSize = tObj->getSize();
+
+			if ( Rect( tPos.x, tPos.y, tPos.x + tSize.x, tPos.y + tSize.y ).contains( pos ) )
+				return tObj;
+		}
+	}
+
+	return NULL;
+}
+
+// Half of the points fall inside a random object, so most of the picks hit an object instead of the empty space
+void createPickPoints( std::vector<Vector2i>& points, const Uint32& picks, const Sizei& total ) {
+	points.clear();
+
+	for ( Uint32 i = 0; i < picks; i++ ) {
+		if ( i % 2 ) {
+			points.push_back( Vector2i( Math::randi( 0, total.x - 1 ), Math::randi( 0, total.y - 1 ) ) );
+		} else {
+			GameObject * tObj = objects[ Math::randi( 0, (int)objects.size() - 1 ) ];
+			Vector2f tPos = tObj->getPosition();
+			Sizei tSize = tObj->getSize();
+
+			// Around the center of the object, the corners of the rounded polygons are out of the object
+			points.push_back( Vector2i( tPos.x + tSize.x / 2 + Math::randi( -tSize.x / 4, tSize.x / 4 ),
+										tPos.y + tSize.y / 2 + Math::randi( -tSize.y / 4, tSize.y / 4 ) ) );
+		}
+	}
+}
+
+// Picks every point with both methods and returns the number of picks that differ
+Uint32 comparePicks( MapObjectLayer * layer, const std::vector<Vector2i>& points, Uint32& hits ) {
+	Uint32 differ = 0;
+
+	hits = 0;
+
+	for ( size_t i = 0; i < points.size(); i++ ) {
+		GameObject * tObj = linearObjectOver( points[i] );
+
+		if ( NULL != tObj )
+			hits++;
+
+		if ( tObj != layer->getObjectOver( points[i] ) )
+			differ++;
+	}
+
+	return differ;
+}
+
+void drawAllObjects() {
+	for ( size_t i = 0; i < objects.size(); i++ ) {
+		objects[i]->draw();
+	}
+
+	GlobalBatchRenderer::instance()->draw();
+}
+
+}
+
+EE_MAIN_FUNC int main (int argc, char * argv []) {
+	EE::Window::Window * win = Engine::instance()->createWindow( WindowSettings( 800, 600, "eepp - Map Object Index", WindowStyle::Default, WindowBackend::Null ), ContextSettings( false, GLv_NULL ) );
+
+	if ( win->isOpen() ) {
+		Uint32 count = argc > 1 ? atoi( argv[1] ) : 100000;
+		Uint32 frames = argc > 2 ? atoi( argv[2] ) : 50;
+		Uint32 picks = argc > 3 ? atoi( argv[3] ) : 200;
+		TileMap map;
+		Clock clock;
+
+		Math::setRandomSeed( 1 );
+
+		map.create( Sizei( 1024, 1024 ), 1, Sizei( 32, 32 ) );
+
+		MapObjectLayer * layer = reinterpret_cast<MapObjectLayer*>( map.addLayer( MAP_LAYER_OBJECT, LAYER_FLAG_VISIBLE, "objects" ) );
+		Sizei total( map.getTotalSize() );
+
+		for ( Uint32 i = 0; i < count; i++ ) {
+			Vector2f pos( Math::randf( 0, total.x - 64 ), Math::randf( 0, total.y - 64 ) );
+
+			if ( i % 2 ) {
+				objects.push_back( eeNew( GameObjectVirtual, ( i, layer, GObjFlags::GAMEOBJECT_STATIC, GAMEOBJECT_TYPE_VIRTUAL, pos ) ) );
+			} else {
+				Float size = Math::randf( 8, 64 );
+
+				objects.push_back( eeNew( GameObjectPolygon, ( i, Polygon2f::createRoundedRectangle( pos.x, pos.y, size, size ), layer ) ) );
+			}
+
+			layer->addGameObject( objects.back() );
+		}
+
+		std::cout << count << " objects added in " << clock.getElapsedTime().asMilliseconds() << " ms" << std::endl;
+
+		// Drawing, scrolling diagonally through the map
+		Vector2i maxOffset = map.getMaxOffset();
+		Time allTime, culledTime;
+
+		for ( Uint32 f = 0; f < frames; f++ ) {
+			map.setOffset( Vector2f( -maxOffset.x * (Float)( f + 1 ) / frames, -maxOffset.y * (Float)( f + 1 ) / frames ) );
+
+			clock.restart();
+			drawAllObjects();
+			allTime += clock.getElapsedTime();
+
+			clock.restart();
+			map.draw();
+			culledTime += clock.getElapsedTime();
+
+			win->display();
+		}
+
+		std::cout << "Drawing: every object " << allTime.asMicroseconds() / 1000.0 / frames << " ms per frame, culled "
+				  << culledTime.asMicroseconds() / 1000.0 / frames << " ms per frame" << std::endl;
+
+		// Picking
+		std::vector<Vector2i> points;
+		std::vector<GameObject*> linearResults, indexResults;
+		Uint32 found = 0, differ = 0;
+
+		createPickPoints( points, picks, total );
+
+		clock.restart();
+
+		for ( Uint32 i = 0; i < picks; i++ )
+			linearResults.push_back( linearObjectOver( points[i] ) );
+
+		Time linearTime = clock.getElapsedTime();
+
+		clock.restart();
+
+		for ( Uint32 i = 0; i < picks; i++ )
+			indexResults.push_back( layer->getObjectOver( points[i] ) );
+
+		Time indexTime = clock.getElapsedTime();
+
+		for ( Uint32 i = 0; i < picks; i++ ) {
+			if ( NULL != linearResults[i] )
+				found++;
+
+			if ( linearResults[i] != indexResults[i] )
+				differ++;
+		}
+
+		std::cout << "Picking " << picks << " points ( " << found << " hits ): linear scan " << linearTime.asMicroseconds() / 1000.0
+				  << " ms, index " << indexTime.asMicroseconds() / 1000.0 << " ms";
+
+		if ( 0 != differ )
+			std::cout << ", " << differ << " results differ";
+
+		std::cout << std::endl;
+
+		// Moving objects
+		clock.restart();
+
+		for ( size_t i = 0; i < objects.size(); i++ ) {
+			objects[i]->setPosition( objects[i]->getPosition() + Vector2f( Math::randf( -200, 200 ), Math::randf( -200, 200 ) ) );
+		}
+
+		std::cout << "Moving every object: " << clock.getElapsedTime().asMicroseconds() / 1000.0 << " ms" << std::endl;
+
+		// The points are created again inside the moved objects
+		createPickPoints( points, picks, total );
+
+		differ = comparePicks( layer, points, found );
+
+		std::cout << "Picking after moving ( " << found << " hits ): ";
+
+		if ( 0 == differ )
+			std::cout << "results match" << std::endl;
+		else
+			std::cout << differ << " results differ" << std::endl;
+	}
+
+	Engine::destroySingleton();
+
+	MemoryManager::showResults();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+#include <eepp/ee.hpp>
+#include <eepp/maps.hpp>
+#include <eepp/maps/gameobjectvirtual.hpp>
+using namespace EE::Maps;
+
+// Benchmark of the chunked map format: saves the same map in the legacy and the chunked format, and compares the time to
+// the first frame ( loading the map and drawing it ) and the frames while scrolling diagonally through the whole map,
+// with the chunks around the view loaded in background and the far chunks unloaded under a memory budget.
+// Usage: eepp-map-streaming [map size] [frames] [memory budget in MB]
+
+static void createMap( const std::string& path, const Sizei& size, const EE_MAP_FORMAT& format ) {
+	TileMap map;
+
+	map.create( size, 2, Sizei( 32, 32 ) );
+
+	for ( Uint32 l = 0; l < 2; l++ ) {
+		TileMapLayer * layer = reinterpret_cast<TileMapLayer*>( map.addLayer( MAP_LAYER_TILED, LAYER_FLAG_VISIBLE, "layer" + String::toStr( l ) ) );
+
+		for ( Int32 y = 0; y < size.getHeight(); y++ ) {
+			for ( Int32 x = 0; x < size.getWidth(); x++ ) {
+				// The ground layer is full, the second layer only has some objects
+				if ( 0 == l || 0 == ( x * 7 + y * 3 ) % 5 )
+					layer->addGameObject( eeNew( GameObjectVirtual, ( ( x + y ) % 64, layer, GObjFlags::GAMEOBJECT_STATIC, 1000 + l ) ), Vector2i( x, y ) );
+			}
+		}
+	}
+
+	map.saveToFile( path, format );
+}
+
+static Time drawFrame( EE::Window::Window * win, TileMap& map ) {
+	Clock clock;
+
+	map.update();
+	map.draw();
+
+	win->display();
+
+	return clock.getElapsedTime();
+}
+
+static void benchmarkMap( EE::Window::Window * win, const std::string& name, const std::string& path, Uint32 frames, size_t budget ) {
+	Clock clock;
+	TileMap map;
+
+	map.setStreamingMemoryBudget( budget );
+	map.loadFromFile( path );
+
+	Time loadTime = clock.getElapsedTime();
+
+	drawFrame( win, map );
+
+	Time firstFrame = clock.getElapsedTime();
+
+	// Scrolls from the top left corner to the bottom right corner
+	Vector2i maxOffset = map.getMaxOffset();
+	Time total, slowest;
+
+	for ( Uint32 f = 0; f < frames; f++ ) {
+		map.setOffset( Vector2f( -maxOffset.x * (Float)( f + 1 ) / frames, -maxOffset.y * (Float)( f + 1 ) / frames ) );
+
+		Time frame = drawFrame( win, map );
+
+		total += frame;
+		slowest = eemax( slowest, frame );
+	}
+
+	std::cout << name << ": " << FileSystem::sizeToString( FileSystem::fileSize( path ) ) << ", loaded in " << loadTime.asMilliseconds()
+			  << " ms, first frame at " << firstFrame.asMilliseconds() << " ms, scrolling " << total.asMilliseconds() / frames
+			  << " ms per frame ( slowest " << slowest.asMilliseconds() << " ms )";
+
+	if ( map.isStreaming() ) {
+		std::cout << ", " << map.getLoadedChunkCount() << " of " << map.getChunkCount() << " chunks loaded using "
+				  << FileSystem::sizeToString( map.getStreamingMemoryUsed() );
+	}
+
+	std::cout << std::endl;
+}
+
+EE_MAIN_FUNC int main (int argc, char * argv []) {
+	EE::Window::Window * win = Engine::instance()->createWindow( WindowSettings( 800, 600, "eepp - Map Streaming", WindowStyle::Default, WindowBackend::Null ), ContextSettings( false, GLv_NULL ) );
+
+	if ( win->isOpen() ) {
+		Int32 mapSize = argc > 1 ? atoi( argv[1] ) : 1024;
+		Uint32 frames = argc > 2 ? atoi( argv[2] ) : 200;
+		size_t budget = ( argc > 3 ? atoi( argv[3] ) : 8 ) * 1024 * 1024;
+		std::string legacyPath( Sys::getTempPath() + "eepp_map_streaming_legacy.eem" );
+		std::string chunkedPath( Sys::getTempPath() + "eepp_map_streaming_chunked.eem" );
+
+		createMap( legacyPath, Sizei( mapSize, mapSize ), MAP_FORMAT_LEGACY );
+		createMap( chunkedPath, Sizei( mapSize, mapSize ), MAP_FORMAT_CHUNKED );
+
+		std::cout << "Map of " << mapSize << "x" << mapSize << " tiles, " << frames << " frames, " << FileSystem::sizeToString( budget ) << " budget" << std::endl;
+
+		benchmarkMap( win, "Legacy format", legacyPath, frames, budget );
+		benchmarkMap( win, "Chunked format", chunkedPath, frames, budget );
+
+		FileSystem::fileRemove( legacyPath );
+		FileSystem::fileRemove( chunkedPath );
+	}
+
+	Engine::destroySingleton();
+
+	MemoryManager::showResults();
+
+	return EXIT_SUCCESS;
+}
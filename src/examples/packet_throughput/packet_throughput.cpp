@@ -0,0 +1,177 @@
+#include <eepp/ee.hpp>
+#include <eepp/network/tcplistener.hpp>
+#include <eepp/network/packetpool.hpp>
+
+// Benchmark of TcpSocket::send( Packet& ) and TcpSocket::receive( Packet& ) over a loopback connection, with small and
+// large packets: compares the copies that the packet path did before ( the size and the data copied into a new block to
+// send, the data received in chunks of 1 KB appended to a pending buffer and copied again into the user packet ) against
+// the gather write of the size and the data and the data received directly into a buffer that the packet takes, with the
+// packets recycled from a PacketPool.
+// Usage: eepp-packet-throughput [small packets] [large packets] [port]
+
+namespace {
+
+Socket::Status legacySend( TcpSocket& socket, Packet& packet ) {
+	std::size_t size = packet.getDataSize();
+	Uint32 packetSize = BitOp::swapBE32( (Uint32)size );
+	std::vector<char> blockToSend( sizeof(packetSize) + size );
+
+	memcpy( &blockToSend[0], &packetSize, sizeof(packetSize) );
+
+	if ( size > 0 )
+		memcpy( &blockToSend[0] + sizeof(packetSize), packet.getData(), size );
+
+	std::size_t sent;
+
+	return socket.send( &blockToSend[0], blockToSend.size(), sent );
+}
+
+Socket::Status legacyReceive( TcpSocket& socket, Packet& packet ) {
+	packet.clear();
+
+	Uint32 packetSize = 0;
+	std::size_t sizeReceived = 0;
+	std::size_t received = 0;
+
+	while ( sizeReceived < sizeof(packetSize) ) {
+		Socket::Status status = socket.receive( reinterpret_cast<char*>( &packetSize ) + sizeReceived, sizeof(packetSize) - sizeReceived, received );
+		sizeReceived += received;
+
+		if ( status != Socket::Done )
+			return status;
+	}
+
+	packetSize = BitOp::swapBE32( packetSize );
+
+	// The pending packet was a new vector for every packet
+	std::vector<char> pending;
+	char buffer[1024];
+
+	while ( pending.size() < packetSize ) {
+		std::size_t sizeToGet = eemin( static_cast<std::size_t>( packetSize - pending.size() ), sizeof(buffer) );
+		Socket::Status status = socket.receive( buffer, sizeToGet, received );
+
+		if ( status != Socket::Done )
+			return status;
+
+		if ( received > 0 ) {
+			pending.resize( pending.size() + received );
+			memcpy( &pending[0] + pending.size() - received, buffer, received );
+		}
+	}
+
+	if ( !pending.empty() )
+		packet.append( &pending[0], pending.size() );
+
+	return Socket::Done;
+}
+
+struct SenderArgs {
+	TcpSocket *	Socket;
+	Uint32		Count;
+	std::size_t	Size;
+	bool		Legacy;
+};
+
+void sendPackets( SenderArgs * args ) {
+	std::vector<char> payload( args->Size );
+	Packet packet;
+
+	for ( std::size_t i = 0; i < payload.size(); i++ )
+		payload[i] = (char)( i * 31 );
+
+	for ( Uint32 i = 0; i < args->Count; i++ ) {
+		packet.clear();
+		packet.append( payload.empty() ? NULL : &payload[0], payload.size() );
+
+		Socket::Status status = args->Legacy ? legacySend( *args->Socket, packet ) : args->Socket->send( packet );
+
+		if ( status != Socket::Done ) {
+			std::cout << "Send failed" << std::endl;
+			break;
+		}
+	}
+}
+
+bool isValid( const Packet& packet, const std::size_t& size ) {
+	return packet.getDataSize() == size && ( 0 == size || static_cast<const char*>( packet.getData() )[ size - 1 ] == (char)( ( size - 1 ) * 31 ) );
+}
+
+void benchmark( const std::string& name, TcpSocket& client, TcpSocket& server, Uint32 count, std::size_t size, bool legacy ) {
+	SenderArgs args;
+	args.Socket	= &client;
+	args.Count	= count;
+	args.Size	= size;
+	args.Legacy	= legacy;
+
+	PacketPool pool;
+	Packet legacyPacket;
+	Uint32 received = 0;
+	bool valid = true;
+	Thread sender( &sendPackets, &args );
+	Clock clock;
+
+	sender.launch();
+
+	for ( ; received < count; received++ ) {
+		if ( legacy ) {
+			if ( legacyReceive( server, legacyPacket ) != Socket::Done )
+				break;
+
+			valid = valid && isValid( legacyPacket, size );
+		} else {
+			Packet * packet = pool.acquire();
+
+			if ( server.receive( *packet ) != Socket::Done ) {
+				pool.release( packet );
+				break;
+			}
+
+			valid = valid && isValid( *packet, size );
+
+			pool.release( packet );
+		}
+	}
+
+	sender.wait();
+
+	double seconds = clock.getElapsedTime().asSeconds();
+
+	std::cout << "  " << name << ": " << (Uint64)( received / seconds ) << " packets/s, " << ( (double)received * size / seconds / ( 1024 * 1024 ) )
+			  << " MiB/s" << ( received == count && valid ? "" : ", FAILED" ) << std::endl;
+}
+
+}
+
+EE_MAIN_FUNC int main (int argc, char * argv []) {
+	{
+		Uint32 smallCount = argc > 1 ? atoi( argv[1] ) : 200000;
+		Uint32 largeCount = argc > 2 ? atoi( argv[2] ) : 2000;
+		unsigned short port = argc > 3 ? atoi( argv[3] ) : 55100;
+
+		TcpListener listener;
+		TcpSocket client;
+		TcpSocket server;
+
+		if ( listener.listen( port ) != Socket::Done || client.connect( IpAddress::LocalHost, port ) != Socket::Done ||
+			 listener.accept( server ) != Socket::Done )
+		{
+			std::cout << "Failed to open a connection on port " << port << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		std::size_t sizes[3] = { 64, 4096, 256 * 1024 };
+		Uint32 counts[3] = { smallCount, smallCount / 4, largeCount };
+
+		for ( Uint32 i = 0; i < 3; i++ ) {
+			std::cout << counts[i] << " packets of " << FileSystem::sizeToString( sizes[i] ) << ":" << std::endl;
+
+			benchmark( "copies", client, server, counts[i], sizes[i], true );
+			benchmark( "gather write and pooled packets", client, server, counts[i], sizes[i], false );
+		}
+	}
+
+	MemoryManager::showResults();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,72 @@
+#include <eepp/ee.hpp>
+
+// Benchmark of the ParticleSystem update: particles updated per second with the structure of arrays integrator, running in the
+// calling thread and split between the JobSystem workers, compared with updating an array of Particle objects one by one.
+
+static Time benchmarkParticleSystem( ParticleSystem& ps, Uint32 frames, const Time& frameTime ) {
+	Clock clock;
+
+	for ( Uint32 f = 0; f < frames; f++ )
+		ps.update( frameTime );
+
+	return clock.getElapsedTime();
+}
+
+static Time benchmarkParticleObjects( Uint32 count, Uint32 frames, const Time& frameTime, Float timeModifier ) {
+	std::vector<Particle> particles( count );
+	Float t = frameTime.asMilliseconds() * timeModifier;
+
+	for ( Uint32 i = 0; i < count; i++ ) {
+		particles[i].reset( Math::randf( 0, 640 ), Math::randf( 0, 480 ), Math::randf() - 0.5f, ( Math::randf() - 1.1f ) * 8.5f, 0.f, 0.05f );
+		particles[i].setColor( ColorAf( 1.f, 0.5f, 0.1f, 1.f ), Math::randf() * 0.04f + 0.001f );
+	}
+
+	Clock clock;
+
+	for ( Uint32 f = 0; f < frames; f++ ) {
+		for ( Uint32 i = 0; i < count; i++ ) {
+			particles[i].update( t );
+
+			if ( particles[i].a() <= 0.f )
+				particles[i].setColor( ColorAf( 1.f, 0.5f, 0.1f, 1.f ), particles[i].getAlphaDecay() );
+		}
+	}
+
+	return clock.getElapsedTime();
+}
+
+static void printResult( const std::string& name, const Time& time, Uint32 count, Uint32 frames ) {
+	double seconds = time.asSeconds();
+
+	std::cout << name << ": " << time.asMilliseconds() / (double)frames << " ms per frame, "
+			  << ( seconds > 0 ? (Uint64)( (double)count * frames / seconds ) : 0 ) << " particles/sec" << std::endl;
+}
+
+EE_MAIN_FUNC int main (int argc, char * argv []) {
+	EE::Window::Window * win = Engine::instance()->createWindow( WindowSettings( 320, 240, "eepp - Particle Throughput" ), ContextSettings( false ) );
+
+	if ( win->isOpen() ) {
+		Uint32 count = argc > 1 ? atoi( argv[1] ) : 1000000;
+		Uint32 frames = argc > 2 ? atoi( argv[2] ) : 100;
+		Time frameTime = Milliseconds( 16 );
+
+		ParticleSystem ps;
+		ps.create( PSE_Fire, count, 0, Vector2f( 0, 0 ), 16, true, 1, ColorAf( 1.f, 1.f, 1.f, 1.f ), Vector2f( 640, 480 ) );
+
+		printResult( "Particle objects", benchmarkParticleObjects( count, frames, frameTime, ps.time() ), count, frames );
+
+		printResult( "ParticleSystem", benchmarkParticleSystem( ps, frames, frameTime ), count, frames );
+
+		ps.setParallelUpdate( true );
+
+		printResult( "ParticleSystem ( " + String::toStr( JobSystem::instance()->getWorkerCount() ) + " workers )", benchmarkParticleSystem( ps, frames, frameTime ), count, frames );
+
+		std::cout << "Particles alive: " << ps.getAliveCount() << " of " << ps.getCount() << std::endl;
+	}
+
+	Engine::destroySingleton();
+
+	MemoryManager::showResults();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,76 @@
+#include <eepp/ee.hpp>
+
+// Microbenchmark of the SubTexture lookups by id: the linear search that the resource managers used to do against the hashed index.
+
+static SubTexture * linearSearch( const Uint32& id ) {
+	std::list<TextureAtlas*>& atlases = TextureAtlasManager::instance()->getResources();
+
+	for ( std::list<TextureAtlas*>::iterator it = atlases.begin(); it != atlases.end(); it++ ) {
+		std::list<SubTexture*>& subTextures = (*it)->getResources();
+
+		for ( std::list<SubTexture*>::reverse_iterator itSub = subTextures.rbegin(); itSub != subTextures.rend(); itSub++ ) {
+			if ( (*itSub)->getId() == id )
+				return (*itSub);
+		}
+	}
+
+	return NULL;
+}
+
+static void printResult( const std::string& name, const Uint32& lookups, const Uint32& found, const Time& time ) {
+	std::cout << name << ": " << ( lookups / time.asSeconds() ) << " lookups/s ( " << found << " of " << lookups << " found in " << time.asMilliseconds() << " ms )" << std::endl;
+}
+
+EE_MAIN_FUNC int main (int argc, char * argv []) {
+	{
+		Uint32 atlasCount = 40;
+		Uint32 subTexturesPerAtlas = 1000;
+		Uint32 lookups = argc > 1 ? atoi( argv[1] ) : 20000;
+		std::vector<Uint32> ids;
+
+		for ( Uint32 a = 0; a < atlasCount; a++ ) {
+			TextureAtlas * atlas = eeNew( TextureAtlas, ( "atlas" + String::toStr( a ) ) );
+
+			for ( Uint32 s = 0; s < subTexturesPerAtlas; s++ ) {
+				atlas->add( 0, Rect( 0, 0, 16, 16 ), "atlas" + String::toStr( a ) + "_sprite" + String::toStr( s ) );
+			}
+
+			TextureAtlasManager::instance()->add( atlas );
+		}
+
+		// One of every eight lookups misses, like the skins searched in the atlases before the nine patches and textures
+		for ( Uint32 i = 0; i < lookups; i++ ) {
+			Uint32 a = Math::randi( 0, atlasCount - 1 );
+			Uint32 s = Math::randi( 0, subTexturesPerAtlas - 1 );
+
+			if ( 0 == i % 8 )
+				ids.push_back( String::hash( "missing_sprite" + String::toStr( s ) ) );
+			else
+				ids.push_back( String::hash( "atlas" + String::toStr( a ) + "_sprite" + String::toStr( s ) ) );
+		}
+
+		Clock clock;
+		Uint32 found = 0;
+
+		for ( Uint32 i = 0; i < lookups; i++ )
+			if ( NULL != linearSearch( ids[i] ) )
+				found++;
+
+		printResult( "Linear search", lookups, found, clock.getElapsed() );
+
+		found = 0;
+
+		for ( Uint32 i = 0; i < lookups; i++ )
+			if ( NULL != TextureAtlasManager::instance()->getSubTextureById( ids[i] ) )
+				found++;
+
+		printResult( "Hashed index", lookups, found, clock.getElapsed() );
+
+		TextureAtlasManager::destroySingleton();
+		TextureFactory::destroySingleton();
+	}
+
+	MemoryManager::showResults();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,270 @@
+#include <eepp/ee.hpp>
+#include <eepp/network/socketpoller.hpp>
+#include <eepp/network/socketselector.hpp>
+#include <eepp/network/tcplistener.hpp>
+
+#if defined( EE_PLATFORM_POSIX )
+#include <sys/resource.h>
+#include <sys/select.h>
+#endif
+
+// Benchmark of the socket multiplexers with thousands of loopback connections: in every round a few random clients send
+// a byte, and the server waits until it receives all of them. Compares select() over an fd_set with a probe per socket
+// ( how SocketSelector worked before SocketPoller, only possible while the handles are under FD_SETSIZE ), SocketSelector
+// over SocketPoller, and SocketPoller returning the list of sockets ready with the epoll and poll backends. Also checks
+// that wakeUp interrupts a wait from another thread.
+// Usage: eepp-socket-poller [connections] [rounds] [port]
+
+namespace {
+
+// Exposes the handle to run select() directly
+class BenchSocket : public TcpSocket {
+	public:
+		using TcpSocket::getHandle;
+};
+
+const Uint32 ACTIVE_PER_ROUND = 16;
+
+#if defined( EE_PLATFORM_POSIX )
+void raiseFileLimit() {
+	rlimit limit;
+
+	if ( 0 == getrlimit( RLIMIT_NOFILE, &limit ) && limit.rlim_cur < limit.rlim_max ) {
+		limit.rlim_cur = limit.rlim_max;
+		setrlimit( RLIMIT_NOFILE, &limit );
+	}
+}
+
+Uint32 getMaxConnections() {
+	rlimit limit;
+
+	if ( 0 == getrlimit( RLIMIT_NOFILE, &limit ) && limit.rlim_cur != RLIM_INFINITY )
+		return limit.rlim_cur > 64 ? ( limit.rlim_cur - 64 ) / 2 : 0;
+
+	return 0xFFFFFFFF;
+}
+#endif
+
+// Sends a byte from some random clients, and returns the number of bytes sent
+Uint32 sendFromClients( std::vector<BenchSocket*>& clients, const Uint32& count ) {
+	char byte = 'x';
+
+	for ( Uint32 i = 0; i < ACTIVE_PER_ROUND; i++ )
+		clients[ Math::randi( 0, count - 1 ) ]->send( &byte, 1 );
+
+	return ACTIVE_PER_ROUND;
+}
+
+Uint32 receiveByte( TcpSocket * socket ) {
+	char buffer[ ACTIVE_PER_ROUND ];
+	std::size_t received = 0;
+
+	socket->receive( buffer, sizeof(buffer), received );
+
+	return received;
+}
+
+#if defined( EE_PLATFORM_POSIX )
+Time benchmarkSelect( std::vector<BenchSocket*>& clients, std::vector<BenchSocket*>& servers, const Uint32& count, const Uint32& rounds ) {
+	fd_set all;
+	int maxHandle = 0;
+	Clock clock;
+
+	FD_ZERO( &all );
+
+	for ( Uint32 i = 0; i < count; i++ ) {
+		FD_SET( servers[i]->getHandle(), &all );
+		maxHandle = eemax( maxHandle, servers[i]->getHandle() );
+	}
+
+	for ( Uint32 r = 0; r < rounds; r++ ) {
+		Uint32 pending = sendFromClients( clients, count );
+
+		while ( pending > 0 ) {
+			fd_set ready = all;
+
+			if ( select( maxHandle + 1, &ready, NULL, NULL, NULL ) <= 0 )
+				continue;
+
+			for ( Uint32 i = 0; i < count; i++ ) {
+				if ( FD_ISSET( servers[i]->getHandle(), &ready ) )
+					pending -= receiveByte( servers[i] );
+			}
+		}
+	}
+
+	return clock.getElapsedTime();
+}
+#endif
+
+Time benchmarkSelector( std::vector<BenchSocket*>& clients, std::vector<BenchSocket*>& servers, const Uint32& count, const Uint32& rounds ) {
+	SocketSelector selector;
+	Clock clock;
+
+	for ( Uint32 i = 0; i < count; i++ )
+		selector.add( *servers[i] );
+
+	for ( Uint32 r = 0; r < rounds; r++ ) {
+		Uint32 pending = sendFromClients( clients, count );
+
+		while ( pending > 0 ) {
+			if ( !selector.wait() )
+				continue;
+
+			for ( Uint32 i = 0; i < count; i++ ) {
+				if ( selector.isReady( *servers[i] ) )
+					pending -= receiveByte( servers[i] );
+			}
+		}
+	}
+
+	return clock.getElapsedTime();
+}
+
+Time benchmarkPoller( SocketPoller::Backend backend, std::vector<BenchSocket*>& clients, std::vector<BenchSocket*>& servers, const Uint32& count, const Uint32& rounds ) {
+	SocketPoller poller( backend, false );
+	Clock clock;
+
+	for ( Uint32 i = 0; i < count; i++ )
+		poller.add( *servers[i] );
+
+	for ( Uint32 r = 0; r < rounds; r++ ) {
+		Uint32 pending = sendFromClients( clients, count );
+
+		while ( pending > 0 ) {
+			poller.wait();
+
+			const std::vector<SocketPoller::ReadyEvent>& ready = poller.getReady();
+
+			for ( Uint32 i = 0; i < ready.size(); i++ )
+				pending -= receiveByte( static_cast<TcpSocket*>( ready[i].Sock ) );
+		}
+	}
+
+	return clock.getElapsedTime();
+}
+
+void printResult( const std::string& name, const Time& time, const Uint32& rounds ) {
+	std::cout << "  " << name << ": " << time.asMicroseconds() / (double)rounds << " us per round" << std::endl;
+}
+
+void wakeUpLater( SocketPoller * poller ) {
+	Sys::sleep( Milliseconds( 50 ) );
+
+	poller->wakeUp();
+}
+
+}
+
+EE_MAIN_FUNC int main (int argc, char * argv []) {
+	{
+		Uint32 connections = argc > 1 ? atoi( argv[1] ) : 10000;
+		Uint32 rounds = argc > 2 ? atoi( argv[2] ) : 1000;
+		unsigned short port = argc > 3 ? atoi( argv[3] ) : 55090;
+
+#if defined( EE_PLATFORM_POSIX )
+		raiseFileLimit();
+
+		if ( connections > getMaxConnections() ) {
+			connections = getMaxConnections();
+
+			std::cout << "Limited to " << connections << " connections by the open files limit" << std::endl;
+		}
+#endif
+
+		TcpListener listener;
+
+		if ( listener.listen( port ) != Socket::Done ) {
+			std::cout << "Failed to listen on port " << port << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		std::vector<BenchSocket*> clients;
+		std::vector<BenchSocket*> servers;
+		Clock clock;
+
+		// The listener queue is short, so every connection is accepted before opening the next one
+		for ( Uint32 i = 0; i < connections; i++ ) {
+			BenchSocket * client = eeNew( BenchSocket, () );
+			BenchSocket * server = eeNew( BenchSocket, () );
+
+			if ( client->connect( IpAddress::LocalHost, port ) != Socket::Done || listener.accept( *server ) != Socket::Done ) {
+				std::cout << "Failed to open connection " << i << std::endl;
+				eeDelete( client );
+				eeDelete( server );
+				break;
+			}
+
+			server->setBlocking( false );
+
+			clients.push_back( client );
+			servers.push_back( server );
+		}
+
+		std::cout << "Opened " << servers.size() << " connections in " << clock.getElapsedTime().asMilliseconds() << " ms, "
+				  << ACTIVE_PER_ROUND << " active per round, " << rounds << " rounds" << std::endl;
+
+		std::vector<Uint32> sizes;
+		sizes.push_back( 100 );
+		sizes.push_back( 400 );
+		sizes.push_back( 1000 );
+		sizes.push_back( servers.size() );
+
+		Math::setRandomSeed( 1 );
+
+		for ( Uint32 s = 0; s < sizes.size(); s++ ) {
+			Uint32 count = eemin( sizes[s], (Uint32)servers.size() );
+
+			if ( 0 == count || ( s > 0 && count <= sizes[ s - 1 ] ) )
+				continue;
+
+			std::cout << count << " connections:" << std::endl;
+
+#if defined( EE_PLATFORM_POSIX )
+			int maxHandle = 0;
+
+			for ( Uint32 i = 0; i < count; i++ )
+				maxHandle = eemax( maxHandle, servers[i]->getHandle() );
+
+			if ( maxHandle < FD_SETSIZE ) {
+				printResult( "select", benchmarkSelect( clients, servers, count, rounds ), rounds );
+			} else {
+				std::cout << "  select: not possible, handle " << maxHandle << " over FD_SETSIZE ( " << FD_SETSIZE << " )" << std::endl;
+			}
+#endif
+
+			printResult( "SocketSelector", benchmarkSelector( clients, servers, count, rounds ), rounds );
+
+			SocketPoller autoPoller( SocketPoller::Auto, false );
+
+			if ( SocketPoller::Epoll == autoPoller.getBackend() )
+				printResult( "SocketPoller epoll", benchmarkPoller( SocketPoller::Epoll, clients, servers, count, rounds ), rounds );
+
+			printResult( "SocketPoller poll", benchmarkPoller( SocketPoller::Poll, clients, servers, count, rounds ), rounds );
+		}
+
+		// Wakes up a wait without timeout from another thread
+		SocketPoller poller;
+		poller.add( listener );
+
+		Thread thread( &wakeUpLater, &poller );
+		clock.restart();
+		thread.launch();
+
+		Uint32 ready = poller.wait();
+
+		std::cout << "wakeUp: returned after " << clock.getElapsedTime().asMilliseconds() << " ms, woken up " << ( poller.wasWokenUp() ? "yes" : "no" )
+				  << ", " << ready << " sockets ready" << std::endl;
+
+		thread.wait();
+
+		for ( Uint32 i = 0; i < servers.size(); i++ ) {
+			eeDelete( clients[i] );
+			eeDelete( servers[i] );
+		}
+	}
+
+	MemoryManager::showResults();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,64 @@
+#include <eepp/ee.hpp>
+
+// Packs the same set of images with every TexturePacker packing method and prints the wall time, the number of atlases
+// generated and their occupancy, against the original free list algorithm.
+// Usage: eepp-texture-packer-bench [images] [max atlas size]
+//        eepp-texture-packer-bench [directory] [max atlas size]
+// With a directory the images are read from it and the atlases are saved to the temp path, so the time includes
+// the parallel image inspection and decoding.
+
+static const char * MethodNames[] = { "FreeList", "MaxRects", "SkylineBottomLeft", "SkylineMinWaste" };
+
+static void printResult( const std::string& name, TexturePacker& packer, const Time& time ) {
+	std::cout << name << ": " << time.asMilliseconds() << " ms, " << packer.getAtlasCount() << " atlases ( first "
+			  << packer.getWidth() << "x" << packer.getHeight() << " ), " << ( packer.getOccupancy() * 100.f ) << "% occupancy" << std::endl;
+}
+
+EE_MAIN_FUNC int main (int argc, char * argv []) {
+	{
+		std::string path = argc > 1 && FileSystem::isDirectory( std::string( argv[1] ) ) ? argv[1] : "";
+		Uint32 count = argc > 1 && path.empty() ? atoi( argv[1] ) : 1000;
+		Uint32 maxSize = argc > 2 ? atoi( argv[2] ) : 2048;
+		std::vector<Image*> images;
+
+		if ( path.empty() ) {
+			Math::setRandomSeed( 1 );
+
+			// Sprite sheets mix a lot of small icons with some big backgrounds
+			for ( Uint32 i = 0; i < count; i++ ) {
+				Uint32 w = 0 == i % 10 ? Math::randi( 64, 256 ) : Math::randi( 8, 64 );
+				Uint32 h = 0 == i % 10 ? Math::randi( 64, 256 ) : Math::randi( 8, 64 );
+
+				images.push_back( eeNew( Image, ( w, h, 4, Color( i % 255, 128, 255 - i % 255, 255 ) ) ) );
+			}
+		}
+
+		for ( Uint32 m = TexturePacker::FreeList; m <= TexturePacker::SkylineMinWaste; m++ ) {
+			TexturePacker packer( maxSize, maxSize, PD_MDPI, true, 1 );
+			Clock clock;
+
+			packer.setPackingMethod( (TexturePacker::PackingMethod)m );
+
+			if ( path.empty() ) {
+				for ( Uint32 i = 0; i < images.size(); i++ )
+					packer.addImage( images[i], "image" + String::toStr( i ) );
+
+				packer.packTextures();
+			} else {
+				packer.addTexturesPath( path );
+				packer.save( Sys::getTempPath() + "texture_packer_bench_" + String::toStr( m ) + ".png" );
+			}
+
+			printResult( MethodNames[m], packer, clock.getElapsed() );
+		}
+
+		for ( Uint32 i = 0; i < images.size(); i++ )
+			eeSAFE_DELETE( images[i] );
+	}
+
+	JobSystem::destroySingleton();
+
+	MemoryManager::showResults();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,133 @@
+#include <eepp/ee.hpp>
+
+// Benchmark of the UdpSocket batch functions over loopback: sends rounds of datagrams to a local socket and receives
+// them, comparing a call per datagram against the batch send and receive ( sendmmsg / recvmmsg on Linux ), for small
+// datagrams like the game state updates and for bigger ones.
+// Usage: eepp-udp-batch [rounds] [datagrams per round] [port]
+
+namespace {
+
+struct Result {
+	Time		SendTime;
+	Time		ReceiveTime;
+	Uint64		Sent;
+	Uint64		Received;
+	bool		Valid;
+};
+
+void fillDatagrams( std::vector<UdpSocket::Datagram>& datagrams, std::vector<char>& buffer, std::size_t size, unsigned short port ) {
+	buffer.resize( datagrams.size() * size );
+
+	for ( std::size_t i = 0; i < datagrams.size(); i++ ) {
+		datagrams[i].Data		= &buffer[ i * size ];
+		datagrams[i].Size		= size;
+		datagrams[i].Received	= 0;
+		datagrams[i].Address	= IpAddress::LocalHost;
+		datagrams[i].Port		= port;
+	}
+}
+
+Result benchmark( UdpSocket& sender, UdpSocket& receiver, Uint32 rounds, Uint32 perRound, std::size_t size, bool batch ) {
+	std::vector<UdpSocket::Datagram> out( perRound ), in( perRound );
+	std::vector<char> outBuffer, inBuffer;
+	Result result;
+	Clock clock;
+
+	result.Sent = result.Received = 0;
+	result.Valid = true;
+
+	fillDatagrams( out, outBuffer, size, receiver.getLocalPort() );
+	fillDatagrams( in, inBuffer, 2048, 0 );
+
+	for ( Uint32 r = 0; r < rounds; r++ ) {
+		// Every datagram carries its number, to check that the right data arrives
+		for ( Uint32 i = 0; i < perRound; i++ )
+			memcpy( out[i].Data, &i, sizeof(i) );
+
+		clock.restart();
+
+		if ( batch ) {
+			std::size_t sent = 0;
+			sender.send( &out[0], out.size(), sent );
+			result.Sent += sent;
+		} else {
+			for ( Uint32 i = 0; i < perRound; i++ ) {
+				if ( sender.send( out[i].Data, out[i].Size, out[i].Address, out[i].Port ) == Socket::Done )
+					result.Sent++;
+			}
+		}
+
+		result.SendTime += clock.getElapsedTime();
+
+		// The loopback delivers the datagrams while they are sent, so the receiver ( non-blocking ) takes the ones that weren't dropped
+		clock.restart();
+
+		std::size_t received = 0;
+
+		if ( batch ) {
+			std::size_t count = 0;
+
+			while ( received < in.size() && receiver.receive( &in[received], in.size() - received, count ) == Socket::Done )
+				received += count;
+		} else {
+			while ( received < in.size() && receiver.receive( in[received].Data, in[received].Size, in[received].Received, in[received].Address, in[received].Port ) == Socket::Done )
+				received++;
+		}
+
+		result.ReceiveTime += clock.getElapsedTime();
+		result.Received += received;
+
+		for ( std::size_t i = 0; i < received; i++ ) {
+			result.Valid = result.Valid && in[i].Received == size && in[i].Port == sender.getLocalPort() && in[i].Address == IpAddress::LocalHost;
+		}
+
+		if ( received == in.size() ) {
+			for ( Uint32 i = 0; i < perRound; i++ ) {
+				Uint32 number;
+				memcpy( &number, in[i].Data, sizeof(number) );
+				result.Valid = result.Valid && number == i;
+			}
+		}
+	}
+
+	return result;
+}
+
+void printResult( const std::string& name, const Result& result ) {
+	std::cout << "  " << name << ": send " << (Uint64)( result.Sent / result.SendTime.asSeconds() ) << " datagrams/s, receive "
+			  << (Uint64)( result.Received / result.ReceiveTime.asSeconds() ) << " datagrams/s, " << result.Received << " of "
+			  << result.Sent << " received" << ( result.Valid ? "" : ", INVALID DATA" ) << std::endl;
+}
+
+}
+
+EE_MAIN_FUNC int main (int argc, char * argv []) {
+	{
+		Uint32 rounds = argc > 1 ? atoi( argv[1] ) : 2000;
+		Uint32 perRound = argc > 2 ? atoi( argv[2] ) : 64;
+		unsigned short port = argc > 3 ? atoi( argv[3] ) : 55110;
+
+		UdpSocket sender;
+		UdpSocket receiver;
+
+		if ( receiver.bind( port, IpAddress::LocalHost ) != Socket::Done || sender.bind( Socket::AnyPort, IpAddress::LocalHost ) != Socket::Done ) {
+			std::cout << "Failed to bind the sockets on port " << port << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		receiver.setBlocking( false );
+
+		std::size_t sizes[2] = { 32, 512 };
+
+		for ( Uint32 i = 0; i < 2; i++ ) {
+			std::cout << rounds << " rounds of " << perRound << " datagrams of " << sizes[i] << " bytes:" << std::endl;
+
+			printResult( "one call per datagram", benchmark( sender, receiver, rounds, perRound, sizes[i], false ) );
+			printResult( "batch", benchmark( sender, receiver, rounds, perRound, sizes[i], true ) );
+		}
+	}
+
+	MemoryManager::showResults();
+
+	return EXIT_SUCCESS;
+}
@@ -1088,7 +1088,7 @@ void EETest::loadTextures() {
 	Engine::instance()->enableSharedGLContext();
 	#endif
 
-	PakTest->open( MyPath + "test.zip" );
+	PakTest->openReadOnly( MyPath + "test.zip" );
 
 	std::vector<std::string> files = PakTest->getFileList();
 